@@ -5,6 +5,7 @@ const platform = @import("std_impl");
 const helper = @import("selector_helper.zig");
 
 const Channel = platform.channel.Channel;
+const Socket = platform.socket.Socket;
 const makeSelector = helper.makeSelector;
 
 fn benchmarkChannelThroughput(message_count: usize) !void {
@@ -79,11 +80,184 @@ fn benchmarkSelectorWakeup(iterations: usize) !void {
     std.debug.print("Selector average wakeup latency: {d:.2} us\n", .{avg_latency_us});
 }
 
+fn printLatency(name: []const u8, samples: []u64) void {
+    std.mem.sort(u64, samples, {}, std.sort.asc(u64));
+    var sum: u64 = 0;
+    for (samples) |v| sum += v;
+    std.debug.print("  {s:<24} avg={d:.2}us p50={d:.2}us p99={d:.2}us\n", .{
+        name,
+        @as(f64, @floatFromInt(sum / samples.len)) / 1000.0,
+        @as(f64, @floatFromInt(samples[samples.len / 2])) / 1000.0,
+        @as(f64, @floatFromInt(samples[samples.len * 99 / 100])) / 1000.0,
+    });
+}
+
+/// One selector over a command channel, a socket and three timers;
+/// measures how fast each kind of source wakes the waiter.
+fn benchmarkMixedWakeLatency(iterations: usize) !void {
+    const Ch = Channel(u64, 4);
+    const Sel = makeSelector(8, Ch);
+    const alloc = std.heap.page_allocator;
+
+    var ch = try Ch.init();
+    defer ch.deinit();
+
+    var server = try Socket.tcp();
+    defer server.close();
+    try server.bind(.{ 127, 0, 0, 1 }, 0);
+    try server.listen();
+    var client = try Socket.tcp();
+    defer client.close();
+    try client.connect(.{ 127, 0, 0, 1 }, try server.getBoundPort());
+    var conn = try server.accept();
+    defer conn.close();
+
+    var sel = try Sel.init();
+    defer sel.deinit();
+
+    const ch_idx = try sel.addRecv(&ch);
+    const sock_idx = try sel.addSocket(&conn, .read);
+    const timer_idx = try sel.addTimer(0);
+    _ = try sel.addTimer(60_000);
+    _ = try sel.addTimer(120_000);
+    _ = try sel.wait(0); // consume the initial timer
+
+    const ch_lat = try alloc.alloc(u64, iterations);
+    defer alloc.free(ch_lat);
+    const sock_lat = try alloc.alloc(u64, iterations);
+    defer alloc.free(sock_lat);
+    const timer_lat = try alloc.alloc(u64, iterations);
+    defer alloc.free(timer_lat);
+
+    for (0..iterations) |i| {
+        // Channel wake
+        var t0 = std.time.nanoTimestamp();
+        const t = try std.Thread.spawn(.{}, struct {
+            fn run(c: *Ch, start: *i128) void {
+                start.* = std.time.nanoTimestamp();
+                c.send(1) catch {};
+            }
+        }.run, .{ &ch, &t0 });
+        if (try sel.wait(1000) != ch_idx) return error.UnexpectedSource;
+        ch_lat[i] = @intCast(std.time.nanoTimestamp() - t0);
+        t.join();
+        _ = ch.recv();
+
+        // Socket wake
+        const s = try std.Thread.spawn(.{}, struct {
+            fn run(c: *Socket, start: *i128) void {
+                start.* = std.time.nanoTimestamp();
+                _ = c.send("x") catch {};
+            }
+        }.run, .{ &client, &t0 });
+        if (try sel.wait(1000) != sock_idx) return error.UnexpectedSource;
+        sock_lat[i] = @intCast(std.time.nanoTimestamp() - t0);
+        s.join();
+        var b: [1]u8 = undefined;
+        _ = try conn.recv(&b);
+
+        // Timer wake: lateness past a 1ms deadline
+        sel.armTimer(timer_idx, 1);
+        t0 = std.time.nanoTimestamp();
+        if (try sel.wait(1000) != timer_idx) return error.UnexpectedSource;
+        const elapsed: u64 = @intCast(std.time.nanoTimestamp() - t0);
+        timer_lat[i] = elapsed -| std.time.ns_per_ms;
+    }
+
+    std.debug.print("Mixed selector wake latency ({d} iterations, 5 sources):\n", .{iterations});
+    printLatency("channel recv", ch_lat);
+    printLatency("socket read", sock_lat);
+    printLatency("timer (lateness)", timer_lat);
+}
+
+const THROUGHPUT_CHANNELS = 4;
+
+const SelectMode = enum { wait_rebuild, wait_reuse, wait_many };
+
+/// Four producers, one consumer selecting over all channels.
+fn benchmarkSelectThroughput(message_count: usize, mode: SelectMode) !void {
+    const Ch = Channel(u64, 256);
+    const Sel = makeSelector(THROUGHPUT_CHANNELS, Ch);
+
+    var chans: [THROUGHPUT_CHANNELS]Ch = undefined;
+    for (&chans) |*c| c.* = try Ch.init();
+    defer for (&chans) |*c| c.deinit();
+
+    var sel = try Sel.init();
+    defer sel.deinit();
+    for (&chans) |*c| _ = try sel.addRecv(c);
+
+    var producers: [THROUGHPUT_CHANNELS]std.Thread = undefined;
+    const per = message_count / THROUGHPUT_CHANNELS;
+    const start = std.time.nanoTimestamp();
+    for (&producers, &chans) |*p, *c| {
+        p.* = try std.Thread.spawn(.{}, struct {
+            fn run(ch: *Ch, count: usize) void {
+                for (0..count) |i| ch.send(@intCast(i)) catch return;
+                ch.close();
+            }
+        }.run, .{ c, per });
+    }
+
+    var received: usize = 0;
+    var selects: usize = 0;
+    var open: [THROUGHPUT_CHANNELS]bool = .{true} ** THROUGHPUT_CHANNELS;
+    var open_count: usize = THROUGHPUT_CHANNELS;
+    var ready: [THROUGHPUT_CHANNELS]usize = undefined;
+
+    while (open_count > 0) {
+        if (mode == .wait_rebuild) {
+            // Old pattern: fresh registrations before every wait
+            sel.reset();
+            for (&chans, open) |*c, o| {
+                if (o) {
+                    _ = try sel.addRecv(c);
+                } else {
+                    _ = try sel.addTimer(std.math.maxInt(u32)); // keeps indices aligned
+                }
+            }
+        }
+        const n = if (mode == .wait_many)
+            try sel.waitMany(1000, &ready)
+        else blk: {
+            ready[0] = try sel.wait(1000);
+            break :blk @as(usize, 1);
+        };
+        selects += 1;
+
+        for (ready[0..n]) |idx| {
+            if (idx >= THROUGHPUT_CHANNELS or !open[idx]) continue;
+            while (chans[idx].tryRecv()) |_| received += 1;
+            if (chans[idx].isClosed() and chans[idx].isEmpty()) {
+                open[idx] = false;
+                open_count -= 1;
+                if (mode != .wait_rebuild) sel.remove(idx);
+            }
+        }
+    }
+
+    for (producers) |p| p.join();
+
+    const elapsed_s = @as(f64, @floatFromInt(std.time.nanoTimestamp() - start)) / 1e9;
+    std.debug.print("Select throughput [{s}]: {d} msgs over {d} channels, {d} selects, {d:.2} M msg/s, {d:.0} K selects/s\n", .{
+        @tagName(mode),
+        received,
+        THROUGHPUT_CHANNELS,
+        selects,
+        @as(f64, @floatFromInt(received)) / elapsed_s / 1e6,
+        @as(f64, @floatFromInt(selects)) / elapsed_s / 1e3,
+    });
+}
+
 pub fn main() !void {
     std.debug.print("selector benchmark start\n", .{});
 
     try benchmarkChannelThroughput(1_000_000);
     try benchmarkSelectorWakeup(1000);
+    try benchmarkMixedWakeLatency(500);
+    try benchmarkSelectThroughput(1_000_000, .wait_rebuild);
+    try benchmarkSelectThroughput(1_000_000, .wait_reuse);
+    try benchmarkSelectThroughput(1_000_000, .wait_many);
 
     std.debug.print("selector benchmark done\n", .{});
 }
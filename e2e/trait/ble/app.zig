@@ -4,9 +4,13 @@
 //!   1. BT controller init via VHCI
 //!   2. HCI Reset → Command Complete
 //!   3. Read BD_ADDR → get device MAC
+//!
+//! Performance (`[e2e] PERF:` lines, see e2e/README.md):
+//!   - HCI command → Command Complete round trip (Read BD_ADDR)
 
 const platform = @import("platform.zig");
 const log = platform.log;
+const perf = @import("e2e_perf").Reporter(log, "trait/ble");
 const bt = platform.bt;
 
 fn runTests() !void {
@@ -87,9 +91,30 @@ fn runTests() !void {
         }
     }
 
+    try perfCommandRoundTrip();
+
     log.info("[e2e] PASS: trait/ble", .{});
 }
 
+// ============================================================================
+// Performance
+// ============================================================================
+
+const PERF_COMMANDS = 20;
+
+fn perfCommandRoundTrip() !void {
+    const read_addr_cmd = [_]u8{ 0x01, 0x09, 0x10, 0x00 };
+    var resp: [64]u8 = undefined;
+
+    const start = platform.time.nowMs();
+    for (0..PERF_COMMANDS) |_| {
+        _ = try bt.send(&read_addr_cmd);
+        if (!bt.waitForData(2000)) return error.HciTimeout;
+        _ = try bt.recv(&resp);
+    }
+    perf.ops("hci_command", PERF_COMMANDS, platform.time.nowMs() - start);
+}
+
 pub fn run(_: anytype) void {
     runTests() catch |err| {
         log.err("[e2e] FATAL: trait/ble — {}", .{err});
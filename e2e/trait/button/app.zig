@@ -3,9 +3,13 @@
 //! Tests:
 //!   1. Driver init/deinit without crash
 //!   2. isPressed returns false (nobody pressing it during test)
+//!
+//! Performance (`[e2e] PERF:` lines, see e2e/README.md):
+//!   - isPressed() GPIO read cost
 
 const platform = @import("platform.zig");
 const log = platform.log;
+const perf = @import("e2e_perf").Reporter(log, "hal/button");
 const ButtonDriver = platform.ButtonDriver;
 
 fn runTests() !void {
@@ -30,9 +34,29 @@ fn runTests() !void {
         }
     }
 
+    perfIsPressed(&driver);
+
     log.info("[e2e] PASS: hal/button", .{});
 }
 
+// ============================================================================
+// Performance
+// ============================================================================
+
+const PERF_BUDGET_MS = 200;
+const PERF_BATCH = 100;
+
+fn perfIsPressed(driver: *const ButtonDriver) void {
+    var ops: u64 = 0;
+    var pressed: u64 = 0;
+    const start = platform.time.nowMs();
+    while (platform.time.nowMs() - start < PERF_BUDGET_MS) : (ops += PERF_BATCH) {
+        for (0..PERF_BATCH) |_| pressed += @intFromBool(driver.isPressed());
+    }
+    perf.ops("is_pressed", ops, platform.time.nowMs() - start);
+    if (pressed > 0) log.warn("[e2e] WARN: hal/button/perf — pressed during {} reads", .{pressed});
+}
+
 pub fn run(_: anytype) void {
     runTests() catch |err| {
         log.err("[e2e] FATAL: hal/button — {}", .{err});
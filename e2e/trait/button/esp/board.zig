@@ -1,6 +1,12 @@
 //! ESP board for e2e hal/button (DevKit Boot button GPIO0)
 const std = @import("std");
+const idf = @import("idf");
 const esp = @import("esp");
 
 pub const log = std.log.scoped(.e2e);
 pub const ButtonDriver = esp.boards.esp32s3_devkit.BootButtonDriver;
+
+pub const time = struct {
+    pub fn sleepMs(ms: u32) void { idf.time.sleepMs(ms); }
+    pub fn nowMs() u64 { return idf.time.nowMs(); }
+};
@@ -0,0 +1,37 @@
+//! std board for e2e hal/button
+//!
+//! The host has no boot button: ButtonDriver is a released GPIO, so the
+//! suite checks the driver lifecycle and the read path only.
+
+const std = @import("std");
+const std_impl = @import("std_impl");
+
+pub const log = struct {
+    pub fn info(comptime fmt: []const u8, args: anytype) void { std.debug.print("[INFO] " ++ fmt ++ "\n", args); }
+    pub fn err(comptime fmt: []const u8, args: anytype) void { std.debug.print("[ERR]  " ++ fmt ++ "\n", args); }
+    pub fn warn(comptime fmt: []const u8, args: anytype) void { std.debug.print("[WARN] " ++ fmt ++ "\n", args); }
+    pub fn debug(comptime fmt: []const u8, args: anytype) void { std.debug.print("[DBG]  " ++ fmt ++ "\n", args); }
+};
+
+pub const time = struct {
+    pub fn sleepMs(ms: u32) void { std_impl.time.sleepMs(ms); }
+    pub fn nowMs() u64 { return std_impl.time.nowMs(); }
+};
+
+pub const ButtonDriver = struct {
+    const Self = @This();
+
+    initialized: bool = false,
+
+    pub fn init() !Self {
+        return .{ .initialized = true };
+    }
+
+    pub fn deinit(self: *Self) void {
+        self.initialized = false;
+    }
+
+    pub fn isPressed(_: *const Self) bool {
+        return false;
+    }
+};
@@ -1,4 +1,4 @@
-//! e2e: trait/codec — Verify audio encode/decode round-trip (Opus)
+//! e2e: trait/codec — Verify audio encode/decode round-trip (Opus, LC3)
 //!
 //! Tests:
 //!   1. Generate 1kHz triangle wave (multiple 20ms frames @ 16kHz)
@@ -6,10 +6,23 @@
 //!   3. Decode Opus → PCM
 //!   4. Check correlation on last frame (after codec delay settles)
 //!   5. Correlation > 0.7 → PASS
+//!
+//! LC3 conformance (boards whose Codec provides Lc3Encoder):
+//!   - Frame geometry for every 7.5ms/10ms × 8-48kHz configuration
+//!     matches the LC3 spec (NF = fs * dt) and bitrates map to the
+//!     expected fixed frame size
+//!   - Round-trip correlation > 0.7 in every configuration, after
+//!     aligning for the codec delay
+//!   - Lost frames are concealed with a full frame of output
+//!
+//! Performance (`[e2e] PERF:` lines, see e2e/README.md):
+//!   - Opus 16kHz mono 20ms frame encode + decode; ns_per_op below
+//!     20_000_000 is faster than real time
 
 const std = @import("std");
 const platform = @import("platform.zig");
 const log = platform.log;
+const perf = @import("e2e_perf").Reporter(log, "trait/codec");
 const Codec = platform.Codec;
 
 const SAMPLE_RATE: u32 = 16000;
@@ -22,13 +35,20 @@ fn runTests() !void {
     log.info("[e2e] START: trait/codec", .{});
 
     try testEncodeDecodeRoundtrip();
+    if (@hasDecl(Codec, "Lc3Encoder")) try testLc3Conformance();
+
+    try perfOpus();
 
     log.info("[e2e] PASS: trait/codec", .{});
 }
 
 /// Generate one frame of 1kHz triangle wave starting at sample offset
 fn generateTriangle(buf: []i16, offset: u32) void {
-    const period: i32 = @intCast(SAMPLE_RATE / FREQ_HZ); // 16 samples per period
+    generateTriangleAt(buf, offset, SAMPLE_RATE);
+}
+
+fn generateTriangleAt(buf: []i16, offset: u32, sample_rate: u32) void {
+    const period: i32 = @intCast(sample_rate / FREQ_HZ); // 16 samples per period at 16kHz
     const half: i32 = @divTrunc(period, 2);
     for (buf, 0..) |*s, i| {
         const pos: i32 = @intCast((offset + @as(u32, @intCast(i))) % @as(u32, @intCast(period)));
@@ -115,12 +135,151 @@ fn testEncodeDecodeRoundtrip() !void {
     log.info("[e2e] PASS: trait/codec/roundtrip — {} bytes, correlation OK", .{total_encoded_bytes});
 }
 
+// ============================================================================
+// LC3 conformance
+// ============================================================================
+
+const Lc3Config = struct {
+    sample_rate: u32,
+    frame_us: u32,
+    /// NF from the LC3 spec: fs * dt
+    samples: u32,
+    bitrate: u32,
+    /// Expected fixed frame size for `bitrate`
+    bytes: u32,
+};
+
+/// LC3 frame geometry (LC3 spec §3.2.5) with LE Audio BAP-style bitrates
+const lc3_configs = [_]Lc3Config{
+    .{ .sample_rate = 8000, .frame_us = 7500, .samples = 60, .bitrate = 27734, .bytes = 26 },
+    .{ .sample_rate = 8000, .frame_us = 10000, .samples = 80, .bitrate = 24000, .bytes = 30 },
+    .{ .sample_rate = 16000, .frame_us = 7500, .samples = 120, .bitrate = 32000, .bytes = 30 },
+    .{ .sample_rate = 16000, .frame_us = 10000, .samples = 160, .bitrate = 32000, .bytes = 40 },
+    .{ .sample_rate = 24000, .frame_us = 7500, .samples = 180, .bitrate = 48000, .bytes = 45 },
+    .{ .sample_rate = 24000, .frame_us = 10000, .samples = 240, .bitrate = 48000, .bytes = 60 },
+    .{ .sample_rate = 32000, .frame_us = 7500, .samples = 240, .bitrate = 64000, .bytes = 60 },
+    .{ .sample_rate = 32000, .frame_us = 10000, .samples = 320, .bitrate = 64000, .bytes = 80 },
+    .{ .sample_rate = 48000, .frame_us = 7500, .samples = 360, .bitrate = 80000, .bytes = 75 },
+    .{ .sample_rate = 48000, .frame_us = 10000, .samples = 480, .bitrate = 80000, .bytes = 100 },
+};
+
+const LC3_MAX_SAMPLES = 480;
+const LC3_FRAMES = 20;
+
+fn testLc3Conformance() !void {
+    const allocator = platform.heap_allocator;
+
+    for (lc3_configs) |cfg| {
+        const duration: Codec.lc3.FrameDuration = @enumFromInt(cfg.frame_us);
+
+        var encoder = Codec.Lc3Encoder.init(allocator, cfg.sample_rate, duration, cfg.bitrate) catch |err| {
+            log.err("[e2e] FAIL: trait/codec/lc3 — {}Hz/{}us encoder init: {}", .{ cfg.sample_rate, cfg.frame_us, err });
+            return error.EncoderInitFailed;
+        };
+        defer encoder.deinit();
+        var decoder = Codec.Lc3Decoder.init(allocator, cfg.sample_rate, duration) catch |err| {
+            log.err("[e2e] FAIL: trait/codec/lc3 — {}Hz/{}us decoder init: {}", .{ cfg.sample_rate, cfg.frame_us, err });
+            return error.DecoderInitFailed;
+        };
+        defer decoder.deinit();
+
+        if (encoder.frameSize() != cfg.samples or decoder.frameSize() != cfg.samples) {
+            log.err("[e2e] FAIL: trait/codec/lc3 — {}Hz/{}us frame {} samples, expected {}", .{ cfg.sample_rate, cfg.frame_us, encoder.frameSize(), cfg.samples });
+            return error.FrameSizeMismatch;
+        }
+
+        // Two frames of history so the codec delay can be aligned out
+        var input: [3 * LC3_MAX_SAMPLES]i16 = undefined;
+        var output: [3 * LC3_MAX_SAMPLES]i16 = undefined;
+        const n = cfg.samples;
+
+        for (0..LC3_FRAMES) |frame_idx| {
+            var pcm_in: [LC3_MAX_SAMPLES]i16 = undefined;
+            generateTriangleAt(pcm_in[0..n], @intCast(frame_idx * n), cfg.sample_rate);
+
+            var frame_buf: [400]u8 = undefined;
+            const encoded = try encoder.encode(pcm_in[0..n], n, &frame_buf);
+            if (encoded.len != cfg.bytes) {
+                log.err("[e2e] FAIL: trait/codec/lc3 — {}Hz/{}us frame {} bytes, expected {}", .{ cfg.sample_rate, cfg.frame_us, encoded.len, cfg.bytes });
+                return error.FrameBytesMismatch;
+            }
+
+            var pcm_out: [LC3_MAX_SAMPLES]i16 = undefined;
+            const decoded = try decoder.decode(encoded, &pcm_out);
+            if (decoded.len != n) return error.DecodeSizeMismatch;
+
+            // Keep the last three frames
+            std.mem.copyForwards(i16, input[0 .. 2 * n], input[n .. 3 * n]);
+            std.mem.copyForwards(i16, output[0 .. 2 * n], output[n .. 3 * n]);
+            @memcpy(input[2 * n .. 3 * n], pcm_in[0..n]);
+            @memcpy(output[2 * n .. 3 * n], decoded);
+        }
+
+        if (!correlatedWithDelay(input[0 .. 3 * n], output[0 .. 3 * n], n)) {
+            log.err("[e2e] FAIL: trait/codec/lc3 — {}Hz/{}us correlation too low", .{ cfg.sample_rate, cfg.frame_us });
+            return error.CorrelationTooLow;
+        }
+
+        var concealed: [LC3_MAX_SAMPLES]i16 = undefined;
+        const plc = try decoder.plc(&concealed);
+        if (plc.len != n) return error.PlcSizeMismatch;
+    }
+
+    log.info("[e2e] PASS: trait/codec/lc3 — {} configurations", .{lc3_configs.len});
+}
+
+/// |correlation| > 0.7 between the last input frame and the output,
+/// searching delays up to one frame.
+fn correlatedWithDelay(input: []const i16, output: []const i16, n: usize) bool {
+    const x = input[input.len - 2 * n .. input.len - n];
+    for (0..n + 1) |delay| {
+        const y = output[output.len - 2 * n + delay ..][0..n];
+        var sum_xy: i64 = 0;
+        var sum_xx: i64 = 0;
+        var sum_yy: i64 = 0;
+        for (x, y) |a, b| {
+            sum_xy += @as(i64, a) * @as(i64, b);
+            sum_xx += @as(i64, a) * @as(i64, a);
+            sum_yy += @as(i64, b) * @as(i64, b);
+        }
+        if (@as(i128, sum_xy) * @as(i128, sum_xy) * 100 > @as(i128, sum_xx) * @as(i128, sum_yy) * 49) return true;
+    }
+    return false;
+}
+
 pub fn run(_: anytype) void {
     runTests() catch |err| {
         log.err("[e2e] FATAL: trait/codec — {}", .{err});
     };
 }
 
+// ============================================================================
+// Performance
+// ============================================================================
+
+const PERF_FRAMES = 50;
+
+fn perfOpus() !void {
+    const allocator = platform.heap_allocator;
+
+    var encoder = try Codec.OpusEncoder.init(allocator, SAMPLE_RATE, 1, .voip, FRAME_MS);
+    defer encoder.deinit();
+    var decoder = try Codec.OpusDecoder.init(allocator, SAMPLE_RATE, 1, FRAME_MS);
+    defer decoder.deinit();
+
+    var pcm_in: [FRAME_SIZE]i16 = undefined;
+    var pcm_out: [FRAME_SIZE]i16 = undefined;
+    var opus_buf: [1024]u8 = undefined;
+
+    const start = platform.time.nowMs();
+    for (0..PERF_FRAMES) |frame_idx| {
+        generateTriangle(&pcm_in, @intCast(frame_idx * FRAME_SIZE));
+        const encoded = try encoder.encode(&pcm_in, FRAME_SIZE, &opus_buf);
+        _ = try decoder.decode(encoded, &pcm_out);
+    }
+    perf.ops("opus_20ms_frame", PERF_FRAMES, platform.time.nowMs() - start);
+}
+
 test "e2e: trait/codec" {
     try runTests();
 }
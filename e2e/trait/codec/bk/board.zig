@@ -4,3 +4,7 @@ const opus_codec = @import("opus_codec.zig");
 pub const log = bk.impl.log.scoped("e2e");
 pub const heap_allocator = bk.armino.heap.psram;
 pub const Codec = opus_codec;
+pub const time = struct {
+    pub fn sleepMs(ms: u32) void { bk.impl.Time.sleepMs(ms); }
+    pub fn nowMs() u64 { return bk.impl.Time.nowMs(); }
+};
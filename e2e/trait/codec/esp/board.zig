@@ -6,3 +6,8 @@ const opus_codec = @import("opus_codec.zig");
 pub const log = std.log.scoped(.e2e);
 pub const heap_allocator = idf.heap.psram;
 pub const Codec = opus_codec;
+
+pub const time = struct {
+    pub fn sleepMs(ms: u32) void { idf.time.sleepMs(ms); }
+    pub fn nowMs() u64 { return idf.time.nowMs(); }
+};
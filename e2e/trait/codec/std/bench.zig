@@ -0,0 +1,287 @@
+//! Codec real-time-factor benchmark: LC3 vs Opus at similar bitrates.
+//!
+//! Encodes and decodes 20s of a voice-like signal (harmonic stack with a
+//! moving pitch plus noise) and reports CPU time per second of audio.
+//! RTF = CPU seconds / audio seconds; lower is better, < 1 is real time.
+//!
+//! BM3 compares frames/s of the Opus wrapper driven one frame per call
+//! through stream.encodeLoop / decodeLoop against the batched loops over a
+//! FrameRing (trait.codec.encodeBatch / decodeBatch).
+//!
+//! A last test checks the batch contract on a native backend (Opus) and
+//! the per-frame fallback (LC3): undersized buffers fail the whole batch.
+
+const std = @import("std");
+const board = @import("board");
+const audio = @import("audio");
+const trait = @import("trait");
+const print = std.debug.print;
+const testing = std.testing;
+
+const Codec = board.Codec;
+const AUDIO_SECONDS = 20;
+
+fn voice(buf: []i16, sample_rate: u32) void {
+    var prng = std.Random.DefaultPrng.init(0xC0DEC);
+    const rand = prng.random();
+    var phase: f32 = 0;
+    for (buf, 0..) |*s, i| {
+        const t = @as(f32, @floatFromInt(i)) / @as(f32, @floatFromInt(sample_rate));
+        const f0 = 140 + 40 * @sin(2 * std.math.pi * 0.7 * t);
+        phase += 2 * std.math.pi * f0 / @as(f32, @floatFromInt(sample_rate));
+        var v: f32 = 0;
+        for (1..8) |h| v += @sin(phase * @as(f32, @floatFromInt(h))) / @as(f32, @floatFromInt(h));
+        v = v * 6000 + (rand.float(f32) - 0.5) * 800;
+        s.* = @intFromFloat(std.math.clamp(v, -32767, 32767));
+    }
+}
+
+const Result = struct {
+    enc_ns: u64,
+    dec_ns: u64,
+    bytes: usize,
+};
+
+fn report(name: []const u8, r: Result) void {
+    const audio_ns: f64 = AUDIO_SECONDS * 1e9;
+    print("[bench]   {s:<26} enc RTF {d:.4}  dec RTF {d:.4}  {d:>6.1} kbps\n", .{
+        name,
+        @as(f64, @floatFromInt(r.enc_ns)) / audio_ns,
+        @as(f64, @floatFromInt(r.dec_ns)) / audio_ns,
+        @as(f64, @floatFromInt(r.bytes)) * 8 / AUDIO_SECONDS / 1000,
+    });
+}
+
+fn runCodec(enc: anytype, dec: anytype, pcm: []const i16) !Result {
+    const n = enc.frameSize();
+    var frames: usize = 0;
+    var packet: [1500]u8 = undefined;
+    var out: [2048]i16 = undefined;
+    var r = Result{ .enc_ns = 0, .dec_ns = 0, .bytes = 0 };
+    var timer = try std.time.Timer.start();
+    while ((frames + 1) * n <= pcm.len) : (frames += 1) {
+        const frame = pcm[frames * n ..][0..n];
+        timer.reset();
+        const encoded = try enc.encode(frame, n, &packet);
+        r.enc_ns += timer.lap();
+        const decoded = try dec.decode(encoded, out[0..n]);
+        r.dec_ns += timer.read();
+        try testing.expectEqual(@as(usize, n), decoded.len);
+        r.bytes += encoded.len;
+    }
+    return r;
+}
+
+fn lc3(sample_rate: u32, duration: Codec.lc3.FrameDuration, bitrate: u32, pcm: []const i16) !Result {
+    var enc = try Codec.Lc3Encoder.init(testing.allocator, sample_rate, duration, bitrate);
+    defer enc.deinit();
+    var dec = try Codec.Lc3Decoder.init(testing.allocator, sample_rate, duration);
+    defer dec.deinit();
+    return runCodec(&enc, &dec, pcm);
+}
+
+fn opus(sample_rate: u32, frame_ms: u32, bitrate: u32, pcm: []const i16) !Result {
+    var enc = try Codec.OpusEncoder.init(testing.allocator, sample_rate, 1, .voip, frame_ms);
+    defer enc.deinit();
+    try enc.inner.setBitrate(bitrate);
+    try enc.inner.setVbr(false);
+    var dec = try Codec.OpusDecoder.init(testing.allocator, sample_rate, 1, frame_ms);
+    defer dec.deinit();
+    return runCodec(&enc, &dec, pcm);
+}
+
+test "BM1: 16kHz voice at 32kbps" {
+    const pcm = try testing.allocator.alloc(i16, 16000 * AUDIO_SECONDS);
+    defer testing.allocator.free(pcm);
+    voice(pcm, 16000);
+
+    print("\n[bench] 16kHz mono voice, {d}s, ~32kbps\n", .{AUDIO_SECONDS});
+    report("lc3 10ms", try lc3(16000, .ms10, 32000, pcm));
+    report("lc3 7.5ms", try lc3(16000, .ms7_5, 32000, pcm));
+    report("opus 10ms", try opus(16000, 10, 32000, pcm));
+    report("opus 20ms", try opus(16000, 20, 32000, pcm));
+}
+
+test "BM2: 48kHz voice at 96kbps" {
+    const pcm = try testing.allocator.alloc(i16, 48000 * AUDIO_SECONDS);
+    defer testing.allocator.free(pcm);
+    voice(pcm, 48000);
+
+    print("\n[bench] 48kHz mono voice, {d}s, ~96kbps\n", .{AUDIO_SECONDS});
+    report("lc3 10ms", try lc3(48000, .ms10, 96000, pcm));
+    report("lc3 7.5ms", try lc3(48000, .ms7_5, 96000, pcm));
+    report("opus 10ms", try opus(48000, 10, 96000, pcm));
+}
+
+// ----------------------------------------------------------------------------
+// BM3: per-frame vs batched pipeline
+// ----------------------------------------------------------------------------
+
+const BATCH = 8;
+
+/// PCM source serving `pcm` in 1 ms chunks, like a capture callback.
+const PcmSource = struct {
+    pcm: []const i16,
+    chunk: usize,
+    pos: usize = 0,
+
+    pub fn read(self: *PcmSource, buf: []i16) ?usize {
+        if (self.pos >= self.pcm.len) return null;
+        const n = @min(self.chunk, buf.len, self.pcm.len - self.pos);
+        @memcpy(buf[0..n], self.pcm[self.pos..][0..n]);
+        self.pos += n;
+        return n;
+    }
+};
+
+/// Stores packets back to back with a length table.
+const PacketStore = struct {
+    data: std.ArrayList(u8) = .empty,
+    lens: std.ArrayList(u16) = .empty,
+
+    fn deinit(self: *PacketStore) void {
+        self.data.deinit(testing.allocator);
+        self.lens.deinit(testing.allocator);
+    }
+
+    pub fn write(self: *PacketStore, packet: []const u8) void {
+        self.data.appendSlice(testing.allocator, packet) catch unreachable;
+        self.lens.append(testing.allocator, @intCast(packet.len)) catch unreachable;
+    }
+
+    pub fn writeBatch(self: *PacketStore, data: []const u8, lens: []const u16) void {
+        self.data.appendSlice(testing.allocator, data) catch unreachable;
+        self.lens.appendSlice(testing.allocator, lens) catch unreachable;
+    }
+};
+
+/// Per-frame sink: only `write`, so the batched loop writes packet by packet.
+const FrameSink = struct {
+    store: *PacketStore,
+
+    pub fn write(self: *FrameSink, packet: []const u8) void {
+        self.store.write(packet);
+    }
+};
+
+/// Replays stored packets one at a time.
+const PacketSource = struct {
+    it: trait.codec.PacketIterator,
+
+    pub fn read(self: *PacketSource) ?[]const u8 {
+        return self.it.next();
+    }
+};
+
+const PcmCounter = struct {
+    samples: usize = 0,
+    sum: i64 = 0,
+
+    pub fn write(self: *PcmCounter, pcm: []const i16) void {
+        self.samples += pcm.len;
+        self.sum +%= pcm[pcm.len - 1];
+    }
+};
+
+fn framesPerSec(frames: usize, ns: u64) f64 {
+    return @as(f64, @floatFromInt(frames)) * 1e9 / @as(f64, @floatFromInt(@max(ns, 1)));
+}
+
+fn pipeline(comptime batched: bool, pcm: []const i16) !void {
+    const Enc = Codec.OpusEncoder;
+    const Dec = Codec.OpusDecoder;
+    var enc = try Enc.init(testing.allocator, 48000, 1, .audio, 10);
+    defer enc.deinit();
+    try enc.inner.setComplexity(0);
+    var dec = try Dec.init(testing.allocator, 48000, 1, 10);
+    defer dec.deinit();
+    const n = enc.frameSize();
+    const frames = pcm.len / n;
+
+    var store = PacketStore{};
+    defer store.deinit();
+    var src = PcmSource{ .pcm = pcm, .chunk = 48 };
+    var ring_buf: [4 * BATCH * 480]i16 = undefined;
+    var ring = audio.FrameRing.init(ring_buf[0 .. 4 * BATCH * n], n);
+
+    var timer = try std.time.Timer.start();
+    if (batched) {
+        audio.stream.encodeLoopBatched(PcmSource, Enc, PacketStore, BATCH, &src, &enc, &store, &ring);
+    } else {
+        var sink = FrameSink{ .store = &store };
+        audio.stream.encodeLoop(PcmSource, Enc, FrameSink, &src, &enc, &sink);
+    }
+    const enc_ns = timer.lap();
+
+    var packets = PacketSource{ .it = .init(store.data.items, store.lens.items) };
+    var out = PcmCounter{};
+    timer.reset();
+    if (batched) {
+        audio.stream.decodeLoopBatched(PacketSource, Dec, PcmCounter, BATCH, &packets, &dec, &out, &ring);
+    } else {
+        audio.stream.decodeLoop(PacketSource, Dec, PcmCounter, &packets, &dec, &out);
+    }
+    const dec_ns = timer.read();
+    std.mem.doNotOptimizeAway(out.sum);
+
+    try testing.expectEqual(frames, store.lens.items.len);
+    try testing.expectEqual(frames * n, out.samples);
+    print("[bench]   {s:<26} enc {d:>9.0} frames/s  dec {d:>9.0} frames/s\n", .{
+        if (batched) "batched ring" else "per-frame loop",
+        framesPerSec(frames, enc_ns),
+        framesPerSec(frames, dec_ns),
+    });
+}
+
+test "BM3: Opus 48kHz 10ms, per-frame vs batched pipeline" {
+    const pcm = try testing.allocator.alloc(i16, 48000 * AUDIO_SECONDS);
+    defer testing.allocator.free(pcm);
+    voice(pcm, 48000);
+
+    print("\n[bench] opus 48kHz mono 10ms, {d}s, batch {d}\n", .{ AUDIO_SECONDS, BATCH });
+    try pipeline(false, pcm);
+    try pipeline(true, pcm);
+}
+
+// ----------------------------------------------------------------------------
+// Batch contract: undersized buffers fail the whole batch
+// ----------------------------------------------------------------------------
+
+fn expectBatchRejected(enc: anytype, dec: anytype) !void {
+    const Enc = @typeInfo(@TypeOf(enc)).pointer.child;
+    const n = enc.frameSize();
+    var pcm: [4 * 480]i16 = undefined;
+    voice(pcm[0 .. 4 * n], 48000);
+
+    var out: [4 * trait.codec.maxPacketBytes(Enc)]u8 = @splat(0xEE);
+    var lens: [4]u16 = @splat(0xEEEE);
+    try testing.expectError(error.BufferTooSmall, trait.codec.encodeBatch(enc, pcm[0 .. 4 * n], n, &out, lens[0..3]));
+    try testing.expectError(error.BufferTooSmall, trait.codec.encodeBatch(enc, pcm[0 .. 4 * n], n, out[0..3], &lens));
+    for (out) |b| try testing.expectEqual(@as(u8, 0xEE), b);
+    for (lens) |l| try testing.expectEqual(@as(u16, 0xEEEE), l);
+
+    const packets = try trait.codec.encodeBatch(enc, pcm[0 .. 4 * n], n, &out, &lens);
+    var decoded: [4 * 480]i16 = @splat(0x7EEE);
+    try testing.expectError(error.BufferTooSmall, trait.codec.decodeBatch(dec, packets, &lens, decoded[0 .. 4 * n - 1]));
+    try testing.expectError(error.BadArg, trait.codec.decodeBatch(dec, packets[0 .. packets.len - 1], &lens, &decoded));
+    for (decoded) |s| try testing.expectEqual(@as(i16, 0x7EEE), s);
+    try testing.expectEqual(@as(usize, 4 * n), (try trait.codec.decodeBatch(dec, packets, &lens, &decoded)).len);
+}
+
+test "undersized batch buffers fail before any frame is coded" {
+    // Native batch (opus) and the per-frame fallback (lc3)
+    try testing.expect(trait.codec.hasEncodeBatch(Codec.OpusEncoder));
+    try testing.expect(!trait.codec.hasEncodeBatch(Codec.Lc3Encoder));
+
+    var opus_enc = try Codec.OpusEncoder.init(testing.allocator, 48000, 1, .audio, 10);
+    defer opus_enc.deinit();
+    var opus_dec = try Codec.OpusDecoder.init(testing.allocator, 48000, 1, 10);
+    defer opus_dec.deinit();
+    try expectBatchRejected(&opus_enc, &opus_dec);
+
+    var lc3_enc = try Codec.Lc3Encoder.init(testing.allocator, 48000, .ms10, 96000);
+    defer lc3_enc.deinit();
+    var lc3_dec = try Codec.Lc3Decoder.init(testing.allocator, 48000, .ms10);
+    defer lc3_dec.deinit();
+    try expectBatchRejected(&lc3_enc, &lc3_dec);
+}
@@ -1,5 +1,7 @@
 const std = @import("std");
+const std_impl = @import("std_impl");
 const opus_codec = @import("opus_codec.zig");
+const lc3_codec = @import("lc3_codec.zig");
 
 pub const log = struct {
     pub fn info(comptime fmt: []const u8, args: anytype) void { std.debug.print("[INFO] " ++ fmt ++ "\n", args); }
@@ -8,4 +10,16 @@ pub const log = struct {
     pub fn debug(comptime fmt: []const u8, args: anytype) void { std.debug.print("[DBG]  " ++ fmt ++ "\n", args); }
 };
 
-pub const Codec = opus_codec;
+pub const Codec = struct {
+    pub const OpusEncoder = opus_codec.OpusEncoder;
+    pub const OpusDecoder = opus_codec.OpusDecoder;
+
+    pub const lc3 = lc3_codec;
+    pub const Lc3Encoder = lc3_codec.Lc3Encoder;
+    pub const Lc3Decoder = lc3_codec.Lc3Decoder;
+};
+
+pub const time = struct {
+    pub fn sleepMs(ms: u32) void { std_impl.time.sleepMs(ms); }
+    pub fn nowMs() u64 { return std_impl.time.nowMs(); }
+};
@@ -0,0 +1,66 @@
+//! LC3 Codec Wrapper — trait.codec compatible
+//!
+//! Wraps the raw lc3 Encoder/Decoder with bitrate → frame size tracking
+//! and allocator management.
+//!
+//! Usage:
+//!   var enc = try lc3_codec.Lc3Encoder.init(allocator, 16000, .ms10, 32000);
+//!   defer enc.deinit();
+
+const std = @import("std");
+const lc3 = @import("lc3");
+
+pub const FrameDuration = lc3.FrameDuration;
+pub const frameSamples = lc3.frameSamples;
+pub const frameBytes = lc3.frameBytes;
+
+pub const Lc3Encoder = struct {
+    inner: lc3.Encoder,
+    frame_bytes: u32,
+    alloc: std.mem.Allocator,
+
+    pub fn init(allocator: std.mem.Allocator, sample_rate: u32, duration: FrameDuration, bitrate: u32) !Lc3Encoder {
+        const frame_bytes = try lc3.frameBytes(duration, bitrate);
+        const inner = try lc3.Encoder.init(allocator, sample_rate, duration);
+        return .{ .inner = inner, .frame_bytes = frame_bytes, .alloc = allocator };
+    }
+
+    pub fn deinit(self: *Lc3Encoder) void {
+        self.inner.deinit(self.alloc);
+    }
+
+    pub fn encode(self: *Lc3Encoder, pcm: []const i16, frame_size: u32, out: []u8) ![]const u8 {
+        if (frame_size != self.frameSize() or pcm.len < frame_size) return error.BadArg;
+        return self.inner.encode(pcm[0..frame_size], self.frame_bytes, out);
+    }
+
+    pub fn frameSize(self: *const Lc3Encoder) u32 {
+        return self.inner.frameSamples();
+    }
+};
+
+pub const Lc3Decoder = struct {
+    inner: lc3.Decoder,
+    alloc: std.mem.Allocator,
+
+    pub fn init(allocator: std.mem.Allocator, sample_rate: u32, duration: FrameDuration) !Lc3Decoder {
+        const inner = try lc3.Decoder.init(allocator, sample_rate, duration);
+        return .{ .inner = inner, .alloc = allocator };
+    }
+
+    pub fn deinit(self: *Lc3Decoder) void {
+        self.inner.deinit(self.alloc);
+    }
+
+    pub fn decode(self: *Lc3Decoder, data: []const u8, pcm: []i16) ![]const i16 {
+        return self.inner.decode(data, pcm);
+    }
+
+    pub fn plc(self: *Lc3Decoder, pcm: []i16) ![]const i16 {
+        return self.inner.plc(pcm);
+    }
+
+    pub fn frameSize(self: *const Lc3Decoder) u32 {
+        return self.inner.frameSamples();
+    }
+};
@@ -33,6 +33,10 @@ pub const OpusEncoder = struct {
     pub fn frameSize(self: *const OpusEncoder) u32 {
         return self.inner.frameSizeForMs(self.frame_ms);
     }
+
+    pub fn encodeBatch(self: *OpusEncoder, pcm: []const i16, frame_size: u32, out: []u8, lens: []u16) ![]const u8 {
+        return self.inner.encodeBatch(pcm, frame_size, out, lens);
+    }
 };
 
 pub const OpusDecoder = struct {
@@ -56,4 +60,8 @@ pub const OpusDecoder = struct {
     pub fn frameSize(self: *const OpusDecoder) u32 {
         return self.inner.frameSizeForMs(self.frame_ms);
     }
+
+    pub fn decodeBatch(self: *OpusDecoder, data: []const u8, lens: []const u16, pcm: []i16) ![]const i16 {
+        return self.inner.decodeBatch(data, lens, pcm);
+    }
 };
@@ -10,11 +10,16 @@
 //!   - X25519: RFC 7748 §6.1
 //!   - HKDF: RFC 5869 Test Case 1
 //!   - HMAC: RFC 4231 Test Case 2
+//!
+//! Performance (`[e2e] PERF:` lines, see e2e/README.md): SHA-256,
+//! AES-128-GCM and ChaCha20-Poly1305 throughput over 1 KiB blocks, and
+//! X25519 scalar multiplications per second.
 
 const std = @import("std");
 const trait = @import("trait");
 const platform = @import("platform.zig");
 const log = platform.log;
+const perf = @import("e2e_perf").Reporter(log, "trait/crypto");
 
 // Compile-time validation: Crypto must implement ALL required primitives.
 // Uses default Config where all 11 required fields are `true`.
@@ -78,6 +83,15 @@ fn runTests() !void {
     testAeadTamperDetection();
     testChaCha20TamperDetection();
 
+    // ========================================================================
+    // Performance
+    // ========================================================================
+
+    perfSha256();
+    perfAead("aes128gcm", Crypto.Aes128Gcm);
+    perfAead("chacha20poly1305", Crypto.ChaCha20Poly1305);
+    perfX25519();
+
     // ========================================================================
     // Summary
     // ========================================================================
@@ -485,6 +499,52 @@ fn testChaCha20TamperDetection() void {
     }
 }
 
+// ============================================================================
+// Performance
+// ============================================================================
+
+const PERF_BUDGET_MS = 200;
+const PERF_BLOCK = 1024;
+
+var perf_in: [PERF_BLOCK]u8 = .{0xA5} ** PERF_BLOCK;
+var perf_out: [PERF_BLOCK]u8 = undefined;
+
+fn perfSha256() void {
+    var h = Crypto.Sha256.init();
+    var bytes: u64 = 0;
+    const start = platform.time.nowMs();
+    while (platform.time.nowMs() - start < PERF_BUDGET_MS) : (bytes += PERF_BLOCK) {
+        h.update(&perf_in);
+    }
+    std.mem.doNotOptimizeAway(h.final());
+    perf.bytes("sha256", bytes, platform.time.nowMs() - start);
+}
+
+fn perfAead(comptime name: []const u8, comptime Aead: type) void {
+    const key: [Aead.key_length]u8 = .{0x42} ** Aead.key_length;
+    const nonce: [Aead.nonce_length]u8 = .{0x01} ** Aead.nonce_length;
+    var tag: [Aead.tag_length]u8 = undefined;
+
+    var bytes: u64 = 0;
+    const start = platform.time.nowMs();
+    while (platform.time.nowMs() - start < PERF_BUDGET_MS) : (bytes += PERF_BLOCK) {
+        Aead.encryptStatic(&perf_out, &tag, &perf_in, "", nonce, key);
+    }
+    perf.bytes(name, bytes, platform.time.nowMs() - start);
+}
+
+fn perfX25519() void {
+    const X = Crypto.X25519;
+    const kp = X.KeyPair.generateDeterministic(.{0x77} ** 32) catch return;
+
+    var ops: u64 = 0;
+    const start = platform.time.nowMs();
+    while (platform.time.nowMs() - start < PERF_BUDGET_MS) : (ops += 1) {
+        std.mem.doNotOptimizeAway(X.scalarmult(kp.secret_key, kp.public_key) catch return);
+    }
+    perf.ops("x25519", ops, platform.time.nowMs() - start);
+}
+
 // ============================================================================
 // Entry point
 // ============================================================================
@@ -1,7 +1,13 @@
 //! ESP board for e2e trait/crypto
 //! Uses ESP mbedTLS-based crypto suite (hardware accelerated).
 const std = @import("std");
+const idf = @import("idf");
 const esp = @import("esp");
 
 pub const log = std.log.scoped(.e2e);
 pub const Crypto = esp.impl.crypto.Suite;
+
+pub const time = struct {
+    pub fn sleepMs(ms: u32) void { idf.time.sleepMs(ms); }
+    pub fn nowMs() u64 { return idf.time.nowMs(); }
+};
@@ -1,4 +1,5 @@
 const std = @import("std");
+const std_impl = @import("std_impl");
 const crypto = @import("crypto");
 pub const log = struct {
     pub fn info(comptime fmt: []const u8, args: anytype) void { std.debug.print("[INFO] " ++ fmt ++ "\n", args); }
@@ -7,3 +8,7 @@ pub const log = struct {
     pub fn debug(comptime fmt: []const u8, args: anytype) void { std.debug.print("[DBG]  " ++ fmt ++ "\n", args); }
 };
 pub const Crypto = crypto;
+pub const time = struct {
+    pub fn sleepMs(ms: u32) void { std_impl.time.sleepMs(ms); }
+    pub fn nowMs() u64 { return std_impl.time.nowMs(); }
+};
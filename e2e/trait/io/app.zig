@@ -4,10 +4,14 @@
 //!   1. init + deinit without crash
 //!   2. registerRead on pipe fd, write triggers callback via poll
 //!   3. wake() interrupts blocking poll
+//!
+//! Performance (`[e2e] PERF:` lines, see e2e/README.md):
+//!   - pipe write → poll → read callback round trip
 
 const std = @import("std");
 const platform = @import("platform.zig");
 const log = platform.log;
+const perf = @import("e2e_perf").Reporter(log, "trait/io");
 const IOService = platform.IOService;
 
 fn runTests() !void {
@@ -17,6 +21,8 @@ fn runTests() !void {
     try testReadCallback();
     try testWake();
 
+    try perfReadReady();
+
     log.info("[e2e] PASS: trait/io", .{});
 }
 
@@ -105,6 +111,50 @@ fn testWake() !void {
     log.info("[e2e] PASS: trait/io/wake", .{});
 }
 
+// ============================================================================
+// Performance
+// ============================================================================
+
+const PERF_BUDGET_MS = 200;
+
+// One byte in flight: each op is a write, a poll that dispatches the
+// read callback, and the read that drains the pipe
+fn perfReadReady() !void {
+    var io = try IOService.init(std.heap.page_allocator);
+    defer io.deinit();
+
+    const pipe = try std.posix.pipe();
+    defer std.posix.close(pipe[0]);
+    defer std.posix.close(pipe[1]);
+
+    var fired: u64 = 0;
+    io.registerRead(pipe[0], .{
+        .ptr = @ptrCast(&fired),
+        .callback = struct {
+            fn cb(ptr: ?*anyopaque, fd: std.posix.fd_t) void {
+                const n: *u64 = @ptrCast(@alignCast(ptr));
+                var b: [1]u8 = undefined;
+                _ = std.posix.read(fd, &b) catch return;
+                n.* += 1;
+            }
+        }.cb,
+    });
+
+    var ops: u64 = 0;
+    const start = platform.time.nowMs();
+    while (platform.time.nowMs() - start < PERF_BUDGET_MS) : (ops += 1) {
+        _ = try std.posix.write(pipe[1], "x");
+        _ = io.poll(100);
+    }
+    const ms = platform.time.nowMs() - start;
+
+    if (fired != ops) {
+        log.err("[e2e] FAIL: trait/io/perf_read — {} writes, {} callbacks", .{ ops, fired });
+        return error.IoCallbackNotTriggered;
+    }
+    perf.ops("read_ready", ops, ms);
+}
+
 pub fn run(_: anytype) void {
     runTests() catch |err| {
         log.err("[e2e] FATAL: trait/io — {}", .{err});
@@ -1,3 +1,4 @@
 const board = @import("board");
 pub const log = board.log;
+pub const time = board.time;
 pub const IOService = board.IOService;
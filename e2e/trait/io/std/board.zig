@@ -7,3 +7,7 @@ pub const log = struct {
     pub fn debug(comptime fmt: []const u8, args: anytype) void { std.debug.print("[DBG]  " ++ fmt ++ "\n", args); }
 };
 pub const IOService = std_impl.IOService;
+pub const time = struct {
+    pub fn sleepMs(ms: u32) void { std_impl.time.sleepMs(ms); }
+    pub fn nowMs() u64 { return std_impl.time.nowMs(); }
+};
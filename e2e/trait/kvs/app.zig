@@ -1,12 +1,17 @@
-//! e2e: trait/kvs — Verify key-value store (NVS on ESP)
+//! e2e: trait/kvs — Verify key-value store (NVS on ESP, in-memory on std)
 //!
 //! Tests:
 //!   1. NVS init
 //!   2. setU32 + getU32 round-trip
 //!   3. Key not found returns error
+//!
+//! Performance (`[e2e] PERF:` lines, see e2e/README.md):
+//!   - setU32 + commit (fixed count, each commit may write flash)
+//!   - getU32 of an existing key
 
 const platform = @import("platform.zig");
 const log = platform.log;
+const perf = @import("e2e_perf").Reporter(log, "trait/kvs");
 const Nvs = platform.Nvs;
 
 fn runTests() !void {
@@ -51,18 +56,44 @@ fn runTests() !void {
     }
 
     // Test 3: Key not found
-    {
-        _ = nvs.getU32("nonexistent_key_xyz") catch |err| {
-            if (err == Nvs.NvsError.NotFound) {
-                log.info("[e2e] PASS: trait/kvs/not_found — correct error", .{});
-                return; // this is the expected path
-            }
-            log.err("[e2e] FAIL: trait/kvs/not_found — wrong error: {}", .{err});
-            return error.NvsWrongError;
-        };
+    if (nvs.getU32("nonexistent_key_xyz")) |_| {
         log.err("[e2e] FAIL: trait/kvs/not_found — no error returned", .{});
         return error.NvsExpectedError;
+    } else |err| {
+        if (err != Nvs.NvsError.NotFound) {
+            log.err("[e2e] FAIL: trait/kvs/not_found — wrong error: {}", .{err});
+            return error.NvsWrongError;
+        }
+        log.info("[e2e] PASS: trait/kvs/not_found — correct error", .{});
+    }
+
+    try perfSetCommit(&nvs);
+    try perfGet(&nvs);
+}
+
+// ============================================================================
+// Performance
+// ============================================================================
+
+const PERF_BUDGET_MS = 200;
+const PERF_WRITES = 100;
+
+fn perfSetCommit(nvs: *Nvs) !void {
+    const start = platform.time.nowMs();
+    for (0..PERF_WRITES) |i| {
+        try nvs.setU32("perf_val", @intCast(i));
+        try nvs.commit();
+    }
+    perf.ops("set_commit", PERF_WRITES, platform.time.nowMs() - start);
+}
+
+fn perfGet(nvs: *Nvs) !void {
+    var ops: u64 = 0;
+    const start = platform.time.nowMs();
+    while (platform.time.nowMs() - start < PERF_BUDGET_MS) : (ops += 1) {
+        if ((try nvs.getU32("perf_val")) != PERF_WRITES - 1) return error.NvsValueMismatch;
     }
+    perf.ops("get", ops, platform.time.nowMs() - start);
 }
 
 pub fn run(_: anytype) void {
@@ -74,6 +105,5 @@ pub fn run(_: anytype) void {
 }
 
 test "e2e: trait/kvs" {
-    // KVS test is ESP-only (NVS flash)
-    return error.SkipZigTest;
+    try runTests();
 }
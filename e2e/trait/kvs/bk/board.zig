@@ -35,3 +35,7 @@ pub const Nvs = struct {
         self.inner.commit() catch return error.WriteFailed;
     }
 };
+pub const time = struct {
+    pub fn sleepMs(ms: u32) void { bk.impl.Time.sleepMs(ms); }
+    pub fn nowMs() u64 { return bk.impl.Time.nowMs(); }
+};
@@ -33,3 +33,8 @@ pub const Nvs = struct {
         return self.inner.commit();
     }
 };
+
+pub const time = struct {
+    pub fn sleepMs(ms: u32) void { idf.time.sleepMs(ms); }
+    pub fn nowMs() u64 { return idf.time.nowMs(); }
+};
@@ -0,0 +1,107 @@
+//! std board for e2e trait/kvs
+//!
+//! Nvs is a fixed-size in-memory table keyed by namespace and key, with
+//! the ESP NVS error behaviour the app relies on (NotFound for a missing
+//! key). Values are visible as soon as they are set, so commit only
+//! checks that the handle is open.
+
+const std = @import("std");
+const std_impl = @import("std_impl");
+
+pub const log = struct {
+    pub fn info(comptime fmt: []const u8, args: anytype) void { std.debug.print("[INFO] " ++ fmt ++ "\n", args); }
+    pub fn err(comptime fmt: []const u8, args: anytype) void { std.debug.print("[ERR]  " ++ fmt ++ "\n", args); }
+    pub fn warn(comptime fmt: []const u8, args: anytype) void { std.debug.print("[WARN] " ++ fmt ++ "\n", args); }
+    pub fn debug(comptime fmt: []const u8, args: anytype) void { std.debug.print("[DBG]  " ++ fmt ++ "\n", args); }
+};
+
+pub const time = struct {
+    pub fn sleepMs(ms: u32) void { std_impl.time.sleepMs(ms); }
+    pub fn nowMs() u64 { return std_impl.time.nowMs(); }
+};
+
+pub const Nvs = struct {
+    pub const NvsError = error{ NotInitialized, InvalidName, InvalidHandle, NotEnoughSpace, NotFound };
+
+    const max_name = 32;
+    const max_entries = 64;
+
+    const Name = struct {
+        buf: [max_name]u8 = undefined,
+        len: u8 = 0,
+
+        fn init(s: []const u8) NvsError!Name {
+            if (s.len == 0 or s.len > max_name) return error.InvalidName;
+            var n = Name{ .len = @intCast(s.len) };
+            @memcpy(n.buf[0..s.len], s);
+            return n;
+        }
+
+        fn eql(a: *const Name, b: *const Name) bool {
+            return std.mem.eql(u8, a.buf[0..a.len], b.buf[0..b.len]);
+        }
+    };
+
+    const Entry = struct {
+        namespace: Name,
+        key: Name,
+        value: u32,
+    };
+
+    var initialized = false;
+    var mutex: std.Thread.Mutex = .{};
+    var entries: [max_entries]Entry = undefined;
+    var entry_count: usize = 0;
+
+    namespace: Name,
+    is_open: bool,
+
+    pub fn flashInit() NvsError!void {
+        mutex.lock();
+        defer mutex.unlock();
+        initialized = true;
+    }
+
+    pub fn open(namespace: [:0]const u8) NvsError!Nvs {
+        if (!initialized) return error.NotInitialized;
+        return .{ .namespace = try Name.init(namespace), .is_open = true };
+    }
+
+    pub fn deinit(self: *Nvs) void {
+        self.is_open = false;
+    }
+
+    pub fn setU32(self: *Nvs, key: [:0]const u8, value: u32) NvsError!void {
+        if (!self.is_open) return error.InvalidHandle;
+        const k = try Name.init(key);
+        mutex.lock();
+        defer mutex.unlock();
+        if (self.find(&k)) |e| {
+            e.value = value;
+            return;
+        }
+        if (entry_count == max_entries) return error.NotEnoughSpace;
+        entries[entry_count] = .{ .namespace = self.namespace, .key = k, .value = value };
+        entry_count += 1;
+    }
+
+    pub fn getU32(self: *Nvs, key: [:0]const u8) NvsError!u32 {
+        if (!self.is_open) return error.InvalidHandle;
+        const k = try Name.init(key);
+        mutex.lock();
+        defer mutex.unlock();
+        const e = self.find(&k) orelse return error.NotFound;
+        return e.value;
+    }
+
+    pub fn commit(self: *Nvs) NvsError!void {
+        if (!self.is_open) return error.InvalidHandle;
+    }
+
+    fn find(self: *const Nvs, key: *const Name) ?*Entry {
+        for (entries[0..entry_count]) |*e| {
+            if (e.namespace.eql(&self.namespace) and e.key.eql(key)) return e;
+        }
+        return null;
+    }
+};
@@ -4,9 +4,13 @@
 //!   1. Driver init/deinit without crash
 //!   2. setPixel + refresh (set red, then clear)
 //!   3. clear works
+//!
+//! Performance (`[e2e] PERF:` lines, see e2e/README.md):
+//!   - full-strip setPixel + refresh (one frame)
 
 const platform = @import("platform.zig");
 const log = platform.log;
+const perf = @import("e2e_perf").Reporter(log, "hal/led_strip");
 const LedDriver = platform.LedDriver;
 
 fn runTests() !void {
@@ -34,9 +38,29 @@ fn runTests() !void {
         log.info("[e2e] PASS: hal/led_strip/clear", .{});
     }
 
+    perfFrame(&driver);
+
     log.info("[e2e] PASS: hal/led_strip", .{});
 }
 
+// ============================================================================
+// Performance
+// ============================================================================
+
+const PERF_FRAMES = 100;
+
+fn perfFrame(driver: *LedDriver) void {
+    const n = driver.getPixelCount();
+    const start = platform.time.nowMs();
+    for (0..PERF_FRAMES) |frame| {
+        const level: u8 = @intCast(frame % 32);
+        for (0..n) |i| driver.setPixel(@intCast(i), .{ .r = level, .g = 0, .b = level });
+        driver.refresh();
+    }
+    perf.ops("frame", PERF_FRAMES, platform.time.nowMs() - start);
+    driver.clear();
+}
+
 pub fn run(_: anytype) void {
     runTests() catch |err| {
         log.err("[e2e] FATAL: hal/led_strip — {}", .{err});
@@ -8,4 +8,5 @@ pub const LedDriver = esp.boards.esp32s3_devkit.LedDriver;
 
 pub const time = struct {
     pub fn sleepMs(ms: u32) void { idf.time.sleepMs(ms); }
+    pub fn nowMs() u64 { return idf.time.nowMs(); }
 };
@@ -0,0 +1,59 @@
+//! std board for e2e hal/led_strip
+//!
+//! LedDriver keeps a pixel buffer and latches it into a "shown" frame on
+//! refresh, the host stand-in for the WS2812 transfer.
+
+const std = @import("std");
+const hal = @import("hal");
+const std_impl = @import("std_impl");
+
+pub const log = struct {
+    pub fn info(comptime fmt: []const u8, args: anytype) void { std.debug.print("[INFO] " ++ fmt ++ "\n", args); }
+    pub fn err(comptime fmt: []const u8, args: anytype) void { std.debug.print("[ERR]  " ++ fmt ++ "\n", args); }
+    pub fn warn(comptime fmt: []const u8, args: anytype) void { std.debug.print("[WARN] " ++ fmt ++ "\n", args); }
+    pub fn debug(comptime fmt: []const u8, args: anytype) void { std.debug.print("[DBG]  " ++ fmt ++ "\n", args); }
+};
+
+pub const time = struct {
+    pub fn sleepMs(ms: u32) void { std_impl.time.sleepMs(ms); }
+    pub fn nowMs() u64 { return std_impl.time.nowMs(); }
+};
+
+pub const LedDriver = struct {
+    const Self = @This();
+    pub const Color = hal.Color;
+
+    const pixel_count = 12;
+
+    pixels: [pixel_count]Color = .{Color{}} ** pixel_count,
+    shown: [pixel_count]Color = .{Color{}} ** pixel_count,
+    initialized: bool = false,
+
+    pub fn init() !Self {
+        return .{ .initialized = true };
+    }
+
+    pub fn deinit(self: *Self) void {
+        if (self.initialized) self.clear();
+        self.initialized = false;
+    }
+
+    pub fn setPixel(self: *Self, index: u32, color: Color) void {
+        if (index >= pixel_count or !self.initialized) return;
+        self.pixels[index] = color;
+    }
+
+    pub fn getPixelCount(_: *Self) u32 {
+        return pixel_count;
+    }
+
+    pub fn refresh(self: *Self) void {
+        if (self.initialized) self.shown = self.pixels;
+    }
+
+    pub fn clear(self: *Self) void {
+        if (!self.initialized) return;
+        self.pixels = .{Color{}} ** pixel_count;
+        self.refresh();
+    }
+};
@@ -6,10 +6,14 @@
 //!   3. Empty format string works
 //!   4. Long message works
 //!
+//! Performance (`[e2e] PERF:` lines, see e2e/README.md):
+//!   - info() with one integer argument, end to end through the sink
+//!
 //! This file is IDENTICAL for all platforms.
 
 const platform = @import("platform.zig");
 const log = platform.log;
+const perf = @import("e2e_perf").Reporter(log, "trait/log");
 
 fn runTests() !void {
     log.info("[e2e] START: trait/log", .{});
@@ -33,9 +37,23 @@ fn runTests() !void {
     log.info("abcdefghijklmnopqrstuvwxyz_0123456789_ABCDEFGHIJKLMNOPQRSTUVWXYZ count={}", .{@as(u32, 99)});
     log.info("[e2e] PASS: trait/log/long_message", .{});
 
+    perfInfo();
+
     log.info("[e2e] PASS: trait/log", .{});
 }
 
+// ============================================================================
+// Performance
+// ============================================================================
+
+// Fixed count rather than a time budget: every op is a line of output
+fn perfInfo() void {
+    const n = 100;
+    const start = platform.time.nowMs();
+    for (0..n) |i| log.info("perf line {}", .{i});
+    perf.ops("info", n, platform.time.nowMs() - start);
+}
+
 // ESP entry
 pub fn run(_: anytype) void {
     runTests() catch |err| {
@@ -5,3 +5,4 @@
 const board = @import("board");
 
 pub const log = board.log;
+pub const time = board.time;
@@ -1,6 +1,7 @@
 //! std board for e2e trait/log
 
 const std = @import("std");
+const std_impl = @import("std_impl");
 
 pub const log = struct {
     pub fn info(comptime fmt: []const u8, args: anytype) void {
@@ -19,3 +20,8 @@ pub const log = struct {
         std.debug.print("[DBG]  " ++ fmt ++ "\n", args);
     }
 };
+
+pub const time = struct {
+    pub fn sleepMs(ms: u32) void { std_impl.time.sleepMs(ms); }
+    pub fn nowMs() u64 { return std_impl.time.nowMs(); }
+};
@@ -6,10 +6,14 @@
 //!   3. WiFi disconnect → ip_lost event fires with interface name
 //!   4. WiFi reconnect → second dhcp_bound event fires
 //!   5. Final disconnect + cleanup
+//!
+//! Performance (`[e2e] PERF:` lines, see e2e/README.md):
+//!   - connect() → first DHCP event latency
 
 const std = @import("std");
 const platform = @import("platform.zig");
 const log = platform.log;
+const perf = @import("e2e_perf").Reporter(log, "trait/net_events");
 const NetEvent = platform.NetEvent;
 
 var g_ssid: []const u8 = "";
@@ -82,6 +86,7 @@ fn runTests() !void {
     // Test 2: Connect → dhcp_bound
     resetEvents();
     log.info("[e2e] INFO: connecting to {s}...", .{g_ssid});
+    const connect_start = platform.time.nowMs();
     wifi.connect(g_ssid, g_password);
 
     // Wait for connection + DHCP (up to 30s)
@@ -100,6 +105,7 @@ fn runTests() !void {
         log.err("[e2e] FAIL: trait/net_events/dhcp_bound — no event in 5s after connect", .{});
         return error.NoDhcpEvent;
     }
+    perf.latency("connect_to_dhcp", platform.time.nowMs() - connect_start);
 
     // Verify dhcp_bound
     {
@@ -0,0 +1,35 @@
+//! e2e PERF lines — shared by the trait suites
+//!
+//! Formats the `[e2e] PERF:` lines described in e2e/README.md
+//! ("Performance") so every suite reports the same keys.
+//!
+//! ```zig
+//! const perf = @import("e2e_perf").Reporter(log, "trait/time");
+//! perf.ops("now_ms", ops, ms);
+//! ```
+
+/// PERF lines for the suite at `path` (e.g. "trait/time"), written to
+/// `log.info`
+pub fn Reporter(comptime log: type, comptime path: []const u8) type {
+    return struct {
+        /// `ops= ms= ns_per_op= ops_per_s=`
+        pub fn ops(comptime name: []const u8, n: u64, ms: u64) void {
+            const t = @max(ms, 1);
+            log.info("[e2e] PERF: " ++ path ++ "/" ++ name ++ " ops={} ms={} ns_per_op={} ops_per_s={}", .{
+                n, ms, t * 1_000_000 / @max(n, 1), n * 1000 / t,
+            });
+        }
+
+        /// `bytes= ms= kib_per_s=`
+        pub fn bytes(comptime name: []const u8, n: u64, ms: u64) void {
+            log.info("[e2e] PERF: " ++ path ++ "/" ++ name ++ " bytes={} ms={} kib_per_s={}", .{
+                n, ms, n * 1000 / 1024 / @max(ms, 1),
+            });
+        }
+
+        /// `ms=` alone: one-shot latency
+        pub fn latency(comptime name: []const u8, ms: u64) void {
+            log.info("[e2e] PERF: " ++ path ++ "/" ++ name ++ " ms={}", .{ms});
+        }
+    };
+}
@@ -4,9 +4,13 @@
 //!   1. fill() produces non-zero output
 //!   2. Two consecutive fills produce different output
 //!   3. fill() works on various buffer sizes
+//!
+//! Performance (`[e2e] PERF:` lines, see e2e/README.md):
+//!   - fill() throughput in 256-byte requests
 
 const platform = @import("platform.zig");
 const log = platform.log;
+const perf = @import("e2e_perf").Reporter(log, "trait/rng");
 const rng = platform.rng;
 
 fn runTests() !void {
@@ -71,9 +75,27 @@ fn runTests() !void {
         log.info("[e2e] PASS: trait/rng/sizes", .{});
     }
 
+    perfFill();
+
     log.info("[e2e] PASS: trait/rng", .{});
 }
 
+// ============================================================================
+// Performance
+// ============================================================================
+
+const PERF_BUDGET_MS = 200;
+
+fn perfFill() void {
+    var buf: [256]u8 = undefined;
+    var bytes: u64 = 0;
+    const start = platform.time.nowMs();
+    while (platform.time.nowMs() - start < PERF_BUDGET_MS) : (bytes += buf.len) {
+        rng.fill(&buf);
+    }
+    perf.bytes("fill", bytes, platform.time.nowMs() - start);
+}
+
 pub fn run(_: anytype) void {
     runTests() catch |err| {
         log.err("[e2e] FATAL: trait/rng — {}", .{err});
@@ -4,3 +4,7 @@ pub const log = bk.impl.log.scoped("e2e");
 pub const rng = struct {
     pub fn fill(buf: []u8) void { bk.impl.crypto.Suite.Rng.fill(buf); }
 };
+pub const time = struct {
+    pub fn sleepMs(ms: u32) void { bk.impl.Time.sleepMs(ms); }
+    pub fn nowMs() u64 { return bk.impl.Time.nowMs(); }
+};
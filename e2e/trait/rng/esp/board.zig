@@ -7,3 +7,8 @@ pub const log = std.log.scoped(.e2e);
 pub const rng = struct {
     pub fn fill(buf: []u8) void { idf.random.fill(buf); }
 };
+
+pub const time = struct {
+    pub fn sleepMs(ms: u32) void { idf.time.sleepMs(ms); }
+    pub fn nowMs() u64 { return idf.time.nowMs(); }
+};
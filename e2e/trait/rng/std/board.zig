@@ -1,4 +1,5 @@
 const std = @import("std");
+const std_impl = @import("std_impl");
 pub const log = struct {
     pub fn info(comptime fmt: []const u8, args: anytype) void { std.debug.print("[INFO] " ++ fmt ++ "\n", args); }
     pub fn err(comptime fmt: []const u8, args: anytype) void { std.debug.print("[ERR]  " ++ fmt ++ "\n", args); }
@@ -8,3 +9,7 @@ pub const log = struct {
 pub const rng = struct {
     pub fn fill(buf: []u8) void { std.crypto.random.bytes(buf); }
 };
+pub const time = struct {
+    pub fn sleepMs(ms: u32) void { std_impl.time.sleepMs(ms); }
+    pub fn nowMs() u64 { return std_impl.time.nowMs(); }
+};
@@ -4,10 +4,15 @@
 //!   1. RTC driver init/deinit without crash
 //!   2. uptime() returns monotonically increasing values
 //!   3. nowMs() returns null or valid epoch (if synced)
+//!
+//! Performance (`[e2e] PERF:` lines, see e2e/README.md):
+//!   - uptime() read cost
 
+const std = @import("std");
 const hal = @import("hal");
 const platform = @import("platform.zig");
 const log = platform.log;
+const perf = @import("e2e_perf").Reporter(log, "hal/rtc");
 const time = platform.time;
 
 fn runTests() !void {
@@ -55,9 +60,29 @@ fn runTests() !void {
         }
     }
 
+    perfUptime(&reader);
+
     log.info("[e2e] PASS: hal/rtc", .{});
 }
 
+// ============================================================================
+// Performance
+// ============================================================================
+
+const PERF_BUDGET_MS = 200;
+const PERF_BATCH = 1000;
+
+fn perfUptime(reader: anytype) void {
+    var ops: u64 = 0;
+    var sink: u64 = 0;
+    const start = time.nowMs();
+    while (time.nowMs() - start < PERF_BUDGET_MS) : (ops += PERF_BATCH) {
+        for (0..PERF_BATCH) |_| sink +%= reader.uptime();
+    }
+    perf.ops("uptime", ops, time.nowMs() - start);
+    std.mem.doNotOptimizeAway(sink);
+}
+
 pub fn run(_: anytype) void {
     runTests() catch |err| {
         log.err("[e2e] FATAL: hal/rtc — {}", .{err});
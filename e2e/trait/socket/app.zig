@@ -5,12 +5,18 @@
 //!   2. UDP: sendTo + recvFromWithAddr on localhost
 //!
 //! Both server and client use trait Socket — fully cross-platform.
+//!
+//! Performance (`[e2e] PERF:` lines, see e2e/README.md):
+//!   - TCP loopback bulk throughput (client → server, 256 KiB)
+//!   - UDP loopback datagram send → recv
 
 const std = @import("std");
 const platform = @import("platform.zig");
 const log = platform.log;
+const perf = @import("e2e_perf").Reporter(log, "trait/socket");
 const Socket = platform.Socket;
 const Rt = platform.runtime;
+const time = platform.time;
 
 fn runTests() !void {
     log.info("[e2e] START: trait/socket", .{});
@@ -18,6 +24,9 @@ fn runTests() !void {
     try testTcpEcho();
     try testUdpEcho();
 
+    try perfTcpThroughput();
+    try perfUdpDatagrams();
+
     log.info("[e2e] PASS: trait/socket", .{});
 }
 
@@ -137,6 +146,84 @@ fn testUdpEcho() !void {
     log.info("[e2e] PASS: trait/socket/udp — {} bytes from port {}", .{ result.len, result.src_port });
 }
 
+// ============================================================================
+// Performance
+// ============================================================================
+
+const PERF_BUDGET_MS = 200;
+const PERF_TCP_BYTES = 256 * 1024;
+const PERF_CHUNK = 1024;
+
+// Static so the ESP main task stack is not a limit
+var perf_tx: [PERF_CHUNK]u8 = .{0x5A} ** PERF_CHUNK;
+var perf_rx: [PERF_CHUNK]u8 = undefined;
+
+// Server counts bytes until the client closes; timed until the server
+// has seen the last byte
+fn perfTcpThroughput() !void {
+    const localhost: [4]u8 = .{ 127, 0, 0, 1 };
+
+    var server = try Socket.tcp();
+    defer server.close();
+    try server.bind(localhost, 0);
+    const port = try server.getBoundPort();
+    try server.listen();
+
+    var received = std.atomic.Value(u64).init(0);
+    const sink = try Rt.Thread.spawn(.{}, struct {
+        fn run(srv: *Socket, total: *std.atomic.Value(u64)) void {
+            var conn = srv.accept() catch return;
+            defer conn.close();
+            var n: u64 = 0;
+            while (conn.recv(&perf_rx)) |len| n += len else |_| {}
+            total.store(n, .release);
+        }
+    }.run, .{ &server, &received });
+
+    const start = time.nowMs();
+    {
+        var client = try Socket.tcp();
+        defer client.close();
+        try client.connect(localhost, port);
+        var sent: usize = 0;
+        while (sent < PERF_TCP_BYTES) {
+            sent += try client.send(perf_tx[0..@min(PERF_CHUNK, PERF_TCP_BYTES - sent)]);
+        }
+    }
+    sink.join();
+    const ms = time.nowMs() - start;
+
+    const got = received.load(.acquire);
+    if (got != PERF_TCP_BYTES) {
+        log.err("[e2e] FAIL: trait/socket/perf_tcp — server got {} of {} bytes", .{ got, PERF_TCP_BYTES });
+        return error.TcpShortTransfer;
+    }
+    perf.bytes("tcp_loopback", got, ms);
+}
+
+// One datagram in flight: sendTo then recvFrom on the same thread
+fn perfUdpDatagrams() !void {
+    const localhost: [4]u8 = .{ 127, 0, 0, 1 };
+
+    var receiver = try Socket.udp();
+    defer receiver.close();
+    try receiver.bind(localhost, 0);
+    receiver.setRecvTimeout(2000);
+    const port = try receiver.getBoundPort();
+
+    var sender = try Socket.udp();
+    defer sender.close();
+
+    var ops: u64 = 0;
+    const start = time.nowMs();
+    while (time.nowMs() - start < PERF_BUDGET_MS) : (ops += 1) {
+        _ = try sender.sendTo(localhost, port, perf_tx[0..64]);
+        const n = try receiver.recvFrom(&perf_rx);
+        if (n != 64) return error.UdpMismatch;
+    }
+    perf.ops("udp_datagram", ops, time.nowMs() - start);
+}
+
 pub fn run(_: anytype) void {
     runTests() catch |err| {
         log.err("[e2e] FATAL: trait/socket — {}", .{err});
@@ -5,3 +5,8 @@ const idf = @import("idf");
 pub const log = std.log.scoped(.e2e);
 pub const Socket = idf.Socket;
 pub const runtime = idf.runtime;
+
+pub const time = struct {
+    pub fn sleepMs(ms: u32) void { idf.time.sleepMs(ms); }
+    pub fn nowMs() u64 { return idf.time.nowMs(); }
+};
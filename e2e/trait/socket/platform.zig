@@ -1,4 +1,5 @@
 const board = @import("board");
 pub const log = board.log;
+pub const time = board.time;
 pub const Socket = board.Socket;
 pub const runtime = board.runtime;
@@ -8,3 +8,7 @@ pub const log = struct {
 };
 pub const Socket = std_impl.socket.Socket;
 pub const runtime = std_impl.runtime;
+pub const time = struct {
+    pub fn sleepMs(ms: u32) void { std_impl.time.sleepMs(ms); }
+    pub fn nowMs() u64 { return std_impl.time.nowMs(); }
+};
@@ -4,10 +4,14 @@
 //!   1. spawn + join: thread runs to completion, result visible after join
 //!   2. spawn + detach: fire-and-forget task completes
 //!   3. spawn multiple + join all
+//!
+//! Performance (`[e2e] PERF:` lines, see e2e/README.md):
+//!   - spawn → join round trip of an empty task
 
 const std = @import("std");
 const platform = @import("platform.zig");
 const log = platform.log;
+const perf = @import("e2e_perf").Reporter(log, "trait/spawner");
 const Rt = platform.runtime;
 
 fn runTests() !void {
@@ -17,6 +21,8 @@ fn runTests() !void {
     try testSpawnDetach();
     try testMultipleJoin();
 
+    try perfSpawnJoin();
+
     log.info("[e2e] PASS: trait/spawner", .{});
 }
 
@@ -96,6 +102,35 @@ fn testMultipleJoin() !void {
     log.info("[e2e] PASS: trait/spawner/multi — 3/3 joined", .{});
 }
 
+// ============================================================================
+// Performance
+// ============================================================================
+
+const PERF_BUDGET_MS = 200;
+
+// Spawn latency: thread creation, first run and join, one at a time
+fn perfSpawnJoin() !void {
+    var counter = std.atomic.Value(u32).init(0);
+
+    var ops: u64 = 0;
+    const start = platform.time.nowMs();
+    while (platform.time.nowMs() - start < PERF_BUDGET_MS) : (ops += 1) {
+        const thread = try Rt.Thread.spawn(.{}, struct {
+            fn run(c: *std.atomic.Value(u32)) void {
+                _ = c.fetchAdd(1, .release);
+            }
+        }.run, .{&counter});
+        thread.join();
+    }
+    const ms = platform.time.nowMs() - start;
+
+    if (counter.load(.acquire) != ops) {
+        log.err("[e2e] FAIL: trait/spawner/perf_spawn — {} spawned, {} ran", .{ ops, counter.load(.acquire) });
+        return error.SpawnCountMismatch;
+    }
+    perf.ops("spawn_join", ops, ms);
+}
+
 pub fn run(_: anytype) void {
     runTests() catch |err| {
         log.err("[e2e] FATAL: trait/spawner — {}", .{err});
@@ -7,6 +7,10 @@
 //!   4. Channel send/recv across threads
 //!   5. WaitGroup tracks task completion
 //!
+//! Performance (`[e2e] PERF:` lines, see e2e/README.md):
+//!   - mutex lock/unlock, uncontended and contended by two threads
+//!   - channel send → recv throughput across threads
+//!
 //! This file is IDENTICAL for all platforms.
 
 const std = @import("std");
@@ -14,6 +18,7 @@ const platform = @import("platform.zig");
 const waitgroup_pkg = @import("waitgroup");
 
 const log = platform.log;
+const perf = @import("e2e_perf").Reporter(log, "trait/sync");
 const time = platform.time;
 const Rt = platform.runtime;
 const Channel = platform.channel.Channel;
@@ -27,6 +32,10 @@ fn runTests() !void {
     try testChannel();
     try testWaitGroup();
 
+    perfMutexUncontended();
+    try perfMutexContended();
+    try perfChannel();
+
     log.info("[e2e] PASS: trait/sync", .{});
 }
 
@@ -186,6 +195,86 @@ fn testWaitGroup() !void {
     log.info("[e2e] PASS: trait/sync/waitgroup — 3/3 tasks completed", .{});
 }
 
+// ============================================================================
+// Performance
+// ============================================================================
+
+const PERF_BUDGET_MS = 200;
+const PERF_BATCH = 1000;
+
+fn perfMutexUncontended() void {
+    var mutex = Rt.Mutex.init();
+    defer mutex.deinit();
+
+    var ops: u64 = 0;
+    const start = time.nowMs();
+    while (time.nowMs() - start < PERF_BUDGET_MS) : (ops += PERF_BATCH) {
+        for (0..PERF_BATCH) |_| {
+            mutex.lock();
+            mutex.unlock();
+        }
+    }
+    perf.ops("mutex_uncontended", ops, time.nowMs() - start);
+}
+
+// Two threads alternate on one mutex; ops counts both sides
+fn perfMutexContended() !void {
+    const Shared = struct {
+        mutex: Rt.Mutex,
+        counter: u64 = 0,
+        stop: std.atomic.Value(bool) = .init(false),
+    };
+    var shared = Shared{ .mutex = Rt.Mutex.init() };
+    defer shared.mutex.deinit();
+
+    const worker = try Rt.Thread.spawn(.{}, struct {
+        fn run(sh: *Shared) void {
+            while (!sh.stop.load(.acquire)) {
+                sh.mutex.lock();
+                sh.counter += 1;
+                sh.mutex.unlock();
+            }
+        }
+    }.run, .{&shared});
+
+    const start = time.nowMs();
+    while (time.nowMs() - start < PERF_BUDGET_MS) {
+        for (0..PERF_BATCH) |_| {
+            shared.mutex.lock();
+            shared.counter += 1;
+            shared.mutex.unlock();
+        }
+    }
+    shared.stop.store(true, .release);
+    worker.join();
+    perf.ops("mutex_contended", shared.counter, time.nowMs() - start);
+}
+
+fn perfChannel() !void {
+    const Ch = Channel(u32, 16);
+    var ch = try Ch.init();
+    defer ch.deinit();
+
+    const count: u32 = 10_000;
+    const start = time.nowMs();
+    const producer = try Rt.Thread.spawn(.{}, struct {
+        fn run(c: *Ch, n: u32) void {
+            for (0..n) |i| c.send(@intCast(i)) catch break;
+            c.close();
+        }
+    }.run, .{ &ch, count });
+
+    var received: u64 = 0;
+    while (ch.recv()) |_| received += 1;
+    producer.join();
+
+    if (received != count) {
+        log.err("[e2e] FAIL: trait/sync/perf_channel — expected {} items, got {}", .{ count, received });
+        return error.ChannelWrongCount;
+    }
+    perf.ops("channel_send_recv", received, time.nowMs() - start);
+}
+
 // ESP entry
 pub fn run(_: anytype) void {
     runTests() catch |err| {
@@ -2,9 +2,13 @@
 //!
 //! Tests:
 //!   1. getCpuCount() returns >= 1
+//!
+//! Performance (`[e2e] PERF:` lines, see e2e/README.md):
+//!   - getCpuCount() call cost
 
 const platform = @import("platform.zig");
 const log = platform.log;
+const perf = @import("e2e_perf").Reporter(log, "trait/system");
 const runtime = platform.runtime;
 
 fn runTests() !void {
@@ -23,9 +27,27 @@ fn runTests() !void {
         log.info("[e2e] PASS: trait/system/cpuCount — {} cores", .{count});
     }
 
+    perfCpuCount();
+
     log.info("[e2e] PASS: trait/system", .{});
 }
 
+// ============================================================================
+// Performance
+// ============================================================================
+
+const PERF_BUDGET_MS = 200;
+const PERF_BATCH = 100;
+
+fn perfCpuCount() void {
+    var ops: u64 = 0;
+    const start = platform.time.nowMs();
+    while (platform.time.nowMs() - start < PERF_BUDGET_MS) : (ops += PERF_BATCH) {
+        for (0..PERF_BATCH) |_| _ = runtime.getCpuCount() catch 0;
+    }
+    perf.ops("cpu_count", ops, platform.time.nowMs() - start);
+}
+
 pub fn run(_: anytype) void {
     runTests() catch |err| {
         log.err("[e2e] FATAL: trait/system — {}", .{err});
@@ -3,9 +3,13 @@
 //! Tests:
 //!   1. Driver init/deinit without crash
 //!   2. readCelsius returns value in -10 to 80 range
+//!
+//! Performance (`[e2e] PERF:` lines, see e2e/README.md):
+//!   - readCelsius() latency
 
 const platform = @import("platform.zig");
 const log = platform.log;
+const perf = @import("e2e_perf").Reporter(log, "hal/temp_sensor");
 const TempDriver = platform.TempDriver;
 
 fn runTests() !void {
@@ -50,9 +54,26 @@ fn runTests() !void {
         log.info("[e2e] PASS: hal/temp_sensor/read — {}C (stable)", .{temp_int});
     }
 
+    try perfRead(&driver);
+
     log.info("[e2e] PASS: hal/temp_sensor", .{});
 }
 
+// ============================================================================
+// Performance
+// ============================================================================
+
+const PERF_BUDGET_MS = 200;
+
+fn perfRead(driver: *TempDriver) !void {
+    var ops: u64 = 0;
+    const start = platform.time.nowMs();
+    while (platform.time.nowMs() - start < PERF_BUDGET_MS) : (ops += 1) {
+        _ = try driver.readCelsius();
+    }
+    perf.ops("read_celsius", ops, platform.time.nowMs() - start);
+}
+
 pub fn run(_: anytype) void {
     runTests() catch |err| {
         log.err("[e2e] FATAL: hal/temp_sensor — {}", .{err});
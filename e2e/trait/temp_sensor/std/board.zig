@@ -0,0 +1,41 @@
+//! std board for e2e hal/temp_sensor
+//!
+//! The host exposes no die sensor portably: TempDriver reports a steady
+//! room temperature with a small deterministic wobble, inside the range
+//! and stability limits the suite checks.
+
+const std = @import("std");
+const std_impl = @import("std_impl");
+
+pub const log = struct {
+    pub fn info(comptime fmt: []const u8, args: anytype) void { std.debug.print("[INFO] " ++ fmt ++ "\n", args); }
+    pub fn err(comptime fmt: []const u8, args: anytype) void { std.debug.print("[ERR]  " ++ fmt ++ "\n", args); }
+    pub fn warn(comptime fmt: []const u8, args: anytype) void { std.debug.print("[WARN] " ++ fmt ++ "\n", args); }
+    pub fn debug(comptime fmt: []const u8, args: anytype) void { std.debug.print("[DBG]  " ++ fmt ++ "\n", args); }
+};
+
+pub const time = struct {
+    pub fn sleepMs(ms: u32) void { std_impl.time.sleepMs(ms); }
+    pub fn nowMs() u64 { return std_impl.time.nowMs(); }
+};
+
+pub const TempDriver = struct {
+    const Self = @This();
+
+    enabled: bool = false,
+    reads: u32 = 0,
+
+    pub fn init() !Self {
+        return .{ .enabled = true };
+    }
+
+    pub fn deinit(self: *Self) void {
+        self.enabled = false;
+    }
+
+    pub fn readCelsius(self: *Self) !f32 {
+        if (!self.enabled) return error.NotEnabled;
+        self.reads +%= 1;
+        return 25.0 + @as(f32, @floatFromInt(self.reads % 5)) * 0.1;
+    }
+};
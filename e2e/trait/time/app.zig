@@ -5,10 +5,16 @@
 //!   2. getTimeMs() returns monotonically increasing values
 //!   3. sleepMs duration is within tolerance (50ms sleep → 40-200ms elapsed)
 //!
+//! Performance (`[e2e] PERF:` lines, see e2e/README.md):
+//!   - nowMs() call cost
+//!   - sleepMs(1) actual duration (tick granularity)
+//!
 //! This file is IDENTICAL for all platforms. platform.zig → board module handles switching.
 
+const std = @import("std");
 const platform = @import("platform.zig");
 const log = platform.log;
+const perf = @import("e2e_perf").Reporter(log, "trait/time");
 const time = platform.time;
 
 fn runTests() !void {
@@ -49,9 +55,38 @@ fn runTests() !void {
         log.info("[e2e] PASS: trait/time/duration — 50ms sleep took {}ms", .{elapsed});
     }
 
+    perfNowMs();
+    perfSleep1();
+
     log.info("[e2e] PASS: trait/time", .{});
 }
 
+// ============================================================================
+// Performance
+// ============================================================================
+
+const PERF_BUDGET_MS = 200;
+const PERF_BATCH = 1000;
+
+fn perfNowMs() void {
+    var ops: u64 = 0;
+    var sink: u64 = 0;
+    const start = time.nowMs();
+    while (time.nowMs() - start < PERF_BUDGET_MS) : (ops += PERF_BATCH) {
+        for (0..PERF_BATCH) |_| sink +%= time.nowMs();
+    }
+    perf.ops("now_ms", ops, time.nowMs() - start);
+    std.mem.doNotOptimizeAway(sink);
+}
+
+// ns_per_op is the real length of a 1ms sleep
+fn perfSleep1() void {
+    const n = 50;
+    const start = time.nowMs();
+    for (0..n) |_| time.sleepMs(1);
+    perf.ops("sleep_1ms", n, time.nowMs() - start);
+}
+
 /// ESP entry point (called by esp_zig_app framework)
 pub fn run(_: anytype) void {
     runTests() catch |err| {
@@ -6,10 +6,14 @@
 //!   3. Wait for DHCP (got IP)
 //!   4. UDP loopback on localhost (proves lwip is working)
 //!   5. Disconnect
+//!
+//! Performance (`[e2e] PERF:` lines, see e2e/README.md):
+//!   - connect() → associated latency
 
 const std = @import("std");
 const platform = @import("platform.zig");
 const log = platform.log;
+const perf = @import("e2e_perf").Reporter(log, "hal/wifi");
 
 var g_ssid: []const u8 = "";
 var g_password: []const u8 = "";
@@ -29,6 +33,7 @@ fn runTests() !void {
     const ssid = g_ssid;
     const password = g_password;
     log.info("[e2e] INFO: connecting to {s}...", .{ssid});
+    const connect_start = platform.time.nowMs();
     wifi.connect(ssid, password);
 
     // Test 3: Wait for connection + IP (poll for up to 30s)
@@ -43,6 +48,7 @@ fn runTests() !void {
         return error.WifiConnectTimeout;
     }
     log.info("[e2e] PASS: hal/wifi/connect — connected in ~{}ms", .{waited});
+    perf.latency("connect", platform.time.nowMs() - connect_start);
 
     // Wait a bit more for DHCP
     platform.time.sleepMs(2000);
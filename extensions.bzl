@@ -1,10 +1,11 @@
 """Module extensions for embed-zig.
 
 Provides:
-- Audio libraries (opus, ogg, speexdsp)
+- Audio libraries (opus, lc3, ogg, speexdsp)
 - Zig toolchain with Xtensa support
 """
 
+load("//third_party/lc3:repository.bzl", _lc3_repository = "lc3_repository")
 load("//third_party/opus:repository.bzl", _opus_repository = "opus_repository")
 load("//third_party/speexdsp:repository.bzl", _speexdsp_repository = "speexdsp_repository")
 
@@ -53,6 +54,7 @@ _ogg_repo = repository_rule(
 def _audio_libs_impl(ctx):
     """Module extension for audio libraries."""
     _opus_repository(name = "opus")
+    _lc3_repository(name = "lc3")
     _ogg_repo(name = "ogg")
     _speexdsp_repository(name = "speexdsp")
 
@@ -135,8 +135,28 @@ pub const input = struct {
     pub const adc_button = @import("input/src/adc_button.zig");
     pub const AdcButtonSet = adc_button.AdcButtonSet;
     pub const ButtonEvents = adc_button.ButtonEvents;
+    pub const sampler = adc_button.sampler;
 };
 
+/// Firmware Updates
+///
+/// A/B slot update engine over trait.fs with streaming SHA-256 and
+/// signature verification, resumable downloads, delta patches and
+/// trial boots with automatic rollback.
+pub const ota = @import("ota/src/ota.zig");
+
+/// Structured Logging
+///
+/// trait.log backend with deferred argument formatting, per-module rate
+/// limits, a lock-free record ring and crash capture to trait.fs.
+pub const slog = @import("slog/src/slog.zig");
+
+/// Connection Memory Pools
+///
+/// Size-class slab allocator and per-connection arenas for servers,
+/// exposed as std.mem.Allocator for http, mqtt0 and the BLE host.
+pub const pool = @import("pool/src/pool.zig");
+
 test {
     @import("std").testing.refAllDecls(@This());
 }
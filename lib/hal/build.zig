@@ -18,6 +18,13 @@ pub fn build(b: *std.Build) void {
     });
     const motion_module = motion_dep.module("motion");
 
+    // Get input dependency (ADC sampling engine)
+    const input_dep = b.dependency("input", .{
+        .target = target,
+        .optimize = optimize,
+    });
+    const input_module = input_dep.module("input");
+
     // HAL module
     const hal_module = b.addModule("hal", .{
         .root_source_file = b.path("src/hal.zig"),
@@ -26,6 +33,7 @@ pub fn build(b: *std.Build) void {
         .imports = &.{
             .{ .name = "trait", .module = trait_module },
             .{ .name = "motion", .module = motion_module },
+            .{ .name = "input", .module = input_module },
         },
     });
 
@@ -48,6 +56,7 @@ pub fn build(b: *std.Build) void {
                 .imports = &.{
                     .{ .name = "trait", .module = trait_module },
                     .{ .name = "motion", .module = motion_module },
+                    .{ .name = "input", .module = input_module },
                 },
             }),
         });
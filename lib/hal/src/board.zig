@@ -64,6 +64,10 @@
 //!     }
 //! }
 //! ```
+//!
+//! Battery boards replace the fixed `sleepMs(10)` with a hal.tickless
+//! scheduler and `board.sleepUntilDue(&sched, max_ms)`, so periodic work
+//! shares wakeups and the loop sleeps until the next one is due.
 
 const std = @import("std");
 const trait = @import("trait");
@@ -800,6 +804,16 @@ pub fn Board(comptime spec: type) type {
             return !self.events.isEmpty();
         }
 
+        /// Sleep until the next coalesced deadline of a hal.tickless
+        /// scheduler, at most `max_ms`. Returns at once while events are
+        /// queued. On platforms with tickless idle (FreeRTOS light sleep)
+        /// `time.sleepMs` is where the CPU actually powers down.
+        pub fn sleepUntilDue(self: *Self, sched: anytype, max_ms: u32) void {
+            if (self.hasEvents()) return;
+            const ms = sched.sleepMs(self.uptime(), max_ms);
+            if (ms > 0) time.sleepMs(ms);
+        }
+
         /// Get pointer to the event queue (for peripherals that need direct access)
         pub fn getEventQueue(self: *Self) *QueueImpl(Event, 64) {
             return &self.events;
@@ -12,15 +12,20 @@
 //! ├─────────────────────────────────────────┤
 //! │ ButtonGroup(spec, ButtonId)  ← HAL     │
 //! │   - ADC value → button mapping          │
-//! │   - debouncing                          │
+//! │   - debouncing (per sample or batch)    │
 //! │   - click/double-click detection        │
 //! │   - long press detection                │
 //! ├─────────────────────────────────────────┤
 //! │ Driver (spec.Driver)  ← hardware impl  │
 //! │   - readRaw() -> u16                    │
+//! │   - readBatch([]u16) -> usize (opt, DMA)│
 //! └─────────────────────────────────────────┘
 //! ```
 //!
+//! Several groups can share one sampling task through
+//! `hal.adc_sampler.Engine`, which reads each driver in batches and sleeps
+//! while no button is held (see `sampleBatch`).
+//!
 //! ## Usage
 //!
 //! ```zig
@@ -57,6 +62,7 @@
 const std = @import("std");
 
 const button_mod = @import("button.zig");
+const sampler = @import("input").sampler;
 /// Re-export ButtonAction from button module for consistency
 pub const ButtonAction = button_mod.ButtonAction;
 // ============================================================================
@@ -87,6 +93,9 @@ pub const ButtonGroupConfig = struct {
     long_press_ms: u32 = 1000,
     /// Click gap window in milliseconds (for consecutive clicks)
     click_gap_ms: u32 = 300,
+    /// Agreeing samples required before a press/release is accepted
+    /// (1 = act on the first sample, the classic polling behavior)
+    debounce_samples: u8 = 1,
 };
 
 /// Event from ButtonGroup
@@ -110,7 +119,8 @@ pub fn ButtonGroupEvent(comptime ButtonId: type) type {
 /// Button Group HAL component (ADC mode)
 ///
 /// spec must define:
-/// - `Driver`: struct with readRaw() -> u16 method
+/// - `Driver`: struct with readRaw() -> u16 method, and optionally
+///   readBatch(out: []u16) -> usize returning the newest DMA samples
 /// - `ranges`: &[_]Range - ADC value ranges for each button
 /// - `ref_value`: u16 - ADC value when no button is pressed
 /// - `ref_tolerance`: u16 - tolerance for detecting ref state (optional, default 200)
@@ -202,6 +212,8 @@ pub fn from(comptime spec: type, comptime ButtonId: type) type {
         current_button: ?ButtonId = null,
         is_at_ref: bool = true,
         last_raw: u16 = 0,
+        /// Debounces the ref/non-ref level across samples
+        debounce: sampler.Debounce(bool) = sampler.Debounce(bool).init(true),
 
         /// Event queue for multiple events per poll
         event_queue: [8]Event = undefined,
@@ -237,19 +249,35 @@ pub fn from(comptime spec: type, comptime ButtonId: type) type {
 
         /// Poll ADC and process button state changes
         pub fn poll(self: *Self) void {
+            self.processSample(self.driver.readRaw(), self.time_fn());
+        }
+
+        /// Read a batch of samples (DMA ring when the driver has one, else a
+        /// single readRaw) and process each at its own timestamp, `period_ms`
+        /// apart. Used by hal.adc_sampler.Engine; returns samples processed.
+        pub fn sampleBatch(self: *Self, max: usize, period_ms: u32) usize {
+            var buf: [sampler.MAX_BATCH]u16 = undefined;
+            const n = sampler.readBatch(self.driver, buf[0..@min(max, buf.len)]);
             const now_ms = self.time_fn();
-            const raw = self.driver.readRaw();
-            self.last_raw = raw;
+            for (buf[0..n], 0..) |raw, i| {
+                self.processSample(raw, sampler.sampleTime(now_ms, i, n, period_ms));
+            }
+            return n;
+        }
 
-            // Check if at reference (no button pressed)
-            const cur_is_ref = isRefValue(raw);
+        /// No button held and no level change pending debounce
+        pub fn isIdle(self: *const Self) bool {
+            return self.is_at_ref and self.current_button == null and self.debounce.count == 0;
+        }
+
+        fn processSample(self: *Self, raw: u16, now_ms: u64) void {
+            self.last_raw = raw;
 
-            // State transition detection
-            if (cur_is_ref != self.is_at_ref) {
+            // Debounced ref/non-ref transition
+            if (self.debounce.feed(isRefValue(raw), self.config.debounce_samples)) |cur_is_ref| {
                 if (!cur_is_ref) {
                     // Transition: ref → non-ref (button pressed)
-                    const new_button = findButton(raw);
-                    self.handleButtonPress(new_button, now_ms);
+                    self.handleButtonPress(findButton(raw), now_ms);
                 } else {
                     // Transition: non-ref → ref (button released)
                     self.handleButtonRelease(now_ms);
@@ -409,6 +437,7 @@ pub fn from(comptime spec: type, comptime ButtonId: type) type {
             }
             self.current_button = null;
             self.is_at_ref = true;
+            self.debounce.reset(true);
             self.event_count = 0;
             self.event_index = 0;
         }
@@ -663,3 +692,59 @@ test "ButtonGroup double click" {
     try std.testing.expectEqual(ButtonAction.double_click, event.?.action);
     try std.testing.expectEqual(@as(u8, 2), event.?.click_count);
 }
+
+test "ButtonGroup batch sampling with debounce" {
+    const TestButtonId = enum(u8) { btn = 0 };
+
+    const MockTime = struct {
+        var t: u64 = 0;
+        pub fn now() u64 {
+            return t;
+        }
+    };
+
+    // DMA-style driver: returns the queued samples, oldest first
+    const MockDriver = struct {
+        samples: []const u16 = &.{},
+        pub fn readRaw(self: *@This()) u16 {
+            return self.samples[self.samples.len - 1];
+        }
+        pub fn readBatch(self: *@This(), out: []u16) usize {
+            const n = @min(out.len, self.samples.len);
+            @memcpy(out[0..n], self.samples[self.samples.len - n ..]);
+            return n;
+        }
+    };
+
+    const btns_spec = struct {
+        pub const Driver = MockDriver;
+        pub const ranges = &[_]Range{
+            .{ .id = 0, .min = 200, .max = 400 },
+        };
+        pub const ref_value: u16 = 4095;
+        pub const meta = .{ .id = "buttons.batch" };
+    };
+
+    const TestButtonGroup = from(btns_spec, TestButtonId);
+
+    var driver = MockDriver{};
+    var btns = TestButtonGroup.initWithConfig(&driver, MockTime.now, .{
+        .debounce_samples = 3,
+    });
+
+    // Two-sample glitch: rejected
+    driver.samples = &.{ 4095, 300, 300, 4095 };
+    MockTime.t = 100;
+    try std.testing.expectEqual(@as(usize, 4), btns.sampleBatch(4, 5));
+    try std.testing.expect(btns.nextEvent() == null);
+    try std.testing.expect(btns.isIdle());
+
+    // Press accepted on the third sample, stamped 5ms before the batch read
+    driver.samples = &.{ 4095, 300, 300, 300, 300 };
+    MockTime.t = 200;
+    _ = btns.sampleBatch(5, 5);
+    const event = btns.nextEvent().?;
+    try std.testing.expectEqual(ButtonAction.press, event.action);
+    try std.testing.expectEqual(@as(u64, 195), event.timestamp_ms);
+    try std.testing.expect(!btns.isIdle());
+}
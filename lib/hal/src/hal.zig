@@ -61,6 +61,8 @@
 pub const Board = @import("board.zig").Board;
 /// Simple event queue
 pub const SimpleQueue = @import("board.zig").SimpleQueue;
+/// Tickless scheduler for board loops (hal.tickless.Scheduler)
+pub const tickless = @import("tickless.zig");
 
 // ============================================================================
 // Trait Module (re-exported for convenience)
@@ -79,10 +81,14 @@ pub const led_strip = @import("led_strip.zig");
 pub const button = @import("button.zig");
 /// Button Group module (hal.button_group.from, hal.button_group.is)
 pub const button_group = @import("button_group.zig");
+/// Batched ADC sampling engine shared by button groups (hal.adc_sampler.Engine)
+pub const adc_sampler = @import("input").sampler;
 /// Button Matrix module (hal.button_matrix.from, hal.button_matrix.is)
 pub const button_matrix = @import("button_matrix.zig");
 /// WiFi module (hal.wifi.from, hal.wifi.is)
 pub const wifi = @import("wifi.zig");
+/// WiFi connection policy: priorities, backoff, roaming, power save (hal.wifi_manager.Manager)
+pub const wifi_manager = @import("wifi_manager.zig");
 /// Net module (hal.net.from, hal.net.is)
 pub const net = @import("net.zig");
 /// RTC module (hal.rtc.reader.from, hal.rtc.writer.from)
@@ -268,8 +274,10 @@ test {
     const std = @import("std");
     std.testing.refAllDecls(@This());
     _ = @import("board.zig");
+    _ = @import("tickless.zig");
     _ = @import("button_group.zig");
     _ = @import("wifi.zig");
+    _ = @import("wifi_manager.zig");
     _ = @import("net.zig");
     _ = @import("rtc.zig");
     _ = @import("led.zig");
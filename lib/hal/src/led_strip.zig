@@ -690,6 +690,9 @@ pub fn LedStripController(comptime Config: type) type {
         pub const KF = Keyframe(led_count);
         pub const FX = Effects(led_count);
 
+        /// Interpolation step of eased frames, as reported by `nextTickMs`
+        pub const ease_step_ms: u32 = if (@hasDecl(Config, "ease_step_ms")) Config.ease_step_ms else 20;
+
         /// Function type for writing colors to hardware
         pub const WriteFn = *const fn (*const [led_count]Color) void;
 
@@ -886,6 +889,27 @@ pub fn LedStripController(comptime Config: type) type {
             self.write_fn(&output);
         }
 
+        /// When `tick` next has something to change, for tickless loops:
+        /// the overlay timeout, the next interpolation step of an eased
+        /// frame, or the end of the current frame. Null while the output
+        /// is static (nothing playing, paused, disabled, held frame).
+        pub fn nextTickMs(self: Self, now_ms: u64) ?u64 {
+            if (!self.enabled) return null;
+            if (self.overlay != null) {
+                return if (self.overlay_timeout_ms > 0) self.overlay_timeout_ms else null;
+            }
+            if (!self.playing or self.paused or self.animation.isEmpty()) return null;
+            if (self.frame_start_ms == 0) return now_ms;
+
+            const frame = self.animation.frames[self.current_frame];
+            if (frame.duration_ms == 0xFFFF) return null;
+            const end = self.frame_start_ms + frame.duration_ms;
+            if (frame.easing != .none and frame.duration_ms > 0) {
+                return @max(now_ms, @min(end, now_ms + ease_step_ms));
+            }
+            return @max(now_ms, end);
+        }
+
         /// Get current colors (before brightness adjustment)
         pub fn getCurrentColors(self: Self) [led_count]Color {
             return self.current_colors;
@@ -1022,6 +1046,38 @@ test "LedStripController basics" {
     try std.testing.expectEqual(Color.red, test_output[0]);
 }
 
+test "LedStripController nextTickMs" {
+    const Config = struct {
+        pub const led_count = 2;
+        pub const max_frames = 4;
+    };
+    const Controller = LedStripController(Config);
+    var ctrl = Controller.init(&testWriteFn);
+
+    try std.testing.expectEqual(@as(?u64, null), ctrl.nextTickMs(0));
+
+    // Flashing: wake at each frame boundary only
+    ctrl.playKeyframes(&Controller.FX.flash(Color.red, 500), true);
+    try std.testing.expectEqual(@as(?u64, 1000), ctrl.nextTickMs(1000));
+    ctrl.tick(1000);
+    try std.testing.expectEqual(@as(?u64, 1500), ctrl.nextTickMs(1010));
+
+    // Eased frames step at ease_step_ms
+    ctrl.playKeyframes(&.{Controller.KF.solidEased(Color.blue, 300, .ease_in_out)}, true);
+    ctrl.tick(2000);
+    try std.testing.expectEqual(@as(?u64, 2020), ctrl.nextTickMs(2000));
+    try std.testing.expectEqual(@as(?u64, 2300), ctrl.nextTickMs(2290));
+
+    // A held solid colour and an untimed overlay are static
+    ctrl.playKeyframes(&Controller.FX.solid(Color.green), false);
+    ctrl.tick(3000);
+    try std.testing.expectEqual(@as(?u64, null), ctrl.nextTickMs(3000));
+    ctrl.setOverlaySolid(Color.white, 0, 3000);
+    try std.testing.expectEqual(@as(?u64, null), ctrl.nextTickMs(3000));
+    ctrl.setOverlaySolid(Color.white, 200, 3000);
+    try std.testing.expectEqual(@as(?u64, 3200), ctrl.nextTickMs(3000));
+}
+
 test "RgbLedStrip with mock driver" {
     // Mock driver implementation
     const MockDriver = struct {
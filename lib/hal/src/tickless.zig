@@ -0,0 +1,224 @@
+//! Tickless Scheduler
+//!
+//! Replaces the fixed `sleepMs(10)` board loop with one shared deadline.
+//! Each periodic job (button polling, battery ADC, LED animation, UI
+//! frames) registers a period and a slack — how late it may run. The
+//! scheduler wakes at the earliest point where some job would otherwise
+//! run too late, and runs every job that is already due at that point, so
+//! jobs whose windows overlap share one wakeup.
+//!
+//! Periodic deadlines sit on a grid of their period (multiples of
+//! `period_ms` since boot), so jobs with harmonic periods line up on the
+//! same instants. Jobs with work only some of the time (an LED animation
+//! that settles on a static colour, a UI that is not dirty) schedule
+//! one-shot deadlines with `at`, or none at all.
+//!
+//! ```zig
+//! const Job = enum { buttons, battery, leds, ui };
+//! var sched = hal.tickless.Scheduler(Job).init();
+//! sched.every(.buttons, 20, 10, board.uptime());
+//! sched.every(.battery, 1000, 500, board.uptime());
+//!
+//! while (Board.isRunning()) {
+//!     const now = board.uptime();
+//!     const due = sched.due(now);
+//!     if (due.contains(.buttons)) board.buttons.poll();
+//!     if (due.contains(.battery)) readBattery();
+//!     if (due.contains(.leds)) leds.tick(now);
+//!     sched.at(.leds, leds.nextTickMs(now), 5);
+//!     while (board.nextEvent()) |event| handle(event);
+//!     board.sleepUntilDue(&sched, 1000);
+//! }
+//! ```
+
+const std = @import("std");
+
+/// Wakeup counters
+pub const Stats = struct {
+    /// Calls to `due` that ran at least one job
+    wakeups: u64 = 0,
+    /// Job runs handed out
+    runs: u64 = 0,
+    /// Latest a job ran after its deadline
+    max_late_ms: u64 = 0,
+};
+
+/// Scheduler for the jobs named by the fields of `Job` (an enum).
+pub fn Scheduler(comptime Job: type) type {
+    if (@typeInfo(Job) != .@"enum") @compileError("tickless.Scheduler expects an enum of jobs");
+
+    return struct {
+        const Self = @This();
+
+        pub const Due = std.EnumSet(Job);
+
+        const Entry = struct {
+            /// Earliest run time; null when the job is not scheduled
+            deadline: ?u64 = null,
+            /// 0 for one-shot deadlines
+            period_ms: u32 = 0,
+            slack_ms: u32 = 0,
+        };
+
+        entries: std.EnumArray(Job, Entry),
+        stats: Stats = .{},
+
+        pub fn init() Self {
+            return .{ .entries = std.EnumArray(Job, Entry).initFill(.{}) };
+        }
+
+        /// Run `job` every `period_ms`, at most `slack_ms` late. The first
+        /// deadline is the next multiple of the period after `now_ms`.
+        pub fn every(self: *Self, job: Job, period_ms: u32, slack_ms: u32, now_ms: u64) void {
+            std.debug.assert(period_ms > 0);
+            const e = self.entries.getPtr(job);
+            if (e.period_ms == period_ms and e.deadline != null) {
+                e.slack_ms = slack_ms;
+                return;
+            }
+            e.* = .{
+                .deadline = nextMultiple(now_ms, period_ms),
+                .period_ms = period_ms,
+                .slack_ms = slack_ms,
+            };
+        }
+
+        /// Run `job` once at `deadline_ms` (at most `slack_ms` late), or
+        /// not at all when null. Replaces any periodic schedule.
+        pub fn at(self: *Self, job: Job, deadline_ms: ?u64, slack_ms: u32) void {
+            self.entries.set(job, .{ .deadline = deadline_ms, .slack_ms = slack_ms });
+        }
+
+        pub fn cancel(self: *Self, job: Job) void {
+            self.entries.set(job, .{});
+        }
+
+        pub fn isScheduled(self: *const Self, job: Job) bool {
+            return self.entries.get(job).deadline != null;
+        }
+
+        /// Latest time the loop may sleep until: the earliest
+        /// `deadline + slack` over all scheduled jobs. Null when nothing is
+        /// scheduled and only an interrupt or event can create work.
+        pub fn nextWakeup(self: *const Self) ?u64 {
+            var next: ?u64 = null;
+            for (self.entries.values) |e| {
+                const d = e.deadline orelse continue;
+                const latest = d + e.slack_ms;
+                if (next == null or latest < next.?) next = latest;
+            }
+            return next;
+        }
+
+        /// Milliseconds to sleep from `now_ms`, capped at `max_ms`.
+        pub fn sleepMs(self: *const Self, now_ms: u64, max_ms: u32) u32 {
+            const next = self.nextWakeup() orelse return max_ms;
+            if (next <= now_ms) return 0;
+            return @intCast(@min(next - now_ms, max_ms));
+        }
+
+        /// Jobs whose deadline has passed. Periodic jobs move to their next
+        /// grid point after `now_ms` (missed periods are skipped, not
+        /// replayed); one-shot jobs are unscheduled.
+        pub fn due(self: *Self, now_ms: u64) Due {
+            var set = Due.initEmpty();
+            var it = self.entries.iterator();
+            while (it.next()) |kv| {
+                const e = kv.value;
+                const d = e.deadline orelse continue;
+                if (d > now_ms) continue;
+                set.insert(kv.key);
+                self.stats.max_late_ms = @max(self.stats.max_late_ms, now_ms - d);
+                e.deadline = if (e.period_ms == 0) null else nextMultiple(now_ms, e.period_ms);
+            }
+            const n = set.count();
+            if (n > 0) {
+                self.stats.wakeups += 1;
+                self.stats.runs += n;
+            }
+            return set;
+        }
+
+        fn nextMultiple(now_ms: u64, period_ms: u32) u64 {
+            return (now_ms / period_ms + 1) * period_ms;
+        }
+    };
+}
+
+// ============================================================================
+// Tests
+// ============================================================================
+
+const testing = std.testing;
+
+const TestJob = enum { buttons, battery, leds };
+
+test "periodic jobs sit on their period grid" {
+    var s = Scheduler(TestJob).init();
+    s.every(.buttons, 20, 0, 7);
+    s.every(.battery, 1000, 0, 7);
+    try testing.expectEqual(@as(?u64, 20), s.nextWakeup());
+    try testing.expect(s.due(19).count() == 0);
+
+    const d = s.due(20);
+    try testing.expect(d.contains(.buttons) and !d.contains(.battery));
+    try testing.expectEqual(@as(?u64, 40), s.nextWakeup());
+
+    // Missed periods are skipped
+    _ = s.due(95);
+    try testing.expectEqual(@as(?u64, 100), s.nextWakeup());
+    try testing.expectEqual(@as(u64, 55), s.stats.max_late_ms);
+}
+
+test "slack lets overlapping jobs share a wakeup" {
+    var s = Scheduler(TestJob).init();
+    s.every(.buttons, 30, 15, 0);
+    s.every(.battery, 40, 25, 0);
+    // buttons: 30..45, battery: 40..65 → one wakeup at 45 runs both
+    try testing.expectEqual(@as(?u64, 45), s.nextWakeup());
+    const d = s.due(45);
+    try testing.expect(d.contains(.buttons) and d.contains(.battery));
+    try testing.expectEqual(@as(u64, 1), s.stats.wakeups);
+    try testing.expectEqual(@as(u64, 2), s.stats.runs);
+}
+
+test "one-shot deadlines and an empty schedule" {
+    var s = Scheduler(TestJob).init();
+    try testing.expectEqual(@as(?u64, null), s.nextWakeup());
+    try testing.expectEqual(@as(u32, 500), s.sleepMs(0, 500));
+
+    s.at(.leds, 120, 10);
+    try testing.expectEqual(@as(u32, 130), s.sleepMs(0, 500));
+    try testing.expectEqual(@as(u32, 0), s.sleepMs(200, 500));
+    try testing.expect(s.due(125).contains(.leds));
+    try testing.expect(!s.isScheduled(.leds));
+
+    s.at(.leds, null, 0);
+    try testing.expectEqual(@as(?u64, null), s.nextWakeup());
+}
+
+test "re-registering the same period keeps the phase" {
+    var s = Scheduler(TestJob).init();
+    s.every(.buttons, 50, 0, 0);
+    s.every(.buttons, 50, 20, 30);
+    try testing.expectEqual(@as(?u64, 70), s.nextWakeup());
+    s.every(.buttons, 10, 0, 30);
+    try testing.expectEqual(@as(?u64, 40), s.nextWakeup());
+}
+
+test "idle board wakes far less often than a 10ms loop" {
+    // Battery, temperature and slowed button polling, one minute
+    const Job = enum { buttons, battery, temp };
+    var s = Scheduler(Job).init();
+    s.every(.battery, 1000, 500, 0);
+    s.every(.temp, 5000, 2000, 0);
+    s.every(.buttons, 50, 25, 0);
+    var now: u64 = 0;
+    while (now < 60_000) {
+        now = s.nextWakeup().?;
+        _ = s.due(now);
+    }
+    try testing.expect(s.stats.wakeups * 3 < 60_000 / 10);
+    try testing.expect(s.stats.runs > s.stats.wakeups);
+    try testing.expect(s.stats.max_late_ms <= 25);
+}
@@ -0,0 +1,666 @@
+//! WiFi Connection Manager
+//!
+//! Decides when to connect, retry, switch networks, roam and change the
+//! power-save mode, so apps do not each carry their own reconnect loop.
+//!
+//! `Policy` is the state machine. It takes WiFi events, RSSI samples and
+//! the current time, and hands out `Action`s; it never touches a driver,
+//! so it runs unchanged on the host. `Manager(Wifi)` ties a Policy to a
+//! `hal.wifi` component and applies the actions.
+//!
+//! - Networks are tried by priority, then by signal in the last scan. A
+//!   network that fails `attempts_per_network` times in a row is skipped
+//!   until every visible network has had its turn.
+//! - A lost link is first retried at once on the same network (most drops
+//!   are transient), then the manager scans and selects again.
+//! - Retries back off exponentially from `backoff_initial_ms` up to
+//!   `backoff_max_ms`, spread by ±`jitter_pct` so devices that lost the
+//!   same AP do not come back in lockstep.
+//! - Below `roam_rssi` the manager scans (at most every
+//!   `roam_interval_ms`) and moves to a known AP at least
+//!   `roam_margin_db` stronger.
+//! - Power save follows traffic: `power.active` while `activity` was
+//!   reported within `power.idle_after_ms`, `power.idle` after that, never
+//!   on a weak link, and off while connecting.
+//!
+//! ```zig
+//! const networks = [_]hal.wifi_manager.Network{
+//!     .{ .ssid = "home", .password = "...", .priority = 2 },
+//!     .{ .ssid = "phone", .password = "...", .priority = 1 },
+//! };
+//! var mgr = hal.wifi_manager.Manager(@TypeOf(board.wifi)).init(&board.wifi, .{ .networks = &networks });
+//! mgr.start(board.uptime());
+//!
+//! while (Board.isRunning()) {
+//!     while (board.nextEvent()) |event| switch (event) {
+//!         .wifi => |w| mgr.handleEvent(w, board.uptime()),
+//!         else => {},
+//!     };
+//!     mgr.tick(board.uptime());
+//!     if (mgr.deadline()) |at| sched.at(.wifi, at, 50);
+//! }
+//! ```
+
+const std = @import("std");
+const wifi = @import("wifi.zig");
+
+const Mac = wifi.Mac;
+const WifiEvent = wifi.WifiEvent;
+const PowerSaveMode = wifi.PowerSaveMode;
+
+/// Most networks a Config may list
+pub const max_networks = 8;
+
+/// A known network
+pub const Network = struct {
+    ssid: []const u8,
+    password: []const u8 = "",
+    /// Higher is tried first
+    priority: u8 = 0,
+};
+
+pub const PowerPolicy = struct {
+    /// Mode while traffic is flowing
+    active: PowerSaveMode = .min_modem,
+    /// Mode after `idle_after_ms` without `activity`
+    idle: PowerSaveMode = .max_modem,
+    idle_after_ms: u32 = 10_000,
+    /// Below this RSSI stay in `active`: sleeping through beacons on a
+    /// weak link is how the AP gets lost
+    weak_rssi: i8 = -80,
+};
+
+pub const Config = struct {
+    networks: []const Network,
+    backoff_initial_ms: u32 = 1_000,
+    backoff_max_ms: u32 = 60_000,
+    /// Random spread of each backoff delay, in percent
+    jitter_pct: u8 = 20,
+    /// Consecutive failures before moving on to the next network
+    attempts_per_network: u8 = 2,
+    connect_timeout_ms: u32 = 15_000,
+    scan_timeout_ms: u32 = 5_000,
+    /// Look for a better AP below this RSSI...
+    roam_rssi: i8 = -72,
+    /// ...and move to one at least this much stronger
+    roam_margin_db: u8 = 8,
+    roam_interval_ms: u32 = 30_000,
+    /// RSSI sampling period while connected
+    rssi_sample_ms: u32 = 2_000,
+    power: PowerPolicy = .{},
+    /// Jitter seed; use a hardware random value on devices
+    seed: u64 = 0,
+};
+
+pub const Phase = enum {
+    stopped,
+    scanning,
+    connecting,
+    connected,
+    backoff,
+};
+
+pub const Action = union(enum) {
+    scan,
+    /// Join `networks[network]`, on a specific AP when `bssid` is set
+    connect: struct { network: u8, bssid: ?Mac },
+    disconnect,
+    power_save: PowerSaveMode,
+    /// Sample the link and report it with `Policy.onRssi`
+    read_rssi,
+};
+
+pub const Stats = struct {
+    connects: u32 = 0,
+    failures: u32 = 0,
+    link_losses: u32 = 0,
+    roams: u32 = 0,
+    scans: u32 = 0,
+    /// Link loss to connected again: latest, worst and summed over
+    /// `link_losses`
+    last_reconnect_ms: u64 = 0,
+    max_reconnect_ms: u64 = 0,
+    total_down_ms: u64 = 0,
+    /// Roam decision to connected on the new AP
+    last_roam_ms: u64 = 0,
+};
+
+const Candidate = struct {
+    bssid: Mac,
+    rssi: i8,
+};
+
+pub const Policy = struct {
+    const Self = @This();
+
+    config: Config,
+    phase: Phase = .stopped,
+    stats: Stats = .{},
+    prng: std.Random.DefaultPrng,
+
+    /// Network of the current attempt or link
+    network: ?u8 = null,
+    failures: [max_networks]u8 = .{0} ** max_networks,
+    /// Strongest AP per network in the last scan
+    seen: [max_networks]?Candidate = .{null} ** max_networks,
+    backoff_round: u8 = 0,
+    /// Connect or scan timeout, or end of backoff
+    phase_deadline: u64 = 0,
+    scan_supported: bool = true,
+
+    /// First attempt after a link loss, straight to the old network
+    fast_retry: bool = false,
+    link_lost_at: ?u64 = null,
+
+    rssi: ?i8 = null,
+    bssid: ?Mac = null,
+    next_rssi_sample: u64 = 0,
+    roam_scan_deadline: ?u64 = null,
+    last_roam_scan: ?u64 = null,
+    roam_started: ?u64 = null,
+
+    last_activity: u64 = 0,
+    power: ?PowerSaveMode = null,
+
+    queue: [4]Action = undefined,
+    queued: u8 = 0,
+
+    pub fn init(config: Config) Self {
+        std.debug.assert(config.networks.len > 0 and config.networks.len <= max_networks);
+        return .{ .config = config, .prng = .init(config.seed) };
+    }
+
+    pub fn start(self: *Self, now_ms: u64) void {
+        if (self.phase != .stopped) return;
+        self.last_activity = now_ms;
+        self.beginSelect(now_ms);
+    }
+
+    pub fn stop(self: *Self) void {
+        if (self.phase == .stopped) return;
+        self.phase = .stopped;
+        self.network = null;
+        self.fast_retry = false;
+        self.link_lost_at = null;
+        self.roam_scan_deadline = null;
+        self.roam_started = null;
+        self.push(.disconnect);
+    }
+
+    /// Traffic on the link; keeps power save in `power.active`
+    pub fn activity(self: *Self, now_ms: u64) void {
+        self.last_activity = now_ms;
+    }
+
+    /// The driver cannot scan: select by priority alone from now on
+    pub fn scanUnsupported(self: *Self, now_ms: u64) void {
+        self.scan_supported = false;
+        self.roam_scan_deadline = null;
+        if (self.phase == .scanning) self.select(now_ms);
+    }
+
+    pub fn onEvent(self: *Self, event: WifiEvent, now_ms: u64) void {
+        if (self.phase == .stopped) return;
+        switch (event) {
+            .connected => if (self.phase == .connecting) self.linkUp(now_ms),
+            .disconnected => |reason| switch (self.phase) {
+                .connected => self.linkLost(now_ms),
+                // Our own disconnect (roam, timeout) surfacing late
+                .connecting => if (reason != .user_request) self.attemptFailed(now_ms),
+                else => {},
+            },
+            .connection_failed => if (self.phase == .connecting) self.attemptFailed(now_ms),
+            .scan_result => |ap| if (self.phase == .scanning or self.roam_scan_deadline != null) self.record(&ap),
+            .scan_done => if (self.phase == .scanning) {
+                self.select(now_ms);
+            } else if (self.roam_scan_deadline != null) {
+                self.roam_scan_deadline = null;
+                self.decideRoam(now_ms);
+            },
+            .rssi_low => |rssi| self.onRssi(rssi, self.bssid, now_ms),
+            else => {},
+        }
+    }
+
+    /// Link quality sample (after `read_rssi`, or from an `rssi_low` event)
+    pub fn onRssi(self: *Self, rssi: i8, bssid: ?Mac, now_ms: u64) void {
+        self.rssi = rssi;
+        self.bssid = bssid;
+        if (self.phase != .connected or !self.scan_supported or self.roam_scan_deadline != null) return;
+        if (rssi >= self.config.roam_rssi) return;
+        if (self.last_roam_scan) |t| if (now_ms - t < self.config.roam_interval_ms) return;
+
+        self.last_roam_scan = now_ms;
+        self.roam_scan_deadline = now_ms + self.config.scan_timeout_ms;
+        self.seen = .{null} ** max_networks;
+        self.stats.scans += 1;
+        self.push(.scan);
+    }
+
+    /// Next action to apply at `now_ms`, or null when there is nothing
+    /// to do until `deadline()`
+    pub fn next(self: *Self, now_ms: u64) ?Action {
+        if (self.pop()) |a| return a;
+
+        switch (self.phase) {
+            .connecting => if (now_ms >= self.phase_deadline) {
+                self.push(.disconnect);
+                self.attemptFailed(now_ms);
+            },
+            .scanning => if (now_ms >= self.phase_deadline) self.select(now_ms),
+            .backoff => if (now_ms >= self.phase_deadline) self.beginSelect(now_ms),
+            .connected => {
+                if (self.roam_scan_deadline) |d| if (now_ms >= d) {
+                    self.roam_scan_deadline = null;
+                }
+                if (now_ms >= self.next_rssi_sample) {
+                    self.next_rssi_sample = now_ms + self.config.rssi_sample_ms;
+                    self.push(.read_rssi);
+                }
+            },
+            .stopped => return null,
+        }
+
+        const mode = self.desiredPower(now_ms);
+        if (self.power != mode) {
+            self.power = mode;
+            self.push(.{ .power_save = mode });
+        }
+        return self.pop();
+    }
+
+    /// Earliest time `next` has something to do; null when stopped
+    pub fn deadline(self: *const Self) ?u64 {
+        if (self.queued > 0) return 0;
+        return switch (self.phase) {
+            .stopped => null,
+            .scanning, .connecting, .backoff => self.phase_deadline,
+            .connected => blk: {
+                var at = self.next_rssi_sample;
+                if (self.roam_scan_deadline) |d| at = @min(at, d);
+                // Going idle is only due when it would change the mode: a
+                // weak link stays in `power.active` however quiet it is
+                if (self.power != self.config.power.idle and !self.weakLink()) {
+                    at = @min(at, self.last_activity + self.config.power.idle_after_ms);
+                }
+                break :blk at;
+            },
+        };
+    }
+
+    /// Backoff delay of the current round, jitter included
+    pub fn backoffDelay(self: *Self) u64 {
+        const shift: u6 = @intCast(@min(self.backoff_round, 20));
+        const base = @min(@as(u64, self.config.backoff_initial_ms) << shift, self.config.backoff_max_ms);
+        const spread = base * self.config.jitter_pct / 100;
+        if (spread == 0) return base;
+        return base - spread + self.prng.random().uintAtMost(u64, 2 * spread);
+    }
+
+    // ========================================================================
+    // Transitions
+    // ========================================================================
+
+    fn beginSelect(self: *Self, now_ms: u64) void {
+        if (!self.scan_supported) return self.select(now_ms);
+        self.phase = .scanning;
+        self.phase_deadline = now_ms + self.config.scan_timeout_ms;
+        self.seen = .{null} ** max_networks;
+        self.stats.scans += 1;
+        self.push(.scan);
+    }
+
+    /// Connect to the best eligible network, or back off
+    fn select(self: *Self, now_ms: u64) void {
+        if (self.best()) |n| return self.connectTo(n, if (self.seen[n]) |c| c.bssid else null, now_ms);
+
+        // Everything visible has used its attempts: start a new round
+        self.failures = .{0} ** max_networks;
+        self.phase = .backoff;
+        self.phase_deadline = now_ms + self.backoffDelay();
+        self.backoff_round +|= 1;
+    }
+
+    fn best(self: *const Self) ?u8 {
+        var pick: ?u8 = null;
+        for (self.config.networks, 0..) |net, i| {
+            if (self.failures[i] >= self.config.attempts_per_network) continue;
+            if (self.scan_supported and self.seen[i] == null) continue;
+            if (pick) |p| {
+                const cur = self.config.networks[p];
+                if (net.priority < cur.priority) continue;
+                if (net.priority == cur.priority and rssiOf(self.seen[i]) <= rssiOf(self.seen[p])) continue;
+            }
+            pick = @intCast(i);
+        }
+        return pick;
+    }
+
+    fn connectTo(self: *Self, network: u8, bssid: ?Mac, now_ms: u64) void {
+        self.network = network;
+        self.phase = .connecting;
+        self.phase_deadline = now_ms + self.config.connect_timeout_ms;
+        self.push(.{ .connect = .{ .network = network, .bssid = bssid } });
+    }
+
+    fn linkUp(self: *Self, now_ms: u64) void {
+        self.phase = .connected;
+        self.stats.connects += 1;
+        if (self.network) |n| self.failures[n] = 0;
+        self.backoff_round = 0;
+        self.fast_retry = false;
+        self.rssi = null;
+        self.next_rssi_sample = now_ms;
+
+        if (self.link_lost_at) |t| {
+            const down = now_ms - t;
+            self.stats.last_reconnect_ms = down;
+            self.stats.max_reconnect_ms = @max(self.stats.max_reconnect_ms, down);
+            self.stats.total_down_ms += down;
+            self.link_lost_at = null;
+        }
+        if (self.roam_started) |t| {
+            self.stats.last_roam_ms = now_ms - t;
+            self.roam_started = null;
+        }
+    }
+
+    fn linkLost(self: *Self, now_ms: u64) void {
+        self.stats.link_losses += 1;
+        self.link_lost_at = now_ms;
+        self.roam_scan_deadline = null;
+        self.fast_retry = true;
+        self.connectTo(self.network orelse 0, null, now_ms);
+    }
+
+    fn attemptFailed(self: *Self, now_ms: u64) void {
+        self.stats.failures += 1;
+        if (self.network) |n| self.failures[n] +|= 1;
+
+        if (self.roam_started != null) {
+            // The old link is gone too
+            self.roam_started = null;
+            if (self.link_lost_at == null) self.link_lost_at = now_ms;
+        }
+        if (self.fast_retry) {
+            self.fast_retry = false;
+            return self.beginSelect(now_ms);
+        }
+        self.select(now_ms);
+    }
+
+    fn record(self: *Self, ap: *const wifi.ApInfo) void {
+        // A roam scan is looking for somewhere else to go
+        if (self.phase == .connected) if (self.bssid) |b| if (std.mem.eql(u8, &b, &ap.bssid)) return;
+        for (self.config.networks, 0..) |net, i| {
+            if (!std.mem.eql(u8, net.ssid, ap.getSsid())) continue;
+            if (self.seen[i]) |c| if (c.rssi >= ap.rssi) return;
+            self.seen[i] = .{ .bssid = ap.bssid, .rssi = ap.rssi };
+            return;
+        }
+    }
+
+    fn decideRoam(self: *Self, now_ms: u64) void {
+        const current = self.rssi orelse return;
+        var pick: ?u8 = null;
+        for (self.seen, 0..) |maybe, i| {
+            const c = maybe orelse continue;
+            if (self.bssid) |b| if (std.mem.eql(u8, &b, &c.bssid)) continue;
+            if (@as(i16, c.rssi) < @as(i16, current) + @as(i16, self.config.roam_margin_db)) continue;
+            if (pick) |p| if (c.rssi <= self.seen[p].?.rssi) continue;
+            pick = @intCast(i);
+        }
+        const n = pick orelse return;
+        self.stats.roams += 1;
+        self.roam_started = now_ms;
+        self.connectTo(n, self.seen[n].?.bssid, now_ms);
+    }
+
+    fn desiredPower(self: *const Self, now_ms: u64) PowerSaveMode {
+        if (self.phase != .connected) return .none;
+        const p = self.config.power;
+        if (self.weakLink()) return p.active;
+        return if (now_ms - self.last_activity < p.idle_after_ms) p.active else p.idle;
+    }
+
+    fn weakLink(self: *const Self) bool {
+        const r = self.rssi orelse return false;
+        return r < self.config.power.weak_rssi;
+    }
+
+    fn rssiOf(c: ?Candidate) i8 {
+        return if (c) |v| v.rssi else std.math.minInt(i8);
+    }
+
+    fn push(self: *Self, action: Action) void {
+        std.debug.assert(self.queued < self.queue.len);
+        self.queue[self.queued] = action;
+        self.queued += 1;
+    }
+
+    fn pop(self: *Self) ?Action {
+        if (self.queued == 0) return null;
+        const a = self.queue[0];
+        std.mem.copyForwards(Action, self.queue[0 .. self.queued - 1], self.queue[1..self.queued]);
+        self.queued -= 1;
+        return a;
+    }
+};
+
+/// Drives a `hal.wifi` component (or anything with its methods) with a
+/// Policy. Feed it the board's wifi events and call `tick` when
+/// `deadline` comes due.
+pub fn Manager(comptime Wifi: type) type {
+    return struct {
+        const Self = @This();
+
+        wifi: *Wifi,
+        policy: Policy,
+
+        pub fn init(w: *Wifi, config: Config) Self {
+            return .{ .wifi = w, .policy = .init(config) };
+        }
+
+        pub fn start(self: *Self, now_ms: u64) void {
+            self.policy.start(now_ms);
+            self.tick(now_ms);
+        }
+
+        pub fn stop(self: *Self, now_ms: u64) void {
+            self.policy.stop();
+            self.tick(now_ms);
+        }
+
+        pub fn handleEvent(self: *Self, event: WifiEvent, now_ms: u64) void {
+            self.policy.onEvent(event, now_ms);
+            self.tick(now_ms);
+        }
+
+        pub fn activity(self: *Self, now_ms: u64) void {
+            self.policy.activity(now_ms);
+        }
+
+        pub fn tick(self: *Self, now_ms: u64) void {
+            while (self.policy.next(now_ms)) |action| self.apply(action, now_ms);
+        }
+
+        pub fn deadline(self: *const Self) ?u64 {
+            return self.policy.deadline();
+        }
+
+        pub fn phase(self: *const Self) Phase {
+            return self.policy.phase;
+        }
+
+        pub fn stats(self: *const Self) Stats {
+            return self.policy.stats;
+        }
+
+        fn apply(self: *Self, action: Action, now_ms: u64) void {
+            switch (action) {
+                // Any other error leaves the scan to time out
+                .scan => self.wifi.scanStart(.{}) catch |err| {
+                    if (err == error.NotSupported) self.policy.scanUnsupported(now_ms);
+                },
+                .connect => |c| {
+                    const net = self.policy.config.networks[c.network];
+                    self.wifi.connectWithConfig(.{
+                        .ssid = net.ssid,
+                        .password = net.password,
+                        .bssid = c.bssid,
+                        .timeout_ms = self.policy.config.connect_timeout_ms,
+                    });
+                },
+                .disconnect => self.wifi.disconnect(),
+                .power_save => |mode| self.wifi.setPowerSave(mode),
+                .read_rssi => if (self.wifi.getRssi()) |rssi| {
+                    self.policy.onRssi(rssi, self.wifi.getBssid(), now_ms);
+                },
+            }
+        }
+    };
+}
+
+// ============================================================================
+// Tests
+// ============================================================================
+
+const testing = std.testing;
+
+fn apInfo(ssid: []const u8, bssid: u8, rssi: i8) wifi.ApInfo {
+    var ap = wifi.ApInfo{
+        .ssid = undefined,
+        .ssid_len = @intCast(ssid.len),
+        .bssid = .{ 0x02, 0, 0, 0, 0, bssid },
+        .channel = 6,
+        .rssi = rssi,
+        .auth_mode = .wpa2_psk,
+    };
+    @memcpy(ap.ssid[0..ssid.len], ssid);
+    return ap;
+}
+
+fn drain(p: *Policy, now: u64, out: []Action) []Action {
+    var n: usize = 0;
+    while (p.next(now)) |a| : (n += 1) out[n] = a;
+    return out[0..n];
+}
+
+test "selects by priority, then signal, and moves on after failures" {
+    const nets = [_]Network{
+        .{ .ssid = "cafe", .priority = 1 },
+        .{ .ssid = "home", .priority = 2 },
+        .{ .ssid = "lab", .priority = 2 },
+    };
+    var p = Policy.init(.{ .networks = &nets, .attempts_per_network = 1 });
+    var buf: [8]Action = undefined;
+
+    p.start(0);
+    try testing.expectEqual(Action.scan, drain(&p, 0, &buf)[0]);
+    p.onEvent(.{ .scan_result = apInfo("cafe", 1, -40) }, 100);
+    p.onEvent(.{ .scan_result = apInfo("home", 2, -70) }, 100);
+    p.onEvent(.{ .scan_result = apInfo("lab", 3, -60) }, 100);
+    p.onEvent(.{ .scan_done = .{ .success = true } }, 100);
+
+    // lab: top priority, stronger than home
+    var acts = drain(&p, 100, &buf);
+    try testing.expectEqual(@as(u8, 2), acts[0].connect.network);
+    try testing.expectEqual(@as(u8, 3), acts[0].connect.bssid.?[5]);
+
+    p.onEvent(.{ .connection_failed = .auth_failed }, 600);
+    acts = drain(&p, 600, &buf);
+    try testing.expectEqual(@as(u8, 1), acts[0].connect.network);
+
+    p.onEvent(.{ .connection_failed = .timeout }, 1100);
+    acts = drain(&p, 1100, &buf);
+    try testing.expectEqual(@as(u8, 0), acts[0].connect.network);
+
+    p.onEvent(.{ .connected = {} }, 1600);
+    try testing.expectEqual(Phase.connected, p.phase);
+    try testing.expectEqual(@as(u32, 2), p.stats.failures);
+}
+
+test "backoff doubles up to the cap, within the jitter band" {
+    const nets = [_]Network{.{ .ssid = "home" }};
+    var p = Policy.init(.{ .networks = &nets, .backoff_initial_ms = 1000, .backoff_max_ms = 8000, .jitter_pct = 25, .seed = 7 });
+
+    const expected = [_]u64{ 1000, 2000, 4000, 8000, 8000, 8000 };
+    for (expected, 0..) |base, round| {
+        p.backoff_round = @intCast(round);
+        for (0..50) |_| {
+            const d = p.backoffDelay();
+            try testing.expect(d >= base * 3 / 4 and d <= base * 5 / 4);
+        }
+    }
+}
+
+test "lost link retries the same network first and measures the outage" {
+    const nets = [_]Network{.{ .ssid = "home" }};
+    var p = Policy.init(.{ .networks = &nets });
+    var buf: [8]Action = undefined;
+
+    p.start(0);
+    _ = drain(&p, 0, &buf);
+    p.onEvent(.{ .scan_result = apInfo("home", 1, -50) }, 1000);
+    p.onEvent(.{ .scan_done = .{ .success = true } }, 1000);
+    _ = drain(&p, 1000, &buf);
+    p.onEvent(.{ .connected = {} }, 1500);
+    _ = drain(&p, 1500, &buf);
+
+    p.onEvent(.{ .disconnected = .connection_lost }, 5000);
+    const acts = drain(&p, 5000, &buf);
+    try testing.expect(acts[0] == .connect);
+    try testing.expectEqual(@as(?Mac, null), acts[0].connect.bssid);
+
+    p.onEvent(.{ .connected = {} }, 5400);
+    try testing.expectEqual(@as(u64, 400), p.stats.last_reconnect_ms);
+    try testing.expectEqual(@as(u32, 1), p.stats.link_losses);
+}
+
+test "power save follows activity and link strength" {
+    const nets = [_]Network{.{ .ssid = "home" }};
+    var p = Policy.init(.{ .networks = &nets, .power = .{ .idle_after_ms = 1000 } });
+    var buf: [8]Action = undefined;
+
+    p.start(0);
+    _ = drain(&p, 0, &buf);
+    p.onEvent(.{ .scan_result = apInfo("home", 1, -50) }, 100);
+    p.onEvent(.{ .scan_done = .{ .success = true } }, 100);
+    _ = drain(&p, 100, &buf);
+    p.onEvent(.{ .connected = {} }, 500);
+
+    var acts = drain(&p, 500, &buf);
+    try testing.expectEqual(Action{ .power_save = .min_modem }, acts[acts.len - 1]);
+    acts = drain(&p, 1200, &buf);
+    try testing.expectEqual(Action{ .power_save = .max_modem }, acts[acts.len - 1]);
+
+    // Weak link: the roam scan goes out, and power save stays shallow
+    p.onRssi(-85, null, 1300);
+    acts = drain(&p, 1300, &buf);
+    try testing.expectEqual(Action.scan, acts[0]);
+    try testing.expectEqual(Action{ .power_save = .min_modem }, acts[acts.len - 1]);
+}
+
+test "a weak idle link does not keep the idle deadline due" {
+    const nets = [_]Network{.{ .ssid = "home" }};
+    var p = Policy.init(.{ .networks = &nets, .power = .{ .idle_after_ms = 1000 }, .rssi_sample_ms = 5000 });
+    var buf: [8]Action = undefined;
+
+    p.start(0);
+    _ = drain(&p, 0, &buf);
+    p.onEvent(.{ .scan_result = apInfo("home", 1, -50) }, 100);
+    p.onEvent(.{ .scan_done = .{ .success = true } }, 100);
+    _ = drain(&p, 100, &buf);
+    p.onEvent(.{ .connected = {} }, 500);
+    _ = drain(&p, 500, &buf);
+    // Quiet but strong: going idle is the next thing due
+    try testing.expectEqual(@as(?u64, 1000), p.deadline());
+
+    // Weak and quiet for long: only the next RSSI sample is due
+    p.onRssi(-85, null, 600);
+    _ = drain(&p, 600, &buf);
+    _ = drain(&p, 3000, &buf);
+    try testing.expectEqual(PowerSaveMode.min_modem, p.power.?);
+    try testing.expectEqual(@as(?u64, 5500), p.deadline());
+    try testing.expectEqual(@as(?Action, null), p.next(3000));
+}
@@ -0,0 +1,75 @@
+const std = @import("std");
+const hal = @import("hal");
+const print = std.debug.print;
+const testing = std.testing;
+
+const Scheduler = hal.tickless.Scheduler;
+const Stats = hal.tickless.Stats;
+
+// ============================================================================
+// BM1: host simulation
+// ============================================================================
+
+/// Typical battery board: ADC button group, battery ADC, temperature
+/// sensor, a breathing status LED that settles on a static colour, and a
+/// 30fps UI that only renders while dirty. One simulated minute: the
+/// first 10s are interactive (button held, animation and UI active),
+/// the remaining 50s idle.
+const Sim = struct {
+    const Job = enum { buttons, battery, temp, leds, ui };
+    const duration_ms = 60_000;
+    const active_until_ms = 10_000;
+
+    /// Fixed board loop: every peripheral checked on a 10ms sleep
+    fn fixedLoop() u64 {
+        return duration_ms / 10;
+    }
+
+    /// Each peripheral task on its own timer, always running
+    fn perTask() u64 {
+        const periods = [_]u64{ 10, 1000, 5000, 20, 33 };
+        var n: u64 = 0;
+        for (periods) |p| n += duration_ms / p;
+        return n;
+    }
+
+    /// Tickless: shared deadline with slack; button polling slows from
+    /// 20ms to 50ms when nothing is pressed, LED and UI only schedule
+    /// while they have something to show.
+    fn tickless() Stats {
+        var s = Scheduler(Job).init();
+        var now: u64 = 0;
+        s.every(.battery, 1000, 500, now);
+        s.every(.temp, 5000, 2000, now);
+        while (now < duration_ms) {
+            if (now < active_until_ms) {
+                s.every(.buttons, 20, 10, now);
+                s.every(.leds, 20, 5, now);
+                s.every(.ui, 33, 8, now);
+            } else {
+                s.every(.buttons, 50, 25, now);
+                s.cancel(.leds);
+                s.cancel(.ui);
+            }
+            now = s.nextWakeup() orelse duration_ms;
+            _ = s.due(now);
+        }
+        return s.stats;
+    }
+};
+
+test "BM1: wakeups per second on a typical board" {
+    const secs = Sim.duration_ms / 1000;
+    const stats = Sim.tickless();
+    print("\n[bench] wakeups/s over {d}s (10s active, 50s idle)\n", .{secs});
+    print("[bench]   fixed 10ms board loop   {d:>6.1}\n", .{@as(f64, @floatFromInt(Sim.fixedLoop())) / secs});
+    print("[bench]   one timer per task      {d:>6.1}\n", .{@as(f64, @floatFromInt(Sim.perTask())) / secs});
+    print("[bench]   tickless                {d:>6.1}  ({d:.2} jobs/wakeup, max {d}ms late)\n", .{
+        @as(f64, @floatFromInt(stats.wakeups)) / secs,
+        @as(f64, @floatFromInt(stats.runs)) / @as(f64, @floatFromInt(stats.wakeups)),
+        stats.max_late_ms,
+    });
+
+    try testing.expect(stats.wakeups * 3 < Sim.fixedLoop());
+    try testing.expect(stats.max_late_ms <= 25);
+}
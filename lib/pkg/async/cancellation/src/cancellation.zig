@@ -1,8 +1,13 @@
-//! CancellationToken — Cooperative cancellation signal
+//! Cancellation — CancellationToken and wakeable Scopes
 //!
 //! Pure atomic implementation, zero dependencies beyond Zig builtins.
 //! Used to signal long-running tasks to exit gracefully.
 //!
+//! `CancellationToken` is a bare flag that tasks poll. `Scope` adds what a
+//! flag cannot: it wakes waits that are blocked right now, carries a
+//! deadline, forms a tree (cancelling a scope cancels its children) and
+//! reports why it was cancelled.
+//!
 //! ## Usage
 //!
 //! ```zig
@@ -17,6 +22,32 @@
 //! token.cancel();
 //! ```
 //!
+//! ```zig
+//! var root = Scope.init(.{ .clock = std_impl.cancel.nowNs });
+//! var request: Scope = undefined;
+//! request.initChild(&root, .{ .timeout_ns = 5 * std.time.ns_per_s });
+//! defer request.deinit();
+//!
+//! // Blocked waits return error.Cancelled when either scope is cancelled
+//! // or the 5s deadline passes:
+//! const msg = try ch.recvCancellable(&request);
+//!
+//! // Shutdown:
+//! root.cancel(.shutdown);
+//! ```
+//!
+//! ## Waking blocked waits
+//!
+//! A blocking primitive registers a `Waker` for the duration of its wait;
+//! `cancel` calls every registered waker once. Wakers run on the
+//! cancelling thread with the scope's lock held: they must not block for
+//! long and must not call back into the same scope. Register before taking
+//! the primitive's own lock and unregister after releasing it.
+//!
+//! Deadlines are absolute times on the scope's clock. A deadline passing
+//! does not cancel anything by itself; waits bound their sleep by
+//! `remainingNs` and call `checkDeadline` when it runs out.
+//!
 //! ## Thread Safety
 //!
 //! All methods are safe to call from any thread. Uses acquire/release
@@ -24,6 +55,8 @@
 
 const std = @import("std");
 
+const cancellation = @This();
+
 /// Cooperative cancellation signal using atomic boolean.
 /// Safe to share across threads without additional synchronization.
 pub const CancellationToken = struct {
@@ -50,6 +83,204 @@ pub const CancellationToken = struct {
     }
 };
 
+/// Why a scope was cancelled
+pub const Reason = enum(u8) {
+    /// Not cancelled
+    none = 0,
+    /// Plain `cancel` request
+    cancelled,
+    /// The scope's deadline (or an ancestor's) passed
+    deadline,
+    /// Orderly shutdown of the owning component
+    shutdown,
+    _,
+};
+
+/// Monotonic clock in nanoseconds, used to resolve deadlines
+pub const Clock = *const fn () u64;
+
+/// Callback registered by a blocked wait; called once on cancellation.
+pub const Waker = struct {
+    ctx: *anyopaque,
+    wakeFn: *const fn (ctx: *anyopaque) void,
+    prev: ?*Waker = null,
+    next: ?*Waker = null,
+    linked: bool = false,
+
+    pub fn init(ctx: *anyopaque, wakeFn: *const fn (ctx: *anyopaque) void) Waker {
+        return .{ .ctx = ctx, .wakeFn = wakeFn };
+    }
+};
+
+pub const Options = struct {
+    /// Clock for deadlines; children inherit their parent's when null
+    clock: ?Clock = null,
+    /// Absolute deadline on `clock`
+    deadline_ns: ?u64 = null,
+    /// Deadline relative to now, the earlier of the two wins
+    timeout_ns: ?u64 = null,
+};
+
+/// Spin lock guarding a scope's child and waker lists. Critical sections
+/// are a few pointer updates, except during `cancel`.
+const SpinLock = struct {
+    locked: std.atomic.Value(bool) = .init(false),
+
+    fn lock(self: *SpinLock) void {
+        while (self.locked.cmpxchgWeak(false, true, .acquire, .monotonic) != null) {
+            std.atomic.spinLoopHint();
+        }
+    }
+
+    fn unlock(self: *SpinLock) void {
+        self.locked.store(false, .release);
+    }
+};
+
+/// Hierarchical cancellation scope with an optional deadline.
+///
+/// A child scope must not move between `initChild` and `deinit`, and must
+/// be deinitialized before its parent. Root scopes need no `deinit`.
+pub const Scope = struct {
+    /// Lets generic waits name the waker type as `@TypeOf(scope.*).Waker`
+    pub const Waker = cancellation.Waker;
+
+    state: std.atomic.Value(u8) = .init(@intFromEnum(Reason.none)),
+    clock: ?Clock = null,
+    /// Earliest of this scope's deadline and its ancestors'
+    deadline_ns: ?u64 = null,
+    parent: ?*Scope = null,
+    lock: SpinLock = .{},
+    children: ?*Scope = null,
+    prev_sibling: ?*Scope = null,
+    next_sibling: ?*Scope = null,
+    wakers: ?*Scope.Waker = null,
+
+    /// Create a root scope. A deadline or timeout needs a clock.
+    pub fn init(options: Options) Scope {
+        std.debug.assert(options.clock != null or !hasDeadline(options));
+        var self = Scope{ .clock = options.clock };
+        self.deadline_ns = self.resolve(options);
+        return self;
+    }
+
+    /// Start `self` as a child of `parent`. The child starts cancelled
+    /// (with the parent's reason) if the parent already is. A deadline or
+    /// timeout needs a clock, given here or inherited from the parent.
+    pub fn initChild(self: *Scope, parent: *Scope, options: Options) void {
+        std.debug.assert(options.clock != null or parent.clock != null or !hasDeadline(options));
+        self.* = .{ .clock = options.clock orelse parent.clock, .parent = parent };
+        self.deadline_ns = earliest(self.resolve(options), parent.deadline_ns);
+
+        parent.lock.lock();
+        defer parent.lock.unlock();
+        self.next_sibling = parent.children;
+        if (parent.children) |c| c.prev_sibling = self;
+        parent.children = self;
+        const why = parent.reason();
+        if (why != .none) self.state.store(@intFromEnum(why), .release);
+    }
+
+    /// Detach from the parent. Outstanding children must be deinitialized
+    /// first.
+    pub fn deinit(self: *Scope) void {
+        std.debug.assert(self.children == null);
+        const parent = self.parent orelse return;
+        parent.lock.lock();
+        defer parent.lock.unlock();
+        if (self.prev_sibling) |p| p.next_sibling = self.next_sibling else parent.children = self.next_sibling;
+        if (self.next_sibling) |n| n.prev_sibling = self.prev_sibling;
+        self.parent = null;
+    }
+
+    /// Cancel this scope and all its descendants, waking every registered
+    /// wait. Only the first call has an effect; its reason sticks.
+    pub fn cancel(self: *Scope, why: Reason) void {
+        std.debug.assert(why != .none);
+        if (self.state.cmpxchgStrong(@intFromEnum(Reason.none), @intFromEnum(why), .acq_rel, .acquire) != null) return;
+
+        self.lock.lock();
+        defer self.lock.unlock();
+        var w = self.wakers;
+        while (w) |waker| : (w = waker.next) waker.wakeFn(waker.ctx);
+        var c = self.children;
+        while (c) |child| : (c = child.next_sibling) child.cancel(why);
+    }
+
+    pub fn isCancelled(self: *const Scope) bool {
+        return self.reason() != .none;
+    }
+
+    /// Why the scope was cancelled, `.none` if it was not
+    pub fn reason(self: *const Scope) Reason {
+        return @enumFromInt(self.state.load(.acquire));
+    }
+
+    /// Absolute deadline on the scope's clock, inherited ones included
+    pub fn deadline(self: *const Scope) ?u64 {
+        return self.deadline_ns;
+    }
+
+    /// Nanoseconds until the deadline: null without one, 0 once it passed.
+    pub fn remainingNs(self: *const Scope) ?u64 {
+        const d = self.deadline_ns orelse return null;
+        return d -| self.clock.?();
+    }
+
+    /// Cancel with `.deadline` if the deadline passed. Returns whether the
+    /// scope is cancelled (for any reason) afterwards.
+    pub fn checkDeadline(self: *Scope) bool {
+        if (self.remainingNs() == 0) self.cancel(.deadline);
+        return self.isCancelled();
+    }
+
+    /// `error.Cancelled` once cancelled or past the deadline
+    pub fn check(self: *Scope) error{Cancelled}!void {
+        if (self.checkDeadline()) return error.Cancelled;
+    }
+
+    /// Add `waker` to be called on cancellation. Returns false without
+    /// registering if the scope is already cancelled, so a wait that
+    /// registered successfully cannot miss the wakeup.
+    pub fn register(self: *Scope, waker: *Scope.Waker) bool {
+        self.lock.lock();
+        defer self.lock.unlock();
+        if (self.isCancelled()) return false;
+        waker.prev = null;
+        waker.next = self.wakers;
+        if (self.wakers) |head| head.prev = waker;
+        self.wakers = waker;
+        waker.linked = true;
+        return true;
+    }
+
+    /// Remove `waker`. Waits for a `cancel` that is calling it to finish,
+    /// so the waker's context may be released afterwards.
+    pub fn unregister(self: *Scope, waker: *Scope.Waker) void {
+        self.lock.lock();
+        defer self.lock.unlock();
+        if (!waker.linked) return;
+        if (waker.prev) |p| p.next = waker.next else self.wakers = waker.next;
+        if (waker.next) |n| n.prev = waker.prev;
+        waker.linked = false;
+    }
+
+    fn resolve(self: *const Scope, options: Options) ?u64 {
+        const relative = if (options.timeout_ns) |t| self.clock.?() +| t else null;
+        return earliest(options.deadline_ns, relative);
+    }
+
+    fn hasDeadline(options: Options) bool {
+        return options.deadline_ns != null or options.timeout_ns != null;
+    }
+
+    fn earliest(a: ?u64, b: ?u64) ?u64 {
+        const x = a orelse return b;
+        const y = b orelse return x;
+        return @min(x, y);
+    }
+};
+
 // ============================================================================
 // Tests
 // ============================================================================
@@ -94,3 +325,124 @@ test "CancellationToken cross-thread visibility" {
     // Thread exited because it saw the cancellation
     try std.testing.expect(token.isCancelled());
 }
+
+var test_now: u64 = 0;
+
+fn testClock() u64 {
+    return test_now;
+}
+
+test "Scope cancellation propagates to children with its reason" {
+    var root = Scope.init(.{});
+    var a: Scope = undefined;
+    a.initChild(&root, .{});
+    var b: Scope = undefined;
+    b.initChild(&a, .{});
+    var sibling: Scope = undefined;
+    sibling.initChild(&root, .{});
+
+    a.cancel(.shutdown);
+    try std.testing.expectEqual(Reason.shutdown, b.reason());
+    try std.testing.expect(!root.isCancelled() and !sibling.isCancelled());
+
+    // First reason sticks
+    root.cancel(.cancelled);
+    try std.testing.expectEqual(Reason.shutdown, a.reason());
+    try std.testing.expectEqual(Reason.cancelled, sibling.reason());
+
+    // Children of a cancelled scope start cancelled
+    var late: Scope = undefined;
+    late.initChild(&b, .{});
+    try std.testing.expectEqual(Reason.shutdown, late.reason());
+
+    late.deinit();
+    sibling.deinit();
+    b.deinit();
+    a.deinit();
+    try std.testing.expectEqual(@as(?*Scope, null), root.children);
+}
+
+test "Scope wakers run once and not after cancellation" {
+    const Counter = struct {
+        fn wake(ctx: *anyopaque) void {
+            const n: *u32 = @ptrCast(@alignCast(ctx));
+            n.* += 1;
+        }
+    };
+    var root = Scope.init(.{});
+    var child: Scope = undefined;
+    child.initChild(&root, .{});
+    defer child.deinit();
+
+    var hits: u32 = 0;
+    var w1 = Waker.init(&hits, Counter.wake);
+    var w2 = Waker.init(&hits, Counter.wake);
+    var gone = Waker.init(&hits, Counter.wake);
+    try std.testing.expect(child.register(&w1));
+    try std.testing.expect(root.register(&w2));
+    try std.testing.expect(child.register(&gone));
+    child.unregister(&gone);
+
+    root.cancel(.cancelled);
+    root.cancel(.cancelled);
+    try std.testing.expectEqual(@as(u32, 2), hits);
+
+    var late = Waker.init(&hits, Counter.wake);
+    try std.testing.expect(!child.register(&late));
+    child.unregister(&late); // not linked: no-op
+    child.unregister(&w1);
+    root.unregister(&w2);
+}
+
+test "Scope deadlines: inherited, relative, checked" {
+    test_now = 1_000;
+    var root = Scope.init(.{ .clock = testClock, .deadline_ns = 5_000 });
+    var tight: Scope = undefined;
+    tight.initChild(&root, .{ .timeout_ns = 500 });
+    defer tight.deinit();
+    var loose: Scope = undefined;
+    loose.initChild(&root, .{ .deadline_ns = 9_000 });
+    defer loose.deinit();
+
+    try std.testing.expectEqual(@as(?u64, 1_500), tight.deadline());
+    try std.testing.expectEqual(@as(?u64, 5_000), loose.deadline());
+    try std.testing.expectEqual(@as(?u64, 500), tight.remainingNs());
+    try std.testing.expectEqual(@as(?u64, null), Scope.init(.{}).remainingNs());
+
+    test_now = 2_000;
+    try std.testing.expectEqual(@as(?u64, 0), tight.remainingNs());
+    try std.testing.expectError(error.Cancelled, tight.check());
+    try std.testing.expectEqual(Reason.deadline, tight.reason());
+    try std.testing.expect(!root.isCancelled());
+
+    test_now = 6_000;
+    try std.testing.expect(loose.checkDeadline());
+    try std.testing.expectEqual(Reason.deadline, loose.reason());
+}
+
+test "Scope wakes a blocked thread" {
+    var root = Scope.init(.{});
+    var event = std.Thread.ResetEvent{};
+    var exited = std.atomic.Value(bool).init(false);
+
+    const thread = try std.Thread.spawn(.{}, struct {
+        fn run(s: *Scope, ev: *std.Thread.ResetEvent, done: *std.atomic.Value(bool)) void {
+            var waker = Waker.init(ev, wake);
+            if (s.register(&waker)) {
+                ev.wait();
+                s.unregister(&waker);
+            }
+            done.store(true, .release);
+        }
+
+        fn wake(ctx: *anyopaque) void {
+            const ev: *std.Thread.ResetEvent = @ptrCast(@alignCast(ctx));
+            ev.set();
+        }
+    }.run, .{ &root, &event, &exited });
+
+    std.Thread.sleep(1 * std.time.ns_per_ms);
+    root.cancel(.shutdown);
+    thread.join();
+    try std.testing.expect(exited.load(.acquire));
+}
@@ -116,6 +116,40 @@ pub fn WaitGroup(comptime Rt: type) type {
                 self.cond.wait(&self.mutex);
             }
         }
+
+        /// `wait` that returns `error.Cancelled` once `scope` (an
+        /// `async/cancellation` Scope) is cancelled or its deadline passes.
+        /// The tasks keep running; cancel them through the same scope.
+        pub fn waitCancellable(self: *Self, scope: anytype) error{Cancelled}!void {
+            var waker = @TypeOf(scope.*).Waker.init(self, wakeWaiters);
+            if (!scope.register(&waker)) return error.Cancelled;
+            defer scope.unregister(&waker);
+
+            self.mutex.lock();
+            while (self.counter > 0) {
+                if (scope.isCancelled()) break;
+                const remaining = scope.remainingNs() orelse {
+                    self.cond.wait(&self.mutex);
+                    continue;
+                };
+                if (remaining == 0) break;
+                _ = self.cond.timedWait(&self.mutex, remaining);
+            }
+            const finished = self.counter <= 0;
+            self.mutex.unlock();
+
+            if (finished) return;
+            // Outside the mutex: a deadline cancel runs our waker
+            _ = scope.checkDeadline();
+            return error.Cancelled;
+        }
+
+        fn wakeWaiters(ctx: *anyopaque) void {
+            const self: *Self = @ptrCast(@alignCast(ctx));
+            self.mutex.lock();
+            defer self.mutex.unlock();
+            self.cond.broadcast();
+        }
     };
 }
 
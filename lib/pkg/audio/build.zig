@@ -59,7 +59,28 @@ pub fn build(b: *std.Build) void {
         .optimize = optimize,
     }));
 
+    // Tests: ring + stream
+    const ring_tests = b.addTest(.{
+        .root_module = b.createModule(.{
+            .root_source_file = b.path("src/ring.zig"),
+            .target = target,
+            .optimize = optimize,
+        }),
+    });
+    ring_tests.root_module.addImport("trait", trait_dep.module("trait"));
+
+    const stream_tests = b.addTest(.{
+        .root_module = b.createModule(.{
+            .root_source_file = b.path("src/stream.zig"),
+            .target = target,
+            .optimize = optimize,
+        }),
+    });
+    stream_tests.root_module.addImport("trait", trait_dep.module("trait"));
+
     const test_step = b.step("test", "Run unit tests");
     test_step.dependOn(&b.addRunArtifact(resampler_tests).step);
     test_step.dependOn(&b.addRunArtifact(mixer_tests).step);
+    test_step.dependOn(&b.addRunArtifact(ring_tests).step);
+    test_step.dependOn(&b.addRunArtifact(stream_tests).step);
 }
@@ -2,19 +2,26 @@
 //!
 //! - resampler: Sample rate + channel conversion (SpeexDSP)
 //! - stream: Generic encode/decode loops (codec-agnostic)
+//! - ring: SPSC frame ring for zero-copy stage hand-off
 //! - ogg: Ogg container bindings
+//! - mixer: Multi-track mixer with per-track underrun counters
+//! - deadline: Callback deadline, xrun and wake-jitter accounting
 //!
 //! Opus codec: see //third_party/opus (opus_fixed / opus_float)
 //! SpeexDSP: see //third_party/speexdsp (speexdsp_fixed / speexdsp_float)
 
 pub const resampler = @import("resampler.zig");
 pub const stream = @import("stream.zig");
+pub const ring = @import("ring.zig");
 pub const ogg = @import("ogg.zig");
 pub const mixer = @import("mixer.zig");
+pub const deadline = @import("deadline.zig");
 
 pub const Format = resampler.Format;
 pub const Resampler = resampler.Resampler;
 pub const StreamResampler = resampler.StreamResampler;
+pub const FrameRing = ring.FrameRing;
+pub const DeadlineMonitor = deadline.Monitor;
 
 test {
     @import("std").testing.refAllDecls(@This());
@@ -0,0 +1,244 @@
+//! Deadline — callback timing and xrun accounting for audio loops
+//!
+//! A real-time audio loop has one deadline per period: the next buffer
+//! must be ready before the device finishes playing the current one.
+//! `Monitor` timestamps each period of a stream (a PortAudio callback, an
+//! I2S refill, a `Mixer.read` pull) and keeps the numbers that make
+//! glitches measurable instead of audible:
+//!
+//! - **late**: the callback ran longer than `budget_pct` of the period
+//! - **xruns**: reported by the host (PortAudio status flags, DMA
+//!   underflow), or inferred when consecutive callbacks start two or
+//!   more periods apart (buffers were missed in between)
+//! - **wake jitter**: how far each start-to-start interval is from the
+//!   period, as a log2 histogram, so percentiles need no sample storage
+//!
+//! The audio thread is the only writer. Counters are atomics updated with
+//! plain load/store pairs (no locked read-modify-write on the hot path);
+//! any thread may read `stats()` at any time.
+//!
+//! Timestamps are caller-supplied nanoseconds from a monotonic clock, so
+//! the monitor runs the same on hosts, boards and in tests.
+//!
+//! ```zig
+//! var mon = Monitor.init(.{ .period_ns = 256 * std.time.ns_per_s / 48_000 });
+//! fn callback(...) {
+//!     mon.begin(clock.nowNs());
+//!     defer mon.end(clock.nowNs());
+//!     if (status.output_underflow) mon.xrun(1);
+//!     ...
+//! }
+//! ```
+
+const std = @import("std");
+
+/// Histogram buckets: bucket 0 is < 1 µs, bucket i is < 2^i µs
+pub const hist_buckets = 16;
+
+pub const Config = struct {
+    /// Nominal time between callbacks
+    period_ns: u64,
+    /// Callback time above this share of the period counts as late
+    budget_pct: u8 = 75,
+    /// Count gaps of two or more periods as xruns. Turn off when the host
+    /// reports xruns itself (they would be counted twice).
+    infer_xruns: bool = true,
+};
+
+pub const Stats = struct {
+    callbacks: u64 = 0,
+    late: u64 = 0,
+    xruns: u64 = 0,
+    max_exec_ns: u64 = 0,
+    total_exec_ns: u64 = 0,
+    max_jitter_ns: u64 = 0,
+    jitter_hist: [hist_buckets]u64 = [_]u64{0} ** hist_buckets,
+
+    pub fn meanExecNs(self: *const Stats) u64 {
+        return if (self.callbacks == 0) 0 else self.total_exec_ns / self.callbacks;
+    }
+
+    /// Upper bound of the histogram bucket holding the `pct` percentile
+    /// of wake jitter
+    pub fn jitterPercentileNs(self: *const Stats, pct: u8) u64 {
+        var total: u64 = 0;
+        for (self.jitter_hist) |n| total += n;
+        if (total == 0) return 0;
+        const want = (total * pct + 99) / 100;
+        var seen: u64 = 0;
+        for (self.jitter_hist, 0..) |n, i| {
+            seen += n;
+            if (seen >= want) return bucketLimitNs(i);
+        }
+        return bucketLimitNs(hist_buckets - 1);
+    }
+
+    /// Glitches a listener can hear: xruns plus late callbacks
+    pub fn glitches(self: *const Stats) u64 {
+        return self.xruns + self.late;
+    }
+};
+
+const Counter = std.atomic.Value(u64);
+
+pub const Monitor = struct {
+    config: Config,
+    budget_ns: u64,
+
+    // Audio thread only
+    last_start: ?u64 = null,
+    started: u64 = 0,
+
+    callbacks: Counter = .init(0),
+    late: Counter = .init(0),
+    xruns: Counter = .init(0),
+    max_exec_ns: Counter = .init(0),
+    total_exec_ns: Counter = .init(0),
+    max_jitter_ns: Counter = .init(0),
+    jitter_hist: [hist_buckets]Counter = [_]Counter{.init(0)} ** hist_buckets,
+
+    pub fn init(config: Config) Monitor {
+        std.debug.assert(config.period_ns > 0);
+        return .{
+            .config = config,
+            .budget_ns = config.period_ns * config.budget_pct / 100,
+        };
+    }
+
+    /// Start of a callback
+    pub fn begin(self: *Monitor, now_ns: u64) void {
+        self.started = now_ns;
+        const last = self.last_start;
+        self.last_start = now_ns;
+        const prev = last orelse return;
+
+        const interval = now_ns -| prev;
+        const period = self.config.period_ns;
+        const jitter = if (interval > period) interval - period else period - interval;
+        bump(&self.jitter_hist[bucketOf(jitter)], 1);
+        raise(&self.max_jitter_ns, jitter);
+        if (self.config.infer_xruns and interval >= 2 * period) {
+            bump(&self.xruns, interval / period - 1);
+        }
+    }
+
+    /// End of the callback started by the last `begin`
+    pub fn end(self: *Monitor, now_ns: u64) void {
+        const exec = now_ns -| self.started;
+        bump(&self.callbacks, 1);
+        bump(&self.total_exec_ns, exec);
+        raise(&self.max_exec_ns, exec);
+        if (exec > self.budget_ns) bump(&self.late, 1);
+    }
+
+    /// Xruns reported by the host (underflow/overflow flags)
+    pub fn xrun(self: *Monitor, count: u64) void {
+        bump(&self.xruns, count);
+    }
+
+    /// Forget the previous start, e.g. after the stream was paused, so
+    /// the gap is not counted as jitter or xruns
+    pub fn resync(self: *Monitor) void {
+        self.last_start = null;
+    }
+
+    pub fn stats(self: *const Monitor) Stats {
+        var s = Stats{
+            .callbacks = self.callbacks.load(.monotonic),
+            .late = self.late.load(.monotonic),
+            .xruns = self.xruns.load(.monotonic),
+            .max_exec_ns = self.max_exec_ns.load(.monotonic),
+            .total_exec_ns = self.total_exec_ns.load(.monotonic),
+            .max_jitter_ns = self.max_jitter_ns.load(.monotonic),
+        };
+        for (&s.jitter_hist, &self.jitter_hist) |*out, *c| out.* = c.load(.monotonic);
+        return s;
+    }
+
+    /// Single writer: a load/store pair is enough
+    fn bump(c: *Counter, n: u64) void {
+        c.store(c.load(.monotonic) + n, .monotonic);
+    }
+
+    fn raise(c: *Counter, v: u64) void {
+        if (v > c.load(.monotonic)) c.store(v, .monotonic);
+    }
+};
+
+fn bucketOf(jitter_ns: u64) usize {
+    const micros = jitter_ns / std.time.ns_per_us;
+    if (micros == 0) return 0;
+    return @min(hist_buckets - 1, @as(usize, std.math.log2_int(u64, micros)) + 1);
+}
+
+fn bucketLimitNs(i: usize) u64 {
+    return (@as(u64, 1) << @intCast(i)) * std.time.ns_per_us;
+}
+
+// ============================================================================
+// Tests
+// ============================================================================
+
+const testing = std.testing;
+const ms = std.time.ns_per_ms;
+const us = std.time.ns_per_us;
+
+test "steady callbacks: no late, no xruns, jitter in the lowest buckets" {
+    var mon = Monitor.init(.{ .period_ns = 5 * ms });
+    var t: u64 = 1_000 * ms;
+    for (0..100) |i| {
+        // +-20 µs of wake noise, 1 ms of work
+        const noise: u64 = if (i % 2 == 0) 20 * us else 0;
+        mon.begin(t + noise);
+        mon.end(t + noise + 1 * ms);
+        t += 5 * ms;
+    }
+    const s = mon.stats();
+    try testing.expectEqual(@as(u64, 100), s.callbacks);
+    try testing.expectEqual(@as(u64, 0), s.late);
+    try testing.expectEqual(@as(u64, 0), s.xruns);
+    try testing.expectEqual(@as(u64, 1 * ms), s.meanExecNs());
+    try testing.expectEqual(@as(u64, 20 * us), s.max_jitter_ns);
+    try testing.expect(s.jitterPercentileNs(99) <= 32 * us);
+}
+
+test "overlong callbacks are late; a missed period is an xrun" {
+    var mon = Monitor.init(.{ .period_ns = 10 * ms, .budget_pct = 50 });
+    mon.begin(0);
+    mon.end(6 * ms);
+    mon.begin(10 * ms);
+    mon.end(12 * ms);
+    // Two periods skipped
+    mon.begin(40 * ms);
+    mon.end(41 * ms);
+
+    const s = mon.stats();
+    try testing.expectEqual(@as(u64, 1), s.late);
+    try testing.expectEqual(@as(u64, 2), s.xruns);
+    try testing.expectEqual(@as(u64, 3), s.glitches());
+    try testing.expectEqual(@as(u64, 20 * ms), s.max_jitter_ns);
+}
+
+test "host-reported xruns and resync" {
+    var mon = Monitor.init(.{ .period_ns = 10 * ms, .infer_xruns = false });
+    mon.begin(0);
+    mon.end(1 * ms);
+    mon.xrun(1);
+    // Paused for a second
+    mon.resync();
+    mon.begin(1_000 * ms);
+    mon.end(1_001 * ms);
+
+    const s = mon.stats();
+    try testing.expectEqual(@as(u64, 1), s.xruns);
+    try testing.expectEqual(@as(u64, 0), s.max_jitter_ns);
+}
+
+test "jitter histogram buckets" {
+    try testing.expectEqual(@as(usize, 0), bucketOf(999));
+    try testing.expectEqual(@as(usize, 1), bucketOf(1 * us));
+    try testing.expectEqual(@as(usize, 2), bucketOf(3 * us));
+    try testing.expectEqual(@as(usize, 10), bucketOf(1 * ms));
+    try testing.expectEqual(@as(usize, hist_buckets - 1), bucketOf(10_000 * ms));
+    try testing.expectEqual(@as(u64, 1024 * us), bucketLimitNs(10));
+}
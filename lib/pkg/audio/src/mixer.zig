@@ -13,6 +13,9 @@
 //! - Per-track resampler converts input format to mixer output format on the
 //!   read path (matching Go architecture)
 //! - f32 intermediate mixing with clipping to i16 output
+//! - Underrun accounting: a track that runs dry mid-chunk (writer behind,
+//!   not at EOF) counts an underrun on its `TrackCtrl`; `stats()` has the
+//!   mixer-wide totals
 //!
 //! ## Usage
 //!
@@ -64,6 +67,16 @@ pub fn Mixer(comptime Rt: type) type {
             ctrl: *TrackCtrl,
         };
 
+        pub const Stats = struct {
+            /// Successful `read` calls
+            reads: u64 = 0,
+            /// Chunks in which a track ran dry before EOF and was
+            /// zero-padded, summed over all tracks
+            underruns: u64 = 0,
+            /// `read` calls that found no track data and had to wait
+            starved: u64 = 0,
+        };
+
         // ================================================================
         // Mixer state
         // ================================================================
@@ -81,6 +94,7 @@ pub fn Mixer(comptime Rt: type) type {
         close_err: bool,
 
         running_silence_ms: u32,
+        stats_val: Stats,
 
         mix_buf: []f32,
         track_read_buf: []i16,
@@ -107,6 +121,7 @@ pub fn Mixer(comptime Rt: type) type {
                 .close_write = false,
                 .close_err = false,
                 .running_silence_ms = if (config.silence_gap_ms > 0) config.silence_gap_ms else 0,
+                .stats_val = .{},
                 .mix_buf = allocator.alloc(f32, chunk_samples) catch &.{},
                 .track_read_buf = allocator.alloc(i16, chunk_samples) catch &.{},
                 .read_chunk_samples = chunk_samples,
@@ -165,6 +180,7 @@ pub fn Mixer(comptime Rt: type) type {
             var peak: f32 = 0;
             var has_data = false;
             var is_silence = false;
+            var waited = false;
 
             while (true) {
                 const result = self.readFullLocked(buf[0..limit]);
@@ -176,9 +192,13 @@ pub fn Mixer(comptime Rt: type) type {
                 if (has_data or is_silence) break;
 
                 // No data from any track — wait
+                waited = true;
                 self.data_available.wait(&self.mutex);
             }
 
+            self.stats_val.reads += 1;
+            if (waited) self.stats_val.starved += 1;
+
             // Update running silence
             if (has_data) {
                 self.running_silence_ms = 0;
@@ -237,6 +257,7 @@ pub fn Mixer(comptime Rt: type) type {
             var it = self.head;
             while (it) |ctrl| {
                 const ok = ctrl.readFull(track_buf);
+                if (ok.underrun) self.stats_val.underruns += 1;
 
                 if (ok.is_err or (ok.is_eof and !ok.has_data)) {
                     // Track errored or finished — unlink from list
@@ -321,6 +342,13 @@ pub fn Mixer(comptime Rt: type) type {
             }
         }
 
+        /// Read and underrun counters since `init`
+        pub fn stats(self: *Self) Stats {
+            self.mutex.lock();
+            defer self.mutex.unlock();
+            return self.stats_val;
+        }
+
         // ================================================================
         // Track management
         // ================================================================
@@ -510,6 +538,9 @@ pub fn Mixer(comptime Rt: type) type {
             // Fade-out duration in ms (atomic)
             fade_out_ms_val: i32 = 0,
 
+            // Chunks zero-padded because the writer fell behind (atomic)
+            underruns_val: u64 = 0,
+
             pub fn setGain(self: *TrackCtrl, g: f32) void {
                 self.atomicStoreGain(g);
             }
@@ -526,6 +557,11 @@ pub fn Mixer(comptime Rt: type) type {
                 return @atomicLoad(i64, &self.read_bytes_val, .acquire);
             }
 
+            /// Mixer chunks in which this track ran dry before EOF
+            pub fn underruns(self: *TrackCtrl) u64 {
+                return @atomicLoad(u64, &self.underruns_val, .acquire);
+            }
+
             pub fn setFadeOutDuration(self: *TrackCtrl, ms: u32) void {
                 @atomicStore(i32, &self.fade_out_ms_val, @intCast(ms), .release);
             }
@@ -601,13 +637,16 @@ pub fn Mixer(comptime Rt: type) type {
             }
 
             /// Read from the track, filling the buffer. Non-blocking per-track.
-            fn readFull(self: *TrackCtrl, buf: []u8) struct { has_data: bool, is_err: bool, is_eof: bool } {
-                const t = self.track orelse return .{ .has_data = false, .is_err = true, .is_eof = false };
+            fn readFull(self: *TrackCtrl, buf: []u8) struct { has_data: bool, is_err: bool, is_eof: bool, underrun: bool } {
+                const t = self.track orelse return .{ .has_data = false, .is_err = true, .is_eof = false, .underrun = false };
                 const result = trackReadFull(t, buf);
                 if (result.bytes_read > 0) {
                     self.atomicAddReadBytes(@intCast(result.bytes_read));
                 }
-                return .{ .has_data = result.bytes_read > 0, .is_err = result.is_err, .is_eof = result.is_eof };
+                if (result.short) {
+                    _ = @atomicRmw(u64, &self.underruns_val, .Add, 1, .acq_rel);
+                }
+                return .{ .has_data = result.bytes_read > 0, .is_err = result.is_err, .is_eof = result.is_eof, .underrun = result.short };
             }
         };
 
@@ -889,7 +928,9 @@ pub fn Mixer(comptime Rt: type) type {
 
         /// Reads from track until buf is filled or no more data.
         /// Partial data is zero-padded. Returns 0 bytes_read if completely empty.
-        fn trackReadFull(track: *TrackInternal, buf: []u8) struct { bytes_read: usize, is_err: bool, is_eof: bool } {
+        /// `short` is set when the track ran dry mid-chunk without reaching
+        /// EOF: the writer fell behind the reader (an underrun).
+        fn trackReadFull(track: *TrackInternal, buf: []u8) struct { bytes_read: usize, is_err: bool, is_eof: bool, short: bool } {
             // Zero-fill first (matching Go: for i := range p { p[i] = 0 })
             @memset(buf, 0);
 
@@ -897,7 +938,7 @@ pub fn Mixer(comptime Rt: type) type {
             var saw_eof = false;
             while (total < buf.len) {
                 const result = track.readData(buf[total..]);
-                if (result.is_err) return .{ .bytes_read = 0, .is_err = true, .is_eof = false };
+                if (result.is_err) return .{ .bytes_read = 0, .is_err = true, .is_eof = false, .short = false };
                 if (result.n == 0) {
                     if (result.is_eof) saw_eof = true;
                     break;
@@ -905,10 +946,10 @@ pub fn Mixer(comptime Rt: type) type {
                 total += result.n;
             }
 
-            if (total == 0) return .{ .bytes_read = 0, .is_err = false, .is_eof = saw_eof };
+            if (total == 0) return .{ .bytes_read = 0, .is_err = false, .is_eof = saw_eof, .short = false };
 
             // Partial fill — already zero-padded, return full buf length
-            return .{ .bytes_read = buf.len, .is_err = false, .is_eof = false };
+            return .{ .bytes_read = buf.len, .is_err = false, .is_eof = false, .short = total < buf.len and !saw_eof };
         }
 
         // ================================================================
@@ -2267,3 +2308,38 @@ test "T18: read bytes counter accuracy" {
     try testing.expect(rb > 0);
     try testing.expect(rb >= num_samples * 2);
 }
+
+test "T19: underrun accounting" {
+    const Mx = Mixer(TestRt);
+    var mx = Mx.init(testing.allocator, .{
+        .output = .{ .rate = 16000 },
+    });
+    defer mx.deinit();
+
+    const format = Mx.Format{ .rate = 16000 };
+    const h = try mx.createTrack(.{});
+    var buf: [160]i16 = undefined;
+
+    // Writer behind: the chunk is zero-padded and counted
+    try h.track.write(format, &([_]i16{1000} ** 100));
+    try testing.expectEqual(@as(?usize, 160), mx.read(&buf));
+    try testing.expectEqual(@as(u64, 1), h.ctrl.underruns());
+
+    // Full chunk: no underrun
+    try h.track.write(format, &([_]i16{1000} ** 160));
+    try testing.expectEqual(@as(?usize, 160), mx.read(&buf));
+
+    // Short final chunk at EOF is not an underrun
+    try h.track.write(format, &([_]i16{1000} ** 50));
+    h.ctrl.closeWrite();
+    try testing.expectEqual(@as(?usize, 160), mx.read(&buf));
+    try testing.expectEqual(@as(u64, 1), h.ctrl.underruns());
+
+    mx.closeWrite();
+    try testing.expectEqual(@as(?usize, null), mx.read(&buf));
+
+    const s = mx.stats();
+    try testing.expectEqual(@as(u64, 3), s.reads);
+    try testing.expectEqual(@as(u64, 1), s.underruns);
+    try testing.expectEqual(@as(u64, 0), s.starved);
+}
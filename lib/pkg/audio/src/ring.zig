@@ -0,0 +1,167 @@
+//! Audio Ring — zero-copy hand-off between pipeline stages
+//!
+//! Single-producer / single-consumer ring of PCM frames that hands out
+//! slices of its own storage. A stage writes in place (a source reads PCM
+//! straight into the ring, or a decoder decodes into it) and the next
+//! stage consumes the same memory, so frames are never copied between
+//! stages.
+//!
+//! The ring hands out at most the run up to the wrap point; callers loop
+//! until they have what they need.
+//!
+//! ## Usage
+//!
+//! ```zig
+//! var storage: [8 * 320]i16 = undefined;
+//! var frames = FrameRing.init(&storage, 320);
+//!
+//! // producer
+//! const free = frames.writable();          // whole frames, contiguous
+//! const n = mic.read(free);
+//! frames.commit(n / 320);
+//!
+//! // consumer
+//! const ready = frames.readable();
+//! const packets = try trait.codec.encodeBatch(&enc, ready, 320, ...);
+//! frames.release(ready.len / 320);
+//! ```
+
+const std = @import("std");
+
+const Atomic = std.atomic.Value(usize);
+
+// ============================================================================
+// FrameRing
+// ============================================================================
+
+/// Ring of fixed-size PCM frames over caller-provided storage.
+/// Head and tail are free-running frame counters; the producer owns
+/// `head`, the consumer owns `tail`.
+pub const FrameRing = struct {
+    buf: []i16,
+    frame_size: usize,
+    slots: usize,
+    head: Atomic = Atomic.init(0),
+    tail: Atomic = Atomic.init(0),
+
+    /// `buf.len` is truncated to a whole number of frames.
+    pub fn init(buf: []i16, frame_size: usize) FrameRing {
+        std.debug.assert(frame_size > 0 and buf.len >= frame_size);
+        return .{ .buf = buf, .frame_size = frame_size, .slots = buf.len / frame_size };
+    }
+
+    /// Frames ready to read
+    pub fn count(self: *const FrameRing) usize {
+        return self.head.load(.acquire) - self.tail.load(.acquire);
+    }
+
+    /// Free frames
+    pub fn free(self: *const FrameRing) usize {
+        return self.slots - self.count();
+    }
+
+    /// Contiguous free frames, as samples. Empty when full.
+    pub fn writable(self: *FrameRing) []i16 {
+        const head = self.head.load(.monotonic);
+        const used = head - self.tail.load(.acquire);
+        const at = head % self.slots;
+        const n = @min(self.slots - used, self.slots - at);
+        return self.buf[at * self.frame_size ..][0 .. n * self.frame_size];
+    }
+
+    /// Publish `frames` frames written into `writable()`.
+    pub fn commit(self: *FrameRing, frames: usize) void {
+        std.debug.assert(frames <= self.free());
+        _ = self.head.fetchAdd(frames, .release);
+    }
+
+    /// Contiguous ready frames, as samples. Empty when no frame is ready.
+    pub fn readable(self: *FrameRing) []i16 {
+        const tail = self.tail.load(.monotonic);
+        const ready = self.head.load(.acquire) - tail;
+        const at = tail % self.slots;
+        const n = @min(ready, self.slots - at);
+        return self.buf[at * self.frame_size ..][0 .. n * self.frame_size];
+    }
+
+    /// Hand `frames` frames from `readable()` back to the producer.
+    pub fn release(self: *FrameRing, frames: usize) void {
+        std.debug.assert(frames <= self.count());
+        _ = self.tail.fetchAdd(frames, .release);
+    }
+};
+
+// ============================================================================
+// Tests
+// ============================================================================
+
+test "FrameRing hands out contiguous runs up to the wrap" {
+    var storage: [4 * 3 + 2]i16 = undefined;
+    var ring = FrameRing.init(&storage, 3);
+    try std.testing.expectEqual(@as(usize, 4), ring.slots);
+
+    var w = ring.writable();
+    try std.testing.expectEqual(@as(usize, 12), w.len);
+    for (w[0..9], 0..) |*s, i| s.* = @intCast(i);
+    ring.commit(3);
+
+    const r = ring.readable();
+    try std.testing.expectEqual(@as(usize, 9), r.len);
+    try std.testing.expectEqual(@as(i16, 8), r[8]);
+    try std.testing.expectEqual(@intFromPtr(w.ptr), @intFromPtr(r.ptr));
+    ring.release(2);
+
+    // One slot before the wrap, then the two released slots after it.
+    w = ring.writable();
+    try std.testing.expectEqual(@as(usize, 3), w.len);
+    ring.commit(1);
+    w = ring.writable();
+    try std.testing.expectEqual(@as(usize, 6), w.len);
+    try std.testing.expectEqual(@intFromPtr(&storage[0]), @intFromPtr(w.ptr));
+    ring.commit(2);
+    try std.testing.expectEqual(@as(usize, 0), ring.writable().len);
+
+    try std.testing.expectEqual(@as(usize, 6), ring.readable().len);
+    ring.release(2);
+    try std.testing.expectEqual(@as(usize, 6), ring.readable().len);
+    ring.release(2);
+    try std.testing.expectEqual(@as(usize, 0), ring.count());
+}
+
+test "FrameRing SPSC across threads" {
+    var storage: [8 * 16]i16 = undefined;
+    var ring = FrameRing.init(&storage, 16);
+    const total = 4096;
+
+    const Producer = struct {
+        fn run(r: *FrameRing) void {
+            var next: usize = 0;
+            while (next < total) {
+                const w = r.writable();
+                if (w.len == 0) {
+                    std.Thread.yield() catch {};
+                    continue;
+                }
+                const frames = @min(w.len / 16, total - next);
+                for (0..frames) |f| @memset(w[f * 16 ..][0..16], @intCast((next + f) & 0x7fff));
+                r.commit(frames);
+                next += frames;
+            }
+        }
+    };
+
+    const t = try std.Thread.spawn(.{}, Producer.run, .{&ring});
+    var seen: usize = 0;
+    while (seen < total) {
+        const r = ring.readable();
+        if (r.len == 0) {
+            std.Thread.yield() catch {};
+            continue;
+        }
+        const frames = r.len / 16;
+        for (0..frames) |f| try std.testing.expectEqual(@as(i16, @intCast((seen + f) & 0x7fff)), r[f * 16 + 15]);
+        ring.release(frames);
+        seen += frames;
+    }
+    t.join();
+}
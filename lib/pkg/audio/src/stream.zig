@@ -24,8 +24,19 @@
 //! // channel → decode → speaker
 //! stream.decodeLoop(&channel_src, &decoder, &speaker_sink);
 //! ```
+//!
+//! ## Batched loops
+//!
+//! `encodeLoopBatched` / `decodeLoopBatched` stage PCM in a caller-owned
+//! `ring.FrameRing`: the source reads (or the decoder writes) straight
+//! into ring memory and the codec consumes it in place, `batch_frames`
+//! frames per `trait.codec.encodeBatch` call. A sink may declare
+//! `fn writeBatch(*Sink, data: []const u8, lens: []const u16) void` to take
+//! a whole batch of packets at once; otherwise each packet is written.
 
+const std = @import("std");
 const trait = @import("trait");
+const FrameRing = @import("ring.zig").FrameRing;
 
 /// Encode loop: read PCM from Src → encode via Enc → write to Sink.
 ///
@@ -48,10 +59,9 @@ pub fn encodeLoop(
     }
 
     const frame_size = enc.frameSize();
-    const max_opus: usize = 1275; // max opus packet per RFC 6716
 
     var accum: [7680]i16 = undefined; // max 120ms @ 48kHz stereo
-    var opus_buf: [max_opus]u8 = undefined;
+    var opus_buf: [trait.codec.maxPacketBytes(Enc)]u8 = undefined;
     var accum_n: usize = 0;
 
     while (true) {
@@ -100,3 +110,216 @@ pub fn decodeLoop(
         }
     }
 }
+
+/// Batched encode loop: read PCM into `frames` → encode `batch_frames`
+/// frames per call → write packets to Sink.
+///
+/// `frames.frame_size` must equal `enc.frameSize()`. A partial batch is
+/// flushed when the ring fills up or the source ends.
+pub fn encodeLoopBatched(
+    comptime Src: type,
+    comptime Enc: type,
+    comptime Sink: type,
+    comptime batch_frames: usize,
+    src: *Src,
+    enc: *Enc,
+    sink: *Sink,
+    frames: *FrameRing,
+) void {
+    comptime {
+        _ = trait.codec.Encoder(Enc);
+    }
+
+    const frame_size = enc.frameSize();
+    std.debug.assert(frames.frame_size == frame_size);
+
+    var out: [batch_frames * trait.codec.maxPacketBytes(Enc)]u8 = undefined;
+    var lens: [batch_frames]u16 = undefined;
+    // Samples of the frame being filled, already in ring memory
+    var partial: usize = 0;
+    var done = false;
+
+    while (!done or frames.count() > 0) {
+        if (!done and frames.count() < batch_frames) {
+            const free = frames.writable();
+            if (free.len > 0) {
+                if (src.read(free[partial..])) |n| {
+                    partial += n;
+                    frames.commit(partial / frame_size);
+                    partial %= frame_size;
+                    continue;
+                }
+                done = true;
+            }
+        }
+
+        const ready = frames.readable();
+        const n = @min(ready.len / frame_size, batch_frames);
+        if (n == 0) continue;
+        const packets = trait.codec.encodeBatch(enc, ready[0 .. n * frame_size], frame_size, &out, lens[0..n]) catch {
+            frames.release(n);
+            continue;
+        };
+        frames.release(n);
+
+        if (comptime @hasDecl(Sink, "writeBatch")) {
+            sink.writeBatch(packets, lens[0..n]);
+        } else {
+            var it = trait.codec.PacketIterator.init(packets, lens[0..n]);
+            while (it.next()) |packet| sink.write(packet);
+        }
+    }
+}
+
+/// Batched decode loop: decode packets from Src straight into `frames`
+/// → write runs of up to `batch_frames` frames to Sink.
+///
+/// `frames.frame_size` must equal `dec.frameSize()`.
+pub fn decodeLoopBatched(
+    comptime Src: type,
+    comptime Dec: type,
+    comptime Sink: type,
+    comptime batch_frames: usize,
+    src: *Src,
+    dec: *Dec,
+    sink: *Sink,
+    frames: *FrameRing,
+) void {
+    comptime {
+        _ = trait.codec.Decoder(Dec);
+    }
+
+    const frame_size = dec.frameSize();
+    std.debug.assert(frames.frame_size == frame_size);
+
+    while (true) {
+        const free = frames.writable();
+        if (free.len == 0 or frames.count() >= batch_frames) {
+            flushFrames(Sink, sink, frames);
+            continue;
+        }
+
+        const packet = src.read() orelse break;
+        const decoded = dec.decode(packet, free[0..frame_size]) catch continue;
+        if (decoded.len == frame_size) frames.commit(1);
+    }
+    while (frames.count() > 0) flushFrames(Sink, sink, frames);
+}
+
+fn flushFrames(comptime Sink: type, sink: *Sink, frames: *FrameRing) void {
+    const ready = frames.readable();
+    sink.write(ready);
+    frames.release(ready.len / frames.frame_size);
+}
+
+// ============================================================================
+// Tests
+// ============================================================================
+
+/// Toy codec: one packet per frame holding the frame's first sample.
+const ByteEncoder = struct {
+    pub const max_packet_bytes: usize = 1;
+
+    pub fn encode(_: *ByteEncoder, pcm: []const i16, _: u32, out: []u8) ![]const u8 {
+        out[0] = @intCast(pcm[0]);
+        return out[0..1];
+    }
+
+    pub fn frameSize(_: *const ByteEncoder) u32 {
+        return 4;
+    }
+};
+
+const ByteDecoder = struct {
+    pub fn decode(_: *ByteDecoder, data: []const u8, pcm: []i16) ![]const i16 {
+        @memset(pcm[0..4], data[0]);
+        return pcm[0..4];
+    }
+
+    pub fn frameSize(_: *const ByteDecoder) u32 {
+        return 4;
+    }
+};
+
+test "encodeLoopBatched batches frames and flushes the tail" {
+    const testing = std.testing;
+
+    // Delivers 3 samples per read so frames straddle reads.
+    const Src = struct {
+        pcm: []const i16,
+        pos: usize = 0,
+
+        fn read(self: *@This(), buf: []i16) ?usize {
+            if (self.pos == self.pcm.len) return null;
+            const n = @min(3, buf.len, self.pcm.len - self.pos);
+            @memcpy(buf[0..n], self.pcm[self.pos..][0..n]);
+            self.pos += n;
+            return n;
+        }
+    };
+    const Sink = struct {
+        got: [16]u8 = undefined,
+        n: usize = 0,
+        n_lens: usize = 0,
+        batches: usize = 0,
+
+        pub fn writeBatch(self: *@This(), data: []const u8, lens: []const u16) void {
+            self.batches += 1;
+            for (lens) |len| self.n_lens += len;
+            @memcpy(self.got[self.n..][0..data.len], data);
+            self.n += data.len;
+        }
+    };
+
+    var pcm: [10 * 4]i16 = undefined;
+    for (0..10) |f| @memset(pcm[f * 4 ..][0..4], @intCast(f + 1));
+
+    var storage: [6 * 4]i16 = undefined;
+    var ring = FrameRing.init(&storage, 4);
+    var src = Src{ .pcm = &pcm };
+    var enc = ByteEncoder{};
+    var sink = Sink{};
+    encodeLoopBatched(Src, ByteEncoder, Sink, 4, &src, &enc, &sink, &ring);
+
+    try testing.expectEqualSlices(u8, &.{ 1, 2, 3, 4, 5, 6, 7, 8, 9, 10 }, sink.got[0..sink.n]);
+    try testing.expectEqual(@as(usize, 10), sink.n_lens);
+    try testing.expectEqual(@as(usize, 3), sink.batches);
+}
+
+test "decodeLoopBatched writes contiguous runs" {
+    const testing = std.testing;
+
+    const Src = struct {
+        next: u8 = 1,
+        buf: [1]u8 = undefined,
+
+        fn read(self: *@This()) ?[]const u8 {
+            if (self.next > 7) return null;
+            self.buf[0] = self.next;
+            self.next += 1;
+            return &self.buf;
+        }
+    };
+    const Sink = struct {
+        got: [7 * 4]i16 = undefined,
+        n: usize = 0,
+        writes: usize = 0,
+
+        fn write(self: *@This(), pcm: []const i16) void {
+            self.writes += 1;
+            @memcpy(self.got[self.n..][0..pcm.len], pcm);
+            self.n += pcm.len;
+        }
+    };
+
+    var storage: [5 * 4]i16 = undefined;
+    var ring = FrameRing.init(&storage, 4);
+    var src = Src{};
+    var dec = ByteDecoder{};
+    var sink = Sink{};
+    decodeLoopBatched(Src, ByteDecoder, Sink, 3, &src, &dec, &sink, &ring);
+
+    try testing.expectEqual(@as(usize, 7 * 4), sink.n);
+    for (0..7) |f| try testing.expectEqual(@as(i16, @intCast(f + 1)), sink.got[f * 4 + 3]);
+    try testing.expect(sink.writes < 7);
+}
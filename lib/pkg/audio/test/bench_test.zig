@@ -0,0 +1,249 @@
+//! Audio thread policy under CPU load: callback jitter and glitches.
+//!
+//! A simulated device pulls one 256-frame period of 48 kHz mono (5.33 ms)
+//! from a `Mixer` every period, sleeping to absolute deadlines like a
+//! DMA-driven callback, and runs a little DSP on it. Two producer threads
+//! keep their tracks about 20 ms ahead of the device. A `DeadlineMonitor`
+//! times every period.
+//!
+//!   BM1: load × policy matrix, 400 periods (~2 s) each:
+//!        - load: idle, or one busy-loop burner thread per CPU
+//!        - policy: SCHED_OTHER, or SCHED_FIFO with the memory locked
+//!          (skipped, and reported, when the process may not use it)
+//!        Reports wake jitter p50/p99/max, callback time mean/max, late
+//!        callbacks, xruns (missed periods), track underruns and device
+//!        reads that had to wait for data.
+//!
+//! Jitter percentiles are histogram bucket bounds (powers of two µs).
+
+const std = @import("std");
+const audio = @import("audio");
+const std_impl = @import("std_impl");
+const print = std.debug.print;
+const testing = std.testing;
+
+const realtime = std_impl.realtime;
+const Mx = audio.mixer.Mixer(std_impl.runtime);
+const DeadlineMonitor = audio.DeadlineMonitor;
+
+const RATE = 48_000;
+const PERIOD_FRAMES = 256;
+const PERIOD_NS = PERIOD_FRAMES * std.time.ns_per_s / RATE;
+const PERIODS = 400;
+const LEAD_SAMPLES = RATE / 50; // 20 ms
+const CHUNK_SAMPLES = RATE / 200; // 5 ms
+
+const format = Mx.Format{ .rate = RATE };
+
+fn nowNs() u64 {
+    return std_impl.cancel.nowNs();
+}
+
+// ============================================================================
+// Simulated device
+// ============================================================================
+
+const Device = struct {
+    mixer: *Mx,
+    policy: realtime.Policy,
+    mon: DeadlineMonitor = .init(.{ .period_ns = PERIOD_NS }),
+    applied: realtime.Applied = undefined,
+    state: [2]f32 = .{ 0, 0 },
+
+    fn run(self: *Device) void {
+        self.applied = realtime.promote(.{
+            .policy = self.policy,
+            .lock_memory = self.policy != .other,
+            .prefault_stack = true,
+        });
+        defer realtime.demote(self.applied);
+
+        var buf: [PERIOD_FRAMES]i16 = undefined;
+        var next = nowNs();
+        for (0..PERIODS) |_| {
+            next += PERIOD_NS;
+            const now = nowNs();
+            if (next > now) std.Thread.sleep(next - now);
+
+            self.mon.begin(nowNs());
+            const n = self.mixer.read(&buf) orelse break;
+            self.dsp(buf[0..n]);
+            self.mon.end(nowNs());
+        }
+    }
+
+    /// A few passes of a biquad-ish filter: stands in for effects work
+    fn dsp(self: *Device, buf: []i16) void {
+        for (0..16) |_| {
+            for (buf) |*s| {
+                const x: f32 = @floatFromInt(s.*);
+                const y = 0.5 * x + 0.3 * self.state[0] - 0.1 * self.state[1];
+                self.state[1] = self.state[0];
+                self.state[0] = y;
+                s.* = @intFromFloat(std.math.clamp(y, -32768, 32767));
+            }
+        }
+    }
+};
+
+/// Feeds one track, staying `LEAD_SAMPLES` ahead of what the mixer read
+const Producer = struct {
+    handle: Mx.TrackHandle,
+    freq: f32,
+    running: std.atomic.Value(bool) = .init(true),
+
+    fn run(self: *Producer) void {
+        var chunk: [CHUNK_SAMPLES]i16 = undefined;
+        var written: usize = 0;
+        var phase: f32 = 0;
+        const step = 2 * std.math.pi * self.freq / RATE;
+        while (self.running.load(.acquire)) {
+            const consumed: usize = @intCast(@divTrunc(self.handle.ctrl.readBytes(), 2));
+            if (written > consumed + LEAD_SAMPLES) {
+                std.Thread.sleep(std.time.ns_per_ms);
+                continue;
+            }
+            for (&chunk) |*s| {
+                s.* = @intFromFloat(@sin(phase) * 8000);
+                phase = @mod(phase + step, 2 * std.math.pi);
+            }
+            self.handle.track.write(format, &chunk) catch return;
+            written += chunk.len;
+        }
+    }
+};
+
+// ============================================================================
+// CPU load
+// ============================================================================
+
+const Burners = struct {
+    running: std.atomic.Value(bool) = .init(true),
+    pool: [64]std.Thread = undefined,
+    count: usize = 0,
+
+    fn start(self: *Burners, n: usize) !void {
+        for (0..@min(n, self.pool.len)) |_| {
+            self.pool[self.count] = try std.Thread.spawn(.{ .stack_size = 64 * 1024 }, burn, .{&self.running});
+            self.count += 1;
+        }
+    }
+
+    fn stop(self: *Burners) void {
+        self.running.store(false, .release);
+        for (self.pool[0..self.count]) |th| th.join();
+    }
+
+    fn burn(running: *std.atomic.Value(bool)) void {
+        var x: u64 = 0x9E3779B97F4A7C15;
+        while (running.load(.monotonic)) {
+            for (0..4096) |_| x = x *% 6364136223846793005 +% 1442695040888963407;
+            std.mem.doNotOptimizeAway(x);
+        }
+    }
+};
+
+// ============================================================================
+// BM1: load × policy
+// ============================================================================
+
+const Result = struct {
+    deadline: audio.deadline.Stats,
+    mixer: Mx.Stats,
+    underruns: u64,
+    applied: realtime.Applied,
+};
+
+fn scenario(policy: realtime.Policy, burners: usize) !Result {
+    var mx = Mx.init(testing.allocator, .{ .output = format });
+    defer mx.deinit();
+
+    var producers = [_]Producer{
+        .{ .handle = try mx.createTrack(.{ .label = "music", .gain = 0.5 }), .freq = 440 },
+        .{ .handle = try mx.createTrack(.{ .label = "voice", .gain = 0.5 }), .freq = 660 },
+    };
+    var feeders: [producers.len]std.Thread = undefined;
+    for (&feeders, &producers) |*th, *p| th.* = try std.Thread.spawn(.{}, Producer.run, .{p});
+
+    var load = Burners{};
+    try load.start(burners);
+    // Let the producers build their lead
+    std.Thread.sleep(20 * std.time.ns_per_ms);
+
+    var device = Device{ .mixer = &mx, .policy = policy };
+    const dt = try std.Thread.spawn(.{}, Device.run, .{&device});
+    dt.join();
+    load.stop();
+
+    for (&producers) |*p| p.running.store(false, .release);
+    // Wakes producers blocked in write
+    mx.close();
+    for (feeders) |th| th.join();
+
+    var underruns: u64 = 0;
+    for (producers) |p| underruns += p.handle.ctrl.underruns();
+    return .{
+        .deadline = device.mon.stats(),
+        .mixer = mx.stats(),
+        .underruns = underruns,
+        .applied = device.applied,
+    };
+}
+
+/// Whether this process may use SCHED_FIFO, checked on a scratch thread
+fn fifoAllowed() !realtime.Status {
+    const Probe = struct {
+        status: realtime.Status = .unsupported,
+        fn run(self: *@This()) void {
+            const applied = realtime.promote(.{ .policy = .fifo, .lock_memory = false });
+            self.status = applied.status;
+            realtime.demote(applied);
+        }
+    };
+    var probe = Probe{};
+    const t = try std.Thread.spawn(.{}, Probe.run, .{&probe});
+    t.join();
+    return probe.status;
+}
+
+fn us(ns: u64) u64 {
+    return ns / std.time.ns_per_us;
+}
+
+test "BM1: callback jitter and glitches, idle vs loaded, SCHED_OTHER vs SCHED_FIFO" {
+    const cpus = std.Thread.getCpuCount() catch 1;
+    const fifo = try fifoAllowed();
+    print("\n[bench] BM1: {d} periods of {d} frames @ {d} Hz ({d} us), {d} CPUs\n", .{
+        PERIODS, PERIOD_FRAMES, RATE, us(PERIOD_NS), cpus,
+    });
+    if (fifo != .applied) print("[bench]   SCHED_FIFO unavailable ({s}): fifo rows skipped\n", .{@tagName(fifo)});
+
+    for ([_][]const u8{ "idle", "loaded" }) |load| {
+        for ([_]realtime.Policy{ .other, .fifo }) |policy| {
+            if (policy == .fifo and fifo != .applied) continue;
+            const burners: usize = if (std.mem.eql(u8, load, "loaded")) cpus else 0;
+            const r = try scenario(policy, burners);
+            const d = r.deadline;
+
+            print("[bench]   {s:<6} {s:<5} jitter p50 {d:>5} us  p99 {d:>5} us  max {d:>6} us   exec mean {d:>4} us  max {d:>5} us   late {d:>3}  xruns {d:>3}  underruns {d:>3}  starved {d:>3}{s}\n", .{
+                load,
+                @tagName(policy),
+                us(d.jitterPercentileNs(50)),
+                us(d.jitterPercentileNs(99)),
+                us(d.max_jitter_ns),
+                us(d.meanExecNs()),
+                us(d.max_exec_ns),
+                d.late,
+                d.xruns,
+                r.underruns,
+                r.mixer.starved,
+                if (r.applied.memory_locked) "  (mlockall)" else "",
+            });
+
+            // Every period was served, and every serve was one mixer read
+            try testing.expectEqual(@as(u64, PERIODS), d.callbacks);
+            try testing.expectEqual(d.callbacks, r.mixer.reads);
+            if (policy == .fifo) try testing.expectEqual(realtime.Policy.fifo, r.applied.policy);
+        }
+    }
+}
@@ -0,0 +1,205 @@
+//! Display Flush Benchmark
+//!
+//! Measures the flush pipeline for a 320x240 panel: effective frames per
+//! second on the host, bytes and windows moved per frame, and the frame
+//! rate the SPI bus would allow at 40MHz for that traffic.
+//!
+//!   BM1: conversion kernels, vector vs scalar (MB/s of source pixels)
+//!   BM2: full-frame flush, native / byte-swapped / XRGB8888 → RGB565 BE
+//!   BM3: 24 dirty widgets, one window per area vs DirtyAreas merging
+//!
+//! Run:
+//!   bazel test //lib/pkg/display:bench --test_output=all
+
+const std = @import("std");
+const display = @import("display.zig");
+const print = std.debug.print;
+
+const W: u16 = 320;
+const H: u16 = 240;
+const FRAMES = 200;
+
+/// Bus clock used to model wire time
+const SPI_HZ: f64 = 40_000_000;
+/// Command bytes per window: CASET + 4, RASET + 4, RAMWR
+const WINDOW_CMD_BYTES = 11;
+
+/// SPI that only counts
+const NullSpi = struct {
+    bytes: u64 = 0,
+    writes: u64 = 0,
+    sum: u8 = 0,
+
+    pub fn write(self: *NullSpi, data: []const u8) !void {
+        self.bytes += data.len;
+        self.writes += 1;
+        self.sum +%= data[data.len - 1];
+    }
+};
+
+const NullDc = struct {
+    pub fn setHigh(_: *NullDc) void {}
+    pub fn setLow(_: *NullDc) void {}
+};
+
+fn fillFrame(fb: []u8, seed: u64) void {
+    var prng = std.Random.DefaultPrng.init(seed);
+    prng.random().bytes(fb);
+}
+
+fn reportFlush(name: []const u8, ns: u64, frames: u32, stats: display.FlushStats) void {
+    const secs = @as(f64, @floatFromInt(@max(ns, 1))) / 1e9;
+    const bytes_per_frame = @as(f64, @floatFromInt(stats.bytes)) / @as(f64, @floatFromInt(frames));
+    const windows_per_frame = @as(f64, @floatFromInt(stats.windows)) / @as(f64, @floatFromInt(frames));
+    const wire_secs = (bytes_per_frame + windows_per_frame * WINDOW_CMD_BYTES) * 8 / SPI_HZ;
+    print("[bench]   {s:<30} {d:>8.0} fps host  {d:>8.0} B/frame  {d:>5.1} win/frame  {d:>6.1} fps @40MHz\n", .{
+        name,
+        @as(f64, @floatFromInt(frames)) / secs,
+        bytes_per_frame,
+        windows_per_frame,
+        1 / wire_secs,
+    });
+}
+
+// ============================================================================
+// BM1: kernels
+// ============================================================================
+
+fn kernel(comptime conv: display.Conversion, comptime vector: bool, src: []const u8, dst: []u8) !f64 {
+    const pixels = src.len / conv.srcBpp();
+    var timer = try std.time.Timer.start();
+    for (0..FRAMES) |_| {
+        if (vector) {
+            display.convert.convert(conv, src, dst, pixels);
+        } else {
+            display.convert.convertScalar(conv, src, dst, pixels);
+        }
+        std.mem.doNotOptimizeAway(dst[dst.len / 2]);
+    }
+    const secs = @as(f64, @floatFromInt(@max(timer.read(), 1))) / 1e9;
+    return @as(f64, @floatFromInt(src.len * FRAMES)) / secs / (1024 * 1024);
+}
+
+test "BM1: conversion kernels" {
+    const alloc = std.testing.allocator;
+    const src = try alloc.alloc(u8, @as(usize, W) * H * 4);
+    defer alloc.free(src);
+    const dst = try alloc.alloc(u8, @as(usize, W) * H * 4);
+    defer alloc.free(dst);
+    fillFrame(src, 1);
+
+    print("\n[bench] conversion kernels, {d}x{d}, {d} frames\n", .{ W, H, FRAMES });
+    const cases = .{
+        .{ "rgb565 -> rgb565 BE", display.Conversion{ .from = .rgb565, .to = .rgb565, .swap565 = true } },
+        .{ "xrgb8888 -> rgb565 BE", display.Conversion{ .from = .xrgb8888, .to = .rgb565, .swap565 = true } },
+        .{ "rgb888 -> rgb565", display.Conversion{ .from = .rgb888, .to = .rgb565 } },
+        .{ "rgb565 -> xrgb8888", display.Conversion{ .from = .rgb565, .to = .xrgb8888 } },
+    };
+    inline for (cases) |c| {
+        const n = @as(usize, W) * H * c[1].srcBpp();
+        const scalar = try kernel(c[1], false, src[0..n], dst);
+        const vector = try kernel(c[1], true, src[0..n], dst);
+        print("[bench]   {s:<30} scalar {d:>8.1} MB/s  vector {d:>8.1} MB/s  ({d:.1}x)\n", .{
+            c[0], scalar, vector, vector / scalar,
+        });
+    }
+}
+
+// ============================================================================
+// BM2: full frame
+// ============================================================================
+
+fn fullFrame(comptime name: []const u8, comptime config: display.SpiLcdConfig, fb: []const u8) !void {
+    const Lcd = display.SpiLcd(NullSpi, NullDc, config);
+    var spi = NullSpi{};
+    var dc = NullDc{};
+    var lcd = Lcd.init(&spi, &dc);
+    const full = [_]display.Area{.{ .x1 = 0, .y1 = 0, .x2 = W - 1, .y2 = H - 1 }};
+
+    var timer = try std.time.Timer.start();
+    for (0..FRAMES) |_| lcd.flushAreas(fb, &full);
+    reportFlush(name, timer.read(), FRAMES, lcd.stats);
+    std.mem.doNotOptimizeAway(spi.sum);
+}
+
+test "BM2: full-frame flush" {
+    const alloc = std.testing.allocator;
+    const fb = try alloc.alloc(u8, @as(usize, W) * H * 4);
+    defer alloc.free(fb);
+    fillFrame(fb, 2);
+
+    print("\n[bench] full-frame flush, {d}x{d}\n", .{ W, H });
+    try fullFrame("rgb565 native", .{ .width = W, .height = H, .buf_lines = 20 }, fb);
+    try fullFrame("rgb565 -> BE", .{ .width = W, .height = H, .buf_lines = 20, .swap_bytes = true }, fb);
+    try fullFrame("xrgb8888 -> rgb565 BE", .{
+        .width = W,
+        .height = H,
+        .buf_lines = 20,
+        .color_format = .xrgb8888,
+        .panel_format = .rgb565,
+        .swap_bytes = true,
+    }, fb);
+}
+
+// ============================================================================
+// BM3: dirty widgets
+// ============================================================================
+
+/// 8x6 grid of 40x40 cells; every other cell (alternating per frame)
+/// redraws two stacked 40x10 text lines, reported as separate areas.
+fn widgetAreas(frame: usize, out: []display.Area) []display.Area {
+    var n: usize = 0;
+    for (0..6) |row| {
+        for (0..8) |col| {
+            if ((row + col + frame) % 2 != 0) continue;
+            const x: u16 = @intCast(col * 40);
+            const y: u16 = @intCast(row * 40);
+            out[n] = .{ .x1 = x, .y1 = y, .x2 = x + 39, .y2 = y + 9 };
+            n += 1;
+            out[n] = .{ .x1 = x, .y1 = y + 10, .x2 = x + 39, .y2 = y + 19 };
+            n += 1;
+        }
+    }
+    return out[0..n];
+}
+
+fn widgets(comptime name: []const u8, comptime merge: bool, fb: []const u8, host: bool) !void {
+    var areas_buf: [96]display.Area = undefined;
+    var dirty = display.DirtyAreas(32){};
+
+    const Lcd = display.SpiLcd(NullSpi, NullDc, .{ .width = W, .height = H, .buf_lines = 20, .swap_bytes = true });
+    var spi = NullSpi{};
+    var dc = NullDc{};
+    var lcd = Lcd.init(&spi, &dc);
+
+    const Mem = display.MemDisplayWith(W, H, .{ .render_mode = .partial, .buf_lines = 20, .swap_bytes = true });
+    const mem = try std.testing.allocator.create(Mem);
+    defer std.testing.allocator.destroy(mem);
+    mem.* = Mem.create();
+
+    var timer = try std.time.Timer.start();
+    for (0..FRAMES) |f| {
+        var areas: []const display.Area = widgetAreas(f, &areas_buf);
+        if (merge) {
+            dirty.clear();
+            for (areas) |a| dirty.add(a);
+            areas = dirty.items();
+        }
+        if (host) mem.flushAreas(fb, areas) else lcd.flushAreas(fb, areas);
+    }
+    reportFlush(name, timer.read(), FRAMES, if (host) mem.stats else lcd.stats);
+    std.mem.doNotOptimizeAway(spi.sum);
+}
+
+test "BM3: dirty widgets, per-area vs merged" {
+    const alloc = std.testing.allocator;
+    const fb = try alloc.alloc(u8, @as(usize, W) * H * 2);
+    defer alloc.free(fb);
+    fillFrame(fb, 3);
+
+    print("\n[bench] 24 dirty widgets (2 areas each), rgb565 -> BE\n", .{});
+    try widgets("SpiLcd per area", false, fb, false);
+    try widgets("SpiLcd merged", true, fb, false);
+    try widgets("MemDisplay per area", false, fb, true);
+    try widgets("MemDisplay merged", true, fb, true);
+}
@@ -0,0 +1,245 @@
+//! Pixel Format Conversion
+//!
+//! Converts pixel runs between ColorFormats, optionally emitting RGB565
+//! byte-swapped (big-endian), which is what SPI panels expect on the wire.
+//!
+//! Memory layout follows LVGL:
+//! - rgb565: little-endian u16, `RRRRRGGG GGGBBBBB`
+//! - rgb888: 3 bytes, B G R
+//! - xrgb8888 / argb8888: 4 bytes, B G R A (alpha written as 0xFF)
+//!
+//! Conversions are resolved at comptime and run `lanes` pixels at a time
+//! on @Vector, with a scalar loop for the tail. `convertScalar` is the
+//! per-pixel reference used by tests and the benchmark.
+
+const std = @import("std");
+const types = @import("types.zig");
+const ColorFormat = types.ColorFormat;
+const bytesPerPixel = types.bytesPerPixel;
+
+const native_endian = @import("builtin").cpu.arch.endian();
+
+/// Pixels per vector step
+pub const lanes = 8;
+
+/// Source → panel conversion
+pub const Conversion = struct {
+    from: ColorFormat,
+    to: ColorFormat,
+    /// Emit RGB565 big-endian (only meaningful when `to == .rgb565`)
+    swap565: bool = false,
+
+    pub fn isIdentity(self: Conversion) bool {
+        return self.from == self.to and !(self.to == .rgb565 and self.swap565);
+    }
+
+    pub fn srcBpp(self: Conversion) u8 {
+        return bytesPerPixel(self.from);
+    }
+
+    pub fn dstBpp(self: Conversion) u8 {
+        return bytesPerPixel(self.to);
+    }
+};
+
+/// Convert `pixels` pixels from `src` to `dst`.
+pub fn convert(comptime conv: Conversion, src: []const u8, dst: []u8, pixels: usize) void {
+    const sb = comptime conv.srcBpp();
+    const db = comptime conv.dstBpp();
+    std.debug.assert(src.len >= pixels * sb and dst.len >= pixels * db);
+
+    if (comptime conv.isIdentity()) {
+        @memcpy(dst[0 .. pixels * db], src[0 .. pixels * sb]);
+        return;
+    }
+
+    var i: usize = 0;
+    while (i + lanes <= pixels) : (i += lanes) {
+        const px = load(conv.from, src[i * sb ..][0 .. lanes * sb]);
+        store(conv.to, conv.swap565, px, dst[i * db ..][0 .. lanes * db]);
+    }
+    convertScalar(conv, src[i * sb ..], dst[i * db ..], pixels - i);
+}
+
+/// Per-pixel reference implementation.
+pub fn convertScalar(comptime conv: Conversion, src: []const u8, dst: []u8, pixels: usize) void {
+    const sb = comptime conv.srcBpp();
+    const db = comptime conv.dstBpp();
+    for (0..pixels) |i| {
+        const s = src[i * sb ..][0..sb];
+        const d = dst[i * db ..][0..db];
+        var r: u8 = undefined;
+        var g: u8 = undefined;
+        var b: u8 = undefined;
+        switch (conv.from) {
+            .rgb565 => {
+                const v = std.mem.readInt(u16, s[0..2], .little);
+                r = expand5(@truncate(v >> 11));
+                g = expand6(@truncate(v >> 5));
+                b = expand5(@truncate(v));
+            },
+            .rgb888, .xrgb8888, .argb8888 => {
+                b = s[0];
+                g = s[1];
+                r = s[2];
+            },
+        }
+        switch (conv.to) {
+            .rgb565 => {
+                const v = (@as(u16, r >> 3) << 11) | (@as(u16, g >> 2) << 5) | (b >> 3);
+                std.mem.writeInt(u16, d[0..2], v, if (conv.swap565) .big else .little);
+            },
+            .rgb888 => d.* = .{ b, g, r },
+            .xrgb8888, .argb8888 => d.* = .{ b, g, r, 0xFF },
+        }
+    }
+}
+
+fn expand5(v: u5) u8 {
+    return (@as(u8, v) << 3) | (v >> 2);
+}
+
+fn expand6(v: u6) u8 {
+    return (@as(u8, v) << 2) | (v >> 4);
+}
+
+// ============================================================================
+// Vector kernels
+// ============================================================================
+
+const V8 = @Vector(lanes, u8);
+const V16 = @Vector(lanes, u16);
+const V32 = @Vector(lanes, u32);
+
+const Rgb = struct { r: V8, g: V8, b: V8 };
+
+fn fromLittle(comptime T: type, v: T) T {
+    return if (native_endian == .big) @byteSwap(v) else v;
+}
+
+fn toEndian(comptime T: type, v: T, comptime big: bool) T {
+    return if ((native_endian == .big) != big) @byteSwap(v) else v;
+}
+
+/// Shuffle mask picking byte `offset` of each `stride`-byte pixel.
+fn pick(comptime stride: usize, comptime offset: usize) @Vector(lanes, i32) {
+    var mask: [lanes]i32 = undefined;
+    for (&mask, 0..) |*m, k| m.* = @intCast(k * stride + offset);
+    return mask;
+}
+
+/// Mask appending lane `k` of the second operand after every
+/// `width - 1` elements of the first: weave(2) gives a0 b0 a1 b1 ...,
+/// weave(3) on that gives a0 a1 b0 a2 a3 b1 ...
+fn weave(comptime width: usize) [lanes * width]i32 {
+    var mask: [lanes * width]i32 = undefined;
+    for (0..lanes) |k| {
+        for (0..width - 1) |j| mask[k * width + j] = @intCast(k * (width - 1) + j);
+        mask[k * width + width - 1] = ~@as(i32, @intCast(k));
+    }
+    return mask;
+}
+
+inline fn load(comptime fmt: ColorFormat, bytes: *const [lanes * bytesPerPixel(fmt)]u8) Rgb {
+    switch (fmt) {
+        .rgb565 => {
+            const v = fromLittle(V16, @bitCast(bytes.*));
+            const r: V8 = @truncate(v >> @splat(11));
+            const g: V8 = @truncate((v >> @splat(5)) & @as(V16, @splat(0x3F)));
+            const b: V8 = @truncate(v & @as(V16, @splat(0x1F)));
+            return .{
+                .r = (r << @splat(3)) | (r >> @splat(2)),
+                .g = (g << @splat(2)) | (g >> @splat(4)),
+                .b = (b << @splat(3)) | (b >> @splat(2)),
+            };
+        },
+        .rgb888 => {
+            const v: @Vector(lanes * 3, u8) = bytes.*;
+            return .{
+                .r = @shuffle(u8, v, undefined, comptime pick(3, 2)),
+                .g = @shuffle(u8, v, undefined, comptime pick(3, 1)),
+                .b = @shuffle(u8, v, undefined, comptime pick(3, 0)),
+            };
+        },
+        .xrgb8888, .argb8888 => {
+            const v = fromLittle(V32, @bitCast(bytes.*));
+            return .{
+                .r = @truncate(v >> @splat(16)),
+                .g = @truncate(v >> @splat(8)),
+                .b = @truncate(v),
+            };
+        },
+    }
+}
+
+inline fn store(comptime fmt: ColorFormat, comptime swap565: bool, px: Rgb, bytes: *[lanes * bytesPerPixel(fmt)]u8) void {
+    switch (fmt) {
+        .rgb565 => {
+            const r: V16 = @intCast(px.r >> @splat(3));
+            const g: V16 = @intCast(px.g >> @splat(2));
+            const b: V16 = @intCast(px.b >> @splat(3));
+            const v = (r << @splat(11)) | (g << @splat(5)) | b;
+            bytes.* = @bitCast(toEndian(V16, v, swap565));
+        },
+        .rgb888 => {
+            // Interleave as B G R: pair up b|g, then weave r in.
+            const bg = @shuffle(u8, px.b, px.g, comptime weave(2));
+            bytes.* = @shuffle(u8, bg, px.r, comptime weave(3));
+        },
+        .xrgb8888, .argb8888 => {
+            const r: V32 = @intCast(px.r);
+            const g: V32 = @intCast(px.g);
+            const b: V32 = @intCast(px.b);
+            const v = @as(V32, @splat(0xFF00_0000)) | (r << @splat(16)) | (g << @splat(8)) | b;
+            bytes.* = @bitCast(toEndian(V32, v, false));
+        },
+    }
+}
+
+// ============================================================================
+// Tests
+// ============================================================================
+
+const formats = [_]ColorFormat{ .rgb565, .rgb888, .xrgb8888, .argb8888 };
+
+test "vector kernels match the scalar reference" {
+    var prng = std.Random.DefaultPrng.init(0xD15);
+    var src: [37 * 4]u8 = undefined;
+    prng.random().bytes(&src);
+
+    inline for (formats) |from| {
+        inline for (formats) |to| {
+            inline for (.{ false, true }) |swap| {
+                const conv = Conversion{ .from = from, .to = to, .swap565 = swap };
+                var fast: [37 * 4]u8 = undefined;
+                var slow: [37 * 4]u8 = undefined;
+                const n = 37 * conv.dstBpp();
+                convert(conv, &src, &fast, 37);
+                if (conv.isIdentity()) {
+                    try std.testing.expectEqualSlices(u8, src[0..n], fast[0..n]);
+                } else {
+                    convertScalar(conv, &src, &slow, 37);
+                    try std.testing.expectEqualSlices(u8, slow[0..n], fast[0..n]);
+                }
+            }
+        }
+    }
+}
+
+test "rgb565 swap and expansion" {
+    // Pure red, green, blue in little-endian RGB565
+    const src = [_]u8{ 0x00, 0xF8, 0xE0, 0x07, 0x1F, 0x00 };
+    var swapped: [6]u8 = undefined;
+    convertScalar(.{ .from = .rgb565, .to = .rgb565, .swap565 = true }, &src, &swapped, 3);
+    try std.testing.expectEqualSlices(u8, &.{ 0xF8, 0x00, 0x07, 0xE0, 0x00, 0x1F }, &swapped);
+
+    var wide: [12]u8 = undefined;
+    convertScalar(.{ .from = .rgb565, .to = .xrgb8888 }, &src, &wide, 3);
+    try std.testing.expectEqualSlices(u8, &.{ 0, 0, 0xFF, 0xFF, 0, 0xFF, 0, 0xFF, 0xFF, 0, 0, 0xFF }, &wide);
+}
+
+test "identity detection" {
+    try std.testing.expect((Conversion{ .from = .rgb565, .to = .rgb565 }).isIdentity());
+    try std.testing.expect(!(Conversion{ .from = .rgb565, .to = .rgb565, .swap565 = true }).isIdentity());
+    try std.testing.expect((Conversion{ .from = .rgb888, .to = .rgb888, .swap565 = true }).isIdentity());
+}
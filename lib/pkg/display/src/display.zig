@@ -37,12 +37,31 @@
 //! var lcd = LcdDriver.init(&spi, &dc);
 //! var ctx = try ui.init(LcdDriver, &lcd);
 //! ```
+//!
+//! Partial refresh: collect areas in a `DirtyAreas(N)` and hand them to
+//! `flushAreas(fb, dirty.items())`; `panel_format` / `swap_bytes` convert
+//! pixels on the way out (see flush.zig, convert.zig).
+//!
+//! Asynchronous flush: a driver whose transfer runs in the background
+//! (SPI DMA, a bus thread) declares `async_flush = true` and provides
+//! `flushAsync(area, pixels, done)` plus `waitFlush()`; it signals `done`
+//! when the transfer has released the buffer. Together with
+//! `draw_buffers = 2`, the UI renders the next stripe while the previous
+//! one is still on the bus. `MemDisplayWith(.., .{ .async_flush = .. })`
+//! models this on the host.
 
 // Types
 pub const Area = @import("types.zig").Area;
 pub const ColorFormat = @import("types.zig").ColorFormat;
 pub const RenderMode = @import("types.zig").RenderMode;
 pub const bytesPerPixel = @import("types.zig").bytesPerPixel;
+pub const FlushDone = @import("types.zig").FlushDone;
+
+// Flush pipeline
+pub const convert = @import("convert.zig");
+pub const Conversion = convert.Conversion;
+pub const DirtyAreas = @import("flush.zig").DirtyAreas;
+pub const FlushStats = @import("flush.zig").Stats;
 
 // LCD controller drivers
 pub const SpiLcd = @import("spi_lcd.zig").SpiLcd;
@@ -50,6 +69,9 @@ pub const SpiLcdConfig = @import("spi_lcd.zig").Config;
 
 // Test utilities
 pub const MemDisplay = @import("mem_display.zig").MemDisplay;
+pub const MemDisplayWith = @import("mem_display.zig").MemDisplayWith;
+pub const MemDisplayConfig = @import("mem_display.zig").Config;
+pub const AsyncFlush = @import("mem_display.zig").AsyncFlush;
 
 // ============================================================================
 // Tests
@@ -61,4 +83,6 @@ test {
     _ = @import("types.zig");
     _ = @import("spi_lcd.zig");
     _ = @import("mem_display.zig");
+    _ = @import("convert.zig");
+    _ = @import("flush.zig");
 }
@@ -0,0 +1,213 @@
+//! Flush Pipeline
+//!
+//! Shared by SpiLcd and MemDisplay:
+//!
+//! - `DirtyAreas` collects areas to refresh and merges neighbours when one
+//!   window costs no more than sending them apart (plus `slack_px` for the
+//!   per-window command overhead).
+//! - `streamWindow` sends one window's pixels to a sink, converting from
+//!   the render format to the panel format a chunk at a time. With no
+//!   conversion it hands the source memory straight to the sink.
+//!
+//! Sink contract:
+//!   fn sendPixels(self: *Sink, bytes: []const u8) void — panel-format
+//!   bytes in row order, continuing the current window.
+
+const std = @import("std");
+const types = @import("types.zig");
+const convert_mod = @import("convert.zig");
+
+const Area = types.Area;
+pub const Conversion = convert_mod.Conversion;
+
+/// Transfer counters
+pub const Stats = struct {
+    /// Windows opened (one CASET/RASET/RAMWR sequence each)
+    windows: u32 = 0,
+    /// Pixel bytes sent to the panel
+    bytes: u64 = 0,
+};
+
+/// Send a `w`×`h` window whose first pixel is at `src[0]` and whose rows
+/// are `stride` pixels apart. `tx` is the conversion buffer; it may be
+/// empty when `conv` is the identity.
+pub fn streamWindow(
+    comptime conv: Conversion,
+    src: []const u8,
+    stride: usize,
+    w: usize,
+    h: usize,
+    tx: []u8,
+    sink: anytype,
+) void {
+    const sb: usize = comptime conv.srcBpp();
+    const db: usize = comptime conv.dstBpp();
+    const row_bytes = stride * sb;
+
+    if (comptime conv.isIdentity()) {
+        if (stride == w) return sink.sendPixels(src[0 .. w * h * sb]);
+        for (0..h) |y| sink.sendPixels(src[y * row_bytes ..][0 .. w * sb]);
+        return;
+    }
+
+    const tx_px = tx.len / db;
+    std.debug.assert(tx_px > 0);
+    var used: usize = 0;
+    for (0..h) |y| {
+        var x: usize = 0;
+        while (x < w) {
+            const n = @min(w - x, tx_px - used);
+            convert_mod.convert(conv, src[y * row_bytes + x * sb ..], tx[used * db ..], n);
+            used += n;
+            x += n;
+            if (used == tx_px) {
+                sink.sendPixels(tx[0 .. used * db]);
+                used = 0;
+            }
+        }
+    }
+    if (used > 0) sink.sendPixels(tx[0 .. used * db]);
+}
+
+/// Collects up to `max` areas for one refresh.
+pub fn DirtyAreas(comptime max: usize) type {
+    return struct {
+        const Self = @This();
+
+        areas: [max]Area = undefined,
+        count: usize = 0,
+        /// Extra pixels a merge may send to save a window
+        slack_px: u32 = 64,
+
+        /// Add an area, absorbing every area that is cheaper to send
+        /// together with it. When full, it is folded into the area whose
+        /// bounding box grows least.
+        pub fn add(self: *Self, area: Area) void {
+            var a = area;
+            var i: usize = 0;
+            while (i < self.count) {
+                if (self.worthMerging(self.areas[i], a)) {
+                    a = a.merge(self.areas[i]);
+                    self.remove(i);
+                    i = 0;
+                } else {
+                    i += 1;
+                }
+            }
+
+            if (self.count == max) {
+                var best: usize = 0;
+                var best_growth: u32 = std.math.maxInt(u32);
+                for (self.areas[0..self.count], 0..) |e, j| {
+                    const growth = e.merge(a).pixelCount() - e.pixelCount();
+                    if (growth < best_growth) {
+                        best = j;
+                        best_growth = growth;
+                    }
+                }
+                a = a.merge(self.areas[best]);
+                self.remove(best);
+                return self.add(a);
+            }
+
+            self.areas[self.count] = a;
+            self.count += 1;
+        }
+
+        pub fn items(self: *const Self) []const Area {
+            return self.areas[0..self.count];
+        }
+
+        pub fn clear(self: *Self) void {
+            self.count = 0;
+        }
+
+        /// Pixels that a flush of `items()` will send
+        pub fn pixelCount(self: *const Self) u32 {
+            var n: u32 = 0;
+            for (self.items()) |a| n += a.pixelCount();
+            return n;
+        }
+
+        fn worthMerging(self: *const Self, a: Area, b: Area) bool {
+            const parts = a.pixelCount() + b.pixelCount() - a.overlapCount(b);
+            return a.merge(b).pixelCount() <= parts + self.slack_px;
+        }
+
+        fn remove(self: *Self, i: usize) void {
+            self.count -= 1;
+            self.areas[i] = self.areas[self.count];
+        }
+    };
+}
+
+// ============================================================================
+// Tests
+// ============================================================================
+
+const testing = std.testing;
+
+test "DirtyAreas merges neighbours and keeps distant areas apart" {
+    var d = DirtyAreas(4){};
+    d.add(.{ .x1 = 0, .y1 = 0, .x2 = 9, .y2 = 9 });
+    d.add(.{ .x1 = 10, .y1 = 0, .x2 = 19, .y2 = 9 }); // side by side
+    d.add(.{ .x1 = 0, .y1 = 10, .x2 = 19, .y2 = 19 }); // below both
+    try testing.expectEqual(@as(usize, 1), d.count);
+    try testing.expectEqual(Area{ .x1 = 0, .y1 = 0, .x2 = 19, .y2 = 19 }, d.items()[0]);
+
+    d.add(.{ .x1 = 200, .y1 = 200, .x2 = 209, .y2 = 209 });
+    try testing.expectEqual(@as(usize, 2), d.count);
+    try testing.expectEqual(@as(u32, 500), d.pixelCount());
+}
+
+test "DirtyAreas folds into the cheapest area when full" {
+    var d = DirtyAreas(2){ .slack_px = 0 };
+    d.add(.{ .x1 = 0, .y1 = 0, .x2 = 9, .y2 = 9 });
+    d.add(.{ .x1 = 100, .y1 = 100, .x2 = 109, .y2 = 109 });
+    d.add(.{ .x1 = 0, .y1 = 20, .x2 = 9, .y2 = 29 });
+    try testing.expectEqual(@as(usize, 2), d.count);
+    var found = false;
+    for (d.items()) |a| {
+        if (a.x1 == 0 and a.y1 == 0 and a.y2 == 29) found = true;
+    }
+    try testing.expect(found);
+}
+
+const Collect = struct {
+    buf: [256]u8 = undefined,
+    len: usize = 0,
+    calls: usize = 0,
+
+    pub fn sendPixels(self: *Collect, bytes: []const u8) void {
+        @memcpy(self.buf[self.len..][0..bytes.len], bytes);
+        self.len += bytes.len;
+        self.calls += 1;
+    }
+};
+
+test "streamWindow: identity is zero-copy, conversion is chunked" {
+    // 4x3 source with stride 6, rgb565 little-endian, pixel = (y << 8) | x
+    var src: [6 * 3 * 2]u8 = undefined;
+    for (0..3) |y| {
+        for (0..6) |x| std.mem.writeInt(u16, src[(y * 6 + x) * 2 ..][0..2], @intCast(y << 8 | x), .little);
+    }
+
+    var same = Collect{};
+    var no_tx: [0]u8 = .{};
+    streamWindow(.{ .from = .rgb565, .to = .rgb565 }, src[2..], 6, 4, 3, &no_tx, &same);
+    try testing.expectEqual(@as(usize, 3), same.calls);
+    try testing.expectEqual(@as(usize, 24), same.len);
+    try testing.expectEqual(@as(u16, 0x0201), std.mem.readInt(u16, same.buf[16..18], .little));
+
+    var swapped = Collect{};
+    var tx: [10]u8 = undefined; // 5 pixels: chunks straddle rows
+    streamWindow(.{ .from = .rgb565, .to = .rgb565, .swap565 = true }, src[2..], 6, 4, 3, &tx, &swapped);
+    try testing.expectEqual(@as(usize, 3), swapped.calls);
+    try testing.expectEqual(@as(usize, 24), swapped.len);
+    for (0..3) |y| {
+        for (0..4) |x| {
+            const v = std.mem.readInt(u16, swapped.buf[(y * 4 + x) * 2 ..][0..2], .big);
+            try testing.expectEqual(@as(u16, @intCast(y << 8 | (x + 1))), v);
+        }
+    }
+}
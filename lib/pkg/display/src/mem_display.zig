@@ -8,13 +8,53 @@
 //! - `flush_count`: number of times flush was called
 //! - `framebuffer`: raw pixel data to verify rendering
 //! - `getPixel()`: read individual pixel values
+//!
+//! `MemDisplayWith` behaves like a panel behind the flush pipeline: it
+//! takes partial windows (`render_mode = .partial`, `flushAreas`), holds
+//! its framebuffer in `panel_format`, and counts windows and bytes moved,
+//! so SpiLcd configurations can be exercised on the host.
+//!
+//! With `async_flush` set it also models a DMA transfer: `flushAsync`
+//! only records the request, and the pixels are copied out of the caller's
+//! buffer when the transfer completes — so a UI that reuses a buffer
+//! still on the bus draws the wrong pixels in tests. Completion happens
+//! in `waitFlush` (`.on_wait`, single-threaded tests) or when another
+//! thread modelling the bus calls `complete` (`.external`).
 
+const std = @import("std");
 const types = @import("types.zig");
+const flush_mod = @import("flush.zig");
 const Area = types.Area;
+const FlushDone = types.FlushDone;
 const ColorFormat = types.ColorFormat;
 const RenderMode = types.RenderMode;
 const bytesPerPixel = types.bytesPerPixel;
 
+/// Who completes an asynchronous flush
+pub const AsyncFlush = enum {
+    /// Synchronous `flush` only
+    none,
+    /// `waitFlush` completes the transfer in flight
+    on_wait,
+    /// Another thread calls `complete`; `waitFlush` waits for it
+    external,
+};
+
+/// MemDisplayWith configuration
+pub const Config = struct {
+    color_format: ColorFormat = .rgb565,
+    render_mode: RenderMode = .full,
+    /// Lines per flush chunk (null = full height)
+    buf_lines: ?u16 = null,
+    /// Framebuffer format (null = `color_format`)
+    panel_format: ?ColorFormat = null,
+    /// Store RGB565 big-endian, like an SPI panel's GRAM
+    swap_bytes: bool = false,
+    /// Draw buffers the UI should allocate (1 or 2)
+    draw_buffers: u8 = 1,
+    async_flush: AsyncFlush = .none,
+};
+
 /// Memory-backed display driver.
 ///
 /// Generic over resolution and color format to match any display spec.
@@ -23,8 +63,21 @@ pub fn MemDisplay(
     comptime h: u16,
     comptime color_fmt: ColorFormat,
 ) type {
-    const bpp = bytesPerPixel(color_fmt);
-    const fb_size = @as(u32, w) * @as(u32, h) * @as(u32, bpp);
+    return MemDisplayWith(w, h, .{ .color_format = color_fmt });
+}
+
+/// Memory-backed display driver with render mode and panel format.
+pub fn MemDisplayWith(comptime w: u16, comptime h: u16, comptime config: Config) type {
+    const conv = flush_mod.Conversion{
+        .from = config.color_format,
+        .to = config.panel_format orelse config.color_format,
+        .swap565 = config.swap_bytes,
+    };
+    const src_bpp: u32 = conv.srcBpp();
+    const bpp: u32 = conv.dstBpp();
+    const fb_size = @as(u32, w) * @as(u32, h) * bpp;
+    const lines = config.buf_lines orelse h;
+    const tx_bytes: usize = if (conv.isIdentity()) 0 else @as(usize, w) * lines * bpp;
 
     return struct {
         const Self = @This();
@@ -32,11 +85,20 @@ pub fn MemDisplay(
         // -- Display driver comptime interface --
         pub const width: u16 = w;
         pub const height: u16 = h;
-        pub const color_format: ColorFormat = color_fmt;
-        pub const render_mode: RenderMode = .full;
-        pub const buf_lines: u16 = h; // full-frame for testing
+        pub const color_format: ColorFormat = config.color_format;
+        pub const render_mode: RenderMode = config.render_mode;
+        pub const buf_lines: u16 = lines;
+        pub const draw_buffers: u8 = config.draw_buffers;
+        pub const async_flush: bool = config.async_flush != .none;
+        pub const conversion = conv;
+
+        const Transfer = struct {
+            area: Area,
+            data: [*]const u8,
+            done: FlushDone,
+        };
 
-        /// Raw framebuffer in memory
+        /// Raw framebuffer in memory (panel format)
         framebuffer: [fb_size]u8,
 
         /// Number of times flush was called (for test assertions)
@@ -45,6 +107,19 @@ pub fn MemDisplay(
         /// Last flushed area (for test assertions)
         last_area: ?Area,
 
+        /// Windows and bytes moved
+        stats: flush_mod.Stats = .{},
+
+        /// Window being written and the next pixel in it
+        window: Area = .{ .x1 = 0, .y1 = 0, .x2 = 0, .y2 = 0 },
+        cursor: u32 = 0,
+
+        tx: [tx_bytes]u8 = undefined,
+
+        /// Asynchronous transfer in flight (valid while `in_flight`)
+        transfer: Transfer = undefined,
+        in_flight: std.atomic.Value(bool) = .init(false),
+
         /// Create a new MemDisplay with zeroed framebuffer
         pub fn create() Self {
             return .{
@@ -58,24 +133,93 @@ pub fn MemDisplay(
         pub fn flush(self: *Self, area: Area, color_data: [*]const u8) void {
             self.flush_count += 1;
             self.last_area = area;
+            self.openWindow(area);
+            const src_bytes = area.pixelCount() * src_bpp;
+            flush_mod.streamWindow(conv, color_data[0..src_bytes], area.width(), area.width(), area.height(), &self.tx, self);
+        }
 
-            // Copy pixel data into the framebuffer line by line
-            const area_w = @as(u32, area.width());
-            const line_bytes = area_w * @as(u32, bpp);
+        /// Start an asynchronous flush. `color_data` must stay untouched
+        /// until `done` is signalled; one transfer at a time.
+        pub fn flushAsync(self: *Self, area: Area, color_data: [*]const u8, done: FlushDone) void {
+            std.debug.assert(!self.in_flight.load(.acquire));
+            self.transfer = .{ .area = area, .data = color_data, .done = done };
+            self.in_flight.store(true, .release);
+        }
 
-            var y: u16 = area.y1;
-            while (y <= area.y2) : (y += 1) {
-                const fb_offset = (@as(u32, y) * @as(u32, w) + @as(u32, area.x1)) * @as(u32, bpp);
-                const src_offset = (@as(u32, y - area.y1) * area_w) * @as(u32, bpp);
+        /// Finish the transfer in flight: copy its pixels into the
+        /// framebuffer, then signal its completion. Returns false if
+        /// nothing was in flight.
+        pub fn complete(self: *Self) bool {
+            if (!self.in_flight.load(.acquire)) return false;
+            const t = self.transfer;
+            self.flush(t.area, t.data);
+            self.in_flight.store(false, .release);
+            t.done.signal();
+            return true;
+        }
 
-                if (fb_offset + line_bytes <= fb_size) {
-                    const dst = self.framebuffer[fb_offset..][0..line_bytes];
-                    const src = color_data[src_offset..][0..line_bytes];
-                    @memcpy(dst, src);
+        pub fn busy(self: *const Self) bool {
+            return self.in_flight.load(.acquire);
+        }
+
+        /// Panel bytes the transfer in flight moves (0 when idle), for
+        /// bus timing models
+        pub fn pendingBytes(self: *const Self) usize {
+            if (!self.busy()) return 0;
+            return self.transfer.area.pixelCount() * bpp;
+        }
+
+        /// Block until no transfer is in flight
+        pub fn waitFlush(self: *Self) void {
+            if (config.async_flush == .on_wait) {
+                _ = self.complete();
+                return;
+            }
+            while (self.busy()) std.atomic.spinLoopHint();
+        }
+
+        /// Refresh `areas` of a full-frame source framebuffer
+        /// (`width * height` pixels in `color_format`).
+        pub fn flushAreas(self: *Self, fb: []const u8, areas: []const Area) void {
+            std.debug.assert(fb.len >= @as(usize, w) * h * src_bpp);
+            for (areas) |area| {
+                self.flush_count += 1;
+                self.last_area = area;
+                self.openWindow(area);
+                const offset = (@as(usize, area.y1) * w + area.x1) * src_bpp;
+                flush_mod.streamWindow(conv, fb[offset..], w, area.width(), area.height(), &self.tx, self);
+            }
+        }
+
+        /// Flush pipeline sink: write panel-format bytes at the window
+        /// cursor, wrapping at the window's right edge like panel GRAM.
+        /// Rows that fall outside the framebuffer are dropped.
+        pub fn sendPixels(self: *Self, bytes: []const u8) void {
+            self.stats.bytes += bytes.len;
+            const area_w = @as(u32, self.window.width());
+            var px: u32 = @intCast(bytes.len / bpp);
+            var src: u32 = 0;
+            while (px > 0) {
+                const row = self.cursor / area_w;
+                const col = self.cursor % area_w;
+                const n = @min(px, area_w - col);
+                const y = @as(u32, self.window.y1) + row;
+                const fb_offset = (y * @as(u32, w) + @as(u32, self.window.x1) + col) * bpp;
+                if (fb_offset + n * bpp <= fb_size) {
+                    @memcpy(self.framebuffer[fb_offset..][0 .. n * bpp], bytes[src * bpp ..][0 .. n * bpp]);
                 }
+                self.cursor += n;
+                src += n;
+                px -= n;
             }
         }
 
+        fn openWindow(self: *Self, area: Area) void {
+            self.stats.windows += 1;
+            self.window = area;
+            self.cursor = 0;
+        }
+
         /// Get a raw pixel value at (x, y) as bytes
         pub fn getPixelBytes(self: *const Self, x: u16, y: u16) [bpp]u8 {
             const offset = (@as(u32, y) * @as(u32, w) + @as(u32, x)) * @as(u32, bpp);
@@ -116,8 +260,6 @@ pub fn MemDisplay(
 // Tests
 // ============================================================================
 
-const std = @import("std");
-
 test "MemDisplay basic" {
     const Disp = MemDisplay(320, 240, .rgb565);
     var disp = Disp.create();
@@ -157,3 +299,60 @@ test "MemDisplay comptime interface" {
     try std.testing.expectEqual(@as(u32, 1), disp.flush_count);
     try std.testing.expect(disp.hasContent(.{ .x1 = 0, .y1 = 0, .x2 = 127, .y2 = 0 }));
 }
+
+test "MemDisplayWith partial windows with panel conversion" {
+    const Disp = MemDisplayWith(16, 8, .{
+        .render_mode = .partial,
+        .buf_lines = 2,
+        .swap_bytes = true,
+    });
+    try std.testing.expectEqual(RenderMode.partial, Disp.render_mode);
+    try std.testing.expectEqual(@as(u16, 2), Disp.buf_lines);
+
+    var disp = Disp.create();
+    var src: [16 * 8 * 2]u8 = undefined;
+    for (0..16 * 8) |i| std.mem.writeInt(u16, src[i * 2 ..][0..2], @intCast(i), .little);
+
+    disp.flushAreas(&src, &.{
+        .{ .x1 = 1, .y1 = 1, .x2 = 3, .y2 = 2 },
+        .{ .x1 = 10, .y1 = 5, .x2 = 15, .y2 = 7 },
+    });
+
+    try std.testing.expectEqual(@as(u32, 2), disp.stats.windows);
+    try std.testing.expectEqual(@as(u64, (6 + 18) * 2), disp.stats.bytes);
+    // Stored big-endian at the same position as the source pixel
+    const p = disp.getPixelBytes(3, 2);
+    try std.testing.expectEqual(@as(u16, 2 * 16 + 3), std.mem.readInt(u16, &p, .big));
+    const q = disp.getPixelBytes(15, 7);
+    try std.testing.expectEqual(@as(u16, 7 * 16 + 15), std.mem.readInt(u16, &q, .big));
+    try std.testing.expect(!disp.hasContent(.{ .x1 = 4, .y1 = 0, .x2 = 9, .y2 = 4 }));
+}
+
+test "MemDisplayWith async flush copies on completion" {
+    const Disp = MemDisplayWith(8, 4, .{ .render_mode = .partial, .buf_lines = 2, .async_flush = .on_wait });
+    try std.testing.expect(Disp.async_flush);
+
+    const Counter = struct {
+        fn done(ctx: *anyopaque) void {
+            const n: *u32 = @ptrCast(@alignCast(ctx));
+            n.* += 1;
+        }
+    };
+    var disp = Disp.create();
+    var signalled: u32 = 0;
+    var buf = [_]u8{0x11} ** (8 * 2 * 2);
+    const area = Area{ .x1 = 0, .y1 = 1, .x2 = 7, .y2 = 2 };
+
+    disp.flushAsync(area, &buf, .{ .ctx = &signalled, .func = Counter.done });
+    try std.testing.expect(disp.busy());
+    try std.testing.expectEqual(@as(usize, 32), disp.pendingBytes());
+    try std.testing.expect(!disp.hasAnyContent());
+
+    // The buffer is read at completion, as a DMA would
+    @memset(&buf, 0x22);
+    disp.waitFlush();
+    try std.testing.expect(!disp.busy());
+    try std.testing.expectEqual(@as(u32, 1), signalled);
+    try std.testing.expectEqual(@as(u8, 0x22), disp.getPixelBytes(3, 2)[0]);
+    try std.testing.expect(!disp.complete());
+}
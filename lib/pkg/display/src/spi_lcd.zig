@@ -25,12 +25,26 @@
 //! var lcd = LcdDriver.init(&spi, &dc);
 //! lcd.flush(area, pixels);
 //! ```
+//!
+//! ## Format conversion and partial refresh
+//!
+//! Set `panel_format` / `swap_bytes` when the panel's wire format differs
+//! from what the UI renders (e.g. LVGL little-endian RGB565 to an ST7789
+//! that wants big-endian). Pixels are converted into a `buf_lines` transfer
+//! buffer chunk by chunk during the flush; with no conversion the caller's
+//! memory goes to the bus untouched.
+//!
+//! `flushAreas(fb, areas)` refreshes several windows of a full-frame
+//! framebuffer; collect them with `DirtyAreas` to merge neighbours first.
 
+const std = @import("std");
 const types = @import("types.zig");
+const flush_mod = @import("flush.zig");
 pub const Area = types.Area;
 pub const ColorFormat = types.ColorFormat;
 pub const RenderMode = types.RenderMode;
 pub const bytesPerPixel = types.bytesPerPixel;
+pub const Stats = flush_mod.Stats;
 
 /// SPI LCD configuration
 pub const Config = struct {
@@ -43,6 +57,10 @@ pub const Config = struct {
     col_offset: u16 = 0,
     /// Row address offset
     row_offset: u16 = 0,
+    /// Pixel format on the wire (null = `color_format`, no conversion)
+    panel_format: ?ColorFormat = null,
+    /// Send RGB565 big-endian, as most SPI panels expect
+    swap_bytes: bool = false,
 };
 
 /// ST7789-compatible commands
@@ -79,6 +97,12 @@ pub fn SpiLcd(comptime Spi: type, comptime DcPin: type, comptime config: Config)
     }
 
     const bpp = bytesPerPixel(config.color_format);
+    const conv = flush_mod.Conversion{
+        .from = config.color_format,
+        .to = config.panel_format orelse config.color_format,
+        .swap565 = config.swap_bytes,
+    };
+    const tx_bytes: usize = if (conv.isIdentity()) 0 else @as(usize, config.width) * config.buf_lines * conv.dstBpp();
 
     return struct {
         const Self = @This();
@@ -86,6 +110,12 @@ pub fn SpiLcd(comptime Spi: type, comptime DcPin: type, comptime config: Config)
         spi: *Spi,
         dc: *DcPin,
 
+        /// Windows and pixel bytes sent so far
+        stats: Stats = .{},
+
+        /// Conversion buffer (empty when no conversion is configured)
+        tx: [tx_bytes]u8 = undefined,
+
         /// SPI error counter — incremented on each failed SPI write.
         /// Upper layers can inspect this for diagnostics (e.g. after flush).
         /// The flush signature must remain `void` (LVGL C callback constraint),
@@ -98,6 +128,7 @@ pub fn SpiLcd(comptime Spi: type, comptime DcPin: type, comptime config: Config)
         pub const color_format: ColorFormat = config.color_format;
         pub const render_mode: RenderMode = config.render_mode;
         pub const buf_lines: u16 = config.buf_lines;
+        pub const conversion = conv;
 
         pub fn init(spi: *Spi, dc: *DcPin) Self {
             if (@hasDecl(Spi, "configureDisplay")) {
@@ -113,6 +144,44 @@ pub fn SpiLcd(comptime Spi: type, comptime DcPin: type, comptime config: Config)
         /// Flush pixels to the LCD.
         /// Sends CASET + RASET + RAMWR commands, then pixel data.
         pub fn flush(self: *Self, area: Area, color_data: [*]const u8) void {
+            self.setWindow(area);
+            const pixel_bytes = area.pixelCount() * @as(u32, bpp);
+            flush_mod.streamWindow(conv, color_data[0..pixel_bytes], area.width(), area.width(), area.height(), &self.tx, Sink{ .lcd = self });
+        }
+
+        /// Refresh `areas` of a full-frame framebuffer (`width * height`
+        /// pixels in `color_format`), one window per area.
+        pub fn flushAreas(self: *Self, fb: []const u8, areas: []const Area) void {
+            std.debug.assert(fb.len >= @as(usize, config.width) * config.height * bpp);
+            for (areas) |area| {
+                self.setWindow(area);
+                const offset = (@as(usize, area.y1) * config.width + area.x1) * bpp;
+                flush_mod.streamWindow(conv, fb[offset..], config.width, area.width(), area.height(), &self.tx, Sink{ .lcd = self });
+            }
+        }
+
+        /// Backlight control — no-op for SPI LCD.
+        /// Board-level code should use a separate GPIO/PWM driver for backlight.
+        pub fn setBacklight(_: *Self, _: u8) void {}
+
+        // ================================================================
+        // Low-level SPI + DC helpers
+        // ================================================================
+
+        /// Pixel sink for the flush pipeline (RAMWR continuation)
+        const Sink = struct {
+            lcd: *Self,
+
+            pub fn sendPixels(self: Sink, bytes: []const u8) void {
+                self.lcd.stats.bytes += bytes.len;
+                self.lcd.writeData(bytes);
+            }
+        };
+
+        /// CASET + RASET for `area`, then RAMWR
+        fn setWindow(self: *Self, area: Area) void {
+            self.stats.windows += 1;
+
             // Set column address (CASET)
             const x1 = area.x1 + config.col_offset;
             const x2 = area.x2 + config.col_offset;
@@ -131,20 +200,9 @@ pub fn SpiLcd(comptime Spi: type, comptime DcPin: type, comptime config: Config)
                 @intCast(y2 >> 8), @intCast(y2 & 0xFF),
             });
 
-            // Write pixel data (RAMWR)
-            const pixel_bytes = area.pixelCount() * @as(u32, bpp);
             self.writeCmd(CMD.RAMWR);
-            self.writeData(color_data[0..pixel_bytes]);
         }
 
-        /// Backlight control — no-op for SPI LCD.
-        /// Board-level code should use a separate GPIO/PWM driver for backlight.
-        pub fn setBacklight(_: *Self, _: u8) void {}
-
-        // ================================================================
-        // Low-level SPI + DC helpers
-        // ================================================================
-
         /// Send a command byte (DC low)
         fn writeCmd(self: *Self, cmd: u8) void {
             self.dc.setLow();
@@ -167,8 +225,6 @@ pub fn SpiLcd(comptime Spi: type, comptime DcPin: type, comptime config: Config)
 // Tests
 // ============================================================================
 
-const std = @import("std");
-
 /// Mock SPI that records all bytes written, tagged with DC level
 const MockSpi = struct {
     const Entry = struct {
@@ -277,6 +333,52 @@ test "SpiLcd with column/row offset" {
     try std.testing.expectEqual(@as(u8, 80), spi.log[1].data[3]); // low byte = offset
 }
 
+test "SpiLcd converts to big-endian RGB565 during transfer" {
+    var dc = MockDcPin{};
+    var spi = MockSpi{ .dc = &dc };
+
+    const Lcd = SpiLcd(MockSpi, MockDcPin, .{
+        .width = 16,
+        .height = 16,
+        .buf_lines = 1,
+        .swap_bytes = true,
+    });
+    var lcd = Lcd.init(&spi, &dc);
+
+    // 16x2 area: two 32-byte chunks through the 1-line transfer buffer
+    var pixels: [16 * 2 * 2]u8 = undefined;
+    for (0..32) |i| std.mem.writeInt(u16, pixels[i * 2 ..][0..2], @intCast(0x100 + i), .little);
+    lcd.flush(.{ .x1 = 0, .y1 = 0, .x2 = 15, .y2 = 1 }, &pixels);
+
+    try std.testing.expectEqual(@as(usize, 7), spi.log_count);
+    try std.testing.expectEqual(@as(usize, 32), spi.log[5].len);
+    try std.testing.expectEqual(@as(u8, 0x01), spi.log[5].data[0]);
+    try std.testing.expectEqual(@as(u8, 0x00), spi.log[5].data[1]);
+    try std.testing.expectEqual(@as(u8, 0x1F), spi.log[6].data[31]);
+    try std.testing.expectEqual(@as(u64, 64), lcd.stats.bytes);
+}
+
+test "SpiLcd flushAreas opens one window per area" {
+    var dc = MockDcPin{};
+    var spi = MockSpi{ .dc = &dc };
+
+    const Lcd = SpiLcd(MockSpi, MockDcPin, .{ .width = 8, .height = 8 });
+    var lcd = Lcd.init(&spi, &dc);
+
+    var fb: [8 * 8 * 2]u8 = undefined;
+    for (&fb, 0..) |*b, i| b.* = @intCast(i);
+    lcd.flushAreas(&fb, &.{
+        .{ .x1 = 0, .y1 = 0, .x2 = 7, .y2 = 1 }, // full rows: one write
+        .{ .x1 = 2, .y1 = 4, .x2 = 3, .y2 = 5 }, // sub-rows: one write per row
+    });
+
+    try std.testing.expectEqual(@as(u32, 2), lcd.stats.windows);
+    try std.testing.expectEqual(@as(u64, 32 + 8), lcd.stats.bytes);
+    try std.testing.expectEqual(@as(usize, 6 + 5 + 2), spi.log_count);
+    try std.testing.expectEqual(@as(u8, (4 * 8 + 2) * 2), spi.log[11].data[0]);
+    try std.testing.expectEqual(@as(u8, (5 * 8 + 2) * 2), spi.log[12].data[0]);
+}
+
 test "SpiLcd compile-time properties" {
     const Lcd = SpiLcd(MockSpi, MockDcPin, .{
         .width = 320,
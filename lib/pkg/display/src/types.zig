@@ -30,6 +30,19 @@ pub const RenderMode = enum {
     full,
 };
 
+/// Completion handle for an asynchronous flush (drivers with
+/// `async_flush = true`). The driver calls `signal` exactly once, when the
+/// transfer has finished reading the pixel buffer — typically from the
+/// DMA-done interrupt. Until then the UI must not reuse that buffer.
+pub const FlushDone = struct {
+    ctx: *anyopaque,
+    func: *const fn (ctx: *anyopaque) void,
+
+    pub fn signal(self: FlushDone) void {
+        self.func(self.ctx);
+    }
+};
+
 /// Rectangular area on the display
 pub const Area = struct {
     x1: u16,
@@ -48,6 +61,30 @@ pub const Area = struct {
     pub fn pixelCount(self: Area) u32 {
         return @as(u32, self.width()) * @as(u32, self.height());
     }
+
+    /// Bounding box of both areas
+    pub fn merge(self: Area, other: Area) Area {
+        return .{
+            .x1 = @min(self.x1, other.x1),
+            .y1 = @min(self.y1, other.y1),
+            .x2 = @max(self.x2, other.x2),
+            .y2 = @max(self.y2, other.y2),
+        };
+    }
+
+    /// Whether the areas share at least one pixel
+    pub fn intersects(self: Area, other: Area) bool {
+        return self.x1 <= other.x2 and other.x1 <= self.x2 and
+            self.y1 <= other.y2 and other.y1 <= self.y2;
+    }
+
+    /// Pixels covered by both areas
+    pub fn overlapCount(self: Area, other: Area) u32 {
+        if (!self.intersects(other)) return 0;
+        const w = @as(u32, @min(self.x2, other.x2) - @max(self.x1, other.x1)) + 1;
+        const h = @as(u32, @min(self.y2, other.y2) - @max(self.y1, other.y1)) + 1;
+        return w * h;
+    }
 };
 
 /// Bytes per pixel for a given color format
@@ -72,6 +109,16 @@ test "Area calculations" {
     try std.testing.expectEqual(@as(u32, 4000), area.pixelCount());
 }
 
+test "Area merge and overlap" {
+    const a = Area{ .x1 = 0, .y1 = 0, .x2 = 9, .y2 = 9 };
+    const b = Area{ .x1 = 5, .y1 = 5, .x2 = 14, .y2 = 9 };
+    const c = Area{ .x1 = 10, .y1 = 0, .x2 = 19, .y2 = 9 };
+    try std.testing.expectEqual(Area{ .x1 = 0, .y1 = 0, .x2 = 14, .y2 = 9 }, a.merge(b));
+    try std.testing.expectEqual(@as(u32, 25), a.overlapCount(b));
+    try std.testing.expect(!a.intersects(c));
+    try std.testing.expectEqual(@as(u32, 0), a.overlapCount(c));
+}
+
 test "bytesPerPixel" {
     try std.testing.expectEqual(@as(u8, 2), bytesPerPixel(.rgb565));
     try std.testing.expectEqual(@as(u8, 3), bytesPerPixel(.rgb888));
@@ -16,24 +16,31 @@
 //! App must provide:
 //!   pub const State: type           — AppState struct
 //!   pub const Event: type           — AppEvent union(enum)
-//!   pub fn reduce(*State, Event) void
+//!   pub fn reduce(*State, Event) void  — or reduce(Tracked(State), Event)
+//!                                         for field-level change masks
 //!   pub fn render(*Framebuffer, *const State, *const Resources) void
 //!   pub const Resources: type       — immutable resources struct
 
 const Store = @import("store.zig").Store;
 
 pub fn AppStateManager(comptime App: type) type {
-    comptime {
+    const AppStore = Store(App.State, App.Event);
+    const tracked = comptime blk: {
         // Validate App has required declarations
         _ = @as(type, App.State);
         _ = @as(type, App.Event);
-        _ = @as(*const fn (*App.State, App.Event) void, &App.reduce);
-    }
+        const Reduce = @TypeOf(App.reduce);
+        if (Reduce == fn (*App.State, App.Event) void) break :blk false;
+        if (Reduce == fn (AppStore.Tracked, App.Event) void) break :blk true;
+        @compileError("App.reduce must be fn(*State, Event) void or fn(Tracked(State), Event) void");
+    };
 
     return struct {
         const Self = @This();
 
-        store: Store(App.State, App.Event),
+        pub const Mask = AppStore.Mask;
+
+        store: AppStore,
         last_render_ms: u64 = 0,
         rendered_once: bool = false,
         min_frame_interval_ms: u32,
@@ -46,7 +53,10 @@ pub fn AppStateManager(comptime App: type) type {
 
         pub fn init(config: Config) Self {
             return .{
-                .store = Store(App.State, App.Event).init(config.initial_state, App.reduce),
+                .store = if (tracked)
+                    AppStore.initTracked(config.initial_state, App.reduce)
+                else
+                    AppStore.init(config.initial_state, App.reduce),
                 .min_frame_interval_ms = if (config.fps == 0) 0 else 1000 / @as(u32, config.fps),
                 .fps = config.fps,
             };
@@ -74,6 +84,15 @@ pub fn AppStateManager(comptime App: type) type {
             return true;
         }
 
+        /// Earliest time `shouldRender` can return true, for tickless UI
+        /// loops: null while the state is clean (nothing to wake for),
+        /// otherwise the end of the current frame interval.
+        pub fn nextFrameMs(self: *const Self, now_ms: u64) ?u64 {
+            if (!self.store.isDirty()) return null;
+            if (self.fps == 0 or !self.rendered_once) return now_ms;
+            return @max(now_ms, self.last_render_ms + self.min_frame_interval_ms);
+        }
+
         /// Mark render as done. Call after render + flush completes.
         pub fn commitFrame(self: *Self, now_ms: u64) void {
             self.store.commitFrame();
@@ -95,6 +114,11 @@ pub fn AppStateManager(comptime App: type) type {
         pub fn isDirty(self: *const Self) bool {
             return self.store.isDirty();
         }
+
+        /// Fields changed since last commitFrame, for mask-driven renderers.
+        pub fn changes(self: *const Self) Mask {
+            return self.store.changes();
+        }
     };
 }
 
@@ -159,6 +183,19 @@ test "AppStateManager: shouldRender respects fps" {
     app.commitFrame(66);
 }
 
+test "AppStateManager: nextFrameMs only while dirty" {
+    var app = AppStateManager(TestApp).init(.{ .fps = 30 });
+
+    // First frame renders as soon as possible
+    try testing.expectEqual(@as(?u64, 5), app.nextFrameMs(5));
+    app.commitFrame(5);
+    try testing.expectEqual(@as(?u64, null), app.nextFrameMs(10));
+
+    app.dispatch(.increment);
+    try testing.expectEqual(@as(?u64, 38), app.nextFrameMs(10));
+    try testing.expectEqual(@as(?u64, 50), app.nextFrameMs(50));
+}
+
 test "AppStateManager: fps=0 unlimited" {
     var app = AppStateManager(TestApp).init(.{ .fps = 0 });
     app.dispatch(.increment);
@@ -197,3 +234,33 @@ test "AppStateManager: state navigation" {
     app.dispatch(.{ .navigate = .home });
     try testing.expectEqual(.home, app.getState().page);
 }
+
+const TrackedApp = struct {
+    pub const State = TestApp.State;
+    pub const Event = TestApp.Event;
+
+    pub fn reduce(s: Store(State, Event).Tracked, event: Event) void {
+        switch (event) {
+            .increment => s.set(.count, s.get(.count) + 1),
+            .decrement => if (s.get(.count) > 0) s.set(.count, s.get(.count) - 1),
+            .navigate => |page| s.set(.page, switch (page) {
+                .home => .home,
+                .settings => .settings,
+            }),
+        }
+    }
+};
+
+test "AppStateManager: tracked reducer exposes the change mask" {
+    var app = AppStateManager(TrackedApp).init(.{ .fps = 0 });
+    app.commitFrame(0);
+
+    app.dispatch(.{ .navigate = .home }); // already home
+    try testing.expect(!app.shouldRender(1));
+
+    app.dispatch(.{ .navigate = .settings });
+    try testing.expect(app.shouldRender(1));
+    try testing.expect(app.changes().isSet(.page) and !app.changes().isSet(.count));
+    app.commitFrame(1);
+    try testing.expectEqual(.settings, app.getPrev().page);
+}
@@ -0,0 +1,198 @@
+//! Field-level change tracking for Flux state
+//!
+//! `FieldMask(State)` is one bit per top-level field of `State`, laid out
+//! at comptime. A reducer written against `Tracked(State)` sets the bit of
+//! every field it actually changes, so bindings and compositors can skip
+//! everything else without comparing current and previous state field by
+//! field — the cost of a frame follows what changed, not how big the
+//! state is.
+//!
+//! ```zig
+//! fn reduce(s: flux.Tracked(State), e: Event) void {
+//!     switch (e) {
+//!         .tick => s.set(.time_sec, s.get(.time_sec) + 1),
+//!         .move => |dx| s.ptr(.player).x += dx,
+//!         .reset => s.replace(.{}),
+//!     }
+//! }
+//!
+//! var store = flux.Store(State, Event).initTracked(.{}, reduce);
+//! store.dispatch(.tick);
+//! store.changes().isSet(.time_sec); // true, nothing else set
+//! ```
+
+const std = @import("std");
+
+/// One bit per field of `State` (a struct).
+pub fn FieldMask(comptime State: type) type {
+    const fields = std.meta.fields(State);
+
+    return struct {
+        const Self = @This();
+
+        pub const Field = std.meta.FieldEnum(State);
+        pub const len = fields.len;
+
+        bits: std.StaticBitSet(len),
+
+        pub fn initEmpty() Self {
+            return .{ .bits = .initEmpty() };
+        }
+
+        pub fn initFull() Self {
+            return .{ .bits = .initFull() };
+        }
+
+        /// Mask of the fields in `list`, a tuple of field tags:
+        /// `comptime Mask.of(.{ .score, .page })`.
+        pub fn of(list: anytype) Self {
+            var self = initEmpty();
+            inline for (list) |f| self.set(f);
+            return self;
+        }
+
+        pub fn set(self: *Self, field: Field) void {
+            self.bits.set(@intFromEnum(field));
+        }
+
+        pub fn isSet(self: Self, field: Field) bool {
+            return self.bits.isSet(@intFromEnum(field));
+        }
+
+        pub fn any(self: Self) bool {
+            return self.bits.findFirstSet() != null;
+        }
+
+        pub fn count(self: Self) usize {
+            return self.bits.count();
+        }
+
+        pub fn intersects(self: Self, other: Self) bool {
+            return self.bits.intersectWith(other.bits).findFirstSet() != null;
+        }
+
+        pub fn setUnion(self: *Self, other: Self) void {
+            self.bits.setUnion(other.bits);
+        }
+
+        /// Fields that differ between `a` and `b`, by full comparison.
+        /// The fallback for reducers that do not track their writes.
+        pub fn diff(a: *const State, b: *const State) Self {
+            var self = initEmpty();
+            inline for (fields, 0..) |f, i| {
+                if (!std.meta.eql(@field(a, f.name), @field(b, f.name))) self.bits.set(i);
+            }
+            return self;
+        }
+
+        /// Copy the fields in this mask from `src` to `dst`
+        pub fn copy(self: Self, dst: *State, src: *const State) void {
+            inline for (fields, 0..) |f, i| {
+                if (self.bits.isSet(i)) @field(dst, f.name) = @field(src, f.name);
+            }
+        }
+    };
+}
+
+/// State handle given to tracked reducers: reads are free, writes mark
+/// the field in the store's change mask.
+pub fn Tracked(comptime State: type) type {
+    return struct {
+        const Self = @This();
+
+        pub const Mask = FieldMask(State);
+        pub const Field = Mask.Field;
+
+        state: *State,
+        mask: *Mask,
+
+        pub fn FieldType(comptime field: Field) type {
+            return @FieldType(State, @tagName(field));
+        }
+
+        pub fn get(self: Self, comptime field: Field) FieldType(field) {
+            return @field(self.state, @tagName(field));
+        }
+
+        /// Read-only view of the whole state
+        pub fn read(self: Self) *const State {
+            return self.state;
+        }
+
+        /// Write a field; marks it only if the value differs.
+        pub fn set(self: Self, comptime field: Field, value: FieldType(field)) void {
+            const slot = &@field(self.state, @tagName(field));
+            if (std.meta.eql(slot.*, value)) return;
+            slot.* = value;
+            self.mask.set(field);
+        }
+
+        /// Pointer for in-place mutation of a field; marks it
+        /// unconditionally.
+        pub fn ptr(self: Self, comptime field: Field) *FieldType(field) {
+            self.mask.set(field);
+            return &@field(self.state, @tagName(field));
+        }
+
+        /// Replace the whole state, marking the fields that differ.
+        pub fn replace(self: Self, new: State) void {
+            self.mask.setUnion(Mask.diff(self.state, &new));
+            self.state.* = new;
+        }
+    };
+}
+
+// ============================================================================
+// Tests
+// ============================================================================
+
+const testing = std.testing;
+
+const TestState = struct {
+    count: u32 = 0,
+    name: [4]u8 = .{ 0, 0, 0, 0 },
+    pos: struct { x: i16 = 0, y: i16 = 0 } = .{},
+};
+
+test "FieldMask: comptime masks and set operations" {
+    const Mask = FieldMask(TestState);
+    const watch = comptime Mask.of(.{ .count, .pos });
+    try testing.expectEqual(@as(usize, 2), watch.count());
+
+    var m = Mask.initEmpty();
+    try testing.expect(!m.any() and !m.intersects(watch));
+    m.set(.name);
+    try testing.expect(!m.intersects(watch));
+    m.set(.pos);
+    try testing.expect(m.intersects(watch));
+    try testing.expect(Mask.initFull().isSet(.name));
+}
+
+test "FieldMask: diff and copy" {
+    const Mask = FieldMask(TestState);
+    var a = TestState{};
+    const b = TestState{ .count = 1, .pos = .{ .y = 3 } };
+    const d = Mask.diff(&a, &b);
+    try testing.expect(d.isSet(.count) and d.isSet(.pos) and !d.isSet(.name));
+
+    d.copy(&a, &b);
+    try testing.expect(std.meta.eql(a, b));
+}
+
+test "Tracked: writes mark only changed fields" {
+    var state = TestState{};
+    var mask = FieldMask(TestState).initEmpty();
+    const t = Tracked(TestState){ .state = &state, .mask = &mask };
+
+    t.set(.count, 0); // same value
+    try testing.expect(!mask.any());
+    t.set(.count, t.get(.count) + 5);
+    t.ptr(.pos).x = 7;
+    try testing.expect(mask.isSet(.count) and mask.isSet(.pos) and !mask.isSet(.name));
+    try testing.expectEqual(@as(i16, 7), state.pos.x);
+
+    mask = .initEmpty();
+    t.replace(.{ .count = 5, .pos = .{ .x = 7 }, .name = "abcd".* });
+    try testing.expectEqual(@as(usize, 1), mask.count());
+    try testing.expect(mask.isSet(.name));
+}
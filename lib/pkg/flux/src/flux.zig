@@ -5,6 +5,7 @@
 //! Core components:
 //!   Store: Redux-style state container (dispatch, reduce, commitFrame)
 //!   AppStateManager: Event dispatch + frame-rate controlled render scheduling
+//!   FieldMask / Tracked: per-field change masks built by tracked reducers
 //!
 //! Usage:
 //!   const flux = @import("flux");
@@ -18,10 +19,13 @@
 
 pub const Store = @import("store.zig").Store;
 pub const AppStateManager = @import("app_state_manager.zig").AppStateManager;
+pub const FieldMask = @import("changes.zig").FieldMask;
+pub const Tracked = @import("changes.zig").Tracked;
 
 test {
     const std = @import("std");
     std.testing.refAllDecls(@This());
     _ = @import("store.zig");
     _ = @import("app_state_manager.zig");
+    _ = @import("changes.zig");
 }
@@ -5,6 +5,11 @@
 //!   render checks isDirty() → reads state/prev → draws framebuffer
 //!   commitFrame() snapshots prev = state, clears dirty
 //!
+//! Tracked stores (`initTracked`) hand the reducer a `Tracked(State)`
+//! instead of `*State`; its writes build the per-field change mask
+//! returned by `changes()`, and `commitFrame` copies only those fields
+//! into prev. Plain stores compute the same mask by diffing state and prev.
+//!
 //! Thread safety: Store is designed for single-thread use.
 //! External threads push events via a Channel, the UI thread
 //! drains the channel and calls dispatch().
@@ -33,10 +38,21 @@ pub fn Store(comptime State: type, comptime Event: type) type {
     return struct {
         const Self = @This();
 
+        pub const Mask = changes_mod.FieldMask(State);
+        pub const Tracked = changes_mod.Tracked(State);
+
+        pub const Reducer = union(enum) {
+            plain: *const fn (*State, Event) void,
+            tracked: *const fn (Tracked, Event) void,
+        };
+
         state: State,
         prev: State,
         dirty: bool,
-        reducer: *const fn (*State, Event) void,
+        reducer: Reducer,
+        /// Fields written since the last commitFrame by a tracked reducer;
+        /// full until the first commitFrame.
+        changed: Mask,
 
         /// Create a store with initial state and reducer function.
         pub fn init(initial: State, reducer: *const fn (*State, Event) void) Self {
@@ -44,27 +60,55 @@ pub fn Store(comptime State: type, comptime Event: type) type {
                 .state = initial,
                 .prev = initial,
                 .dirty = true, // first frame always needs render
-                .reducer = reducer,
+                .reducer = .{ .plain = reducer },
+                .changed = .initFull(),
+            };
+        }
+
+        /// Create a store whose reducer records the fields it changes.
+        /// Dispatching an event that changes nothing leaves the store clean.
+        pub fn initTracked(initial: State, reducer: *const fn (Tracked, Event) void) Self {
+            return .{
+                .state = initial,
+                .prev = initial,
+                .dirty = true,
+                .reducer = .{ .tracked = reducer },
+                .changed = .initFull(), // first frame renders every field
             };
         }
 
         /// Dispatch a single event — calls reducer, marks dirty.
         pub fn dispatch(self: *Self, event: Event) void {
-            self.reducer(&self.state, event);
-            self.dirty = true;
+            switch (self.reducer) {
+                .plain => |reduce| {
+                    reduce(&self.state, event);
+                    self.dirty = true;
+                },
+                .tracked => |reduce| {
+                    reduce(.{ .state = &self.state, .mask = &self.changed }, event);
+                    self.dirty = self.dirty or self.changed.any();
+                },
+            }
         }
 
         /// Dispatch multiple events in a batch — calls reducer for each,
         /// marks dirty once at the end.
         pub fn dispatchBatch(self: *Self, events: []const Event) void {
             for (events) |event| {
-                self.reducer(&self.state, event);
-            }
-            if (events.len > 0) {
-                self.dirty = true;
+                self.dispatch(event);
             }
         }
 
+        /// Fields that changed since the last commitFrame. Tracked stores
+        /// return the mask their reducer built; plain stores diff state
+        /// against prev.
+        pub fn changes(self: *const Self) Mask {
+            return switch (self.reducer) {
+                .plain => if (self.changed.count() == Mask.len) self.changed else Mask.diff(&self.state, &self.prev),
+                .tracked => self.changed,
+            };
+        }
+
         /// Check if state changed since last commitFrame.
         pub fn isDirty(self: *const Self) bool {
             return self.dirty;
@@ -81,14 +125,21 @@ pub fn Store(comptime State: type, comptime Event: type) type {
         }
 
         /// End frame — snapshot current state as prev, clear dirty.
-        /// Call this after rendering is complete.
+        /// Call this after rendering is complete. Tracked stores copy only
+        /// the changed fields.
         pub fn commitFrame(self: *Self) void {
-            self.prev = self.state;
+            switch (self.reducer) {
+                .plain => self.prev = self.state,
+                .tracked => self.changed.copy(&self.prev, &self.state),
+            }
+            self.changed = .initEmpty();
             self.dirty = false;
         }
     };
 }
 
+const changes_mod = @import("changes.zig");
+
 // ============================================================================
 // Tests
 // ============================================================================
@@ -189,3 +240,43 @@ test "reset via dispatch" {
     store.dispatch(.reset);
     try testing.expectEqual(@as(u32, 0), store.getState().count);
 }
+
+fn testTrackedReducer(s: Store(TestState, TestEvent).Tracked, event: TestEvent) void {
+    switch (event) {
+        .increment => s.set(.count, s.get(.count) + 1),
+        .decrement => if (s.get(.count) > 0) s.set(.count, s.get(.count) - 1),
+        .reset => s.replace(.{}),
+        .add => |n| s.set(.count, s.get(.count) + n),
+    }
+}
+
+test "tracked store reports changed fields and skips no-op events" {
+    var store = Store(TestState, TestEvent).initTracked(.{}, testTrackedReducer);
+    try testing.expectEqual(@as(usize, 2), store.changes().count());
+    store.commitFrame();
+
+    store.dispatch(.decrement); // count already 0
+    try testing.expect(!store.isDirty());
+    try testing.expect(!store.changes().any());
+
+    store.dispatchBatch(&[_]TestEvent{ .increment, .{ .add = 4 } });
+    try testing.expect(store.isDirty());
+    try testing.expect(store.changes().isSet(.count) and !store.changes().isSet(.name));
+    try testing.expectEqual(@as(u32, 0), store.getPrev().count);
+
+    store.commitFrame();
+    try testing.expectEqual(@as(u32, 5), store.getPrev().count);
+    try testing.expect(!store.changes().any());
+}
+
+test "plain store changes() diffs against prev" {
+    var store = Store(TestState, TestEvent).init(.{}, testReducer);
+    try testing.expectEqual(@as(usize, 2), store.changes().count());
+    store.commitFrame();
+
+    store.dispatch(.{ .add = 3 });
+    const c = store.changes();
+    try testing.expect(c.isSet(.count) and !c.isSet(.name));
+    store.dispatch(.reset);
+    try testing.expect(!store.changes().any());
+}
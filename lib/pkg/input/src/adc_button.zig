@@ -14,7 +14,7 @@
 //!     │
 //!     ▼
 //! AdcButtonSet(AdcReader, N)
-//!     │  • Background polling task
+//!     │  • Background polling task, or a member of sampler.Engine
 //!     │  • ADC value → button mapping
 //!     │  • State change detection
 //!     │
@@ -56,6 +56,9 @@ const std = @import("std");
 
 const RingBuffer = @import("ring_buffer.zig").RingBuffer;
 
+/// Batched, event-driven ADC sampling engine (shared with hal.ButtonGroup)
+pub const sampler = @import("sampler.zig");
+
 // ============================================================================
 // ButtonEvents - Generic button event buffer (platform-independent)
 // ============================================================================
@@ -169,7 +172,8 @@ pub const ButtonEvents = struct {
 /// Create an ADC button set type for a specific ADC reader and button count.
 ///
 /// `AdcReader` must have a `readMv() u32` function that returns the current
-/// ADC value in millivolts.
+/// ADC value in millivolts. It may also have `readBatchMv(out: []u32) usize`
+/// returning the newest DMA samples (oldest first) for `sampleBatch`.
 pub fn AdcButtonSet(
     comptime AdcReader: type,
     comptime num_buttons: comptime_int,
@@ -227,6 +231,10 @@ pub fn AdcButtonSet(
 
             /// Sleep function (platform-dependent)
             sleep_ms: ?SleepMsFn = null,
+
+            /// Agreeing samples required for a press/release in
+            /// `sampleBatch` (replaces the sleeping readStable of `poll`)
+            debounce_samples: u8 = 2,
         };
 
         // -------------------------- State --------------------------
@@ -251,6 +259,11 @@ pub fn AdcButtonSet(
         /// Task control
         running: bool = false,
 
+        /// Batch path: ref/non-ref debouncer and lowest reading of the
+        /// pending press (same minimum rule as readStable)
+        debounce: sampler.Debounce(bool) = sampler.Debounce(bool).init(true),
+        pending_min_mv: u32 = std.math.maxInt(u32),
+
         // -------------------------- Lifecycle --------------------------
 
         /// Initialize with configuration
@@ -335,6 +348,48 @@ pub fn AdcButtonSet(
             }
         }
 
+        /// Read a batch of samples and process each at its own timestamp
+        /// (sampler.Engine member). Never sleeps.
+        pub fn sampleBatch(self: *Self, max: usize, period_ms: u32) usize {
+            var buf: [sampler.MAX_BATCH]u32 = undefined;
+            const out = buf[0..@min(max, buf.len)];
+            if (out.len == 0) return 0;
+            const n = if (@hasDecl(AdcReader, "readBatchMv"))
+                @min(AdcReader.readBatchMv(out), out.len)
+            else blk: {
+                out[0] = AdcReader.readMv();
+                break :blk 1;
+            };
+            const now_ms = self.time_fn();
+            for (out[0..n], 0..) |mv, i| {
+                self.processSample(mv, sampler.sampleTime(now_ms, i, n, period_ms));
+            }
+            return n;
+        }
+
+        /// No button held and no press pending debounce
+        pub fn isIdle(self: *const Self) bool {
+            return self.is_at_ref and self.debounce.count == 0;
+        }
+
+        fn processSample(self: *Self, mv: u32, now_ms: u64) void {
+            const cur_is_ref = self.isRefValue(mv);
+            if (!cur_is_ref) self.pending_min_mv = @min(self.pending_min_mv, mv);
+
+            const stable_ref = self.debounce.feed(cur_is_ref, self.config.debounce_samples) orelse {
+                if (self.debounce.count == 0) self.pending_min_mv = std.math.maxInt(u32);
+                return;
+            };
+            const stable_mv = if (stable_ref) mv else self.pending_min_mv;
+            self.pending_min_mv = std.math.maxInt(u32);
+
+            self.handleButtonChange(self.findButton(stable_mv), now_ms);
+            self.is_at_ref = stable_ref;
+            self.start_value_mv = stable_mv;
+            self.last_value_mv = stable_mv;
+            self.state_start_ms = now_ms;
+        }
+
         /// Read ADC multiple times and return minimum (for debouncing)
         fn readStable(self: *Self, first_value: u32) u32 {
             var min_value = first_value;
@@ -1345,3 +1400,58 @@ test "AdcButtonSet: ESP-ADF ranges - voltage just outside range" {
     btns.poll();
     try std.testing.expectEqual(@as(i8, -1), btns.getCurrentButton());
 }
+
+// ============================================================================
+// AdcButtonSet Tests - Batched sampling
+// ============================================================================
+
+test "AdcButtonSet: sampleBatch debounces a DMA batch" {
+    const Time = createMockTimeSource();
+    const DmaAdc = struct {
+        var batch: []const u32 = &.{};
+        pub fn readMv() u32 {
+            return batch[batch.len - 1];
+        }
+        pub fn readBatchMv(out: []u32) usize {
+            const n = @min(out.len, batch.len);
+            @memcpy(out[0..n], batch[batch.len - n ..]);
+            return n;
+        }
+    };
+
+    const Buttons = AdcButtonSet(DmaAdc, 2);
+    var btns = Buttons.init(.{
+        .ranges = .{
+            .{ .min_mv = 2700, .max_mv = 3000 },
+            .{ .min_mv = 2200, .max_mv = 2600 },
+        },
+        .debounce_samples = 2,
+    }, Time.now);
+
+    // Single-sample glitch is ignored
+    DmaAdc.batch = &.{ 3300, 2400, 3300, 3300 };
+    Time.set(20);
+    try std.testing.expectEqual(@as(usize, 4), btns.sampleBatch(4, 5));
+    try std.testing.expectEqual(@as(i8, -1), btns.getCurrentButton());
+    try std.testing.expect(btns.isIdle());
+
+    // Press confirmed on the second agreeing sample, timestamped in-batch
+    DmaAdc.batch = &.{ 3300, 2450, 2400, 2400 };
+    Time.set(40);
+    _ = btns.sampleBatch(4, 5);
+    try std.testing.expectEqual(@as(i8, 1), btns.getCurrentButton());
+    try std.testing.expect(!btns.isIdle());
+
+    // Release
+    DmaAdc.batch = &.{ 2400, 3300, 3300, 3300 };
+    Time.set(60);
+    _ = btns.sampleBatch(4, 5);
+    try std.testing.expectEqual(@as(i8, -1), btns.getCurrentButton());
+    const state = btns.getState(1);
+    try std.testing.expect(!state.is_pressed);
+    try std.testing.expectEqual(@as(u8, 1), state.consecutive_clicks);
+}
+
+test {
+    _ = sampler;
+}
@@ -0,0 +1,237 @@
+//! ADC Sampling Engine - batched, event-driven sampling for ADC buttons
+//!
+//! Replaces one-sample-per-wakeup polling. A single task wakes, pulls a
+//! batch of samples from every member's driver, runs each member's
+//! debounce and gesture state machine over the batch with per-sample
+//! timestamps, then sleeps:
+//!
+//!   - while a button is active: one wakeup per `batch_len` samples
+//!   - while every member is idle: one wakeup per `idle_period_ms`, or a
+//!     blocking wake function (ADC threshold / watchdog interrupt) if set
+//!
+//! Drivers with a DMA ring expose `readBatch(out: []u16) usize` returning
+//! the newest samples, oldest first. Drivers without it are read once per
+//! wakeup through `readRaw()`.
+//!
+//! Members are `hal.ButtonGroup` or `AdcButtonSet` instances - anything with
+//! `sampleBatch(max, period_ms) usize` and `isIdle() bool`.
+//!
+//! ## Usage
+//!
+//! ```zig
+//! const Engine = sampler.Engine(struct { *VolumeLadder, *MediaLadder });
+//! var engine = Engine.init(.{ &board.buttons, &media }, .{});
+//! engine.run(sleepMs); // in a background task
+//! ```
+
+const std = @import("std");
+
+/// Largest batch a member reads per wakeup
+pub const MAX_BATCH = 32;
+
+pub const Config = struct {
+    /// Spacing between samples inside a batch (DMA conversion period)
+    sample_period_ms: u32 = 5,
+    /// Samples per wakeup while a button is active
+    batch_len: u8 = 4,
+    /// Wakeup period while all members are idle
+    idle_period_ms: u32 = 50,
+};
+
+/// Wakeup accounting (for power tuning and benchmarks)
+pub const Stats = struct {
+    wakeups: u64 = 0,
+    idle_wakeups: u64 = 0,
+    samples: u64 = 0,
+};
+
+/// Sample-count debouncer: a new level is accepted after `need`
+/// consecutive samples agree. `need <= 1` accepts immediately.
+pub fn Debounce(comptime T: type) type {
+    return struct {
+        const Self = @This();
+
+        stable: T,
+        candidate: T,
+        count: u8 = 0,
+
+        pub fn init(level: T) Self {
+            return .{ .stable = level, .candidate = level };
+        }
+
+        /// Feed one sample; returns the new stable level when it changes
+        pub fn feed(self: *Self, level: T, need: u8) ?T {
+            if (level == self.stable) {
+                self.candidate = level;
+                self.count = 0;
+                return null;
+            }
+            if (level != self.candidate) {
+                self.candidate = level;
+                self.count = 0;
+            }
+            self.count +|= 1;
+            if (self.count < @max(need, 1)) return null;
+            self.stable = level;
+            self.count = 0;
+            return level;
+        }
+
+        pub fn reset(self: *Self, level: T) void {
+            self.* = init(level);
+        }
+    };
+}
+
+/// Read up to `out.len` raw samples from a driver pointer. Uses the
+/// driver's DMA batch when it has one, otherwise a single `readRaw()`.
+pub fn readBatch(driver: anytype, out: []u16) usize {
+    if (out.len == 0) return 0;
+    const D = @typeInfo(@TypeOf(driver)).pointer.child;
+    if (@hasDecl(D, "readBatch")) return @min(driver.readBatch(out), out.len);
+    out[0] = driver.readRaw();
+    return 1;
+}
+
+/// Timestamp of sample `i` of `n` in a batch read at `now_ms`
+pub fn sampleTime(now_ms: u64, i: usize, n: usize, period_ms: u32) u64 {
+    return now_ms -| @as(u64, n - 1 - i) * period_ms;
+}
+
+/// Sampling engine over a tuple of member pointers
+pub fn Engine(comptime Members: type) type {
+    const fields = @typeInfo(Members).@"struct".fields;
+
+    return struct {
+        const Self = @This();
+
+        /// Blocks until ADC activity or `timeout_ms` elapses
+        pub const WakeFn = *const fn (timeout_ms: u32) void;
+
+        members: Members,
+        config: Config,
+        stats: Stats = .{},
+        idle: bool = true,
+        running: bool = false,
+        wake_fn: ?WakeFn = null,
+
+        pub fn init(members: Members, config: Config) Self {
+            std.debug.assert(config.batch_len >= 1 and config.batch_len <= MAX_BATCH);
+            return .{ .members = members, .config = config };
+        }
+
+        /// Use a blocking wake source instead of timed idle checks
+        pub fn setWake(self: *Self, wake_fn: WakeFn) void {
+            self.wake_fn = wake_fn;
+        }
+
+        /// One wakeup: sample every member. Returns ms until the next one.
+        pub fn step(self: *Self) u32 {
+            var idle = true;
+            inline for (fields) |f| {
+                const member = @field(self.members, f.name);
+                self.stats.samples += member.sampleBatch(self.config.batch_len, self.config.sample_period_ms);
+                if (!member.isIdle()) idle = false;
+            }
+            self.idle = idle;
+            self.stats.wakeups += 1;
+            if (idle) {
+                self.stats.idle_wakeups += 1;
+                return self.config.idle_period_ms;
+            }
+            return self.config.sample_period_ms * self.config.batch_len;
+        }
+
+        /// Run until `stop()`. Call from a dedicated task.
+        pub fn run(self: *Self, sleep_fn: *const fn (u32) void) void {
+            self.running = true;
+            while (self.running) {
+                const delay_ms = self.step();
+                if (self.idle) {
+                    if (self.wake_fn) |wake| {
+                        wake(delay_ms);
+                        continue;
+                    }
+                }
+                sleep_fn(delay_ms);
+            }
+        }
+
+        pub fn stop(self: *Self) void {
+            self.running = false;
+        }
+
+        pub fn isIdle(self: *const Self) bool {
+            return self.idle;
+        }
+    };
+}
+
+// ============================================================================
+// Tests
+// ============================================================================
+
+test "Debounce: accepts level after N agreeing samples" {
+    var d = Debounce(bool).init(true);
+    try std.testing.expect(d.feed(false, 3) == null);
+    try std.testing.expect(d.feed(true, 3) == null); // glitch resets
+    try std.testing.expect(d.feed(false, 3) == null);
+    try std.testing.expect(d.feed(false, 3) == null);
+    try std.testing.expectEqual(@as(?bool, false), d.feed(false, 3));
+    try std.testing.expect(d.feed(false, 3) == null);
+}
+
+test "Debounce: need 1 is immediate" {
+    var d = Debounce(i8).init(-1);
+    try std.testing.expectEqual(@as(?i8, 2), d.feed(2, 1));
+    try std.testing.expectEqual(@as(?i8, -1), d.feed(-1, 0));
+}
+
+test "readBatch: DMA and single-sample drivers" {
+    const Dma = struct {
+        pub fn readBatch(_: *@This(), out: []u16) usize {
+            for (out, 0..) |*s, i| s.* = @intCast(i);
+            return out.len;
+        }
+    };
+    const Single = struct {
+        pub fn readRaw(_: *@This()) u16 {
+            return 7;
+        }
+    };
+    var buf: [4]u16 = undefined;
+    var dma = Dma{};
+    var single = Single{};
+    try std.testing.expectEqual(@as(usize, 4), readBatch(&dma, &buf));
+    try std.testing.expectEqual(@as(u16, 3), buf[3]);
+    try std.testing.expectEqual(@as(usize, 1), readBatch(&single, &buf));
+    try std.testing.expectEqual(@as(u16, 7), buf[0]);
+    try std.testing.expectEqual(@as(u64, 85), sampleTime(100, 1, 4, 5));
+}
+
+test "Engine: slows down while all members are idle" {
+    const Member = struct {
+        active: bool = false,
+        pub fn sampleBatch(_: *@This(), max: usize, _: u32) usize {
+            return max;
+        }
+        pub fn isIdle(self: *const @This()) bool {
+            return !self.active;
+        }
+    };
+    var a = Member{};
+    var b = Member{};
+    var engine = Engine(struct { *Member, *Member }).init(.{ &a, &b }, .{
+        .sample_period_ms = 5,
+        .batch_len = 4,
+        .idle_period_ms = 80,
+    });
+
+    try std.testing.expectEqual(@as(u32, 80), engine.step());
+    b.active = true;
+    try std.testing.expectEqual(@as(u32, 20), engine.step());
+    try std.testing.expect(!engine.isIdle());
+    try std.testing.expectEqual(@as(u64, 2), engine.stats.wakeups);
+    try std.testing.expectEqual(@as(u64, 1), engine.stats.idle_wakeups);
+    try std.testing.expectEqual(@as(u64, 16), engine.stats.samples);
+}
@@ -0,0 +1,135 @@
+const std = @import("std");
+const input = @import("input");
+const print = std.debug.print;
+const testing = std.testing;
+
+const sampler = input.sampler;
+
+// ============================================================================
+// Simulated ladders on a virtual clock
+// ============================================================================
+
+const SIM_MS: u64 = 60_000;
+const POLL_MS: u32 = 10;
+const DMA_PERIOD_MS: u32 = 5;
+
+var now_ms: u64 = 0;
+
+fn timeNow() u64 {
+    return now_ms;
+}
+
+/// Ladder `k` presses one of its buttons for 150ms every 2s (offset per
+/// ladder), otherwise idles at 3300mV.
+fn ladderMv(k: u32, t: u64) u32 {
+    const phase = (t + @as(u64, k) * 700) % 2000;
+    if (phase >= 150) return 3300;
+    const presses = (t + @as(u64, k) * 700) / 2000;
+    return if (presses % 2 == 0) 2850 else 2400;
+}
+
+fn Ladder(comptime k: u32, comptime dma: bool) type {
+    const Base = struct {
+        pub fn readMv() u32 {
+            return ladderMv(k, now_ms);
+        }
+    };
+    if (!dma) return Base;
+    return struct {
+        pub const readMv = Base.readMv;
+        pub fn readBatchMv(out: []u32) usize {
+            for (out, 0..) |*s, i| s.* = ladderMv(k, sampler.sampleTime(now_ms, i, out.len, DMA_PERIOD_MS));
+            return out.len;
+        }
+    };
+}
+
+var clicks: u32 = 0;
+
+fn countRelease(_: i8, state: input.ButtonEvents.State, _: ?*anyopaque) void {
+    if (!state.is_pressed) clicks += 1;
+}
+
+fn ladderConfig(comptime Set: type) Set.Config {
+    return .{
+        .ranges = .{
+            .{ .min_mv = 2700, .max_mv = 3000 },
+            .{ .min_mv = 2200, .max_mv = 2600 },
+        },
+        .on_change = countRelease,
+    };
+}
+
+const Result = struct {
+    wakeups: u64,
+    cpu_ns: u64,
+    clicks: u32,
+};
+
+fn report(name: []const u8, r: Result) void {
+    const secs = SIM_MS / 1000;
+    print("[bench]   {s:<28} {d:>5} wakeups/s  {d:>6} ns CPU/s  {d} clicks\n", .{
+        name, r.wakeups / secs, r.cpu_ns / secs, r.clicks,
+    });
+}
+
+fn legacyPoll() Result {
+    const S0 = input.AdcButtonSet(Ladder(0, false), 2);
+    const S1 = input.AdcButtonSet(Ladder(1, false), 2);
+    const S2 = input.AdcButtonSet(Ladder(2, false), 2);
+    var a = S0.init(ladderConfig(S0), timeNow);
+    var b = S1.init(ladderConfig(S1), timeNow);
+    var c = S2.init(ladderConfig(S2), timeNow);
+
+    clicks = 0;
+    var wakeups: u64 = 0;
+    var timer = std.time.Timer.start() catch unreachable;
+    now_ms = 0;
+    while (now_ms < SIM_MS) : (now_ms += POLL_MS) {
+        a.poll();
+        b.poll();
+        c.poll();
+        wakeups += 1;
+    }
+    return .{ .wakeups = wakeups, .cpu_ns = timer.read(), .clicks = clicks };
+}
+
+fn engine(comptime dma: bool, batch_len: u8) Result {
+    const S0 = input.AdcButtonSet(Ladder(0, dma), 2);
+    const S1 = input.AdcButtonSet(Ladder(1, dma), 2);
+    const S2 = input.AdcButtonSet(Ladder(2, dma), 2);
+    var a = S0.init(ladderConfig(S0), timeNow);
+    var b = S1.init(ladderConfig(S1), timeNow);
+    var c = S2.init(ladderConfig(S2), timeNow);
+
+    var eng = sampler.Engine(struct { *S0, *S1, *S2 }).init(.{ &a, &b, &c }, .{
+        .sample_period_ms = if (dma) DMA_PERIOD_MS else POLL_MS,
+        .batch_len = batch_len,
+        .idle_period_ms = 50,
+    });
+
+    clicks = 0;
+    var timer = std.time.Timer.start() catch unreachable;
+    now_ms = 0;
+    while (now_ms < SIM_MS) now_ms += eng.step();
+    return .{ .wakeups = eng.stats.wakeups, .cpu_ns = timer.read(), .clicks = clicks };
+}
+
+// ============================================================================
+// BM1: Wakeups and CPU per second, 3 ladders
+// ============================================================================
+
+test "BM1: 3 ADC ladders, legacy 10ms polling vs sampling engine" {
+    print("\n[bench] 3 ladders, {d}s simulated, 150ms press every 2s per ladder\n", .{SIM_MS / 1000});
+    const legacy = legacyPoll();
+    const single = engine(false, 1);
+    const dma = engine(true, 4);
+    report("legacy poll (10ms)", legacy);
+    report("engine, readMv per wakeup", single);
+    report("engine, DMA batch 4x5ms", dma);
+
+    // Same gestures seen, far fewer wakeups
+    try testing.expectEqual(legacy.clicks, dma.clicks);
+    try testing.expectEqual(legacy.clicks, single.clicks);
+    try testing.expect(dma.wakeups * 3 < legacy.wakeups);
+}
@@ -22,6 +22,12 @@ pub fn build(b: *std.Build) void {
     dns_mod.addImport("trait", trait_dep.module("trait"));
     dns_mod.addImport("net/tls", tls_dep.module("net/tls"));
 
+    // std_impl dependency (for host socket)
+    const std_impl_dep = b.dependency("std_impl", .{
+        .target = target,
+        .optimize = optimize,
+    });
+
     // Unit Tests
     const test_step = b.step("test", "Run unit tests");
     const tests = b.addTest(.{
@@ -33,15 +39,10 @@ pub fn build(b: *std.Build) void {
     });
     tests.root_module.addImport("trait", trait_dep.module("trait"));
     tests.root_module.addImport("net/tls", tls_dep.module("net/tls"));
+    tests.root_module.addImport("std_impl", std_impl_dep.module("std_impl"));
     const run_tests = b.addRunArtifact(tests);
     test_step.dependOn(&run_tests.step);
 
-    // std_impl dependency (for host socket)
-    const std_impl_dep = b.dependency("std_impl", .{
-        .target = target,
-        .optimize = optimize,
-    });
-
     // Integration Test - run actual DNS queries
     const integration_test = b.addExecutable(.{
         .name = "dns_test",
@@ -31,6 +31,11 @@
 //!   };
 //!
 //!   const ip = try resolver.resolve("www.google.com");
+//!
+//!   // Dual-stack: AAAA + A records, then race them (RFC 8305)
+//!   var addrs: [8]dns.IpAddress = undefined;
+//!   const n = try resolver.resolveAll("www.google.com", &addrs);
+//!   const conn = try dns.happy_eyeballs.connect(Socket, addrs[0..n], 443, .{});
 
 const std = @import("std");
 
@@ -38,6 +43,15 @@ const trait = @import("trait");
 const tls = @import("tls");
 
 pub const Ipv4Address = [4]u8;
+pub const IpAddress = trait.socket.IpAddress;
+
+pub const happy_eyeballs = @import("happy_eyeballs.zig");
+
+/// Query record type
+pub const RecordType = enum(u16) {
+    a = 1,
+    aaaa = 28,
+};
 
 pub const DnsError = error{
     InvalidHostname,
@@ -172,6 +186,60 @@ fn ResolverImplWithCrypto(comptime Socket: type, comptime TlsClient: type, compt
         }
 
         fn resolveUdp(self: *const Self, hostname: []const u8) DnsError!Ipv4Address {
+            var response_buf: [512]u8 = undefined;
+            const response = try self.exchangeUdp(hostname, .a, &response_buf);
+            return parseResponse(response) catch return error.ResponseParseFailed;
+        }
+
+        fn resolveTcp(self: *const Self, hostname: []const u8) DnsError!Ipv4Address {
+            var response_buf: [512]u8 = undefined;
+            const response = try self.exchangeTcp(hostname, .a, &response_buf);
+            return parseResponse(response) catch return error.ResponseParseFailed;
+        }
+
+        /// Resolve hostname to every IPv6 and IPv4 address (AAAA first).
+        /// Returns the number of addresses written to `out`.
+        ///
+        /// DoH and the custom resolver only yield IPv4 addresses.
+        pub fn resolveAll(self: *const Self, hostname: []const u8, out: []IpAddress) DnsError!usize {
+            if (out.len == 0) return 0;
+
+            if (has_custom_resolver) {
+                if (self.custom_resolver) |r| {
+                    if (r.resolve(hostname)) |ip| {
+                        out[0] = .{ .ipv4 = ip };
+                        return 1;
+                    }
+                }
+            }
+
+            if (self.protocol == .https) {
+                out[0] = .{ .ipv4 = try self.resolveHttps(hostname) };
+                return 1;
+            }
+
+            var count: usize = 0;
+            var last_err: DnsError = error.NoAnswer;
+            for ([_]RecordType{ .aaaa, .a }) |rtype| {
+                if (count == out.len) break;
+                var response_buf: [512]u8 = undefined;
+                const response = switch (self.protocol) {
+                    .tcp => self.exchangeTcp(hostname, rtype, &response_buf),
+                    else => self.exchangeUdp(hostname, rtype, &response_buf),
+                } catch |err| {
+                    last_err = err;
+                    continue;
+                };
+                count += parseAddresses(response, out[count..]) catch |err| {
+                    if (err != error.NoAnswer) last_err = error.ResponseParseFailed;
+                    continue;
+                };
+            }
+            if (count == 0) return last_err;
+            return count;
+        }
+
+        fn exchangeUdp(self: *const Self, hostname: []const u8, rtype: RecordType, response_buf: *[512]u8) DnsError![]const u8 {
             var sock = socket.udp() catch return error.SocketError;
             defer sock.close();
 
@@ -179,25 +247,22 @@ fn ResolverImplWithCrypto(comptime Socket: type, comptime TlsClient: type, compt
 
             // Build query
             var query_buf: [512]u8 = undefined;
-            const query_len = buildQuery(&query_buf, hostname, generateTxId()) catch return error.QueryBuildFailed;
+            const query_len = buildQueryType(&query_buf, hostname, generateTxId(), rtype) catch return error.QueryBuildFailed;
 
             // Send query
             _ = sock.sendTo(self.server, 53, query_buf[0..query_len]) catch return error.SocketError;
 
             // Receive response
-            var response_buf: [512]u8 = undefined;
-            const response_len = sock.recvFrom(&response_buf) catch |err| {
+            const response_len = sock.recvFrom(response_buf) catch |err| {
                 return switch (err) {
                     error.Timeout => error.Timeout,
                     else => error.SocketError,
                 };
             };
-
-            // Parse response
-            return parseResponse(response_buf[0..response_len]) catch return error.ResponseParseFailed;
+            return response_buf[0..response_len];
         }
 
-        fn resolveTcp(self: *const Self, hostname: []const u8) DnsError!Ipv4Address {
+        fn exchangeTcp(self: *const Self, hostname: []const u8, rtype: RecordType, response_buf: *[512]u8) DnsError![]const u8 {
             var sock = socket.tcp() catch return error.SocketError;
             defer sock.close();
 
@@ -209,7 +274,7 @@ fn ResolverImplWithCrypto(comptime Socket: type, comptime TlsClient: type, compt
 
             // Build query
             var query_buf: [514]u8 = undefined; // 2 bytes length prefix + 512 query
-            const query_len = buildQuery(query_buf[2..], hostname, generateTxId()) catch return error.QueryBuildFailed;
+            const query_len = buildQueryType(query_buf[2..], hostname, generateTxId(), rtype) catch return error.QueryBuildFailed;
 
             // TCP DNS: prepend 2-byte length
             query_buf[0] = @intCast((query_len >> 8) & 0xFF);
@@ -229,7 +294,6 @@ fn ResolverImplWithCrypto(comptime Socket: type, comptime TlsClient: type, compt
             const response_len: usize = (@as(usize, len_buf[0]) << 8) | len_buf[1];
 
             // Receive response
-            var response_buf: [512]u8 = undefined;
             if (response_len > response_buf.len) return error.ResponseParseFailed;
 
             var total_read: usize = 0;
@@ -243,9 +307,7 @@ fn ResolverImplWithCrypto(comptime Socket: type, comptime TlsClient: type, compt
                 if (n == 0) break;
                 total_read += n;
             }
-
-            // Parse response
-            return parseResponse(response_buf[0..total_read]) catch return error.ResponseParseFailed;
+            return response_buf[0..total_read];
         }
 
         fn resolveHttps(self: *const Self, hostname: []const u8) DnsError!Ipv4Address {
@@ -444,8 +506,13 @@ fn generateTxId() u16 {
     return tx_id_counter;
 }
 
-/// Build DNS query packet
+/// Build DNS query packet (type A)
 pub fn buildQuery(buf: []u8, hostname: []const u8, transaction_id: u16) !usize {
+    return buildQueryType(buf, hostname, transaction_id, .a);
+}
+
+/// Build DNS query packet for the given record type
+pub fn buildQueryType(buf: []u8, hostname: []const u8, transaction_id: u16, rtype: RecordType) !usize {
     if (hostname.len == 0 or hostname.len > 253) return error.InvalidHostname;
 
     var pos: usize = 0;
@@ -501,9 +568,8 @@ pub fn buildQuery(buf: []u8, hostname: []const u8, transaction_id: u16) !usize {
     buf[pos] = 0x00; // null terminator
     pos += 1;
 
-    // Type: A (1)
-    buf[pos] = 0x00;
-    buf[pos + 1] = 0x01;
+    // Type: A (1) or AAAA (28)
+    std.mem.writeInt(u16, buf[pos..][0..2], @intFromEnum(rtype), .big);
     pos += 2;
 
     // Class: IN (1)
@@ -576,6 +642,63 @@ pub fn parseResponse(data: []const u8) !Ipv4Address {
     return error.NoAnswer;
 }
 
+/// Parse DNS response and collect every A and AAAA record, in answer
+/// order. Returns the number of addresses written to `out`.
+pub fn parseAddresses(data: []const u8, out: []IpAddress) !usize {
+    if (data.len < 12) return error.ResponseParseFailed;
+
+    const rcode = data[3] & 0x0F;
+    if (rcode != 0) return error.NoAnswer;
+
+    const answer_count = (@as(u16, data[6]) << 8) | data[7];
+    if (answer_count == 0) return error.NoAnswer;
+
+    // Skip header and question section
+    var pos: usize = 12;
+    while (pos < data.len and data[pos] != 0) {
+        if ((data[pos] & 0xC0) == 0xC0) {
+            pos += 2;
+            break;
+        }
+        pos += @as(usize, data[pos]) + 1;
+    }
+    if (pos < data.len and data[pos] == 0) pos += 1;
+    pos += 4;
+
+    var count: usize = 0;
+    var i: u16 = 0;
+    while (i < answer_count and pos + 12 <= data.len and count < out.len) : (i += 1) {
+        if ((data[pos] & 0xC0) == 0xC0) {
+            pos += 2;
+        } else {
+            while (pos < data.len and data[pos] != 0) {
+                pos += @as(usize, data[pos]) + 1;
+            }
+            pos += 1;
+        }
+
+        if (pos + 10 > data.len) break;
+
+        const rtype = (@as(u16, data[pos]) << 8) | data[pos + 1];
+        const rdlength = (@as(u16, data[pos + 8]) << 8) | data[pos + 9];
+        pos += 10; // type, class, TTL, rdlength
+        if (pos + rdlength > data.len) break;
+
+        if (rtype == @intFromEnum(RecordType.a) and rdlength == 4) {
+            out[count] = .{ .ipv4 = data[pos..][0..4].* };
+            count += 1;
+        } else if (rtype == @intFromEnum(RecordType.aaaa) and rdlength == 16) {
+            out[count] = .{ .ipv6 = data[pos..][0..16].* };
+            count += 1;
+        }
+
+        pos += rdlength;
+    }
+
+    if (count == 0) return error.NoAnswer;
+    return count;
+}
+
 /// Format IPv4 address as string
 pub fn formatIpv4(addr: Ipv4Address, buf: []u8) []const u8 {
     return std.fmt.bufPrint(buf, "{d}.{d}.{d}.{d}", .{ addr[0], addr[1], addr[2], addr[3] }) catch "?.?.?.?";
@@ -598,6 +721,35 @@ test "buildQuery" {
     try std.testing.expect(len < 100);
 }
 
+test "buildQueryType: AAAA" {
+    var buf: [512]u8 = undefined;
+    const len = try buildQueryType(&buf, "example.com", 1, .aaaa);
+    try std.testing.expectEqual(@as(u8, 0), buf[len - 4]);
+    try std.testing.expectEqual(@as(u8, 28), buf[len - 3]);
+}
+
+test "parseAddresses: mixed A and AAAA answers" {
+    // Header: id, flags (response, no error), 1 question, 2 answers
+    const header = [_]u8{ 0x12, 0x34, 0x81, 0x80, 0, 1, 0, 2, 0, 0, 0, 0 };
+    const question = [_]u8{ 1, 'a', 0, 0, 28, 0, 1 };
+    const aaaa = [_]u8{ 0xC0, 12, 0, 28, 0, 1, 0, 0, 0, 60, 0, 16 } ++ [_]u8{0} ** 15 ++ [_]u8{1};
+    const a = [_]u8{ 0xC0, 12, 0, 1, 0, 1, 0, 0, 0, 60, 0, 4, 127, 0, 0, 1 };
+    const msg = header ++ question ++ aaaa ++ a;
+
+    var out: [4]IpAddress = undefined;
+    const n = try parseAddresses(&msg, &out);
+    try std.testing.expectEqual(@as(usize, 2), n);
+    try std.testing.expect(out[0].eql(.{ .ipv6 = trait.socket.parseIpv6("::1").? }));
+    try std.testing.expect(out[1].eql(.{ .ipv4 = .{ 127, 0, 0, 1 } }));
+
+    // parseResponse still returns the first A record
+    try std.testing.expectEqual(Ipv4Address{ 127, 0, 0, 1 }, try parseResponse(&msg));
+
+    // Output capacity is respected
+    var one: [1]IpAddress = undefined;
+    try std.testing.expectEqual(@as(usize, 1), try parseAddresses(&msg, &one));
+}
+
 test "parseIpv4String" {
     const ip = parseIpv4String("192.168.1.1").?;
     try std.testing.expectEqual(@as(u8, 192), ip[0]);
@@ -703,3 +855,7 @@ test "Resolver with DomainResolver has custom_resolver field" {
     const R = Resolver(TestMockSocket, MockResolver);
     try std.testing.expect(@hasField(R, "custom_resolver"));
 }
+
+test {
+    _ = happy_eyeballs;
+}
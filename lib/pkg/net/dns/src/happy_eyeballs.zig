@@ -0,0 +1,500 @@
+//! Happy Eyeballs v2 (RFC 8305) - race IPv6 and IPv4 connection attempts
+//!
+//! Addresses are interleaved by family (IPv6 first). One attempt starts,
+//! and if it has neither connected nor failed after `attempt_delay_ms`, the
+//! next one starts alongside it. A failed attempt starts the next one at
+//! once. The first attempt to connect wins; every other one is closed.
+//!
+//! Racing needs the socket's optional non-blocking connect
+//! (`connectStart`/`connectPoll`, see `trait.socket.hasConnectPoll`).
+//! Without it, addresses are tried one after another with a blocking
+//! connect. Without `trait.socket.hasIpv6`, IPv6 addresses are skipped.
+//! With `trait.socket.hasConnectPollAny`, all attempts in flight are
+//! waited on in one poll; otherwise each is polled in turn for a slice.
+//!
+//! The attempt delay and timeout are measured on `Config.clock`, or the
+//! OS monotonic clock when the target has one. On a target with neither,
+//! the requested waits are added up instead.
+//!
+//! ## Usage
+//!
+//! ```zig
+//! var addrs: [8]dns.IpAddress = undefined;
+//! const n = try resolver.resolveAll("example.com", &addrs);
+//! const conn = try dns.happy_eyeballs.connect(Socket, addrs[0..n], 443, .{});
+//! var sock = conn.socket;
+//! ```
+
+const std = @import("std");
+const builtin = @import("builtin");
+const trait = @import("trait");
+
+const IpAddress = trait.socket.IpAddress;
+
+/// Most addresses considered per connect
+pub const MAX_ATTEMPTS = 8;
+
+pub const Config = struct {
+    /// Delay before starting the next attempt (RFC 8305 recommends 250ms)
+    attempt_delay_ms: u32 = 250,
+    /// Give up after this long
+    timeout_ms: u32 = 10_000,
+    /// Wait per socket when attempts are polled in turn (no `connectPollAny`)
+    poll_slice_ms: u32 = 10,
+    /// Monotonic milliseconds; null uses the OS clock
+    clock: ?*const fn () u64 = null,
+};
+
+pub const Error = error{
+    NoAddress,
+    ConnectFailed,
+    Timeout,
+};
+
+pub fn Connection(comptime Socket: type) type {
+    return struct {
+        socket: Socket,
+        addr: IpAddress,
+    };
+}
+
+/// Reorder `addrs` into `out` alternating families, IPv6 first, keeping the
+/// resolver's order within each family. Returns the count written.
+pub fn interleave(addrs: []const IpAddress, out: []IpAddress) usize {
+    var v6: usize = 0;
+    var v4: usize = 0;
+    var count: usize = 0;
+    var want: trait.socket.Family = .ipv6;
+    while (count < out.len) {
+        const next = nextOf(addrs, want, if (want == .ipv6) &v6 else &v4) orelse
+            nextOf(addrs, other(want), if (want == .ipv6) &v4 else &v6) orelse break;
+        out[count] = next;
+        count += 1;
+        want = other(next.family());
+    }
+    return count;
+}
+
+fn other(fam: trait.socket.Family) trait.socket.Family {
+    return if (fam == .ipv6) .ipv4 else .ipv6;
+}
+
+fn nextOf(addrs: []const IpAddress, fam: trait.socket.Family, cursor: *usize) ?IpAddress {
+    while (cursor.* < addrs.len) {
+        const a = addrs[cursor.*];
+        cursor.* += 1;
+        if (a.family() == fam) return a;
+    }
+    return null;
+}
+
+/// Connect to the first reachable address, racing attempts per RFC 8305
+pub fn connect(comptime Socket: type, addrs: []const IpAddress, port: u16, config: Config) Error!Connection(Socket) {
+    var candidates: [MAX_ATTEMPTS]IpAddress = undefined;
+    var n: usize = 0;
+    var ordered: [MAX_ATTEMPTS]IpAddress = undefined;
+    for (ordered[0..interleave(addrs, &ordered)]) |a| {
+        if (comptime !trait.socket.hasIpv6(Socket)) {
+            if (a == .ipv6) continue;
+        }
+        candidates[n] = a;
+        n += 1;
+    }
+    if (n == 0) return error.NoAddress;
+
+    if (comptime !trait.socket.hasConnectPoll(Socket)) {
+        return connectSequential(Socket, candidates[0..n], port);
+    }
+    return race(Socket, candidates[0..n], port, config);
+}
+
+fn connectSequential(comptime Socket: type, addrs: []const IpAddress, port: u16) Error!Connection(Socket) {
+    for (addrs) |addr| {
+        var sock = trait.socket.tcpFor(Socket, addr.family()) catch continue;
+        trait.socket.connectAddr(&sock, addr, port) catch {
+            sock.close();
+            continue;
+        };
+        return .{ .socket = sock, .addr = addr };
+    }
+    return error.ConnectFailed;
+}
+
+fn race(comptime Socket: type, addrs: []const IpAddress, port: u16, config: Config) Error!Connection(Socket) {
+    var pending: [MAX_ATTEMPTS]?Socket = .{null} ** MAX_ATTEMPTS;
+    var next: usize = 0;
+    var active: usize = 0;
+    var watch = Stopwatch.init(config.clock);
+    // When the next attempt is due; 0 = now
+    var next_due: u64 = 0;
+
+    errdefer for (&pending) |*p| {
+        if (p.*) |*s| s.close();
+    }
+
+    while (true) {
+        const now = watch.elapsed();
+        if (now >= config.timeout_ms) return error.Timeout;
+
+        // Start the next attempt when the delay has passed or nothing is in flight
+        if (next < addrs.len and (now >= next_due or active == 0)) {
+            const i = next;
+            next += 1;
+            // A synchronous failure starts the next attempt at once
+            var sock = trait.socket.tcpFor(Socket, addrs[i].family()) catch {
+                next_due = 0;
+                continue;
+            };
+            const done = sock.connectStart(addrs[i], port) catch {
+                sock.close();
+                next_due = 0;
+                continue;
+            };
+            if (done) return finish(Socket, &pending, sock, addrs[i]);
+            pending[i] = sock;
+            active += 1;
+            next_due = now + config.attempt_delay_ms;
+        }
+        if (active == 0) {
+            if (next >= addrs.len) return error.ConnectFailed;
+            continue;
+        }
+
+        // Wait until the next attempt or the timeout is due
+        var wait: u64 = config.timeout_ms - now;
+        if (next < addrs.len) wait = @min(wait, next_due -| now);
+        const wait_ms: u32 = @intCast(wait);
+
+        if (comptime trait.socket.hasConnectPollAny(Socket)) {
+            // One poll over every attempt in flight
+            var socks: [MAX_ATTEMPTS]*Socket = undefined;
+            var index: [MAX_ATTEMPTS]usize = undefined;
+            var n: usize = 0;
+            for (&pending, 0..) |*p, i| {
+                const sock = if (p.*) |*s| s else continue;
+                socks[n] = sock;
+                index[n] = i;
+                n += 1;
+            }
+            const ready = Socket.connectPollAny(socks[0..n], wait_ms) catch return error.ConnectFailed;
+            watch.waited(wait_ms);
+            const i = index[ready orelse continue];
+            if (settle(Socket, &pending, i, &active, &next_due, 0)) |won| return finish(Socket, &pending, won, addrs[i]);
+        } else {
+            // Poll in turn, splitting a slice across attempts in flight
+            const per = @max(@min(wait_ms, config.poll_slice_ms) / @as(u32, @intCast(active)), 1);
+            for (0..pending.len) |i| {
+                if (pending[i] == null) continue;
+                watch.waited(per);
+                if (settle(Socket, &pending, i, &active, &next_due, per)) |won| return finish(Socket, &pending, won, addrs[i]);
+            }
+        }
+    }
+}
+
+/// Poll attempt `i`. Returns the socket once connected; a failed attempt
+/// is closed and makes the next one due now.
+fn settle(comptime Socket: type, pending: *[MAX_ATTEMPTS]?Socket, i: usize, active: *usize, next_due: *u64, timeout_ms: u32) ?Socket {
+    const sock = &(pending[i].?);
+    const connected = sock.connectPoll(timeout_ms) catch {
+        sock.close();
+        pending[i] = null;
+        active.* -= 1;
+        next_due.* = 0;
+        return null;
+    };
+    if (!connected) return null;
+    const won = sock.*;
+    pending[i] = null;
+    return won;
+}
+
+/// Milliseconds since the race began
+const Stopwatch = struct {
+    clock: ?*const fn () u64,
+    start: u64,
+    /// Sum of requested waits, used when there is no clock at all
+    counted: u64 = 0,
+
+    const has_os_clock = switch (builtin.os.tag) {
+        .freestanding, .other => false,
+        else => true,
+    };
+
+    fn init(clock: ?*const fn () u64) Stopwatch {
+        return .{ .clock = clock, .start = read(clock) orelse 0 };
+    }
+
+    fn elapsed(self: *const Stopwatch) u64 {
+        const now = read(self.clock) orelse return self.counted;
+        return now -| self.start;
+    }
+
+    fn waited(self: *Stopwatch, ms: u32) void {
+        self.counted +|= ms;
+    }
+
+    fn read(clock: ?*const fn () u64) ?u64 {
+        if (clock) |c| return c();
+        if (comptime !has_os_clock) return null;
+        const now = std.time.Instant.now() catch return null;
+        return now.since(std.mem.zeroes(std.time.Instant)) / std.time.ns_per_ms;
+    }
+};
+
+fn finish(comptime Socket: type, pending: *[MAX_ATTEMPTS]?Socket, won: Socket, addr: IpAddress) Connection(Socket) {
+    for (pending) |*p| {
+        if (p.*) |*s| s.close();
+        p.* = null;
+    }
+    return .{ .socket = won, .addr = addr };
+}
+
+// ============================================================================
+// Tests
+// ============================================================================
+
+test "interleave alternates families, IPv6 first" {
+    const v6a: IpAddress = .{ .ipv6 = trait.socket.parseIpv6("2001:db8::1").? };
+    const v6b: IpAddress = .{ .ipv6 = trait.socket.parseIpv6("2001:db8::2").? };
+    const v4a: IpAddress = .{ .ipv4 = .{ 192, 0, 2, 1 } };
+    const v4b: IpAddress = .{ .ipv4 = .{ 192, 0, 2, 2 } };
+    const v4c: IpAddress = .{ .ipv4 = .{ 192, 0, 2, 3 } };
+
+    var out: [8]IpAddress = undefined;
+    const n = interleave(&.{ v4a, v4b, v6a, v4c, v6b }, &out);
+    try std.testing.expectEqual(@as(usize, 5), n);
+    const want = [_]IpAddress{ v6a, v4a, v6b, v4b, v4c };
+    for (want, out[0..n]) |w, got| try std.testing.expect(w.eql(got));
+
+    // Single family keeps its order
+    try std.testing.expectEqual(@as(usize, 2), interleave(&.{ v4a, v4b }, &out));
+    try std.testing.expect(out[1].eql(v4b));
+}
+
+const std_impl = @import("std_impl");
+const SockError = trait.socket.Error;
+const StdSocket = std_impl.socket.Socket;
+
+/// Injected per-family connect delays
+var delay_ms: [2]u32 = .{ 0, 0 };
+/// Address whose `connectStart` fails synchronously
+var fail_start: ?IpAddress = null;
+
+/// Std socket whose non-blocking connect reports success only after the
+/// injected delay for its family has passed.
+const DelaySocket = struct {
+    inner: StdSocket,
+    fam: trait.socket.Family = .ipv4,
+    started_ms: i64 = 0,
+
+    const Self = @This();
+
+    pub fn tcp() SockError!Self {
+        return .{ .inner = try StdSocket.tcp(), .fam = .ipv4 };
+    }
+    pub fn tcp6() SockError!Self {
+        return .{ .inner = try StdSocket.tcp6(), .fam = .ipv6 };
+    }
+    pub fn udp() SockError!Self {
+        return .{ .inner = try StdSocket.udp() };
+    }
+    pub fn udp6() SockError!Self {
+        return .{ .inner = try StdSocket.udp6(), .fam = .ipv6 };
+    }
+    pub fn close(self: *Self) void {
+        self.inner.close();
+    }
+    pub fn connect(self: *Self, ip: trait.socket.Ipv4Address, port: u16) SockError!void {
+        return self.inner.connect(ip, port);
+    }
+    pub fn connect6(self: *Self, ip: trait.socket.Ipv6Address, port: u16) SockError!void {
+        return self.inner.connect6(ip, port);
+    }
+    pub fn sendTo6(self: *Self, ip: trait.socket.Ipv6Address, port: u16, data: []const u8) SockError!usize {
+        return self.inner.sendTo6(ip, port, data);
+    }
+    pub fn bind6(self: *Self, ip: trait.socket.Ipv6Address, port: u16) SockError!void {
+        return self.inner.bind6(ip, port);
+    }
+    pub fn connectStart(self: *Self, ip: IpAddress, port: u16) SockError!bool {
+        if (fail_start) |f| if (f.eql(ip)) return error.ConnectFailed;
+        self.started_ms = std.time.milliTimestamp();
+        const done = try self.inner.connectStart(ip, port);
+        return done and self.remaining() == 0;
+    }
+    pub fn connectPoll(self: *Self, timeout_ms: u32) SockError!bool {
+        const wait = self.remaining();
+        if (wait > 0) {
+            std.Thread.sleep(@as(u64, @min(wait, timeout_ms)) * std.time.ns_per_ms);
+            if (wait > timeout_ms) return false;
+        }
+        return self.inner.connectPoll(timeout_ms);
+    }
+    pub fn connectPollAny(socks: []const *Self, timeout_ms: u32) SockError!?usize {
+        // Sleep until the first delay runs out, then poll the real sockets
+        var wait = timeout_ms;
+        for (socks) |s| wait = @min(wait, s.remaining());
+        if (wait > 0) std.Thread.sleep(@as(u64, wait) * std.time.ns_per_ms);
+        var inner: [MAX_ATTEMPTS]*StdSocket = undefined;
+        var index: [MAX_ATTEMPTS]usize = undefined;
+        var n: usize = 0;
+        for (socks, 0..) |s, i| {
+            if (s.remaining() > 0) continue;
+            inner[n] = &s.inner;
+            index[n] = i;
+            n += 1;
+        }
+        if (n == 0) return null;
+        const k = try StdSocket.connectPollAny(inner[0..n], timeout_ms - wait) orelse return null;
+        return index[k];
+    }
+    pub fn send(self: *Self, data: []const u8) SockError!usize {
+        return self.inner.send(data);
+    }
+
+    fn remaining(self: *const Self) u32 {
+        const elapsed = std.time.milliTimestamp() - self.started_ms;
+        const want: i64 = delay_ms[@intFromEnum(self.fam)];
+        return @intCast(@max(want - elapsed, 0));
+    }
+};
+
+/// Listeners on ::1 and 127.0.0.1 sharing one port
+const Loopback = struct {
+    v6: StdSocket,
+    v4: StdSocket,
+    port: u16,
+
+    fn open() !Loopback {
+        var v6 = StdSocket.tcp6() catch return error.SkipZigTest;
+        errdefer v6.close();
+        v6.bind6(trait.socket.parseIpv6("::1").?, 0) catch return error.SkipZigTest;
+        try v6.listen();
+        const port = try v6.getBoundPort();
+        var v4 = try StdSocket.tcp();
+        errdefer v4.close();
+        try v4.bind(.{ 127, 0, 0, 1 }, port);
+        try v4.listen();
+        return .{ .v6 = v6, .v4 = v4, .port = port };
+    }
+
+    fn close(self: *Loopback) void {
+        self.v6.close();
+        self.v4.close();
+    }
+};
+
+const loopback_addrs = [_]IpAddress{
+    .{ .ipv4 = .{ 127, 0, 0, 1 } },
+    .{ .ipv6 = [_]u8{0} ** 15 ++ [_]u8{1} },
+};
+
+test "loopback: IPv6 wins when both families are fast" {
+    var lo = try Loopback.open();
+    defer lo.close();
+    delay_ms = .{ 0, 0 };
+
+    var conn = try connect(DelaySocket, &loopback_addrs, lo.port, .{});
+    defer conn.socket.close();
+    try std.testing.expectEqual(trait.socket.Family.ipv6, conn.addr.family());
+}
+
+test "loopback: slow IPv6 falls back to IPv4 after the attempt delay" {
+    var lo = try Loopback.open();
+    defer lo.close();
+    delay_ms = .{ 0, 2000 }; // ipv4, ipv6
+
+    const start = std.time.milliTimestamp();
+    var conn = try connect(DelaySocket, &loopback_addrs, lo.port, .{ .attempt_delay_ms = 100 });
+    defer conn.socket.close();
+    const took = std.time.milliTimestamp() - start;
+
+    try std.testing.expectEqual(trait.socket.Family.ipv4, conn.addr.family());
+    try std.testing.expect(took >= 90);
+    try std.testing.expect(took < 1000);
+}
+
+test "loopback: slow IPv4 does not delay a fast IPv6" {
+    var lo = try Loopback.open();
+    defer lo.close();
+    delay_ms = .{ 2000, 0 };
+
+    const start = std.time.milliTimestamp();
+    var conn = try connect(DelaySocket, &loopback_addrs, lo.port, .{ .attempt_delay_ms = 100 });
+    defer conn.socket.close();
+    try std.testing.expectEqual(trait.socket.Family.ipv6, conn.addr.family());
+    try std.testing.expect(std.time.milliTimestamp() - start < 1000);
+}
+
+test "loopback: refused IPv6 moves to IPv4 without waiting" {
+    // IPv4 listener only; ::1 on the same port refuses
+    var v4 = try StdSocket.tcp();
+    defer v4.close();
+    try v4.bind(.{ 127, 0, 0, 1 }, 0);
+    try v4.listen();
+    const port = try v4.getBoundPort();
+    delay_ms = .{ 0, 0 };
+
+    const start = std.time.milliTimestamp();
+    var conn = try connect(StdSocket, &loopback_addrs, port, .{ .attempt_delay_ms = 1000 });
+    defer conn.socket.close();
+    try std.testing.expectEqual(trait.socket.Family.ipv4, conn.addr.family());
+    try std.testing.expect(std.time.milliTimestamp() - start < 500);
+}
+
+test "loopback: synchronous connect failure starts the next attempt at once" {
+    var lo = try Loopback.open();
+    defer lo.close();
+    delay_ms = .{ 0, 2000 };
+    fail_start = .{ .ipv4 = .{ 192, 0, 2, 1 } };
+    defer fail_start = null;
+
+    // Order: ::1 (slow), 192.0.2.1 (fails in connectStart), 127.0.0.1
+    const addrs = [_]IpAddress{ loopback_addrs[1], fail_start.?, loopback_addrs[0] };
+    const start = std.time.milliTimestamp();
+    var conn = try connect(DelaySocket, &addrs, lo.port, .{ .attempt_delay_ms = 300 });
+    defer conn.socket.close();
+    const took = std.time.milliTimestamp() - start;
+
+    try std.testing.expect(conn.addr.eql(loopback_addrs[0]));
+    // One attempt delay for ::1, none after the failed start
+    try std.testing.expect(took >= 250);
+    try std.testing.expect(took < 500);
+}
+
+test "loopback: all attempts timing out" {
+    var lo = try Loopback.open();
+    defer lo.close();
+    delay_ms = .{ 5000, 5000 };
+
+    try std.testing.expectError(error.Timeout, connect(DelaySocket, &loopback_addrs, lo.port, .{
+        .attempt_delay_ms = 50,
+        .timeout_ms = 200,
+    }));
+}
+
+/// Jumps 10 s on every read
+var fake_ms: u64 = 0;
+fn fakeClock() u64 {
+    fake_ms += 10_000;
+    return fake_ms;
+}
+
+test "loopback: timeout follows the clock, not the requested waits" {
+    var lo = try Loopback.open();
+    defer lo.close();
+    delay_ms = .{ 5000, 5000 };
+    fake_ms = 0;
+
+    const start = std.time.milliTimestamp();
+    try std.testing.expectError(error.Timeout, connect(DelaySocket, &loopback_addrs, lo.port, .{
+        .timeout_ms = 10_005,
+        .clock = fakeClock,
+    }));
+    try std.testing.expect(std.time.milliTimestamp() - start < 1000);
+}
+
+test "DelaySocket races through connectPollAny" {
+    try std.testing.expect(trait.socket.hasConnectPollAny(DelaySocket));
+}
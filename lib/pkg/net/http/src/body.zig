@@ -0,0 +1,592 @@
+//! Streaming Response Body
+//!
+//! Constant-memory response reading for the HTTP client: the status line and
+//! headers are parsed from a caller-provided scratch buffer, then the body is
+//! pulled through `read()` with `Transfer-Encoding: chunked` decoded on the fly.
+//! Use this for OTA images and asset downloads that do not fit in RAM.
+//!
+//! ```zig
+//! var reader = try http.ResponseReader(TlsClient).init(&tls_client, &scratch);
+//! while (true) {
+//!     const n = try reader.read(&chunk);
+//!     if (n == 0) break;
+//!     _ = file.write(chunk[0..n]);
+//! }
+//! ```
+
+const std = @import("std");
+const trait = @import("trait");
+
+// ============================================================================
+// Chunked Decoder
+// ============================================================================
+
+/// Incremental `Transfer-Encoding: chunked` decoder (RFC 9112 §7.1).
+///
+/// Input may be split at arbitrary byte boundaries. Payload is compacted to
+/// the front of the same slice, so no second buffer is needed. Chunk
+/// extensions and trailer fields are skipped.
+pub const ChunkedDecoder = struct {
+    state: State = .size,
+    /// Remaining payload bytes in the current chunk (or size being parsed)
+    remaining: u64 = 0,
+    size_digits: u8 = 0,
+
+    const Self = @This();
+
+    pub const Error = error{InvalidChunk};
+
+    const State = enum {
+        size,
+        extension,
+        size_lf,
+        data,
+        data_cr,
+        data_lf,
+        trailer,
+        trailer_line,
+        trailer_line_lf,
+        trailer_end_lf,
+        done,
+    };
+
+    /// Decode `data` in place. Returns the number of payload bytes now stored
+    /// at `data[0..n]`. Bytes after the terminating chunk are ignored.
+    pub fn decode(self: *Self, data: []u8) Error!usize {
+        var out: usize = 0;
+        var i: usize = 0;
+
+        while (i < data.len) {
+            switch (self.state) {
+                .data => {
+                    const n: usize = @intCast(@min(self.remaining, data.len - i));
+                    std.mem.copyForwards(u8, data[out..][0..n], data[i..][0..n]);
+                    out += n;
+                    i += n;
+                    self.remaining -= n;
+                    if (self.remaining == 0) self.state = .data_cr;
+                    continue;
+                },
+                .done => return out,
+                else => {},
+            }
+
+            const c = data[i];
+            i += 1;
+
+            switch (self.state) {
+                .size => {
+                    if (std.fmt.charToDigit(c, 16)) |digit| {
+                        if (self.size_digits >= 16) return error.InvalidChunk;
+                        self.remaining = self.remaining * 16 + digit;
+                        self.size_digits += 1;
+                    } else |_| {
+                        if (self.size_digits == 0) return error.InvalidChunk;
+                        self.state = switch (c) {
+                            ';', ' ', '\t' => .extension,
+                            '\r' => .size_lf,
+                            else => return error.InvalidChunk,
+                        };
+                    }
+                },
+                .extension => {
+                    if (c == '\r') self.state = .size_lf;
+                },
+                .size_lf => {
+                    if (c != '\n') return error.InvalidChunk;
+                    self.state = if (self.remaining == 0) .trailer else .data;
+                },
+                .data_cr => {
+                    if (c != '\r') return error.InvalidChunk;
+                    self.state = .data_lf;
+                },
+                .data_lf => {
+                    if (c != '\n') return error.InvalidChunk;
+                    self.state = .size;
+                    self.size_digits = 0;
+                },
+                .trailer => {
+                    self.state = if (c == '\r') .trailer_end_lf else .trailer_line;
+                },
+                .trailer_line => {
+                    if (c == '\r') self.state = .trailer_line_lf;
+                },
+                .trailer_line_lf => {
+                    if (c != '\n') return error.InvalidChunk;
+                    self.state = .trailer;
+                },
+                .trailer_end_lf => {
+                    if (c != '\n') return error.InvalidChunk;
+                    self.state = .done;
+                },
+                .data, .done => unreachable,
+            }
+        }
+
+        return out;
+    }
+
+    /// True once the terminating zero-size chunk and trailers were consumed
+    pub fn isDone(self: *const Self) bool {
+        return self.state == .done;
+    }
+};
+
+// ============================================================================
+// Sink
+// ============================================================================
+
+/// Destination for streamed body bytes.
+///
+/// `writeFn` must consume all of `data`; returning false aborts the transfer.
+pub const Sink = struct {
+    ctx: *anyopaque,
+    writeFn: *const fn (ctx: *anyopaque, data: []const u8) bool,
+
+    pub fn write(self: Sink, data: []const u8) bool {
+        return self.writeFn(self.ctx, data);
+    }
+
+    /// Sink that appends to an open `trait.fs.File` (opened with `.write`).
+    pub fn fromFile(file: *trait.fs.File) Sink {
+        return .{ .ctx = @ptrCast(file), .writeFn = &fileWrite };
+    }
+
+    fn fileWrite(ctx: *anyopaque, data: []const u8) bool {
+        const file: *trait.fs.File = @ptrCast(@alignCast(ctx));
+        var written: usize = 0;
+        while (written < data.len) {
+            const n = file.write(data[written..]);
+            if (n == 0) return false;
+            written += n;
+        }
+        return true;
+    }
+};
+
+// ============================================================================
+// Response Head
+// ============================================================================
+
+pub const Head = struct {
+    status_code: u16,
+    /// Content-Length header value, if present
+    content_length: ?u64 = null,
+    chunked: bool = false,
+    /// Full resource size from `Content-Range: bytes a-b/total` (206 only)
+    total_size: ?u64 = null,
+    /// First byte offset from `Content-Range` (206 only)
+    range_start: ?u64 = null,
+};
+
+pub const HeadError = error{InvalidResponse};
+
+/// Parse status line and the headers relevant to body framing.
+/// `headers` must end with the blank line ("\r\n\r\n").
+pub fn parseHead(headers: []const u8) HeadError!Head {
+    if (headers.len < 12 or !std.mem.startsWith(u8, headers, "HTTP/1.")) {
+        return error.InvalidResponse;
+    }
+
+    var head = Head{
+        .status_code = std.fmt.parseInt(u16, headers[9..12], 10) catch return error.InvalidResponse,
+    };
+
+    var i: usize = 0;
+    while (i < headers.len) {
+        const line_end = std.mem.indexOfPos(u8, headers, i, "\r\n") orelse break;
+        const line = headers[i..line_end];
+        i = line_end + 2;
+
+        const colon = std.mem.indexOfScalar(u8, line, ':') orelse continue;
+        const name = line[0..colon];
+        const value = std.mem.trim(u8, line[colon + 1 ..], " \t");
+
+        if (std.ascii.eqlIgnoreCase(name, "content-length")) {
+            head.content_length = std.fmt.parseInt(u64, value, 10) catch return error.InvalidResponse;
+        } else if (std.ascii.eqlIgnoreCase(name, "transfer-encoding")) {
+            head.chunked = std.ascii.indexOfIgnoreCase(value, "chunked") != null;
+        } else if (std.ascii.eqlIgnoreCase(name, "content-range")) {
+            parseContentRange(value, &head);
+        }
+    }
+
+    return head;
+}
+
+/// `bytes 100-199/1000` → range_start = 100, total_size = 1000
+fn parseContentRange(value: []const u8, head: *Head) void {
+    if (!std.ascii.startsWithIgnoreCase(value, "bytes ")) return;
+    const spec = value["bytes ".len..];
+    const dash = std.mem.indexOfScalar(u8, spec, '-') orelse return;
+    const slash = std.mem.indexOfScalar(u8, spec, '/') orelse return;
+    if (slash < dash) return;
+
+    head.range_start = std.fmt.parseInt(u64, spec[0..dash], 10) catch null;
+    head.total_size = std.fmt.parseInt(u64, spec[slash + 1 ..], 10) catch null;
+}
+
+// ============================================================================
+// Response Reader
+// ============================================================================
+
+pub const ReadError = error{
+    ReceiveFailed,
+    Timeout,
+    InvalidResponse,
+    BufferTooSmall,
+};
+
+/// Streaming response reader over any connection with `recv([]u8) !usize`
+/// (trait.socket, tls.Client, ...).
+///
+/// `scratch` must hold the complete status line and headers. Body bytes that
+/// arrive with the headers are served from it first; afterwards `read()`
+/// receives straight into the caller's buffer. The parsed `head` does not
+/// reference scratch, so scratch may be reused as the read buffer.
+pub fn ResponseReader(comptime Conn: type) type {
+    return struct {
+        conn: *Conn,
+        head: Head,
+
+        scratch: []u8,
+        /// Unread raw body bytes buffered in scratch
+        pending_start: usize,
+        pending_end: usize,
+
+        framing: Framing,
+        /// Body bytes left for Content-Length framing
+        remaining: u64,
+        decoder: ChunkedDecoder = .{},
+        done: bool = false,
+
+        const Self = @This();
+
+        const Framing = enum { length, chunked, until_close };
+
+        /// Receive and parse the response head.
+        pub fn init(conn: *Conn, scratch: []u8) ReadError!Self {
+            var len: usize = 0;
+            const headers_end = while (true) {
+                if (std.mem.indexOf(u8, scratch[0..len], "\r\n\r\n")) |pos| break pos + 4;
+                if (len >= scratch.len) return error.BufferTooSmall;
+
+                const n = try recvConn(conn, scratch[len..]);
+                if (n == 0) return error.InvalidResponse;
+                len += n;
+            };
+
+            const head = try parseHead(scratch[0..headers_end]);
+
+            // Move early body bytes to the front so all of scratch is reusable
+            const pending = len - headers_end;
+            std.mem.copyForwards(u8, scratch[0..pending], scratch[headers_end..len]);
+
+            // RFC 9112 §6.3: chunked overrides Content-Length; 1xx/204/304 have no body
+            const no_body = head.status_code / 100 == 1 or head.status_code == 204 or head.status_code == 304;
+            const framing: Framing = if (head.chunked)
+                .chunked
+            else if (head.content_length != null or no_body)
+                .length
+            else
+                .until_close;
+
+            return .{
+                .conn = conn,
+                .head = head,
+                .scratch = scratch,
+                .pending_start = 0,
+                .pending_end = pending,
+                .framing = framing,
+                .remaining = if (no_body) 0 else head.content_length orelse 0,
+                .done = framing == .length and (no_body or head.content_length.? == 0),
+            };
+        }
+
+        /// Read decoded body bytes. Returns 0 at end of body.
+        pub fn read(self: *Self, dest: []u8) ReadError!usize {
+            if (dest.len == 0) return 0;
+
+            while (!self.done) {
+                const limit: usize = if (self.framing == .length)
+                    @intCast(@min(self.remaining, dest.len))
+                else
+                    dest.len;
+
+                var n: usize = 0;
+                if (self.pending_start < self.pending_end) {
+                    n = @min(limit, self.pending_end - self.pending_start);
+                    // dest may alias scratch (see pipe); data only moves towards the front
+                    std.mem.copyForwards(u8, dest[0..n], self.scratch[self.pending_start..][0..n]);
+                    self.pending_start += n;
+                } else {
+                    n = recvConn(self.conn, dest[0..limit]) catch |err| {
+                        if (err == error.ReceiveFailed and self.framing == .until_close) {
+                            self.done = true;
+                            return 0;
+                        }
+                        return err;
+                    };
+                    if (n == 0) {
+                        if (self.framing != .until_close) return error.ReceiveFailed;
+                        self.done = true;
+                        return 0;
+                    }
+                }
+
+                switch (self.framing) {
+                    .length => {
+                        self.remaining -= n;
+                        if (self.remaining == 0) self.done = true;
+                        return n;
+                    },
+                    .until_close => return n,
+                    .chunked => {
+                        const out = self.decoder.decode(dest[0..n]) catch return error.InvalidResponse;
+                        if (self.decoder.isDone()) self.done = true;
+                        // Frame-only input (sizes, CRLFs) yields nothing; keep reading
+                        if (out > 0) return out;
+                    },
+                }
+            }
+            return 0;
+        }
+
+        /// Stream the remaining body into `sink`, discarding the first `skip`
+        /// bytes and stopping after `limit` bytes are written (null = to the
+        /// end). `chunk` is the transfer buffer and may be the same memory as
+        /// `scratch`. Returns bytes written.
+        pub fn pipe(self: *Self, sink: Sink, chunk: []u8, skip: u64, limit: ?u64) (ReadError || error{SinkWriteFailed})!u64 {
+            var to_skip = skip;
+            var written: u64 = 0;
+            while (true) {
+                if (limit) |max| if (written >= max) return written;
+                const n = try self.read(chunk);
+                if (n == 0) return written;
+
+                var data = chunk[0..n];
+                if (to_skip > 0) {
+                    const s: usize = @intCast(@min(to_skip, data.len));
+                    to_skip -= s;
+                    data = data[s..];
+                    if (data.len == 0) continue;
+                }
+                if (limit) |max| data = data[0..@intCast(@min(data.len, max - written))];
+
+                if (!sink.write(data)) return error.SinkWriteFailed;
+                written += data.len;
+            }
+        }
+
+        /// True when the connection is positioned exactly at the end of this
+        /// response and can be reused (not for close-delimited bodies).
+        pub fn isComplete(self: *const Self) bool {
+            return self.done and self.framing != .until_close;
+        }
+
+        fn recvConn(conn: *Conn, buf: []u8) ReadError!usize {
+            return conn.recv(buf) catch |err| {
+                const e: anyerror = err;
+                if (e == error.Timeout) return error.Timeout;
+                if (e == error.Closed) return 0;
+                return error.ReceiveFailed;
+            };
+        }
+    };
+}
+
+// ============================================================================
+// Tests
+// ============================================================================
+
+const testing = std.testing;
+
+test "ChunkedDecoder - single buffer" {
+    var buf = "5\r\nhello\r\n7\r\n, world\r\n0\r\n\r\n".*;
+    var dec = ChunkedDecoder{};
+    const n = try dec.decode(&buf);
+    try testing.expectEqualStrings("hello, world", buf[0..n]);
+    try testing.expect(dec.isDone());
+}
+
+test "ChunkedDecoder - byte at a time" {
+    const input = "a;ext=1\r\n0123456789\r\n3\r\nabc\r\n0\r\nX-Trailer: yes\r\n\r\n";
+    var dec = ChunkedDecoder{};
+    var out: [32]u8 = undefined;
+    var out_len: usize = 0;
+    for (input) |c| {
+        var b = [1]u8{c};
+        const n = try dec.decode(&b);
+        if (n > 0) {
+            out[out_len] = b[0];
+            out_len += 1;
+        }
+    }
+    try testing.expectEqualStrings("0123456789abc", out[0..out_len]);
+    try testing.expect(dec.isDone());
+}
+
+test "ChunkedDecoder - hex sizes and trailing bytes ignored" {
+    var buf = ("1F\r\n" ++ "x" ** 31 ++ "\r\n0\r\n\r\nGARBAGE").*;
+    var dec = ChunkedDecoder{};
+    const n = try dec.decode(&buf);
+    try testing.expectEqual(@as(usize, 31), n);
+    try testing.expect(dec.isDone());
+}
+
+test "ChunkedDecoder - invalid input" {
+    var dec1 = ChunkedDecoder{};
+    var bad_size = "zz\r\n".*;
+    try testing.expectError(error.InvalidChunk, dec1.decode(&bad_size));
+
+    var dec2 = ChunkedDecoder{};
+    var missing_crlf = "3\r\nabcX".*;
+    try testing.expectError(error.InvalidChunk, dec2.decode(&missing_crlf));
+
+    var dec3 = ChunkedDecoder{};
+    var overflow = "11111111111111111\r\n".*;
+    try testing.expectError(error.InvalidChunk, dec3.decode(&overflow));
+}
+
+test "parseHead - framing headers" {
+    const head = try parseHead("HTTP/1.1 206 Partial Content\r\nContent-Length: 100\r\nContent-Range: bytes 900-999/1000\r\n\r\n");
+    try testing.expectEqual(@as(u16, 206), head.status_code);
+    try testing.expectEqual(@as(?u64, 100), head.content_length);
+    try testing.expectEqual(@as(?u64, 900), head.range_start);
+    try testing.expectEqual(@as(?u64, 1000), head.total_size);
+    try testing.expect(!head.chunked);
+
+    const chunked = try parseHead("HTTP/1.1 200 OK\r\ntransfer-encoding: gzip, chunked\r\n\r\n");
+    try testing.expect(chunked.chunked);
+
+    try testing.expectError(error.InvalidResponse, parseHead("garbage\r\n\r\n"));
+}
+
+/// Replays a canned response in fixed-size pieces, like a slow socket
+const MockConn = struct {
+    data: []const u8,
+    pos: usize = 0,
+    step: usize,
+
+    pub fn recv(self: *MockConn, buf: []u8) error{Closed}!usize {
+        if (self.pos >= self.data.len) return error.Closed;
+        const n = @min(@min(buf.len, self.step), self.data.len - self.pos);
+        @memcpy(buf[0..n], self.data[self.pos..][0..n]);
+        self.pos += n;
+        return n;
+    }
+};
+
+const CollectSink = struct {
+    buf: [256]u8 = undefined,
+    len: usize = 0,
+
+    fn sink(self: *CollectSink) Sink {
+        return .{ .ctx = @ptrCast(self), .writeFn = &write };
+    }
+
+    fn write(ctx: *anyopaque, data: []const u8) bool {
+        const self: *CollectSink = @ptrCast(@alignCast(ctx));
+        if (self.len + data.len > self.buf.len) return false;
+        @memcpy(self.buf[self.len..][0..data.len], data);
+        self.len += data.len;
+        return true;
+    }
+};
+
+test "ResponseReader - content-length across small reads" {
+    var conn = MockConn{ .data = "HTTP/1.1 200 OK\r\nContent-Length: 11\r\n\r\nhello world", .step = 7 };
+    var scratch: [64]u8 = undefined;
+    var reader = try ResponseReader(MockConn).init(&conn, &scratch);
+    try testing.expectEqual(@as(u16, 200), reader.head.status_code);
+
+    var collect = CollectSink{};
+    var chunk: [4]u8 = undefined;
+    const n = try reader.pipe(collect.sink(), &chunk, 0, null);
+    try testing.expectEqual(@as(u64, 11), n);
+    try testing.expectEqualStrings("hello world", collect.buf[0..collect.len]);
+    try testing.expect(reader.isComplete());
+}
+
+test "ResponseReader - chunked with skip" {
+    const resp = "HTTP/1.1 200 OK\r\nTransfer-Encoding: chunked\r\n\r\n4\r\nabcd\r\n6\r\nefghij\r\n0\r\n\r\n";
+    var step: usize = 1;
+    while (step <= resp.len) : (step += 5) {
+        var conn = MockConn{ .data = resp, .step = step };
+        var scratch: [128]u8 = undefined;
+        var reader = try ResponseReader(MockConn).init(&conn, &scratch);
+
+        var collect = CollectSink{};
+        var chunk: [3]u8 = undefined;
+        _ = try reader.pipe(collect.sink(), &chunk, 2, null);
+        try testing.expectEqualStrings("cdefghij", collect.buf[0..collect.len]);
+        try testing.expect(reader.isComplete());
+    }
+}
+
+test "ResponseReader - pipe stops at the limit" {
+    var conn = MockConn{ .data = "HTTP/1.1 200 OK\r\nContent-Length: 11\r\n\r\nhello world", .step = 3 };
+    var scratch: [64]u8 = undefined;
+    var reader = try ResponseReader(MockConn).init(&conn, &scratch);
+
+    var collect = CollectSink{};
+    var chunk: [4]u8 = undefined;
+    try testing.expectEqual(@as(u64, 4), try reader.pipe(collect.sink(), &chunk, 2, 4));
+    try testing.expectEqualStrings("llo ", collect.buf[0..collect.len]);
+}
+
+test "ResponseReader - close-delimited body" {
+    var conn = MockConn{ .data = "HTTP/1.0 200 OK\r\n\r\nuntil close", .step = 4 };
+    var scratch: [64]u8 = undefined;
+    var reader = try ResponseReader(MockConn).init(&conn, &scratch);
+
+    var collect = CollectSink{};
+    var chunk: [8]u8 = undefined;
+    _ = try reader.pipe(collect.sink(), &chunk, 0, null);
+    try testing.expectEqualStrings("until close", collect.buf[0..collect.len]);
+    try testing.expect(!reader.isComplete());
+}
+
+test "ResponseReader - truncated content-length body fails" {
+    var conn = MockConn{ .data = "HTTP/1.1 200 OK\r\nContent-Length: 100\r\n\r\nshort", .step = 64 };
+    var scratch: [64]u8 = undefined;
+    var reader = try ResponseReader(MockConn).init(&conn, &scratch);
+
+    var chunk: [128]u8 = undefined;
+    try testing.expectEqual(@as(usize, 5), try reader.read(&chunk));
+    try testing.expectError(error.ReceiveFailed, reader.read(&chunk));
+}
+
+test "ResponseReader - headers larger than scratch" {
+    var conn = MockConn{ .data = "HTTP/1.1 200 OK\r\nX-Long: aaaaaaaaaaaaaaaaaaaaaaaaaaaaaa\r\n\r\n", .step = 64 };
+    var scratch: [32]u8 = undefined;
+    try testing.expectError(error.BufferTooSmall, ResponseReader(MockConn).init(&conn, &scratch));
+}
+
+test "Sink.fromFile" {
+    const Backing = struct {
+        var buf: [32]u8 = undefined;
+        var len: usize = 0;
+
+        fn write(_: *anyopaque, data: []const u8) usize {
+            // Accept at most 3 bytes per call to exercise the retry loop
+            const n = @min(data.len, 3);
+            @memcpy(buf[len..][0..n], data[0..n]);
+            len += n;
+            return n;
+        }
+
+        fn close(_: *anyopaque) void {}
+    };
+
+    var dummy: u8 = 0;
+    var file = trait.fs.File{
+        .ctx = @ptrCast(&dummy),
+        .writeFn = &Backing.write,
+        .closeFn = &Backing.close,
+        .size = 0,
+    };
+    const sink = Sink.fromFile(&file);
+    try testing.expect(sink.write("firmware"));
+    try testing.expectEqualStrings("firmware", Backing.buf[0..Backing.len]);
+}
@@ -15,6 +15,12 @@
 //!   const Client = http.Client(Socket);
 //!   var client = Client{};
 //!   const resp = try client.get("http://192.168.1.100/api", &buffer);
+//!
+//!   // Large downloads: stream the body into a file with constant memory
+//!   var file = board.fs.open("/ota/firmware.bin", .write) orelse return;
+//!   defer file.close();
+//!   var scratch: [4096]u8 = undefined;
+//!   const result = try client.download(url, .{}, http.Sink.fromFile(&file), &scratch);
 
 const std = @import("std");
 
@@ -25,8 +31,10 @@ const dns = @import("dns");
 const request_mod = @import("request.zig");
 const response_mod = @import("response.zig");
 const stream_mod = @import("stream.zig");
+const body_mod = @import("body.zig");
 
 pub const Method = request_mod.Method;
+pub const Sink = body_mod.Sink;
 
 pub const Response = struct {
     status_code: u16,
@@ -67,6 +75,31 @@ pub const ClientError = error{
     TlsHandshakeFailed,
     TlsNotSupported,
     BufferTooSmall,
+    SinkWriteFailed,
+};
+
+/// Options for `download()`
+pub const DownloadOptions = struct {
+    /// Resume offset: sends `Range: bytes=<range_start>-` when non-zero
+    range_start: u64 = 0,
+    /// Inclusive last byte to fetch (null = to end of resource)
+    range_end: ?u64 = null,
+};
+
+/// Outcome of a streamed download
+pub const DownloadResult = struct {
+    status_code: u16,
+    /// Body bytes delivered to the sink by this call
+    bytes_written: u64,
+    /// Full resource size, if the server reported it
+    total_size: ?u64,
+    /// True if the server honoured the Range request (206 Partial Content)
+    resumed: bool,
+
+    /// Check if response is successful (2xx)
+    pub fn isSuccess(self: DownloadResult) bool {
+        return self.status_code >= 200 and self.status_code < 300;
+    }
 };
 
 // =============================================================================
@@ -153,6 +186,38 @@ fn HttpClientImpl(comptime Socket: type, comptime Crypto: type, comptime Rt: typ
             return self.request(.POST, url, dns_query, "application/dns-message", buffer);
         }
 
+        /// Stream a GET response body into `sink` using only `scratch` as memory.
+        /// See `downloadOn` for buffer and Range semantics.
+        pub fn download(
+            self: *const Self,
+            url: []const u8,
+            opts: DownloadOptions,
+            sink: Sink,
+            scratch: []u8,
+        ) ClientError!DownloadResult {
+            const parsed = parseUrl(url) orelse return error.InvalidUrl;
+
+            var socket = try self.dial(parsed.host, parsed.port);
+            defer socket.close();
+
+            if (!parsed.is_https) {
+                return downloadOn(&socket, parsed.host, parsed.path, self.user_agent, opts, sink, scratch);
+            }
+
+            var tls_client = TlsClient.init(&socket, .{
+                .allocator = self.allocator,
+                .hostname = parsed.host,
+                .skip_verify = self.ca_store == null,
+                .ca_store = self.ca_store,
+                .timeout_ms = self.timeout_ms,
+            }) catch return error.TlsError;
+            defer tls_client.deinit();
+
+            tls_client.connect() catch return error.TlsHandshakeFailed;
+
+            return downloadOn(&tls_client, parsed.host, parsed.path, self.user_agent, opts, sink, scratch);
+        }
+
         /// Perform HTTP request
         pub fn request(
             self: *const Self,
@@ -165,24 +230,9 @@ fn HttpClientImpl(comptime Socket: type, comptime Crypto: type, comptime Rt: typ
             // Parse URL
             const parsed = parseUrl(url) orelse return error.InvalidUrl;
 
-            // Resolve hostname to IP address
-            const addr = self.resolveHost(parsed.host) orelse {
-                return error.DnsResolveFailed;
-            };
-
-            // Create and configure socket
-            var socket = Socket.tcp() catch return error.ConnectionFailed;
-
-            socket.setRecvTimeout(self.timeout_ms);
-            socket.setSendTimeout(self.timeout_ms);
-            socket.setTcpNoDelay(true);
-
-            // Connect to server
+            // Resolve and connect
             // Note: requestHttps/requestHttp will close the socket via defer
-            socket.connect(addr, parsed.port) catch {
-                socket.close();
-                return error.ConnectionFailed;
-            };
+            var socket = try self.dial(parsed.host, parsed.port);
 
             // For HTTPS, use TLS
             if (parsed.is_https) {
@@ -193,11 +243,31 @@ fn HttpClientImpl(comptime Socket: type, comptime Crypto: type, comptime Rt: typ
             return self.requestHttp(&socket, parsed, method, body_data, content_type, buffer);
         }
 
-        /// Resolve hostname to IP address using built-in DNS resolver
-        fn resolveHost(self: *const Self, host: []const u8) ?[4]u8 {
+        /// Resolve `host` and connect, racing IPv6 and IPv4 addresses
+        /// (Happy Eyeballs) when the socket supports IPv6
+        fn dial(self: *const Self, host: []const u8, port: u16) ClientError!Socket {
+            var addrs: [dns.happy_eyeballs.MAX_ATTEMPTS]dns.IpAddress = undefined;
+            const n = self.resolveHost(host, &addrs);
+            if (n == 0) return error.DnsResolveFailed;
+
+            const conn = dns.happy_eyeballs.connect(Socket, addrs[0..n], port, .{
+                .timeout_ms = self.timeout_ms,
+            }) catch return error.ConnectionFailed;
+
+            var socket = conn.socket;
+            socket.setRecvTimeout(self.timeout_ms);
+            socket.setSendTimeout(self.timeout_ms);
+            socket.setTcpNoDelay(true);
+            return socket;
+        }
+
+        /// Resolve hostname to IP addresses using built-in DNS resolver.
+        /// Returns the number of addresses written to `out`.
+        fn resolveHost(self: *const Self, host: []const u8, out: []dns.IpAddress) usize {
             // First try to parse as IP address
-            if (trait.socket.parseIpv4(host)) |addr| {
-                return addr;
+            if (trait.socket.parseIp(host)) |addr| {
+                out[0] = addr;
+                return 1;
             }
 
             // Use built-in DNS resolver
@@ -210,7 +280,12 @@ fn HttpClientImpl(comptime Socket: type, comptime Crypto: type, comptime Rt: typ
                 resolver.custom_resolver = self.custom_resolver;
             }
 
-            return resolver.resolve(host) catch null;
+            // AAAA lookups only pay off when the socket can dial IPv6
+            if (comptime trait.socket.hasIpv6(Socket)) {
+                return resolver.resolveAll(host, out) catch 0;
+            }
+            out[0] = .{ .ipv4 = resolver.resolve(host) catch return 0 };
+            return 1;
         }
 
         /// HTTP request without TLS
@@ -227,7 +302,7 @@ fn HttpClientImpl(comptime Socket: type, comptime Crypto: type, comptime Rt: typ
 
             // Build HTTP request
             var req_buf: [2048]u8 = undefined;
-            const req_len = buildRequest(&req_buf, method, parsed.host, parsed.path, body_data, content_type, self.user_agent) catch {
+            const req_len = buildRequest(&req_buf, method, parsed.host, parsed.path, body_data, content_type, self.user_agent, null) catch {
                 return error.BufferTooSmall;
             };
 
@@ -285,7 +360,7 @@ fn HttpClientImpl(comptime Socket: type, comptime Crypto: type, comptime Rt: typ
 
             // Build HTTP request
             var req_buf: [2048]u8 = undefined;
-            const req_len = buildRequest(&req_buf, method, parsed.host, parsed.path, body_data, content_type, self.user_agent) catch {
+            const req_len = buildRequest(&req_buf, method, parsed.host, parsed.path, body_data, content_type, self.user_agent, null) catch {
                 return error.BufferTooSmall;
             };
 
@@ -341,6 +416,34 @@ fn ClientImpl(comptime Socket: type) type {
             return self.request(.POST, url, body_data, null, buffer);
         }
 
+        /// Stream a GET response body into `sink` using only `scratch` as memory.
+        /// See `downloadOn` for buffer and Range semantics.
+        pub fn download(
+            self: *const Self,
+            url: []const u8,
+            opts: DownloadOptions,
+            sink: Sink,
+            scratch: []u8,
+        ) ClientError!DownloadResult {
+            const parsed = parseUrl(url) orelse return error.InvalidUrl;
+            if (parsed.is_https) return error.TlsNotSupported;
+
+            const addr = trait.socket.parseIp(parsed.host) orelse {
+                return error.DnsResolveFailed;
+            };
+
+            var socket = trait.socket.tcpFor(Socket, addr.family()) catch return error.ConnectionFailed;
+            defer socket.close();
+
+            socket.setRecvTimeout(self.timeout_ms);
+            socket.setSendTimeout(self.timeout_ms);
+            socket.setTcpNoDelay(true);
+
+            trait.socket.connectAddr(&socket, addr, parsed.port) catch return error.ConnectionFailed;
+
+            return downloadOn(&socket, parsed.host, parsed.path, self.user_agent, opts, sink, scratch);
+        }
+
         /// Perform HTTP request (HTTP only, IP addresses only)
         pub fn request(
             self: *const Self,
@@ -359,12 +462,12 @@ fn ClientImpl(comptime Socket: type) type {
             }
 
             // Parse IP address (no DNS resolution)
-            const addr = trait.socket.parseIpv4(parsed.host) orelse {
+            const addr = trait.socket.parseIp(parsed.host) orelse {
                 return error.DnsResolveFailed;
             };
 
             // Create socket
-            var socket = Socket.tcp() catch return error.ConnectionFailed;
+            var socket = trait.socket.tcpFor(Socket, addr.family()) catch return error.ConnectionFailed;
             errdefer socket.close();
 
             // Configure socket
@@ -373,7 +476,7 @@ fn ClientImpl(comptime Socket: type) type {
             socket.setTcpNoDelay(true);
 
             // Connect
-            socket.connect(addr, parsed.port) catch return error.ConnectionFailed;
+            trait.socket.connectAddr(&socket, addr, parsed.port) catch return error.ConnectionFailed;
 
             // HTTP request
             return self.requestHttp(&socket, parsed, method, body_data, content_type, buffer);
@@ -393,7 +496,7 @@ fn ClientImpl(comptime Socket: type) type {
 
             // Build HTTP request
             var req_buf: [2048]u8 = undefined;
-            const req_len = buildRequest(&req_buf, method, parsed.host, parsed.path, body_data, content_type, self.user_agent) catch {
+            const req_len = buildRequest(&req_buf, method, parsed.host, parsed.path, body_data, content_type, self.user_agent, null) catch {
                 return error.BufferTooSmall;
             };
 
@@ -429,6 +532,81 @@ fn ClientImpl(comptime Socket: type) type {
 // Shared Helper Functions
 // =============================================================================
 
+/// Send a GET over an established connection and stream the response body
+/// into `sink`. `conn` is anything with `send`/`recv` (socket or TLS client).
+///
+/// `scratch` holds the request, then the response headers, then serves as
+/// the transfer buffer, so memory use is constant regardless of body size.
+/// Larger scratch means fewer recv/sink calls per byte.
+///
+/// Resume: with `opts.range_start > 0` a Range header is sent. If the server
+/// ignores it (200 instead of 206), the first `range_start` bytes are
+/// discarded and the body is cut off after `range_end`, so the sink still
+/// receives exactly the requested range.
+/// Non-2xx bodies are drained into nothing and reported via `status_code`.
+pub fn downloadOn(
+    conn: anytype,
+    host: []const u8,
+    path: []const u8,
+    user_agent: []const u8,
+    opts: DownloadOptions,
+    sink: Sink,
+    scratch: []u8,
+) ClientError!DownloadResult {
+    const Conn = @TypeOf(conn.*);
+
+    var range_buf: [64]u8 = undefined;
+    const range_header: ?[]const u8 = if (opts.range_start > 0 or opts.range_end != null)
+        formatRangeHeader(&range_buf, opts.range_start, opts.range_end)
+    else
+        null;
+
+    const req_len = buildRequest(scratch, .GET, host, path, null, null, user_agent, range_header) catch {
+        return error.BufferTooSmall;
+    };
+    var sent: usize = 0;
+    while (sent < req_len) {
+        const n = conn.send(scratch[sent..req_len]) catch return error.SendFailed;
+        if (n == 0) return error.SendFailed;
+        sent += n;
+    }
+
+    var reader = try body_mod.ResponseReader(Conn).init(conn, scratch);
+    const head = reader.head;
+
+    var result = DownloadResult{
+        .status_code = head.status_code,
+        .bytes_written = 0,
+        .total_size = head.total_size,
+        .resumed = head.status_code == 206,
+    };
+
+    if (!result.isSuccess()) return result;
+
+    var skip: u64 = 0;
+    var limit: ?u64 = null;
+    if (result.resumed) {
+        // A 206 for a different offset would corrupt the sink
+        if (head.range_start) |start| {
+            if (start != opts.range_start) return error.InvalidResponse;
+        }
+    } else {
+        skip = opts.range_start;
+        if (opts.range_end) |last| limit = (last +| 1) -| opts.range_start;
+        if (result.total_size == null) result.total_size = head.content_length;
+    }
+
+    result.bytes_written = try reader.pipe(sink, scratch, skip, limit);
+    return result;
+}
+
+fn formatRangeHeader(buf: []u8, start: u64, end: ?u64) []const u8 {
+    return if (end) |last|
+        std.fmt.bufPrint(buf, "Range: bytes={d}-{d}\r\n", .{ start, last }) catch unreachable
+    else
+        std.fmt.bufPrint(buf, "Range: bytes={d}-\r\n", .{start}) catch unreachable;
+}
+
 /// URL parsing result
 const ParsedUrl = struct {
     is_https: bool,
@@ -458,7 +636,16 @@ fn parseUrl(url: []const u8) ?ParsedUrl {
     var host: []const u8 = undefined;
     var port: u16 = if (is_https) 443 else 80;
 
-    if (std.mem.indexOfScalar(u8, host_port, ':')) |colon| {
+    if (std.mem.startsWith(u8, host_port, "[")) {
+        // IPv6 literal: keep the brackets for the Host header
+        const close = std.mem.indexOfScalar(u8, host_port, ']') orelse return null;
+        host = host_port[0 .. close + 1];
+        const after = host_port[close + 1 ..];
+        if (after.len > 0) {
+            if (after[0] != ':') return null;
+            port = std.fmt.parseInt(u16, after[1..], 10) catch return null;
+        }
+    } else if (std.mem.indexOfScalar(u8, host_port, ':')) |colon| {
         host = host_port[0..colon];
         port = std.fmt.parseInt(u16, host_port[colon + 1 ..], 10) catch return null;
     } else {
@@ -483,6 +670,7 @@ fn buildRequest(
     body_data: ?[]const u8,
     content_type: ?[]const u8,
     user_agent: []const u8,
+    extra_headers: ?[]const u8,
 ) !usize {
     var fbs = std.io.fixedBufferStream(buf);
     const w = fbs.writer();
@@ -505,6 +693,11 @@ fn buildRequest(
         try w.writeAll("Accept: application/dns-message\r\n");
     }
 
+    // Pre-formatted "Name: value\r\n" lines (e.g. Range)
+    if (extra_headers) |extra| {
+        try w.writeAll(extra);
+    }
+
     // End headers
     try w.writeAll("\r\n");
 
@@ -583,6 +776,14 @@ fn parseResponse(buffer: []u8, len: usize) ClientError!Response {
         i = line_end + 2;
     }
 
+    // De-chunk in place so body() returns the payload, not the framing
+    var body_end = len;
+    if (chunked) {
+        var decoder = body_mod.ChunkedDecoder{};
+        const n = decoder.decode(buffer[headers_end..len]) catch return error.InvalidResponse;
+        body_end = headers_end + n;
+    }
+
     return Response{
         .status_code = status_code,
         .content_length = content_length,
@@ -590,7 +791,7 @@ fn parseResponse(buffer: []u8, len: usize) ClientError!Response {
         .headers_end = headers_end,
         .body_start = headers_end,
         .buffer = buffer,
-        .buffer_len = len,
+        .buffer_len = body_end,
     };
 }
 
@@ -643,13 +844,24 @@ test "parseUrl - IP address" {
     try std.testing.expectEqual(@as(u16, 3000), result.port);
 }
 
+test "parseUrl - IPv6 literal" {
+    const result = parseUrl("http://[::1]:8080/api").?;
+    try std.testing.expectEqualStrings("[::1]", result.host);
+    try std.testing.expectEqual(@as(u16, 8080), result.port);
+    try std.testing.expect(trait.socket.parseIp(result.host).? == .ipv6);
+
+    const default_port = parseUrl("https://[2001:db8::1]/").?;
+    try std.testing.expectEqual(@as(u16, 443), default_port.port);
+    try std.testing.expect(parseUrl("http://[::1/") == null);
+}
+
 test "parseUrl - invalid empty host" {
     try std.testing.expect(parseUrl("http:///path") == null);
 }
 
 test "buildRequest - GET request" {
     var buf: [2048]u8 = undefined;
-    const len = buildRequest(&buf, .GET, "example.com", "/api", null, null, "test-agent") catch unreachable;
+    const len = buildRequest(&buf, .GET, "example.com", "/api", null, null, "test-agent", null) catch unreachable;
     const request = buf[0..len];
 
     try std.testing.expect(std.mem.indexOf(u8, request, "GET /api HTTP/1.1\r\n") != null);
@@ -661,7 +873,7 @@ test "buildRequest - GET request" {
 test "buildRequest - POST request with body" {
     var buf: [2048]u8 = undefined;
     const body = "test body data";
-    const len = buildRequest(&buf, .POST, "api.example.com", "/submit", body, "text/plain", "test-agent") catch unreachable;
+    const len = buildRequest(&buf, .POST, "api.example.com", "/submit", body, "text/plain", "test-agent", null) catch unreachable;
     const request = buf[0..len];
 
     try std.testing.expect(std.mem.indexOf(u8, request, "POST /submit HTTP/1.1\r\n") != null);
@@ -723,6 +935,58 @@ test "parseResponse - chunked transfer" {
     try std.testing.expectEqual(@as(u16, 200), resp.status_code);
     try std.testing.expect(resp.chunked);
     try std.testing.expect(resp.content_length == null);
+    try std.testing.expectEqualStrings("hello", resp.body());
+}
+
+test "buildRequest - Range header" {
+    var buf: [2048]u8 = undefined;
+    var range_buf: [64]u8 = undefined;
+    const range = formatRangeHeader(&range_buf, 4096, null);
+    const len = buildRequest(&buf, .GET, "example.com", "/fw.bin", null, null, "test-agent", range) catch unreachable;
+    const request = buf[0..len];
+
+    try std.testing.expect(std.mem.indexOf(u8, request, "Range: bytes=4096-\r\n") != null);
+    try std.testing.expect(std.mem.endsWith(u8, request, "\r\n\r\n"));
+    try std.testing.expectEqualStrings("Range: bytes=0-99\r\n", formatRangeHeader(&range_buf, 0, 99));
+}
+
+test "downloadOn - a 200 to a ranged request delivers only the range" {
+    const Conn = struct {
+        reply: []const u8,
+        pos: usize = 0,
+
+        pub fn send(_: *@This(), data: []const u8) error{Closed}!usize {
+            return data.len;
+        }
+
+        pub fn recv(self: *@This(), buf: []u8) error{Closed}!usize {
+            if (self.pos >= self.reply.len) return error.Closed;
+            const n = @min(buf.len, 5, self.reply.len - self.pos);
+            @memcpy(buf[0..n], self.reply[self.pos..][0..n]);
+            self.pos += n;
+            return n;
+        }
+    };
+    const Collect = struct {
+        buf: [32]u8 = undefined,
+        len: usize = 0,
+
+        fn write(ctx: *anyopaque, data: []const u8) bool {
+            const self: *@This() = @ptrCast(@alignCast(ctx));
+            @memcpy(self.buf[self.len..][0..data.len], data);
+            self.len += data.len;
+            return true;
+        }
+    };
+
+    var conn = Conn{ .reply = "HTTP/1.1 200 OK\r\nContent-Length: 16\r\n\r\n0123456789abcdef" };
+    var collect = Collect{};
+    var scratch: [512]u8 = undefined;
+    const result = try downloadOn(&conn, "example.com", "/fw.bin", "test-agent", .{ .range_start = 4, .range_end = 9 }, .{ .ctx = @ptrCast(&collect), .writeFn = &Collect.write }, &scratch);
+
+    try std.testing.expect(!result.resumed);
+    try std.testing.expectEqual(@as(u64, 6), result.bytes_written);
+    try std.testing.expectEqualStrings("456789", collect.buf[0..collect.len]);
 }
 
 test "Response.isSuccess" {
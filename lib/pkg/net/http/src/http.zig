@@ -27,6 +27,9 @@
 //! const Client = http.HttpClient(Socket, crypto.Suite, Rt, void);
 //! var client = Client{ .allocator = allocator };
 //! const resp = try client.get("https://example.com/api", &buffer);
+//!
+//! // Bodies larger than RAM: stream into a file (or any Sink)
+//! const result = try client.download(url, .{ .range_start = resume_at }, http.Sink.fromFile(&file), &scratch);
 //! ```
 
 // -- Client --
@@ -35,6 +38,14 @@ pub const HttpClient = client.HttpClient;
 pub const Client = client.Client;
 pub const ClientError = client.ClientError;
 pub const ClientResponse = client.Response;
+pub const DownloadOptions = client.DownloadOptions;
+pub const DownloadResult = client.DownloadResult;
+pub const downloadOn = client.downloadOn;
+
+pub const body = @import("body.zig");
+pub const Sink = body.Sink;
+pub const ResponseReader = body.ResponseReader;
+pub const ChunkedDecoder = body.ChunkedDecoder;
 
 pub const stream = @import("stream.zig");
 pub const SocketStream = stream.SocketStream;
@@ -69,6 +80,8 @@ pub const EmbeddedFile = static.EmbeddedFile;
 
 // Run all tests
 test {
+    _ = client;
+    _ = body;
     _ = request;
     _ = response;
     _ = router;
@@ -9,6 +9,9 @@ pub const Response = struct {
     pos: usize = 0,
     headers_sent: bool = false,
     status_code: u16 = 200,
+    /// Set by the server when this is the last response on the connection;
+    /// emits "Connection: close" so pipelining clients stop sending.
+    close_connection: bool = false,
 
     write_fn: *const fn (ctx: *anyopaque, data: []const u8) WriteError!void,
     write_ctx: *anyopaque,
@@ -83,6 +86,10 @@ pub const Response = struct {
         hdr_pos = appendBuf(&hdr_buf, hdr_pos, request.writeUsize(&cl_buf, body.len) orelse "0");
         hdr_pos = appendBuf(&hdr_buf, hdr_pos, "\r\n");
 
+        if (self.close_connection) {
+            hdr_pos = appendBuf(&hdr_buf, hdr_pos, "Connection: close\r\n");
+        }
+
         self.write_fn(self.write_ctx, hdr_buf[0..hdr_pos]) catch {};
 
         // 2. Send custom headers accumulated by setHeader()
@@ -225,6 +232,23 @@ test "404 sendStatus" {
     try testing.expect(mem.indexOf(u8, out, "Content-Length: 0\r\n") != null);
 }
 
+test "close_connection emits Connection: close" {
+    var tw = TestWriter{};
+    var write_buf: [512]u8 = undefined;
+    var resp = Response{
+        .write_buf = &write_buf,
+        .write_fn = TestWriter.writeFn,
+        .write_ctx = @ptrCast(&tw),
+        .close_connection = true,
+    };
+
+    resp.send("bye");
+
+    const out = tw.output();
+    try testing.expect(mem.indexOf(u8, out, "Connection: close\r\n") != null);
+    try testing.expect(mem.endsWith(u8, out, "\r\n\r\nbye"));
+}
+
 test "multiple headers" {
     var tw = TestWriter{};
     var write_buf: [512]u8 = undefined;
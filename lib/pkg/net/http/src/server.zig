@@ -14,7 +14,18 @@ const Handler = router_mod.Handler;
 pub const Config = struct {
     read_buf_size: usize = 8192,
     write_buf_size: usize = 4096,
+    /// Requests served on one keep-alive connection before the server closes
+    /// it (the last response carries "Connection: close"). 0 = unlimited.
     max_requests_per_conn: usize = 100,
+    /// Honour keep-alive at all. When false every response closes the connection.
+    keep_alive: bool = true,
+    /// Pipelined responses are coalesced into this buffer and flushed with a
+    /// single send once no further complete request is buffered.
+    /// 0 = write-through (one send per response piece).
+    out_buf_size: usize = 4096,
+    /// Upper bound on responses held in the output buffer before a forced
+    /// flush, so a long pipeline still sees steady progress.
+    max_pipeline_depth: usize = 16,
 };
 
 /// HTTP/1.1 Server generic over Socket type.
@@ -22,6 +33,10 @@ pub const Config = struct {
 /// Socket must implement recv/send/close (trait.socket interface).
 /// User controls the accept loop; server handles per-connection request/response.
 ///
+/// Pipelining: every complete request already in the read buffer is handled
+/// before the server blocks on recv again. Responses are produced strictly in
+/// request order and coalesced into one send per batch (see Config.out_buf_size).
+///
 /// Example:
 ///   const HttpServer = http.Server(Socket, .{ .read_buf_size = 8192 });
 ///   var server = HttpServer.init(allocator, &routes);
@@ -43,7 +58,8 @@ pub fn Server(comptime Socket: type, comptime config: Config) type {
         }
 
         /// Serve a single connection. Call in a spawned task.
-        /// Supports HTTP/1.1 keep-alive: loops until connection close or limit reached.
+        /// Supports HTTP/1.1 keep-alive and pipelining: loops until connection
+        /// close or limit reached.
         pub fn serveConn(self: *const Self, socket: Socket) void {
             var sock = socket;
             defer sock.close();
@@ -54,24 +70,36 @@ pub fn Server(comptime Socket: type, comptime config: Config) type {
             const write_buf = self.allocator.alloc(u8, config.write_buf_size) catch return;
             defer self.allocator.free(write_buf);
 
+            const out_buf = self.allocator.alloc(u8, config.out_buf_size) catch return;
+            defer self.allocator.free(out_buf);
+
+            var out = BatchWriter{ .sock = &sock, .buf = out_buf };
+            // Runs before sock.close(): whatever is still batched goes out first
+            defer out.flush() catch {};
+
             var buffered: usize = 0;
             var requests_served: usize = 0;
+            var pending_responses: usize = 0;
 
             var need_more_data = false;
 
-            while (requests_served < config.max_requests_per_conn) {
+            while (config.max_requests_per_conn == 0 or requests_served < config.max_requests_per_conn) {
                 // Read data until we can attempt a parse.
                 // First iteration: wait for header terminator "\r\n\r\n".
                 // After Incomplete (partial body): force at least one recv before retrying parse.
                 while (need_more_data or mem.indexOf(u8, read_buf[0..buffered], "\r\n\r\n") == null) {
                     if (buffered >= read_buf.len) break;
 
+                    // About to block: release the batched responses first
+                    out.flush() catch return;
+                    pending_responses = 0;
+
                     const n = sock.recv(read_buf[buffered..]) catch |err| {
                         switch (err) {
                             error.Timeout => {
                                 if (buffered == 0) return;
                                 if (need_more_data) {
-                                    sendError(&sock, write_buf, 408);
+                                    sendError(&out, write_buf, 408);
                                     return;
                                 }
                                 break;
@@ -89,24 +117,30 @@ pub fn Server(comptime Socket: type, comptime config: Config) type {
                     switch (err) {
                         error.Incomplete => {
                             if (buffered >= read_buf.len) {
-                                sendError(&sock, write_buf, 413);
+                                sendError(&out, write_buf, 413);
                                 return;
                             }
                             need_more_data = true;
                             continue;
                         },
                         else => {
-                            sendError(&sock, write_buf, 400);
+                            sendError(&out, write_buf, 400);
                             return;
                         },
                     }
                 };
 
                 var req = result.request;
+                requests_served += 1;
+                const last = !config.keep_alive or
+                    (config.max_requests_per_conn != 0 and requests_served >= config.max_requests_per_conn) or
+                    !wantsKeepAlive(&req);
+
                 var resp = Response{
                     .write_buf = write_buf,
-                    .write_fn = socketWriteFn(Socket),
-                    .write_ctx = @ptrCast(&sock),
+                    .write_fn = BatchWriter.write,
+                    .write_ctx = @ptrCast(&out),
+                    .close_connection = last,
                 };
 
                 const route_match = router_mod.match(self.routes, req.method, req.path);
@@ -115,15 +149,15 @@ pub fn Server(comptime Socket: type, comptime config: Config) type {
                     .not_found => resp.sendStatus(404),
                     .method_not_allowed => resp.sendStatus(405),
                 }
+                // A silent handler would stall every pipelined request behind it
+                if (!resp.headers_sent) resp.sendStatus(500);
 
-                requests_served += 1;
+                if (out.failed or last) return;
 
-                const is_http10 = mem.eql(u8, req.version, "HTTP/1.0");
-                if (req.header("Connection")) |conn_header| {
-                    if (std.ascii.eqlIgnoreCase(conn_header, "close")) return;
-                    if (is_http10 and !std.ascii.eqlIgnoreCase(conn_header, "keep-alive")) return;
-                } else if (is_http10) {
-                    return;
+                pending_responses += 1;
+                if (pending_responses >= config.max_pipeline_depth) {
+                    out.flush() catch return;
+                    pending_responses = 0;
                 }
 
                 const consumed = result.consumed;
@@ -136,27 +170,63 @@ pub fn Server(comptime Socket: type, comptime config: Config) type {
             }
         }
 
-        fn sendError(sock: *Socket, write_buf: []u8, code: u16) void {
+        fn wantsKeepAlive(req: *const Request) bool {
+            const is_http10 = mem.eql(u8, req.version, "HTTP/1.0");
+            if (req.header("Connection")) |conn_header| {
+                if (std.ascii.eqlIgnoreCase(conn_header, "close")) return false;
+                if (is_http10) return std.ascii.eqlIgnoreCase(conn_header, "keep-alive");
+                return true;
+            }
+            return !is_http10;
+        }
+
+        fn sendError(out: *BatchWriter, write_buf: []u8, code: u16) void {
             var resp = Response{
                 .write_buf = write_buf,
-                .write_fn = socketWriteFn(Socket),
-                .write_ctx = @ptrCast(sock),
+                .write_fn = BatchWriter.write,
+                .write_ctx = @ptrCast(out),
+                .close_connection = true,
             };
             resp.sendStatus(code);
         }
-    };
-}
 
-fn socketWriteFn(comptime Socket: type) *const fn (*anyopaque, []const u8) Response.WriteError!void {
-    return struct {
-        fn write(ctx: *anyopaque, data: []const u8) Response.WriteError!void {
-            const sock: *Socket = @ptrCast(@alignCast(ctx));
-            var sent: usize = 0;
-            while (sent < data.len) {
-                sent += sock.send(data[sent..]) catch return error.SocketError;
+        /// Coalesces response writes; pieces larger than the buffer bypass it.
+        const BatchWriter = struct {
+            sock: *Socket,
+            buf: []u8,
+            len: usize = 0,
+            failed: bool = false,
+
+            fn write(ctx: *anyopaque, data: []const u8) Response.WriteError!void {
+                const self: *BatchWriter = @ptrCast(@alignCast(ctx));
+                if (self.failed) return error.SocketError;
+
+                if (self.len + data.len > self.buf.len) {
+                    try self.flush();
+                    if (data.len > self.buf.len) return self.sendAll(data);
+                }
+                @memcpy(self.buf[self.len..][0..data.len], data);
+                self.len += data.len;
             }
-        }
-    }.write;
+
+            fn flush(self: *BatchWriter) Response.WriteError!void {
+                if (self.len == 0) return;
+                const n = self.len;
+                self.len = 0;
+                try self.sendAll(self.buf[0..n]);
+            }
+
+            fn sendAll(self: *BatchWriter, data: []const u8) Response.WriteError!void {
+                var sent: usize = 0;
+                while (sent < data.len) {
+                    sent += self.sock.send(data[sent..]) catch {
+                        self.failed = true;
+                        return error.SocketError;
+                    };
+                }
+            }
+        };
+    };
 }
 
 // ---------------------------------------------------------------------------
@@ -175,6 +245,7 @@ const MockSocket = struct {
         input_pos: usize = 0,
         output: [8192]u8 = undefined,
         output_len: usize = 0,
+        send_calls: usize = 0,
         closed: bool = false,
 
         fn getOutput(self: *const State) []const u8 {
@@ -198,6 +269,7 @@ const MockSocket = struct {
         if (end > s.output.len) return error.SendFailed;
         @memcpy(s.output[s.output_len..end], data);
         s.output_len = end;
+        s.send_calls += 1;
         return data.len;
     }
 
@@ -279,3 +351,97 @@ test "Connection: close terminates" {
     }
     try testing.expectEqual(@as(usize, 1), count);
 }
+
+fn countResponses(out: []const u8) usize {
+    var count: usize = 0;
+    var pos: usize = 0;
+    while (mem.indexOfPos(u8, out, pos, "HTTP/1.1 ")) |idx| {
+        count += 1;
+        pos = idx + 1;
+    }
+    return count;
+}
+
+fn pathHandler(req: *Request, resp: *Response) void {
+    resp.send(req.path);
+}
+
+test "pipelined requests — in-order responses, one coalesced send" {
+    const raw =
+        "GET /a HTTP/1.1\r\nHost: x\r\n\r\n" ++
+        "GET /bb HTTP/1.1\r\nHost: x\r\n\r\n" ++
+        "GET /missing HTTP/1.1\r\nHost: x\r\n\r\n" ++
+        "GET /ccc HTTP/1.1\r\nHost: x\r\nConnection: close\r\n\r\n";
+    var state = MockSocket.State{ .input = raw };
+    const socket = MockSocket{ .state = &state };
+
+    const routes = [_]Route{
+        router_mod.get("/a", pathHandler),
+        router_mod.get("/bb", pathHandler),
+        router_mod.get("/ccc", pathHandler),
+    };
+
+    const TestServer = Server(MockSocket, .{ .read_buf_size = 1024, .write_buf_size = 512 });
+    const server = TestServer.init(testing.allocator, &routes);
+    server.serveConn(socket);
+
+    const out = state.getOutput();
+    try testing.expectEqual(@as(usize, 4), countResponses(out));
+    try testing.expectEqual(@as(usize, 1), state.send_calls);
+
+    const a = mem.indexOf(u8, out, "\r\n\r\n/a").?;
+    const bb = mem.indexOf(u8, out, "\r\n\r\n/bb").?;
+    const nf = mem.indexOf(u8, out, "HTTP/1.1 404").?;
+    const ccc = mem.indexOf(u8, out, "\r\n\r\n/ccc").?;
+    try testing.expect(a < bb and bb < nf and nf < ccc);
+    // Only the last response announces the close
+    try testing.expectEqual(mem.indexOf(u8, out, "Connection: close").?, mem.lastIndexOf(u8, out, "Connection: close").?);
+    try testing.expect(mem.indexOf(u8, out, "Connection: close").? > nf);
+}
+
+test "pipeline depth forces intermediate flushes" {
+    const one = "GET /a HTTP/1.1\r\nHost: x\r\n\r\n";
+    const raw = one ** 6;
+    var state = MockSocket.State{ .input = raw };
+    const socket = MockSocket{ .state = &state };
+
+    const routes = [_]Route{router_mod.get("/a", pathHandler)};
+
+    const TestServer = Server(MockSocket, .{ .read_buf_size = 1024, .write_buf_size = 512, .max_pipeline_depth = 2 });
+    const server = TestServer.init(testing.allocator, &routes);
+    server.serveConn(socket);
+
+    try testing.expectEqual(@as(usize, 6), countResponses(state.getOutput()));
+    try testing.expectEqual(@as(usize, 3), state.send_calls);
+}
+
+test "max_requests_per_conn — last response announces close" {
+    const one = "GET /a HTTP/1.1\r\nHost: x\r\n\r\n";
+    var state = MockSocket.State{ .input = one ** 5 };
+    const socket = MockSocket{ .state = &state };
+
+    const routes = [_]Route{router_mod.get("/a", pathHandler)};
+
+    const TestServer = Server(MockSocket, .{ .read_buf_size = 1024, .write_buf_size = 512, .max_requests_per_conn = 3 });
+    const server = TestServer.init(testing.allocator, &routes);
+    server.serveConn(socket);
+
+    const out = state.getOutput();
+    try testing.expectEqual(@as(usize, 3), countResponses(out));
+    try testing.expect(mem.indexOf(u8, out, "Connection: close") != null);
+    try testing.expect(state.closed);
+}
+
+test "keep_alive disabled closes after first response" {
+    const one = "GET /a HTTP/1.1\r\nHost: x\r\n\r\n";
+    var state = MockSocket.State{ .input = one ** 2 };
+    const socket = MockSocket{ .state = &state };
+
+    const routes = [_]Route{router_mod.get("/a", pathHandler)};
+
+    const TestServer = Server(MockSocket, .{ .read_buf_size = 1024, .write_buf_size = 512, .keep_alive = false });
+    const server = TestServer.init(testing.allocator, &routes);
+    server.serveConn(socket);
+
+    try testing.expectEqual(@as(usize, 1), countResponses(state.getOutput()));
+}
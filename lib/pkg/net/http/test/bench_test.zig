@@ -417,3 +417,136 @@ test "BM5: 10 concurrent connections x 100 keep-alive requests" {
     print("\n[bench] HTTP concurrent-keepalive: {d}x{d} = {d}/{d} req in {d}ms\n", .{ CONNS, REQS_PER_CONN, ok, expected, elapsed });
     try testing.expectEqual(expected, ok);
 }
+
+// ============================================================================
+// BM6: Client download throughput — 64MB streamed through a 16KB scratch
+// ============================================================================
+
+fn serveBulk(listener_fd: posix.socket_t, total: usize) void {
+    var sock = acceptOne(listener_fd) catch return;
+    defer sock.close();
+
+    var req_buf: [1024]u8 = undefined;
+    var req_len: usize = 0;
+    while (std.mem.indexOf(u8, req_buf[0..req_len], "\r\n\r\n") == null) {
+        const n = posix.recv(sock.fd, req_buf[req_len..], 0) catch return;
+        if (n == 0) return;
+        req_len += n;
+    }
+
+    var hdr_buf: [128]u8 = undefined;
+    const hdr = std.fmt.bufPrint(&hdr_buf, "HTTP/1.1 200 OK\r\nContent-Length: {d}\r\nConnection: close\r\n\r\n", .{total}) catch return;
+    sendRaw(&sock, hdr) catch return;
+
+    var block: [65536]u8 = undefined;
+    @memset(&block, 'D');
+    var sent: usize = 0;
+    while (sent < total) {
+        const n = @min(block.len, total - sent);
+        sendRaw(&sock, block[0..n]) catch return;
+        sent += n;
+    }
+}
+
+const CountSink = struct {
+    bytes: u64 = 0,
+
+    fn sink(self: *CountSink) http.Sink {
+        return .{ .ctx = @ptrCast(self), .writeFn = &write };
+    }
+
+    fn write(ctx: *anyopaque, data: []const u8) bool {
+        const self: *CountSink = @ptrCast(@alignCast(ctx));
+        self.bytes += data.len;
+        return true;
+    }
+};
+
+test "BM6: 64MB streaming download" {
+    const listener = try startListener();
+    defer posix.close(listener.fd);
+
+    const total: usize = 64 * 1024 * 1024;
+    const t = try std.Thread.spawn(.{}, serveBulk, .{ listener.fd, total });
+    defer t.join();
+
+    var sock = try TcpSocket.connectTo(listener.port);
+    defer sock.close();
+
+    var scratch: [16384]u8 = undefined;
+    var counter = CountSink{};
+    const start = nowMs();
+    const result = try http.downloadOn(&sock, "localhost", "/bulk", "bench", .{}, counter.sink(), &scratch);
+    const elapsed = nowMs() - start;
+
+    const mb_per_s = if (elapsed > 0) total * 1000 / elapsed / (1024 * 1024) else 0;
+    print("\n[bench] HTTP client download: {d}MB in {d}ms, {d} MB/s (16KB scratch)\n", .{ total / (1024 * 1024), elapsed, mb_per_s });
+    try testing.expectEqual(@as(u64, total), result.bytes_written);
+    try testing.expectEqual(@as(u64, total), counter.bytes);
+}
+
+// ============================================================================
+// BM7: Pipelined load — batches of requests per write, req/s + batch latency
+// ============================================================================
+
+const PipelineServer = http.Server(TcpSocket, .{
+    .read_buf_size = 8192,
+    .write_buf_size = 4096,
+    .max_requests_per_conn = 0,
+    .out_buf_size = 8192,
+    .max_pipeline_depth = 32,
+});
+
+fn servePipelineConn(server: *const PipelineServer, listener_fd: posix.socket_t) void {
+    const conn = acceptOne(listener_fd) catch return;
+    server.serveConn(conn);
+}
+
+test "BM7: pipelined 10000 requests, depth 16" {
+    const listener = try startListener();
+    defer posix.close(listener.fd);
+
+    const server = PipelineServer.init(testing.allocator, &small_routes);
+    const t = try std.Thread.spawn(.{}, servePipelineConn, .{ &server, listener.fd });
+    defer t.join();
+
+    var sock = try TcpSocket.connectTo(listener.port);
+    defer sock.close();
+
+    const DEPTH = 16;
+    const BATCHES = 625;
+    const batch = GET_REQUEST ** DEPTH;
+
+    var reader = BufferedReader(16384).init(&sock);
+    var latencies_us: [BATCHES]u64 = undefined;
+    var ok_count: usize = 0;
+    const start = nowMs();
+
+    for (0..BATCHES) |b| {
+        const t0 = std.time.nanoTimestamp();
+        try sendRaw(&sock, batch);
+        for (0..DEPTH) |_| {
+            if (reader.readOneResponse() catch false) ok_count += 1;
+        }
+        latencies_us[b] = @intCast(@divFloor(std.time.nanoTimestamp() - t0, std.time.ns_per_us));
+    }
+
+    const elapsed = nowMs() - start;
+    try sendRaw(&sock, CLOSE_REQUEST);
+    _ = reader.readOneResponse() catch false;
+
+    std.mem.sort(u64, &latencies_us, {}, std.sort.asc(u64));
+    var sum: u64 = 0;
+    for (latencies_us) |l| sum += l;
+
+    const N = DEPTH * BATCHES;
+    const rps = if (elapsed > 0) N * 1000 / elapsed else 0;
+    print("\n[bench] HTTP pipelined: {d} req (depth {d}) in {d}ms, {d} req/s\n", .{ N, DEPTH, elapsed, rps });
+    print("[bench] HTTP pipelined batch latency: avg {d}us, p50 {d}us, p99 {d}us, max {d}us\n", .{
+        sum / BATCHES,
+        latencies_us[BATCHES / 2],
+        latencies_us[BATCHES * 99 / 100],
+        latencies_us[BATCHES - 1],
+    });
+    try testing.expectEqual(@as(usize, N), ok_count);
+}
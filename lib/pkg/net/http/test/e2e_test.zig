@@ -410,3 +410,184 @@ test "E5: static embedded file serving" {
         try expectStatus(resp, 404);
     }
 }
+
+// ============================================================================
+// E6: Streaming client download (chunked, Content-Length, Range resume)
+// ============================================================================
+
+/// Deterministic payload byte at a given offset
+fn patternByte(offset: u64) u8 {
+    return @intCast(offset % 251);
+}
+
+const Framing = enum { length, chunked, ignore_range };
+
+/// Minimal origin server: answers one GET with `total` pattern bytes,
+/// honouring `Range: bytes=N-` unless told to ignore it.
+fn serveDownload(listener_fd: posix.socket_t, framing: Framing, total: usize) void {
+    var sock = acceptOne(listener_fd) catch return;
+    defer sock.close();
+
+    var req_buf: [1024]u8 = undefined;
+    var req_len: usize = 0;
+    while (std.mem.indexOf(u8, req_buf[0..req_len], "\r\n\r\n") == null) {
+        const n = posix.recv(sock.fd, req_buf[req_len..], 0) catch return;
+        if (n == 0) return;
+        req_len += n;
+    }
+    const req = req_buf[0..req_len];
+
+    var start: usize = 0;
+    if (framing != .ignore_range) {
+        if (std.mem.indexOf(u8, req, "Range: bytes=")) |pos| {
+            const val = req[pos + "Range: bytes=".len ..];
+            const dash = std.mem.indexOfScalar(u8, val, '-') orelse return;
+            start = std.fmt.parseUnsigned(usize, val[0..dash], 10) catch return;
+        }
+    }
+
+    var hdr_buf: [256]u8 = undefined;
+    const hdr = switch (framing) {
+        .chunked => std.fmt.bufPrint(&hdr_buf, "HTTP/1.1 200 OK\r\nTransfer-Encoding: chunked\r\nConnection: close\r\n\r\n", .{}),
+        else => if (start > 0)
+            std.fmt.bufPrint(&hdr_buf, "HTTP/1.1 206 Partial Content\r\nContent-Length: {d}\r\nContent-Range: bytes {d}-{d}/{d}\r\nConnection: close\r\n\r\n", .{ total - start, start, total - 1, total })
+        else
+            std.fmt.bufPrint(&hdr_buf, "HTTP/1.1 200 OK\r\nContent-Length: {d}\r\nConnection: close\r\n\r\n", .{total}),
+    } catch return;
+    sendRaw(&sock, hdr) catch return;
+
+    // Irregular chunk sizes so framing lands at arbitrary recv boundaries
+    var chunk: [4096]u8 = undefined;
+    var offset: usize = start;
+    var size: usize = 1;
+    while (offset < total) {
+        const n = @min(size, total - offset, chunk.len);
+        for (chunk[0..n], 0..) |*b, i| b.* = patternByte(offset + i);
+        if (framing == .chunked) {
+            var size_buf: [16]u8 = undefined;
+            sendRaw(&sock, std.fmt.bufPrint(&size_buf, "{x}\r\n", .{n}) catch return) catch return;
+            sendRaw(&sock, chunk[0..n]) catch return;
+            sendRaw(&sock, "\r\n") catch return;
+        } else {
+            sendRaw(&sock, chunk[0..n]) catch return;
+        }
+        offset += n;
+        size = @min(size * 3 + 1, chunk.len);
+    }
+    if (framing == .chunked) sendRaw(&sock, "0\r\n\r\n") catch return;
+}
+
+/// Sink that verifies the pattern instead of storing the body
+const VerifySink = struct {
+    offset: u64,
+    bytes: u64 = 0,
+    ok: bool = true,
+
+    fn sink(self: *VerifySink) http.Sink {
+        return .{ .ctx = @ptrCast(self), .writeFn = &write };
+    }
+
+    fn write(ctx: *anyopaque, data: []const u8) bool {
+        const self: *VerifySink = @ptrCast(@alignCast(ctx));
+        for (data) |b| {
+            if (b != patternByte(self.offset)) self.ok = false;
+            self.offset += 1;
+        }
+        self.bytes += data.len;
+        return true;
+    }
+};
+
+fn runDownload(framing: Framing, total: usize, range_start: u64) !struct { result: http.DownloadResult, verify: VerifySink } {
+    const listener = try startListener();
+    defer posix.close(listener.fd);
+
+    const t = try std.Thread.spawn(.{}, serveDownload, .{ listener.fd, framing, total });
+    defer t.join();
+
+    var sock = try TcpSocket.connectTo(listener.port);
+    defer sock.close();
+
+    // Scratch is far smaller than the body: memory stays constant
+    var scratch: [512]u8 = undefined;
+    var verify = VerifySink{ .offset = range_start };
+    const result = try http.downloadOn(&sock, "localhost", "/fw.bin", "e2e-test", .{ .range_start = range_start }, verify.sink(), &scratch);
+    return .{ .result = result, .verify = verify };
+}
+
+test "E6: streaming download larger than scratch buffer" {
+    const total = 256 * 1024;
+
+    // Content-Length framing
+    {
+        const r = try runDownload(.length, total, 0);
+        try testing.expectEqual(@as(u16, 200), r.result.status_code);
+        try testing.expectEqual(@as(u64, total), r.result.bytes_written);
+        try testing.expectEqual(@as(?u64, total), r.result.total_size);
+        try testing.expect(r.verify.ok);
+    }
+
+    // Chunked framing is decoded on the fly
+    {
+        const r = try runDownload(.chunked, total, 0);
+        try testing.expectEqual(@as(u64, total), r.result.bytes_written);
+        try testing.expect(r.verify.ok);
+    }
+
+    // Resume via Range → 206
+    {
+        const r = try runDownload(.length, total, 100_000);
+        try testing.expect(r.result.resumed);
+        try testing.expectEqual(@as(u16, 206), r.result.status_code);
+        try testing.expectEqual(@as(u64, total - 100_000), r.result.bytes_written);
+        try testing.expectEqual(@as(?u64, total), r.result.total_size);
+        try testing.expect(r.verify.ok);
+    }
+
+    // Server ignores Range → prefix is skipped client-side
+    {
+        const r = try runDownload(.ignore_range, total, 100_000);
+        try testing.expect(!r.result.resumed);
+        try testing.expectEqual(@as(u64, total - 100_000), r.result.bytes_written);
+        try testing.expect(r.verify.ok);
+    }
+}
+
+// ============================================================================
+// E7: Pipelined requests in a single write
+// ============================================================================
+
+test "E7: pipelined requests answered in order" {
+    const listener = try startListener();
+    defer posix.close(listener.fd);
+
+    const server = HttpServer.init(testing.allocator, &routes);
+    const t = try std.Thread.spawn(.{}, serveOneConnection, .{ &server, listener.fd });
+    defer t.join();
+
+    var sock = try TcpSocket.connectTo(listener.port);
+    defer sock.close();
+
+    // status, missing, static file, status+close — all in one send
+    try sendRaw(&sock, "GET /api/status HTTP/1.1\r\nHost: localhost\r\n\r\n" ++
+        "GET /nonexistent HTTP/1.1\r\nHost: localhost\r\n\r\n" ++
+        "GET /static/app.js HTTP/1.1\r\nHost: localhost\r\n\r\n" ++
+        "GET /api/status HTTP/1.1\r\nHost: localhost\r\nConnection: close\r\n\r\n");
+
+    // Server closes after the last response; read to EOF
+    var buf: [8192]u8 = undefined;
+    var total: usize = 0;
+    while (total < buf.len) {
+        const n = posix.recv(sock.fd, buf[total..], 0) catch break;
+        if (n == 0) break;
+        total += n;
+    }
+    const out = buf[0..total];
+
+    const r1 = std.mem.indexOf(u8, out, "HTTP/1.1 200").?;
+    const r2 = std.mem.indexOf(u8, out, "HTTP/1.1 404").?;
+    const r3 = std.mem.indexOf(u8, out, "console.log('hello');").?;
+    const r4 = std.mem.lastIndexOf(u8, out, "HTTP/1.1 200").?;
+    try testing.expect(r1 < r2 and r2 < r3 and r3 < r4);
+    try testing.expect(std.mem.indexOf(u8, out[r4..], "Connection: close") != null);
+}
@@ -0,0 +1,39 @@
+const std = @import("std");
+
+pub fn build(b: *std.Build) void {
+    const target = b.standardTargetOptions(.{});
+    const optimize = b.standardOptimizeOption(.{});
+
+    const trait_dep = b.dependency("trait", .{
+        .target = target,
+        .optimize = optimize,
+    });
+
+    // Module
+    const pool_mod = b.addModule("net/pool", .{
+        .root_source_file = b.path("src/pool.zig"),
+        .target = target,
+        .optimize = optimize,
+    });
+    pool_mod.addImport("trait", trait_dep.module("trait"));
+
+    // Test-only dependency: runtime Mutex for the threaded slab test
+    const std_impl_dep = b.dependency("std_impl", .{
+        .target = target,
+        .optimize = optimize,
+    });
+
+    // Unit tests
+    const test_step = b.step("test", "Run unit tests");
+    const tests = b.addTest(.{
+        .root_module = b.createModule(.{
+            .root_source_file = b.path("src/pool.zig"),
+            .target = target,
+            .optimize = optimize,
+        }),
+    });
+    tests.root_module.addImport("trait", trait_dep.module("trait"));
+    tests.root_module.addImport("std_impl", std_impl_dep.module("std_impl"));
+    const run_tests = b.addRunArtifact(tests);
+    test_step.dependOn(&run_tests.step);
+}
@@ -0,0 +1,312 @@
+//! Per-Connection Arena
+//!
+//! A bump allocator for state that lives exactly as long as one
+//! connection: parsed headers, topic-alias maps, per-message contexts.
+//! Memory comes in `block_size` blocks from a backing allocator (usually a
+//! Slab, so the blocks themselves are recycled between connections).
+//! `free` only reclaims the most recent allocation; everything else goes
+//! back at once when the connection closes and the handler calls `reset`.
+//!
+//! `reset` keeps up to `retain_blocks` blocks, so the next connection on
+//! the same handler starts without touching the backing allocator.
+//! Requests that do not fit an empty block get their own allocation from
+//! the backing allocator and are released on `reset`.
+//!
+//! Not thread-safe: one arena per connection (or per worker).
+
+const std = @import("std");
+
+const Allocator = std.mem.Allocator;
+const Alignment = std.mem.Alignment;
+
+pub const Options = struct {
+    /// Bytes requested from the backing allocator per block, header included
+    block_size: usize = 4096,
+    /// Blocks kept across `reset`
+    retain_blocks: usize = 1,
+};
+
+pub const Stats = struct {
+    /// Bytes handed out since the last reset, less rolled-back ones
+    used: usize = 0,
+    /// Most bytes handed out between two resets
+    peak: usize = 0,
+    /// Blocks held, retained ones included
+    blocks: usize = 0,
+    /// Connections served (calls to `reset`)
+    resets: usize = 0,
+};
+
+const block_alignment: Alignment = .@"16";
+
+/// Header at the start of every block and oversize allocation
+const Block = struct {
+    next: ?*Block,
+    /// Bytes of the backing allocation, header included
+    len: usize,
+    alignment: Alignment,
+
+    const header = std.mem.alignForward(usize, @sizeOf(Block), block_alignment.toByteUnits());
+
+    fn bytes(self: *Block) []u8 {
+        return @as([*]u8, @ptrCast(self))[0..self.len];
+    }
+};
+
+pub const Arena = struct {
+    backing: Allocator,
+    options: Options,
+    /// Blocks in use, newest first; allocations bump through the newest
+    blocks: ?*Block = null,
+    /// Offset of the next free byte in the newest block
+    offset: usize = 0,
+    /// Blocks retained by the last reset
+    spare: ?*Block = null,
+    spare_count: usize = 0,
+    /// Oversize allocations, released on reset
+    large: ?*Block = null,
+    stats: Stats = .{},
+
+    pub fn init(backing: Allocator, options: Options) Arena {
+        std.debug.assert(options.block_size > Block.header);
+        return .{ .backing = backing, .options = options };
+    }
+
+    pub fn deinit(self: *Arena) void {
+        self.release();
+        while (self.spare) |b| {
+            self.spare = b.next;
+            self.destroyBlock(b);
+        }
+        self.spare_count = 0;
+    }
+
+    pub fn allocator(self: *Arena) Allocator {
+        return .{ .ptr = self, .vtable = &vtable };
+    }
+
+    /// Drop everything allocated since the last reset. Call when the
+    /// connection closes.
+    pub fn reset(self: *Arena) void {
+        self.release();
+        self.stats.resets += 1;
+    }
+
+    fn release(self: *Arena) void {
+        while (self.large) |b| {
+            self.large = b.next;
+            self.backing.rawFree(b.bytes(), b.alignment, @returnAddress());
+        }
+        while (self.blocks) |b| {
+            self.blocks = b.next;
+            if (self.spare_count < self.options.retain_blocks) {
+                b.next = self.spare;
+                self.spare = b;
+                self.spare_count += 1;
+            } else {
+                self.destroyBlock(b);
+            }
+        }
+        self.offset = 0;
+        self.stats.used = 0;
+    }
+
+    fn destroyBlock(self: *Arena, b: *Block) void {
+        self.backing.rawFree(b.bytes(), block_alignment, @returnAddress());
+        self.stats.blocks -= 1;
+    }
+
+    /// Bump `len` bytes out of the newest block, if they fit.
+    fn bump(self: *Arena, len: usize, alignment: Alignment) ?[*]u8 {
+        const b = self.blocks orelse return null;
+        const base = @intFromPtr(b);
+        const start = std.mem.alignForward(usize, base + self.offset, alignment.toByteUnits());
+        if (start + len > base + b.len) return null;
+        self.offset = start + len - base;
+        return @ptrFromInt(start);
+    }
+
+    fn pushBlock(self: *Arena, ret_addr: usize) bool {
+        const b = if (self.spare) |s| blk: {
+            self.spare = s.next;
+            self.spare_count -= 1;
+            break :blk s;
+        } else blk: {
+            const mem = self.backing.rawAlloc(self.options.block_size, block_alignment, ret_addr) orelse return false;
+            const fresh: *Block = @ptrCast(@alignCast(mem));
+            fresh.len = self.options.block_size;
+            fresh.alignment = block_alignment;
+            self.stats.blocks += 1;
+            break :blk fresh;
+        };
+        b.next = self.blocks;
+        self.blocks = b;
+        self.offset = Block.header;
+        return true;
+    }
+
+    fn allocLarge(self: *Arena, len: usize, alignment: Alignment, ret_addr: usize) ?[*]u8 {
+        const a = Alignment.max(alignment, block_alignment);
+        const header = std.mem.alignForward(usize, Block.header, a.toByteUnits());
+        const mem = self.backing.rawAlloc(header + len, a, ret_addr) orelse return null;
+        const b: *Block = @ptrCast(@alignCast(mem));
+        b.* = .{ .next = self.large, .len = header + len, .alignment = a };
+        self.large = b;
+        return mem + header;
+    }
+
+    /// Whether `memory` is the most recent bump allocation
+    fn isLast(self: *const Arena, memory: []u8) bool {
+        const b = self.blocks orelse return false;
+        return @intFromPtr(memory.ptr) + memory.len == @intFromPtr(b) + self.offset;
+    }
+
+    fn addUsed(self: *Arena, delta: isize) void {
+        self.stats.used = @intCast(@as(isize, @intCast(self.stats.used)) + delta);
+        self.stats.peak = @max(self.stats.peak, self.stats.used);
+    }
+
+    // ========================================================================
+    // Allocator vtable
+    // ========================================================================
+
+    const vtable = Allocator.VTable{
+        .alloc = alloc,
+        .resize = resize,
+        .remap = remap,
+        .free = free,
+    };
+
+    fn alloc(ctx: *anyopaque, len: usize, alignment: Alignment, ret_addr: usize) ?[*]u8 {
+        const self: *Arena = @ptrCast(@alignCast(ctx));
+        const ptr = self.bump(len, alignment) orelse blk: {
+            const fits = Block.header + len + alignment.toByteUnits() - 1 <= self.options.block_size;
+            if (!fits) break :blk self.allocLarge(len, alignment, ret_addr) orelse return null;
+            if (!self.pushBlock(ret_addr)) return null;
+            break :blk self.bump(len, alignment).?;
+        };
+        self.addUsed(@intCast(len));
+        return ptr;
+    }
+
+    fn resize(ctx: *anyopaque, memory: []u8, alignment: Alignment, new_len: usize, ret_addr: usize) bool {
+        _ = alignment;
+        _ = ret_addr;
+        const self: *Arena = @ptrCast(@alignCast(ctx));
+        if (!self.isLast(memory)) return new_len <= memory.len;
+        const b = self.blocks.?;
+        const start = @intFromPtr(memory.ptr) - @intFromPtr(b);
+        if (start + new_len > b.len) return false;
+        self.offset = start + new_len;
+        self.addUsed(@as(isize, @intCast(new_len)) - @as(isize, @intCast(memory.len)));
+        return true;
+    }
+
+    fn remap(ctx: *anyopaque, memory: []u8, alignment: Alignment, new_len: usize, ret_addr: usize) ?[*]u8 {
+        return if (resize(ctx, memory, alignment, new_len, ret_addr)) memory.ptr else null;
+    }
+
+    fn free(ctx: *anyopaque, memory: []u8, alignment: Alignment, ret_addr: usize) void {
+        _ = alignment;
+        _ = ret_addr;
+        const self: *Arena = @ptrCast(@alignCast(ctx));
+        if (!self.isLast(memory)) return;
+        self.offset -= memory.len;
+        self.addUsed(-@as(isize, @intCast(memory.len)));
+    }
+};
+
+// ============================================================================
+// Tests
+// ============================================================================
+
+const testing = std.testing;
+
+test "bump allocations, rollback of the last one" {
+    var arena = Arena.init(testing.allocator, .{});
+    defer arena.deinit();
+    const a = arena.allocator();
+
+    const x = try a.alloc(u8, 10);
+    const y = try a.alloc(u32, 4);
+    try testing.expect(std.mem.isAligned(@intFromPtr(y.ptr), @alignOf(u32)));
+    try testing.expect(@intFromPtr(y.ptr) > @intFromPtr(x.ptr));
+
+    a.free(y);
+    const z = try a.alloc(u32, 4);
+    try testing.expectEqual(y.ptr, z.ptr);
+    try testing.expectEqual(@as(usize, 26), arena.stats.used);
+    try testing.expectEqual(@as(usize, 1), arena.stats.blocks);
+}
+
+test "growing the last allocation stays in place" {
+    var arena = Arena.init(testing.allocator, .{});
+    defer arena.deinit();
+
+    const a = arena.allocator();
+    var list: std.ArrayList(u8) = .empty;
+    for (0..1000) |i| try list.append(a, @truncate(i));
+    const first = list.items.ptr;
+    for (0..1000) |i| try list.append(a, @truncate(i));
+    try testing.expectEqual(first, list.items.ptr);
+    try testing.expectEqual(@as(usize, 1), arena.stats.blocks);
+}
+
+test "reset retains blocks for the next connection" {
+    var arena = Arena.init(testing.allocator, .{ .block_size = 1024, .retain_blocks = 2 });
+    defer arena.deinit();
+    const a = arena.allocator();
+
+    for (0..3) |_| _ = try a.alloc(u8, 900);
+    try testing.expectEqual(@as(usize, 3), arena.stats.blocks);
+
+    arena.reset();
+    try testing.expectEqual(@as(usize, 2), arena.stats.blocks);
+    try testing.expectEqual(@as(usize, 2), arena.spare_count);
+    try testing.expectEqual(@as(usize, 0), arena.stats.used);
+    try testing.expectEqual(@as(usize, 2700), arena.stats.peak);
+
+    _ = try a.alloc(u8, 900);
+    try testing.expectEqual(@as(usize, 2), arena.stats.blocks);
+    try testing.expectEqual(@as(usize, 1), arena.spare_count);
+    try testing.expectEqual(@as(usize, 1), arena.stats.resets);
+}
+
+test "oversize requests get their own allocation until reset" {
+    var arena = Arena.init(testing.allocator, .{ .block_size = 1024 });
+    defer arena.deinit();
+    const a = arena.allocator();
+
+    const big = try a.alloc(u8, 8192);
+    @memset(big, 1);
+    const aligned = a.rawAlloc(2000, .@"64", @returnAddress()).?;
+    try testing.expect(std.mem.isAligned(@intFromPtr(aligned), 64));
+    try testing.expectEqual(@as(usize, 0), arena.stats.blocks);
+    try testing.expectEqual(@as(usize, 10192), arena.stats.used);
+
+    arena.reset();
+    try testing.expectEqual(@as(?*Block, null), arena.large);
+}
+
+test "blocks from a slab are recycled between connections" {
+    const slab_mod = @import("slab.zig");
+    const S = slab_mod.Slab(slab_mod.NoLock, .{});
+    var slab = S.init(testing.allocator);
+    defer slab.deinit();
+
+    var conns: [4]Arena = undefined;
+    for (&conns) |*c| c.* = Arena.init(slab.allocator(), .{ .retain_blocks = 0 });
+    defer for (&conns) |*c| c.deinit();
+
+    for (0..50) |round| {
+        for (&conns) |*c| {
+            const a = c.allocator();
+            for (0..20) |i| _ = try a.alloc(u8, 16 + (round + i) % 300);
+        }
+        for (&conns) |*c| c.reset();
+    }
+    const s = slab.stats(S.classOf(4096, .@"16").?);
+    try testing.expectEqual(@as(usize, 0), s.live);
+    try testing.expect(s.peak <= 8);
+    try testing.expectEqual(@as(usize, 1), s.slabs);
+}
@@ -0,0 +1,43 @@
+//! Connection Memory Pools
+//!
+//! Allocators for servers that open and close many connections:
+//!
+//! - `Slab` — size-class allocator shared by all connections. Recycles
+//!   fixed-size buffers (PacketBuffers, request/response buffers) through
+//!   per-class free lists instead of going back to the general-purpose heap.
+//! - `Arena` — one per connection (or per handler). Bump-allocates what the
+//!   connection needs and drops it all with `reset` when it closes.
+//!
+//! Both are plain `std.mem.Allocator`s, so http.Server, mqtt0.Broker and
+//! the BLE host adopt them through the allocator they already take:
+//!
+//! ```zig
+//! var slab = pool.Slab(Rt.Mutex, .{}).init(std.heap.page_allocator);
+//! defer slab.deinit();
+//! const server = HttpServer.init(slab.allocator(), &routes);
+//!
+//! // in the connection handler
+//! var arena = pool.Arena.init(slab.allocator(), .{});
+//! defer arena.deinit();
+//! while (conn.next()) |msg| {
+//!     try handle(arena.allocator(), msg);
+//! }
+//! arena.reset();
+//! ```
+
+pub const slab = @import("slab.zig");
+pub const arena = @import("arena.zig");
+
+pub const Slab = slab.Slab;
+pub const SlabConfig = slab.Config;
+pub const ClassStats = slab.ClassStats;
+pub const NoLock = slab.NoLock;
+
+pub const Arena = arena.Arena;
+pub const ArenaOptions = arena.Options;
+pub const ArenaStats = arena.Stats;
+
+test {
+    _ = slab;
+    _ = arena;
+}
@@ -0,0 +1,380 @@
+//! Size-Class Slab Allocator
+//!
+//! Serves the fixed-size objects a server allocates per connection —
+//! PacketBuffers, request/response buffers, handler contexts — from
+//! power-of-two size classes carved out of `slab_bytes` chunks taken from a
+//! parent allocator. A freed object goes onto its class's intrusive free
+//! list and is handed to the next allocation of that class, so connection
+//! churn recycles the same memory instead of fragmenting the parent heap.
+//!
+//! - Requests larger than `max_size`, or aligned beyond `max_alignment`,
+//!   pass straight through to the parent.
+//! - `resize`/`remap` succeed in place while the new length stays in the
+//!   same class; crossing classes makes `realloc` move the object.
+//! - Slabs are kept until `deinit`, so the footprint is the high-water
+//!   mark of each class.
+//! - One `Mutex` guards the allocator. Servers with a worker per core can
+//!   give each worker its own `Slab(NoLock, ...)` instead.
+//!
+//! ```zig
+//! var slab = pool.Slab(Rt.Mutex, .{}).init(std.heap.page_allocator);
+//! defer slab.deinit();
+//! var broker = try Broker.init(slab.allocator(), &mux, .{});
+//! ```
+
+const std = @import("std");
+const trait = @import("trait");
+
+const Allocator = std.mem.Allocator;
+const Alignment = std.mem.Alignment;
+
+/// Alignment of every slab; objects of 64 bytes and up inherit it
+const slab_alignment: Alignment = .@"64";
+/// Slab header, padded so the first object keeps the slab alignment
+const header_bytes = 64;
+
+pub const Config = struct {
+    /// Smallest class; must hold a free-list pointer
+    min_size: usize = 32,
+    /// Largest class; bigger requests go to the parent
+    max_size: usize = 16 * 1024,
+    /// Object bytes per slab (the parent is asked for this plus a header)
+    slab_bytes: usize = 64 * 1024,
+};
+
+/// Lock for allocators owned by a single thread
+pub const NoLock = struct {
+    pub fn init() NoLock {
+        return .{};
+    }
+    pub fn deinit(_: *NoLock) void {}
+    pub fn lock(_: *NoLock) void {}
+    pub fn unlock(_: *NoLock) void {}
+};
+
+/// Per-class counters
+pub const ClassStats = struct {
+    /// Object size of the class
+    size: usize = 0,
+    /// Objects handed out and not yet freed
+    live: usize = 0,
+    /// Most objects live at once
+    peak: usize = 0,
+    /// Slabs carved for this class
+    slabs: usize = 0,
+};
+
+pub fn Slab(comptime Mutex: type, comptime config: Config) type {
+    _ = trait.sync.Mutex(Mutex);
+    comptime {
+        std.debug.assert(std.math.isPowerOfTwo(config.min_size) and config.min_size >= @sizeOf(usize));
+        std.debug.assert(std.math.isPowerOfTwo(config.max_size) and config.max_size >= config.min_size);
+        std.debug.assert(config.slab_bytes >= config.max_size);
+    }
+    const min_shift = std.math.log2_int(usize, config.min_size);
+    const class_count = std.math.log2_int(usize, config.max_size) - min_shift + 1;
+
+    return struct {
+        const Self = @This();
+
+        pub const classes = class_count;
+        /// Strongest alignment served from a slab
+        pub const max_alignment = slab_alignment.toByteUnits();
+
+        const Node = struct { next: ?*Node };
+
+        /// Slabs are chained through their header for `deinit`
+        const SlabHeader = struct { next: ?*SlabHeader };
+
+        const Class = struct {
+            free: ?*Node = null,
+            /// Uncarved remainder of the newest slab of this class
+            bump: usize = 0,
+            end: usize = 0,
+            stats: ClassStats = .{},
+        };
+
+        parent: Allocator,
+        mutex: Mutex,
+        class: [class_count]Class,
+        slabs: ?*SlabHeader = null,
+        /// Live pass-through allocations and their bytes
+        large_live: usize = 0,
+        large_bytes: usize = 0,
+
+        pub fn init(parent: Allocator) Self {
+            var self = Self{
+                .parent = parent,
+                .mutex = Mutex.init(),
+                .class = [_]Class{.{}} ** class_count,
+            };
+            for (&self.class, 0..) |*c, i| c.stats.size = classSize(i);
+            return self;
+        }
+
+        /// Return every slab to the parent. Pass-through allocations that
+        /// are still live are the caller's leak, not released here.
+        pub fn deinit(self: *Self) void {
+            while (self.slabs) |s| {
+                self.slabs = s.next;
+                const mem: [*]u8 = @ptrCast(s);
+                self.parent.rawFree(mem[0 .. header_bytes + config.slab_bytes], slab_alignment, @returnAddress());
+            }
+            self.mutex.deinit();
+        }
+
+        pub fn allocator(self: *Self) Allocator {
+            return .{ .ptr = self, .vtable = &vtable };
+        }
+
+        pub fn classSize(index: usize) usize {
+            return config.min_size << @intCast(index);
+        }
+
+        /// Class serving `len` bytes at `alignment`, or null for pass-through.
+        pub fn classOf(len: usize, alignment: Alignment) ?usize {
+            const align_bytes = alignment.toByteUnits();
+            if (align_bytes > max_alignment) return null;
+            const need = @max(len, align_bytes, config.min_size);
+            if (need > config.max_size) return null;
+            return std.math.log2_int_ceil(usize, need) - min_shift;
+        }
+
+        pub fn stats(self: *Self, index: usize) ClassStats {
+            self.mutex.lock();
+            defer self.mutex.unlock();
+            return self.class[index].stats;
+        }
+
+        /// Bytes held from the parent, slabs and pass-through together
+        pub fn footprint(self: *Self) usize {
+            self.mutex.lock();
+            defer self.mutex.unlock();
+            var slabs: usize = 0;
+            for (self.class) |c| slabs += c.stats.slabs;
+            return slabs * (header_bytes + config.slab_bytes) + self.large_bytes;
+        }
+
+        // ====================================================================
+        // Allocator vtable
+        // ====================================================================
+
+        const vtable = Allocator.VTable{
+            .alloc = alloc,
+            .resize = resize,
+            .remap = remap,
+            .free = free,
+        };
+
+        fn alloc(ctx: *anyopaque, len: usize, alignment: Alignment, ret_addr: usize) ?[*]u8 {
+            const self: *Self = @ptrCast(@alignCast(ctx));
+            const index = classOf(len, alignment) orelse return self.allocLarge(len, alignment, ret_addr);
+
+            self.mutex.lock();
+            defer self.mutex.unlock();
+            const c = &self.class[index];
+            const ptr: [*]u8 = if (c.free) |node| blk: {
+                c.free = node.next;
+                break :blk @ptrCast(node);
+            } else self.carve(c) orelse return null;
+            c.stats.live += 1;
+            c.stats.peak = @max(c.stats.peak, c.stats.live);
+            return ptr;
+        }
+
+        /// Take the next object from the class's newest slab, starting a
+        /// new slab when it is used up. Caller holds the mutex.
+        fn carve(self: *Self, c: *Class) ?[*]u8 {
+            const size = c.stats.size;
+            if (c.end - c.bump < size) {
+                const mem = self.parent.rawAlloc(header_bytes + config.slab_bytes, slab_alignment, @returnAddress()) orelse return null;
+                const header: *SlabHeader = @ptrCast(@alignCast(mem));
+                header.next = self.slabs;
+                self.slabs = header;
+                c.bump = @intFromPtr(mem) + header_bytes;
+                c.end = c.bump + config.slab_bytes;
+                c.stats.slabs += 1;
+            }
+            const ptr: [*]u8 = @ptrFromInt(c.bump);
+            c.bump += size;
+            return ptr;
+        }
+
+        fn allocLarge(self: *Self, len: usize, alignment: Alignment, ret_addr: usize) ?[*]u8 {
+            const ptr = self.parent.rawAlloc(len, alignment, ret_addr) orelse return null;
+            self.mutex.lock();
+            defer self.mutex.unlock();
+            self.large_live += 1;
+            self.large_bytes += len;
+            return ptr;
+        }
+
+        fn resize(ctx: *anyopaque, memory: []u8, alignment: Alignment, new_len: usize, ret_addr: usize) bool {
+            const self: *Self = @ptrCast(@alignCast(ctx));
+            const new_class = classOf(new_len, alignment);
+            if (classOf(memory.len, alignment)) |old| return new_class == old;
+            if (new_class != null) return false;
+            if (!self.parent.rawResize(memory, alignment, new_len, ret_addr)) return false;
+            self.largeResized(memory.len, new_len);
+            return true;
+        }
+
+        fn remap(ctx: *anyopaque, memory: []u8, alignment: Alignment, new_len: usize, ret_addr: usize) ?[*]u8 {
+            const self: *Self = @ptrCast(@alignCast(ctx));
+            const new_class = classOf(new_len, alignment);
+            if (classOf(memory.len, alignment)) |old| return if (new_class == old) memory.ptr else null;
+            if (new_class != null) return null;
+            const ptr = self.parent.rawRemap(memory, alignment, new_len, ret_addr) orelse return null;
+            self.largeResized(memory.len, new_len);
+            return ptr;
+        }
+
+        fn largeResized(self: *Self, old_len: usize, new_len: usize) void {
+            self.mutex.lock();
+            defer self.mutex.unlock();
+            self.large_bytes = self.large_bytes - old_len + new_len;
+        }
+
+        fn free(ctx: *anyopaque, memory: []u8, alignment: Alignment, ret_addr: usize) void {
+            const self: *Self = @ptrCast(@alignCast(ctx));
+            const index = classOf(memory.len, alignment) orelse {
+                self.parent.rawFree(memory, alignment, ret_addr);
+                self.mutex.lock();
+                defer self.mutex.unlock();
+                self.large_live -= 1;
+                self.large_bytes -= memory.len;
+                return;
+            };
+
+            self.mutex.lock();
+            defer self.mutex.unlock();
+            const c = &self.class[index];
+            const node: *Node = @ptrCast(@alignCast(memory.ptr));
+            node.next = c.free;
+            c.free = node;
+            c.stats.live -= 1;
+        }
+    };
+}
+
+// ============================================================================
+// Tests
+// ============================================================================
+
+const testing = std.testing;
+
+test "class selection" {
+    const S = Slab(NoLock, .{});
+    try testing.expectEqual(@as(usize, 10), S.classes);
+    try testing.expectEqual(@as(?usize, 0), S.classOf(1, .@"1"));
+    try testing.expectEqual(@as(?usize, 0), S.classOf(32, .@"8"));
+    try testing.expectEqual(@as(?usize, 1), S.classOf(33, .@"8"));
+    try testing.expectEqual(@as(?usize, 1), S.classOf(8, .@"64"));
+    try testing.expectEqual(@as(?usize, 9), S.classOf(16 * 1024, .@"16"));
+    try testing.expectEqual(@as(?usize, null), S.classOf(16 * 1024 + 1, .@"16"));
+    try testing.expectEqual(@as(?usize, null), S.classOf(64, Alignment.fromByteUnits(128)));
+}
+
+test "freed objects are reused by the next allocation of the class" {
+    var slab = Slab(NoLock, .{}).init(testing.allocator);
+    defer slab.deinit();
+    const a = slab.allocator();
+
+    const first = try a.alloc(u8, 100);
+    const other = try a.alloc(u8, 100);
+    try testing.expect(first.ptr != other.ptr);
+    a.free(first);
+    const again = try a.alloc(u8, 120);
+    try testing.expectEqual(first.ptr, again.ptr);
+    a.free(again);
+    a.free(other);
+
+    const s = slab.stats(Slab(NoLock, .{}).classOf(100, .@"1").?);
+    try testing.expectEqual(@as(usize, 128), s.size);
+    try testing.expectEqual(@as(usize, 0), s.live);
+    try testing.expectEqual(@as(usize, 2), s.peak);
+    try testing.expectEqual(@as(usize, 1), s.slabs);
+}
+
+test "objects are aligned and slabs fill before a new one is taken" {
+    const S = Slab(NoLock, .{ .max_size = 1024, .slab_bytes = 4096 });
+    var slab = S.init(testing.allocator);
+    defer slab.deinit();
+    const a = slab.allocator();
+
+    var objs: [5][]u8 = undefined;
+    for (&objs) |*o| {
+        const ptr = a.rawAlloc(1000, .@"64", @returnAddress()).?;
+        try testing.expect(std.mem.isAligned(@intFromPtr(ptr), 64));
+        o.* = ptr[0..1000];
+    }
+    try testing.expectEqual(@as(usize, 2), slab.stats(S.classOf(1000, .@"1").?).slabs);
+    for (objs) |o| a.rawFree(o, .@"64", @returnAddress());
+}
+
+test "resize stays in place within a class and realloc moves across" {
+    var slab = Slab(NoLock, .{}).init(testing.allocator);
+    defer slab.deinit();
+    const a = slab.allocator();
+
+    var buf = try a.alloc(u8, 40);
+    try testing.expect(a.resize(buf, 64));
+    buf = buf.ptr[0..64];
+    try testing.expect(!a.resize(buf, 65));
+    try testing.expect(!a.resize(buf, 16));
+
+    @memset(buf, 0xAB);
+    buf = try a.realloc(buf, 300);
+    try testing.expectEqual(@as(u8, 0xAB), buf[63]);
+    a.free(buf);
+}
+
+test "large requests pass through to the parent" {
+    var slab = Slab(NoLock, .{}).init(testing.allocator);
+    defer slab.deinit();
+    const a = slab.allocator();
+
+    const big = try a.alloc(u8, 64 * 1024);
+    try testing.expectEqual(@as(usize, 1), slab.large_live);
+    try testing.expectEqual(@as(usize, 64 * 1024), slab.footprint());
+    a.free(big);
+    try testing.expectEqual(@as(usize, 0), slab.large_bytes);
+
+    var list: std.ArrayList(u32) = .empty;
+    defer list.deinit(a);
+    for (0..10_000) |i| try list.append(a, @intCast(i));
+    try testing.expectEqual(@as(u32, 9_999), list.items[9_999]);
+}
+
+test "shared between threads" {
+    const std_impl = @import("std_impl");
+    var slab = Slab(std_impl.runtime.Mutex, .{}).init(testing.allocator);
+    defer slab.deinit();
+
+    const Worker = struct {
+        fn run(a: Allocator, seed: u64) void {
+            var prng = std.Random.DefaultPrng.init(seed);
+            const r = prng.random();
+            var live: [32]?[]u8 = .{null} ** 32;
+            for (0..20_000) |_| {
+                const slot = &live[r.uintLessThan(usize, live.len)];
+                if (slot.*) |buf| {
+                    std.debug.assert(buf[0] == @as(u8, @truncate(buf.len)));
+                    a.free(buf);
+                    slot.* = null;
+                } else {
+                    const buf = a.alloc(u8, 1 + r.uintLessThan(usize, 4096)) catch return;
+                    buf[0] = @truncate(buf.len);
+                    slot.* = buf;
+                }
+            }
+            for (live) |l| if (l) |buf| a.free(buf);
+        }
+    };
+
+    var threads: [4]std.Thread = undefined;
+    for (&threads, 0..) |*t, i| t.* = try std.Thread.spawn(.{}, Worker.run, .{ slab.allocator(), i });
+    for (threads) |t| t.join();
+
+    for (0..@TypeOf(slab).classes) |i| try testing.expectEqual(@as(usize, 0), slab.stats(i).live);
+}
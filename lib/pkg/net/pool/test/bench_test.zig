@@ -0,0 +1,312 @@
+//! Connection-churn benchmark for the pool allocators.
+//!
+//! Models a server with 256 connection slots. Each operation picks a slot
+//! and opens a connection there (read 8 KiB, write 4 KiB, out 4 KiB, as
+//! http.Server does), adds a per-message object of 24..512 bytes to an
+//! open connection (contexts, topic aliases), or closes it.
+//!
+//!   BM1: latency of open / message / close, p50 and p99, single thread
+//!   BM2: RSS growth under sustained churn, each strategy in a fresh
+//!        child process (Linux only)
+//!   BM3: throughput with 4 server threads: one shared allocator vs a
+//!        locked shared Slab vs a Slab per thread
+//!
+//! Strategies:
+//!   smp         everything through std.heap.smp_allocator
+//!   gpa         everything through GeneralPurposeAllocator
+//!   slab        everything through a Slab over page_allocator
+//!   slab+arena  buffers from the Slab, messages from a per-connection
+//!               Arena backed by the same Slab, reset on close
+
+const std = @import("std");
+const builtin = @import("builtin");
+const pool = @import("pool");
+const std_impl = @import("std_impl");
+const print = std.debug.print;
+const testing = std.testing;
+const Allocator = std.mem.Allocator;
+
+const SLOTS = 256;
+const OPS = 300_000;
+const MSGS = 24;
+const THREADS = 4;
+
+const buf_sizes = [_]usize{ 8192, 4096, 4096 };
+const msg_sizes = [_]usize{ 24, 40, 64, 96, 128, 200, 320, 512 };
+
+const LocalSlab = pool.Slab(pool.NoLock, .{});
+const SharedSlab = pool.Slab(std_impl.runtime.Mutex, .{});
+
+const Conn = struct {
+    open: bool = false,
+    bufs: [buf_sizes.len][]u8 = undefined,
+    msgs: [MSGS][]u8 = undefined,
+    n: usize = 0,
+    arena: pool.Arena = undefined,
+};
+
+const Op = enum { open, message, close };
+
+/// Slots plus the allocator(s) they draw from.
+const Server = struct {
+    shared: Allocator,
+    use_arena: bool,
+    conns: []Conn,
+
+    fn init(backing: Allocator, shared: Allocator, use_arena: bool) !Server {
+        const conns = try backing.alloc(Conn, SLOTS);
+        for (conns) |*c| {
+            c.* = .{};
+            if (use_arena) c.arena = pool.Arena.init(shared, .{});
+        }
+        return .{ .shared = shared, .use_arena = use_arena, .conns = conns };
+    }
+
+    fn deinit(self: *Server, backing: Allocator) void {
+        for (self.conns) |*c| {
+            if (c.open) self.close(c);
+            if (self.use_arena) c.arena.deinit();
+        }
+        backing.free(self.conns);
+    }
+
+    fn pick(self: *Server, r: std.Random) struct { *Conn, Op } {
+        const c = &self.conns[r.uintLessThan(usize, SLOTS)];
+        if (!c.open) return .{ c, .open };
+        if (c.n < MSGS and r.uintLessThan(u8, 4) != 0) return .{ c, .message };
+        return .{ c, .close };
+    }
+
+    fn run(self: *Server, c: *Conn, op: Op, r: std.Random) !void {
+        switch (op) {
+            .open => {
+                for (&c.bufs, buf_sizes) |*b, size| {
+                    b.* = try self.shared.alloc(u8, size);
+                    b.*[0] = 1;
+                }
+                c.open = true;
+            },
+            .message => {
+                const a = if (self.use_arena) c.arena.allocator() else self.shared;
+                const m = try a.alloc(u8, msg_sizes[r.uintLessThan(usize, msg_sizes.len)]);
+                m[0] = 1;
+                c.msgs[c.n] = m;
+                c.n += 1;
+            },
+            .close => self.close(c),
+        }
+    }
+
+    fn close(self: *Server, c: *Conn) void {
+        for (c.bufs) |b| self.shared.free(b);
+        if (self.use_arena) {
+            c.arena.reset();
+        } else {
+            for (c.msgs[0..c.n]) |m| self.shared.free(m);
+        }
+        c.n = 0;
+        c.open = false;
+    }
+};
+
+const Strategy = enum { smp, gpa, slab, @"slab+arena" };
+
+/// Run `body(server, args)` with the strategy's allocators set up.
+fn withStrategy(strategy: Strategy, body: anytype, args: anytype) !void {
+    const backing = std.heap.page_allocator;
+    switch (strategy) {
+        .smp => {
+            var server = try Server.init(backing, std.heap.smp_allocator, false);
+            defer server.deinit(backing);
+            try @call(.auto, body, .{&server} ++ args);
+        },
+        .gpa => {
+            var gpa = std.heap.GeneralPurposeAllocator(.{}){};
+            defer _ = gpa.deinit();
+            var server = try Server.init(backing, gpa.allocator(), false);
+            defer server.deinit(backing);
+            try @call(.auto, body, .{&server} ++ args);
+        },
+        .slab, .@"slab+arena" => {
+            var slab = LocalSlab.init(backing);
+            defer slab.deinit();
+            var server = try Server.init(backing, slab.allocator(), strategy == .@"slab+arena");
+            defer server.deinit(backing);
+            try @call(.auto, body, .{&server} ++ args);
+        },
+    }
+}
+
+// ============================================================================
+// BM1: latency
+// ============================================================================
+
+const Samples = struct {
+    allocator: Allocator,
+    ns: [3]std.ArrayList(u32),
+
+    fn init(a: Allocator) !Samples {
+        var s: Samples = .{ .allocator = a, .ns = undefined };
+        for (&s.ns) |*l| l.* = try std.ArrayList(u32).initCapacity(a, OPS);
+        return s;
+    }
+
+    fn deinit(self: *Samples) void {
+        for (&self.ns) |*l| l.deinit(self.allocator);
+    }
+
+    fn percentile(self: *Samples, op: Op, p: usize) u32 {
+        const items = self.ns[@intFromEnum(op)].items;
+        if (items.len == 0) return 0;
+        std.mem.sort(u32, items, {}, std.sort.asc(u32));
+        return items[@min(items.len - 1, items.len * p / 100)];
+    }
+};
+
+fn timedChurn(server: *Server, samples: *Samples) !void {
+    var prng = std.Random.DefaultPrng.init(0xC0FFEE);
+    const r = prng.random();
+    for (0..OPS) |_| {
+        const c, const op = server.pick(r);
+        var timer = try std.time.Timer.start();
+        try server.run(c, op, r);
+        samples.ns[@intFromEnum(op)].appendAssumeCapacity(@intCast(@min(timer.read(), std.math.maxInt(u32))));
+    }
+}
+
+test "BM1: allocation latency under connection churn" {
+    print("\n[bench] connection churn, {d} slots, {d} ops (ns per operation)\n", .{ SLOTS, OPS });
+    print("[bench]   {s:<12} {s:>10} {s:>10} {s:>10} {s:>10} {s:>10} {s:>10}\n", .{
+        "strategy", "open p50", "open p99", "msg p50", "msg p99", "close p50", "close p99",
+    });
+    for ([_]Strategy{ .smp, .gpa, .slab, .@"slab+arena" }) |strategy| {
+        var samples = try Samples.init(std.heap.page_allocator);
+        defer samples.deinit();
+        // One warm-up pass so every strategy starts from a populated heap
+        var warm = try Samples.init(std.heap.page_allocator);
+        defer warm.deinit();
+        try withStrategy(strategy, timedChurn, .{&warm});
+        try withStrategy(strategy, timedChurn, .{&samples});
+
+        print("[bench]   {s:<12} {d:>10} {d:>10} {d:>10} {d:>10} {d:>10} {d:>10}\n", .{
+            @tagName(strategy),
+            samples.percentile(.open, 50),
+            samples.percentile(.open, 99),
+            samples.percentile(.message, 50),
+            samples.percentile(.message, 99),
+            samples.percentile(.close, 50),
+            samples.percentile(.close, 99),
+        });
+    }
+}
+
+// ============================================================================
+// BM2: RSS growth
+// ============================================================================
+
+const RSS_ROUNDS = 20;
+
+fn rssKiB() !u64 {
+    var buf: [4096]u8 = undefined;
+    const status = try std.fs.cwd().readFile("/proc/self/status", &buf);
+    var lines = std.mem.tokenizeScalar(u8, status, '\n');
+    while (lines.next()) |line| {
+        if (!std.mem.startsWith(u8, line, "VmRSS:")) continue;
+        var fields = std.mem.tokenizeAny(u8, line["VmRSS:".len..], " \tkB");
+        return std.fmt.parseInt(u64, fields.next() orelse return error.BadStatus, 10);
+    }
+    return error.BadStatus;
+}
+
+/// Churn for RSS_ROUNDS × OPS operations, recording RSS after the first
+/// round and after the last.
+fn rssChurn(server: *Server, out: *[2]u64) !void {
+    var prng = std.Random.DefaultPrng.init(0xBEEF);
+    const r = prng.random();
+    for (0..RSS_ROUNDS) |round| {
+        for (0..OPS) |_| {
+            const c, const op = server.pick(r);
+            try server.run(c, op, r);
+        }
+        if (round == 0) out[0] = try rssKiB();
+    }
+    out[1] = try rssKiB();
+}
+
+/// Run one strategy in a forked child so each starts from a clean heap.
+fn measureRss(strategy: Strategy) ![3]u64 {
+    const fds = try std.posix.pipe();
+    const pid = try std.posix.fork();
+    if (pid == 0) {
+        std.posix.close(fds[0]);
+        var result = [3]u64{ 0, 0, 0 };
+        result[0] = rssKiB() catch 0;
+        var after: [2]u64 = .{ 0, 0 };
+        withStrategy(strategy, rssChurn, .{&after}) catch {};
+        result[1] = after[0];
+        result[2] = after[1];
+        _ = std.posix.write(fds[1], std.mem.asBytes(&result)) catch {};
+        std.posix.exit(0);
+    }
+    std.posix.close(fds[1]);
+    defer std.posix.close(fds[0]);
+    var result: [3]u64 = undefined;
+    const n = try std.posix.read(fds[0], std.mem.asBytes(&result));
+    _ = std.posix.waitpid(pid, 0);
+    if (n != @sizeOf([3]u64)) return error.ChildFailed;
+    return result;
+}
+
+test "BM2: RSS growth under sustained churn" {
+    if (builtin.os.tag != .linux) return error.SkipZigTest;
+
+    print("\n[bench] RSS over {d} rounds of {d} ops (KiB)\n", .{ RSS_ROUNDS, OPS });
+    print("[bench]   {s:<12} {s:>10} {s:>10} {s:>10} {s:>12}\n", .{ "strategy", "start", "round 1", "final", "growth 1..N" });
+    for ([_]Strategy{ .smp, .gpa, .slab, .@"slab+arena" }) |strategy| {
+        const rss = try measureRss(strategy);
+        print("[bench]   {s:<12} {d:>10} {d:>10} {d:>10} {d:>12}\n", .{
+            @tagName(strategy), rss[0], rss[1], rss[2], @as(i64, @intCast(rss[2])) - @as(i64, @intCast(rss[1])),
+        });
+    }
+}
+
+// ============================================================================
+// BM3: threads
+// ============================================================================
+
+fn worker(shared: ?Allocator, seed: u64) void {
+    const backing = std.heap.page_allocator;
+    var local = LocalSlab.init(backing);
+    defer local.deinit();
+    var server = Server.init(backing, shared orelse local.allocator(), shared == null) catch return;
+    defer server.deinit(backing);
+
+    var prng = std.Random.DefaultPrng.init(seed);
+    const r = prng.random();
+    for (0..OPS / THREADS) |_| {
+        const c, const op = server.pick(r);
+        server.run(c, op, r) catch return;
+    }
+}
+
+fn timeThreads(shared: ?Allocator) !f64 {
+    var timer = try std.time.Timer.start();
+    var threads: [THREADS]std.Thread = undefined;
+    for (&threads, 0..) |*t, i| t.* = try std.Thread.spawn(.{}, worker, .{ shared, i });
+    for (threads) |t| t.join();
+    const secs = @as(f64, @floatFromInt(@max(timer.read(), 1))) / 1e9;
+    return @as(f64, OPS) / secs;
+}
+
+test "BM3: four server threads" {
+    var slab = SharedSlab.init(std.heap.page_allocator);
+    defer slab.deinit();
+
+    print("\n[bench] {d} threads x {d} slots, {d} ops total\n", .{ THREADS, SLOTS, OPS });
+    _ = try timeThreads(std.heap.smp_allocator);
+    print("[bench]   {s:<26} {d:>12.0} ops/s\n", .{ "smp_allocator, shared", try timeThreads(std.heap.smp_allocator) });
+    print("[bench]   {s:<26} {d:>12.0} ops/s\n", .{ "Slab(Mutex), shared", try timeThreads(slab.allocator()) });
+    print("[bench]   {s:<26} {d:>12.0} ops/s\n", .{ "Slab(NoLock)+Arena/thread", try timeThreads(null) });
+
+    for (0..SharedSlab.classes) |i| try testing.expectEqual(@as(usize, 0), slab.stats(i).live);
+}
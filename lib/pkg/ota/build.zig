@@ -0,0 +1,44 @@
+const std = @import("std");
+
+pub fn build(b: *std.Build) void {
+    const target = b.standardTargetOptions(.{});
+    const optimize = b.standardOptimizeOption(.{});
+
+    const trait_dep = b.dependency("trait", .{
+        .target = target,
+        .optimize = optimize,
+    });
+
+    // Module
+    const ota_mod = b.addModule("ota", .{
+        .root_source_file = b.path("src/ota.zig"),
+        .target = target,
+        .optimize = optimize,
+    });
+    ota_mod.addImport("trait", trait_dep.module("trait"));
+
+    // Test-only dependencies: host fs driver and std.crypto suite
+    const crypto_dep = b.dependency("crypto", .{
+        .target = target,
+        .optimize = optimize,
+    });
+    const std_impl_dep = b.dependency("std_impl", .{
+        .target = target,
+        .optimize = optimize,
+    });
+
+    // Tests
+    const test_step = b.step("test", "Run ota tests");
+    const tests = b.addTest(.{
+        .root_module = b.createModule(.{
+            .root_source_file = b.path("src/ota.zig"),
+            .target = target,
+            .optimize = optimize,
+        }),
+    });
+    tests.root_module.addImport("trait", trait_dep.module("trait"));
+    tests.root_module.addImport("crypto", crypto_dep.module("crypto"));
+    tests.root_module.addImport("std_impl", std_impl_dep.module("std_impl"));
+    const run_tests = b.addRunArtifact(tests);
+    test_step.dependOn(&run_tests.step);
+}
@@ -0,0 +1,456 @@
+//! Binary delta patches
+//!
+//! A patch rebuilds a target image from a source image (the running
+//! slot) with three operations:
+//!
+//!   COPY   len, src_off          out = src[src_off..][0..len]
+//!   INSERT len, bytes[len]       out = bytes
+//!   ADD    len, src_off, d[len]  out[i] = src[src_off + i] +% d[i]
+//!
+//! ADD is the bsdiff trick: a rebuilt firmware moves code around, so most
+//! of a "changed" region differs from the old one only in relocated
+//! addresses. The byte-wise difference is mostly zeros and compresses
+//! well on the wire.
+//!
+//! Wire format (little-endian):
+//!
+//!   header  "ZDP1" | flags u32 | source_size u64 | target_size u64
+//!   op      tag u8 | len u32 | [src_off u64]  (COPY/ADD)  | [bytes]
+//!
+//! `Patcher` applies a patch as it streams in: RAM use is the patcher
+//! itself (~64 bytes) plus a caller-provided scratch buffer for source
+//! reads, independent of image size. Its whole state is plain data so
+//! `ota.Engine` can journal it and resume mid-operation after power loss.
+//!
+//! `encode` builds patches on the host (allocating, not for devices).
+
+const std = @import("std");
+const trait = @import("trait");
+
+pub const magic = "ZDP1";
+pub const header_len = 24;
+
+pub const Op = enum(u8) {
+    copy = 1,
+    insert = 2,
+    add = 3,
+
+    fn headerLen(self: Op) usize {
+        return switch (self) {
+            .insert => 5,
+            .copy, .add => 13,
+        };
+    }
+};
+
+pub const Error = error{
+    /// Malformed patch, or an op reaching outside source/target bounds
+    Corrupt,
+    /// Patch was built for a source of a different size
+    SourceMismatch,
+    /// Output rejected by the sink
+    WriteFailed,
+    /// Source read came back short
+    ReadFailed,
+};
+
+/// Receives rebuilt target bytes, in order.
+pub const Output = struct {
+    ctx: *anyopaque,
+    writeFn: *const fn (ctx: *anyopaque, bytes: []const u8) bool,
+
+    pub fn write(self: Output, bytes: []const u8) bool {
+        return self.writeFn(self.ctx, bytes);
+    }
+};
+
+/// Streaming patch applier.
+pub const Patcher = struct {
+    pub const Phase = enum(u8) { header, op, copy, insert, add, done };
+
+    phase: Phase = .header,
+    /// Partially received header bytes
+    pend_len: u8 = 0,
+    pend: [header_len]u8 = undefined,
+    /// Bytes left in the current op
+    remaining: u32 = 0,
+    /// Source offset of the current COPY/ADD
+    src_off: u64 = 0,
+    source_size: u64 = 0,
+    target_size: u64 = 0,
+    /// Target bytes produced so far
+    out_off: u64 = 0,
+
+    /// Feed the next patch bytes. `source` must support pread (the running
+    /// slot); `scratch` bounds every source read.
+    pub fn feed(
+        self: *Patcher,
+        input: []const u8,
+        source: *trait.fs.File,
+        scratch: []u8,
+        out: Output,
+    ) Error!void {
+        var in = input;
+        while (true) {
+            switch (self.phase) {
+                .header => {
+                    if (in.len == 0) return;
+                    in = self.gather(in, header_len);
+                    if (self.pend_len < header_len) return;
+                    try self.parseHeader(source.size);
+                },
+                .op => {
+                    if (in.len == 0) return;
+                    const tag = if (self.pend_len > 0) self.pend[0] else in[0];
+                    const op = std.meta.intToEnum(Op, tag) catch return error.Corrupt;
+                    in = self.gather(in, op.headerLen());
+                    if (self.pend_len < op.headerLen()) return;
+                    try self.parseOp(op);
+                },
+                .copy => {
+                    // COPY takes no input: drain it before returning so the
+                    // output position is final once the last patch byte is fed
+                    while (self.remaining > 0) {
+                        const n = @min(self.remaining, scratch.len);
+                        try self.readSource(source, scratch[0..n]);
+                        try self.emit(out, scratch[0..n]);
+                    }
+                    self.nextOp();
+                },
+                .insert => {
+                    if (in.len == 0) return;
+                    const n = @min(self.remaining, in.len);
+                    try self.emit(out, in[0..n]);
+                    in = in[n..];
+                    if (self.remaining == 0) self.nextOp();
+                },
+                .add => {
+                    if (in.len == 0) return;
+                    const n = @min(self.remaining, in.len, scratch.len);
+                    const buf = scratch[0..n];
+                    try self.readSource(source, buf);
+                    for (buf, in[0..n]) |*b, d| b.* +%= d;
+                    try self.emit(out, buf);
+                    in = in[n..];
+                    if (self.remaining == 0) self.nextOp();
+                },
+                .done => {
+                    if (in.len > 0) return error.Corrupt;
+                    return;
+                },
+            }
+        }
+    }
+
+    /// True once the header is parsed and every target byte was produced.
+    pub fn isComplete(self: *const Patcher) bool {
+        return self.phase == .done;
+    }
+
+    fn gather(self: *Patcher, in: []const u8, want: usize) []const u8 {
+        const n = @min(want - self.pend_len, in.len);
+        @memcpy(self.pend[self.pend_len..][0..n], in[0..n]);
+        self.pend_len += @intCast(n);
+        return in[n..];
+    }
+
+    fn parseHeader(self: *Patcher, source_size: u64) Error!void {
+        if (!std.mem.eql(u8, self.pend[0..4], magic)) return error.Corrupt;
+        self.source_size = std.mem.readInt(u64, self.pend[8..16], .little);
+        self.target_size = std.mem.readInt(u64, self.pend[16..24], .little);
+        if (self.source_size > source_size) return error.SourceMismatch;
+        self.pend_len = 0;
+        self.nextOp();
+    }
+
+    fn parseOp(self: *Patcher, op: Op) Error!void {
+        self.remaining = std.mem.readInt(u32, self.pend[1..5], .little);
+        self.src_off = if (op == .insert) 0 else std.mem.readInt(u64, self.pend[5..13], .little);
+        self.pend_len = 0;
+        if (self.remaining > self.target_size - self.out_off) return error.Corrupt;
+        if (op != .insert and (self.src_off > self.source_size or
+            self.remaining > self.source_size - self.src_off)) return error.Corrupt;
+        self.phase = switch (op) {
+            .copy => .copy,
+            .insert => .insert,
+            .add => .add,
+        };
+        if (self.remaining == 0) self.nextOp();
+    }
+
+    fn nextOp(self: *Patcher) void {
+        self.phase = if (self.out_off == self.target_size) .done else .op;
+    }
+
+    fn readSource(self: *Patcher, source: *trait.fs.File, buf: []u8) Error!void {
+        var got: usize = 0;
+        while (got < buf.len) {
+            const n = source.pread(buf[got..], self.src_off + got);
+            if (n == 0) return error.ReadFailed;
+            got += n;
+        }
+        self.src_off += buf.len;
+    }
+
+    fn emit(self: *Patcher, out: Output, bytes: []const u8) Error!void {
+        if (!out.write(bytes)) return error.WriteFailed;
+        self.out_off += bytes.len;
+        self.remaining -= @intCast(bytes.len);
+    }
+};
+
+// ============================================================================
+// Encoder (host side)
+// ============================================================================
+
+/// Seed length for source matches
+const block = 16;
+/// An approximate (ADD) match ends after this many mismatching bytes in a row
+const max_mismatch_run = 8;
+/// Exact stretch inside an approximate match worth its own COPY op
+const min_copy_split = 32;
+
+/// Build a patch turning `source` into `target`. Greedy: index the source
+/// at block-aligned offsets, extend each seed forward allowing sparse
+/// mismatches, and fall back to INSERT for unmatched bytes.
+pub fn encode(allocator: std.mem.Allocator, source: []const u8, target: []const u8) ![]u8 {
+    var out: std.ArrayList(u8) = .empty;
+    errdefer out.deinit(allocator);
+
+    var hdr: [header_len]u8 = undefined;
+    @memcpy(hdr[0..4], magic);
+    std.mem.writeInt(u32, hdr[4..8], 0, .little);
+    std.mem.writeInt(u64, hdr[8..16], source.len, .little);
+    std.mem.writeInt(u64, hdr[16..24], target.len, .little);
+    try out.appendSlice(allocator, &hdr);
+
+    var index = std.AutoHashMap(u64, u64).init(allocator);
+    defer index.deinit();
+    var off: usize = 0;
+    while (off + block <= source.len) : (off += block) {
+        const gop = try index.getOrPut(seedKey(source[off..][0..block]));
+        if (!gop.found_existing) gop.value_ptr.* = off;
+    }
+
+    var pos: usize = 0;
+    var lit_start: usize = 0;
+    while (pos + block <= target.len) {
+        const src = index.get(seedKey(target[pos..][0..block])) orelse {
+            pos += 1;
+            continue;
+        };
+        if (!std.mem.eql(u8, source[src..][0..block], target[pos..][0..block])) {
+            pos += 1;
+            continue;
+        }
+        const m = extend(source[src..], target[pos..]);
+        try emitInsert(allocator, &out, target[lit_start..pos]);
+        try emitMatch(allocator, &out, source[src..][0..m.len], target[pos..][0..m.len], src, m.exact);
+        pos += m.len;
+        lit_start = pos;
+    }
+    try emitInsert(allocator, &out, target[lit_start..]);
+    return out.toOwnedSlice(allocator);
+}
+
+fn seedKey(bytes: *const [block]u8) u64 {
+    return std.hash.Wyhash.hash(0, bytes);
+}
+
+const Match = struct { len: usize, exact: bool };
+
+fn extend(src: []const u8, dst: []const u8) Match {
+    const limit = @min(src.len, dst.len, std.math.maxInt(u32));
+    var len: usize = 0;
+    var end: usize = 0; // one past the last matching byte
+    var miss_run: usize = 0;
+    var exact = true;
+    while (len < limit) : (len += 1) {
+        if (src[len] == dst[len]) {
+            miss_run = 0;
+            end = len + 1;
+        } else {
+            miss_run += 1;
+            if (miss_run >= max_mismatch_run) break;
+        }
+    }
+    for (src[0..end], dst[0..end]) |a, b| {
+        if (a != b) exact = false;
+    }
+    return .{ .len = end, .exact = exact };
+}
+
+fn emitInsert(allocator: std.mem.Allocator, out: *std.ArrayList(u8), bytes: []const u8) !void {
+    var rest = bytes;
+    while (rest.len > 0) {
+        const n: u32 = @intCast(@min(rest.len, std.math.maxInt(u32)));
+        try out.append(allocator, @intFromEnum(Op.insert));
+        std.mem.writeInt(u32, try out.addManyAsArray(allocator, 4), n, .little);
+        try out.appendSlice(allocator, rest[0..n]);
+        rest = rest[n..];
+    }
+}
+
+fn emitMatch(allocator: std.mem.Allocator, out: *std.ArrayList(u8), src: []const u8, dst: []const u8, src_off: usize, exact: bool) !void {
+    if (exact) return emitOp(allocator, out, .copy, src, dst, src_off);
+
+    // Sparse differences: exact stretches long enough to pay for an op
+    // header become COPY, the rest ADD.
+    var seg: usize = 0;
+    var i: usize = 0;
+    while (i < dst.len) {
+        var run: usize = 0;
+        while (i + run < dst.len and src[i + run] == dst[i + run]) run += 1;
+        if (run >= min_copy_split or i + run == dst.len) {
+            if (i > seg) try emitOp(allocator, out, .add, src[seg..i], dst[seg..i], src_off + seg);
+            if (run > 0) try emitOp(allocator, out, .copy, src[i..][0..run], dst[i..][0..run], src_off + i);
+            seg = i + run;
+        }
+        i += @max(run, 1);
+    }
+    if (seg < dst.len) try emitOp(allocator, out, .add, src[seg..], dst[seg..], src_off + seg);
+}
+
+fn emitOp(allocator: std.mem.Allocator, out: *std.ArrayList(u8), op: Op, src: []const u8, dst: []const u8, src_off: usize) !void {
+    try out.append(allocator, @intFromEnum(op));
+    std.mem.writeInt(u32, try out.addManyAsArray(allocator, 4), @intCast(dst.len), .little);
+    std.mem.writeInt(u64, try out.addManyAsArray(allocator, 8), src_off, .little);
+    if (op != .add) return;
+    try out.ensureUnusedCapacity(allocator, dst.len);
+    for (src, dst) |a, b| out.appendAssumeCapacity(b -% a);
+}
+
+// ============================================================================
+// Tests
+// ============================================================================
+
+const testing = std.testing;
+
+const MemSink = struct {
+    buf: std.ArrayList(u8) = .empty,
+
+    fn output(self: *MemSink) Output {
+        return .{ .ctx = @ptrCast(self), .writeFn = &write };
+    }
+
+    fn write(ctx: *anyopaque, bytes: []const u8) bool {
+        const self: *MemSink = @ptrCast(@alignCast(ctx));
+        self.buf.appendSlice(testing.allocator, bytes) catch return false;
+        return true;
+    }
+};
+
+fn memFile(data: []const u8) trait.fs.File {
+    return .{ .data = data, .ctx = undefined, .closeFn = &noClose, .size = data.len };
+}
+
+fn noClose(_: *anyopaque) void {}
+
+fn applyChunked(source: []const u8, patch: []const u8, chunk: usize) ![]u8 {
+    var src = memFile(source);
+    var sink = MemSink{};
+    errdefer sink.buf.deinit(testing.allocator);
+    var scratch: [64]u8 = undefined;
+    var p = Patcher{};
+    var i: usize = 0;
+    while (i < patch.len) : (i += chunk) {
+        try p.feed(patch[i..@min(i + chunk, patch.len)], &src, &scratch, sink.output());
+    }
+    try testing.expect(p.isComplete());
+    return sink.buf.toOwnedSlice(testing.allocator);
+}
+
+fn countOps(patch: []const u8) [4]usize {
+    var counts = [_]usize{0} ** 4;
+    var i: usize = header_len;
+    while (i < patch.len) {
+        const op: Op = @enumFromInt(patch[i]);
+        const len = std.mem.readInt(u32, patch[i + 1 ..][0..4], .little);
+        counts[patch[i]] += 1;
+        i += op.headerLen() + if (op == .copy) 0 else len;
+    }
+    return counts;
+}
+
+/// Firmware-like pair: the target shifts a region by 40 bytes and bumps
+/// every 32-bit "pointer" word in it, plus a fresh literal section.
+fn samplePair(allocator: std.mem.Allocator) !struct { []u8, []u8 } {
+    const source = try allocator.alloc(u8, 8192);
+    errdefer allocator.free(source);
+    var prng = std.Random.DefaultPrng.init(7);
+    prng.random().bytes(source);
+
+    var target: std.ArrayList(u8) = .empty;
+    errdefer target.deinit(allocator);
+    try target.appendSlice(allocator, source[0..1000]);
+    try target.appendSlice(allocator, "new code goes here, forty bytes long...!");
+    var i: usize = 1000;
+    while (i + 4 <= 6000) : (i += 4) {
+        var w = std.mem.readInt(u32, source[i..][0..4], .little);
+        if (i % 64 == 0) w +%= 40;
+        std.mem.writeInt(u32, try target.addManyAsArray(allocator, 4), w, .little);
+    }
+    try target.appendSlice(allocator, source[6000..]);
+    return .{ source, try target.toOwnedSlice(allocator) };
+}
+
+test "encode/apply round trip with COPY, ADD and INSERT" {
+    const source, const target = try samplePair(testing.allocator);
+    defer testing.allocator.free(source);
+    defer testing.allocator.free(target);
+
+    const patch = try encode(testing.allocator, source, target);
+    defer testing.allocator.free(patch);
+    const ops = countOps(patch);
+    try testing.expect(ops[@intFromEnum(Op.copy)] > 0);
+    try testing.expect(ops[@intFromEnum(Op.insert)] > 0);
+    try testing.expect(ops[@intFromEnum(Op.add)] > 0);
+
+    for ([_]usize{ 1, 3, 13, 64, 4096, patch.len }) |chunk| {
+        const rebuilt = try applyChunked(source, patch, chunk);
+        defer testing.allocator.free(rebuilt);
+        try testing.expectEqualSlices(u8, target, rebuilt);
+    }
+}
+
+test "identical images produce a tiny patch" {
+    var data: [4096]u8 = undefined;
+    for (&data, 0..) |*b, i| b.* = @truncate(i * 7);
+    const patch = try encode(testing.allocator, &data, &data);
+    defer testing.allocator.free(patch);
+    try testing.expect(patch.len < 64);
+
+    const rebuilt = try applyChunked(&data, patch, 5);
+    defer testing.allocator.free(rebuilt);
+    try testing.expectEqualSlices(u8, &data, rebuilt);
+}
+
+test "ops outside source or target bounds are rejected" {
+    var src_data = [_]u8{0} ** 32;
+    var src = memFile(&src_data);
+    var sink = MemSink{};
+    defer sink.buf.deinit(testing.allocator);
+    var scratch: [16]u8 = undefined;
+
+    var hdr: [header_len + 13]u8 = undefined;
+    @memcpy(hdr[0..4], magic);
+    std.mem.writeInt(u32, hdr[4..8], 0, .little);
+    std.mem.writeInt(u64, hdr[8..16], 32, .little);
+    std.mem.writeInt(u64, hdr[16..24], 64, .little);
+    hdr[24] = @intFromEnum(Op.copy);
+    std.mem.writeInt(u32, hdr[25..29], 16, .little);
+    std.mem.writeInt(u64, hdr[29..37], 20, .little); // 20 + 16 > 32
+
+    var p = Patcher{};
+    try testing.expectError(error.Corrupt, p.feed(&hdr, &src, &scratch, sink.output()));
+
+    var bad_magic = hdr;
+    bad_magic[0] = 'X';
+    p = .{};
+    try testing.expectError(error.Corrupt, p.feed(&bad_magic, &src, &scratch, sink.output()));
+
+    var big_source = hdr;
+    std.mem.writeInt(u64, big_source[8..16], 4096, .little);
+    p = .{};
+    try testing.expectError(error.SourceMismatch, p.feed(&big_source, &src, &scratch, sink.output()));
+}
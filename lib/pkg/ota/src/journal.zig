@@ -0,0 +1,225 @@
+//! OTA state journal
+//!
+//! The update state lives in two fixed-size records in one file. Each
+//! store writes the record *not* holding the newest state, with a higher
+//! sequence number and a CRC, then syncs. A write torn by power loss
+//! fails its CRC and `load` falls back to the other record, so every
+//! transition (resume checkpoint, activate, confirm, rollback) is atomic.
+//!
+//! The record layout is fixed so a bootloader can read it without this
+//! package:
+//!
+//!   off  size  field
+//!     0     4  magic "OTAJ"
+//!     4     1  version (1)
+//!     5     1  phase
+//!     6     1  active slot
+//!     7     1  boot attempts in trial
+//!     8     1  update kind (full/delta)
+//!    16     8  sequence
+//!    24     8  image size
+//!    32     8  bytes written to the target slot
+//!    40     8  download bytes consumed (resume offset)
+//!    48    32  image SHA-256
+//!    80    64  per-slot image SHA-256 (zero = unknown)
+//!   144    16  per-slot image size
+//!   160    64  delta patcher state
+//!   252     4  CRC-32 of bytes 0..252
+
+const std = @import("std");
+const trait = @import("trait");
+const delta = @import("delta.zig");
+
+pub const record_size = 256;
+pub const file_size = 2 * record_size;
+
+const magic = "OTAJ";
+const version = 1;
+
+pub const Slot = enum(u8) {
+    a = 0,
+    b = 1,
+
+    pub fn other(self: Slot) Slot {
+        return if (self == .a) .b else .a;
+    }
+};
+
+pub const Kind = enum(u8) {
+    full = 0,
+    delta = 1,
+};
+
+pub const Phase = enum(u8) {
+    /// Running a confirmed image, no update in progress
+    idle = 0,
+    /// Streaming into the inactive slot
+    receiving = 1,
+    /// Inactive slot holds a verified image, not yet activated
+    ready = 2,
+    /// Booting the new image until the application confirms it
+    trial = 3,
+};
+
+pub const State = struct {
+    seq: u64 = 0,
+    phase: Phase = .idle,
+    active: Slot = .a,
+    boot_attempts: u8 = 0,
+    kind: Kind = .full,
+    image_size: u64 = 0,
+    written: u64 = 0,
+    consumed: u64 = 0,
+    image_sha256: [32]u8 = [_]u8{0} ** 32,
+    slot_sha256: [2][32]u8 = .{ [_]u8{0} ** 32, [_]u8{0} ** 32 },
+    slot_size: [2]u64 = .{ 0, 0 },
+    patcher: delta.Patcher = .{},
+
+    /// Slot written by the current update (the inactive one)
+    pub fn target(self: *const State) Slot {
+        return self.active.other();
+    }
+
+    pub fn encode(self: *const State) [record_size]u8 {
+        var r = [_]u8{0} ** record_size;
+        @memcpy(r[0..4], magic);
+        r[4] = version;
+        r[5] = @intFromEnum(self.phase);
+        r[6] = @intFromEnum(self.active);
+        r[7] = self.boot_attempts;
+        r[8] = @intFromEnum(self.kind);
+        std.mem.writeInt(u64, r[16..24], self.seq, .little);
+        std.mem.writeInt(u64, r[24..32], self.image_size, .little);
+        std.mem.writeInt(u64, r[32..40], self.written, .little);
+        std.mem.writeInt(u64, r[40..48], self.consumed, .little);
+        @memcpy(r[48..80], &self.image_sha256);
+        @memcpy(r[80..112], &self.slot_sha256[0]);
+        @memcpy(r[112..144], &self.slot_sha256[1]);
+        std.mem.writeInt(u64, r[144..152], self.slot_size[0], .little);
+        std.mem.writeInt(u64, r[152..160], self.slot_size[1], .little);
+        encodePatcher(&self.patcher, r[160..224]);
+        std.mem.writeInt(u32, r[252..256], std.hash.Crc32.hash(r[0..252]), .little);
+        return r;
+    }
+
+    pub fn decode(r: *const [record_size]u8) ?State {
+        if (!std.mem.eql(u8, r[0..4], magic) or r[4] != version) return null;
+        if (std.mem.readInt(u32, r[252..256], .little) != std.hash.Crc32.hash(r[0..252])) return null;
+        var s = State{
+            .phase = std.meta.intToEnum(Phase, r[5]) catch return null,
+            .active = std.meta.intToEnum(Slot, r[6]) catch return null,
+            .boot_attempts = r[7],
+            .kind = std.meta.intToEnum(Kind, r[8]) catch return null,
+            .seq = std.mem.readInt(u64, r[16..24], .little),
+            .image_size = std.mem.readInt(u64, r[24..32], .little),
+            .written = std.mem.readInt(u64, r[32..40], .little),
+            .consumed = std.mem.readInt(u64, r[40..48], .little),
+            .slot_size = .{
+                std.mem.readInt(u64, r[144..152], .little),
+                std.mem.readInt(u64, r[152..160], .little),
+            },
+            .patcher = decodePatcher(r[160..224]) orelse return null,
+        };
+        @memcpy(&s.image_sha256, r[48..80]);
+        @memcpy(&s.slot_sha256[0], r[80..112]);
+        @memcpy(&s.slot_sha256[1], r[112..144]);
+        return s;
+    }
+};
+
+fn encodePatcher(p: *const delta.Patcher, out: *[64]u8) void {
+    out[0] = @intFromEnum(p.phase);
+    out[1] = p.pend_len;
+    std.mem.writeInt(u32, out[4..8], p.remaining, .little);
+    std.mem.writeInt(u64, out[8..16], p.src_off, .little);
+    std.mem.writeInt(u64, out[16..24], p.source_size, .little);
+    std.mem.writeInt(u64, out[24..32], p.target_size, .little);
+    std.mem.writeInt(u64, out[32..40], p.out_off, .little);
+    @memcpy(out[40..][0..p.pend_len], p.pend[0..p.pend_len]);
+}
+
+fn decodePatcher(in: *const [64]u8) ?delta.Patcher {
+    if (in[1] > delta.header_len) return null;
+    var p = delta.Patcher{
+        .phase = std.meta.intToEnum(delta.Patcher.Phase, in[0]) catch return null,
+        .pend_len = in[1],
+        .remaining = std.mem.readInt(u32, in[4..8], .little),
+        .src_off = std.mem.readInt(u64, in[8..16], .little),
+        .source_size = std.mem.readInt(u64, in[16..24], .little),
+        .target_size = std.mem.readInt(u64, in[24..32], .little),
+        .out_off = std.mem.readInt(u64, in[32..40], .little),
+    };
+    @memcpy(p.pend[0..p.pend_len], in[40..][0..p.pend_len]);
+    return p;
+}
+
+/// Newest valid record in the journal file, or null if neither is valid.
+pub fn load(file: *trait.fs.File) ?State {
+    var best: ?State = null;
+    for (0..2) |i| {
+        var r: [record_size]u8 = undefined;
+        if (file.pread(&r, i * record_size) != record_size) continue;
+        const s = State.decode(&r) orelse continue;
+        if (best == null or s.seq > best.?.seq) best = s;
+    }
+    return best;
+}
+
+/// Persist `state` with the next sequence number. On success `state.seq`
+/// is updated; on failure it is left as it was and the previous record
+/// is still the valid one.
+pub fn store(file: *trait.fs.File, state: *State) bool {
+    var next = state.*;
+    next.seq +%= 1;
+    const r = next.encode();
+    const off = (next.seq % 2) * record_size;
+    if (file.pwrite(&r, off) != record_size) return false;
+    if (!file.sync()) return false;
+    state.seq = next.seq;
+    return true;
+}
+
+// ============================================================================
+// Tests
+// ============================================================================
+
+const testing = std.testing;
+
+test "record round trip" {
+    var s = State{
+        .seq = 41,
+        .phase = .receiving,
+        .active = .b,
+        .kind = .delta,
+        .image_size = 1 << 33,
+        .written = 12345,
+        .consumed = 678,
+        .slot_size = .{ 10, 20 },
+        .patcher = .{ .phase = .add, .pend_len = 3, .remaining = 99, .src_off = 7, .target_size = 1 << 33 },
+    };
+    s.image_sha256[0] = 0xAA;
+    s.slot_sha256[1][31] = 0x55;
+    s.patcher.pend[0..3].* = .{ 1, 2, 3 };
+
+    const d = State.decode(&s.encode()) orelse return error.TestUnexpectedResult;
+    try testing.expectEqual(s.seq, d.seq);
+    try testing.expectEqual(s.phase, d.phase);
+    try testing.expectEqual(s.active, d.active);
+    try testing.expectEqual(s.kind, d.kind);
+    try testing.expectEqual(s.image_size, d.image_size);
+    try testing.expectEqual(s.written, d.written);
+    try testing.expectEqual(s.consumed, d.consumed);
+    try testing.expectEqualSlices(u8, &s.image_sha256, &d.image_sha256);
+    try testing.expectEqualSlices(u8, &s.slot_sha256[1], &d.slot_sha256[1]);
+    try testing.expectEqual(s.slot_size, d.slot_size);
+    try testing.expectEqual(s.patcher.phase, d.patcher.phase);
+    try testing.expectEqual(s.patcher.remaining, d.patcher.remaining);
+    try testing.expectEqualSlices(u8, s.patcher.pend[0..3], d.patcher.pend[0..3]);
+}
+
+test "corrupt record is rejected" {
+    const s = State{ .seq = 1, .phase = .ready };
+    var r = s.encode();
+    r[30] ^= 1;
+    try testing.expect(State.decode(&r) == null);
+}
@@ -0,0 +1,762 @@
+//! A/B Firmware Update Engine
+//!
+//! Streams a new image into the inactive slot through `trait.fs`, verifies
+//! it as it arrives, and switches slots atomically:
+//!
+//!   idle --begin--> receiving --finish--> ready --activate--> trial
+//!     ^                                                         |
+//!     +------------------ confirm / rollback -------------------+
+//!
+//! - **Verification**: the manifest (size, SHA-256, delta base) is checked
+//!   against an Ed25519 signature before the first byte is written, and
+//!   the image hash is computed incrementally while streaming, so `finish`
+//!   needs no second pass over the slot.
+//! - **Resume**: progress is checkpointed to a double-buffered journal
+//!   every `checkpoint_bytes`. After power loss, `begin` with the same
+//!   manifest returns the download offset to continue from (e.g. an HTTP
+//!   Range request); the hash is rebuilt from the slot, not the network.
+//! - **Delta**: `.delta` manifests carry a patch (see `delta.zig`) against
+//!   the running slot. RAM use is one `buffer_size` scratch buffer no
+//!   matter how large the image is.
+//! - **Rollback**: after `activate` the new slot boots in trial; `boot`
+//!   counts attempts and falls back to the previous slot if the
+//!   application never calls `confirm`.
+//!
+//! Usage:
+//! ```zig
+//! const Ota = ota.Engine(Board.fs.DriverType, Crypto);
+//! var engine = try Ota.init(&fs_driver, .{ .public_key = release_key });
+//! defer engine.deinit();
+//!
+//! var offset = try engine.begin(manifest); // non-zero when resuming
+//! while (try download(url, offset, &buf)) |chunk| {
+//!     try engine.write(chunk);
+//!     offset += chunk.len;
+//! }
+//! try engine.finish();   // size + SHA-256 check
+//! try engine.activate(); // then reboot
+//!
+//! // On the next boot, once the application is healthy:
+//! try engine.confirm();
+//! ```
+
+const std = @import("std");
+const trait = @import("trait");
+
+pub const delta = @import("delta.zig");
+pub const journal = @import("journal.zig");
+pub const power_cut = @import("power_cut.zig");
+pub const PowerCutFs = power_cut.PowerCutFs;
+
+pub const Slot = journal.Slot;
+pub const Kind = journal.Kind;
+pub const Phase = journal.Phase;
+
+const File = trait.fs.File;
+
+/// Scratch buffer for source reads and re-hashing on resume
+pub const buffer_size = 4096;
+
+pub const Error = error{
+    /// Slot or journal I/O failed (including simulated power loss)
+    Io,
+    /// Call not valid in the current phase
+    BadState,
+    /// A public key is configured but the manifest is unsigned
+    SignatureRequired,
+    /// Signature did not verify (or the crypto suite cannot verify)
+    BadSignature,
+    /// Delta patch was built against a different image than the running one
+    SourceMismatch,
+    /// Delta patch is malformed
+    PatchCorrupt,
+    /// Received more or fewer bytes than the manifest declares
+    SizeMismatch,
+    /// Received image hash differs from the manifest
+    DigestMismatch,
+};
+
+/// Describes one update. Produced and signed by the release server.
+pub const Manifest = struct {
+    kind: Kind = .full,
+    image_size: u64,
+    image_sha256: [32]u8,
+    /// Delta only: SHA-256 of the image the patch applies to
+    source_sha256: ?[32]u8 = null,
+    /// Ed25519 over `signedBytes()`
+    signature: ?[64]u8 = null,
+
+    pub const signed_len = 4 + 1 + 8 + 32 + 32;
+
+    /// Canonical bytes covered by the signature
+    pub fn signedBytes(self: *const Manifest) [signed_len]u8 {
+        var out: [signed_len]u8 = undefined;
+        @memcpy(out[0..4], "OTAM");
+        out[4] = @intFromEnum(self.kind);
+        std.mem.writeInt(u64, out[5..13], self.image_size, .little);
+        @memcpy(out[13..45], &self.image_sha256);
+        @memcpy(out[45..77], &(self.source_sha256 orelse [_]u8{0} ** 32));
+        return out;
+    }
+
+    fn sameImage(self: *const Manifest, s: *const journal.State) bool {
+        return self.kind == s.kind and self.image_size == s.image_size and
+            std.mem.eql(u8, &self.image_sha256, &s.image_sha256);
+    }
+};
+
+pub const Config = struct {
+    slot_paths: [2][]const u8 = .{ "/ota/slot_a.bin", "/ota/slot_b.bin" },
+    journal_path: []const u8 = "/ota/state.bin",
+    /// Ed25519 release key. When set, unsigned manifests are rejected.
+    public_key: ?[32]u8 = null,
+    /// Trial boots before falling back to the previous slot
+    max_boot_attempts: u8 = 3,
+    /// Bytes written between journal checkpoints (bounds re-download
+    /// after power loss)
+    checkpoint_bytes: u64 = 64 * 1024,
+};
+
+/// Update engine over an fs driver (`open(path, mode) ?trait.fs.File`)
+/// and a `trait.crypto` suite providing Sha256 and, for signed
+/// manifests, Ed25519 with `verify`.
+pub fn Engine(comptime Fs: type, comptime Crypto: type) type {
+    comptime {
+        _ = trait.crypto.from(Crypto, .{
+            .sha256 = true,
+            .sha384 = false,
+            .aes_128_gcm = false,
+            .aes_256_gcm = false,
+            .chacha20_poly1305 = false,
+            .x25519 = false,
+            .hkdf_sha256 = false,
+            .hkdf_sha384 = false,
+            .hmac_sha256 = false,
+            .hmac_sha384 = false,
+            .rng = false,
+        });
+    }
+
+    return struct {
+        const Self = @This();
+        const Sha256 = Crypto.Sha256;
+        const can_verify = trait.crypto.has(Crypto, "Ed25519") and @hasDecl(Crypto.Ed25519, "verify");
+
+        fs: *Fs,
+        cfg: Config,
+        state: journal.State,
+        journal_file: File,
+        /// Inactive slot, open while receiving
+        target: ?File = null,
+        /// Running slot, open while applying a delta
+        source: ?File = null,
+        hasher: Sha256 = undefined,
+        last_checkpoint: u64 = 0,
+        overflow: bool = false,
+        scratch: [buffer_size]u8 = undefined,
+
+        /// Open the journal and load the last committed state.
+        pub fn init(fs: *Fs, cfg: Config) Error!Self {
+            var jf = fs.open(cfg.journal_path, .read_write) orelse return error.Io;
+            return .{
+                .fs = fs,
+                .cfg = cfg,
+                .state = journal.load(&jf) orelse .{},
+                .journal_file = jf,
+            };
+        }
+
+        /// Close files. An update in progress stays resumable.
+        pub fn deinit(self: *Self) void {
+            self.closeSlots();
+            self.journal_file.close();
+        }
+
+        pub fn phase(self: *const Self) Phase {
+            return self.state.phase;
+        }
+
+        /// Slot the bootloader should run
+        pub fn activeSlot(self: *const Self) Slot {
+            return self.state.active;
+        }
+
+        /// Target bytes written so far and the expected total
+        pub fn progress(self: *const Self) struct { written: u64, total: u64 } {
+            return .{ .written = self.state.written, .total = self.state.image_size };
+        }
+
+        /// Call once per boot, before the application starts. Counts trial
+        /// boots and rolls back once `max_boot_attempts` is exceeded.
+        /// Returns the slot to run.
+        pub fn boot(self: *Self) Error!Slot {
+            if (self.state.phase == .trial) {
+                var next = self.state;
+                if (next.boot_attempts >= self.cfg.max_boot_attempts) {
+                    revert(&next);
+                } else {
+                    next.boot_attempts += 1;
+                }
+                try self.commit(&next);
+            }
+            return self.state.active;
+        }
+
+        /// Start (or resume) receiving `m`. Returns the download offset to
+        /// continue from: 0 for a fresh update, the checkpointed offset
+        /// when the same manifest was interrupted, or `image_size` when it
+        /// already finished.
+        pub fn begin(self: *Self, m: Manifest) Error!u64 {
+            if (self.state.phase == .trial) return error.BadState;
+            try self.verifySignature(&m);
+
+            if (m.sameImage(&self.state)) {
+                if (self.state.phase == .ready) return m.image_size;
+                if (self.state.phase == .receiving) return self.resume();
+            }
+
+            self.closeSlots();
+            var next = self.state;
+            next.phase = .receiving;
+            next.kind = m.kind;
+            next.image_size = m.image_size;
+            next.image_sha256 = m.image_sha256;
+            next.written = 0;
+            next.consumed = 0;
+            next.patcher = .{};
+            next.slot_sha256[@intFromEnum(next.target())] = [_]u8{0} ** 32;
+            next.slot_size[@intFromEnum(next.target())] = 0;
+
+            if (m.kind == .delta) {
+                const want = m.source_sha256 orelse return error.SourceMismatch;
+                const have = try self.activeDigest(&next);
+                if (!std.mem.eql(u8, &want, &have)) return error.SourceMismatch;
+            }
+
+            // Journal first: the target slot is never written while the
+            // committed state still describes it as a valid image.
+            try self.commit(&next);
+            try self.openSlots();
+            self.hasher = Sha256.init();
+            self.last_checkpoint = 0;
+            return 0;
+        }
+
+        /// Feed the next download bytes (image or patch, per manifest).
+        /// All or nothing: on error the engine is back where it was before
+        /// `chunk`, so the same chunk can be fed again.
+        pub fn write(self: *Self, chunk: []const u8) Error!void {
+            if (self.state.phase != .receiving or self.target == null) return error.BadState;
+            self.overflow = false;
+
+            // The patcher, `written` and the digest advance while a chunk
+            // is applied; `consumed` only once it is done
+            const saved_state = self.state;
+            const saved_hasher = self.hasher;
+            errdefer {
+                self.state = saved_state;
+                self.hasher = saved_hasher;
+            }
+
+            switch (self.state.kind) {
+                .full => if (!self.writeTarget(chunk)) return self.writeError(),
+                .delta => self.state.patcher.feed(chunk, &self.source.?, &self.scratch, .{
+                    .ctx = @ptrCast(self),
+                    .writeFn = &patchOut,
+                }) catch |err| return switch (err) {
+                    error.Corrupt => error.PatchCorrupt,
+                    error.SourceMismatch => error.SourceMismatch,
+                    error.ReadFailed => error.Io,
+                    error.WriteFailed => self.writeError(),
+                },
+            }
+            self.state.consumed += chunk.len;
+
+            if (self.state.written - self.last_checkpoint >= self.cfg.checkpoint_bytes) {
+                try self.checkpoint();
+            }
+        }
+
+        /// Check size and digest; on success the inactive slot is `ready`.
+        /// A digest mismatch discards the update.
+        pub fn finish(self: *Self) Error!void {
+            if (self.state.phase == .ready) return;
+            if (self.state.phase != .receiving or self.target == null) return error.BadState;
+            if (self.state.written != self.state.image_size) return error.SizeMismatch;
+            if (self.state.kind == .delta and !self.state.patcher.isComplete()) return error.SizeMismatch;
+
+            const digest = self.hasher.final();
+            if (!std.mem.eql(u8, &digest, &self.state.image_sha256)) {
+                self.closeSlots();
+                var next = self.state;
+                next.phase = .idle;
+                try self.commit(&next);
+                return error.DigestMismatch;
+            }
+
+            if (!self.target.?.sync()) return error.Io;
+            self.closeSlots();
+            var next = self.state;
+            next.phase = .ready;
+            next.slot_sha256[@intFromEnum(next.target())] = digest;
+            next.slot_size[@intFromEnum(next.target())] = next.image_size;
+            try self.commit(&next);
+        }
+
+        /// Drop an unfinished or unactivated update.
+        pub fn abort(self: *Self) Error!void {
+            if (self.state.phase != .receiving and self.state.phase != .ready) return error.BadState;
+            self.closeSlots();
+            var next = self.state;
+            next.phase = .idle;
+            try self.commit(&next);
+        }
+
+        /// Switch to the ready slot in trial mode. Reboot afterwards.
+        pub fn activate(self: *Self) Error!void {
+            if (self.state.phase != .ready) return error.BadState;
+            var next = self.state;
+            next.active = next.target();
+            next.phase = .trial;
+            next.boot_attempts = 0;
+            try self.commit(&next);
+        }
+
+        /// The trial image is healthy: keep it.
+        pub fn confirm(self: *Self) Error!void {
+            if (self.state.phase != .trial) return error.BadState;
+            var next = self.state;
+            next.phase = .idle;
+            next.boot_attempts = 0;
+            try self.commit(&next);
+        }
+
+        /// Return to the previous slot from trial. Reboot afterwards.
+        pub fn rollback(self: *Self) Error!void {
+            if (self.state.phase != .trial) return error.BadState;
+            var next = self.state;
+            revert(&next);
+            try self.commit(&next);
+        }
+
+        fn revert(s: *journal.State) void {
+            const failed = s.active;
+            s.active = failed.other();
+            s.phase = .idle;
+            s.boot_attempts = 0;
+            s.slot_sha256[@intFromEnum(failed)] = [_]u8{0} ** 32;
+            s.slot_size[@intFromEnum(failed)] = 0;
+        }
+
+        // ====================================================================
+        // Internals
+        // ====================================================================
+
+        fn commit(self: *Self, next: *journal.State) Error!void {
+            if (!journal.store(&self.journal_file, next)) return error.Io;
+            self.state = next.*;
+        }
+
+        fn checkpoint(self: *Self) Error!void {
+            if (!self.target.?.sync()) return error.Io;
+            var next = self.state;
+            try self.commit(&next);
+            self.last_checkpoint = self.state.written;
+        }
+
+        fn verifySignature(self: *Self, m: *const Manifest) Error!void {
+            const key = self.cfg.public_key orelse return;
+            const sig = m.signature orelse return error.SignatureRequired;
+            if (comptime can_verify) {
+                const Ed25519 = Crypto.Ed25519;
+                const pk = Ed25519.PublicKey.fromBytes(key) catch return error.BadSignature;
+                const s = Ed25519.Signature.fromBytes(sig);
+                if (!Ed25519.verify(s, &m.signedBytes(), pk)) return error.BadSignature;
+            } else {
+                return error.BadSignature;
+            }
+        }
+
+        /// Digest of the running image; hashed from the slot (and recorded
+        /// in `s`) when unknown, e.g. for a factory-flashed image.
+        fn activeDigest(self: *Self, s: *journal.State) Error![32]u8 {
+            const i = @intFromEnum(s.active);
+            if (s.slot_size[i] != 0) return s.slot_sha256[i];
+
+            var file = self.fs.open(self.cfg.slot_paths[i], .read) orelse return error.Io;
+            defer file.close();
+            file.advise(0, 0, .sequential);
+            self.hasher = Sha256.init();
+            try self.hashPrefix(&file, file.size);
+            s.slot_sha256[i] = self.hasher.final();
+            s.slot_size[i] = file.size;
+            return s.slot_sha256[i];
+        }
+
+        fn resume(self: *Self) Error!u64 {
+            if (self.target == null) try self.openSlots();
+            self.hasher = Sha256.init();
+            try self.hashPrefix(&self.target.?, self.state.written);
+            self.last_checkpoint = self.state.written;
+            return self.state.consumed;
+        }
+
+        fn hashPrefix(self: *Self, file: *File, len: u64) Error!void {
+            var off: u64 = 0;
+            while (off < len) {
+                const want: usize = @intCast(@min(len - off, self.scratch.len));
+                const n = file.pread(self.scratch[0..want], off);
+                if (n == 0) return error.Io;
+                self.hasher.update(self.scratch[0..n]);
+                off += n;
+            }
+        }
+
+        fn openSlots(self: *Self) Error!void {
+            const t = @intFromEnum(self.state.target());
+            self.target = self.fs.open(self.cfg.slot_paths[t], .read_write) orelse return error.Io;
+            if (self.state.kind == .delta) {
+                const a = @intFromEnum(self.state.active);
+                self.source = self.fs.open(self.cfg.slot_paths[a], .read) orelse {
+                    self.closeSlots();
+                    return error.Io;
+                };
+                self.source.?.advise(0, 0, .random);
+            }
+        }
+
+        fn closeSlots(self: *Self) void {
+            if (self.target) |*f| f.close();
+            if (self.source) |*f| f.close();
+            self.target = null;
+            self.source = null;
+        }
+
+        fn writeError(self: *Self) Error {
+            return if (self.overflow) error.SizeMismatch else error.Io;
+        }
+
+        fn writeTarget(self: *Self, bytes: []const u8) bool {
+            if (bytes.len > self.state.image_size - self.state.written) {
+                self.overflow = true;
+                return false;
+            }
+            const file = &self.target.?;
+            var off: usize = 0;
+            while (off < bytes.len) {
+                const n = file.pwrite(bytes[off..], self.state.written + off);
+                if (n == 0) return false;
+                off += n;
+            }
+            self.hasher.update(bytes);
+            self.state.written += bytes.len;
+            return true;
+        }
+
+        fn patchOut(ctx: *anyopaque, bytes: []const u8) bool {
+            const self: *Self = @ptrCast(@alignCast(ctx));
+            return self.writeTarget(bytes);
+        }
+    };
+}
+
+// ============================================================================
+// Tests
+// ============================================================================
+
+const testing = std.testing;
+const std_impl = @import("std_impl");
+const Suite = @import("crypto");
+
+const HostFs = std_impl.fs.Fs;
+
+fn sha256(data: []const u8) [32]u8 {
+    var out: [32]u8 = undefined;
+    std.crypto.hash.sha2.Sha256.hash(data, &out, .{});
+    return out;
+}
+
+fn testImage(buf: []u8, seed: u64) void {
+    var prng = std.Random.DefaultPrng.init(seed);
+    prng.random().bytes(buf);
+}
+
+/// Temp dir with an `ota/` directory and a factory image in slot A
+const Rig = struct {
+    tmp: std.testing.TmpDir,
+    host: HostFs,
+
+    fn init(factory: []const u8) !Rig {
+        var tmp = testing.tmpDir(.{});
+        errdefer tmp.cleanup();
+        try tmp.dir.makeDir("ota");
+        try tmp.dir.writeFile(.{ .sub_path = "ota/slot_a.bin", .data = factory });
+        return .{ .tmp = tmp, .host = HostFs.initDir(tmp.dir) };
+    }
+
+    fn deinit(self: *Rig) void {
+        self.host.deinit();
+        self.tmp.cleanup();
+    }
+
+    fn expectSlot(self: *Rig, path: []const u8, want: []const u8) !void {
+        const got = try self.tmp.dir.readFileAlloc(testing.allocator, path, 1 << 24);
+        defer testing.allocator.free(got);
+        try testing.expectEqualSlices(u8, want, got[0..want.len]);
+    }
+};
+
+fn feed(engine: anytype, data: []const u8, chunk: usize) !void {
+    var i: usize = 0;
+    while (i < data.len) : (i += chunk) {
+        try engine.write(data[i..@min(i + chunk, data.len)]);
+    }
+}
+
+test "full update: receive, verify, activate, confirm" {
+    var factory: [3000]u8 = undefined;
+    testImage(&factory, 1);
+    var image: [10_000]u8 = undefined;
+    testImage(&image, 2);
+
+    var rig = try Rig.init(&factory);
+    defer rig.deinit();
+
+    const Ota = Engine(HostFs, Suite);
+    var engine = try Ota.init(&rig.host, .{ .checkpoint_bytes = 1024 });
+    defer engine.deinit();
+    try testing.expectEqual(Slot.a, try engine.boot());
+
+    const m = Manifest{ .image_size = image.len, .image_sha256 = sha256(&image) };
+    try testing.expectEqual(@as(u64, 0), try engine.begin(m));
+    try feed(&engine, &image, 777);
+    try engine.finish();
+    try testing.expectEqual(Phase.ready, engine.phase());
+    try engine.activate();
+    try rig.expectSlot("ota/slot_b.bin", &image);
+
+    // Reboot into the new slot and confirm it
+    var after = try Ota.init(&rig.host, .{});
+    defer after.deinit();
+    try testing.expectEqual(Slot.b, try after.boot());
+    try after.confirm();
+    try testing.expectEqual(Phase.idle, after.phase());
+    try testing.expectEqual(Slot.b, try after.boot());
+}
+
+test "digest or size mismatch is rejected" {
+    var image: [5000]u8 = undefined;
+    testImage(&image, 3);
+    var rig = try Rig.init("factory");
+    defer rig.deinit();
+
+    var engine = try Engine(HostFs, Suite).init(&rig.host, .{});
+    defer engine.deinit();
+
+    var m = Manifest{ .image_size = image.len, .image_sha256 = sha256(&image) };
+    m.image_sha256[0] ^= 1;
+    _ = try engine.begin(m);
+    try feed(&engine, &image, 1000);
+    try testing.expectError(error.DigestMismatch, engine.finish());
+    try testing.expectEqual(Phase.idle, engine.phase());
+    try testing.expectError(error.BadState, engine.activate());
+
+    m.image_sha256 = sha256(&image);
+    _ = try engine.begin(m);
+    try testing.expectError(error.SizeMismatch, engine.finish());
+    try feed(&engine, &image, 1000);
+    try testing.expectError(error.SizeMismatch, engine.write("x"));
+}
+
+test "signed manifests" {
+    const kp = Suite.Ed25519.KeyPair.generate();
+    var image: [2048]u8 = undefined;
+    testImage(&image, 4);
+    var rig = try Rig.init("factory");
+    defer rig.deinit();
+
+    var engine = try Engine(HostFs, Suite).init(&rig.host, .{ .public_key = kp.public_key.toBytes() });
+    defer engine.deinit();
+
+    var m = Manifest{ .image_size = image.len, .image_sha256 = sha256(&image) };
+    try testing.expectError(error.SignatureRequired, engine.begin(m));
+
+    m.signature = (try kp.sign(&m.signedBytes(), null)).toBytes();
+    var forged = m;
+    forged.image_size -= 1;
+    try testing.expectError(error.BadSignature, engine.begin(forged));
+
+    _ = try engine.begin(m);
+    try feed(&engine, &image, 512);
+    try engine.finish();
+}
+
+test "delta update against a factory image" {
+    const source = try testing.allocator.alloc(u8, 64 * 1024);
+    defer testing.allocator.free(source);
+    testImage(source, 5);
+    const target = try testing.allocator.dupe(u8, source);
+    defer testing.allocator.free(target);
+    for (0..200) |i| target[i * 300 + 17] +%= 1; // patched "addresses"
+    @memcpy(target[40_000..40_032], "freshly inserted release notes!!");
+
+    const patch = try delta.encode(testing.allocator, source, target);
+    defer testing.allocator.free(patch);
+    try testing.expect(patch.len < target.len / 2);
+
+    var rig = try Rig.init(source);
+    defer rig.deinit();
+    var engine = try Engine(HostFs, Suite).init(&rig.host, .{ .checkpoint_bytes = 4096 });
+    defer engine.deinit();
+
+    var m = Manifest{
+        .kind = .delta,
+        .image_size = target.len,
+        .image_sha256 = sha256(target),
+        .source_sha256 = sha256(target), // wrong base
+    };
+    try testing.expectError(error.SourceMismatch, engine.begin(m));
+
+    m.source_sha256 = sha256(source);
+    _ = try engine.begin(m);
+    try feed(&engine, patch, 1400);
+    try engine.finish();
+    try engine.activate();
+    try rig.expectSlot("ota/slot_b.bin", target);
+}
+
+test "trial image that never confirms is rolled back" {
+    var image: [1024]u8 = undefined;
+    testImage(&image, 6);
+    var rig = try Rig.init("factory");
+    defer rig.deinit();
+
+    const Ota = Engine(HostFs, Suite);
+    var engine = try Ota.init(&rig.host, .{ .max_boot_attempts = 2 });
+    defer engine.deinit();
+    _ = try engine.begin(.{ .image_size = image.len, .image_sha256 = sha256(&image) });
+    try engine.write(&image);
+    try engine.finish();
+    try engine.activate();
+
+    try testing.expectEqual(Slot.b, try engine.boot());
+    try testing.expectEqual(Slot.b, try engine.boot());
+    try testing.expectEqual(Slot.a, try engine.boot()); // third boot gives up
+    try testing.expectEqual(Phase.idle, engine.phase());
+    try testing.expectError(error.BadState, engine.confirm());
+}
+
+/// Run one update with the power cut after `cut` bytes, reboot, resume
+/// and check the result. Returns false once `cut` exceeds a full run.
+fn updateWithPowerCut(kind: Kind, source: []const u8, image: []const u8, payload: []const u8, cut: u64) !bool {
+    var rig = try Rig.init(source);
+    defer rig.deinit();
+    const cfg = Config{ .checkpoint_bytes = 2048 };
+    const m = Manifest{
+        .kind = kind,
+        .image_size = image.len,
+        .image_sha256 = sha256(image),
+        .source_sha256 = if (kind == .delta) sha256(source) else null,
+    };
+
+    var cut_fs = PowerCutFs(HostFs).init(&rig.host);
+    cut_fs.cutAfter(cut);
+    {
+        var engine = try Engine(PowerCutFs(HostFs), Suite).init(&cut_fs, cfg);
+        defer engine.deinit();
+        run: {
+            const off = engine.begin(m) catch break :run;
+            feed(&engine, payload[@intCast(off)..], 1000) catch break :run;
+            engine.finish() catch break :run;
+            engine.activate() catch break :run;
+        }
+    }
+    if (!cut_fs.tripped) return false;
+
+    // Reboot on the healthy filesystem and finish the job
+    const Ota = Engine(HostFs, Suite);
+    var engine = try Ota.init(&rig.host, cfg);
+    defer engine.deinit();
+    if (engine.phase() != .trial) {
+        const off = try engine.begin(m);
+        try testing.expect(off <= payload.len);
+        try feed(&engine, payload[@intCast(off)..], 1000);
+        try engine.finish();
+        try engine.activate();
+    }
+    try testing.expectEqual(Slot.b, try engine.boot());
+    try rig.expectSlot("ota/slot_b.bin", image);
+    return true;
+}
+
+test "a failed write rolls back so the chunk can be fed again" {
+    var source: [12_000]u8 = undefined;
+    testImage(&source, 9);
+    var image: [20_000]u8 = undefined;
+    testImage(&image, 10);
+    @memcpy(image[2000..10_000], source[3000..11_000]);
+
+    const patch = try delta.encode(testing.allocator, &source, &image);
+    defer testing.allocator.free(patch);
+
+    for ([_]Kind{ .full, .delta }) |kind| {
+        const payload: []const u8 = if (kind == .full) &image else patch;
+        var cut: u64 = 700;
+        while (cut < payload.len) : (cut += 2900) {
+            var rig = try Rig.init(&source);
+            defer rig.deinit();
+            var cut_fs = PowerCutFs(HostFs).init(&rig.host);
+            var engine = try Engine(PowerCutFs(HostFs), Suite).init(&cut_fs, .{ .checkpoint_bytes = 2048 });
+            defer engine.deinit();
+            _ = try engine.begin(.{
+                .kind = kind,
+                .image_size = image.len,
+                .image_sha256 = sha256(&image),
+                .source_sha256 = if (kind == .delta) sha256(&source) else null,
+            });
+
+            // Fail one write part way through, then retry it
+            cut_fs.cutAfter(cut);
+            var failed = false;
+            var i: usize = 0;
+            while (i < payload.len) : (i += 1000) {
+                const chunk = payload[i..@min(i + 1000, payload.len)];
+                engine.write(chunk) catch {
+                    failed = true;
+                    cut_fs.budget = null;
+                    cut_fs.tripped = false;
+                    try engine.write(chunk);
+                };
+            }
+            try testing.expect(failed);
+            try engine.finish();
+            try engine.activate();
+            try rig.expectSlot("ota/slot_b.bin", &image);
+        }
+    }
+}
+
+test "power loss at any point resumes to a verified image" {
+    var source: [12_000]u8 = undefined;
+    testImage(&source, 7);
+    var image: [20_000]u8 = undefined;
+    testImage(&image, 8);
+    @memcpy(image[5000..15_000], source[1000..11_000]);
+
+    const patch = try delta.encode(testing.allocator, &source, &image);
+    defer testing.allocator.free(patch);
+
+    var cut: u64 = 0;
+    while (try updateWithPowerCut(.full, &source, &image, &image, cut)) cut += 613;
+    try testing.expect(cut > image.len);
+
+    cut = 0;
+    while (try updateWithPowerCut(.delta, &source, &image, patch, cut)) cut += 613;
+    try testing.expect(cut > image.len);
+}
+
+test {
+    _ = delta;
+    _ = journal;
+    _ = power_cut;
+}
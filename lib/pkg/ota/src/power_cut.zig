@@ -0,0 +1,166 @@
+//! Power-loss simulator for trait.fs drivers
+//!
+//! Wraps any driver with `open(path, mode) ?File` and lets a test cut the
+//! power after a byte budget. The write that crosses the budget is torn
+//! (only its first bytes land) and every later write or sync fails, as if
+//! the device stopped mid-operation. "Reboot" by dropping the wrapper and
+//! re-opening the same backing files.
+//!
+//! Writes land in order with no write-back cache, like NOR flash or a
+//! file synced after every write; `File.sync` ordering is what the OTA
+//! engine relies on to make that assumption safe on real media.
+//!
+//! Usage:
+//!   var cut = PowerCutFs(std_impl.fs.Fs).init(&host_fs);
+//!   cut.cutAfter(4096);
+//!   var engine = try Engine.init(&cut, .{});
+//!   ... // fails with error.Io once the budget is spent
+//!   try testing.expect(cut.tripped);
+
+const std = @import("std");
+const trait = @import("trait");
+
+const File = trait.fs.File;
+
+pub fn PowerCutFs(comptime Inner: type) type {
+    return struct {
+        const Self = @This();
+        const max_files = 8;
+
+        const Wrapped = struct {
+            used: bool = false,
+            owner: *Self = undefined,
+            inner: File = undefined,
+        };
+
+        inner: *Inner,
+        /// Bytes that may still be written before the cut (null = no cut)
+        budget: ?u64 = null,
+        /// Set once the power has been cut
+        tripped: bool = false,
+        /// Total bytes written through the wrapper
+        bytes_written: u64 = 0,
+        files: [max_files]Wrapped = [_]Wrapped{.{}} ** max_files,
+
+        pub fn init(inner: *Inner) Self {
+            return .{ .inner = inner };
+        }
+
+        /// Cut the power once `bytes` more bytes have been written.
+        pub fn cutAfter(self: *Self, bytes: u64) void {
+            self.budget = bytes;
+            self.tripped = false;
+        }
+
+        pub fn open(self: *Self, path: []const u8, mode: trait.fs.OpenMode) ?File {
+            if (self.tripped) return null;
+            const w = for (&self.files) |*f| {
+                if (!f.used) break f;
+            } else return null;
+            const inner = self.inner.open(path, mode) orelse return null;
+            w.* = .{ .used = true, .owner = self, .inner = inner };
+            return .{
+                .data = inner.data,
+                .ctx = @ptrCast(w),
+                .readFn = &read,
+                .writeFn = &write,
+                .seekFn = &seek,
+                .preadFn = &pread,
+                .pwriteFn = &pwrite,
+                .adviseFn = &advise,
+                .syncFn = &sync,
+                .closeFn = &close,
+                .size = inner.size,
+            };
+        }
+
+        /// How many of `len` bytes may land before the cut.
+        fn allow(self: *Self, len: usize) usize {
+            if (self.tripped) return 0;
+            const budget = self.budget orelse return len;
+            if (len <= budget) {
+                self.budget = budget - len;
+                return len;
+            }
+            self.budget = 0;
+            self.tripped = true;
+            return @intCast(budget);
+        }
+
+        fn of(ctx: *anyopaque) *Wrapped {
+            return @ptrCast(@alignCast(ctx));
+        }
+
+        fn read(ctx: *anyopaque, buf: []u8) usize {
+            return of(ctx).inner.read(buf);
+        }
+
+        fn write(ctx: *anyopaque, data: []const u8) usize {
+            const w = of(ctx);
+            const n = w.owner.allow(data.len);
+            if (n == 0) return 0;
+            const done = w.inner.write(data[0..n]);
+            w.owner.bytes_written += done;
+            return if (w.owner.tripped) 0 else done;
+        }
+
+        fn seek(ctx: *anyopaque, offset: i64, whence: trait.fs.Whence) ?u64 {
+            return of(ctx).inner.seek(offset, whence);
+        }
+
+        fn pread(ctx: *anyopaque, buf: []u8, offset: u64) usize {
+            return of(ctx).inner.pread(buf, offset);
+        }
+
+        fn pwrite(ctx: *anyopaque, data: []const u8, offset: u64) usize {
+            const w = of(ctx);
+            const n = w.owner.allow(data.len);
+            if (n == 0) return 0;
+            const done = w.inner.pwrite(data[0..n], offset);
+            w.owner.bytes_written += done;
+            return if (w.owner.tripped) 0 else done;
+        }
+
+        fn advise(ctx: *anyopaque, offset: u64, len: u64, advice: trait.fs.Advice) void {
+            of(ctx).inner.advise(offset, len, advice);
+        }
+
+        fn sync(ctx: *anyopaque) bool {
+            const w = of(ctx);
+            if (w.owner.tripped) return false;
+            return w.inner.sync();
+        }
+
+        fn close(ctx: *anyopaque) void {
+            const w = of(ctx);
+            w.inner.close();
+            w.used = false;
+        }
+    };
+}
+
+// ============================================================================
+// Tests
+// ============================================================================
+
+test "write crossing the budget is torn, later writes fail" {
+    const std_impl = @import("std_impl");
+    var tmp = std.testing.tmpDir(.{});
+    defer tmp.cleanup();
+    var host = std_impl.fs.Fs.initDir(tmp.dir);
+    defer host.deinit();
+
+    var cut = PowerCutFs(std_impl.fs.Fs).init(&host);
+    cut.cutAfter(6);
+    var file = cut.open("/x.bin", .read_write) orelse return error.TestUnexpectedResult;
+    try std.testing.expectEqual(@as(usize, 4), file.pwrite("abcd", 0));
+    try std.testing.expectEqual(@as(usize, 0), file.pwrite("efgh", 4));
+    try std.testing.expect(cut.tripped);
+    try std.testing.expect(!file.sync());
+    try std.testing.expectEqual(@as(usize, 0), file.pwrite("z", 0));
+    file.close();
+
+    var buf: [8]u8 = undefined;
+    const got = try tmp.dir.readFile("x.bin", &buf);
+    try std.testing.expectEqualStrings("abcdef", got);
+}
@@ -0,0 +1,156 @@
+//! OTA patch-apply throughput benchmark.
+//!
+//! Builds an 8 MiB firmware-like image and a "next release" that keeps
+//! most code but shifts a region and rewrites pointer words in it (what a
+//! relink does), then compares:
+//!
+//!   - full image: stream every byte into the inactive slot
+//!   - delta: stream the patch, rebuilding the image from the running slot
+//!   - patcher only: delta apply into memory (no slot I/O, no hashing)
+//!
+//! Throughput is reported in MB/s of rebuilt image; the wire column is
+//! what had to be downloaded.
+
+const std = @import("std");
+const ota = @import("ota");
+const std_impl = @import("std_impl");
+const Suite = @import("crypto");
+const trait = @import("trait");
+const print = std.debug.print;
+const testing = std.testing;
+
+const IMAGE_SIZE = 8 * 1024 * 1024;
+const CHUNK = 4096;
+
+const HostFs = std_impl.fs.Fs;
+const Ota = ota.Engine(HostFs, Suite);
+
+fn sha256(data: []const u8) [32]u8 {
+    var out: [32]u8 = undefined;
+    std.crypto.hash.sha2.Sha256.hash(data, &out, .{});
+    return out;
+}
+
+/// Old image: random "code". New image: 64 KiB of new code inserted at
+/// 1 MiB, every 16th word of the following 4 MiB relocated, the rest kept.
+fn buildImages(allocator: std.mem.Allocator) !struct { []u8, []u8 } {
+    const old = try allocator.alloc(u8, IMAGE_SIZE);
+    var prng = std.Random.DefaultPrng.init(0x07A);
+    prng.random().bytes(old);
+
+    const new = try allocator.alloc(u8, IMAGE_SIZE);
+    const insert = 64 * 1024;
+    const moved = 4 * 1024 * 1024;
+    const at = 1024 * 1024;
+    @memcpy(new[0..at], old[0..at]);
+    prng.random().bytes(new[at..][0..insert]);
+    @memcpy(new[at + insert ..][0..moved], old[at..][0..moved]);
+    var i: usize = at + insert;
+    while (i < at + insert + moved) : (i += 64) {
+        const w = std.mem.readInt(u32, new[i..][0..4], .little);
+        std.mem.writeInt(u32, new[i..][0..4], w +% insert, .little);
+    }
+    @memcpy(new[at + insert + moved ..], old[at + moved ..][0 .. IMAGE_SIZE - at - insert - moved]);
+    return .{ old, new };
+}
+
+const Result = struct {
+    ns: u64,
+    wire: usize,
+};
+
+fn report(name: []const u8, r: Result) void {
+    const mb = @as(f64, IMAGE_SIZE) / (1024 * 1024);
+    const secs = @as(f64, @floatFromInt(@max(r.ns, 1))) / 1e9;
+    print("[bench]   {s:<22} {d:>8.1} MB/s  wire {d:>9} bytes ({d:>5.1}%)\n", .{
+        name,
+        mb / secs,
+        r.wire,
+        @as(f64, @floatFromInt(r.wire)) * 100 / IMAGE_SIZE,
+    });
+}
+
+fn runEngine(dir: std.fs.Dir, old: []const u8, m: ota.Manifest, payload: []const u8) !Result {
+    try dir.writeFile(.{ .sub_path = "ota/slot_a.bin", .data = old });
+    dir.deleteFile("ota/state.bin") catch {};
+    var fs = HostFs.initDir(dir);
+    defer fs.deinit();
+    var engine = try Ota.init(&fs, .{ .checkpoint_bytes = 256 * 1024 });
+    defer engine.deinit();
+
+    var timer = try std.time.Timer.start();
+    _ = try engine.begin(m);
+    var i: usize = 0;
+    while (i < payload.len) : (i += CHUNK) {
+        try engine.write(payload[i..@min(i + CHUNK, payload.len)]);
+    }
+    try engine.finish();
+    return .{ .ns = timer.read(), .wire = payload.len };
+}
+
+const NullSink = struct {
+    sum: u64 = 0,
+
+    fn write(ctx: *anyopaque, bytes: []const u8) bool {
+        const self: *NullSink = @ptrCast(@alignCast(ctx));
+        self.sum +%= bytes[0] +% bytes[bytes.len - 1];
+        return true;
+    }
+};
+
+fn noClose(_: *anyopaque) void {}
+
+fn patcherOnly(old: []const u8, patch: []const u8) !Result {
+    var source = trait.fs.File{ .data = old, .ctx = undefined, .closeFn = &noClose, .size = old.len };
+    var sink = NullSink{};
+    var scratch: [ota.buffer_size]u8 = undefined;
+    var p = ota.delta.Patcher{};
+
+    var timer = try std.time.Timer.start();
+    var i: usize = 0;
+    while (i < patch.len) : (i += CHUNK) {
+        try p.feed(patch[i..@min(i + CHUNK, patch.len)], &source, &scratch, .{
+            .ctx = @ptrCast(&sink),
+            .writeFn = &NullSink.write,
+        });
+    }
+    const ns = timer.read();
+    try testing.expect(p.isComplete());
+    std.mem.doNotOptimizeAway(sink.sum);
+    return .{ .ns = ns, .wire = patch.len };
+}
+
+test "BM1: 8 MiB image, full download vs delta patch" {
+    const old, const new = try buildImages(testing.allocator);
+    defer testing.allocator.free(old);
+    defer testing.allocator.free(new);
+
+    var timer = try std.time.Timer.start();
+    const patch = try ota.delta.encode(testing.allocator, old, new);
+    defer testing.allocator.free(patch);
+    const encode_ms = timer.read() / std.time.ns_per_ms;
+
+    var tmp = testing.tmpDir(.{});
+    defer tmp.cleanup();
+    try tmp.dir.makeDir("ota");
+
+    const full_m = ota.Manifest{ .image_size = new.len, .image_sha256 = sha256(new) };
+    var delta_m = full_m;
+    delta_m.kind = .delta;
+    delta_m.source_sha256 = sha256(old);
+
+    print("\n[bench] {d} MiB image, patch encoded in {d} ms, {d} KiB scratch\n", .{
+        IMAGE_SIZE / (1024 * 1024), encode_ms, ota.buffer_size / 1024,
+    });
+    const full = try runEngine(tmp.dir, old, full_m, new);
+    const patched = try runEngine(tmp.dir, old, delta_m, patch);
+    const raw = try patcherOnly(old, patch);
+    report("full image (engine)", full);
+    report("delta (engine)", patched);
+    report("delta (patcher only)", raw);
+
+    const slot = try tmp.dir.readFileAlloc(testing.allocator, "ota/slot_b.bin", IMAGE_SIZE);
+    defer testing.allocator.free(slot);
+    try testing.expectEqualSlices(u8, new, slot);
+    try testing.expect(patch.len * 2 < new.len);
+}
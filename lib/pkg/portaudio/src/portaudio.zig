@@ -22,6 +22,13 @@
 //!     try stream.stop();
 //! }
 //! ```
+//!
+//! Every stream keeps xrun counters (`stats()`): underflow/overflow status
+//! flags of callback streams, and `paOutputUnderflowed` /
+//! `paInputOverflowed` results of blocking streams, which are counted
+//! rather than returned as errors (the data was still transferred).
+//! Callback streams also count late callbacks: ones that finish after the
+//! DAC time of the buffer they fill.
 
 const std = @import("std");
 
@@ -186,6 +193,98 @@ pub const StreamConfig = struct {
     device: DeviceIndex = c.paNoDevice,
 };
 
+// ============================================================================
+// Stream Statistics
+// ============================================================================
+
+pub const Stats = struct {
+    /// Callbacks run, or blocking reads/writes done
+    buffers: u64 = 0,
+    output_underflows: u64 = 0,
+    output_overflows: u64 = 0,
+    input_underflows: u64 = 0,
+    input_overflows: u64 = 0,
+    /// Callbacks that finished after their buffer's DAC time
+    late: u64 = 0,
+    /// Longest callback, when the host API reports stream times
+    max_exec_ns: u64 = 0,
+    /// Smallest margin between a callback's end and its buffer's DAC
+    /// time; null until measured
+    min_slack_ns: ?u64 = null,
+
+    pub fn xruns(self: *const Stats) u64 {
+        return self.output_underflows + self.output_overflows + self.input_underflows + self.input_overflows;
+    }
+
+    /// Glitches a listener can hear: xruns plus late callbacks
+    pub fn glitches(self: *const Stats) u64 {
+        return self.xruns() + self.late;
+    }
+};
+
+/// Counters behind `Stats`. Written by the audio (or blocking I/O) thread
+/// only, so plain load/store pairs suffice; read from any thread.
+const Counters = struct {
+    const Counter = std.atomic.Value(u64);
+    const no_slack = std.math.maxInt(u64);
+
+    buffers: Counter = .init(0),
+    output_underflows: Counter = .init(0),
+    output_overflows: Counter = .init(0),
+    input_underflows: Counter = .init(0),
+    input_overflows: Counter = .init(0),
+    late: Counter = .init(0),
+    max_exec_ns: Counter = .init(0),
+    min_slack_ns: Counter = .init(no_slack),
+
+    fn bump(counter: *Counter) void {
+        counter.store(counter.load(.monotonic) + 1, .monotonic);
+    }
+
+    /// Count the status flags of one callback. Priming buffers are not
+    /// xruns.
+    fn flags(self: *Counters, status: c.PaStreamCallbackFlags) void {
+        bump(&self.buffers);
+        if (status & c.paOutputUnderflow != 0) bump(&self.output_underflows);
+        if (status & c.paOutputOverflow != 0) bump(&self.output_overflows);
+        if (status & c.paInputUnderflow != 0) bump(&self.input_underflows);
+        if (status & c.paInputOverflow != 0) bump(&self.input_overflows);
+    }
+
+    /// Time one callback that started at `info.currentTime` and ended at
+    /// `end` (stream time, seconds)
+    fn timing(self: *Counters, info: *const c.PaStreamCallbackTimeInfo, end: c.PaTime) void {
+        // Some host APIs leave the times at zero
+        if (info.currentTime <= 0 or end <= 0) return;
+        const exec = secsToNs(end - info.currentTime);
+        if (exec > self.max_exec_ns.load(.monotonic)) self.max_exec_ns.store(exec, .monotonic);
+
+        if (info.outputBufferDacTime <= 0) return;
+        const slack = info.outputBufferDacTime - end;
+        if (slack <= 0) return bump(&self.late);
+        const slack_ns = secsToNs(slack);
+        if (slack_ns < self.min_slack_ns.load(.monotonic)) self.min_slack_ns.store(slack_ns, .monotonic);
+    }
+
+    fn snapshot(self: *const Counters) Stats {
+        const slack = self.min_slack_ns.load(.monotonic);
+        return .{
+            .buffers = self.buffers.load(.monotonic),
+            .output_underflows = self.output_underflows.load(.monotonic),
+            .output_overflows = self.output_overflows.load(.monotonic),
+            .input_underflows = self.input_underflows.load(.monotonic),
+            .input_overflows = self.input_overflows.load(.monotonic),
+            .late = self.late.load(.monotonic),
+            .max_exec_ns = self.max_exec_ns.load(.monotonic),
+            .min_slack_ns = if (slack == no_slack) null else slack,
+        };
+    }
+
+    fn secsToNs(secs: c.PaTime) u64 {
+        return @intFromFloat(@max(secs, 0) * std.time.ns_per_s);
+    }
+};
+
 // ============================================================================
 // Output Stream (blocking write)
 // ============================================================================
@@ -196,6 +295,7 @@ pub fn OutputStream(comptime SampleType: type) type {
 
         stream: ?*c.PaStream,
         config: StreamConfig,
+        counters: Counters = .{},
 
         pub fn open(cfg: StreamConfig) Error!Self {
             var self = Self{
@@ -246,12 +346,21 @@ pub fn OutputStream(comptime SampleType: type) type {
             }
         }
 
+        /// Write interleaved samples. An underflow before this write is
+        /// counted in `stats()`, not returned.
         pub fn write(self: *Self, buffer: []const SampleType) Error!void {
             if (self.stream) |s| {
                 const frames = @divExact(buffer.len, @as(usize, @intCast(self.config.channels)));
-                try check(c.Pa_WriteStream(s, buffer.ptr, @intCast(frames)));
+                const code = c.Pa_WriteStream(s, buffer.ptr, @intCast(frames));
+                Counters.bump(&self.counters.buffers);
+                if (code == c.paOutputUnderflowed) return Counters.bump(&self.counters.output_underflows);
+                try check(code);
             }
         }
+
+        pub fn stats(self: *const Self) Stats {
+            return self.counters.snapshot();
+        }
     };
 }
 
@@ -265,6 +374,7 @@ pub fn InputStream(comptime SampleType: type) type {
 
         stream: ?*c.PaStream,
         config: StreamConfig,
+        counters: Counters = .{},
 
         pub fn open(cfg: StreamConfig) Error!Self {
             var self = Self{
@@ -315,12 +425,21 @@ pub fn InputStream(comptime SampleType: type) type {
             }
         }
 
+        /// Read interleaved samples. An overflow before this read is
+        /// counted in `stats()`, not returned.
         pub fn read(self: *Self, buffer: []SampleType) Error!void {
             if (self.stream) |s| {
                 const frames = @divExact(buffer.len, @as(usize, @intCast(self.config.channels)));
-                try check(c.Pa_ReadStream(s, buffer.ptr, @intCast(frames)));
+                const code = c.Pa_ReadStream(s, buffer.ptr, @intCast(frames));
+                Counters.bump(&self.counters.buffers);
+                if (code == c.paInputOverflowed) return Counters.bump(&self.counters.input_overflows);
+                try check(code);
             }
         }
+
+        pub fn stats(self: *const Self) Stats {
+            return self.counters.snapshot();
+        }
     };
 }
 
@@ -344,11 +463,20 @@ pub fn CallbackStream(comptime SampleType: type) type {
             user_data: ?*anyopaque,
         ) CallbackResult;
 
+        /// Called once on the audio thread, before the first callback.
+        /// The place to apply a real-time policy to a thread the host API
+        /// created (e.g. `std_impl.realtime.promote`).
+        pub const ThreadHook = *const fn (user_data: ?*anyopaque) void;
+
         /// Context passed to PortAudio callback wrapper
         const CallbackContext = struct {
             callback: Callback,
             user_data: ?*anyopaque,
             channels: i32,
+            stream: ?*c.PaStream = null,
+            on_audio_thread: ?ThreadHook = null,
+            hook_ran: bool = false,
+            counters: Counters = .{},
         };
 
         stream: ?*c.PaStream,
@@ -393,14 +521,24 @@ pub fn CallbackStream(comptime SampleType: type) type {
                     _: ?*const anyopaque,
                     output: ?*anyopaque,
                     frame_count: c_ulong,
-                    _: [*c]const c.PaStreamCallbackTimeInfo,
-                    _: c.PaStreamCallbackFlags,
+                    time_info: [*c]const c.PaStreamCallbackTimeInfo,
+                    status: c.PaStreamCallbackFlags,
                     user: ?*anyopaque,
                 ) callconv(.c) c_int {
                     const ctx: *CallbackContext = @ptrCast(@alignCast(user));
+                    if (!ctx.hook_ran) {
+                        ctx.hook_ran = true;
+                        if (ctx.on_audio_thread) |hook| hook(ctx.user_data);
+                    }
+                    ctx.counters.flags(status);
+
                     const out_ptr: [*]SampleType = @ptrCast(@alignCast(output));
                     const total_samples = frame_count * @as(c_ulong, @intCast(ctx.channels));
                     const result = ctx.callback(out_ptr[0..total_samples], frame_count, ctx.user_data);
+
+                    if (time_info != null) {
+                        if (ctx.stream) |s| ctx.counters.timing(time_info, c.Pa_GetStreamTime(s));
+                    }
                     return @intFromEnum(result);
                 }
             };
@@ -415,6 +553,25 @@ pub fn CallbackStream(comptime SampleType: type) type {
                 CallbackWrapper.cb,
                 &self.context,
             ));
+            self.context.stream = self.stream;
+        }
+
+        /// Set the hook run on the audio thread before the first callback.
+        /// Call before `start`.
+        pub fn onAudioThread(self: *Self, hook: ThreadHook) void {
+            self.context.on_audio_thread = hook;
+            self.context.hook_ran = false;
+        }
+
+        pub fn stats(self: *const Self) Stats {
+            return self.context.counters.snapshot();
+        }
+
+        /// Share of the period spent in the callback, as measured by the
+        /// host API (0..1; 0 if unavailable)
+        pub fn cpuLoad(self: *const Self) f64 {
+            const s = self.stream orelse return 0;
+            return c.Pa_GetStreamCpuLoad(s);
         }
 
         pub fn close(self: *Self) void {
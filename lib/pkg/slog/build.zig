@@ -0,0 +1,39 @@
+const std = @import("std");
+
+pub fn build(b: *std.Build) void {
+    const target = b.standardTargetOptions(.{});
+    const optimize = b.standardOptimizeOption(.{});
+
+    const trait_dep = b.dependency("trait", .{
+        .target = target,
+        .optimize = optimize,
+    });
+
+    // Module
+    const slog_mod = b.addModule("slog", .{
+        .root_source_file = b.path("src/slog.zig"),
+        .target = target,
+        .optimize = optimize,
+    });
+    slog_mod.addImport("trait", trait_dep.module("trait"));
+
+    // Test-only dependency: host fs driver
+    const std_impl_dep = b.dependency("std_impl", .{
+        .target = target,
+        .optimize = optimize,
+    });
+
+    // Tests
+    const test_step = b.step("test", "Run slog tests");
+    const tests = b.addTest(.{
+        .root_module = b.createModule(.{
+            .root_source_file = b.path("src/slog.zig"),
+            .target = target,
+            .optimize = optimize,
+        }),
+    });
+    tests.root_module.addImport("trait", trait_dep.module("trait"));
+    tests.root_module.addImport("std_impl", std_impl_dep.module("std_impl"));
+    const run_tests = b.addRunArtifact(tests);
+    test_step.dependOn(&run_tests.step);
+}
@@ -0,0 +1,220 @@
+//! Deferred argument encoding
+//!
+//! A log call site is a comptime format string and an argument tuple
+//! type. `Codec(fmt, Args)` turns that pair into two functions:
+//!
+//! - `encode` copies the argument values into a record payload: integers,
+//!   floats, bools, enums and error values as their raw bytes, strings as
+//!   a length byte and the (possibly truncated) bytes. No formatting.
+//! - `render` decodes a payload back into a tuple and runs `std.fmt` on
+//!   it. This is what the drain side calls, off the hot path.
+//!
+//! `render` is stored in the record as a function pointer, so one ring
+//! holds records from every call site without a format-string table.
+//!
+//! Call sites whose arguments cannot be copied by value (structs,
+//! optionals, slices of anything but u8, `{f}`-style formatters) or whose
+//! fixed-size part does not fit a payload fall back to formatting eagerly
+//! into the payload; `Codec(...).deferred` tells which path a site takes.
+
+const std = @import("std");
+
+/// Record payload bytes (arguments or eagerly formatted text)
+pub const payload_len = 96;
+
+/// Renders a payload into `out`; returns the bytes written (truncated to
+/// `out.len`)
+pub const RenderFn = fn (payload: []const u8, out: []u8) usize;
+
+const Kind = enum { value, string, unsupported };
+
+fn kindOf(comptime T: type) Kind {
+    return switch (@typeInfo(T)) {
+        .int, .float, .bool, .@"enum", .error_set, .comptime_int, .comptime_float => .value,
+        .pointer => |p| switch (p.size) {
+            .slice => if (p.child == u8) .string else .unsupported,
+            .one => switch (@typeInfo(p.child)) {
+                .array => |a| if (a.child == u8) .string else .unsupported,
+                else => .unsupported,
+            },
+            else => .unsupported,
+        },
+        else => .unsupported,
+    };
+}
+
+/// Type an argument is stored and decoded as
+fn Stored(comptime T: type) type {
+    return switch (@typeInfo(T)) {
+        .comptime_int => i64,
+        .comptime_float => f64,
+        .pointer => []const u8,
+        else => T,
+    };
+}
+
+pub fn Codec(comptime fmt: []const u8, comptime Args: type) type {
+    const fields = @typeInfo(Args).@"struct".fields;
+
+    const layout = comptime blk: {
+        var types: [fields.len]type = undefined;
+        var ok = true;
+        // Bytes taken by value fields plus one length byte per string
+        var fixed: usize = 0;
+        for (fields, 0..) |f, i| {
+            types[i] = Stored(f.type);
+            switch (kindOf(f.type)) {
+                .value => fixed += @sizeOf(types[i]),
+                .string => fixed += 1,
+                .unsupported => ok = false,
+            }
+        }
+        break :blk .{ .types = types, .deferred = ok and fixed <= payload_len };
+    };
+
+    return struct {
+        /// True when arguments are copied and formatted at drain time
+        pub const deferred = layout.deferred;
+        const Decoded = std.meta.Tuple(&layout.types);
+
+        /// Write the record payload for `args`; returns its length
+        pub fn encode(out: *[payload_len]u8, args: Args) usize {
+            if (!deferred) return formatInto(out, fmt, args);
+
+            var off: usize = 0;
+            inline for (fields, 0..) |f, i| {
+                const T = layout.types[i];
+                switch (comptime kindOf(f.type)) {
+                    .value => {
+                        const v: T = @field(args, f.name);
+                        @memcpy(out[off..][0..@sizeOf(T)], std.mem.asBytes(&v));
+                        off += @sizeOf(T);
+                    },
+                    .string => {
+                        const s: []const u8 = @field(args, f.name);
+                        // Strings share what the fields after them leave
+                        const room = payload_len - off - 1 - comptime fixedAfter(i);
+                        const n: u8 = @intCast(@min(s.len, room, 255));
+                        out[off] = n;
+                        @memcpy(out[off + 1 ..][0..n], s[0..n]);
+                        off += 1 + n;
+                    },
+                    .unsupported => unreachable,
+                }
+            }
+            return off;
+        }
+
+        /// Format a payload written by `encode`
+        pub fn render(payload: []const u8, out: []u8) usize {
+            if (!deferred) return copyText(payload, out);
+
+            var args: Decoded = undefined;
+            var off: usize = 0;
+            inline for (fields, 0..) |f, i| {
+                const T = layout.types[i];
+                switch (comptime kindOf(f.type)) {
+                    .value => {
+                        args[i] = std.mem.bytesToValue(T, payload[off..][0..@sizeOf(T)]);
+                        off += @sizeOf(T);
+                    },
+                    .string => {
+                        const n = payload[off];
+                        args[i] = payload[off + 1 ..][0..n];
+                        off += 1 + n;
+                    },
+                    .unsupported => unreachable,
+                }
+            }
+            return formatInto(out, fmt, args);
+        }
+
+        /// Bytes reserved for the fields after field `i`
+        fn fixedAfter(comptime i: usize) usize {
+            var n: usize = 0;
+            for (fields[i + 1 ..], layout.types[i + 1 ..]) |f, T| {
+                n += if (kindOf(f.type) == .value) @sizeOf(T) else 1;
+            }
+            return n;
+        }
+    };
+}
+
+/// `std.fmt` into `out`, keeping what fits
+pub fn formatInto(out: []u8, comptime fmt: []const u8, args: anytype) usize {
+    var fbs = std.io.fixedBufferStream(out);
+    std.fmt.format(fbs.writer(), fmt, args) catch {};
+    return fbs.pos;
+}
+
+fn copyText(payload: []const u8, out: []u8) usize {
+    const n = @min(payload.len, out.len);
+    @memcpy(out[0..n], payload[0..n]);
+    return n;
+}
+
+// ============================================================================
+// Tests
+// ============================================================================
+
+const testing = std.testing;
+
+/// Encode, render, and compare with formatting the arguments directly
+fn expectRoundTrip(comptime fmt: []const u8, args: anytype) !void {
+    const C = Codec(fmt, @TypeOf(args));
+    var payload: [payload_len]u8 = undefined;
+    const len = C.encode(&payload, args);
+    var out: [256]u8 = undefined;
+    const n = C.render(payload[0..len], &out);
+
+    var want_buf: [256]u8 = undefined;
+    const want = want_buf[0..formatInto(&want_buf, fmt, args)];
+    // Eager text is cut at the payload size
+    const keep = if (C.deferred) want.len else @min(want.len, payload_len);
+    try testing.expectEqualStrings(want[0..keep], out[0..n]);
+}
+
+test "values and strings are copied, formatted on render" {
+    const Mode = enum { idle, run };
+    var name_buf = "sensor-a".*;
+    const name: []const u8 = &name_buf;
+    const Args = @TypeOf(.{ name, @as(u16, 7), @as(f32, 1.5), true, "lit", Mode.run });
+    const C = Codec("{s} {d} {d:.2} {} {s} {}", Args);
+    try testing.expect(C.deferred);
+
+    var payload: [payload_len]u8 = undefined;
+    const len = C.encode(&payload, .{ name, @as(u16, 7), @as(f32, 1.5), true, "lit", Mode.run });
+    // The payload owns its copy of the string
+    name_buf[0] = 'X';
+
+    var out: [128]u8 = undefined;
+    const n = C.render(payload[0..len], &out);
+    try testing.expect(std.mem.startsWith(u8, out[0..n], "sensor-a 7 1.50 true lit "));
+    try testing.expect(std.mem.endsWith(u8, out[0..n], "run"));
+}
+
+test "comptime numbers and errors" {
+    try testing.expect(Codec("{d} {d} {}", @TypeOf(.{ 42, 2.5, error.Timeout })).deferred);
+    try expectRoundTrip("{d} {d} {}", .{ 42, 2.5, error.Timeout });
+    try expectRoundTrip("no args", .{});
+}
+
+test "long strings are truncated to the payload" {
+    const long = "x" ** 300;
+    const C = Codec("{s}|{d}|{s}", @TypeOf(.{ long, @as(u32, 9), "tail" }));
+    var payload: [payload_len]u8 = undefined;
+    const len = C.encode(&payload, .{ long, @as(u32, 9), "tail" });
+    var out: [256]u8 = undefined;
+    const got = out[0..C.render(payload[0..len], &out)];
+
+    // The first string takes the room; the fields after it still decode
+    try testing.expectEqual(@as(usize, payload_len), len);
+    try testing.expect(std.mem.endsWith(u8, got, "|9|"));
+}
+
+test "unsupported arguments fall back to eager formatting" {
+    const P = struct { x: i32, y: i32 };
+    try testing.expect(!Codec("{any}", @TypeOf(.{P{ .x = 1, .y = 2 }})).deferred);
+    try expectRoundTrip("at {any}", .{P{ .x = 1, .y = 2 }});
+    try expectRoundTrip("{any} " ++ "pad" ** 40, .{P{ .x = 3, .y = 4 }});
+}
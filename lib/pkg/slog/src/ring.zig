@@ -0,0 +1,256 @@
+//! Lock-free record ring
+//!
+//! Fixed-size slots, any number of writers (tasks, ISRs that may log),
+//! one drainer. Writers never wait and never allocate:
+//!
+//! 1. Take a ticket with one fetch-add on `head`. Ticket `t` owns slot
+//!    `t % N` for this lap.
+//! 2. Claim the slot by moving its sequence to `2t + 1` (odd: being
+//!    written).
+//! 3. Fill the entry and publish it with sequence `2t + 2`.
+//!
+//! If a writer from an older lap is still inside the slot (it was
+//! preempted for a whole lap), the new record is dropped. The sequence
+//! still moves to `2t + 1`, so the older writer sees that it was
+//! overtaken and publishes a tombstone under ticket `t` instead of its
+//! entry; its own record is gone too. A writer that finds its slot
+//! already taken by a later lap drops its record as well. Every ticket
+//! ends up published, tombstoned or overwritten, so the drainer never
+//! waits on a record that will not come.
+//!
+//! Writers count nothing: `push` only reports whether the record was
+//! stored, and the drainer accounts for every ticket exactly once (read,
+//! `dropped` tombstone, or overwritten / skipped).
+//!
+//! Old records are overwritten, never waited for: a slow drainer loses
+//! the oldest records, the hot path keeps its latency. The drainer reads
+//! a slot, copies it, and re-checks the sequence (a seqlock), so a record
+//! overwritten mid-copy is detected rather than returned torn.
+//!
+//! Tickets and sequences wrap; all comparisons use wrapping differences.
+
+const std = @import("std");
+const record = @import("record.zig");
+
+pub const Level = std.log.Level;
+
+/// One record as copied out of the ring
+pub const Entry = struct {
+    ts_us: u64,
+    render: *const record.RenderFn,
+    level: Level,
+    /// Index into the logger's module table
+    module: u8,
+    len: u8,
+    payload: [record.payload_len]u8,
+
+    /// `len` of an entry published for a dropped record
+    pub const tombstone = 0xFF;
+
+    pub fn text(self: *const Entry, out: []u8) []const u8 {
+        return out[0..self.render(self.payload[0..self.len], out)];
+    }
+};
+
+pub const Read = enum {
+    /// Entry copied
+    ok,
+    /// Not yet published (or the writer is still inside)
+    pending,
+    /// Overwritten by a later lap
+    overwritten,
+    /// Tombstone: the record was dropped while an older writer was
+    /// still in the slot
+    dropped,
+};
+
+pub fn Ring(comptime slots: usize) type {
+    if (slots == 0 or !std.math.isPowerOfTwo(slots)) @compileError("slog ring size must be a power of two");
+
+    return struct {
+        const Self = @This();
+        pub const capacity = slots;
+
+        const Slot = struct {
+            seq: std.atomic.Value(usize) = .init(0),
+            entry: Entry = undefined,
+        };
+
+        head: std.atomic.Value(usize) = .init(0),
+        slots: [slots]Slot = [_]Slot{.{}} ** slots,
+
+        /// Reserve a slot, let `fill` write the entry, publish it.
+        /// Returns false if the record was dropped or, once written,
+        /// replaced by a tombstone because a later lap overtook it.
+        /// Drops are not counted here; the drainer sees each one.
+        pub fn push(self: *Self, ctx: anytype, comptime fill: fn (@TypeOf(ctx), *Entry) void) bool {
+            return self.pushTicket(self.head.fetchAdd(1, .monotonic), ctx, fill);
+        }
+
+        /// `push` under a ticket already taken (tests use it to resume a
+        /// stalled writer)
+        fn pushTicket(self: *Self, t: usize, ctx: anytype, comptime fill: fn (@TypeOf(ctx), *Entry) void) bool {
+            const slot = &self.slots[t % slots];
+            const writing = 2 *% t +% 1;
+
+            var cur = slot.seq.load(.monotonic);
+            while (true) {
+                if (!older(cur, writing)) return false;
+                if (cur & 1 == 1) {
+                    // An older lap is still inside: hand it our ticket
+                    cur = slot.seq.cmpxchgWeak(cur, writing, .monotonic, .monotonic) orelse return false;
+                    continue;
+                }
+                // Acquire keeps the entry writes below the claim
+                cur = slot.seq.cmpxchgWeak(cur, writing, .acquire, .monotonic) orelse break;
+            }
+            fill(ctx, &slot.entry);
+            return publish(slot, writing);
+        }
+
+        /// False when overtaken: the entry was replaced by a tombstone
+        fn publish(slot: *Slot, writing: usize) bool {
+            var cur = slot.seq.cmpxchgStrong(writing, writing +% 1, .release, .monotonic) orelse return true;
+            // Overtaken: publish the newest ticket handed to us, empty
+            slot.entry.len = Entry.tombstone;
+            while (slot.seq.cmpxchgWeak(cur, cur +% 1, .release, .monotonic)) |now| cur = now;
+            return false;
+        }
+
+        /// Copy the entry for ticket `t`
+        pub fn read(self: *Self, t: usize, out: *Entry) Read {
+            const slot = &self.slots[t % slots];
+            const done = 2 *% t +% 2;
+
+            const before = slot.seq.load(.acquire);
+            if (before != done) return if (older(before, done)) .pending else .overwritten;
+            out.* = slot.entry;
+            // A read-modify-write orders the copy before the re-check
+            // without a standalone fence
+            const after = slot.seq.fetchAdd(0, .acq_rel);
+            if (after != done) return .overwritten;
+            return if (out.len == Entry.tombstone) .dropped else .ok;
+        }
+
+        /// Next ticket to be handed out
+        pub fn end(self: *const Self) usize {
+            return self.head.load(.acquire);
+        }
+
+        /// `a` was written before `b`
+        fn older(a: usize, b: usize) bool {
+            const d: isize = @bitCast(b -% a);
+            return d > 0;
+        }
+    };
+}
+
+// ============================================================================
+// Tests
+// ============================================================================
+
+const testing = std.testing;
+
+fn noText(_: []const u8, _: []u8) usize {
+    return 0;
+}
+
+fn fillTs(ts: u64, e: *Entry) void {
+    e.* = .{ .ts_us = ts, .render = &noText, .level = .info, .module = 0, .len = 0, .payload = undefined };
+}
+
+test "records read back in ticket order; a lap later they are overwritten" {
+    var ring: Ring(4) = .{};
+    for (0..6) |i| try testing.expect(ring.push(@as(u64, i), fillTs));
+    try testing.expectEqual(@as(usize, 6), ring.end());
+
+    var e: Entry = undefined;
+    try testing.expectEqual(Read.overwritten, ring.read(0, &e));
+    try testing.expectEqual(Read.overwritten, ring.read(1, &e));
+    for (2..6) |t| {
+        try testing.expectEqual(Read.ok, ring.read(t, &e));
+        try testing.expectEqual(@as(u64, t), e.ts_us);
+    }
+    try testing.expectEqual(Read.pending, ring.read(6, &e));
+}
+
+test "a writer still inside its slot makes the next lap drop" {
+    const R = Ring(2);
+    var ring: R = .{};
+    // Ticket 0 claimed, still being written
+    _ = ring.head.fetchAdd(1, .monotonic);
+    ring.slots[0].seq.store(1, .monotonic);
+
+    try testing.expect(ring.push(@as(u64, 1), fillTs));
+    try testing.expect(!ring.push(@as(u64, 2), fillTs));
+
+    var e: Entry = undefined;
+    try testing.expectEqual(Read.pending, ring.read(0, &e));
+    try testing.expectEqual(Read.ok, ring.read(1, &e));
+    try testing.expectEqual(Read.pending, ring.read(2, &e));
+
+    // Ticket 0 finishes and finds it was overtaken: not stored either
+    fillTs(0, &ring.slots[0].entry);
+    try testing.expect(!R.publish(&ring.slots[0], 1));
+    try testing.expectEqual(Read.overwritten, ring.read(0, &e));
+    try testing.expectEqual(Read.dropped, ring.read(2, &e));
+}
+
+test "a writer overtaken before claiming its slot drops its record" {
+    var ring: Ring(2) = .{};
+    // Ticket 0 is taken but its writer stalls before claiming slot 0
+    _ = ring.head.fetchAdd(1, .monotonic);
+    try testing.expect(ring.push(@as(u64, 1), fillTs));
+    try testing.expect(ring.push(@as(u64, 2), fillTs));
+
+    // It resumes and finds slot 0 taken by ticket 2
+    try testing.expect(!ring.pushTicket(0, @as(u64, 0), fillTs));
+    var e: Entry = undefined;
+    try testing.expectEqual(Read.overwritten, ring.read(0, &e));
+    try testing.expectEqual(Read.ok, ring.read(2, &e));
+}
+
+test "concurrent writers: every published record is intact" {
+    const Ring64 = Ring(64);
+    const per_thread = 20_000;
+    const threads = 4;
+
+    const Writer = struct {
+        fn run(ring: *Ring64, id: u64) void {
+            for (0..per_thread) |i| {
+                _ = ring.push(id << 32 | i, struct {
+                    fn fill(v: u64, e: *Entry) void {
+                        fillTs(v, e);
+                        // Payload mirrors the timestamp, so a torn copy shows
+                        @memset(&e.payload, @truncate(v));
+                    }
+                }.fill);
+            }
+        }
+    };
+
+    var ring: Ring64 = .{};
+    var pool: [threads]std.Thread = undefined;
+    for (&pool, 0..) |*th, id| th.* = try std.Thread.spawn(.{}, Writer.run, .{ &ring, id });
+
+    // Drain concurrently
+    var next: usize = 0;
+    var seen: usize = 0;
+    var done = false;
+    while (!done) {
+        done = ring.end() == threads * per_thread;
+        const h = ring.end();
+        if (h - next > Ring64.capacity) next = h - Ring64.capacity;
+        var e: Entry = undefined;
+        while (next != h) : (next += 1) switch (ring.read(next, &e)) {
+            .ok => {
+                seen += 1;
+                for (e.payload) |b| try testing.expectEqual(@as(u8, @truncate(e.ts_us)), b);
+            },
+            .pending => break,
+            .overwritten, .dropped => {},
+        };
+    }
+    for (pool) |th| th.join();
+    try testing.expect(seen > 0);
+}
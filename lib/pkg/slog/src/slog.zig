@@ -0,0 +1,520 @@
+//! Structured Logging Backend
+//!
+//! A `trait.log` implementation for code that logs on hot paths. A log
+//! call copies its arguments into a lock-free in-memory ring and returns;
+//! formatting and I/O happen later, when the application drains the ring
+//! to a sink (the platform log, a `Store` file, a socket):
+//!
+//! - **Deferred formatting**: arguments are stored as raw values and
+//!   formatted at drain time (see `record.zig`). A call costs a timestamp,
+//!   a rate check and a ~100-byte copy, whatever the format string.
+//! - **Rate limits**: each module gets a token bucket (`rate_per_s`,
+//!   `burst`). Records over the limit are counted, not stored, and the
+//!   next record that passes is preceded by "suppressed N records", so a
+//!   chatty module cannot flush the ring or stall its caller.
+//! - **Ring**: fixed slots, multi-writer, never blocks (see `ring.zig`).
+//!   A slow drainer loses the oldest records, counted in `stats`.
+//! - **Crash capture**: `Store` keeps the last N records in a file via
+//!   `trait.fs`. Drain into it as part of the normal sink, and call
+//!   `crashDump` from the panic handler to save what the last drain did
+//!   not reach. After the restart, `Store.previous()` returns the tail of
+//!   the last run.
+//!
+//! Logger state is static, one instance per `Logger` type, as with
+//! `std.log`, so scoped loggers satisfy `trait.log` directly.
+//!
+//! Usage:
+//! ```zig
+//! const Log = slog.Logger(board.time, .{
+//!     .modules = &.{
+//!         .{ .name = "wifi", .rate_per_s = 20, .burst = 10 },
+//!         .{ .name = "audio", .level = .warn, .rate_per_s = 5 },
+//!     },
+//! });
+//! const log = Log.scoped(.wifi);
+//! log.info("rssi {d} on ch {d}", .{ rssi, channel });
+//!
+//! // Boot: report the previous run, then keep persisting
+//! var store = try slog.Store(Fs).open(&fs, "/log/last.bin", 256);
+//! var it = store.previous();
+//! while (it.next()) |rec| board.log.info("prev: {s}", .{rec.text});
+//!
+//! // Main loop or a low-priority task: console and crash file
+//! const Sink = struct {
+//!     console: slog.LogSink(board.log) = .{},
+//!     store: *slog.Store(Fs),
+//!
+//!     pub fn write(self: *@This(), line: *const slog.Line) void {
+//!         self.console.write(line);
+//!         self.store.write(line);
+//!     }
+//! };
+//! var sink = Sink{ .store = &store };
+//! if (Log.drain(&sink) > 0) _ = store.sync();
+//!
+//! // Panic handler
+//! Log.crashDump(&store);
+//! ```
+
+const std = @import("std");
+const trait = @import("trait");
+
+pub const record = @import("record.zig");
+pub const ring = @import("ring.zig");
+pub const store = @import("store.zig");
+
+pub const Level = std.log.Level;
+pub const Entry = ring.Entry;
+pub const Store = store.Store;
+
+/// Per-module settings
+pub const Module = struct {
+    name: []const u8,
+    /// Records above this level are compiled out
+    level: Level = .debug,
+    /// Sustained records per second; 0 = unlimited
+    rate_per_s: u32 = 0,
+    /// Records allowed back to back before the rate applies
+    burst: u32 = 8,
+};
+
+pub const Config = struct {
+    modules: []const Module = &.{},
+    /// Settings for scopes not listed in `modules`
+    default: Module = .{ .name = "default" },
+    /// Ring slots (power of two), ~128 bytes each
+    ring_slots: usize = 64,
+};
+
+/// One drained record, rendered. Slices are valid until the sink returns.
+pub const Line = struct {
+    /// Position in the log since boot; gaps mean lost records
+    seq: usize,
+    ts_us: u64,
+    level: Level,
+    module: []const u8,
+    message: []const u8,
+};
+
+/// Bytes a rendered message is cut to
+pub const max_message = 160;
+
+pub const Stats = struct {
+    /// Records stored in the ring (dropped ones excluded)
+    written: u64 = 0,
+    /// Records over their module's rate limit
+    suppressed: u64 = 0,
+    /// Records a drain found dropped because an older writer was still in
+    /// their slot
+    busy: u32 = 0,
+    /// Records a drain found overwritten or had to skip, including those
+    /// whose writer was overtaken before it could store them. Each record
+    /// a drain passes is drained, `busy` or `lost`, never two of them.
+    lost: u64 = 0,
+};
+
+/// Logger over a `trait.time` clock (`nowUs` is used when present)
+pub fn Logger(comptime Time: type, comptime config: Config) type {
+    comptime {
+        _ = trait.time.from(Time);
+        if (config.modules.len >= 255) @compileError("slog supports up to 254 modules");
+    }
+
+    const module_count = config.modules.len + 1;
+    const modules: [module_count]Module = config.modules[0..config.modules.len].* ++ [_]Module{config.default};
+
+    return struct {
+        const Self = @This();
+        const Ring = ring.Ring(config.ring_slots);
+
+        const Limit = struct {
+            /// GCRA theoretical arrival time: the bucket is empty until then
+            tat_us: std.atomic.Value(u64) = .init(0),
+            suppressed: std.atomic.Value(u32) = .init(0),
+        };
+
+        var records: Ring = .{};
+        var limits: [module_count]Limit = [_]Limit{.{}} ** module_count;
+        var written: std.atomic.Value(u64) = .init(0);
+        var suppressed_total: std.atomic.Value(u64) = .init(0);
+        /// Drain cursor (one drainer at a time)
+        var tail: usize = 0;
+        var lost: u64 = 0;
+        var busy: u32 = 0;
+
+        /// A `trait.log` implementation for one module
+        pub fn scoped(comptime scope: @Type(.enum_literal)) type {
+            const m = comptime moduleIndex(@tagName(scope));
+            return struct {
+                pub fn err(comptime fmt: []const u8, args: anytype) void {
+                    log(.err, m, fmt, args);
+                }
+                pub fn warn(comptime fmt: []const u8, args: anytype) void {
+                    log(.warn, m, fmt, args);
+                }
+                pub fn info(comptime fmt: []const u8, args: anytype) void {
+                    log(.info, m, fmt, args);
+                }
+                pub fn debug(comptime fmt: []const u8, args: anytype) void {
+                    log(.debug, m, fmt, args);
+                }
+            };
+        }
+
+        /// The hot path: level filter, rate check, copy into the ring
+        pub fn log(comptime level: Level, comptime m: usize, comptime fmt: []const u8, args: anytype) void {
+            if (comptime @intFromEnum(level) > @intFromEnum(modules[m].level)) return;
+
+            const now = nowUs();
+            const limit = &limits[m];
+            if (!allow(limit, modules[m], now)) {
+                _ = limit.suppressed.fetchAdd(1, .monotonic);
+                _ = suppressed_total.fetchAdd(1, .monotonic);
+                return;
+            }
+            if (limit.suppressed.load(.monotonic) != 0) {
+                const missed = limit.suppressed.swap(0, .monotonic);
+                if (missed != 0) put(.warn, m, now, "suppressed {d} records", .{missed});
+            }
+            put(level, m, now, fmt, args);
+        }
+
+        /// Render every record published since the last drain into `sink`
+        /// (`fn write(self, line: *const Line) void`, e.g. `*Store` or a
+        /// `LogSink`). Returns the number of records written.
+        pub fn drain(sink: anytype) usize {
+            const head = records.end();
+            if (head -% tail > Ring.capacity) {
+                lost += head -% tail -% Ring.capacity;
+                tail = head -% Ring.capacity;
+            }
+            var n: usize = 0;
+            var entry: Entry = undefined;
+            while (tail != head) : (tail +%= 1) switch (records.read(tail, &entry)) {
+                .ok => {
+                    emit(sink, tail, &entry);
+                    n += 1;
+                },
+                // Picked up by the next drain
+                .pending => break,
+                .overwritten => lost += 1,
+                .dropped => busy +%= 1,
+            };
+            return n;
+        }
+
+        /// Write the records the last drain has not reached to `sink`
+        /// (usually a `*Store`) and sync it if it can be synced. Meant for
+        /// the panic handler: no allocation, no locks, and a writer stuck
+        /// in its slot is skipped. The ring is left as it was.
+        pub fn crashDump(sink: anytype) void {
+            const head = records.end();
+            var t = tail;
+            if (head -% t > Ring.capacity) t = head -% Ring.capacity;
+            var entry: Entry = undefined;
+            while (t != head) : (t +%= 1) {
+                if (records.read(t, &entry) == .ok) emit(sink, t, &entry);
+            }
+            if (@hasDecl(@typeInfo(@TypeOf(sink)).pointer.child, "sync")) _ = sink.sync();
+        }
+
+        pub fn stats() Stats {
+            return .{
+                .written = written.load(.monotonic),
+                .suppressed = suppressed_total.load(.monotonic),
+                .busy = busy,
+                .lost = lost,
+            };
+        }
+
+        /// Forget all records, limits and counters (tests)
+        pub fn reset() void {
+            records = .{};
+            limits = [_]Limit{.{}} ** module_count;
+            written = .init(0);
+            suppressed_total = .init(0);
+            tail = 0;
+            lost = 0;
+            busy = 0;
+        }
+
+        fn put(level: Level, comptime m: usize, now: u64, comptime fmt: []const u8, args: anytype) void {
+            const C = record.Codec(fmt, @TypeOf(args));
+            const Ctx = struct { level: Level, now: u64, args: *const @TypeOf(args) };
+            const ok = records.push(Ctx{ .level = level, .now = now, .args = &args }, struct {
+                fn fill(ctx: Ctx, e: *Entry) void {
+                    e.ts_us = ctx.now;
+                    e.render = &C.render;
+                    e.level = ctx.level;
+                    e.module = m;
+                    e.len = @intCast(C.encode(&e.payload, ctx.args.*));
+                }
+            }.fill);
+            if (ok) _ = written.fetchAdd(1, .monotonic);
+        }
+
+        fn allow(limit: *Limit, comptime module: Module, now: u64) bool {
+            if (module.rate_per_s == 0) return true;
+            const interval: u64 = 1_000_000 / module.rate_per_s;
+            const tolerance: u64 = interval * (@max(module.burst, 1) - 1);
+
+            var tat = limit.tat_us.load(.monotonic);
+            while (true) {
+                const base = @max(tat, now);
+                if (base - now > tolerance) return false;
+                tat = limit.tat_us.cmpxchgWeak(tat, base + interval, .monotonic, .monotonic) orelse return true;
+            }
+        }
+
+        fn emit(sink: anytype, t: usize, entry: *const Entry) void {
+            var buf: [max_message]u8 = undefined;
+            const line = Line{
+                .seq = t,
+                .ts_us = entry.ts_us,
+                .level = entry.level,
+                .module = modules[entry.module].name,
+                .message = entry.text(&buf),
+            };
+            sink.write(&line);
+        }
+
+        fn nowUs() u64 {
+            if (@hasDecl(Time, "nowUs")) return Time.nowUs();
+            return Time.nowMs() * 1000;
+        }
+
+        fn moduleIndex(comptime name: []const u8) usize {
+            for (config.modules, 0..) |mod, i| {
+                if (std.mem.eql(u8, mod.name, name)) return i;
+            }
+            return module_count - 1;
+        }
+    };
+}
+
+/// Sink writing drained lines to a `trait.log` implementation as
+/// "[seconds.millis] module: message"
+pub fn LogSink(comptime Impl: type) type {
+    const Log = trait.log.from(Impl);
+    return struct {
+        pub fn write(_: *@This(), line: *const Line) void {
+            const s = line.ts_us / 1_000_000;
+            const ms = line.ts_us / 1000 % 1000;
+            const fmt = "[{d}.{d:0>3}] {s}: {s}";
+            const args = .{ s, ms, line.module, line.message };
+            switch (line.level) {
+                .err => Log.err(fmt, args),
+                .warn => Log.warn(fmt, args),
+                .info => Log.info(fmt, args),
+                .debug => Log.debug(fmt, args),
+            }
+        }
+    };
+}
+
+// ============================================================================
+// Tests
+// ============================================================================
+
+const testing = std.testing;
+const std_impl = @import("std_impl");
+
+/// Hand-driven clock
+const Clock = struct {
+    var now_us: u64 = 1_000_000;
+
+    pub fn sleepMs(ms: u32) void {
+        now_us += @as(u64, ms) * 1000;
+    }
+    pub fn nowMs() u64 {
+        return now_us / 1000;
+    }
+    pub fn nowUs() u64 {
+        return now_us;
+    }
+};
+
+/// Collects rendered lines
+const Capture = struct {
+    buf: [32][max_message]u8 = undefined,
+    lens: [32]usize = undefined,
+    modules: [32][]const u8 = undefined,
+    seqs: [32]usize = undefined,
+    n: usize = 0,
+
+    pub fn write(self: *Capture, line: *const Line) void {
+        if (self.n == self.buf.len) return;
+        @memcpy(self.buf[self.n][0..line.message.len], line.message);
+        self.lens[self.n] = line.message.len;
+        self.modules[self.n] = line.module;
+        self.seqs[self.n] = line.seq;
+        self.n += 1;
+    }
+
+    fn message(self: *const Capture, i: usize) []const u8 {
+        return self.buf[i][0..self.lens[i]];
+    }
+};
+
+test "scoped loggers satisfy trait.log; drain renders in order" {
+    const L = Logger(Clock, .{ .modules = &.{.{ .name = "net" }} });
+    L.reset();
+    const net = trait.log.from(L.scoped(.net));
+    const other = L.scoped(.other);
+
+    var ssid = "home".*;
+    net.info("joined {s} rssi {d}", .{ @as([]const u8, &ssid), @as(i8, -61) });
+    ssid[0] = 'X';
+    other.warn("retry {d}/{d}", .{ 2, 5 });
+
+    var cap = Capture{};
+    try testing.expectEqual(@as(usize, 2), L.drain(&cap));
+    try testing.expectEqualStrings("joined home rssi -61", cap.message(0));
+    try testing.expectEqualStrings("net", cap.modules[0]);
+    try testing.expectEqualStrings("retry 2/5", cap.message(1));
+    try testing.expectEqualStrings("default", cap.modules[1]);
+    try testing.expectEqual(@as(usize, 0), L.drain(&cap));
+}
+
+test "module level filter" {
+    const L = Logger(Clock, .{ .modules = &.{.{ .name = "audio", .level = .warn }} });
+    L.reset();
+    const audio = L.scoped(.audio);
+    audio.debug("dropped", .{});
+    audio.info("dropped", .{});
+    audio.warn("kept", .{});
+
+    var cap = Capture{};
+    try testing.expectEqual(@as(usize, 1), L.drain(&cap));
+    try testing.expectEqual(@as(u64, 1), L.stats().written);
+}
+
+test "rate limit suppresses and reports the count" {
+    const L = Logger(Clock, .{ .modules = &.{.{ .name = "spam", .rate_per_s = 10, .burst = 3 }} });
+    L.reset();
+    const spam = L.scoped(.spam);
+
+    for (0..20) |i| spam.info("tick {d}", .{i});
+    try testing.expectEqual(@as(u64, 3), L.stats().written);
+    try testing.expectEqual(@as(u64, 17), L.stats().suppressed);
+
+    // One interval later one more record passes, after the notice
+    Clock.sleepMs(100);
+    spam.info("tick {d}", .{20});
+
+    var cap = Capture{};
+    try testing.expectEqual(@as(usize, 5), L.drain(&cap));
+    try testing.expectEqualStrings("tick 2", cap.message(2));
+    try testing.expectEqualStrings("suppressed 17 records", cap.message(3));
+    try testing.expectEqualStrings("tick 20", cap.message(4));
+}
+
+test "a slow drain loses the oldest records and counts them" {
+    const L = Logger(Clock, .{ .ring_slots = 8 });
+    L.reset();
+    const log = L.scoped(.x);
+    for (0..20) |i| log.info("{d}", .{i});
+
+    var cap = Capture{};
+    try testing.expectEqual(@as(usize, 8), L.drain(&cap));
+    try testing.expectEqualStrings("12", cap.message(0));
+    try testing.expectEqual(@as(usize, 12), cap.seqs[0]);
+    try testing.expectEqual(@as(u64, 12), L.stats().lost);
+}
+
+test "a record lost to an overtaken writer is counted once" {
+    const L = Logger(Clock, .{ .ring_slots = 2 });
+    L.reset();
+    const log = L.scoped(.x);
+
+    // Ticket 0 claims slot 0 and stalls inside it
+    _ = L.records.head.fetchAdd(1, .monotonic);
+    L.records.slots[0].seq.store(1, .monotonic);
+    log.info("a", .{});
+    // Ticket 2 finds slot 0 busy and hands its ticket to the stalled writer
+    log.info("b", .{});
+
+    // The stalled writer finishes as `publish` does when overtaken: a
+    // tombstone for ticket 2, nothing for its own ticket 0
+    L.records.slots[0].entry.len = Entry.tombstone;
+    L.records.slots[0].seq.store(2 * 2 + 2, .release);
+
+    var cap = Capture{};
+    try testing.expectEqual(@as(usize, 1), L.drain(&cap));
+    try testing.expectEqualStrings("a", cap.message(0));
+    const s = L.stats();
+    try testing.expectEqual(@as(u64, 1), s.written);
+    try testing.expectEqual(@as(u32, 1), s.busy);
+    try testing.expectEqual(@as(u64, 1), s.lost);
+}
+
+test "crash dump persists the ring; the next boot reads it back" {
+    const L = Logger(Clock, .{ .modules = &.{.{ .name = "app" }} });
+    L.reset();
+    const app = L.scoped(.app);
+
+    var tmp = testing.tmpDir(.{});
+    defer tmp.cleanup();
+    var fs = std_impl.fs.Fs.initDir(tmp.dir);
+    defer fs.deinit();
+    const S = Store(std_impl.fs.Fs);
+
+    {
+        var st = try S.open(&fs, "/crash.bin", 16);
+        defer st.close();
+        app.info("boot {d}", .{1});
+        _ = L.drain(&st);
+        app.warn("heap low: {d} bytes", .{@as(u32, 512)});
+        app.err("assert {s}", .{"ptr != null"});
+        L.crashDump(&st);
+    }
+
+    var st = try S.open(&fs, "/crash.bin", 16);
+    defer st.close();
+    var it = st.previous();
+    try testing.expectEqualStrings("app: boot 1", it.next().?.text);
+    try testing.expectEqualStrings("app: heap low: 512 bytes", it.next().?.text);
+    const last = it.next().?;
+    try testing.expectEqualStrings("app: assert ptr != null", last.text);
+    try testing.expectEqual(Level.err, last.level);
+    try testing.expect(it.next() == null);
+}
+
+test "LogSink forwards to a trait.log implementation" {
+    const L = Logger(Clock, .{});
+    L.reset();
+    const Out = struct {
+        var errors: usize = 0;
+        var last: [max_message + 32]u8 = undefined;
+        var last_len: usize = 0;
+        fn keep(comptime fmt: []const u8, args: anytype) void {
+            last_len = record.formatInto(&last, fmt, args);
+        }
+        pub fn err(comptime fmt: []const u8, args: anytype) void {
+            errors += 1;
+            keep(fmt, args);
+        }
+        pub fn warn(comptime fmt: []const u8, args: anytype) void {
+            keep(fmt, args);
+        }
+        pub fn info(comptime fmt: []const u8, args: anytype) void {
+            keep(fmt, args);
+        }
+        pub fn debug(comptime fmt: []const u8, args: anytype) void {
+            keep(fmt, args);
+        }
+    };
+
+    Clock.now_us = 12_345_678;
+    L.scoped(.fs).err("mount failed", .{});
+    var sink = LogSink(Out){};
+    _ = L.drain(&sink);
+    try testing.expectEqual(@as(usize, 1), Out.errors);
+    try testing.expectEqualStrings("[12.345] default: mount failed", Out.last[0..Out.last_len]);
+}
+
+test {
+    _ = record;
+    _ = ring;
+    _ = store;
+}
@@ -0,0 +1,243 @@
+//! Persistent log records
+//!
+//! The last `capacity` rendered records in one file of fixed-size
+//! records, written round-robin with `pwrite`. Records are stored as
+//! text, so a crash log stays readable by a different firmware build.
+//! Each record carries a sequence number and a CRC; `open` scans the
+//! file to find where the previous run stopped, and a record torn by a
+//! reset fails its CRC and is skipped.
+//!
+//! Record layout (little endian):
+//!
+//!   off  size  field
+//!     0     4  magic "SLG1"
+//!     4     4  sequence
+//!     8     8  timestamp (µs since boot)
+//!    16     1  level
+//!    17     1  text length
+//!    18   106  text ("module: message")
+//!   124     4  CRC-32 of bytes 0..124
+
+const std = @import("std");
+const trait = @import("trait");
+
+const File = trait.fs.File;
+pub const Level = std.log.Level;
+
+pub const record_size = 128;
+pub const text_len = 106;
+
+const magic = "SLG1";
+
+pub const Error = error{
+    /// File could not be opened or written
+    Io,
+};
+
+/// One stored record; `text` points into the reader's buffer
+pub const Record = struct {
+    seq: u32,
+    ts_us: u64,
+    level: Level,
+    text: []const u8,
+};
+
+/// Record file over an fs driver (`open(path, mode) ?trait.fs.File`)
+pub fn Store(comptime Fs: type) type {
+    return struct {
+        const Self = @This();
+
+        file: File,
+        capacity: u32,
+        /// Sequence number of the next append
+        next_seq: u32 = 0,
+        /// `next_seq` when the file was opened: records before it are
+        /// from earlier runs
+        boot_seq: u32 = 0,
+        /// Appends not yet synced
+        dirty: bool = false,
+
+        /// Open (or create) the record file and find the newest record.
+        pub fn open(fs: *Fs, path: []const u8, capacity: u32) Error!Self {
+            std.debug.assert(capacity > 0);
+            const file = fs.open(path, .read_write) orelse return error.Io;
+            var self = Self{ .file = file, .capacity = capacity };
+
+            var newest: ?u32 = null;
+            var buf: [record_size]u8 = undefined;
+            for (0..capacity) |i| {
+                const rec = self.readAt(@intCast(i), &buf) orelse continue;
+                if (newest == null or newer(rec.seq, newest.?)) newest = rec.seq;
+            }
+            if (newest) |n| self.next_seq = n +% 1;
+            self.boot_seq = self.next_seq;
+            return self;
+        }
+
+        pub fn close(self: *Self) void {
+            _ = self.sync();
+            self.file.close();
+        }
+
+        /// Store one record. Text longer than `text_len` is cut.
+        pub fn append(self: *Self, ts_us: u64, level: Level, text: []const u8) Error!void {
+            var r: [record_size]u8 = [_]u8{0} ** record_size;
+            const n: u8 = @intCast(@min(text.len, text_len));
+            @memcpy(r[0..4], magic);
+            std.mem.writeInt(u32, r[4..8], self.next_seq, .little);
+            std.mem.writeInt(u64, r[8..16], ts_us, .little);
+            r[16] = @intFromEnum(level);
+            r[17] = n;
+            @memcpy(r[18..][0..n], text[0..n]);
+            std.mem.writeInt(u32, r[124..128], std.hash.Crc32.hash(r[0..124]), .little);
+
+            const off = @as(u64, self.next_seq % self.capacity) * record_size;
+            if (self.file.pwrite(&r, off) != record_size) return error.Io;
+            self.next_seq +%= 1;
+            self.dirty = true;
+        }
+
+        /// Sink for `Logger.drain` and `Logger.crashDump`: stores a
+        /// `Line` as "module: message"
+        pub fn write(self: *Self, line: anytype) void {
+            var buf: [text_len]u8 = undefined;
+            // On overflow the buffer holds the text cut to fit
+            const text = std.fmt.bufPrint(&buf, "{s}: {s}", .{ line.module, line.message }) catch &buf;
+            self.append(line.ts_us, line.level, text) catch {};
+        }
+
+        /// Make appended records durable. Returns false on failure.
+        pub fn sync(self: *Self) bool {
+            if (!self.dirty) return true;
+            self.dirty = false;
+            return self.file.sync();
+        }
+
+        /// All stored records, oldest first
+        pub fn records(self: *Self) Iterator {
+            return self.range(self.next_seq);
+        }
+
+        /// Records written before this `open`, oldest first: the tail of
+        /// the previous run, up to a crash
+        pub fn previous(self: *Self) Iterator {
+            return self.range(self.boot_seq);
+        }
+
+        fn range(self: *Self, end: u32) Iterator {
+            const span = @min(end, self.capacity);
+            return .{ .store = self, .seq = end -% span, .end = end };
+        }
+
+        pub const Iterator = struct {
+            store: *Self,
+            seq: u32,
+            end: u32,
+            buf: [record_size]u8 = undefined,
+
+            pub fn next(it: *Iterator) ?Record {
+                while (it.seq != it.end) {
+                    const seq = it.seq;
+                    it.seq +%= 1;
+                    const rec = it.store.readAt(seq % it.store.capacity, &it.buf) orelse continue;
+                    // Slot already reused by a newer record
+                    if (rec.seq != seq) continue;
+                    return rec;
+                }
+                return null;
+            }
+        };
+
+        fn readAt(self: *Self, index: u32, buf: *[record_size]u8) ?Record {
+            if (self.file.pread(buf, @as(u64, index) * record_size) != record_size) return null;
+            if (!std.mem.eql(u8, buf[0..4], magic)) return null;
+            if (std.mem.readInt(u32, buf[124..128], .little) != std.hash.Crc32.hash(buf[0..124])) return null;
+            const level = std.meta.intToEnum(Level, buf[16]) catch return null;
+            const n = @min(buf[17], text_len);
+            return .{
+                .seq = std.mem.readInt(u32, buf[4..8], .little),
+                .ts_us = std.mem.readInt(u64, buf[8..16], .little),
+                .level = level,
+                .text = buf[18..][0..n],
+            };
+        }
+
+        fn newer(a: u32, b: u32) bool {
+            const d: i32 = @bitCast(a -% b);
+            return d > 0;
+        }
+    };
+}
+
+// ============================================================================
+// Tests
+// ============================================================================
+
+const testing = std.testing;
+const std_impl = @import("std_impl");
+const HostFs = std_impl.fs.Fs;
+
+test "records survive reopening; previous() is the last run's tail" {
+    var tmp = testing.tmpDir(.{});
+    defer tmp.cleanup();
+    var fs = HostFs.initDir(tmp.dir);
+    defer fs.deinit();
+    const S = Store(HostFs);
+
+    {
+        var store = try S.open(&fs, "/log.bin", 4);
+        defer store.close();
+        var it = store.previous();
+        try testing.expect(it.next() == null);
+        var buf: [16]u8 = undefined;
+        for (0..6) |i| try store.append(i * 1000, .info, try std.fmt.bufPrint(&buf, "run1 #{d}", .{i}));
+    }
+
+    var store = try S.open(&fs, "/log.bin", 4);
+    defer store.close();
+    try store.append(99, .err, "run2");
+
+    var it = store.previous();
+    // Record 2 was replaced by run 2
+    var want: usize = 3;
+    while (it.next()) |rec| : (want += 1) {
+        var buf: [16]u8 = undefined;
+        try testing.expectEqualStrings(try std.fmt.bufPrint(&buf, "run1 #{d}", .{want}), rec.text);
+        try testing.expectEqual(@as(u64, want * 1000), rec.ts_us);
+    }
+    try testing.expectEqual(@as(usize, 6), want);
+
+    // The newest record replaced the oldest one of run 1
+    var all = store.records();
+    var n: usize = 0;
+    var last: ?Record = null;
+    while (all.next()) |rec| : (n += 1) last = rec;
+    try testing.expectEqual(@as(usize, 4), n);
+    try testing.expectEqualStrings("run2", last.?.text);
+    try testing.expectEqual(Level.err, last.?.level);
+}
+
+test "a torn record is skipped" {
+    var tmp = testing.tmpDir(.{});
+    defer tmp.cleanup();
+    var fs = HostFs.initDir(tmp.dir);
+    defer fs.deinit();
+    const S = Store(HostFs);
+
+    {
+        var store = try S.open(&fs, "/log.bin", 8);
+        defer store.close();
+        try store.append(1, .info, "kept");
+        try store.append(2, .info, "torn");
+        // Half of the second record reaches the disk
+        _ = store.file.pwrite(&([_]u8{0xFF} ** 64), record_size + 64);
+    }
+
+    var store = try S.open(&fs, "/log.bin", 8);
+    defer store.close();
+    var it = store.previous();
+    try testing.expectEqualStrings("kept", it.next().?.text);
+    try testing.expect(it.next() == null);
+    // The torn slot is reused
+    try testing.expectEqual(@as(u32, 1), store.next_seq);
+}
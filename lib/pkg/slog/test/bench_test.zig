@@ -0,0 +1,229 @@
+//! Structured logging: hot-path latency and throughput.
+//!
+//!   BM1: nanoseconds per log call (p50/p99/max) for one typical line,
+//!        "rx {s} len {d} rssi {d} crc {x}":
+//!        - eager: format into a line buffer (the formatting half of
+//!          logging straight to a sink, no I/O)
+//!        - eager_write: format and write(2) the line to a file, which is
+//!          what a direct-to-sink log call costs
+//!        - slog: deferred record into the ring
+//!        - slog_limited: a call rejected by the module's rate limit
+//!   BM2: records per second from 1 and 4 writer threads while a drainer
+//!        renders into a `Store` file, with lost/busy counts
+//!   BM3: drain cost, rendering ring records into a `Store`
+//!
+//! Each latency sample times one call; the timer's own cost is reported
+//! as the `timer` row and not subtracted.
+
+const std = @import("std");
+const slog = @import("slog");
+const std_impl = @import("std_impl");
+const print = std.debug.print;
+const testing = std.testing;
+
+const HostFs = std_impl.fs.Fs;
+const Store = slog.Store(HostFs);
+
+const SAMPLES = 200_000;
+const THREAD_RECORDS = 500_000;
+
+const Log = slog.Logger(std_impl.time, .{
+    .modules = &.{
+        .{ .name = "radio" },
+        .{ .name = "spam", .rate_per_s = 10, .burst = 1 },
+    },
+    .ring_slots = 1024,
+});
+
+const Discard = struct {
+    pub fn write(_: *Discard, line: *const slog.Line) void {
+        std.mem.doNotOptimizeAway(line.message.ptr);
+    }
+};
+
+fn percentiles(name: []const u8, samples: []u64) void {
+    std.mem.sort(u64, samples, {}, std.sort.asc(u64));
+    print("[bench]   {s:<13} p50 {d:>6} ns   p99 {d:>6} ns   max {d:>8} ns\n", .{
+        name,
+        samples[samples.len / 2],
+        samples[samples.len * 99 / 100],
+        samples[samples.len - 1],
+    });
+}
+
+// ============================================================================
+// BM1: hot-path latency
+// ============================================================================
+
+const Mode = enum { timer, eager, eager_write, slog, slog_limited };
+
+fn latency(mode: Mode, samples: []u64, file: std.fs.File) void {
+    const peer: []const u8 = "a4:c1:38:0f:22:9e";
+    var line: [slog.max_message]u8 = undefined;
+
+    for (samples, 0..) |*s, i| {
+        const len: u16 = @truncate(i);
+        const rssi: i8 = @truncate(@as(isize, @intCast(i % 40)) - 80);
+        const crc: u32 = @truncate(i *% 0x9E3779B1);
+
+        var timer = std.time.Timer.start() catch unreachable;
+        switch (mode) {
+            .timer => {},
+            .eager => {
+                const text = std.fmt.bufPrint(&line, "rx {s} len {d} rssi {d} crc {x}", .{ peer, len, rssi, crc }) catch &line;
+                std.mem.doNotOptimizeAway(text.ptr);
+            },
+            .eager_write => {
+                const text = std.fmt.bufPrint(&line, "rx {s} len {d} rssi {d} crc {x}\n", .{ peer, len, rssi, crc }) catch &line;
+                file.writeAll(text) catch {};
+            },
+            .slog => Log.scoped(.radio).info("rx {s} len {d} rssi {d} crc {x}", .{ peer, len, rssi, crc }),
+            .slog_limited => Log.scoped(.spam).info("rx {s} len {d} rssi {d} crc {x}", .{ peer, len, rssi, crc }),
+        }
+        s.* = timer.read();
+
+        // Keep the ring from lapping so every slog sample is a real push
+        if (i % 512 == 511) {
+            var sink = Discard{};
+            _ = Log.drain(&sink);
+        }
+    }
+}
+
+test "BM1: log call latency, eager vs deferred" {
+    print("\n[bench] BM1: one log call, {d} samples\n", .{SAMPLES});
+    const samples = try testing.allocator.alloc(u64, SAMPLES);
+    defer testing.allocator.free(samples);
+
+    var tmp = testing.tmpDir(.{});
+    defer tmp.cleanup();
+    const file = try tmp.dir.createFile("eager.log", .{});
+    defer file.close();
+
+    var p50: [5]u64 = undefined;
+    for (&p50, 0..) |*p, i| {
+        const mode: Mode = @enumFromInt(i);
+        Log.reset();
+        latency(mode, samples, file);
+        percentiles(@tagName(mode), samples);
+        p.* = samples[samples.len / 2];
+    }
+    const st = Log.stats();
+    print("[bench]   slog_limited: {d} records, {d} suppressed\n", .{ st.written, st.suppressed });
+
+    // A deferred record must beat formatting it, and be far from a write(2)
+    try testing.expect(p50[3] <= p50[1]);
+    try testing.expect(p50[3] * 2 < p50[2]);
+}
+
+// ============================================================================
+// BM2: throughput with a concurrent drainer
+// ============================================================================
+
+const Drainer = struct {
+    store: *Store,
+    running: std.atomic.Value(bool) = .init(true),
+    drained: usize = 0,
+
+    fn run(self: *Drainer) void {
+        while (self.running.load(.acquire)) {
+            const n = Log.drain(self.store);
+            self.drained += n;
+            if (n == 0) std.Thread.yield() catch {};
+        }
+        self.drained += Log.drain(self.store);
+        _ = self.store.sync();
+    }
+};
+
+fn writer(id: usize) void {
+    const log = Log.scoped(.radio);
+    for (0..THREAD_RECORDS) |i| {
+        log.info("writer {d} seq {d} state {s}", .{ id, i, "streaming" });
+    }
+}
+
+test "BM2: records per second, 1 and 4 writers, draining to a Store" {
+    print("\n[bench] BM2: {d} records per writer, ring {d} slots, drain to Store\n", .{ THREAD_RECORDS, 1024 });
+
+    var tmp = testing.tmpDir(.{});
+    defer tmp.cleanup();
+    var fs = HostFs.initDir(tmp.dir);
+    defer fs.deinit();
+
+    for ([_]usize{ 1, 4 }) |threads| {
+        Log.reset();
+        var st = try Store.open(&fs, "/bm2.bin", 4096);
+        defer st.close();
+        var drainer = Drainer{ .store = &st };
+
+        var timer = try std.time.Timer.start();
+        const dt = try std.Thread.spawn(.{}, Drainer.run, .{&drainer});
+        var pool: [4]std.Thread = undefined;
+        for (pool[0..threads], 0..) |*th, id| th.* = try std.Thread.spawn(.{}, writer, .{id});
+        for (pool[0..threads]) |th| th.join();
+        const write_ns = timer.read();
+        drainer.running.store(false, .release);
+        dt.join();
+
+        const total = threads * THREAD_RECORDS;
+        const s = Log.stats();
+        const secs = @as(f64, @floatFromInt(write_ns)) / 1e9;
+        print("[bench]   {d} writer(s): {d:>6.2} M records/s   drained {d} ({d:.1}%), lost {d}, busy {d}\n", .{
+            threads,
+            @as(f64, @floatFromInt(total)) / secs / 1e6,
+            drainer.drained,
+            @as(f64, @floatFromInt(drainer.drained)) * 100 / @as(f64, @floatFromInt(total)),
+            s.lost,
+            s.busy,
+        });
+
+        // Every record is accounted for once: drained, overwritten or dropped
+        try testing.expectEqual(@as(u64, total), drainer.drained + s.lost + s.busy);
+        try testing.expect(s.written >= drainer.drained and s.written <= total);
+    }
+}
+
+// ============================================================================
+// BM3: drain cost
+// ============================================================================
+
+test "BM3: rendering ring records into a Store" {
+    var tmp = testing.tmpDir(.{});
+    defer tmp.cleanup();
+    var fs = HostFs.initDir(tmp.dir);
+    defer fs.deinit();
+    var st = try Store.open(&fs, "/bm3.bin", 4096);
+    defer st.close();
+
+    const rounds = 200;
+    var discard_ns: u64 = 0;
+    var store_ns: u64 = 0;
+    var records: usize = 0;
+    const log = Log.scoped(.radio);
+    for (0..rounds) |r| {
+        inline for (.{ false, true }) |to_store| {
+            Log.reset();
+            for (0..1024) |i| log.info("round {d} rec {d} peer {s}", .{ r, i, "a4:c1:38:0f:22:9e" });
+            var timer = try std.time.Timer.start();
+            if (to_store) {
+                records += Log.drain(&st);
+                store_ns += timer.read();
+            } else {
+                var sink = Discard{};
+                _ = Log.drain(&sink);
+                discard_ns += timer.read();
+            }
+        }
+    }
+    _ = st.sync();
+
+    const per = @as(f64, @floatFromInt(records));
+    print("\n[bench] BM3: drain {d} records\n", .{records});
+    print("[bench]   render only   {d:>6.0} ns/record\n", .{@as(f64, @floatFromInt(discard_ns)) / per});
+    print("[bench]   render+store  {d:>6.0} ns/record (pwrite per record, one sync)\n", .{@as(f64, @floatFromInt(store_ns)) / per});
+
+    try testing.expectEqual(@as(usize, rounds * 1024), records);
+    var it = st.records();
+    try testing.expect(it.next() != null);
+}
@@ -0,0 +1,131 @@
+//! LVGL Render + Flush Benchmark
+//!
+//! Frame time of a full-screen redraw on a 320x240 RGB565 panel in
+//! `buf_lines = 24` stripes. The panel is a MemDisplay with an external
+//! flush completion; a bus thread holds each stripe for its wire time at
+//! 40MHz SPI before completing it, like a DMA-done interrupt would.
+//!
+//!   BM1: single draw buffer (render and transfer alternate) vs two draw
+//!        buffers (the next stripe renders while the previous one is on
+//!        the bus), plus render-only time with an instant bus
+//!
+//! Run:
+//!   bazel test //lib/pkg/ui/lvgl:bench --test_output=all
+
+const std = @import("std");
+const ui = @import("ui.zig");
+const display = @import("display");
+const c = @import("lvgl").c;
+const print = std.debug.print;
+
+const W: u16 = 320;
+const H: u16 = 240;
+const LINES: u16 = 24;
+const FRAMES = 60;
+const SPI_HZ: u64 = 40_000_000;
+
+fn Panel(comptime buffers: u8) type {
+    return display.MemDisplayWith(W, H, .{
+        .render_mode = .partial,
+        .buf_lines = LINES,
+        .draw_buffers = buffers,
+        .async_flush = .external,
+    });
+}
+
+/// Completes each transfer after its wire time at `hz` (0 = at once).
+fn Bus(comptime P: type) type {
+    return struct {
+        const Self = @This();
+
+        panel: *P,
+        hz: u64,
+        stop: std.atomic.Value(bool) = .init(false),
+
+        fn run(self: *Self) void {
+            while (!self.stop.load(.acquire)) {
+                const bytes = self.panel.pendingBytes();
+                if (bytes == 0) {
+                    std.atomic.spinLoopHint();
+                    continue;
+                }
+                if (self.hz > 0) spinFor(bytes * 8 * std.time.ns_per_s / self.hz);
+                _ = self.panel.complete();
+            }
+        }
+
+        /// Sleep granularity is too coarse for 3ms stripes
+        fn spinFor(ns: u64) void {
+            var timer = std.time.Timer.start() catch return;
+            while (timer.read() < ns) std.atomic.spinLoopHint();
+        }
+    };
+}
+
+/// 8x6 grid of rounded boxes with a label each: enough drawing per stripe
+/// that rendering is a real share of the frame.
+fn buildScene(scr: ui.Obj) void {
+    var text: [8]u8 = undefined;
+    for (0..6) |row| {
+        for (0..8) |col| {
+            const box = ui.Obj.create(scr.raw()).?
+                .size(36, 34)
+                .pos(@intCast(col * 40 + 2), @intCast(row * 40 + 3))
+                .bgColor(@intCast(0x304050 + row * 0x101010 + col * 0x080008))
+                .radius(6);
+            const s = std.fmt.bufPrintZ(&text, "{d}", .{row * 8 + col}) catch unreachable;
+            _ = ui.Label.create(box).?.text(s).color(0xffffff).center();
+        }
+    }
+}
+
+/// Average frame time in µs: invalidate the screen, render, wait for the
+/// last stripe to leave the bus.
+fn frameTime(comptime buffers: u8, hz: u64) !f64 {
+    const P = Panel(buffers);
+    const panel = try std.testing.allocator.create(P);
+    defer std.testing.allocator.destroy(panel);
+    panel.* = P.create();
+
+    var bus = Bus(P){ .panel = panel, .hz = hz };
+    const thread = try std.Thread.spawn(.{}, Bus(P).run, .{&bus});
+    defer {
+        bus.stop.store(true, .release);
+        thread.join();
+    }
+
+    var ctx = try ui.init(P, panel);
+    defer ctx.deinit();
+    const scr = ctx.screen();
+    buildScene(scr);
+
+    var timer = try std.time.Timer.start();
+    for (0..FRAMES + 1) |f| {
+        // First frame warms caches and LVGL's layout
+        if (f == 1) timer.reset();
+        _ = scr.bgColor(if (f % 2 == 0) 0x101820 else 0x182010);
+        c.lv_refr_now(ctx.lv_display);
+        panel.waitFlush();
+    }
+    return @as(f64, @floatFromInt(timer.read())) / FRAMES / std.time.ns_per_us;
+}
+
+test "BM1: render + flush frame time, single vs dual draw buffers" {
+    const stripes = (H + LINES - 1) / LINES;
+    const wire_us = @as(f64, @floatFromInt(@as(u64, W) * H * 2 * 8)) * 1e6 / @as(f64, @floatFromInt(SPI_HZ));
+    print("\n[bench] {d}x{d} rgb565, {d}-line stripes ({d}/frame), bus {d:.1} ms/frame at 40MHz\n", .{
+        W, H, LINES, stripes, wire_us / 1000,
+    });
+
+    const render_only = try frameTime(1, 0);
+    const single = try frameTime(1, SPI_HZ);
+    const dual = try frameTime(2, SPI_HZ);
+
+    print("[bench]   {s:<28} {d:>8.2} ms/frame\n", .{ "render only (instant bus)", render_only / 1000 });
+    print("[bench]   {s:<28} {d:>8.2} ms/frame  {d:>6.1} fps\n", .{ "single buffer", single / 1000, 1e6 / single });
+    print("[bench]   {s:<28} {d:>8.2} ms/frame  {d:>6.1} fps  ({d:.0}% of single)\n", .{
+        "dual buffer", dual / 1000, 1e6 / dual, dual * 100 / single,
+    });
+
+    try std.testing.expect(dual < single);
+}
@@ -73,6 +73,7 @@ pub const Font = font.Font;
 pub const RenderMode = display_pkg.RenderMode;
 pub const Area = display_pkg.Area;
 pub const ColorFormat = display_pkg.ColorFormat;
+pub const FlushDone = display_pkg.FlushDone;
 
 // ============================================================================
 // Display Context
@@ -117,6 +118,15 @@ pub fn Context(comptime DisplayDriver: type) type {
 /// For `.direct` mode, Driver must also have:
 /// - `fn getFramebuffer(self: *Driver) [*]u8`
 ///
+/// Optional:
+/// - `draw_buffers: u8` — 2 allocates a second draw buffer so LVGL renders
+///   the next stripe while the previous one is still being sent
+///   (`.partial` / `.full` only)
+/// - `async_flush: bool` — when true, the driver provides
+///   `fn flushAsync(self: *Driver, area: Area, color_data: [*]const u8, done: FlushDone) void`
+///   and `fn waitFlush(self: *Driver) void`; LVGL's flush is marked ready
+///   when the driver signals `done`, not when `flushAsync` returns
+///
 /// Examples: `display.SpiLcd(Spi, DcPin, config)`, `display.MemDisplay(w, h, fmt)`
 pub fn init(comptime Driver: type, driver: *Driver) !Context(Driver) {
     // Comptime validation
@@ -130,6 +140,16 @@ pub fn init(comptime Driver: type, driver: *Driver) !Context(Driver) {
     }
 
     const render_mode = Driver.render_mode;
+    const draw_buffers: u8 = if (@hasDecl(Driver, "draw_buffers")) Driver.draw_buffers else 1;
+    const async_flush = @hasDecl(Driver, "async_flush") and Driver.async_flush;
+    comptime {
+        if (draw_buffers != 1 and draw_buffers != 2) @compileError("draw_buffers must be 1 or 2");
+        if (draw_buffers == 2 and render_mode == .direct) @compileError("dual draw buffers need .partial or .full render mode");
+        if (async_flush) {
+            _ = @as(*const fn (*Driver, display_pkg.Area, [*]const u8, display_pkg.FlushDone) void, &Driver.flushAsync);
+            _ = @as(*const fn (*Driver) void, &Driver.waitFlush);
+        }
+    }
 
     const Adapter = struct {
         const bpp: u32 = display_pkg.bytesPerPixel(Driver.color_format);
@@ -141,28 +161,44 @@ pub fn init(comptime Driver: type, driver: *Driver) !Context(Driver) {
             lv_area: ?*const c.lv_area_t,
             px_map: ?*u8,
         ) callconv(.c) void {
-            // LVGL requires lv_display_flush_ready() on EVERY callback invocation.
+            // LVGL requires lv_display_flush_ready() for EVERY callback invocation.
             // Missing it causes LVGL to stall in "flushing" state permanently.
-            defer if (lv_disp) |d| c.lv_display_flush_ready(d);
-
-            if (lv_area == null or px_map == null) return;
+            const d = lv_disp orelse return;
+            if (lv_area == null or px_map == null) return c.lv_display_flush_ready(d);
             const area = lv_area.?;
-            lcd.flush(.{
+            const a = display_pkg.Area{
                 .x1 = @intCast(area.x1),
                 .y1 = @intCast(area.y1),
                 .x2 = @intCast(area.x2),
                 .y2 = @intCast(area.y2),
-            }, @ptrCast(px_map.?));
+            };
+            if (async_flush) {
+                // Ready once the transfer has released the buffer
+                lcd.flushAsync(a, @ptrCast(px_map.?), .{ .ctx = d, .func = flushDone });
+            } else {
+                lcd.flush(a, @ptrCast(px_map.?));
+                c.lv_display_flush_ready(d);
+            }
+        }
+
+        fn flushDone(ctx: *anyopaque) void {
+            c.lv_display_flush_ready(@ptrCast(@alignCast(ctx)));
+        }
+
+        /// LVGL calls this instead of spinning on its flushing flag
+        fn flushWaitCb(_: ?*c.lv_display_t) callconv(.c) void {
+            lcd.waitFlush();
         }
 
-        // Static draw buffer — sized by render_mode + buf_lines (comptime).
-        // For .direct mode this is unused; the driver provides the buffer.
+        // Static draw buffers — sized by render_mode + buf_lines (comptime).
+        // For .direct mode these are unused; the driver provides the buffer.
         const draw_buf_size = if (render_mode == .direct)
             0
         else
             @as(u32, Driver.width) * bpp * @as(u32, Driver.buf_lines);
 
         var draw_buf: [draw_buf_size]u8 = undefined;
+        var draw_buf2: [if (draw_buffers == 2) draw_buf_size else 0]u8 = undefined;
     };
     Adapter.lcd = driver;
 
@@ -186,17 +222,18 @@ pub fn init(comptime Driver: type, driver: *Driver) !Context(Driver) {
         const fb_size = @as(u32, Driver.width) * @as(u32, Driver.height) * Adapter.bpp;
         c.lv_display_set_buffers(lv_disp, fb, null, fb_size, lv_render_mode);
     } else {
-        // Partial/Full mode: use the static draw buffer
+        // Partial/Full mode: use the static draw buffer(s)
         c.lv_display_set_buffers(
             lv_disp,
             &Adapter.draw_buf,
-            null,
+            if (draw_buffers == 2) &Adapter.draw_buf2 else null,
             Adapter.draw_buf_size,
             lv_render_mode,
         );
     }
 
     c.lv_display_set_flush_cb(lv_disp, Adapter.flushCb);
+    if (async_flush) c.lv_display_set_flush_wait_cb(lv_disp, Adapter.flushWaitCb);
 
     return .{
         .display = driver,
@@ -249,3 +286,42 @@ test "LVGL create label with chaining" {
 
     try @import("std").testing.expect(display.flush_count > 0);
 }
+
+fn renderLabelScene(comptime Display: type, display: *Display) !void {
+    var ctx = try init(Display, display);
+    defer ctx.deinit();
+
+    _ = ctx.screen().bgColor(0x203040);
+    _ = Label.create(ctx.screen()).?
+        .text("Dual buffers")
+        .color(0xffffff)
+        .center();
+
+    var i: u32 = 0;
+    while (i < 10) : (i += 1) {
+        ctx.tick(5);
+        _ = ctx.handler();
+    }
+    display.waitFlush();
+}
+
+test "dual draw buffers with async flush render the same frame" {
+    const std = @import("std");
+    const Single = display_pkg.MemDisplayWith(160, 120, .{ .render_mode = .partial, .buf_lines = 20 });
+    const Dual = display_pkg.MemDisplayWith(160, 120, .{
+        .render_mode = .partial,
+        .buf_lines = 20,
+        .draw_buffers = 2,
+        .async_flush = .on_wait,
+    });
+
+    var single = Single.create();
+    var dual = Dual.create();
+    try renderLabelScene(Single, &single);
+    try renderLabelScene(Dual, &dual);
+
+    // Every stripe completed, and pixels were read only on completion
+    try std.testing.expect(!dual.busy());
+    try std.testing.expect(dual.flush_count >= 6);
+    try std.testing.expectEqualSlices(u8, &single.framebuffer, &dual.framebuffer);
+}
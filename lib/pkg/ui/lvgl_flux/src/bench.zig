@@ -9,11 +9,14 @@
 //!   2. RAM usage (struct sizes)
 //!   3. Render time per frame
 //!   4. Binary size overhead (reported, not measured in test)
+//!   5. Sync cost against state size: full field-by-field diff vs the
+//!      change mask of a tracked flux store
 //!
 //! Run:
 //!   bazel test //lib/pkg/ui/lvgl_flux:bench --test_output=all
 
 const std = @import("std");
+const flux = @import("flux");
 const lvgl_flux = @import("lvgl_flux.zig");
 const SyncEngine = lvgl_flux.SyncEngine;
 const ViewBinding = lvgl_flux.ViewBinding;
@@ -371,3 +374,129 @@ test "comparison: architecture summary" {
         \\
     , .{});
 }
+
+// ============================================================================
+// Sync cost vs state size
+// ============================================================================
+
+/// State with `n` u32 fields f0..f{n-1}
+fn BigState(comptime n: usize) type {
+    @setEvalBranchQuota(100 * n);
+    var fields: [n]std.builtin.Type.StructField = undefined;
+    for (&fields, 0..) |*f, i| {
+        f.* = .{
+            .name = std.fmt.comptimePrint("f{d}", .{i}),
+            .type = u32,
+            .default_value_ptr = &@as(u32, 0),
+            .is_comptime = false,
+            .alignment = @alignOf(u32),
+        };
+    }
+    return @Type(.{ .@"struct" = .{
+        .layout = .auto,
+        .fields = &fields,
+        .decls = &.{},
+        .is_tuple = false,
+    } });
+}
+
+var big_sink: u32 = 0;
+
+/// One binding per field, each watching its own field
+fn bigBindings(comptime S: type) [std.meta.fields(S).len]ViewBinding(S) {
+    const fields = std.meta.fields(S);
+    @setEvalBranchQuota(100 * fields.len);
+    var out: [fields.len]ViewBinding(S) = undefined;
+    for (fields, 0..) |f, i| {
+        out[i] = .{
+            .sync_fn = struct {
+                fn sync(s: *const S, p: *const S) bool {
+                    if (@field(s, f.name) == @field(p, f.name)) return false;
+                    big_sink +%= @field(s, f.name);
+                    return true;
+                }
+            }.sync,
+            .fields = lvgl_flux.watch(S, .{@field(std.meta.FieldEnum(S), f.name)}),
+        };
+    }
+    return out;
+}
+
+/// Each frame: a clock field ticks and one of two other fields changes,
+/// the usual shape of a UI frame (few fields out of many).
+fn BigApp(comptime n: usize) type {
+    return struct {
+        const S = BigState(n);
+        const Event = enum { tick, a, b };
+        const Store = flux.Store(S, Event);
+        const bindings = bigBindings(S);
+        const Engine = SyncEngine(S, &bindings);
+        const a = std.fmt.comptimePrint("f{d}", .{n / 2});
+        const b = std.fmt.comptimePrint("f{d}", .{n - 1});
+
+        fn reducePlain(s: *S, e: Event) void {
+            switch (e) {
+                .tick => s.f0 += 1,
+                .a => @field(s, a) += 1,
+                .b => @field(s, b) += 1,
+            }
+        }
+
+        fn reduceTracked(s: Store.Tracked, e: Event) void {
+            switch (e) {
+                .tick => s.ptr(.f0).* += 1,
+                .a => s.ptr(@field(Store.Tracked.Field, a)).* += 1,
+                .b => s.ptr(@field(Store.Tracked.Field, b)).* += 1,
+            }
+        }
+
+        /// ns per frame: dispatch, sync, commitFrame
+        fn frameNs(tracked: bool) !f64 {
+            var store = if (tracked) Store.initTracked(.{}, reduceTracked) else Store.init(.{}, reducePlain);
+            var engine = Engine.init();
+            const frames = BIG_FRAMES;
+
+            var timer = try std.time.Timer.start();
+            for (0..frames) |i| {
+                const other: Event = if (i % 2 == 0) .a else .b;
+                store.dispatchBatch(&.{ .tick, other });
+                if (tracked) {
+                    engine.syncMask(store.getState(), store.getPrev(), store.changes());
+                } else {
+                    engine.sync(store.getState(), store.getPrev());
+                }
+                store.commitFrame();
+            }
+            const elapsed = timer.read();
+            std.mem.doNotOptimizeAway(big_sink);
+            // Two fields change per frame in both modes
+            try std.testing.expectEqual(@as(u64, 2 * frames), engine.getStats().property_updates);
+            return @as(f64, @floatFromInt(elapsed)) / frames;
+        }
+    };
+}
+
+const BIG_FRAMES = 20_000;
+
+test "comparison: sync cost vs state size (full diff vs change mask)" {
+    std.debug.print(
+        \\
+        \\=== Sync cost per frame vs state size (2 fields change per frame) ===
+        \\
+        \\  {s:>8} {s:>12} {s:>12} {s:>8}
+        \\
+    , .{ "fields", "full diff", "mask", "ratio" });
+
+    var last_full: f64 = 0;
+    var last_mask: f64 = 0;
+    inline for (.{ 16, 64, 256, 512 }) |n| {
+        const App = BigApp(n);
+        const full = try App.frameNs(false);
+        const mask = try App.frameNs(true);
+        std.debug.print("  {d:>8} {d:>10.0}ns {d:>10.0}ns {d:>7.1}x\n", .{ n, full, mask, full / mask });
+        last_full = full;
+        last_mask = mask;
+    }
+
+    try std.testing.expect(last_mask < last_full);
+}
@@ -42,8 +42,23 @@
 //! ctx.tick(ms);
 //! _ = ctx.handler();  // LVGL flushes only dirty widget areas
 //! ```
+//!
+//! ## Change masks
+//!
+//! With a tracked reducer (`fn reduce(s: flux.Tracked(State), e: Event)`)
+//! the store knows which fields each frame touched. Give bindings the
+//! fields they read and sync with the mask; bindings whose fields did not
+//! change are skipped without looking at the state:
+//!
+//! ```zig
+//! const bindings = [_]lvgl_flux.ViewBinding(State){
+//!     .{ .sync_fn = syncCount, .fields = lvgl_flux.watch(State, .{.count}) },
+//! };
+//! engine.syncMask(app.getState(), app.getPrev(), app.changes());
+//! ```
 
 const std = @import("std");
+const flux = @import("flux");
 
 /// Render statistics for benchmarking and monitoring.
 pub const RenderStats = struct {
@@ -80,9 +95,17 @@ pub fn ViewBinding(comptime State: type) type {
         /// Sync function: reads state, updates LVGL widget if needed.
         /// Returns true if a widget property was updated.
         sync_fn: *const fn (state: *const State, prev: *const State) bool,
+        /// Fields the sync function reads. `syncMask` skips the binding
+        /// unless one of them changed; the default runs it every frame.
+        fields: flux.FieldMask(State) = .initFull(),
     };
 }
 
+/// Field mask for `ViewBinding.fields`: `watch(State, .{ .score, .page })`
+pub fn watch(comptime State: type, comptime fields: anytype) flux.FieldMask(State) {
+    return comptime flux.FieldMask(State).of(fields);
+}
+
 /// SyncEngine drives LVGL widget updates from Flux state changes.
 ///
 /// It holds an array of ViewBindings and iterates them on each sync() call,
@@ -122,6 +145,23 @@ pub fn SyncEngine(comptime State: type, comptime bindings: []const ViewBinding(S
             }
         }
 
+        /// Sync only the bindings whose `fields` intersect `changed` (from
+        /// `Store.changes()`). Cost follows the changed fields, not the
+        /// size of `State`.
+        pub fn syncMask(self: *Self, state: *const State, prev: *const State, changed: flux.FieldMask(State)) void {
+            var updates: u64 = 0;
+            inline for (bindings) |binding| {
+                if (binding.fields.intersects(changed) and binding.sync_fn(state, prev)) {
+                    updates += 1;
+                }
+            }
+            self.stats.frame_count += 1;
+            self.stats.property_updates += updates;
+            if (updates == 0) {
+                self.stats.skipped_frames += 1;
+            }
+        }
+
         /// Get render statistics.
         pub fn getStats(self: *const Self) RenderStats {
             return self.stats;
@@ -273,6 +313,34 @@ test "SyncEngine: bindingCount" {
     try std.testing.expectEqual(@as(usize, 3), SyncEngine(State, &bindings).bindingCount());
 }
 
+test "SyncEngine: syncMask skips bindings outside the mask" {
+    const State = struct { x: u32 = 0, y: u32 = 0 };
+    const Counter = struct {
+        var calls: u32 = 0;
+        fn f(s: *const State, p: *const State) bool {
+            calls += 1;
+            return s.x != p.x or s.y != p.y;
+        }
+    };
+
+    const bindings = [_]ViewBinding(State){
+        .{ .sync_fn = Counter.f, .fields = watch(State, .{.x}) },
+        .{ .sync_fn = Counter.f, .fields = watch(State, .{.y}) },
+        .{ .sync_fn = Counter.f }, // watches everything
+    };
+
+    var engine = SyncEngine(State, &bindings).init();
+    const s0 = State{};
+    const s1 = State{ .x = 1 };
+    engine.syncMask(&s1, &s0, watch(State, .{.x}));
+    try std.testing.expectEqual(@as(u32, 2), Counter.calls);
+    try std.testing.expectEqual(@as(u64, 2), engine.stats.property_updates);
+
+    engine.syncMask(&s1, &s1, .initEmpty());
+    try std.testing.expectEqual(@as(u32, 2), Counter.calls);
+    try std.testing.expectEqual(@as(u64, 1), engine.stats.skipped_frames);
+}
+
 test "RenderStats: reset" {
     var stats = RenderStats{
         .frame_count = 100,
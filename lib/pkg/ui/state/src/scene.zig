@@ -55,6 +55,13 @@
 //! const Game = ui.Compositor(FB, GameState, .{ ScoreLabel, PlayerCar });
 //! Game.render(&fb, state, prev, false);
 //! ```
+//!
+//! ## Change Masks
+//!
+//! Components may also declare the state fields they read, e.g.
+//! `pub const fields = .{ .score };`. `renderMask` takes the field mask
+//! of a tracked flux store (`store.changes()`) and skips components whose
+//! fields did not change before calling their `changed`.
 
 const Rect = @import("dirty.zig").Rect;
 
@@ -67,6 +74,8 @@ const Rect = @import("dirty.zig").Rect;
 ///   - `pub fn changed(*const State, *const State) bool`
 ///   - `pub fn draw(*Fb, *const State) void`
 ///   - `const bg: u16` (optional, default 0x0000)
+///   - `const fields` (optional): tuple of the State field tags it reads,
+///     used by `renderMask`
 pub fn Compositor(comptime Fb: type, comptime State: type, comptime components: anytype) type {
     return struct {
         /// Render the scene. Only components where state changed get redrawn.
@@ -80,26 +89,46 @@ pub fn Compositor(comptime Fb: type, comptime State: type, comptime components:
             var redrawn: u8 = 0;
             inline for (components) |C| {
                 if (first_frame or C.changed(state, prev)) {
-                    const bg = if (@hasDecl(C, "bg")) C.bg else 0x0000;
-                    const old_rect = C.bounds(prev);
-                    const new_rect = C.bounds(state);
-
-                    // Clear old position
-                    fb.fillRect(old_rect.x, old_rect.y, old_rect.w, old_rect.h, bg);
-
-                    // If moved, also clear new position (in case another component was there)
-                    if (!old_rect.eql(new_rect)) {
-                        fb.fillRect(new_rect.x, new_rect.y, new_rect.w, new_rect.h, bg);
-                    }
+                    redraw(C, fb, state, prev);
+                    redrawn += 1;
+                }
+            }
+            return redrawn;
+        }
 
-                    // Draw at current position
-                    C.draw(fb, state);
+        /// Like `render`, but components that declare `fields` are skipped
+        /// without calling `changed` unless `changed_fields` (a
+        /// `flux.FieldMask(State)`) has one of them set.
+        pub fn renderMask(fb: *Fb, state: *const State, prev: *const State, changed_fields: anytype, first_frame: bool) u8 {
+            const Mask = @TypeOf(changed_fields);
+            var redrawn: u8 = 0;
+            inline for (components) |C| {
+                const watched = comptime if (@hasDecl(C, "fields")) Mask.of(C.fields) else Mask.initFull();
+                if (first_frame or (watched.intersects(changed_fields) and C.changed(state, prev))) {
+                    redraw(C, fb, state, prev);
                     redrawn += 1;
                 }
             }
             return redrawn;
         }
 
+        fn redraw(comptime C: type, fb: *Fb, state: *const State, prev: *const State) void {
+            const bg = if (@hasDecl(C, "bg")) C.bg else 0x0000;
+            const old_rect = C.bounds(prev);
+            const new_rect = C.bounds(state);
+
+            // Clear old position
+            fb.fillRect(old_rect.x, old_rect.y, old_rect.w, old_rect.h, bg);
+
+            // If moved, also clear new position (in case another component was there)
+            if (!old_rect.eql(new_rect)) {
+                fb.fillRect(new_rect.x, new_rect.y, new_rect.w, new_rect.h, bg);
+            }
+
+            // Draw at current position
+            C.draw(fb, state);
+        }
+
         /// Number of components.
         pub fn count() usize {
             return components.len;
@@ -186,6 +215,7 @@ const GameState = struct {
 
 const HudScore = struct {
     const bg: u16 = 0x2104;
+    pub const fields = .{.score};
 
     pub fn bounds(_: *const GameState) Rect {
         return .{ .x = 0, .y = 0, .w = 240, .h = 20 };
@@ -206,6 +236,7 @@ const HudScore = struct {
 
 const HudTimer = struct {
     const bg: u16 = 0x2104;
+    pub const fields = .{.time_sec};
 
     pub fn bounds(_: *const GameState) Rect {
         return .{ .x = 180, .y = 0, .w = 60, .h = 20 };
@@ -334,6 +365,38 @@ test "Compositor: score + player → 2 components redrawn" {
     try testing.expectEqual(@as(u8, 2), n);
 }
 
+/// Stand-in for flux.FieldMask(GameState): one bit per field
+const TestMask = struct {
+    bits: u4,
+
+    fn of(list: anytype) TestMask {
+        var m = TestMask{ .bits = 0 };
+        inline for (list) |f| m.bits |= @as(u4, 1) << @intFromEnum(@as(std.meta.FieldEnum(GameState), f));
+        return m;
+    }
+
+    fn initFull() TestMask {
+        return .{ .bits = 0xf };
+    }
+
+    fn intersects(a: TestMask, b: TestMask) bool {
+        return a.bits & b.bits != 0;
+    }
+};
+
+test "Compositor: renderMask skips components outside the mask" {
+    var fb = TestFB.init(0);
+    fb.clearDirty();
+    const prev = GameState{ .score = 10, .time_sec = 1 };
+    const curr = GameState{ .score = 11, .time_sec = 2 };
+
+    // Mask says only the timer changed: HudScore is skipped even though
+    // its changed() would be true; components without fields still run.
+    try testing.expectEqual(@as(u8, 1), Game.renderMask(&fb, &curr, &prev, TestMask.of(.{.time_sec}), false));
+    try testing.expectEqual(@as(u8, 2), Game.renderMask(&fb, &curr, &prev, TestMask.of(.{ .score, .time_sec }), false));
+    try testing.expectEqual(@as(u8, 4), Game.renderMask(&fb, &curr, &prev, TestMask.of(.{}), true));
+}
+
 test "Compositor: count" {
     try testing.expectEqual(@as(usize, 4), Game.count());
 }
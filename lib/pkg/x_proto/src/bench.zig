@@ -0,0 +1,212 @@
+//! x_proto Envelope Benchmark
+//!
+//! Effective goodput of READ_X → WRITE_X transfers over the MockTransport
+//! for representative BLE payloads, raw vs enveloped. Air time is modeled
+//! from the packet count (MTU 247, 15ms connection interval, 6 notifies
+//! per event); encode and decode time is measured on the host.
+//!
+//!   BM1: goodput per payload (JSON config, log text, RGB565 UI asset,
+//!        random bytes) for raw, CRC32 only, LZ + CRC32 and LZ + SHA-256
+//!
+//! Run:
+//!   bazel test //lib/pkg/x_proto:bench --test_output=all
+
+const std = @import("std");
+const x_proto = @import("x_proto.zig");
+const chunk = x_proto.chunk;
+const envelope = x_proto.envelope;
+const print = std.debug.print;
+
+const Mock = @import("mock_transport.zig").MockTransportWith(.{
+    .sent_data = 1 << 16,
+    .sent_entries = 1024,
+    .recv_entries = 1024,
+    .recv_data = 1 << 16,
+});
+
+const MTU: u16 = 247;
+const CONN_INTERVAL_US: u64 = 15_000;
+const PACKETS_PER_EVENT: u64 = 6;
+const CPU_ITERS = 50;
+const MAX_PAYLOAD = 16 * 1024;
+
+// ============================================================================
+// Payloads
+// ============================================================================
+
+fn jsonConfig(buf: []u8) []u8 {
+    var w: usize = 0;
+    var i: usize = 0;
+    const names = [_][]const u8{ "wifi", "display", "audio", "sensor", "power", "ble" };
+    while (w + 160 < buf.len) : (i += 1) {
+        const entry = std.fmt.bufPrint(buf[w..],
+            \\{{"section":"{s}","id":{d},"enabled":{s},"interval_ms":{d},"label":"{s} channel {d}"}},
+            \\
+        , .{ names[i % names.len], i, if (i % 3 == 0) "false" else "true", (i % 5 + 1) * 250, names[i % names.len], i % 8 }) catch break;
+        w += entry.len;
+    }
+    return buf[0..w];
+}
+
+fn logText(buf: []u8) []u8 {
+    var w: usize = 0;
+    var i: usize = 0;
+    const msgs = [_][]const u8{ "wifi: connected rssi=-61", "battery: 3.91V 78%", "ui: frame 16ms", "ble: conn param update interval=15ms", "sensor: temp=23.4C hum=41%" };
+    while (w + 80 < buf.len) : (i += 1) {
+        const line = std.fmt.bufPrint(buf[w..], "[{d:0>8}] I {s}\n", .{ 1000 + i * 37, msgs[(i * 7) % msgs.len] }) catch break;
+        w += line.len;
+    }
+    return buf[0..w];
+}
+
+/// 64x64 RGB565 icon: flat background, a filled circle, a gradient bar
+fn uiAsset(buf: []u8) []u8 {
+    const side = 64;
+    const out = buf[0 .. side * side * 2];
+    for (0..side) |y| {
+        for (0..side) |x| {
+            const dx = @as(i32, @intCast(x)) - 32;
+            const dy = @as(i32, @intCast(y)) - 28;
+            const px: u16 = if (y >= 56)
+                @intCast((x / 4) << 11 | 0x07E0)
+            else if (dx * dx + dy * dy < 20 * 20)
+                0xFD20
+            else
+                0x2104;
+            std.mem.writeInt(u16, out[(y * side + x) * 2 ..][0..2], px, .little);
+        }
+    }
+    return out;
+}
+
+fn randomBytes(buf: []u8) []u8 {
+    const out = buf[0 .. 8 * 1024];
+    var prng = std.Random.DefaultPrng.init(42);
+    prng.random().bytes(out);
+    return out;
+}
+
+// ============================================================================
+// Measurement
+// ============================================================================
+
+const Mode = struct {
+    name: []const u8,
+    /// null = legacy client (bare start magic, raw payload)
+    caps: ?envelope.Caps,
+    encoding: envelope.Options = .{},
+};
+
+const modes = [_]Mode{
+    .{ .name = "raw", .caps = null },
+    .{ .name = "crc32", .caps = .all, .encoding = .{ .check = .crc32 } },
+    .{ .name = "lz+crc32", .caps = .all, .encoding = .{ .codec = .lz, .check = .crc32 } },
+    .{ .name = "lz+sha256", .caps = .all, .encoding = .{ .codec = .lz, .check = .sha256 } },
+};
+
+const Result = struct {
+    packets: usize,
+    wire_bytes: usize,
+    cpu_us: f64,
+
+    fn airUs(self: Result) f64 {
+        const events = (self.packets + PACKETS_PER_EVENT - 1) / PACKETS_PER_EVENT;
+        return @floatFromInt(events * CONN_INTERVAL_US);
+    }
+
+    /// Payload bytes per second of air + CPU time
+    fn goodput(self: Result, payload_len: usize) f64 {
+        return @as(f64, @floatFromInt(payload_len)) / ((self.airUs() + self.cpu_us) / 1e6);
+    }
+};
+
+/// One READ_X transfer replayed into WRITE_X, checked end to end, plus the
+/// average encode + decode CPU time.
+fn transfer(allocator: std.mem.Allocator, data: []const u8, mode: Mode) !Result {
+    const read_mock = try allocator.create(Mock);
+    defer allocator.destroy(read_mock);
+    const write_mock = try allocator.create(Mock);
+    defer allocator.destroy(write_mock);
+    read_mock.* = .{};
+    write_mock.* = .{};
+
+    var start: [5]u8 = undefined;
+    start[0..4].* = chunk.start_magic;
+    if (mode.caps) |caps| start[4] = @bitCast(caps);
+    read_mock.scriptRecv(if (mode.caps != null) &start else start[0..4]);
+    read_mock.scriptRecv(&chunk.ack_signal);
+
+    var scratch: [envelope.maxEncodedLen(MAX_PAYLOAD)]u8 = undefined;
+    var rx = x_proto.ReadX(Mock).init(read_mock, data, .{
+        .mtu = MTU,
+        .send_redundancy = 1,
+        .encoding = mode.encoding,
+        .scratch = &scratch,
+    });
+    try rx.run();
+
+    for (0..read_mock.sent_count) |i| write_mock.scriptRecv(read_mock.getSent(i));
+    var recv_buf: [envelope.maxEncodedLen(MAX_PAYLOAD)]u8 = undefined;
+    var decoded: [MAX_PAYLOAD]u8 = undefined;
+    var wx = x_proto.WriteX(Mock).init(write_mock, &recv_buf, .{ .mtu = MTU, .accept = mode.caps, .scratch = &decoded });
+    const received = try wx.run();
+    try std.testing.expectEqualSlices(u8, data, received.data);
+
+    var cpu_us: f64 = 0;
+    if (mode.caps != null) {
+        var timer = try std.time.Timer.start();
+        for (0..CPU_ITERS) |_| {
+            const e = try envelope.encode(data, &scratch, mode.encoding);
+            std.mem.doNotOptimizeAway(try envelope.decode(e, &decoded, .all));
+        }
+        cpu_us = @as(f64, @floatFromInt(timer.read())) / CPU_ITERS / std.time.ns_per_us;
+    }
+
+    return .{
+        .packets = read_mock.sent_count,
+        .wire_bytes = read_mock.sent_data_size,
+        .cpu_us = cpu_us,
+    };
+}
+
+test "BM1: effective goodput, raw vs enveloped" {
+    const allocator = std.testing.allocator;
+    var bufs: [4][MAX_PAYLOAD]u8 = undefined;
+    const payloads = [_]struct { name: []const u8, data: []const u8 }{
+        .{ .name = "json config", .data = jsonConfig(&bufs[0]) },
+        .{ .name = "log text", .data = logText(&bufs[1]) },
+        .{ .name = "ui asset", .data = uiAsset(&bufs[2]) },
+        .{ .name = "random", .data = randomBytes(&bufs[3]) },
+    };
+
+    print("\n[bench] MTU {d}, {d} notifies per {d}ms event\n", .{ MTU, PACKETS_PER_EVENT, CONN_INTERVAL_US / 1000 });
+    print("[bench]   {s:<12} {s:<10} {s:>7} {s:>8} {s:>6} {s:>8} {s:>8} {s:>10} {s:>7}\n", .{
+        "payload", "mode", "bytes", "wire", "pkts", "air ms", "cpu us", "goodput", "vs raw",
+    });
+
+    for (payloads) |p| {
+        var raw_goodput: f64 = 0;
+        var raw_packets: usize = 0;
+        for (modes) |mode| {
+            const r = try transfer(allocator, p.data, mode);
+            const g = r.goodput(p.data.len);
+            if (mode.caps == null) {
+                raw_goodput = g;
+                raw_packets = r.packets;
+            }
+            print("[bench]   {s:<12} {s:<10} {d:>7} {d:>8} {d:>6} {d:>8.0} {d:>8.1} {d:>7.1}kB/s {d:>6.2}x\n", .{
+                p.name,     mode.name,     p.data.len, r.wire_bytes, r.packets,
+                r.airUs() / 1000, r.cpu_us, g / 1024, g / raw_goodput,
+            });
+
+            if (mode.encoding.codec == .lz) {
+                if (std.mem.eql(u8, p.name, "random")) {
+                    // Stored fallback: at most one extra packet
+                    try std.testing.expect(r.packets <= raw_packets + 1);
+                } else {
+                    try std.testing.expect(g > raw_goodput);
+                }
+            }
+        }
+    }
+}
@@ -0,0 +1,597 @@
+//! envelope — Optional compression and integrity for X-Protocol payloads
+//!
+//! Wraps a whole READ_X / WRITE_X payload before it is chunked. Chunking,
+//! loss lists and retransmission are unchanged; the envelope only changes
+//! which bytes are chunked.
+//!
+//! ## Envelope Format
+//!
+//! ```
+//! Byte 0-1:  magic 0xFFFE
+//! Byte 2:    [check 4bit][codec 4bit]
+//! Byte 3-6:  original payload length (u32, big-endian)
+//! Body:      codec none → original bytes
+//!            codec lz   → blocks of ≤ 4096 original bytes, each
+//!                         [stored 1bit][len 15bit] (u16, big-endian)
+//!                         followed by an LZ4 block (or the raw bytes
+//!                         when stored)
+//! Trailer:   check of the original payload: none, CRC32 (4B) or SHA-256 (32B)
+//! ```
+//!
+//! Blocks are compressed independently, so the LZ window — and the
+//! compressor's hash table — is bounded by `block_size`, and a receiver
+//! can decode in place: `decodeInPlace` moves the received envelope to
+//! the end of the receive buffer and expands it towards the front.
+//!
+//! ## Negotiation
+//!
+//! A READ_X client that understands envelopes appends a `Caps` byte to
+//! the start magic (`0xFFFF0001 caps`); the server then always answers
+//! with an envelope, using the codec and check it is configured for when
+//! the client supports them. WRITE_X has no start message, so a server
+//! that wants envelopes says so out of band (e.g. the same caps byte in a
+//! device-info characteristic) and then treats every payload as one.
+//! Payloads are never told apart by sniffing the magic.
+
+const std = @import("std");
+
+// ============================================================================
+// Constants
+// ============================================================================
+
+/// Envelope magic, checked when decoding.
+pub const magic = [2]u8{ 0xFF, 0xFE };
+
+/// Envelope header size in bytes.
+pub const header_size: usize = 7;
+
+/// Original bytes per LZ block; bounds window and compressor memory.
+pub const block_size: usize = 4096;
+
+/// Largest trailer (SHA-256).
+pub const max_trailer_size: usize = 32;
+
+const block_header_size: usize = 2;
+const stored_flag: u16 = 0x8000;
+const hash_bits = 12;
+const min_match: usize = 4;
+/// LZ4 block rules: the last 5 bytes are literals, the last match starts
+/// at least 12 bytes before the end.
+const last_literals: usize = 5;
+const mf_limit: usize = 12;
+
+// ============================================================================
+// Types
+// ============================================================================
+
+pub const Codec = enum(u4) { none = 0, lz = 1, _ };
+
+pub const Check = enum(u4) {
+    none = 0,
+    crc32 = 1,
+    sha256 = 2,
+    _,
+
+    /// Trailer size in bytes.
+    pub fn size(self: Check) usize {
+        return switch (self) {
+            .none => 0,
+            .crc32 => 4,
+            .sha256 => 32,
+            _ => 0,
+        };
+    }
+};
+
+/// What the sender applies.
+pub const Options = struct {
+    codec: Codec = .none,
+    check: Check = .none,
+};
+
+/// Envelope features a peer understands (one byte on the wire).
+pub const Caps = packed struct(u8) {
+    lz: bool = false,
+    crc32: bool = false,
+    sha256: bool = false,
+    _reserved: u5 = 0,
+
+    pub const none: Caps = .{};
+    pub const all: Caps = .{ .lz = true, .crc32 = true, .sha256 = true };
+
+    pub fn any(self: Caps) bool {
+        return @as(u8, @bitCast(self)) != 0;
+    }
+
+    pub fn hasCodec(self: Caps, codec: Codec) bool {
+        return switch (codec) {
+            .none => true,
+            .lz => self.lz,
+            _ => false,
+        };
+    }
+
+    pub fn hasCheck(self: Caps, check: Check) bool {
+        return switch (check) {
+            .none => true,
+            .crc32 => self.crc32,
+            .sha256 => self.sha256,
+            _ => false,
+        };
+    }
+
+    /// Downgrade `want` to what this peer supports.
+    pub fn pick(self: Caps, want: Options) Options {
+        return .{
+            .codec = if (self.hasCodec(want.codec)) want.codec else .none,
+            .check = if (self.hasCheck(want.check)) want.check else .none,
+        };
+    }
+};
+
+pub const Error = error{
+    /// Output buffer too small (or, in place, too little headroom)
+    NoSpace,
+    InvalidEnvelope,
+    /// Codec or check not in the accepted `Caps`
+    Unsupported,
+    /// Body does not decode to the declared length
+    Corrupt,
+    IntegrityMismatch,
+};
+
+/// Decoded envelope header.
+pub const Header = struct {
+    codec: Codec,
+    check: Check,
+    len: u32,
+
+    pub fn encode(self: Header) [header_size]u8 {
+        var out: [header_size]u8 = undefined;
+        out[0..2].* = magic;
+        out[2] = @as(u8, @intFromEnum(self.check)) << 4 | @intFromEnum(self.codec);
+        std.mem.writeInt(u32, out[3..7], self.len, .big);
+        return out;
+    }
+
+    pub fn decode(bytes: *const [header_size]u8) Error!Header {
+        if (!std.mem.eql(u8, bytes[0..2], &magic)) return error.InvalidEnvelope;
+        return .{
+            .codec = @enumFromInt(@as(u4, @truncate(bytes[2]))),
+            .check = @enumFromInt(@as(u4, @truncate(bytes[2] >> 4))),
+            .len = std.mem.readInt(u32, bytes[3..7], .big),
+        };
+    }
+};
+
+// ============================================================================
+// Encoding
+// ============================================================================
+
+/// Check if data starts with the envelope magic.
+pub fn isEnvelope(data: []const u8) bool {
+    return data.len >= header_size and std.mem.eql(u8, data[0..2], &magic);
+}
+
+/// Worst-case envelope size for `len` payload bytes (incompressible data
+/// falls back to stored blocks).
+pub fn maxEncodedLen(len: usize) usize {
+    const blocks = (len + block_size - 1) / block_size;
+    return header_size + len + blocks * block_header_size + max_trailer_size;
+}
+
+/// Wrap `src` into `dst`. Returns the written slice of `dst`.
+pub fn encode(src: []const u8, dst: []u8, options: Options) Error![]u8 {
+    if (src.len > std.math.maxInt(u32)) return error.NoSpace;
+    const trailer = options.check.size();
+    if (dst.len < header_size + trailer) return error.NoSpace;
+
+    const hdr = (Header{ .codec = options.codec, .check = options.check, .len = @intCast(src.len) }).encode();
+    @memcpy(dst[0..header_size], &hdr);
+    var w: usize = header_size;
+    const body_end = dst.len - trailer;
+
+    switch (options.codec) {
+        .none => {
+            if (src.len > body_end - w) return error.NoSpace;
+            @memcpy(dst[w..][0..src.len], src);
+            w += src.len;
+        },
+        .lz => {
+            var offset: usize = 0;
+            while (offset < src.len) : (offset += block_size) {
+                const block = src[offset..@min(src.len, offset + block_size)];
+                if (body_end - w < block_header_size) return error.NoSpace;
+                const out = dst[w + block_header_size .. body_end];
+                if (compressBlock(block, out)) |n| {
+                    std.mem.writeInt(u16, dst[w..][0..2], @intCast(n), .big);
+                    w += block_header_size + n;
+                } else {
+                    if (block.len > out.len) return error.NoSpace;
+                    std.mem.writeInt(u16, dst[w..][0..2], stored_flag | @as(u16, @intCast(block.len)), .big);
+                    @memcpy(out[0..block.len], block);
+                    w += block_header_size + block.len;
+                }
+            }
+        },
+        _ => return error.Unsupported,
+    }
+
+    var digest_buf: [max_trailer_size]u8 = undefined;
+    const d = digest(options.check, src, &digest_buf);
+    @memcpy(dst[w..][0..d.len], d);
+    return dst[0 .. w + d.len];
+}
+
+/// Header and trailer of a `codec = .none` envelope around some payload.
+/// A sender can transmit `head`, the payload itself and `tail()` in turn
+/// instead of copying the payload into an output buffer.
+pub const Frame = struct {
+    head: [header_size]u8,
+    trailer: [max_trailer_size]u8,
+    trailer_len: u8,
+
+    pub fn tail(self: *const Frame) []const u8 {
+        return self.trailer[0..self.trailer_len];
+    }
+
+    /// Envelope size: header, payload and trailer.
+    pub fn encodedLen(self: *const Frame, payload_len: usize) usize {
+        return header_size + payload_len + self.trailer_len;
+    }
+};
+
+/// Build the `Frame` for sending `src` uncompressed with `check`.
+pub fn frame(src: []const u8, check: Check) Error!Frame {
+    if (src.len > std.math.maxInt(u32)) return error.NoSpace;
+    var f: Frame = .{
+        .head = (Header{ .codec = .none, .check = check, .len = @intCast(src.len) }).encode(),
+        .trailer = undefined,
+        .trailer_len = 0,
+    };
+    f.trailer_len = @intCast(digest(check, src, &f.trailer).len);
+    return f;
+}
+
+/// LZ4-format block compressor. Returns the compressed size, or null when
+/// the block does not shrink or does not fit in `dst`.
+fn compressBlock(src: []const u8, dst: []u8) ?usize {
+    std.debug.assert(src.len <= block_size);
+    // Position + 1 of the last occurrence of each 4-byte hash; 0 = empty
+    var table = [_]u16{0} ** (1 << hash_bits);
+    var w: usize = 0;
+    var anchor: usize = 0;
+    var i: usize = 0;
+    const limit = if (src.len > mf_limit) src.len - mf_limit else 0;
+
+    while (i < limit) {
+        const seq = read32(src, i);
+        const h = hash(seq);
+        const cand = table[h];
+        table[h] = @intCast(i + 1);
+        if (cand == 0 or read32(src, cand - 1) != seq) {
+            i += 1;
+            continue;
+        }
+        const m: usize = cand - 1;
+        var len: usize = min_match;
+        while (i + len < src.len - last_literals and src[m + len] == src[i + len]) len += 1;
+        w = emitSequence(dst, w, src[anchor..i], i - m, len) orelse return null;
+        i += len;
+        anchor = i;
+    }
+    w = emitSequence(dst, w, src[anchor..], 0, 0) orelse return null;
+    return if (w < src.len) w else null;
+}
+
+fn read32(buf: []const u8, i: usize) u32 {
+    return std.mem.readInt(u32, buf[i..][0..4], .little);
+}
+
+fn hash(seq: u32) usize {
+    return (seq *% 2654435761) >> (32 - hash_bits);
+}
+
+/// Token, literals and (unless `match_len` is 0, the final sequence) the
+/// match offset and length.
+fn emitSequence(dst: []u8, start: usize, literals: []const u8, offset: usize, match_len: usize) ?usize {
+    const lit = literals.len;
+    const ml = if (match_len > 0) match_len - min_match else 0;
+    const need = 1 + lit / 255 + 1 + lit + 2 + ml / 255 + 1;
+    if (start + need > dst.len) return null;
+
+    var w = start;
+    const token: u8 = @as(u8, @intCast(@min(lit, 15))) << 4 | @as(u8, @intCast(@min(ml, 15)));
+    dst[w] = token;
+    w += 1;
+    if (lit >= 15) w = putLength(dst, w, lit - 15);
+    @memcpy(dst[w..][0..lit], literals);
+    w += lit;
+    if (match_len == 0) return w;
+
+    std.mem.writeInt(u16, dst[w..][0..2], @intCast(offset), .little);
+    w += 2;
+    if (ml >= 15) w = putLength(dst, w, ml - 15);
+    return w;
+}
+
+fn putLength(dst: []u8, start: usize, len: usize) usize {
+    var w = start;
+    var n = len;
+    while (n >= 255) : (n -= 255) {
+        dst[w] = 255;
+        w += 1;
+    }
+    dst[w] = @intCast(n);
+    return w + 1;
+}
+
+fn digest(check: Check, data: []const u8, out: *[max_trailer_size]u8) []const u8 {
+    switch (check) {
+        .crc32 => {
+            std.mem.writeInt(u32, out[0..4], std.hash.Crc32.hash(data), .big);
+            return out[0..4];
+        },
+        .sha256 => {
+            std.crypto.hash.sha2.Sha256.hash(data, out[0..32], .{});
+            return out[0..32];
+        },
+        else => return out[0..0],
+    }
+}
+
+// ============================================================================
+// Decoding
+// ============================================================================
+
+/// Unwrap `src` into `dst`, accepting only the features in `accept`.
+/// Returns the payload slice of `dst`.
+pub fn decode(src: []const u8, dst: []u8, accept: Caps) Error![]u8 {
+    return decodeInto(src, dst, accept);
+}
+
+/// Unwrap the envelope in `buf[0..len]` within `buf` itself. The payload
+/// ends up at the front of `buf`. Needs `buf` to hold the payload plus a
+/// little headroom (the envelope overhead of incompressible stretches);
+/// fails with `error.NoSpace` otherwise.
+pub fn decodeInPlace(buf: []u8, len: usize, accept: Caps) Error![]u8 {
+    const tail = buf[buf.len - len ..];
+    std.mem.copyBackwards(u8, tail, buf[0..len]);
+    return decodeInto(tail, buf, accept);
+}
+
+fn decodeInto(src: []const u8, dst: []u8, accept: Caps) Error![]u8 {
+    if (src.len < header_size) return error.InvalidEnvelope;
+    const hdr = try Header.decode(src[0..header_size]);
+    if (!accept.hasCodec(hdr.codec) or !accept.hasCheck(hdr.check)) return error.Unsupported;
+    if (hdr.len > dst.len) return error.NoSpace;
+
+    const trailer = hdr.check.size();
+    if (src.len < header_size + trailer) return error.InvalidEnvelope;
+    // In place, the output may grow over the trailer: keep a copy
+    var expected: [max_trailer_size]u8 = undefined;
+    @memcpy(expected[0..trailer], src[src.len - trailer ..]);
+
+    const body = src[header_size .. src.len - trailer];
+    const out = dst[0..hdr.len];
+    switch (hdr.codec) {
+        .none => {
+            if (body.len != out.len) return error.Corrupt;
+            std.mem.copyForwards(u8, out, body);
+        },
+        .lz => {
+            var lz = Lz.init(body, out);
+            try lz.run();
+        },
+        _ => return error.Unsupported,
+    }
+
+    var actual: [max_trailer_size]u8 = undefined;
+    if (!std.mem.eql(u8, digest(hdr.check, out, &actual), expected[0..trailer])) return error.IntegrityMismatch;
+    return out;
+}
+
+/// Block decoder. `src` and `dst` may share a buffer with `src` at the
+/// higher address; writes never overtake unread input.
+const Lz = struct {
+    src: []const u8,
+    dst: []u8,
+    in: usize = 0,
+    out: usize = 0,
+    aliased: bool,
+
+    fn init(src: []const u8, dst: []u8) Lz {
+        const s = @intFromPtr(src.ptr);
+        const d = @intFromPtr(dst.ptr);
+        return .{
+            .src = src,
+            .dst = dst,
+            .aliased = s < d + dst.len and d < s + src.len,
+        };
+    }
+
+    fn run(self: *Lz) Error!void {
+        while (self.in < self.src.len) {
+            if (self.src.len - self.in < block_header_size) return error.Corrupt;
+            const hdr = std.mem.readInt(u16, self.src[self.in..][0..2], .big);
+            self.in += block_header_size;
+            const n: usize = hdr & ~stored_flag;
+            if (n > self.src.len - self.in) return error.Corrupt;
+
+            if (hdr & stored_flag != 0) {
+                try self.literals(n, self.in + n);
+            } else {
+                try self.block(self.in + n);
+            }
+        }
+        if (self.out != self.dst.len) return error.Corrupt;
+    }
+
+    fn block(self: *Lz, end: usize) Error!void {
+        const start = self.out;
+        while (true) {
+            const token = try self.byte(end);
+            try self.literals(try self.length(token >> 4, end), end);
+            if (self.in == end) break;
+
+            if (end - self.in < 2) return error.Corrupt;
+            const offset: usize = std.mem.readInt(u16, self.src[self.in..][0..2], .little);
+            self.in += 2;
+            const len = try self.length(token & 0xF, end) + min_match;
+            if (offset == 0 or offset > self.out - start) return error.Corrupt;
+            try self.reserve(self.out + len);
+            // Byte-wise: matches may overlap their own output
+            for (0..len) |k| self.dst[self.out + k] = self.dst[self.out - offset + k];
+            self.out += len;
+        }
+        if (self.out - start > block_size) return error.Corrupt;
+    }
+
+    fn byte(self: *Lz, end: usize) Error!u8 {
+        if (self.in >= end) return error.Corrupt;
+        defer self.in += 1;
+        return self.src[self.in];
+    }
+
+    fn length(self: *Lz, nibble: u8, end: usize) Error!usize {
+        var n: usize = nibble;
+        if (nibble != 15) return n;
+        while (true) {
+            const b = try self.byte(end);
+            n += b;
+            if (b != 255) return n;
+        }
+    }
+
+    /// Copy `n` literal bytes; they must lie before the block's `end`
+    fn literals(self: *Lz, n: usize, end: usize) Error!void {
+        if (n > end - self.in) return error.Corrupt;
+        try self.reserve(self.out);
+        if (n > self.dst.len - self.out) return error.Corrupt;
+        std.mem.copyForwards(u8, self.dst[self.out..][0..n], self.src[self.in..][0..n]);
+        self.in += n;
+        self.out += n;
+    }
+
+    /// Writing up to `dst[end]` must stay within `dst` and, in place,
+    /// behind the next unread input byte.
+    fn reserve(self: *Lz, end: usize) Error!void {
+        if (end > self.dst.len) return error.Corrupt;
+        if (self.aliased and @intFromPtr(self.dst.ptr) + end > @intFromPtr(self.src.ptr) + self.in) return error.NoSpace;
+    }
+};
+
+// ============================================================================
+// Tests
+// ============================================================================
+
+const testing = std.testing;
+
+fn sampleJson(buf: []u8) []u8 {
+    var w: usize = 0;
+    var i: usize = 0;
+    while (true) : (i += 1) {
+        const line = std.fmt.bufPrint(buf[w..], "{{\"id\":{d},\"name\":\"sensor-{d}\",\"enabled\":true,\"interval_ms\":1000}},\n", .{ i, i % 7 }) catch break;
+        w += line.len;
+    }
+    return buf[0..w];
+}
+
+test "Header encode/decode roundtrip" {
+    const h = Header{ .codec = .lz, .check = .sha256, .len = 123456 };
+    const d = try Header.decode(&h.encode());
+    try testing.expectEqual(h, d);
+    try testing.expectError(error.InvalidEnvelope, Header.decode(&[_]u8{ 0xFF, 0xFF, 0, 0, 0, 0, 0 }));
+}
+
+test "Caps pick downgrades unsupported features" {
+    const want = Options{ .codec = .lz, .check = .sha256 };
+    try testing.expectEqual(Options{ .codec = .lz, .check = .none }, (Caps{ .lz = true, .crc32 = true }).pick(want));
+    try testing.expectEqual(want, Caps.all.pick(want));
+    try testing.expect(!Caps.none.any());
+}
+
+test "roundtrip for every codec and check" {
+    var json_buf: [6000]u8 = undefined;
+    const json = sampleJson(&json_buf);
+    var noise: [3000]u8 = undefined;
+    var prng = std.Random.DefaultPrng.init(1);
+    prng.random().bytes(&noise);
+
+    var enc: [maxEncodedLen(6000)]u8 = undefined;
+    var dec: [6000]u8 = undefined;
+    for ([_][]const u8{ json, &noise, "", "a", "abcdabcdabcdabcdabcd" }) |payload| {
+        for ([_]Codec{ .none, .lz }) |codec| {
+            for ([_]Check{ .none, .crc32, .sha256 }) |check| {
+                const e = try encode(payload, &enc, .{ .codec = codec, .check = check });
+                try testing.expect(isEnvelope(e));
+                try testing.expect(e.len <= maxEncodedLen(payload.len));
+                try testing.expectEqualSlices(u8, payload, try decode(e, &dec, Caps.all));
+            }
+        }
+    }
+
+    // Repetitive text shrinks several-fold
+    const e = try encode(json, &enc, .{ .codec = .lz });
+    try testing.expect(e.len * 3 < json.len);
+}
+
+test "frame matches an uncompressed encode" {
+    const payload = "framed without a copy";
+    var enc: [maxEncodedLen(payload.len)]u8 = undefined;
+    for ([_]Check{ .none, .crc32, .sha256 }) |check| {
+        const f = try frame(payload, check);
+        const e = try encode(payload, &enc, .{ .check = check });
+        try testing.expectEqual(e.len, f.encodedLen(payload.len));
+        try testing.expectEqualSlices(u8, e[0..header_size], &f.head);
+        try testing.expectEqualSlices(u8, payload, e[header_size..][0..payload.len]);
+        try testing.expectEqualSlices(u8, e[header_size + payload.len ..], f.tail());
+    }
+}
+
+test "decodeInPlace expands within the receive buffer" {
+    var json_buf: [5000]u8 = undefined;
+    const json = sampleJson(&json_buf);
+    var buf: [5100]u8 = undefined;
+    const e = try encode(json, &buf, .{ .codec = .lz, .check = .crc32 });
+    try testing.expectEqualSlices(u8, json, try decodeInPlace(&buf, e.len, Caps.all));
+
+    // Incompressible payload in a buffer without headroom
+    var noise: [600]u8 = undefined;
+    var prng = std.Random.DefaultPrng.init(2);
+    prng.random().bytes(&noise);
+    var tight: [600 + header_size + 2]u8 = undefined;
+    const n = (try encode(&noise, &tight, .{ .codec = .lz })).len;
+    try testing.expectEqualSlices(u8, &noise, try decodeInPlace(&tight, n, Caps.all));
+}
+
+test "corruption is detected" {
+    var json_buf: [2000]u8 = undefined;
+    const json = sampleJson(&json_buf);
+    var enc: [maxEncodedLen(2000)]u8 = undefined;
+    var dec: [2000]u8 = undefined;
+
+    // Flip one of the final literals (just before the CRC): the LZ stream
+    // still parses
+    const e = try encode(json, &enc, .{ .codec = .lz, .check = .crc32 });
+    e[e.len - 4 - 2] ^= 0x01;
+    try testing.expectError(error.IntegrityMismatch, decode(e, &dec, Caps.all));
+
+    const s = try encode(json, &enc, .{ .check = .sha256 });
+    s[header_size + 5] ^= 0x80;
+    try testing.expectError(error.IntegrityMismatch, decode(s, &dec, Caps.all));
+
+    // Unaccepted features and truncated bodies
+    const c = try encode(json, &enc, .{ .codec = .lz, .check = .sha256 });
+    try testing.expectError(error.Unsupported, decode(c, &dec, .{ .lz = true }));
+    try testing.expectError(error.Corrupt, decode(c[0 .. c.len / 2], &dec, Caps.all));
+    try testing.expectError(error.NoSpace, decode(c, dec[0..100], Caps.all));
+}
+
+test "literal runs cannot cross the block end" {
+    // Block 1 (2 bytes) claims 5 literals that would run into block 2
+    const env = Header.encode(.{ .codec = .lz, .check = .none, .len = 8 }) ++
+        [_]u8{ 0x00, 0x02, 0x50, 'a' } ++ [_]u8{ 0x80, 0x03, 'x', 'y', 'z' };
+    var dec: [16]u8 = undefined;
+    try testing.expectError(error.Corrupt, decode(&env, &dec, Caps.all));
+}
@@ -0,0 +1,98 @@
+//! mock_transport — scripted Transport for x_proto tests and benchmarks
+//!
+//! Records sent messages and replays scripted responses, for
+//! deterministic protocol runs without threads or real I/O.
+
+/// Storage limits of a `MockTransportWith`.
+pub const Limits = struct {
+    sent_data: usize = 16384,
+    sent_entries: usize = 256,
+    recv_entries: usize = 64,
+    recv_data: usize = 4096,
+};
+
+/// Default-sized mock, small enough for the stack.
+pub const MockTransport = MockTransportWith(.{});
+
+pub fn MockTransportWith(comptime limits: Limits) type {
+    return struct {
+        const Self = @This();
+
+        // -- Sent data storage --
+        sent_data: [limits.sent_data]u8 = undefined,
+        sent_lens: [limits.sent_entries]usize = undefined,
+        sent_count: usize = 0,
+        sent_data_size: usize = 0,
+
+        // -- Recv script storage --
+        recv_items: [limits.recv_entries]RecvItem = undefined,
+        recv_count: usize = 0,
+        recv_idx: usize = 0,
+        recv_data_buf: [limits.recv_data]u8 = undefined,
+        recv_data_offset: usize = 0,
+
+        const RecvItem = struct {
+            offset: usize,
+            len: usize,
+            is_timeout: bool,
+        };
+
+        pub fn send(self: *Self, data: []const u8) error{Overflow}!void {
+            if (self.sent_count >= limits.sent_entries) return error.Overflow;
+            if (self.sent_data_size + data.len > limits.sent_data) return error.Overflow;
+            @memcpy(self.sent_data[self.sent_data_size .. self.sent_data_size + data.len], data);
+            self.sent_lens[self.sent_count] = data.len;
+            self.sent_count += 1;
+            self.sent_data_size += data.len;
+        }
+
+        pub fn recv(self: *Self, buf: []u8, timeout_ms: u32) error{Overflow}!?usize {
+            _ = timeout_ms;
+            if (self.recv_idx >= self.recv_count) return null;
+            const item = self.recv_items[self.recv_idx];
+            self.recv_idx += 1;
+            if (item.is_timeout) return null;
+            if (item.len > buf.len) return error.Overflow;
+            @memcpy(buf[0..item.len], self.recv_data_buf[item.offset .. item.offset + item.len]);
+            return item.len;
+        }
+
+        // ---- Test setup helpers ----
+
+        pub fn scriptRecv(self: *Self, data: []const u8) void {
+            self.recv_items[self.recv_count] = .{
+                .offset = self.recv_data_offset,
+                .len = data.len,
+                .is_timeout = false,
+            };
+            @memcpy(
+                self.recv_data_buf[self.recv_data_offset .. self.recv_data_offset + data.len],
+                data,
+            );
+            self.recv_data_offset += data.len;
+            self.recv_count += 1;
+        }
+
+        pub fn scriptTimeout(self: *Self) void {
+            self.recv_items[self.recv_count] = .{ .offset = 0, .len = 0, .is_timeout = true };
+            self.recv_count += 1;
+        }
+
+        pub fn getSent(self: *const Self, idx: usize) []const u8 {
+            var offset: usize = 0;
+            for (self.sent_lens[0..idx]) |l| {
+                offset += l;
+            }
+            return self.sent_data[offset .. offset + self.sent_lens[idx]];
+        }
+
+        /// Mutable view of a sent message, for corrupting it before replay.
+        pub fn getSentMut(self: *Self, idx: usize) []u8 {
+            var offset: usize = 0;
+            for (self.sent_lens[0..idx]) |l| {
+                offset += l;
+            }
+            return self.sent_data[offset .. offset + self.sent_lens[idx]];
+        }
+    };
+}
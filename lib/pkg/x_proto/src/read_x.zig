@@ -24,8 +24,17 @@
 //! 3. Wait for ACK (0xFFFF) or loss list from client
 //! 4. If loss list → retransmit marked chunks → goto 3
 //! 5. If ACK → transfer complete
+//!
+//! A client may append an `envelope.Caps` byte to the start magic. The
+//! server then sends the payload wrapped in an envelope (see
+//! envelope.zig), compressed and checksummed as configured in
+//! `Options.encoding` and supported by the client. Compression encodes
+//! into `Options.scratch`; without compression, or when the compressed
+//! envelope does not fit in scratch, the payload goes out uncompressed,
+//! read straight from `data` between the envelope header and trailer.
 
 const chunk = @import("chunk.zig");
+const envelope = @import("envelope.zig");
 
 pub fn ReadX(comptime Transport: type) type {
     return struct {
@@ -37,6 +46,8 @@ pub fn ReadX(comptime Transport: type) type {
         send_redundancy: u8,
         start_timeout_ms: u32,
         ack_timeout_ms: u32,
+        encoding: envelope.Options,
+        scratch: []u8,
 
         pub const Options = struct {
             mtu: u16 = 247,
@@ -47,6 +58,12 @@ pub fn ReadX(comptime Transport: type) type {
             start_timeout_ms: u32 = 5_000,
             /// Timeout waiting for ACK or loss list after sending all chunks (ms).
             ack_timeout_ms: u32 = 20_000,
+            /// Compression and check for clients that advertise envelope caps.
+            encoding: envelope.Options = .{},
+            /// Output buffer for compressed envelopes; up to
+            /// `envelope.maxEncodedLen(data.len)` bytes. When it is too small
+            /// the payload is sent uncompressed (still checked).
+            scratch: []u8 = &.{},
         };
 
         pub fn init(transport: *Transport, data: []const u8, options: Options) Self {
@@ -57,6 +74,8 @@ pub fn ReadX(comptime Transport: type) type {
                 .send_redundancy = options.send_redundancy,
                 .start_timeout_ms = options.start_timeout_ms,
                 .ack_timeout_ms = options.ack_timeout_ms,
+                .encoding = options.encoding,
+                .scratch = options.scratch,
             };
         }
 
@@ -66,8 +85,33 @@ pub fn ReadX(comptime Transport: type) type {
         pub fn run(self: *Self) !void {
             if (self.data.len == 0) return error.EmptyData;
 
+            var recv_buf: [chunk.max_mtu]u8 = undefined;
+
+            // Phase 1: Wait for start magic from client
+            const start_len = (try self.transport.recv(&recv_buf, self.start_timeout_ms)) orelse
+                return error.Timeout;
+            if (!chunk.isStartMagic(recv_buf[0..start_len])) return error.InvalidStartMagic;
+
+            // Legacy clients send the bare magic and get the raw payload
+            var framed: envelope.Frame = undefined;
+            var payload = Payload{ .body = self.data };
+            if (start_len > chunk.start_magic.len) {
+                const caps: envelope.Caps = @bitCast(recv_buf[chunk.start_magic.len]);
+                const options = caps.pick(self.encoding);
+                const encoded: ?[]const u8 = if (options.codec == .none) null else envelope.encode(self.data, self.scratch, options) catch |err| switch (err) {
+                    error.NoSpace => null,
+                    else => return err,
+                };
+                if (encoded) |e| {
+                    payload = .{ .body = e };
+                } else {
+                    framed = try envelope.frame(self.data, options.check);
+                    payload = .{ .head = &framed.head, .body = self.data, .tail = framed.tail() };
+                }
+            }
+
             const dcs = chunk.dataChunkSize(self.mtu);
-            const total_usize = chunk.chunksNeeded(self.data.len, self.mtu);
+            const total_usize = chunk.chunksNeeded(payload.len(), self.mtu);
             if (total_usize > chunk.max_chunks) return error.TooManyChunks;
             const total: u16 = @intCast(total_usize);
 
@@ -75,16 +119,9 @@ pub fn ReadX(comptime Transport: type) type {
             var sndmask: [chunk.max_mask_bytes]u8 = undefined;
             chunk.Bitmask.initAllSet(sndmask[0..mask_len], total);
 
-            var recv_buf: [chunk.max_mtu]u8 = undefined;
-
-            // Phase 1: Wait for start magic from client
-            const start_len = (try self.transport.recv(&recv_buf, self.start_timeout_ms)) orelse
-                return error.Timeout;
-            if (!chunk.isStartMagic(recv_buf[0..start_len])) return error.InvalidStartMagic;
-
             // Phase 2: Send/retransmit loop
             while (true) {
-                try self.sendMarkedChunks(sndmask[0..mask_len], total, dcs);
+                try self.sendMarkedChunks(&payload, sndmask[0..mask_len], total, dcs);
 
                 // Wait for ACK or loss list
                 const resp_len = (try self.transport.recv(&recv_buf, self.ack_timeout_ms)) orelse
@@ -106,8 +143,37 @@ pub fn ReadX(comptime Transport: type) type {
             }
         }
 
-        /// Send all chunks whose bit is set in `sndmask`.
-        fn sendMarkedChunks(self: *Self, sndmask: []const u8, total: u16, dcs: usize) !void {
+        /// The bytes to chunk: `head`, `body` and `tail` back to back, so an
+        /// uncompressed envelope is sent without copying `data`.
+        const Payload = struct {
+            head: []const u8 = &.{},
+            body: []const u8,
+            tail: []const u8 = &.{},
+
+            fn len(self: *const Payload) usize {
+                return self.head.len + self.body.len + self.tail.len;
+            }
+
+            /// Copy `out.len` bytes starting at `offset`.
+            fn copy(self: *const Payload, offset: usize, out: []u8) void {
+                var at = offset;
+                var w: usize = 0;
+                for ([_][]const u8{ self.head, self.body, self.tail }) |part| {
+                    if (at >= part.len) {
+                        at -= part.len;
+                        continue;
+                    }
+                    const n = @min(part.len - at, out.len - w);
+                    @memcpy(out[w..][0..n], part[at..][0..n]);
+                    w += n;
+                    at = 0;
+                    if (w == out.len) return;
+                }
+            }
+        };
+
+        /// Send all chunks of `payload` whose bit is set in `sndmask`.
+        fn sendMarkedChunks(self: *Self, payload: *const Payload, sndmask: []const u8, total: u16, dcs: usize) !void {
             var chunk_buf: [chunk.max_mtu]u8 = undefined;
             var i: u16 = 0;
             while (i < total) : (i += 1) {
@@ -120,14 +186,11 @@ pub fn ReadX(comptime Transport: type) type {
 
                 // Compute payload range
                 const offset: usize = @as(usize, i) * dcs;
-                const remaining = self.data.len - offset;
+                const remaining = payload.len() - offset;
                 const payload_len: usize = @min(remaining, dcs);
 
                 // Copy payload
-                @memcpy(
-                    chunk_buf[chunk.header_size .. chunk.header_size + payload_len],
-                    self.data[offset .. offset + payload_len],
-                );
+                payload.copy(offset, chunk_buf[chunk.header_size .. chunk.header_size + payload_len]);
 
                 // Send with redundancy
                 const total_len = chunk.header_size + payload_len;
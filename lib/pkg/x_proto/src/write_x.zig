@@ -15,8 +15,15 @@
 //! 3. If all received → send ACK (0xFFFF) → return data
 //! 4. If timeout → send loss list → continue receiving
 //! 5. If max retries exceeded → error
+//!
+//! `Options.accept` is set when the client was told (out of band) to send
+//! envelopes (see envelope.zig). Every completed payload is then decoded
+//! into `Options.scratch` and its check verified before the ACK; a payload
+//! that is not a valid envelope is not ACKed and `recv_buf` keeps the raw
+//! bytes. The payload itself is never sniffed for the envelope magic.
 
 const chunk = @import("chunk.zig");
+const envelope = @import("envelope.zig");
 
 pub fn WriteX(comptime Transport: type) type {
     return struct {
@@ -27,6 +34,8 @@ pub fn WriteX(comptime Transport: type) type {
         mtu: u16,
         timeout_ms: u32,
         max_retries: u8,
+        accept: ?envelope.Caps,
+        scratch: []u8,
 
         pub const Options = struct {
             mtu: u16 = 247,
@@ -34,11 +43,20 @@ pub fn WriteX(comptime Transport: type) type {
             timeout_ms: u32 = 3_000,
             /// Max consecutive timeouts before giving up.
             max_retries: u8 = 5,
+            /// Set when the client was told to send envelopes: every payload
+            /// must be one, using only these features. Null takes payloads
+            /// as raw bytes.
+            accept: ?envelope.Caps = null,
+            /// Receives the decoded payload when `accept` is set; must hold
+            /// the largest payload expected.
+            scratch: []u8 = &.{},
         };
 
         /// Result of a successful WRITE_X transfer.
         pub const Result = struct {
-            /// Slice of the caller-provided recv_buf containing the received data.
+            /// Slice of the caller-provided recv_buf containing the received
+            /// data, or of `scratch` holding the decoded payload when
+            /// `accept` is set.
             data: []const u8,
         };
 
@@ -49,13 +67,16 @@ pub fn WriteX(comptime Transport: type) type {
                 .mtu = options.mtu,
                 .timeout_ms = options.timeout_ms,
                 .max_retries = options.max_retries,
+                .accept = options.accept,
+                .scratch = options.scratch,
             };
         }
 
         /// Run the WRITE_X protocol to completion.
         ///
         /// Blocks until all chunks are received or an error/timeout occurs.
-        /// Returns a Result whose `.data` is a slice of the caller-provided recv_buf.
+        /// Returns a Result whose `.data` is a slice of the caller-provided
+        /// recv_buf (or scratch, for envelopes).
         pub fn run(self: *Self) !Result {
             const dcs = chunk.dataChunkSize(self.mtu);
             const max_chunk_msg = @as(usize, self.mtu) - chunk.att_overhead;
@@ -115,10 +136,15 @@ pub fn WriteX(comptime Transport: type) type {
 
                     // Check completeness
                     if (chunk.Bitmask.isComplete(rcvmask[0..mask_len], total)) {
+                        const data_len = (@as(usize, total) - 1) * dcs + last_chunk_len;
+                        const data = self.recv_buf[0..data_len];
+                        const payload = if (self.accept) |caps|
+                            try envelope.decode(data, self.scratch, caps)
+                        else
+                            data;
                         // All chunks received — send ACK
                         try self.transport.send(&chunk.ack_signal);
-                        const data_len = (@as(usize, total) - 1) * dcs + last_chunk_len;
-                        return .{ .data = self.recv_buf[0..data_len] };
+                        return .{ .data = payload };
                     }
                 } else {
                     // -- Timeout --
@@ -38,11 +38,31 @@
 //! const result = try wx.run();
 //! // result.data contains the received bytes
 //! ```
+//!
+//! ## Compression and Integrity
+//!
+//! Payloads can travel in an envelope (envelope.zig): LZ-compressed in
+//! 4KB blocks and followed by a CRC32 or SHA-256 of the original bytes.
+//! READ_X clients opt in by appending a caps byte to the start magic;
+//! WRITE_X servers that told their clients (out of band) to send envelopes
+//! set `Options.accept` and a `scratch` buffer for the decoded payload.
+//!
+//! ```zig
+//! var scratch: [x_proto.envelope.maxEncodedLen(data.len)]u8 = undefined;
+//! var rx = x_proto.ReadX(MyTransport).init(&transport, data, .{
+//!     .encoding = .{ .codec = .lz, .check = .crc32 },
+//!     .scratch = &scratch,
+//! });
+//!
+//! var decoded: [4096]u8 = undefined;
+//! var wx = x_proto.WriteX(MyTransport).init(&transport, &buf, .{ .accept = .all, .scratch = &decoded });
+//! ```
 
 // Re-export sub-modules
 pub const chunk = @import("chunk.zig");
 pub const read_x = @import("read_x.zig");
 pub const write_x = @import("write_x.zig");
+pub const envelope = @import("envelope.zig");
 
 // Convenience aliases
 pub fn ReadX(comptime Transport: type) type {
@@ -60,6 +80,7 @@ pub const start_magic = chunk.start_magic;
 pub const ack_signal = chunk.ack_signal;
 pub const dataChunkSize = chunk.dataChunkSize;
 pub const chunksNeeded = chunk.chunksNeeded;
+pub const Caps = envelope.Caps;
 
 // ============================================================================
 // Tests — pull in all sub-module tests
@@ -69,90 +90,12 @@ test {
     _ = chunk;
     _ = read_x;
     _ = write_x;
+    _ = envelope;
 }
 
 const std = @import("std");
 
-// ============================================================================
-// Mock Transport for Testing
-// ============================================================================
-
-/// A test transport that records sent messages and replays scripted responses.
-/// Used for deterministic protocol testing without threads or real I/O.
-const MockTransport = struct {
-    const max_sent_data: usize = 16384;
-    const max_sent_entries: usize = 256;
-    const max_recv_entries: usize = 64;
-    const max_recv_data: usize = 4096;
-
-    // -- Sent data storage --
-    sent_data: [max_sent_data]u8 = undefined,
-    sent_lens: [max_sent_entries]usize = undefined,
-    sent_count: usize = 0,
-    sent_data_size: usize = 0,
-
-    // -- Recv script storage --
-    recv_items: [max_recv_entries]RecvItem = undefined,
-    recv_count: usize = 0,
-    recv_idx: usize = 0,
-    recv_data_buf: [max_recv_data]u8 = undefined,
-    recv_data_offset: usize = 0,
-
-    const RecvItem = struct {
-        offset: usize,
-        len: usize,
-        is_timeout: bool,
-    };
-
-    pub fn send(self: *MockTransport, data: []const u8) error{Overflow}!void {
-        if (self.sent_count >= max_sent_entries) return error.Overflow;
-        if (self.sent_data_size + data.len > max_sent_data) return error.Overflow;
-        @memcpy(self.sent_data[self.sent_data_size .. self.sent_data_size + data.len], data);
-        self.sent_lens[self.sent_count] = data.len;
-        self.sent_count += 1;
-        self.sent_data_size += data.len;
-    }
-
-    pub fn recv(self: *MockTransport, buf: []u8, timeout_ms: u32) error{Overflow}!?usize {
-        _ = timeout_ms;
-        if (self.recv_idx >= self.recv_count) return null;
-        const item = self.recv_items[self.recv_idx];
-        self.recv_idx += 1;
-        if (item.is_timeout) return null;
-        if (item.len > buf.len) return error.Overflow;
-        @memcpy(buf[0..item.len], self.recv_data_buf[item.offset .. item.offset + item.len]);
-        return item.len;
-    }
-
-    // ---- Test setup helpers ----
-
-    fn scriptRecv(self: *MockTransport, data: []const u8) void {
-        self.recv_items[self.recv_count] = .{
-            .offset = self.recv_data_offset,
-            .len = data.len,
-            .is_timeout = false,
-        };
-        @memcpy(
-            self.recv_data_buf[self.recv_data_offset .. self.recv_data_offset + data.len],
-            data,
-        );
-        self.recv_data_offset += data.len;
-        self.recv_count += 1;
-    }
-
-    fn scriptTimeout(self: *MockTransport) void {
-        self.recv_items[self.recv_count] = .{ .offset = 0, .len = 0, .is_timeout = true };
-        self.recv_count += 1;
-    }
-
-    fn getSent(self: *const MockTransport, idx: usize) []const u8 {
-        var offset: usize = 0;
-        for (self.sent_lens[0..idx]) |l| {
-            offset += l;
-        }
-        return self.sent_data[offset .. offset + self.sent_lens[idx]];
-    }
-};
+const MockTransport = @import("mock_transport.zig").MockTransport;
 
 /// Helper: build a chunk packet (header + payload) into a buffer.
 fn buildChunkPacket(buf: []u8, total: u16, seq: u16, payload: []const u8) []u8 {
@@ -509,3 +452,183 @@ test "end-to-end: large data with multiple MTU sizes" {
         try std.testing.expectEqualSlices(u8, &data, result.data);
     }
 }
+
+// ============================================================================
+// Envelope Tests
+// ============================================================================
+
+/// Start magic followed by a caps byte
+fn startWithCaps(caps: envelope.Caps) [5]u8 {
+    var msg: [5]u8 = undefined;
+    msg[0..4].* = chunk.start_magic;
+    msg[4] = @bitCast(caps);
+    return msg;
+}
+
+/// Repetitive JSON-ish payload
+fn configPayload(buf: []u8) []u8 {
+    var w: usize = 0;
+    var i: usize = 0;
+    while (true) : (i += 1) {
+        const line = std.fmt.bufPrint(buf[w..], "{{\"key\":\"setting_{d}\",\"value\":{d}}},", .{ i % 16, i }) catch break;
+        w += line.len;
+    }
+    return buf[0..w];
+}
+
+test "end-to-end: compressed and checked transfer" {
+    const mtu: u16 = 100;
+    var payload_buf: [3000]u8 = undefined;
+    const data = configPayload(&payload_buf);
+
+    var read_mock = MockTransport{};
+    read_mock.scriptRecv(&startWithCaps(.all));
+    read_mock.scriptRecv(&chunk.ack_signal);
+
+    var scratch: [envelope.maxEncodedLen(3000)]u8 = undefined;
+    var rx = ReadX(MockTransport).init(&read_mock, data, .{
+        .mtu = mtu,
+        .send_redundancy = 1,
+        .encoding = .{ .codec = .lz, .check = .sha256 },
+        .scratch = &scratch,
+    });
+    try rx.run();
+
+    // Fewer chunks than the raw payload needs
+    try std.testing.expect(read_mock.sent_count < chunk.chunksNeeded(data.len, mtu));
+
+    var write_mock = MockTransport{};
+    for (0..read_mock.sent_count) |i| write_mock.scriptRecv(read_mock.getSent(i));
+
+    var recv_buf: [3000]u8 = undefined;
+    var decoded: [3000]u8 = undefined;
+    var wx = WriteX(MockTransport).init(&write_mock, &recv_buf, .{ .mtu = mtu, .accept = .all, .scratch = &decoded });
+    const result = try wx.run();
+    try std.testing.expectEqualSlices(u8, data, result.data);
+    try std.testing.expectEqualSlices(u8, &chunk.ack_signal, write_mock.getSent(0));
+}
+
+test "end-to-end: client caps limit the encoding" {
+    const data = "caps-limited payload caps-limited payload caps-limited payload";
+
+    // Client only knows CRC32: no compression, CRC32 trailer
+    var read_mock = MockTransport{};
+    read_mock.scriptRecv(&startWithCaps(.{ .crc32 = true }));
+    read_mock.scriptRecv(&chunk.ack_signal);
+    var scratch: [envelope.maxEncodedLen(data.len)]u8 = undefined;
+    var rx = ReadX(MockTransport).init(&read_mock, data, .{
+        .mtu = 247,
+        .send_redundancy = 1,
+        .encoding = .{ .codec = .lz, .check = .crc32 },
+        .scratch = &scratch,
+    });
+    try rx.run();
+
+    const sent = read_mock.getSent(0)[chunk.header_size..];
+    const hdr = try envelope.Header.decode(sent[0..envelope.header_size]);
+    try std.testing.expectEqual(envelope.Codec.none, hdr.codec);
+    try std.testing.expectEqual(envelope.Check.crc32, hdr.check);
+    try std.testing.expectEqual(envelope.header_size + data.len + 4, sent.len);
+
+    // Legacy client: raw payload, scratch untouched
+    var legacy = MockTransport{};
+    legacy.scriptRecv(&chunk.start_magic);
+    legacy.scriptRecv(&chunk.ack_signal);
+    var rx2 = ReadX(MockTransport).init(&legacy, data, .{ .mtu = 247, .send_redundancy = 1 });
+    try rx2.run();
+    try std.testing.expectEqualSlices(u8, data, legacy.getSent(0)[chunk.header_size..]);
+}
+
+test "end-to-end: a server without scratch sends an uncompressed envelope" {
+    const mtu: u16 = 100;
+    var payload_buf: [1500]u8 = undefined;
+    const data = configPayload(&payload_buf);
+
+    var read_mock = MockTransport{};
+    read_mock.scriptRecv(&startWithCaps(.all));
+    read_mock.scriptRecv(&chunk.ack_signal);
+    var rx = ReadX(MockTransport).init(&read_mock, data, .{
+        .mtu = mtu,
+        .send_redundancy = 1,
+        .encoding = .{ .codec = .lz, .check = .sha256 },
+    });
+    try rx.run();
+
+    const first = read_mock.getSent(0)[chunk.header_size..];
+    const hdr = try envelope.Header.decode(first[0..envelope.header_size]);
+    try std.testing.expectEqual(envelope.Codec.none, hdr.codec);
+    try std.testing.expectEqual(envelope.Check.sha256, hdr.check);
+    try std.testing.expectEqual(chunk.chunksNeeded(envelope.header_size + data.len + 32, mtu), read_mock.sent_count);
+
+    var write_mock = MockTransport{};
+    for (0..read_mock.sent_count) |i| write_mock.scriptRecv(read_mock.getSent(i));
+    var recv_buf: [1600]u8 = undefined;
+    var decoded: [1500]u8 = undefined;
+    var wx = WriteX(MockTransport).init(&write_mock, &recv_buf, .{ .mtu = mtu, .accept = .all, .scratch = &decoded });
+    const result = try wx.run();
+    try std.testing.expectEqualSlices(u8, data, result.data);
+}
+
+test "end-to-end: corrupted payload is not ACKed" {
+    const mtu: u16 = 100;
+    var payload_buf: [2000]u8 = undefined;
+    const data = configPayload(&payload_buf);
+
+    var read_mock = MockTransport{};
+    read_mock.scriptRecv(&startWithCaps(.all));
+    read_mock.scriptRecv(&chunk.ack_signal);
+    var scratch: [envelope.maxEncodedLen(2000)]u8 = undefined;
+    var rx = ReadX(MockTransport).init(&read_mock, data, .{
+        .mtu = mtu,
+        .send_redundancy = 1,
+        .encoding = .{ .check = .crc32 },
+        .scratch = &scratch,
+    });
+    try rx.run();
+
+    // Flip a payload bit in the middle chunk
+    const mid = read_mock.getSentMut(read_mock.sent_count / 2);
+    mid[chunk.header_size + 10] ^= 0x20;
+
+    var write_mock = MockTransport{};
+    for (0..read_mock.sent_count) |i| write_mock.scriptRecv(read_mock.getSent(i));
+    var recv_buf: [2100]u8 = undefined;
+    var decoded: [2000]u8 = undefined;
+    var wx = WriteX(MockTransport).init(&write_mock, &recv_buf, .{ .mtu = mtu, .accept = .all, .scratch = &decoded });
+    try std.testing.expectError(error.IntegrityMismatch, wx.run());
+    try std.testing.expectEqual(@as(usize, 0), write_mock.sent_count);
+
+    // The received bytes are left as they arrived
+    const dcs = chunk.dataChunkSize(mtu);
+    const first = read_mock.getSent(0)[chunk.header_size..];
+    try std.testing.expectEqualSlices(u8, first, recv_buf[0..first.len]);
+    try std.testing.expectEqualSlices(u8, mid[chunk.header_size..], recv_buf[(read_mock.sent_count / 2) * dcs ..][0 .. mid.len - chunk.header_size]);
+}
+
+test "WriteX: envelopes are decoded only when negotiated" {
+    const data = "plain client payload";
+    var pkt_buf: [64]u8 = undefined;
+    var enc: [64]u8 = undefined;
+    const e = try envelope.encode(data, &enc, .{ .check = .crc32 });
+    var recv_buf: [128]u8 = undefined;
+    var decoded: [128]u8 = undefined;
+
+    // Not negotiated: a payload that looks like an envelope stays raw
+    var mock = MockTransport{};
+    mock.scriptRecv(buildChunkPacket(&pkt_buf, 1, 1, e));
+    var wx = WriteX(MockTransport).init(&mock, &recv_buf, .{ .mtu = 100 });
+    try std.testing.expectEqualSlices(u8, e, (try wx.run()).data);
+
+    var mock2 = MockTransport{};
+    mock2.scriptRecv(buildChunkPacket(&pkt_buf, 1, 1, e));
+    var wx2 = WriteX(MockTransport).init(&mock2, &recv_buf, .{ .mtu = 100, .accept = .{ .crc32 = true }, .scratch = &decoded });
+    try std.testing.expectEqualSlices(u8, data, (try wx2.run()).data);
+
+    // Negotiated: a raw payload is rejected, not passed through
+    var mock3 = MockTransport{};
+    mock3.scriptRecv(buildChunkPacket(&pkt_buf, 1, 1, data));
+    var wx3 = WriteX(MockTransport).init(&mock3, &recv_buf, .{ .mtu = 100, .accept = .{ .crc32 = true }, .scratch = &decoded });
+    try std.testing.expectError(error.InvalidEnvelope, wx3.run());
+    try std.testing.expectEqual(@as(usize, 0), mock3.sent_count);
+    try std.testing.expectEqualSlices(u8, data, recv_buf[0..data.len]);
+}
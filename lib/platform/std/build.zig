@@ -25,6 +25,13 @@ pub fn build(b: *std.Build) void {
     });
     std_impl_module.addImport("opus", opus_dep.module("opus"));
 
+    // LC3 dependency for codec impl (BLE LE Audio)
+    const lc3_dep = b.dependency("lc3", .{
+        .target = target,
+        .optimize = optimize,
+    });
+    std_impl_module.addImport("lc3", lc3_dep.module("lc3"));
+
     const test_step = b.step("test", "Run all unit tests");
 
     // Test modules (no dependencies)
@@ -32,6 +39,7 @@ pub fn build(b: *std.Build) void {
         "src/impl/sync.zig",
         "src/impl/time.zig",
         "src/impl/runtime.zig",
+        "src/impl/heap.zig",
     };
 
     for (test_files) |file| {
@@ -0,0 +1,92 @@
+//! Cancellation — std platform glue
+//!
+//! Connects `async/cancellation` scopes to the std blocking primitives.
+//! The scope type is taken as `anytype` (anything with the `Scope` API),
+//! so std_impl keeps depending on trait only.
+//!
+//! - `nowNs` is the monotonic clock to give root scopes
+//! - `Channel.recvCancellable` / `sendCancellable` wake through the
+//!   channel's condition variables
+//! - `Wake(Scope)` is an fd that turns readable on cancellation, for
+//!   `Selector.addCancel` and `Selector.waitScoped`
+//! - `Socket.recvCancellable` shuts a stream socket down for reading,
+//!   which ends a blocked `recv`; datagram sockets, where shutdown does
+//!   not reliably wake a reader, wait on a `Wake` fd next to the socket
+//!
+//! ```zig
+//! var root = Scope.init(.{ .clock = std_impl.cancel.nowNs });
+//! var wake = try std_impl.cancel.Wake(Scope).init();
+//! defer wake.deinit();
+//! wake.arm(&root);
+//! defer wake.disarm();
+//!
+//! const cancel_index = try sel.addCancel(&wake);
+//! const ready = try sel.waitScoped(&root, cancel_index, null);
+//! if (ready == cancel_index) return error.Cancelled;
+//! ```
+
+const std = @import("std");
+const posix = std.posix;
+const channel_impl = @import("channel.zig");
+
+/// Monotonic clock in nanoseconds, for `Scope.init(.{ .clock = nowNs })`
+pub fn nowNs() u64 {
+    const now = std.time.Instant.now() catch return 0;
+    return now.since(std.mem.zeroes(std.time.Instant));
+}
+
+/// Round a remaining-time budget up to whole milliseconds for poll-style
+/// timeouts, so a wait never returns before the deadline.
+pub fn msCeil(ns: u64) u32 {
+    return @intCast(@min((ns + std.time.ns_per_ms - 1) / std.time.ns_per_ms, std.math.maxInt(i32)));
+}
+
+/// An fd that becomes readable when the armed scope is cancelled and stays
+/// readable (level-triggered) until re-armed. Must not move while armed.
+pub fn Wake(comptime Scope: type) type {
+    return struct {
+        const Self = @This();
+
+        notifier: channel_impl.Notifier,
+        waker: Scope.Waker = undefined,
+        scope: ?*Scope = null,
+
+        pub fn init() !Self {
+            return .{ .notifier = try channel_impl.Notifier.init() };
+        }
+
+        pub fn deinit(self: *Self) void {
+            self.disarm();
+            self.notifier.deinit();
+        }
+
+        /// Watch `scope`. Readable immediately if it is already cancelled.
+        pub fn arm(self: *Self, scope: *Scope) void {
+            self.disarm();
+            self.notifier.consume();
+            self.waker = Scope.Waker.init(self, wake);
+            if (scope.register(&self.waker)) {
+                self.scope = scope;
+            } else {
+                self.notifier.notify();
+            }
+        }
+
+        /// Stop watching. The fd keeps its current readiness.
+        pub fn disarm(self: *Self) void {
+            const scope = self.scope orelse return;
+            scope.unregister(&self.waker);
+            self.scope = null;
+        }
+
+        /// For `Selector.addCancel` / `addSocket(.., .read)`
+        pub fn getFd(self: *const Self) posix.fd_t {
+            return self.notifier.getFd();
+        }
+
+        fn wake(ctx: *anyopaque) void {
+            const self: *Self = @ptrCast(@alignCast(ctx));
+            self.notifier.notify();
+        }
+    };
+}
@@ -20,7 +20,7 @@ const sync = @import("sync.zig");
 // Notifier — platform-specific notification fd
 // ============================================================================
 
-const Notifier = struct {
+pub const Notifier = struct {
     read_fd: posix.fd_t,
     write_fd: posix.fd_t,
 
@@ -128,6 +128,8 @@ pub fn Channel(comptime T: type, comptime capacity: usize) type {
         size: usize,
         closed: bool,
         notifier: Notifier,
+        /// Readable while the channel has free space or is closed (send readiness)
+        space_notifier: Notifier,
 
         pub fn init() !Self {
             return .{
@@ -140,11 +142,19 @@ pub fn Channel(comptime T: type, comptime capacity: usize) type {
                 .size = 0,
                 .closed = false,
                 .notifier = try Notifier.init(),
+                .space_notifier = try initSpaceNotifier(),
             };
         }
 
+        fn initSpaceNotifier() !Notifier {
+            var n = try Notifier.init();
+            n.notify(); // starts empty, so sending is possible
+            return n;
+        }
+
         pub fn deinit(self: *Self) void {
             self.notifier.deinit();
+            self.space_notifier.deinit();
         }
 
         pub fn send(self: *Self, item: T) error{Closed}!void {
@@ -164,6 +174,7 @@ pub fn Channel(comptime T: type, comptime capacity: usize) type {
             self.buffer[self.tail] = item;
             self.tail = (self.tail + 1) % capacity;
             self.size += 1;
+            if (self.size == capacity) self.space_notifier.consume();
 
             self.cond_not_empty.signal();
             self.mutex.unlock();
@@ -191,6 +202,7 @@ pub fn Channel(comptime T: type, comptime capacity: usize) type {
             self.buffer[self.tail] = item;
             self.tail = (self.tail + 1) % capacity;
             self.size += 1;
+            if (self.size == capacity) self.space_notifier.consume();
 
             self.cond_not_empty.signal();
             self.mutex.unlock();
@@ -230,6 +242,105 @@ pub fn Channel(comptime T: type, comptime capacity: usize) type {
             return self.dequeue();
         }
 
+        /// `send` that gives up with `error.Cancelled` when `scope` (an
+        /// `async/cancellation` Scope) is cancelled or its deadline passes.
+        pub fn sendCancellable(self: *Self, item: T, scope: anytype) error{ Closed, Cancelled }!void {
+            var waker = @TypeOf(scope.*).Waker.init(self, wakeWaiters);
+            if (!scope.register(&waker)) return error.Cancelled;
+            defer scope.unregister(&waker);
+
+            self.mutex.lock();
+            while (self.size >= capacity and !self.closed) {
+                switch (self.waitScoped(&self.cond_not_full, scope)) {
+                    .retry => {},
+                    .cancelled => {
+                        self.mutex.unlock();
+                        return error.Cancelled;
+                    },
+                    .expired => {
+                        self.mutex.unlock();
+                        _ = scope.checkDeadline();
+                        return error.Cancelled;
+                    },
+                }
+            }
+            if (self.closed) {
+                self.mutex.unlock();
+                return error.Closed;
+            }
+
+            const was_empty = self.size == 0;
+            self.buffer[self.tail] = item;
+            self.tail = (self.tail + 1) % capacity;
+            self.size += 1;
+            if (self.size == capacity) self.space_notifier.consume();
+
+            self.cond_not_empty.signal();
+            self.mutex.unlock();
+
+            if (was_empty) {
+                self.notifier.notify();
+            }
+        }
+
+        /// `recv` that gives up with `error.Cancelled` when `scope` is
+        /// cancelled or its deadline passes. Items already queued are
+        /// still delivered first.
+        pub fn recvCancellable(self: *Self, scope: anytype) error{Cancelled}!?T {
+            var waker = @TypeOf(scope.*).Waker.init(self, wakeWaiters);
+            if (!scope.register(&waker)) return error.Cancelled;
+            defer scope.unregister(&waker);
+
+            self.mutex.lock();
+            while (self.size == 0) {
+                if (self.closed) {
+                    self.notifier.consume();
+                    self.mutex.unlock();
+                    return null;
+                }
+                switch (self.waitScoped(&self.cond_not_empty, scope)) {
+                    .retry => {},
+                    .cancelled => {
+                        self.mutex.unlock();
+                        return error.Cancelled;
+                    },
+                    .expired => {
+                        // Cancelling runs our waker, which takes the mutex
+                        self.mutex.unlock();
+                        _ = scope.checkDeadline();
+                        return error.Cancelled;
+                    },
+                }
+            }
+            const item = self.dequeue();
+            self.mutex.unlock();
+            return item;
+        }
+
+        const ScopedWait = enum { retry, cancelled, expired };
+
+        /// One condition wait bounded by the scope's deadline. Called and
+        /// returns with the mutex held.
+        fn waitScoped(self: *Self, cond: *sync.Condition, scope: anytype) ScopedWait {
+            if (scope.isCancelled()) return .cancelled;
+            const remaining = scope.remainingNs() orelse {
+                cond.wait(&self.mutex);
+                return .retry;
+            };
+            if (remaining == 0) return .expired;
+            _ = cond.timedWait(&self.mutex, remaining);
+            return .retry;
+        }
+
+        /// Scope waker: get every blocked sender and receiver to re-check
+        fn wakeWaiters(ctx: *anyopaque) void {
+            const self: *Self = @ptrCast(@alignCast(ctx));
+            self.mutex.lock();
+            self.cond_not_empty.broadcast();
+            self.cond_not_full.broadcast();
+            self.mutex.unlock();
+        }
+
         pub fn close(self: *Self) void {
             self.mutex.lock();
             if (self.closed) {
@@ -239,6 +350,8 @@ pub fn Channel(comptime T: type, comptime capacity: usize) type {
 
             const was_empty = self.size == 0;
             self.closed = true;
+            // Senders selecting on a full channel must wake to see error.Closed
+            if (self.size == capacity) self.space_notifier.notify();
 
             self.cond_not_empty.broadcast();
             self.cond_not_full.broadcast();
@@ -273,9 +386,15 @@ pub fn Channel(comptime T: type, comptime capacity: usize) type {
             return self.notifier.getFd();
         }
 
+        /// Fd readable while `trySend` would not return `error.Full`
+        pub fn sendSelectFd(self: *const Self) posix.fd_t {
+            return self.space_notifier.getFd();
+        }
+
         fn dequeue(self: *Self) T {
             const item = self.buffer[self.head];
             self.head = (self.head + 1) % capacity;
+            if (self.size == capacity and !self.closed) self.space_notifier.notify();
             self.size -= 1;
             if (self.size == 0) {
                 self.notifier.consume();
@@ -0,0 +1,131 @@
+//! LC3 Codec Implementation — Zig std platform
+//!
+//! Wraps third_party/lc3 (liblc3) to satisfy trait.codec contracts. LC3
+//! frames are fixed-size: the encoder emits exactly `frameBytes()` per
+//! frame, derived from the bitrate. Uses a caller-provided allocator for
+//! encoder/decoder state.
+//!
+//! Usage:
+//!   const codec_impl = @import("std_impl").codec;
+//!   var enc = try codec_impl.lc3.Lc3Encoder.init(allocator, 16000, .ms10, 32000);
+//!   defer enc.deinit();
+//!   const frame = try enc.encode(&pcm, enc.frameSize(), &out); // 40 bytes
+
+const std = @import("std");
+const lc3 = @import("lc3");
+
+pub const FrameDuration = lc3.FrameDuration;
+
+/// LC3 encoder satisfying trait.codec.Encoder
+pub const Lc3Encoder = struct {
+    inner: lc3.Encoder,
+    frame_bytes: u32,
+    alloc: std.mem.Allocator,
+
+    const Self = @This();
+
+    pub fn init(
+        allocator: std.mem.Allocator,
+        sample_rate: u32,
+        duration: FrameDuration,
+        bitrate: u32,
+    ) !Self {
+        const frame_bytes = try lc3.frameBytes(duration, bitrate);
+        const inner = try lc3.Encoder.init(allocator, sample_rate, duration);
+        return .{ .inner = inner, .frame_bytes = frame_bytes, .alloc = allocator };
+    }
+
+    pub fn deinit(self: *Self) void {
+        self.inner.deinit(self.alloc);
+        self.* = undefined;
+    }
+
+    /// trait.codec.Encoder: encode one frame of PCM to LC3
+    pub fn encode(self: *Self, pcm: []const i16, frame_size: u32, out: []u8) ![]const u8 {
+        if (frame_size != self.frameSize() or pcm.len < frame_size) return error.BadArg;
+        return self.inner.encode(pcm[0..frame_size], self.frame_bytes, out);
+    }
+
+    /// trait.codec.Encoder: samples per frame
+    pub fn frameSize(self: *const Self) u32 {
+        return self.inner.frameSamples();
+    }
+
+    /// trait.codec batch extension: LC3 frames have a fixed size, so
+    /// packet `i` starts at `i * frameBytes()`. Fails before encoding
+    /// anything when `out` or `lens` cannot hold every frame.
+    pub fn encodeBatch(self: *Self, pcm: []const i16, frame_size: u32, out: []u8, lens: []u16) ![]const u8 {
+        if (frame_size != self.frameSize()) return error.BadArg;
+        const frames = pcm.len / frame_size;
+        const fb: usize = self.frame_bytes;
+        if (lens.len < frames or out.len < frames * fb) return error.BufferTooSmall;
+        for (0..frames) |i| {
+            _ = try self.inner.encode(pcm[i * frame_size ..][0..frame_size], self.frame_bytes, out[i * fb ..][0..fb]);
+            lens[i] = @intCast(fb);
+        }
+        return out[0 .. frames * fb];
+    }
+
+    // ----- lc3-specific -----
+
+    /// Change the bitrate; takes effect on the next frame.
+    pub fn setBitrate(self: *Self, bitrate: u32) !void {
+        self.frame_bytes = try lc3.frameBytes(self.inner.duration, bitrate);
+    }
+
+    /// Encoded bytes per frame at the current bitrate
+    pub fn frameBytes(self: *const Self) u32 {
+        return self.frame_bytes;
+    }
+};
+
+/// LC3 decoder satisfying trait.codec.Decoder
+pub const Lc3Decoder = struct {
+    inner: lc3.Decoder,
+    alloc: std.mem.Allocator,
+
+    const Self = @This();
+
+    pub fn init(allocator: std.mem.Allocator, sample_rate: u32, duration: FrameDuration) !Self {
+        const inner = try lc3.Decoder.init(allocator, sample_rate, duration);
+        return .{ .inner = inner, .alloc = allocator };
+    }
+
+    pub fn deinit(self: *Self) void {
+        self.inner.deinit(self.alloc);
+        self.* = undefined;
+    }
+
+    /// trait.codec.Decoder: decode one LC3 frame to PCM
+    pub fn decode(self: *Self, data: []const u8, pcm: []i16) ![]const i16 {
+        return self.inner.decode(data, pcm);
+    }
+
+    /// trait.codec.Decoder: samples per frame
+    pub fn frameSize(self: *const Self) u32 {
+        return self.inner.frameSamples();
+    }
+
+    /// trait.codec batch extension: decode consecutive frames. Fails
+    /// before decoding anything when `lens` runs past `data` or `pcm`
+    /// cannot hold every frame.
+    pub fn decodeBatch(self: *Self, data: []const u8, lens: []const u16, pcm: []i16) ![]const i16 {
+        const n = self.frameSize();
+        var total: usize = 0;
+        for (lens) |len| total += len;
+        if (total > data.len) return error.BadArg;
+        if (pcm.len < lens.len * n) return error.BufferTooSmall;
+
+        var in_off: usize = 0;
+        for (lens, 0..) |len, i| {
+            _ = try self.inner.decode(data[in_off..][0..len], pcm[i * n ..][0..n]);
+            in_off += len;
+        }
+        return pcm[0 .. lens.len * n];
+    }
+
+    /// Packet loss concealment
+    pub fn plc(self: *Self, pcm: []i16) ![]const i16 {
+        return self.inner.plc(pcm);
+    }
+};
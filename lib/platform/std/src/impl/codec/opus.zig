@@ -46,6 +46,11 @@ pub const OpusEncoder = struct {
         return self.inner.frameSizeForMs(self.frame_ms);
     }
 
+    /// trait.codec batch extension: encode consecutive frames
+    pub fn encodeBatch(self: *Self, pcm: []const i16, frame_size: u32, out: []u8, lens: []u16) ![]const u8 {
+        return self.inner.encodeBatch(pcm, frame_size, out, lens);
+    }
+
     // ----- opus-specific ctl passthrough -----
 
     pub fn setBitrate(self: *Self, bitrate: u32) !void {
@@ -92,6 +97,11 @@ pub const OpusDecoder = struct {
         return self.inner.frameSizeForMs(self.frame_ms);
     }
 
+    /// trait.codec batch extension: decode consecutive packets
+    pub fn decodeBatch(self: *Self, data: []const u8, lens: []const u16, pcm: []i16) ![]const i16 {
+        return self.inner.decodeBatch(data, lens, pcm);
+    }
+
     /// Packet loss concealment
     pub fn plc(self: *Self, pcm: []i16) ![]const i16 {
         return self.inner.plc(pcm);
@@ -0,0 +1,419 @@
+//! Fs — host filesystem driver for trait.fs
+//!
+//! Files opened `.read` are mmap'd: `File.data` points at the mapping
+//! (zero-copy), and read/seek/pread are served from it. Read-ahead is
+//! controlled with `File.advise`, which maps to madvise. Files opened
+//! `.write`/`.read_write` go through the fd with pread/pwrite.
+//!
+//! Paths are relative to the driver root; a leading '/' is ignored.
+//!
+//! Usage:
+//!   var fs = try std_impl.fs.Fs.initPath("assets");
+//!   defer fs.deinit();
+//!   var file = fs.open("/bundle.bin", .read) orelse return;
+//!   defer file.close();
+//!   file.advise(0, 0, .random);
+//!   const entry = file.data.?[offset..][0..len];
+
+const std = @import("std");
+const builtin = @import("builtin");
+const posix = std.posix;
+const trait = @import("trait");
+
+const File = trait.fs.File;
+const Dir = trait.fs.Dir;
+
+/// Maximum simultaneously open files per driver
+pub const MAX_OPEN_FILES = 32;
+/// Maximum simultaneously open directories per driver
+pub const MAX_OPEN_DIRS = 8;
+
+const Mapping = []align(std.heap.page_size_min) u8;
+
+const FileSlot = struct {
+    used: bool = false,
+    file: std.fs.File = undefined,
+    map: ?Mapping = null,
+    pos: u64 = 0,
+    size: u64 = 0,
+
+    fn mapped(self: *const FileSlot) []const u8 {
+        return self.map orelse &.{};
+    }
+};
+
+const DirSlot = struct {
+    used: bool = false,
+    dir: std.fs.Dir = undefined,
+    it: std.fs.Dir.Iterator = undefined,
+};
+
+pub const Fs = struct {
+    const Self = @This();
+
+    root: std.fs.Dir,
+    owns_root: bool,
+    mutex: std.Thread.Mutex = .{},
+    files: [MAX_OPEN_FILES]FileSlot = [_]FileSlot{.{}} ** MAX_OPEN_FILES,
+    dirs: [MAX_OPEN_DIRS]DirSlot = [_]DirSlot{.{}} ** MAX_OPEN_DIRS,
+
+    /// Driver rooted at the current working directory (board init hook)
+    pub fn init() !Self {
+        return .{ .root = std.fs.cwd(), .owns_root = false };
+    }
+
+    /// Driver rooted at `path`
+    pub fn initPath(path: []const u8) !Self {
+        return .{ .root = try std.fs.cwd().openDir(path, .{}), .owns_root = true };
+    }
+
+    /// Driver rooted at an already-open directory (not closed by deinit)
+    pub fn initDir(dir: std.fs.Dir) Self {
+        return .{ .root = dir, .owns_root = false };
+    }
+
+    pub fn deinit(self: *Self) void {
+        for (&self.files) |*slot| {
+            if (slot.used) closeSlot(slot);
+        }
+        for (&self.dirs) |*slot| {
+            if (slot.used) closeDirSlot(slot);
+        }
+        if (self.owns_root) self.root.close();
+    }
+
+    pub fn open(self: *Self, path: []const u8, mode: trait.fs.OpenMode) ?File {
+        const rel = relPath(path) orelse return null;
+        const slot = self.claim(FileSlot, &self.files) orelse return null;
+
+        slot.* = .{ .used = true };
+        slot.file = switch (mode) {
+            .read => self.root.openFile(rel, .{}),
+            .write => self.root.createFile(rel, .{}),
+            .read_write => self.root.createFile(rel, .{ .read = true, .truncate = false }),
+        } catch {
+            slot.used = false;
+            return null;
+        };
+        slot.size = slot.file.getEndPos() catch 0;
+
+        if (mode == .read) {
+            if (slot.size > 0) {
+                slot.map = posix.mmap(
+                    null,
+                    @intCast(slot.size),
+                    posix.PROT.READ,
+                    .{ .TYPE = .PRIVATE },
+                    slot.file.handle,
+                    0,
+                ) catch null;
+            }
+            if (slot.map != null or slot.size == 0) {
+                return .{
+                    .data = slot.mapped(),
+                    .ctx = @ptrCast(slot),
+                    .readFn = &mapRead,
+                    .seekFn = &mapSeek,
+                    .preadFn = &mapPread,
+                    .adviseFn = &mapAdvise,
+                    .closeFn = &close,
+                    .size = slot.size,
+                };
+            }
+            // mmap unavailable (special file): fall through to fd access
+        }
+
+        return .{
+            .ctx = @ptrCast(slot),
+            .readFn = &fdRead,
+            .writeFn = if (mode == .read) null else &fdWrite,
+            .seekFn = &fdSeek,
+            .preadFn = &fdPread,
+            .pwriteFn = if (mode == .read) null else &fdPwrite,
+            .adviseFn = &fdAdvise,
+            .syncFn = if (mode == .read) null else &fdSync,
+            .closeFn = &close,
+            .size = slot.size,
+        };
+    }
+
+    pub fn stat(self: *Self, path: []const u8) ?trait.fs.Stat {
+        const rel = relPath(path) orelse return null;
+        const st = self.root.statFile(rel) catch return null;
+        return .{
+            .size = st.size,
+            .kind = mapKind(st.kind),
+            .mtime_s = @intCast(@divFloor(st.mtime, std.time.ns_per_s)),
+        };
+    }
+
+    pub fn openDir(self: *Self, path: []const u8) ?Dir {
+        const rel = relPath(path) orelse return null;
+        const slot = self.claim(DirSlot, &self.dirs) orelse return null;
+        slot.dir = self.root.openDir(rel, .{ .iterate = true }) catch {
+            slot.used = false;
+            return null;
+        };
+        slot.it = slot.dir.iterate();
+        return .{
+            .ctx = @ptrCast(slot),
+            .nextFn = &dirNext,
+            .closeFn = &dirClose,
+        };
+    }
+
+    fn claim(self: *Self, comptime T: type, slots: []T) ?*T {
+        self.mutex.lock();
+        defer self.mutex.unlock();
+        for (slots) |*slot| {
+            if (!slot.used) {
+                slot.used = true;
+                return slot;
+            }
+        }
+        return null;
+    }
+
+    fn relPath(path: []const u8) ?[]const u8 {
+        const rel = std.mem.trimLeft(u8, path, "/");
+        return if (rel.len == 0) "." else rel;
+    }
+
+    fn mapKind(kind: std.fs.File.Kind) trait.fs.Kind {
+        return switch (kind) {
+            .file => .file,
+            .directory => .directory,
+            else => .other,
+        };
+    }
+
+    // ========================================================================
+    // mmap-backed files
+    // ========================================================================
+
+    fn slotOf(ctx: *anyopaque) *FileSlot {
+        return @ptrCast(@alignCast(ctx));
+    }
+
+    fn mapRead(ctx: *anyopaque, buf: []u8) usize {
+        const slot = slotOf(ctx);
+        const n = mapPread(ctx, buf, slot.pos);
+        slot.pos += n;
+        return n;
+    }
+
+    fn mapPread(ctx: *anyopaque, buf: []u8, offset: u64) usize {
+        const data = slotOf(ctx).mapped();
+        if (offset >= data.len) return 0;
+        const start: usize = @intCast(offset);
+        const n = @min(buf.len, data.len - start);
+        @memcpy(buf[0..n], data[start..][0..n]);
+        return n;
+    }
+
+    fn mapSeek(ctx: *anyopaque, offset: i64, whence: trait.fs.Whence) ?u64 {
+        const slot = slotOf(ctx);
+        const base: u64 = switch (whence) {
+            .start => 0,
+            .current => slot.pos,
+            .end => slot.size,
+        };
+        const target = @as(i128, base) + offset;
+        if (target < 0 or target > slot.size) return null;
+        slot.pos = @intCast(target);
+        return slot.pos;
+    }
+
+    fn mapAdvise(ctx: *anyopaque, offset: u64, len: u64, advice: trait.fs.Advice) void {
+        const slot = slotOf(ctx);
+        const map = slot.map orelse return;
+        if (offset >= map.len) return;
+        // madvise needs a page-aligned start
+        const start = std.mem.alignBackward(usize, @intCast(offset), std.heap.pageSize());
+        const end: usize = if (len == 0) map.len else @min(map.len, @as(usize, @intCast(offset +| len)));
+        const ptr: [*]align(std.heap.page_size_min) u8 = @alignCast(map.ptr + start);
+        posix.madvise(ptr, end - start, madviseFlag(advice)) catch {};
+    }
+
+    fn madviseFlag(advice: trait.fs.Advice) u32 {
+        return switch (advice) {
+            .normal => posix.MADV.NORMAL,
+            .sequential => posix.MADV.SEQUENTIAL,
+            .random => posix.MADV.RANDOM,
+            .will_need => posix.MADV.WILLNEED,
+            .dont_need => posix.MADV.DONTNEED,
+        };
+    }
+
+    // ========================================================================
+    // fd-backed files
+    // ========================================================================
+
+    fn fdRead(ctx: *anyopaque, buf: []u8) usize {
+        return slotOf(ctx).file.read(buf) catch 0;
+    }
+
+    fn fdWrite(ctx: *anyopaque, data: []const u8) usize {
+        return slotOf(ctx).file.write(data) catch 0;
+    }
+
+    fn fdPread(ctx: *anyopaque, buf: []u8, offset: u64) usize {
+        return slotOf(ctx).file.pread(buf, offset) catch 0;
+    }
+
+    fn fdPwrite(ctx: *anyopaque, data: []const u8, offset: u64) usize {
+        return slotOf(ctx).file.pwrite(data, offset) catch 0;
+    }
+
+    fn fdSeek(ctx: *anyopaque, offset: i64, whence: trait.fs.Whence) ?u64 {
+        const file = slotOf(ctx).file;
+        switch (whence) {
+            .start => file.seekTo(std.math.cast(u64, offset) orelse return null) catch return null,
+            .current => file.seekBy(offset) catch return null,
+            .end => file.seekFromEnd(offset) catch return null,
+        }
+        return file.getPos() catch null;
+    }
+
+    fn fdAdvise(ctx: *anyopaque, offset: u64, len: u64, advice: trait.fs.Advice) void {
+        if (builtin.os.tag != .linux) return;
+        const linux = std.os.linux;
+        const flag: usize = switch (advice) {
+            .normal => linux.POSIX_FADV.NORMAL,
+            .sequential => linux.POSIX_FADV.SEQUENTIAL,
+            .random => linux.POSIX_FADV.RANDOM,
+            .will_need => linux.POSIX_FADV.WILLNEED,
+            .dont_need => linux.POSIX_FADV.DONTNEED,
+        };
+        const off = std.math.cast(i64, offset) orelse return;
+        // len 0 means "to the end of the file"
+        const n = std.math.cast(i64, len) orelse 0;
+        _ = linux.fadvise(slotOf(ctx).file.handle, off, n, flag);
+    }
+
+    fn fdSync(ctx: *anyopaque) bool {
+        slotOf(ctx).file.sync() catch return false;
+        return true;
+    }
+
+    fn close(ctx: *anyopaque) void {
+        closeSlot(slotOf(ctx));
+    }
+
+    fn closeSlot(slot: *FileSlot) void {
+        if (slot.map) |m| posix.munmap(m);
+        slot.file.close();
+        slot.* = .{};
+    }
+
+    // ========================================================================
+    // Directories
+    // ========================================================================
+
+    fn dirNext(ctx: *anyopaque) ?trait.fs.DirEntry {
+        const slot: *DirSlot = @ptrCast(@alignCast(ctx));
+        const entry = (slot.it.next() catch return null) orelse return null;
+        return .{ .name = entry.name, .kind = mapKind(entry.kind) };
+    }
+
+    fn dirClose(ctx: *anyopaque) void {
+        closeDirSlot(@ptrCast(@alignCast(ctx)));
+    }
+
+    fn closeDirSlot(slot: *DirSlot) void {
+        slot.dir.close();
+        slot.* = .{};
+    }
+};
+
+// ============================================================================
+// Tests
+// ============================================================================
+
+const fs_spec = struct {
+    pub const Driver = Fs;
+    pub const meta = .{ .id = "fs.std" };
+};
+
+test "Fs matches trait.fs interface" {
+    _ = trait.fs.from(fs_spec);
+}
+
+test "read mode is zero-copy with seek and pread" {
+    var tmp = std.testing.tmpDir(.{});
+    defer tmp.cleanup();
+    try tmp.dir.writeFile(.{ .sub_path = "a.bin", .data = "hello mmap world" });
+
+    var fs = Fs.initDir(tmp.dir);
+    defer fs.deinit();
+
+    var file = fs.open("/a.bin", .read) orelse return error.TestUnexpectedResult;
+    defer file.close();
+
+    try std.testing.expectEqual(@as(u64, 16), file.size);
+    try std.testing.expectEqualStrings("hello mmap world", file.data.?);
+
+    file.advise(0, 0, .random);
+    var buf: [5]u8 = undefined;
+    try std.testing.expectEqual(@as(usize, 5), file.pread(&buf, 11));
+    try std.testing.expectEqualStrings("world", &buf);
+    try std.testing.expectEqual(@as(?u64, 6), file.seek(6, .start));
+    try std.testing.expectEqual(@as(usize, 4), file.read(buf[0..4]));
+    try std.testing.expectEqualStrings("mmap", buf[0..4]);
+    try std.testing.expectEqual(@as(?u64, null), file.seek(1, .end));
+}
+
+test "read_write mode supports pwrite and 64-bit offsets" {
+    var tmp = std.testing.tmpDir(.{});
+    defer tmp.cleanup();
+
+    var fs = Fs.initDir(tmp.dir);
+    defer fs.deinit();
+
+    var file = fs.open("/sparse.bin", .read_write) orelse return error.TestUnexpectedResult;
+    defer file.close();
+
+    const far: u64 = 5 * 1024 * 1024 * 1024; // past 4 GiB (sparse)
+    try std.testing.expectEqual(@as(usize, 3), file.pwrite("end", far));
+    try std.testing.expectEqual(@as(usize, 5), file.pwrite("start", 0));
+    try std.testing.expectEqual(far + 3, file.size);
+    try std.testing.expect(file.sync());
+
+    var buf: [3]u8 = undefined;
+    try std.testing.expectEqual(@as(usize, 3), file.pread(&buf, far));
+    try std.testing.expectEqualStrings("end", &buf);
+    try std.testing.expectEqual(@as(?u64, 0), file.tell());
+    try std.testing.expectEqual(@as(usize, 5), file.write("START"));
+    try std.testing.expectEqual(@as(?u64, far), file.seek(-3, .end));
+}
+
+test "stat and directory listing" {
+    var tmp = std.testing.tmpDir(.{});
+    defer tmp.cleanup();
+    try tmp.dir.makeDir("assets");
+    try tmp.dir.writeFile(.{ .sub_path = "assets/one.png", .data = "1" });
+    try tmp.dir.writeFile(.{ .sub_path = "assets/two.png", .data = "22" });
+    try tmp.dir.makeDir("assets/fonts");
+
+    var fs = Fs.initDir(tmp.dir);
+    defer fs.deinit();
+    var vfs = trait.fs.from(fs_spec).init(&fs);
+
+    const st = vfs.stat("/assets/two.png").?;
+    try std.testing.expectEqual(@as(u64, 2), st.size);
+    try std.testing.expectEqual(trait.fs.Kind.file, st.kind);
+    try std.testing.expectEqual(trait.fs.Kind.directory, vfs.stat("/assets").?.kind);
+    try std.testing.expect(vfs.stat("/missing") == null);
+
+    var dir = vfs.openDir("/assets") orelse return error.TestUnexpectedResult;
+    defer dir.close();
+    var files: usize = 0;
+    var dirs: usize = 0;
+    while (dir.next()) |entry| switch (entry.kind) {
+        .file => files += 1,
+        .directory => dirs += 1,
+        .other => {},
+    };
+    try std.testing.expectEqual(@as(usize, 2), files);
+    try std.testing.expectEqual(@as(usize, 1), dirs);
+}
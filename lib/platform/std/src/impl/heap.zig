@@ -0,0 +1,406 @@
+//! Memory accounting allocator for std builds
+//!
+//! Wraps a parent allocator and keeps per-subsystem counters: live bytes,
+//! peak, allocation rate and size histograms (all-time and live, the latter
+//! showing what is pinning the heap). A subsystem can get a hard budget;
+//! an allocation that would cross it fails at once with OutOfMemory (or
+//! panics with `panic_on_budget`) instead of succeeding on a roomy host
+//! and failing later on a device.
+//!
+//! Packages already take a `std.mem.Allocator`; hand each one the
+//! allocator for its tag:
+//!
+//!   var heap = std_impl.heap.Accounting(std_impl.heap.Subsystem).init(std.heap.c_allocator, .{});
+//!   heap.setBudget(.mqtt0, 64 * 1024);
+//!   var broker = try mqtt0.Broker(...).init(heap.allocator(.mqtt0), handler, .{});
+//!   var server = http.Server(...).init(heap.allocator(.http), &routes);
+//!   ...
+//!   var buf: [1024]u8 = undefined;
+//!   var stderr = std.fs.File.stderr().writer(&buf);
+//!   try heap.report(&stderr.interface);
+//!   try stderr.interface.flush();
+//!
+//! Counters are atomics, so tagged allocators may be used from several
+//! threads. The Accounting value must not move after `allocator()` has
+//! been called.
+
+const std = @import("std");
+const Allocator = std.mem.Allocator;
+const Alignment = std.mem.Alignment;
+
+/// Default tag set
+pub const Subsystem = enum {
+    app,
+    net,
+    http,
+    mqtt0,
+    tls,
+    ws,
+    dns,
+    ble,
+    audio,
+    ui,
+    other,
+};
+
+/// Histogram buckets: <=16, <=32, ..., <=32K, >32K bytes
+pub const bucket_count = 13;
+
+/// Histogram bucket for an allocation of `len` bytes
+pub fn bucketOf(len: usize) usize {
+    if (len <= 16) return 0;
+    const log2 = std.math.log2_int_ceil(usize, len);
+    return @min(log2 - 4, bucket_count - 1);
+}
+
+/// Upper bound of bucket `i` in bytes (null for the open-ended bucket)
+pub fn bucketLimit(i: usize) ?usize {
+    if (i >= bucket_count - 1) return null;
+    return @as(usize, 16) << @intCast(i);
+}
+
+pub const Options = struct {
+    /// Panic instead of returning OutOfMemory when a budget would be crossed
+    panic_on_budget: bool = false,
+};
+
+/// Point-in-time copy of one tag's counters
+pub const Counters = struct {
+    live_bytes: u64 = 0,
+    peak_bytes: u64 = 0,
+    live_allocs: u64 = 0,
+    allocs: u64 = 0,
+    frees: u64 = 0,
+    resizes: u64 = 0,
+    /// Bytes handed out over the lifetime (allocs + resize growth)
+    total_bytes: u64 = 0,
+    /// Allocations refused by the budget
+    denied: u64 = 0,
+    /// Allocations the parent could not satisfy
+    failed: u64 = 0,
+    budget: ?u64 = null,
+    sizes: [bucket_count]u64 = [_]u64{0} ** bucket_count,
+    live_sizes: [bucket_count]u64 = [_]u64{0} ** bucket_count,
+};
+
+pub fn Accounting(comptime Tag: type) type {
+    const tags = @typeInfo(Tag).@"enum".fields;
+    const Counter = std.atomic.Value(u64);
+    const no_budget = std.math.maxInt(u64);
+
+    return struct {
+        const Self = @This();
+
+        const Slot = struct {
+            owner: *Self = undefined,
+            budget: Counter = Counter.init(no_budget),
+            live_bytes: Counter = Counter.init(0),
+            peak_bytes: Counter = Counter.init(0),
+            live_allocs: Counter = Counter.init(0),
+            allocs: Counter = Counter.init(0),
+            frees: Counter = Counter.init(0),
+            resizes: Counter = Counter.init(0),
+            total_bytes: Counter = Counter.init(0),
+            denied: Counter = Counter.init(0),
+            failed: Counter = Counter.init(0),
+            sizes: [bucket_count]Counter = [_]Counter{Counter.init(0)} ** bucket_count,
+            live_sizes: [bucket_count]Counter = [_]Counter{Counter.init(0)} ** bucket_count,
+        };
+
+        parent: Allocator,
+        options: Options,
+        slots: [tags.len]Slot = [_]Slot{.{}} ** tags.len,
+        /// Start of the current rate window
+        window_start_ns: i128,
+
+        pub fn init(parent: Allocator, options: Options) Self {
+            return .{ .parent = parent, .options = options, .window_start_ns = std.time.nanoTimestamp() };
+        }
+
+        /// Allocator whose traffic is counted against `tag`.
+        pub fn allocator(self: *Self, tag: Tag) Allocator {
+            const slot = &self.slots[@intFromEnum(tag)];
+            slot.owner = self;
+            return .{ .ptr = slot, .vtable = &vtable };
+        }
+
+        /// Cap `tag`'s live bytes (null removes the cap).
+        pub fn setBudget(self: *Self, tag: Tag, bytes: ?u64) void {
+            self.slots[@intFromEnum(tag)].budget.store(bytes orelse no_budget, .monotonic);
+        }
+
+        pub fn snapshot(self: *const Self, tag: Tag) Counters {
+            const s = &self.slots[@intFromEnum(tag)];
+            var c = Counters{
+                .live_bytes = s.live_bytes.load(.monotonic),
+                .peak_bytes = s.peak_bytes.load(.monotonic),
+                .live_allocs = s.live_allocs.load(.monotonic),
+                .allocs = s.allocs.load(.monotonic),
+                .frees = s.frees.load(.monotonic),
+                .resizes = s.resizes.load(.monotonic),
+                .total_bytes = s.total_bytes.load(.monotonic),
+                .denied = s.denied.load(.monotonic),
+                .failed = s.failed.load(.monotonic),
+            };
+            const budget = s.budget.load(.monotonic);
+            if (budget != no_budget) c.budget = budget;
+            for (&c.sizes, &c.live_sizes, &s.sizes, &s.live_sizes) |*d, *ld, *src, *lsrc| {
+                d.* = src.load(.monotonic);
+                ld.* = lsrc.load(.monotonic);
+            }
+            return c;
+        }
+
+        /// Sum of live bytes over all tags
+        pub fn liveBytes(self: *const Self) u64 {
+            var n: u64 = 0;
+            for (&self.slots) |*s| n += s.live_bytes.load(.monotonic);
+            return n;
+        }
+
+        /// Reset peaks to the current live size and restart the rate window.
+        pub fn resetWindow(self: *Self) void {
+            for (&self.slots) |*s| s.peak_bytes.store(s.live_bytes.load(.monotonic), .monotonic);
+            self.window_start_ns = std.time.nanoTimestamp();
+        }
+
+        /// One line per tag with any traffic, then the non-empty histogram
+        /// buckets (all-time / live).
+        pub fn report(self: *const Self, writer: anytype) !void {
+            const elapsed_ns = @max(std.time.nanoTimestamp() - self.window_start_ns, 1);
+            const secs = @as(f64, @floatFromInt(elapsed_ns)) / 1e9;
+            try writer.print("{s:<8} {s:>10} {s:>10} {s:>8} {s:>10} {s:>10} {s:>7} {s:>10}\n", .{
+                "tag", "live", "peak", "blocks", "allocs", "allocs/s", "denied", "budget",
+            });
+            inline for (tags) |f| {
+                const c = self.snapshot(@enumFromInt(f.value));
+                if (c.allocs > 0 or c.budget != null) {
+                    try writer.print("{s:<8} {d:>10} {d:>10} {d:>8} {d:>10} {d:>10.0} {d:>7} ", .{
+                        f.name,
+                        c.live_bytes,
+                        c.peak_bytes,
+                        c.live_allocs,
+                        c.allocs,
+                        @as(f64, @floatFromInt(c.allocs)) / secs,
+                        c.denied,
+                    });
+                    if (c.budget) |b| try writer.print("{d:>10}\n", .{b}) else try writer.print("{s:>10}\n", .{"-"});
+                    for (c.sizes, c.live_sizes, 0..) |n, live, i| {
+                        if (n == 0) continue;
+                        if (bucketLimit(i)) |limit| {
+                            try writer.print("         <= {d:<7} {d:>10} / {d}\n", .{ limit, n, live });
+                        } else {
+                            try writer.print("         >  {d:<7} {d:>10} / {d}\n", .{ bucketLimit(i - 1).?, n, live });
+                        }
+                    }
+                }
+            }
+        }
+
+        // ================================================================
+        // Allocator vtable
+        // ================================================================
+
+        const vtable = Allocator.VTable{
+            .alloc = alloc,
+            .resize = resize,
+            .remap = remap,
+            .free = free,
+        };
+
+        fn slotOf(ctx: *anyopaque) *Slot {
+            return @ptrCast(@alignCast(ctx));
+        }
+
+        /// Reserve `len` more live bytes, or refuse if over budget.
+        fn reserve(slot: *Slot, len: usize) bool {
+            const live = slot.live_bytes.fetchAdd(len, .monotonic) + len;
+            if (live > slot.budget.load(.monotonic)) {
+                _ = slot.live_bytes.fetchSub(len, .monotonic);
+                _ = slot.denied.fetchAdd(1, .monotonic);
+                if (slot.owner.options.panic_on_budget) {
+                    std.debug.panic("heap budget exceeded: {d} > {d} bytes", .{ live, slot.budget.load(.monotonic) });
+                }
+                return false;
+            }
+            var peak = slot.peak_bytes.load(.monotonic);
+            while (live > peak) {
+                peak = slot.peak_bytes.cmpxchgWeak(peak, live, .monotonic, .monotonic) orelse break;
+            }
+            return true;
+        }
+
+        fn alloc(ctx: *anyopaque, len: usize, alignment: Alignment, ret_addr: usize) ?[*]u8 {
+            const slot = slotOf(ctx);
+            if (!reserve(slot, len)) return null;
+            const ptr = slot.owner.parent.rawAlloc(len, alignment, ret_addr) orelse {
+                _ = slot.live_bytes.fetchSub(len, .monotonic);
+                _ = slot.failed.fetchAdd(1, .monotonic);
+                return null;
+            };
+            const b = bucketOf(len);
+            _ = slot.allocs.fetchAdd(1, .monotonic);
+            _ = slot.live_allocs.fetchAdd(1, .monotonic);
+            _ = slot.total_bytes.fetchAdd(len, .monotonic);
+            _ = slot.sizes[b].fetchAdd(1, .monotonic);
+            _ = slot.live_sizes[b].fetchAdd(1, .monotonic);
+            return ptr;
+        }
+
+        /// Account for `memory` changing to `new_len` once the parent agreed.
+        fn resized(slot: *Slot, old_len: usize, new_len: usize) void {
+            _ = slot.resizes.fetchAdd(1, .monotonic);
+            if (new_len > old_len) {
+                _ = slot.total_bytes.fetchAdd(new_len - old_len, .monotonic);
+            } else {
+                _ = slot.live_bytes.fetchSub(old_len - new_len, .monotonic);
+            }
+            const from = bucketOf(old_len);
+            const to = bucketOf(new_len);
+            if (from != to) {
+                _ = slot.live_sizes[from].fetchSub(1, .monotonic);
+                _ = slot.live_sizes[to].fetchAdd(1, .monotonic);
+            }
+        }
+
+        fn resize(ctx: *anyopaque, memory: []u8, alignment: Alignment, new_len: usize, ret_addr: usize) bool {
+            const slot = slotOf(ctx);
+            const grow = new_len -| memory.len;
+            if (grow > 0 and !reserve(slot, grow)) return false;
+            if (!slot.owner.parent.rawResize(memory, alignment, new_len, ret_addr)) {
+                if (grow > 0) _ = slot.live_bytes.fetchSub(grow, .monotonic);
+                return false;
+            }
+            resized(slot, memory.len, new_len);
+            return true;
+        }
+
+        fn remap(ctx: *anyopaque, memory: []u8, alignment: Alignment, new_len: usize, ret_addr: usize) ?[*]u8 {
+            const slot = slotOf(ctx);
+            const grow = new_len -| memory.len;
+            if (grow > 0 and !reserve(slot, grow)) return null;
+            const ptr = slot.owner.parent.rawRemap(memory, alignment, new_len, ret_addr) orelse {
+                if (grow > 0) _ = slot.live_bytes.fetchSub(grow, .monotonic);
+                return null;
+            };
+            resized(slot, memory.len, new_len);
+            return ptr;
+        }
+
+        fn free(ctx: *anyopaque, memory: []u8, alignment: Alignment, ret_addr: usize) void {
+            const slot = slotOf(ctx);
+            slot.owner.parent.rawFree(memory, alignment, ret_addr);
+            _ = slot.live_bytes.fetchSub(memory.len, .monotonic);
+            _ = slot.live_allocs.fetchSub(1, .monotonic);
+            _ = slot.frees.fetchAdd(1, .monotonic);
+            _ = slot.live_sizes[bucketOf(memory.len)].fetchSub(1, .monotonic);
+        }
+    };
+}
+
+// ============================================================================
+// Tests
+// ============================================================================
+
+const testing = std.testing;
+
+test "bucketOf" {
+    try testing.expectEqual(@as(usize, 0), bucketOf(1));
+    try testing.expectEqual(@as(usize, 0), bucketOf(16));
+    try testing.expectEqual(@as(usize, 1), bucketOf(17));
+    try testing.expectEqual(@as(usize, 6), bucketOf(1024));
+    try testing.expectEqual(@as(usize, bucket_count - 1), bucketOf(1 << 20));
+    try testing.expectEqual(@as(?usize, 1024), bucketLimit(6));
+    try testing.expectEqual(@as(?usize, null), bucketLimit(bucket_count - 1));
+}
+
+test "per-tag live, peak and histograms" {
+    var heap = Accounting(Subsystem).init(testing.allocator, .{});
+    const http = heap.allocator(.http);
+    const tls = heap.allocator(.tls);
+
+    const a = try http.alloc(u8, 100);
+    const b = try http.alloc(u8, 4000);
+    const c = try tls.alloc(u8, 16 * 1024);
+    http.free(b);
+
+    const h = heap.snapshot(.http);
+    try testing.expectEqual(@as(u64, 100), h.live_bytes);
+    try testing.expectEqual(@as(u64, 4100), h.peak_bytes);
+    try testing.expectEqual(@as(u64, 2), h.allocs);
+    try testing.expectEqual(@as(u64, 1), h.live_allocs);
+    try testing.expectEqual(@as(u64, 1), h.sizes[bucketOf(4000)]);
+    try testing.expectEqual(@as(u64, 0), h.live_sizes[bucketOf(4000)]);
+    try testing.expectEqual(@as(u64, 16 * 1024), heap.snapshot(.tls).live_bytes);
+    try testing.expectEqual(@as(u64, 100 + 16 * 1024), heap.liveBytes());
+
+    http.free(a);
+    tls.free(c);
+    try testing.expectEqual(@as(u64, 0), heap.liveBytes());
+}
+
+test "budget fails fast and recovers after free" {
+    var heap = Accounting(Subsystem).init(testing.allocator, .{});
+    heap.setBudget(.mqtt0, 1024);
+    const mqtt = heap.allocator(.mqtt0);
+
+    const a = try mqtt.alloc(u8, 800);
+    try testing.expectError(error.OutOfMemory, mqtt.alloc(u8, 300));
+    try testing.expectEqual(@as(u64, 1), heap.snapshot(.mqtt0).denied);
+    try testing.expectEqual(@as(u64, 800), heap.snapshot(.mqtt0).live_bytes);
+
+    mqtt.free(a);
+    const b = try mqtt.alloc(u8, 1024);
+    mqtt.free(b);
+}
+
+test "resize and ArrayList growth are accounted" {
+    var heap = Accounting(Subsystem).init(testing.allocator, .{});
+    heap.setBudget(.ws, 4096);
+    const ws = heap.allocator(.ws);
+    var list: std.ArrayList(u8) = .empty;
+    defer list.deinit(ws);
+
+    try list.appendNTimes(ws, 'x', 1000);
+    try testing.expectEqual(@as(u64, list.capacity), heap.snapshot(.ws).live_bytes);
+    try testing.expectError(error.OutOfMemory, list.appendNTimes(ws, 'y', 8000));
+    try testing.expect(heap.snapshot(.ws).denied > 0);
+
+    list.shrinkAndFree(ws, 10);
+    try testing.expectEqual(@as(u64, list.capacity), heap.snapshot(.ws).live_bytes);
+}
+
+test "report lists active tags" {
+    var heap = Accounting(Subsystem).init(testing.allocator, .{});
+    heap.setBudget(.ble, 2048);
+    const buf = try heap.allocator(.dns).alloc(u8, 64);
+    defer heap.allocator(.dns).free(buf);
+
+    var out: [2048]u8 = undefined;
+    var w: std.Io.Writer = .fixed(&out);
+    try heap.report(&w);
+    const text = w.buffered();
+    try testing.expect(std.mem.indexOf(u8, text, "dns") != null);
+    try testing.expect(std.mem.indexOf(u8, text, "ble") != null);
+    try testing.expect(std.mem.indexOf(u8, text, "http") == null);
+}
+
+test "concurrent allocations keep counters consistent" {
+    var heap = Accounting(Subsystem).init(std.heap.page_allocator, .{});
+    const Worker = struct {
+        fn run(a: Allocator) void {
+            for (0..2000) |i| {
+                const buf = a.alloc(u8, 16 + i % 512) catch return;
+                a.free(buf);
+            }
+        }
+    };
+    var threads: [4]std.Thread = undefined;
+    for (&threads) |*t| t.* = try std.Thread.spawn(.{}, Worker.run, .{heap.allocator(.net)});
+    for (threads) |t| t.join();
+
+    const c = heap.snapshot(.net);
+    try testing.expectEqual(@as(u64, 8000), c.allocs);
+    try testing.expectEqual(@as(u64, 8000), c.frees);
+    try testing.expectEqual(@as(u64, 0), c.live_bytes);
+}
@@ -0,0 +1,292 @@
+//! Real-time thread policy for audio and other deadline-driven threads
+//!
+//! Best effort by design: every call reports what actually took effect
+//! instead of failing, so the same code runs with and without privileges.
+//!
+//! - `promote` moves the calling thread to SCHED_FIFO / SCHED_RR. When the
+//!   kernel refuses (no CAP_SYS_NICE, RLIMIT_RTPRIO of 0) it falls back to
+//!   SCHED_OTHER with a lower nice value, and that may be refused too.
+//!   SCHED_RESET_ON_FORK is set, so a forked child never inherits the
+//!   real-time policy. Threads spawned from a promoted thread do inherit
+//!   it: spawn helpers first, then promote.
+//! - `lockMemory` pins the process with mlockall(MCL_CURRENT | MCL_FUTURE),
+//!   so the audio path never takes a page fault on swapped-out memory.
+//!   It is only attempted when RLIMIT_MEMLOCK is unlimited or the process
+//!   runs as root: under a finite limit MCL_FUTURE would make later
+//!   allocations fail once the limit is reached. The lock is process-wide
+//!   and counted: `unlockMemory` (and `demote`, when `promote` took it)
+//!   drops one hold, and memory is unlocked when the last one goes.
+//! - `prefaultStack` touches `prefault_bytes` of stack below the caller so
+//!   the first deep callback does not fault in stack pages.
+//!
+//! Linux only; other hosts report `.unsupported` and stay on the default
+//! policy.
+//!
+//! ```zig
+//! fn audioThread(...) void {
+//!     const applied = std_impl.realtime.promote(.{ .policy = .fifo, .priority = 70 });
+//!     defer std_impl.realtime.demote(applied);
+//!     if (applied.policy == .other) log.warn("no RT scheduling: {s}", .{@tagName(applied.status)});
+//!     ...
+//! }
+//! ```
+
+const std = @import("std");
+const builtin = @import("builtin");
+const posix = std.posix;
+const linux = std.os.linux;
+
+const is_linux = builtin.os.tag == .linux;
+
+pub const Policy = enum {
+    /// Default time-sharing scheduler
+    other,
+    /// Run until blocking or preempted by a higher priority
+    fifo,
+    /// As `fifo`, with round-robin time slices among equal priorities
+    rr,
+};
+
+pub const Config = struct {
+    policy: Policy = .fifo,
+    /// Real-time priority, clamped to the policy's range (1..99 on Linux)
+    priority: u8 = 70,
+    /// Nice value to try when real-time scheduling is refused
+    /// (-20..19, 0 leaves it unchanged)
+    fallback_nice: i8 = -10,
+    /// Also call `lockMemory`
+    lock_memory: bool = true,
+    /// Also call `prefaultStack`; the thread's stack must be larger than
+    /// `prefault_bytes`
+    prefault_stack: bool = false,
+};
+
+pub const Status = enum {
+    /// The requested policy is in effect
+    applied,
+    /// Refused for lack of privileges; fell back to SCHED_OTHER
+    denied,
+    /// Not available on this host
+    unsupported,
+};
+
+/// What `promote` managed to apply
+pub const Applied = struct {
+    status: Status,
+    policy: Policy,
+    /// Real-time priority in effect (0 for `.other`)
+    priority: u8 = 0,
+    /// Nice value set by the fallback (0 if unchanged)
+    nice: i8 = 0,
+    memory_locked: bool = false,
+};
+
+pub const prefault_bytes = 32 * 1024;
+
+const SCHED_OTHER = 0;
+const SCHED_FIFO = 1;
+const SCHED_RR = 2;
+const SCHED_RESET_ON_FORK = 0x40000000;
+const MCL_CURRENT = 1;
+const MCL_FUTURE = 2;
+const PRIO_PROCESS = 0;
+
+const SchedParam = extern struct {
+    priority: c_int,
+};
+
+/// Apply `config` to the calling thread
+pub fn promote(config: Config) Applied {
+    var applied = Applied{ .status = .unsupported, .policy = .other };
+    if (comptime !is_linux) return applied;
+
+    if (config.lock_memory) applied.memory_locked = lockMemory();
+    if (config.prefault_stack) prefaultStack();
+
+    if (config.policy == .other) {
+        applied.status = .applied;
+        return applied;
+    }
+
+    const policy: usize = if (config.policy == .fifo) SCHED_FIFO else SCHED_RR;
+    const lo = priorityBound(.sched_get_priority_min, policy) orelse 1;
+    const hi = priorityBound(.sched_get_priority_max, policy) orelse 99;
+    const priority = std.math.clamp(@as(c_int, config.priority), lo, hi);
+
+    switch (setScheduler(policy, priority)) {
+        .SUCCESS => {
+            applied.status = .applied;
+            applied.policy = config.policy;
+            applied.priority = @intCast(priority);
+        },
+        .PERM => {
+            applied.status = .denied;
+            if (config.fallback_nice != 0) applied.nice = setNice(config.fallback_nice);
+        },
+        else => {},
+    }
+    return applied;
+}
+
+/// Return the calling thread to SCHED_OTHER, reset the nice value if the
+/// fallback changed it, and drop the memory lock if `applied` (from
+/// `promote`) holds one
+pub fn demote(applied: Applied) void {
+    if (comptime !is_linux) return;
+    _ = setScheduler(SCHED_OTHER, 0);
+    if (applied.nice != 0) _ = setNice(0);
+    if (applied.memory_locked) unlockMemory();
+}
+
+/// Scheduling policy of the calling thread
+pub fn current() Policy {
+    if (comptime !is_linux) return .other;
+    const rc = linux.syscall1(.sched_getscheduler, 0);
+    if (linux.E.init(rc) != .SUCCESS) return .other;
+    return switch (rc & ~@as(usize, SCHED_RESET_ON_FORK)) {
+        SCHED_FIFO => .fifo,
+        SCHED_RR => .rr,
+        else => .other,
+    };
+}
+
+/// Threads holding the mlockall lock; guarded by `lock_mutex`
+var lock_holders: u32 = 0;
+var lock_mutex: std.Thread.Mutex = .{};
+
+/// Lock current and future pages in RAM, or add a hold on the existing
+/// lock. Returns false when skipped or refused; see the module comment
+/// for when it is skipped.
+pub fn lockMemory() bool {
+    if (comptime !is_linux) return false;
+    lock_mutex.lock();
+    defer lock_mutex.unlock();
+    if (lock_holders == 0) {
+        const lim = posix.getrlimit(.MEMLOCK) catch return false;
+        if (lim.cur != linux.RLIM.INFINITY and linux.geteuid() != 0) return false;
+        const rc = linux.syscall1(.mlockall, MCL_CURRENT | MCL_FUTURE);
+        if (linux.E.init(rc) != .SUCCESS) return false;
+    }
+    lock_holders += 1;
+    return true;
+}
+
+/// Drop a hold taken by a successful `lockMemory`; the last one unlocks
+/// the whole process (munlockall)
+pub fn unlockMemory() void {
+    if (comptime !is_linux) return;
+    lock_mutex.lock();
+    defer lock_mutex.unlock();
+    std.debug.assert(lock_holders > 0);
+    lock_holders -= 1;
+    if (lock_holders == 0) _ = linux.syscall0(.munlockall);
+}
+
+/// Fault in `prefault_bytes` of the calling thread's stack
+pub noinline fn prefaultStack() void {
+    var buf: [prefault_bytes]u8 = undefined;
+    @memset(&buf, 0);
+    std.mem.doNotOptimizeAway(&buf);
+}
+
+fn setScheduler(policy: usize, priority: c_int) linux.E {
+    const param = SchedParam{ .priority = priority };
+    const rc = linux.syscall3(.sched_setscheduler, 0, policy | SCHED_RESET_ON_FORK, @intFromPtr(&param));
+    return linux.E.init(rc);
+}
+
+fn priorityBound(comptime nr: linux.SYS, policy: usize) ?c_int {
+    const rc = linux.syscall1(nr, policy);
+    if (linux.E.init(rc) != .SUCCESS) return null;
+    return @intCast(rc);
+}
+
+/// Set the calling thread's nice value; returns it, or 0 if refused
+fn setNice(nice: i8) i8 {
+    // who = 0 is the calling thread: Linux nice values are per thread
+    const rc = linux.syscall3(.setpriority, PRIO_PROCESS, 0, @bitCast(@as(isize, nice)));
+    return if (linux.E.init(rc) == .SUCCESS) nice else 0;
+}
+
+// ============================================================================
+// Tests
+// ============================================================================
+
+const testing = std.testing;
+
+/// Runs `promote` on its own thread so the test runner's thread keeps
+/// its policy
+const Probe = struct {
+    applied: Applied = undefined,
+    during: Policy = undefined,
+    after: Policy = undefined,
+
+    fn run(self: *Probe, config: Config) void {
+        self.applied = promote(config);
+        self.during = current();
+        demote(self.applied);
+        self.after = current();
+    }
+
+    fn spawn(config: Config) !Probe {
+        var probe = Probe{};
+        const t = try std.Thread.spawn(.{}, run, .{ &probe, config });
+        t.join();
+        return probe;
+    }
+};
+
+test "promote reports what took effect, privileged or not" {
+    const p = try Probe.spawn(.{ .policy = .fifo, .priority = 200, .lock_memory = false, .prefault_stack = true });
+    switch (p.applied.status) {
+        .applied => {
+            try testing.expectEqual(Policy.fifo, p.applied.policy);
+            try testing.expectEqual(Policy.fifo, p.during);
+            // Clamped to the policy's range
+            try testing.expect(p.applied.priority >= 1 and p.applied.priority <= 99);
+        },
+        .denied, .unsupported => {
+            try testing.expectEqual(Policy.other, p.applied.policy);
+            try testing.expectEqual(Policy.other, p.during);
+        },
+    }
+    try testing.expectEqual(Policy.other, p.after);
+}
+
+test "policy other is always applied" {
+    const p = try Probe.spawn(.{ .policy = .other, .lock_memory = false });
+    if (comptime is_linux) try testing.expectEqual(Status.applied, p.applied.status);
+    try testing.expectEqual(Policy.other, p.during);
+    // fallback_nice is only for a refused real-time policy
+    try testing.expectEqual(@as(i8, 0), p.applied.nice);
+}
+
+test "demote releases the memory lock promote took" {
+    if (comptime !is_linux) return error.SkipZigTest;
+    const p = try Probe.spawn(.{ .policy = .other, .fallback_nice = 0, .lock_memory = true });
+    if (!p.applied.memory_locked) return error.SkipZigTest;
+    try testing.expectEqual(@as(u64, 0), try lockedKb());
+}
+
+test "the memory lock stays until its last holder lets go" {
+    if (comptime !is_linux) return error.SkipZigTest;
+    if (!lockMemory()) return error.SkipZigTest;
+    try testing.expect(lockMemory());
+    unlockMemory();
+    try testing.expect(try lockedKb() > 0);
+    unlockMemory();
+    try testing.expectEqual(@as(u64, 0), try lockedKb());
+}
+
+/// VmLck from /proc/self/status
+fn lockedKb() !u64 {
+    var buf: [8192]u8 = undefined;
+    const status = try std.fs.cwd().readFile("/proc/self/status", &buf);
+    var lines = std.mem.splitScalar(u8, status, '\n');
+    while (lines.next()) |line| {
+        var fields = std.mem.tokenizeAny(u8, line, " \t");
+        if (!std.mem.eql(u8, fields.next() orelse continue, "VmLck:")) continue;
+        return std.fmt.parseInt(u64, fields.next() orelse return error.BadStatus, 10);
+    }
+    return error.BadStatus;
+}
@@ -1,13 +1,23 @@
 //! Selector — std platform implementation
 //!
-//! Multi-channel wait using kqueue (macOS/BSD) or epoll (Linux).
-//! Allows waiting on multiple channels simultaneously.
+//! Multi-source wait using kqueue (macOS/BSD) or epoll (Linux).
+//! One `wait()` covers:
+//!
+//! - channel recv readiness (`addRecv`) and send readiness (`addSend`)
+//! - socket read/write readiness (`addSocket`)
+//! - any number of independent one-shot timers (`addTimer`)
+//! - a single selector-wide timeout (`addTimeout`, trait compatibility)
+//!
+//! Registrations live in one kernel poll set created by `init()` and are
+//! reused across waits; `remove()` drops one source without rebuilding the
+//! set. `waitMany()` reports every ready source from a single syscall.
 
 const std = @import("std");
 const builtin = @import("builtin");
 const posix = std.posix;
 const linux = std.os.linux;
 const channel_impl = @import("channel.zig");
+const cancel = @import("cancel.zig");
 
 /// Convert EPOLL constants to u32.
 /// Handles comptime ints, runtime ints, and packed struct(u32) flags.
@@ -35,15 +45,31 @@ const is_kqueue = builtin.os.tag == .macos or
     builtin.os.tag == .openbsd;
 const is_epoll = builtin.os.tag == .linux;
 
-/// Source entry for tracking registered channels
-const SourceEntry = struct {
-    fd: posix.fd_t,
-    logical_index: usize,
+/// Readiness a socket source waits for
+pub const Interest = enum { read, write };
+
+/// Registered source, indexed by its logical index
+const SourceEntry = union(enum) {
+    free,
+    /// Kernel-polled fd. `owned` is true when the fd is a dup() made so the
+    /// same socket can be registered for read and write on epoll.
+    fd: struct {
+        fd: posix.fd_t,
+        interest: Interest,
+        owned: bool,
+        /// Added with `addRecv`; counted in `recv_count`
+        recv: bool = false,
+    },
+    /// One-shot timer; `deadline_ns` is null while disarmed
+    timer: struct {
+        deadline_ns: ?u64,
+    },
+    timeout,
 };
 
-/// Selector — wait on multiple channels with optional timeout.
+/// Selector — wait on channels, sockets and timers with optional timeout.
 ///
-/// `max_sources` is the maximum number of channels that can be registered.
+/// `max_sources` is the maximum number of sources that can be registered.
 /// `max_events` is ignored on std platform (kept for API compatibility with FreeRTOS).
 /// Timeout is handled separately in wait() call.
 pub fn Selector(comptime max_sources: usize, comptime max_events: usize) type {
@@ -58,6 +84,8 @@ pub fn Selector(comptime max_sources: usize, comptime max_events: usize) type {
         timeout_enabled: bool,
         timeout_ms: u32,
         timeout_index: usize,
+        /// Monotonic time origin for timer deadlines
+        clock: std.time.Instant,
 
         fn createPollFd() !posix.fd_t {
             if (is_kqueue) {
@@ -83,48 +111,166 @@ pub fn Selector(comptime max_sources: usize, comptime max_events: usize) type {
             const poll_fd = try createPollFd();
 
             return .{
-                .entries = undefined,
+                .entries = [_]SourceEntry{.free} ** max_sources,
                 .recv_count = 0,
                 .source_count = 0,
                 .poll_fd = poll_fd,
                 .timeout_enabled = false,
                 .timeout_ms = 0,
                 .timeout_index = max_sources,
+                .clock = std.time.Instant.now() catch return error.PollCreateFailed,
             };
         }
 
         /// Release selector resources
         pub fn deinit(self: *Self) void {
+            self.releaseOwnedFds();
             if (self.poll_fd >= 0) {
                 posix.close(self.poll_fd);
                 self.poll_fd = -1;
             }
         }
 
-        /// Add a channel to wait on.
+        // ====================================================================
+        // Registration
+        // ====================================================================
+
+        /// Add a channel to wait on for received data (or close).
         /// Returns the index of the added source.
         /// Returns error.TooMany if max_sources is reached.
         pub fn addRecv(self: *Self, channel: anytype) error{ TooMany, PollCtlFailed }!usize {
-            if (self.source_count >= max_sources) return error.TooMany;
+            const index = try self.addFd(channel.selectFd(), .read);
+            self.entries[index].fd.recv = true;
+            self.recv_count += 1;
+            return index;
+        }
+
+        /// Add a channel to wait on until it has room for a send (or is
+        /// closed). The channel must provide `sendSelectFd()`.
+        pub fn addSend(self: *Self, channel: anytype) error{ TooMany, PollCtlFailed }!usize {
+            return self.addFd(channel.sendSelectFd(), .read);
+        }
+
+        /// Add a socket (anything with `getFd()`) for read or write readiness.
+        /// The same socket may be added once per interest.
+        pub fn addSocket(self: *Self, socket: anytype, interest: Interest) error{ TooMany, PollCtlFailed }!usize {
+            return self.addFd(@intCast(socket.getFd()), interest);
+        }
+
+        /// Add a cancellation wake fd (`std_impl.cancel.Wake`, armed on a
+        /// scope). Its index becomes ready when the scope is cancelled.
+        pub fn addCancel(self: *Self, wake: anytype) error{ TooMany, PollCtlFailed }!usize {
+            return self.addFd(wake.getFd(), .read);
+        }
+
+        /// Add a one-shot timer firing `after_ms` from now. It is disarmed
+        /// when it fires; re-arm with `armTimer`.
+        pub fn addTimer(self: *Self, after_ms: u32) error{TooMany}!usize {
+            const index = self.freeSlot() orelse return error.TooMany;
+            self.entries[index] = .{ .timer = .{ .deadline_ns = self.nowNs() + msToNs(after_ms) } };
+            self.source_count += 1;
+            return index;
+        }
+
+        /// (Re-)arm timer `index` to fire `after_ms` from now
+        pub fn armTimer(self: *Self, index: usize, after_ms: u32) void {
+            switch (self.entries[index]) {
+                .timer => |*t| t.deadline_ns = self.nowNs() + msToNs(after_ms),
+                else => {},
+            }
+        }
+
+        /// Disarm timer `index` without removing it
+        pub fn disarmTimer(self: *Self, index: usize) void {
+            switch (self.entries[index]) {
+                .timer => |*t| t.deadline_ns = null,
+                else => {},
+            }
+        }
+
+        /// Add a timeout source.
+        /// This is a placeholder - the actual timeout is passed to wait().
+        /// Note: This is kept for trait compatibility but timeout_ms should be passed to wait().
+        pub fn addTimeout(self: *Self, timeout_ms: u32) error{TooMany}!usize {
+            if (self.timeout_enabled) {
+                self.timeout_ms = timeout_ms;
+                return self.timeout_index;
+            }
+            const index = self.freeSlot() orelse return error.TooMany;
+
+            self.entries[index] = .timeout;
+            self.timeout_enabled = true;
+            self.timeout_ms = timeout_ms;
+            self.timeout_index = index;
+            self.source_count += 1;
+            return self.timeout_index;
+        }
+
+        /// Remove one source. Its index may be reused by a later add;
+        /// other indices are unaffected.
+        pub fn remove(self: *Self, index: usize) void {
+            if (index >= max_sources) return;
+            switch (self.entries[index]) {
+                .free => return,
+                .fd => |e| {
+                    self.pollDel(e.fd, e.interest);
+                    if (e.owned) posix.close(e.fd);
+                    if (e.recv) self.recv_count -= 1;
+                },
+                .timer => {},
+                .timeout => {
+                    self.timeout_enabled = false;
+                    self.timeout_index = max_sources;
+                },
+            }
+            self.entries[index] = .free;
+            self.source_count -= 1;
+        }
+
+        fn freeSlot(self: *const Self) ?usize {
+            for (self.entries, 0..) |e, i| {
+                if (e == .free) return i;
+            }
+            return null;
+        }
+
+        fn addFd(self: *Self, fd: posix.fd_t, interest: Interest) error{ TooMany, PollCtlFailed }!usize {
             if (self.poll_fd < 0) return error.PollCtlFailed;
+            const index = self.freeSlot() orelse return error.TooMany;
+
+            // epoll keys registrations by fd: a second interest on the same
+            // fd goes through a dup so each keeps its own index.
+            var reg_fd = fd;
+            var owned = false;
+            if (is_epoll and self.hasFd(fd)) {
+                reg_fd = posix.dup(fd) catch return error.PollCtlFailed;
+                owned = true;
+            }
+            errdefer if (owned) posix.close(reg_fd);
 
-            const fd = channel.selectFd();
-            const logical_index = self.source_count;
-            const recv_index = self.recv_count;
+            try self.pollAdd(reg_fd, interest, index);
+            self.entries[index] = .{ .fd = .{ .fd = reg_fd, .interest = interest, .owned = owned } };
+            self.source_count += 1;
+            return index;
+        }
 
-            self.entries[recv_index] = .{
-                .fd = fd,
-                .logical_index = logical_index,
+        fn hasFd(self: *const Self, fd: posix.fd_t) bool {
+            for (self.entries) |e| switch (e) {
+                .fd => |f| if (f.fd == fd) return true,
+                else => {},
             };
+            return false;
+        }
 
+        fn pollAdd(self: *Self, fd: posix.fd_t, interest: Interest, index: usize) error{PollCtlFailed}!void {
             if (is_kqueue) {
                 var ev: posix.Kevent = .{
                     .ident = @intCast(fd),
-                    .filter = posix.system.EVFILT.READ,
+                    .filter = kqFilter(interest),
                     .flags = posix.system.EV.ADD,
                     .fflags = 0,
                     .data = 0,
-                    .udata = logical_index,
+                    .udata = index,
                 };
                 const rc = posix.system.kevent(
                     self.poll_fd,
@@ -137,8 +283,8 @@ pub fn Selector(comptime max_sources: usize, comptime max_events: usize) type {
                 if (rc < 0) return error.PollCtlFailed;
             } else if (is_epoll) {
                 var ev: posix.system.epoll_event = .{
-                    .events = @intCast(linux.EPOLL.IN),
-                    .data = .{ .u64 = logical_index },
+                    .events = if (interest == .read) @intCast(linux.EPOLL.IN) else @intCast(linux.EPOLL.OUT),
+                    .data = .{ .u64 = index },
                 };
                 const rc = posix.system.epoll_ctl(
                     self.poll_fd,
@@ -148,36 +294,73 @@ pub fn Selector(comptime max_sources: usize, comptime max_events: usize) type {
                 );
                 if (rc < 0) return error.PollCtlFailed;
             }
-
-            self.recv_count += 1;
-            self.source_count += 1;
-            return logical_index;
         }
 
-        /// Add a timeout source.
-        /// This is a placeholder - the actual timeout is passed to wait().
-        /// Note: This is kept for trait compatibility but timeout_ms should be passed to wait().
-        pub fn addTimeout(self: *Self, timeout_ms: u32) error{TooMany}!usize {
-            if (self.timeout_enabled) {
-                self.timeout_ms = timeout_ms;
-                return self.timeout_index;
+        fn pollDel(self: *Self, fd: posix.fd_t, interest: Interest) void {
+            if (self.poll_fd < 0) return;
+            if (is_kqueue) {
+                var ev: posix.Kevent = .{
+                    .ident = @intCast(fd),
+                    .filter = kqFilter(interest),
+                    .flags = posix.system.EV.DELETE,
+                    .fflags = 0,
+                    .data = 0,
+                    .udata = 0,
+                };
+                _ = posix.system.kevent(self.poll_fd, @ptrCast(&ev), 1, @ptrCast(&ev), 0, null);
+            } else if (is_epoll) {
+                var ev: posix.system.epoll_event = undefined;
+                _ = posix.system.epoll_ctl(self.poll_fd, @intCast(linux.EPOLL.CTL_DEL), fd, &ev);
             }
-            if (self.source_count >= max_sources) return error.TooMany;
+        }
 
-            self.timeout_enabled = true;
-            self.timeout_ms = timeout_ms;
-            self.timeout_index = self.source_count;
-            self.source_count += 1;
-            return self.timeout_index;
+        fn kqFilter(interest: Interest) i16 {
+            return if (interest == .read) posix.system.EVFILT.READ else posix.system.EVFILT.WRITE;
         }
 
-        /// Wait for any channel to be ready or timeout.
+        // ====================================================================
+        // Waiting
+        // ====================================================================
+
+        /// Wait for any source to be ready or timeout.
         /// Returns the index of the ready source.
         /// Returns error.Empty if no sources were added.
         /// Returns max_sources if timeout occurred.
         pub fn wait(self: *Self, timeout_ms: ?u32) error{ Empty, PollWaitFailed, Interrupted }!usize {
+            var ready: [1]usize = undefined;
+            const n = try self.waitMany(timeout_ms, &ready);
+            if (n == 0) return max_sources;
+            return ready[0];
+        }
+
+        /// Wait like `wait()`, additionally bounded by `scope`'s deadline.
+        /// `cancel_index` is the `addCancel` index of the scope's wake fd;
+        /// it is returned when the scope is cancelled or the deadline
+        /// passes first (the scope is then cancelled with `.deadline`).
+        pub fn waitScoped(self: *Self, scope: anytype, cancel_index: usize, timeout_ms: ?u32) error{ Empty, PollWaitFailed, Interrupted }!usize {
+            const caller_ms = if (timeout_ms != null)
+                timeout_ms
+            else if (self.timeout_enabled)
+                self.timeout_ms
+            else
+                null;
+            const remaining = scope.remainingNs() orelse return self.wait(timeout_ms);
+            const deadline_ms = cancel.msCeil(remaining);
+            if (caller_ms != null and caller_ms.? < deadline_ms) return self.wait(timeout_ms);
+
+            const ready = try self.wait(deadline_ms);
+            const timed_out = ready == max_sources or (self.timeout_enabled and ready == self.timeout_index);
+            if (timed_out and scope.checkDeadline()) return cancel_index;
+            return ready;
+        }
+
+        /// Wait like `wait()`, but report every ready source (fds first, then
+        /// expired timers) up to `out.len`. Returns the count; 0 means the
+        /// wait timed out with no `addTimeout` source registered.
+        pub fn waitMany(self: *Self, timeout_ms: ?u32, out: []usize) error{ Empty, PollWaitFailed, Interrupted }!usize {
             if (self.source_count == 0) return error.Empty;
             if (self.poll_fd < 0) return error.PollWaitFailed;
+            if (out.len == 0) return 0;
 
             const effective_timeout_ms = if (timeout_ms != null)
                 timeout_ms
@@ -186,22 +369,50 @@ pub fn Selector(comptime max_sources: usize, comptime max_events: usize) type {
             else
                 null;
 
-            if (is_kqueue) {
-                return self.waitKqueue(effective_timeout_ms);
-            } else if (is_epoll) {
-                return self.waitEpoll(effective_timeout_ms);
-            } else {
-                @compileError("Unsupported platform for Selector");
+            // The caller's timeout is a deadline on the monotonic clock, so
+            // early wakes and timer-bound waits never stretch or cut it
+            const deadline: ?u64 = if (effective_timeout_ms) |ms| self.nowNs() + msToNs(ms) else null;
+
+            while (true) {
+                const now = self.nowNs();
+                var poll_ms: ?u32 = if (deadline) |d| cancel.msCeil(d -| now) else null;
+
+                // Shorten the kernel wait to the earliest armed timer
+                var timer_bound = false;
+                if (self.nextDeadlineNs()) |timer| {
+                    const until = cancel.msCeil(timer -| now);
+                    if (poll_ms == null or until < poll_ms.?) {
+                        poll_ms = until;
+                        timer_bound = true;
+                    }
+                }
+
+                var count = if (is_kqueue)
+                    try self.waitKqueue(poll_ms, out)
+                else if (is_epoll)
+                    try self.waitEpoll(poll_ms, out)
+                else
+                    @compileError("Unsupported platform for Selector");
+
+                count += self.collectTimers(out[count..]);
+                if (count > 0) return count;
+
+                // Nothing ready: woke for a timer that had not quite expired,
+                // or early; wait out whatever is left of the caller's timeout
+                if (deadline) |d| {
+                    if (self.nowNs() < d) continue;
+                } else if (timer_bound) continue;
+
+                if (self.timeout_enabled) {
+                    out[0] = self.timeout_index;
+                    return 1;
+                }
+                return 0;
             }
         }
 
-        fn timeoutResult(self: *const Self) usize {
-            if (self.timeout_enabled) return self.timeout_index;
-            return max_sources;
-        }
-
-        fn waitKqueue(self: *Self, timeout_ms: ?u32) error{ PollWaitFailed, Interrupted }!usize {
-            var event: posix.Kevent = undefined;
+        fn waitKqueue(self: *Self, timeout_ms: ?u32, out: []usize) error{ PollWaitFailed, Interrupted }!usize {
+            var events: [max_sources]posix.Kevent = undefined;
             var empty_change: [0]posix.Kevent = .{};
             var ts: posix.timespec = undefined;
             const timeout_ptr: ?*const posix.timespec = if (timeout_ms) |ms| blk: {
@@ -216,8 +427,8 @@ pub fn Selector(comptime max_sources: usize, comptime max_events: usize) type {
                 self.poll_fd,
                 @ptrCast(&empty_change),
                 0,
-                @ptrCast(&event),
-                1,
+                @ptrCast(&events),
+                @intCast(@min(out.len, max_sources)),
                 timeout_ptr,
             );
 
@@ -228,16 +439,13 @@ pub fn Selector(comptime max_sources: usize, comptime max_events: usize) type {
                 };
             }
 
-            if (n == 0) {
-                return self.timeoutResult();
-            }
-
             // Return the index stored in udata
-            return @intCast(event.udata);
+            for (events[0..@intCast(n)], 0..) |ev, i| out[i] = @intCast(ev.udata);
+            return @intCast(n);
         }
 
-        fn waitEpoll(self: *Self, timeout_ms: ?u32) error{ PollWaitFailed, Interrupted }!usize {
-            var events: [1]posix.system.epoll_event = undefined;
+        fn waitEpoll(self: *Self, timeout_ms: ?u32, out: []usize) error{ PollWaitFailed, Interrupted }!usize {
+            var events: [max_sources]posix.system.epoll_event = undefined;
 
             const timeout_int: i32 = if (timeout_ms) |ms|
                 @intCast(ms)
@@ -247,7 +455,7 @@ pub fn Selector(comptime max_sources: usize, comptime max_events: usize) type {
             const n = posix.system.epoll_wait(
                 self.poll_fd,
                 &events,
-                1,
+                @intCast(@min(out.len, max_sources)),
                 timeout_int,
             );
 
@@ -258,15 +466,59 @@ pub fn Selector(comptime max_sources: usize, comptime max_events: usize) type {
                 };
             }
 
-            if (n == 0) {
-                // Timeout
-                return self.timeoutResult();
+            // Return the index stored in data.u64
+            for (events[0..@intCast(n)], 0..) |ev, i| out[i] = @intCast(ev.data.u64);
+            return @intCast(n);
+        }
+
+        /// Move expired timers into `out`, disarming them
+        fn collectTimers(self: *Self, out: []usize) usize {
+            var count: usize = 0;
+            const now = self.nowNs();
+            for (&self.entries, 0..) |*e, i| {
+                if (count == out.len) break;
+                switch (e.*) {
+                    .timer => |*t| if (t.deadline_ns) |d| {
+                        if (d <= now) {
+                            t.deadline_ns = null;
+                            out[count] = i;
+                            count += 1;
+                        }
+                    },
+                    else => {},
+                }
             }
+            return count;
+        }
+
+        fn nextDeadlineNs(self: *const Self) ?u64 {
+            var next: ?u64 = null;
+            for (self.entries) |e| switch (e) {
+                .timer => |t| if (t.deadline_ns) |d| {
+                    if (next == null or d < next.?) next = d;
+                },
+                else => {},
+            };
+            return next;
+        }
 
-            const event = events[0];
+        fn nowNs(self: *const Self) u64 {
+            const now = std.time.Instant.now() catch return 0;
+            return now.since(self.clock);
+        }
 
-            // Return the index stored in data.u64
-            return @intCast(event.data.u64);
+        fn msToNs(ms: u32) u64 {
+            return @as(u64, ms) * std.time.ns_per_ms;
+        }
+
+        fn releaseOwnedFds(self: *Self) void {
+            for (&self.entries) |*e| switch (e.*) {
+                .fd => |f| if (f.owned) {
+                    posix.close(f.fd);
+                    e.* = .free;
+                },
+                else => {},
+            };
         }
 
         /// Reset the selector, clearing all registered sources.
@@ -275,11 +527,13 @@ pub fn Selector(comptime max_sources: usize, comptime max_events: usize) type {
             // This avoids transitioning into a broken `poll_fd = -1` state.
             const new_poll_fd = createPollFd() catch return;
 
+            self.releaseOwnedFds();
             if (self.poll_fd >= 0) {
                 posix.close(self.poll_fd);
             }
             self.poll_fd = new_poll_fd;
 
+            self.entries = [_]SourceEntry{.free} ** max_sources;
             self.recv_count = 0;
             self.source_count = 0;
             self.timeout_enabled = false;
@@ -320,3 +574,131 @@ test "Selector reports explicit errors when poll fd is invalid" {
     try std.testing.expectError(error.PollWaitFailed, sel.wait(0));
     try std.testing.expectError(error.PollCtlFailed, sel.addRecv(&ch2));
 }
+
+test "Selector remove keeps recv_count in step" {
+    const Ch = channel_impl.Channel(u32, 2);
+    const Sel = Selector(4, 4);
+
+    var ch = try Ch.init();
+    defer ch.deinit();
+    var sel = try Sel.init();
+    defer sel.deinit();
+
+    const recv_idx = try sel.addRecv(&ch);
+    const send_idx = try sel.addSend(&ch);
+    try std.testing.expectEqual(@as(usize, 1), sel.recv_count);
+
+    sel.remove(send_idx);
+    try std.testing.expectEqual(@as(usize, 1), sel.recv_count);
+    sel.remove(recv_idx);
+    try std.testing.expectEqual(@as(usize, 0), sel.recv_count);
+    try std.testing.expectEqual(@as(usize, 0), sel.source_count);
+}
+
+test "Selector send readiness follows channel capacity" {
+    const Ch = channel_impl.Channel(u32, 2);
+    const Sel = Selector(2, 2);
+
+    var ch = try Ch.init();
+    defer ch.deinit();
+    var sel = try Sel.init();
+    defer sel.deinit();
+
+    const send_idx = try sel.addSend(&ch);
+    try std.testing.expectEqual(send_idx, try sel.wait(0));
+
+    try ch.send(1);
+    try ch.send(2);
+    try std.testing.expectEqual(@as(usize, 2), try sel.wait(0)); // full
+
+    _ = ch.recv();
+    try std.testing.expectEqual(send_idx, try sel.wait(0));
+
+    try ch.send(3);
+    ch.close();
+    try std.testing.expectEqual(send_idx, try sel.wait(0)); // closed wakes senders
+}
+
+test "Selector timers fire independently in deadline order" {
+    const Ch = channel_impl.Channel(u32, 2);
+    const Sel = Selector(4, 4);
+
+    var ch = try Ch.init();
+    defer ch.deinit();
+    var sel = try Sel.init();
+    defer sel.deinit();
+
+    _ = try sel.addRecv(&ch);
+    const slow = try sel.addTimer(40);
+    const fast = try sel.addTimer(10);
+
+    try std.testing.expectEqual(fast, try sel.wait(null));
+    try std.testing.expectEqual(slow, try sel.wait(null));
+
+    // Both disarmed: only the caller's timeout remains
+    try std.testing.expectEqual(@as(usize, 4), try sel.wait(5));
+
+    sel.armTimer(fast, 0);
+    try std.testing.expectEqual(fast, try sel.wait(1000));
+}
+
+test "Selector timeout holds to the clock across timer-bound waits" {
+    const Ch = channel_impl.Channel(u32, 2);
+    const Sel = Selector(4, 4);
+
+    var ch = try Ch.init();
+    defer ch.deinit();
+    var sel = try Sel.init();
+    defer sel.deinit();
+
+    _ = try sel.addRecv(&ch);
+    const timer = try sel.addTimer(10);
+
+    // The timer fires first, well inside the caller's timeout
+    var start = try std.time.Instant.now();
+    try std.testing.expectEqual(timer, try sel.wait(200));
+    var took = (try std.time.Instant.now()).since(start);
+    try std.testing.expect(took >= 10 * std.time.ns_per_ms);
+    try std.testing.expect(took < 150 * std.time.ns_per_ms);
+
+    // A timer due after the caller's timeout: the timeout wins, on time
+    sel.armTimer(timer, 100);
+    start = try std.time.Instant.now();
+    try std.testing.expectEqual(@as(usize, 4), try sel.wait(30));
+    took = (try std.time.Instant.now()).since(start);
+    try std.testing.expect(took >= 30 * std.time.ns_per_ms);
+    try std.testing.expect(took < 90 * std.time.ns_per_ms);
+}
+
+test "Selector socket readiness and waitMany" {
+    const socket_impl = @import("socket.zig");
+    const Sel = Selector(4, 4);
+
+    var server = try socket_impl.Socket.tcp();
+    defer server.close();
+    try server.bind(.{ 127, 0, 0, 1 }, 0);
+    try server.listen();
+    var client = try socket_impl.Socket.tcp();
+    defer client.close();
+    try client.connect(.{ 127, 0, 0, 1 }, try server.getBoundPort());
+    var conn = try server.accept();
+    defer conn.close();
+
+    var sel = try Sel.init();
+    defer sel.deinit();
+
+    const readable = try sel.addSocket(&conn, .read);
+    const writable = try sel.addSocket(&conn, .write); // same fd, both interests
+
+    var ready: [4]usize = undefined;
+    try std.testing.expectEqual(@as(usize, 1), try sel.waitMany(0, &ready));
+    try std.testing.expectEqual(writable, ready[0]);
+
+    _ = try client.send("x");
+    const n = try sel.waitMany(1000, &ready);
+    try std.testing.expectEqual(@as(usize, 2), n);
+    try std.testing.expect(std.mem.indexOfScalar(usize, ready[0..n], readable) != null);
+
+    sel.remove(writable);
+    try std.testing.expectEqual(readable, try sel.wait(0));
+}
@@ -4,18 +4,65 @@
 //! Compatible with DNS resolver and TLS client.
 
 const std = @import("std");
+const builtin = @import("builtin");
 const posix = std.posix;
+const linux = std.os.linux;
 const trait = @import("trait");
+const cancel = @import("cancel.zig");
 
 /// IPv4 address (matches trait.socket.Ipv4Address)
 pub const Ipv4Address = trait.socket.Ipv4Address;
 
+/// IPv6 address (matches trait.socket.Ipv6Address)
+pub const Ipv6Address = trait.socket.Ipv6Address;
+
+/// Either family (matches trait.socket.IpAddress)
+pub const IpAddress = trait.socket.IpAddress;
+
 /// Socket error (matches trait.socket.Error)
 pub const Error = trait.socket.Error;
 
+/// Batch datagram types (match trait.socket)
+pub const Datagram = trait.socket.Datagram;
+pub const RecvSlot = trait.socket.RecvSlot;
+
+/// sendmmsg/recvmmsg; other systems loop over sendto/recvfrom
+const has_mmsg = builtin.os.tag == .linux;
+
+/// UDP segmentation offload (UDP_SEGMENT, Linux 4.18) and receive
+/// coalescing (UDP_GRO, Linux 5.0), from linux/udp.h
+const has_udp_offload = builtin.os.tag == .linux;
+const SOL_UDP = 17;
+const UDP_SEGMENT = 103;
+const UDP_GRO = 104;
+/// Segments the kernel accepts in one GSO send
+const gso_max_segments = 64;
+/// Largest IPv4 UDP payload
+const max_udp_payload = 65507;
+
+/// Result of `Socket.recvSegments`
+pub const SegmentedRecv = struct {
+    len: usize,
+    /// Size of each datagram in the buffer; the last may be shorter
+    segment_len: usize,
+    src_addr: Ipv4Address,
+    src_port: u16,
+
+    /// Datagrams received
+    pub fn count(self: SegmentedRecv) usize {
+        if (self.segment_len == 0) return 1;
+        return (self.len + self.segment_len - 1) / self.segment_len;
+    }
+};
+
 /// Socket implementation matching trait.socket interface
 pub const Socket = struct {
     fd: posix.socket_t,
+    /// Set once the kernel has refused UDP_SEGMENT
+    gso_off: bool = false,
+    /// Syscalls made by `sendBatch` and `sendSegments`, so benchmarks can
+    /// measure batching instead of assuming it
+    send_syscalls: usize = 0,
 
     const Self = @This();
 
@@ -39,6 +86,22 @@ pub const Socket = struct {
         return .{ .fd = fd };
     }
 
+    /// Create an IPv6 TCP socket
+    pub fn tcp6() Error!Self {
+        const fd = posix.socket(posix.AF.INET6, posix.SOCK.STREAM, 0) catch {
+            return error.CreateFailed;
+        };
+        return .{ .fd = fd };
+    }
+
+    /// Create an IPv6 UDP socket
+    pub fn udp6() Error!Self {
+        const fd = posix.socket(posix.AF.INET6, posix.SOCK.DGRAM, 0) catch {
+            return error.CreateFailed;
+        };
+        return .{ .fd = fd };
+    }
+
     // ========================================================================
     // Instance methods (required by trait.socket)
     // ========================================================================
@@ -60,6 +123,76 @@ pub const Socket = struct {
         };
     }
 
+    /// Connect to an IPv6 address and port
+    pub fn connect6(self: *Self, ip: Ipv6Address, port: u16) Error!void {
+        const addr = sockaddrIn6(ip, port);
+        posix.connect(self.fd, @ptrCast(&addr), @sizeOf(@TypeOf(addr))) catch {
+            return error.ConnectFailed;
+        };
+    }
+
+    /// Begin a non-blocking connect. Returns true if it completed at once;
+    /// otherwise finish it with `connectPoll`.
+    pub fn connectStart(self: *Self, ip: IpAddress, port: u16) Error!bool {
+        try self.setNonBlocking(true);
+        const result = switch (ip) {
+            .ipv4 => |v4| blk: {
+                const addr = posix.sockaddr.in{
+                    .family = posix.AF.INET,
+                    .port = std.mem.nativeToBig(u16, port),
+                    .addr = @bitCast(v4),
+                };
+                break :blk posix.connect(self.fd, @ptrCast(&addr), @sizeOf(@TypeOf(addr)));
+            },
+            .ipv6 => |v6| blk: {
+                const addr = sockaddrIn6(v6, port);
+                break :blk posix.connect(self.fd, @ptrCast(&addr), @sizeOf(@TypeOf(addr)));
+            },
+        };
+        result catch |err| {
+            if (err == error.WouldBlock) return false;
+            return error.ConnectFailed;
+        };
+        try self.setNonBlocking(false);
+        return true;
+    }
+
+    /// Wait up to `timeout_ms` for a connect started by `connectStart`.
+    /// Returns true once connected (socket is blocking again), false if
+    /// still in progress.
+    pub fn connectPoll(self: *Self, timeout_ms: u32) Error!bool {
+        var fds = [_]posix.pollfd{.{ .fd = self.fd, .events = posix.POLL.OUT, .revents = 0 }};
+        const ready = posix.poll(&fds, @intCast(@min(timeout_ms, std.math.maxInt(i32)))) catch {
+            return error.ConnectFailed;
+        };
+        if (ready == 0) return false;
+        posix.getsockoptError(self.fd) catch return error.ConnectFailed;
+        try self.setNonBlocking(false);
+        return true;
+    }
+
+    /// Most sockets `connectPollAny` waits on at once
+    pub const max_poll_any = 16;
+
+    /// Wait up to `timeout_ms` for any connect in `socks` (each started by
+    /// `connectStart`) to finish or fail, in one poll. Returns its index,
+    /// or null on timeout; `connectPoll(0)` on it gives the outcome.
+    pub fn connectPollAny(socks: []const *Self, timeout_ms: u32) Error!?usize {
+        std.debug.assert(socks.len <= max_poll_any);
+        var fds: [max_poll_any]posix.pollfd = undefined;
+        for (socks, fds[0..socks.len]) |sock, *pfd| {
+            pfd.* = .{ .fd = sock.fd, .events = posix.POLL.OUT, .revents = 0 };
+        }
+        const ready = posix.poll(fds[0..socks.len], @intCast(@min(timeout_ms, std.math.maxInt(i32)))) catch {
+            return error.ConnectFailed;
+        };
+        if (ready == 0) return null;
+        for (fds[0..socks.len], 0..) |pfd, i| {
+            if (pfd.revents != 0) return i;
+        }
+        return null;
+    }
+
     /// Send data on connected socket
     pub fn send(self: *Self, data: []const u8) Error!usize {
         return posix.send(self.fd, data, 0) catch {
@@ -80,6 +213,326 @@ pub const Socket = struct {
         return n;
     }
 
+    /// Most buffers taken per `sendv`/`recvv`; the rest is a partial write
+    pub const max_iov = 16;
+
+    /// Most datagrams per sendmmsg/recvmmsg call
+    pub const max_batch = 32;
+
+    /// Send several buffers as one write (sendmsg)
+    pub fn sendv(self: *Self, bufs: []const []const u8) Error!usize {
+        var iov: [max_iov]posix.iovec_const = undefined;
+        const n = @min(bufs.len, max_iov);
+        for (bufs[0..n], iov[0..n]) |buf, *v| v.* = .{ .base = buf.ptr, .len = buf.len };
+        const msg = posix.msghdr_const{
+            .name = null,
+            .namelen = 0,
+            .iov = &iov,
+            .iovlen = @intCast(n),
+            .control = null,
+            .controllen = 0,
+            .flags = 0,
+        };
+        return posix.sendmsg(self.fd, &msg, 0) catch {
+            return error.SendFailed;
+        };
+    }
+
+    /// Receive into several buffers in order (readv)
+    pub fn recvv(self: *Self, bufs: []const []u8) Error!usize {
+        var iov: [max_iov]posix.iovec = undefined;
+        const n = @min(bufs.len, max_iov);
+        for (bufs[0..n], iov[0..n]) |buf, *v| v.* = .{ .base = buf.ptr, .len = buf.len };
+        const len = posix.readv(self.fd, iov[0..n]) catch |err| {
+            return switch (err) {
+                error.WouldBlock => error.Timeout,
+                error.ConnectionResetByPeer => error.Closed,
+                else => error.RecvFailed,
+            };
+        };
+        if (len == 0) return error.Closed;
+        return len;
+    }
+
+    /// Send datagrams, up to `max_batch` per syscall. Returns how many
+    /// went out; an error only if none did.
+    pub fn sendBatch(self: *Self, msgs: []const Datagram) Error!usize {
+        if (comptime !has_mmsg) {
+            for (msgs, 0..) |m, i| {
+                self.send_syscalls += 1;
+                _ = self.sendTo(m.addr, m.port, m.data) catch |err| return if (i > 0) i else err;
+            }
+            return msgs.len;
+        }
+
+        var sent: usize = 0;
+        while (sent < msgs.len) {
+            const batch = msgs[sent..][0..@min(msgs.len - sent, max_batch)];
+            var addrs: [max_batch]posix.sockaddr.in = undefined;
+            var iov: [max_batch]posix.iovec_const = undefined;
+            var hdrs: [max_batch]linux.mmsghdr_const = undefined;
+            for (batch, 0..) |m, i| {
+                addrs[i] = sockaddrIn(m.addr, m.port);
+                iov[i] = .{ .base = m.data.ptr, .len = m.data.len };
+                hdrs[i] = .{
+                    .hdr = .{
+                        .name = @ptrCast(&addrs[i]),
+                        .namelen = @sizeOf(posix.sockaddr.in),
+                        .iov = iov[i..].ptr,
+                        .iovlen = 1,
+                        .control = null,
+                        .controllen = 0,
+                        .flags = 0,
+                    },
+                    .len = 0,
+                };
+            }
+            self.send_syscalls += 1;
+            const rc = linux.syscall4(.sendmmsg, fdArg(self.fd), @intFromPtr(&hdrs), batch.len, 0);
+            switch (linux.E.init(rc)) {
+                .SUCCESS => {},
+                .INTR => continue,
+                else => return if (sent > 0) sent else error.SendFailed,
+            }
+            sent += rc;
+            if (rc < batch.len) break;
+        }
+        return sent;
+    }
+
+    /// Wait for a datagram, then take whatever else is queued, one per
+    /// slot (recvmmsg with MSG_WAITFORONE). Returns the slots filled.
+    pub fn recvBatch(self: *Self, slots: []RecvSlot) Error!usize {
+        if (slots.len == 0) return 0;
+        if (comptime !has_mmsg) {
+            const r = try self.recvFromWithAddr(slots[0].buf);
+            slots[0].len = r.len;
+            slots[0].src_addr = r.src_addr;
+            slots[0].src_port = r.src_port;
+            return 1;
+        }
+
+        const n = @min(slots.len, max_batch);
+        var addrs: [max_batch]posix.sockaddr.in = undefined;
+        var iov: [max_batch]posix.iovec = undefined;
+        var hdrs: [max_batch]linux.mmsghdr = undefined;
+        for (slots[0..n], 0..) |*slot, i| {
+            iov[i] = .{ .base = slot.buf.ptr, .len = slot.buf.len };
+            hdrs[i] = .{
+                .hdr = .{
+                    .name = @ptrCast(&addrs[i]),
+                    .namelen = @sizeOf(posix.sockaddr.in),
+                    .iov = iov[i..].ptr,
+                    .iovlen = 1,
+                    .control = null,
+                    .controllen = 0,
+                    .flags = 0,
+                },
+                .len = 0,
+            };
+        }
+        while (true) {
+            const rc = linux.syscall5(.recvmmsg, fdArg(self.fd), @intFromPtr(&hdrs), n, linux.MSG.WAITFORONE, 0);
+            switch (linux.E.init(rc)) {
+                .SUCCESS => {
+                    for (slots[0..rc], hdrs[0..rc], addrs[0..rc]) |*slot, h, a| {
+                        slot.len = h.len;
+                        slot.src_addr = @bitCast(a.addr);
+                        slot.src_port = std.mem.bigToNative(u16, a.port);
+                    }
+                    return rc;
+                },
+                .INTR => continue,
+                .AGAIN => return error.Timeout,
+                else => return error.RecvFailed,
+            }
+        }
+    }
+
+    /// Send `data` to one destination as datagrams of `segment_len` bytes
+    /// (the last may be shorter). On Linux this is one UDP GSO send per 64
+    /// datagrams, segmented below the stack; elsewhere, or once the kernel
+    /// refuses GSO, it falls back to `sendBatch`. Returns the bytes sent.
+    pub fn sendSegments(self: *Self, ip: Ipv4Address, port: u16, data: []const u8, segment_len: usize) Error!usize {
+        if (segment_len == 0 or segment_len > max_udp_payload) return error.SendFailed;
+        const per_send = @min(gso_max_segments, max_udp_payload / segment_len) * segment_len;
+        var off: usize = 0;
+        while (off < data.len) {
+            const chunk = data[off..][0..@min(data.len - off, per_send)];
+            const n = self.sendSegmentChunk(ip, port, chunk, segment_len) catch |err| {
+                return if (off > 0) off else err;
+            };
+            off += n;
+            if (n < chunk.len) break;
+        }
+        return off;
+    }
+
+    /// Let the kernel coalesce datagrams of one flow for `recvSegments`
+    /// (UDP GRO). Returns false where unsupported; `recvSegments` then
+    /// returns one datagram per call.
+    pub fn enableGro(self: *Self) bool {
+        if (comptime !has_udp_offload) return false;
+        const on: i32 = 1;
+        posix.setsockopt(self.fd, SOL_UDP, UDP_GRO, std.mem.asBytes(&on)) catch return false;
+        return true;
+    }
+
+    /// Receive one datagram, or with `enableGro` a run of same-sized
+    /// datagrams from one sender, back to back in `buf`. Size `buf` for
+    /// 64 KiB to take full GRO batches.
+    pub fn recvSegments(self: *Self, buf: []u8) Error!SegmentedRecv {
+        if (comptime !has_udp_offload) {
+            const r = try self.recvFromWithAddr(buf);
+            return .{ .len = r.len, .segment_len = r.len, .src_addr = r.src_addr, .src_port = r.src_port };
+        }
+
+        var addr: posix.sockaddr.in = undefined;
+        var iov = [1]posix.iovec{.{ .base = buf.ptr, .len = buf.len }};
+        var control: [64]u8 align(@alignOf(Cmsghdr)) = undefined;
+        var msg = posix.msghdr{
+            .name = @ptrCast(&addr),
+            .namelen = @sizeOf(posix.sockaddr.in),
+            .iov = &iov,
+            .iovlen = 1,
+            .control = &control,
+            .controllen = control.len,
+            .flags = 0,
+        };
+        while (true) {
+            const rc = linux.recvmsg(self.fd, &msg, 0);
+            switch (linux.E.init(rc)) {
+                .SUCCESS => {},
+                .INTR => continue,
+                .AGAIN => return error.Timeout,
+                else => return error.RecvFailed,
+            }
+            return .{
+                .len = rc,
+                .segment_len = groSegment(control[0..@min(msg.controllen, control.len)]) orelse rc,
+                .src_addr = @bitCast(addr.addr),
+                .src_port = std.mem.bigToNative(u16, addr.port),
+            };
+        }
+    }
+
+    fn sendSegmentChunk(self: *Self, ip: Ipv4Address, port: u16, chunk: []const u8, segment_len: usize) Error!usize {
+        if (comptime has_udp_offload) {
+            if (!self.gso_off and chunk.len > segment_len) {
+                if (self.sendGso(ip, port, chunk, segment_len)) |n| {
+                    return n;
+                } else |err| switch (err) {
+                    error.Unsupported => self.gso_off = true,
+                    error.SendFailed => return error.SendFailed,
+                }
+            }
+        }
+
+        var msgs: [gso_max_segments]Datagram = undefined;
+        var count: usize = 0;
+        var off: usize = 0;
+        while (off < chunk.len) : (count += 1) {
+            const len = @min(segment_len, chunk.len - off);
+            msgs[count] = .{ .addr = ip, .port = port, .data = chunk[off..][0..len] };
+            off += len;
+        }
+        const sent = try self.sendBatch(msgs[0..count]);
+        return if (sent == count) chunk.len else sent * segment_len;
+    }
+
+    fn sendGso(self: *Self, ip: Ipv4Address, port: u16, chunk: []const u8, segment_len: usize) error{ Unsupported, SendFailed }!usize {
+        const addr = sockaddrIn(ip, port);
+        const iov = [1]posix.iovec_const{.{ .base = chunk.ptr, .len = chunk.len }};
+        const cmsg = GsoCmsg{
+            .hdr = .{ .len = @sizeOf(Cmsghdr) + @sizeOf(u16), .level = SOL_UDP, .type = UDP_SEGMENT },
+            .segment = @intCast(segment_len),
+        };
+        const msg = posix.msghdr_const{
+            .name = @ptrCast(&addr),
+            .namelen = @sizeOf(posix.sockaddr.in),
+            .iov = &iov,
+            .iovlen = 1,
+            .control = &cmsg,
+            .controllen = @sizeOf(GsoCmsg),
+            .flags = 0,
+        };
+        while (true) {
+            self.send_syscalls += 1;
+            const rc = linux.sendmsg(self.fd, &msg, 0);
+            return switch (linux.E.init(rc)) {
+                .SUCCESS => rc,
+                .INTR => continue,
+                // Old kernel, or a route without checksum offload
+                .NOPROTOOPT, .OPNOTSUPP, .INVAL, .IO => error.Unsupported,
+                else => error.SendFailed,
+            };
+        }
+    }
+
+    /// `recv` that returns `error.Cancelled` when `scope` (an
+    /// `async/cancellation` Scope) is cancelled or its deadline passes.
+    /// On a stream socket, cancellation shuts the socket down for reading
+    /// to end the blocked call, so it is meant for abandoning the
+    /// connection, not for interrupting one read and resuming. Datagram
+    /// sockets wait on the socket and a cancellation fd together instead
+    /// (one more fd per call) and stay usable. A deadline that runs out
+    /// while this call waits leaves either kind usable.
+    pub fn recvCancellable(self: *Self, buf: []u8, scope: anytype) (Error || error{Cancelled})!usize {
+        if (self.isDatagram()) return self.recvDatagramCancellable(buf, scope);
+
+        var waker = @TypeOf(scope.*).Waker.init(self, abortRecv);
+        if (!scope.register(&waker)) return error.Cancelled;
+        defer scope.unregister(&waker);
+
+        if (scope.remainingNs()) |remaining| {
+            var fds = [_]posix.pollfd{.{ .fd = self.fd, .events = posix.POLL.IN, .revents = 0 }};
+            const ready = posix.poll(&fds, @intCast(cancel.msCeil(remaining))) catch return error.RecvFailed;
+            if (ready == 0) {
+                // Cancel without our waker: no need to shut the socket down
+                scope.unregister(&waker);
+                _ = scope.checkDeadline();
+                return error.Cancelled;
+            }
+        }
+        return self.recv(buf) catch |err| {
+            return if (scope.isCancelled()) error.Cancelled else err;
+        };
+    }
+
+    /// Shutdown does not end a blocked datagram recv on every host: poll
+    /// the socket next to a cancellation fd instead.
+    fn recvDatagramCancellable(self: *Self, buf: []u8, scope: anytype) (Error || error{Cancelled})!usize {
+        var wake = cancel.Wake(@TypeOf(scope.*)).init() catch return error.RecvFailed;
+        defer wake.deinit();
+        wake.arm(scope);
+
+        var fds = [_]posix.pollfd{
+            .{ .fd = self.fd, .events = posix.POLL.IN, .revents = 0 },
+            .{ .fd = wake.getFd(), .events = posix.POLL.IN, .revents = 0 },
+        };
+        while (true) {
+            const timeout: i32 = if (scope.remainingNs()) |r| @intCast(cancel.msCeil(r)) else -1;
+            const ready = posix.poll(&fds, timeout) catch return error.RecvFailed;
+            if (fds[1].revents != 0) return error.Cancelled;
+            if (ready == 0) {
+                if (scope.checkDeadline()) return error.Cancelled;
+                continue;
+            }
+            return self.recv(buf);
+        }
+    }
+
+    fn isDatagram(self: *const Self) bool {
+        var kind: i32 = 0;
+        posix.getsockopt(self.fd, posix.SOL.SOCKET, posix.SO.TYPE, std.mem.asBytes(&kind)) catch return false;
+        return kind == posix.SOCK.DGRAM;
+    }
+
+    fn abortRecv(ctx: *anyopaque) void {
+        const self: *Self = @ptrCast(@alignCast(ctx));
+        posix.shutdown(self.fd, .recv) catch {};
+    }
+
     /// Set receive timeout in milliseconds
     pub fn setRecvTimeout(self: *Self, timeout_ms: u32) void {
         const tv = posix.timeval{
@@ -116,6 +569,14 @@ pub const Socket = struct {
         };
     }
 
+    /// Send data to a specific IPv6 address (UDP)
+    pub fn sendTo6(self: *Self, ip: Ipv6Address, port: u16, data: []const u8) Error!usize {
+        const addr = sockaddrIn6(ip, port);
+        return posix.sendto(self.fd, data, 0, @ptrCast(&addr), @sizeOf(@TypeOf(addr))) catch {
+            return error.SendFailed;
+        };
+    }
+
     /// Receive data from socket (UDP - ignores sender address)
     pub fn recvFrom(self: *Self, buf: []u8) Error!usize {
         var src_addr: posix.sockaddr.storage = undefined;
@@ -157,10 +618,19 @@ pub const Socket = struct {
         };
     }
 
+    /// Bind an IPv6 socket to a local address and port
+    pub fn bind6(self: *Self, ip: Ipv6Address, port: u16) Error!void {
+        const addr = sockaddrIn6(ip, port);
+        posix.bind(self.fd, @ptrCast(&addr), @sizeOf(@TypeOf(addr))) catch {
+            return error.BindFailed;
+        };
+    }
+
     /// Get the port that the socket is bound to (useful after bind(port=0))
     pub fn getBoundPort(self: *Self) Error!u16 {
-        var addr: posix.sockaddr.in = undefined;
-        var addr_len: posix.socklen_t = @sizeOf(posix.sockaddr.in);
+        // Port sits at the same offset in sockaddr.in and sockaddr.in6
+        var addr: posix.sockaddr.in6 = undefined;
+        var addr_len: posix.socklen_t = @sizeOf(posix.sockaddr.in6);
         posix.getsockname(self.fd, @ptrCast(&addr), &addr_len) catch {
             return error.InvalidAddress;
         };
@@ -176,8 +646,8 @@ pub const Socket = struct {
 
     /// Accept an incoming connection (TCP server)
     pub fn accept(self: *Self) Error!Self {
-        var client_addr: posix.sockaddr.in = undefined;
-        var addr_len: posix.socklen_t = @sizeOf(posix.sockaddr.in);
+        var client_addr: posix.sockaddr.storage = undefined;
+        var addr_len: posix.socklen_t = @sizeOf(posix.sockaddr.storage);
         const client_fd = posix.accept(self.fd, @ptrCast(&client_addr), &addr_len, 0) catch {
             return error.AcceptFailed;
         };
@@ -206,6 +676,56 @@ pub const Socket = struct {
     }
 };
 
+/// struct cmsghdr
+const Cmsghdr = extern struct {
+    len: usize,
+    level: i32,
+    type: i32,
+};
+
+/// UDP_SEGMENT control message; padded to CMSG_SPACE(2) by alignment
+const GsoCmsg = extern struct {
+    hdr: Cmsghdr,
+    segment: u16,
+};
+
+/// gso_size from a UDP_GRO control message, if the kernel coalesced
+fn groSegment(control: []const u8) ?usize {
+    var off: usize = 0;
+    while (off + @sizeOf(Cmsghdr) <= control.len) {
+        const hdr = std.mem.bytesToValue(Cmsghdr, control[off..][0..@sizeOf(Cmsghdr)]);
+        if (hdr.len < @sizeOf(Cmsghdr) or off + hdr.len > control.len) return null;
+        if (hdr.level == SOL_UDP and hdr.type == UDP_GRO and hdr.len >= @sizeOf(Cmsghdr) + 4) {
+            const size = std.mem.readInt(i32, control[off + @sizeOf(Cmsghdr) ..][0..4], builtin.cpu.arch.endian());
+            return if (size > 0) @intCast(size) else null;
+        }
+        off += std.mem.alignForward(usize, hdr.len, @alignOf(Cmsghdr));
+    }
+    return null;
+}
+
+fn sockaddrIn(ip: Ipv4Address, port: u16) posix.sockaddr.in {
+    return .{
+        .family = posix.AF.INET,
+        .port = std.mem.nativeToBig(u16, port),
+        .addr = @bitCast(ip),
+    };
+}
+
+fn fdArg(fd: posix.socket_t) usize {
+    return @bitCast(@as(isize, fd));
+}
+
+fn sockaddrIn6(ip: Ipv6Address, port: u16) posix.sockaddr.in6 {
+    return .{
+        .family = posix.AF.INET6,
+        .port = std.mem.nativeToBig(u16, port),
+        .flowinfo = 0,
+        .addr = ip,
+        .scope_id = 0,
+    };
+}
+
 // ============================================================================
 // Tests
 // ============================================================================
@@ -213,6 +733,11 @@ pub const Socket = struct {
 test "Socket matches trait.socket interface" {
     // This will fail at compile time if Socket doesn't match the trait
     _ = trait.socket.from(Socket);
+    try std.testing.expect(trait.socket.hasIpv6(Socket));
+    try std.testing.expect(trait.socket.hasConnectPoll(Socket));
+    try std.testing.expect(trait.socket.hasConnectPollAny(Socket));
+    try std.testing.expect(trait.socket.hasVectored(Socket));
+    try std.testing.expect(trait.socket.hasBatch(Socket));
 }
 
 test "create TCP socket" {
@@ -234,3 +759,163 @@ test "set socket options" {
     sock.setSendTimeout(5000);
     sock.setTcpNoDelay(true);
 }
+
+test "non-blocking connect on IPv4 loopback" {
+    var server = try Socket.tcp();
+    defer server.close();
+    try server.bind(.{ 127, 0, 0, 1 }, 0);
+    try server.listen();
+    const port = try server.getBoundPort();
+
+    var client = try Socket.tcp();
+    defer client.close();
+    var done = try client.connectStart(.{ .ipv4 = .{ 127, 0, 0, 1 } }, port);
+    while (!done) done = try client.connectPoll(1000);
+
+    var conn = try server.accept();
+    defer conn.close();
+    _ = try client.send("hi");
+    var buf: [2]u8 = undefined;
+    try std.testing.expectEqual(@as(usize, 2), try conn.recv(&buf));
+}
+
+test "connectPollAny reports the attempt that finished" {
+    var server = try Socket.tcp();
+    defer server.close();
+    try server.bind(.{ 127, 0, 0, 1 }, 0);
+    try server.listen();
+    const port = try server.getBoundPort();
+
+    // Nothing listens on port 1: refused, the other connects
+    var refused = try Socket.tcp();
+    defer refused.close();
+    var client = try Socket.tcp();
+    defer client.close();
+    var done = [_]bool{
+        refused.connectStart(.{ .ipv4 = .{ 127, 0, 0, 1 } }, 1) catch true,
+        try client.connectStart(.{ .ipv4 = .{ 127, 0, 0, 1 } }, port),
+    };
+    const socks = [_]*Socket{ &refused, &client };
+    var connected = done[1];
+    while (!done[0] or !done[1]) {
+        var waiting: [2]*Socket = undefined;
+        var index: [2]usize = undefined;
+        var n: usize = 0;
+        for (socks, 0..) |s, i| {
+            if (done[i]) continue;
+            waiting[n] = s;
+            index[n] = i;
+            n += 1;
+        }
+        const k = (try Socket.connectPollAny(waiting[0..n], 1000)) orelse return error.Timeout;
+        const i = index[k];
+        done[i] = true;
+        const ok = socks[i].connectPoll(0) catch false;
+        if (i == 1) connected = ok else try std.testing.expect(!ok);
+    }
+    try std.testing.expect(connected);
+}
+
+test "IPv6 loopback connect" {
+    var server = Socket.tcp6() catch return error.SkipZigTest;
+    defer server.close();
+    const loopback = trait.socket.parseIpv6("::1").?;
+    server.bind6(loopback, 0) catch return error.SkipZigTest;
+    try server.listen();
+    const port = try server.getBoundPort();
+
+    var client = try Socket.tcp6();
+    defer client.close();
+    try client.connect6(loopback, port);
+    var conn = try server.accept();
+    defer conn.close();
+}
+
+test "sendv and recvv over TCP loopback" {
+    var server = try Socket.tcp();
+    defer server.close();
+    try server.bind(.{ 127, 0, 0, 1 }, 0);
+    try server.listen();
+    const port = try server.getBoundPort();
+
+    var client = try Socket.tcp();
+    defer client.close();
+    try client.connect(.{ 127, 0, 0, 1 }, port);
+    var conn = try server.accept();
+    defer conn.close();
+
+    try trait.socket.sendvAll(&client, &.{ "\x82\x05", "", "hello" });
+    var head: [2]u8 = undefined;
+    var body: [5]u8 = undefined;
+    var got: usize = 0;
+    while (got < 7) {
+        got += if (got < 2)
+            try conn.recvv(&.{ head[got..], &body })
+        else
+            try conn.recv(body[got - 2 ..]);
+    }
+    try std.testing.expectEqualSlices(u8, "\x82\x05", &head);
+    try std.testing.expectEqualStrings("hello", &body);
+}
+
+test "sendBatch and recvBatch over UDP loopback" {
+    var rx = try Socket.udp();
+    defer rx.close();
+    try rx.bind(.{ 127, 0, 0, 1 }, 0);
+    const port = try rx.getBoundPort();
+    rx.setRecvTimeout(1000);
+
+    var tx = try Socket.udp();
+    defer tx.close();
+    var msgs: [40]Datagram = undefined;
+    var payloads: [40][1]u8 = undefined;
+    for (&msgs, &payloads, 0..) |*m, *p, i| {
+        p[0] = @intCast(i);
+        m.* = .{ .addr = .{ 127, 0, 0, 1 }, .port = port, .data = p };
+    }
+    try std.testing.expectEqual(@as(usize, msgs.len), try tx.sendBatch(&msgs));
+
+    var bufs: [8][16]u8 = undefined;
+    var slots: [8]RecvSlot = undefined;
+    for (&slots, &bufs) |*slot, *b| slot.* = .{ .buf = b };
+    var next: u8 = 0;
+    while (next < msgs.len) {
+        const n = try rx.recvBatch(&slots);
+        try std.testing.expect(n >= 1);
+        for (slots[0..n]) |slot| {
+            try std.testing.expectEqual(@as(usize, 1), slot.len);
+            try std.testing.expectEqual(next, slot.buf[0]);
+            try std.testing.expectEqual([4]u8{ 127, 0, 0, 1 }, slot.src_addr);
+            next += 1;
+        }
+    }
+}
+
+test "sendSegments and recvSegments over UDP loopback" {
+    var rx = try Socket.udp();
+    defer rx.close();
+    try rx.bind(.{ 127, 0, 0, 1 }, 0);
+    const port = try rx.getBoundPort();
+    rx.setRecvTimeout(1000);
+    _ = rx.enableGro();
+
+    var tx = try Socket.udp();
+    defer tx.close();
+    var data: [10 * 100 + 40]u8 = undefined;
+    for (&data, 0..) |*b, i| b.* = @truncate(i / 100);
+    try std.testing.expectEqual(data.len, try tx.sendSegments(.{ 127, 0, 0, 1 }, port, &data, 100));
+
+    // With GRO the datagrams may arrive coalesced; either way they come
+    // back whole and in order
+    var buf: [64 * 1024]u8 = undefined;
+    var got: usize = 0;
+    var datagrams: usize = 0;
+    while (got < data.len) {
+        const r = try rx.recvSegments(buf[got..]);
+        try std.testing.expect(r.segment_len == 100 or r.len == 40);
+        got += r.len;
+        datagrams += r.count();
+    }
+    try std.testing.expectEqual(@as(usize, 11), datagrams);
+    try std.testing.expectEqualSlices(u8, &data, buf[0..data.len]);
+}
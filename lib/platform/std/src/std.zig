@@ -11,6 +11,21 @@
 //!   var sock = try std_impl.socket.tcp();
 //!   defer sock.close();
 //!
+//!   // Filesystem (mmap-backed trait.fs driver)
+//!   var fs = try std_impl.fs.Fs.initPath("assets");
+//!   defer fs.deinit();
+//!
+//!   // Per-subsystem heap accounting and budgets
+//!   var heap = std_impl.heap.Accounting(std_impl.heap.Subsystem).init(std.heap.c_allocator, .{});
+//!   const http_alloc = heap.allocator(.http);
+//!
+//!   // Cancellation scopes waking blocked waits (async/cancellation)
+//!   var root = cancellation.Scope.init(.{ .clock = std_impl.cancel.nowNs });
+//!   const item = try ch.recvCancellable(&root);
+//!
+//!   // Real-time audio thread: SCHED_FIFO where allowed, mlockall
+//!   const applied = std_impl.realtime.promote(.{ .policy = .fifo, .priority = 70 });
+//!
 //!   // Sync
 //!   var mutex = std_impl.sync.Mutex.init();
 //!   mutex.lock();
@@ -23,6 +38,10 @@ pub const socket = @import("impl/socket.zig");
 pub const runtime = @import("impl/runtime.zig");
 pub const channel = @import("impl/channel.zig");
 pub const selector = @import("impl/selector.zig");
+pub const fs = @import("impl/fs.zig");
+pub const heap = @import("impl/heap.zig");
+pub const cancel = @import("impl/cancel.zig");
+pub const realtime = @import("impl/realtime.zig");
 const builtin = @import("builtin");
 const is_kqueue = builtin.os.tag == .macos or
     builtin.os.tag == .freebsd or
@@ -45,6 +64,7 @@ else
     void;
 pub const codec = struct {
     pub const opus = @import("impl/codec/opus.zig");
+    pub const lc3 = @import("impl/codec/lc3.zig");
 };
 
 // Convenience type re-exports
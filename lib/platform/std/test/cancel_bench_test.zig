@@ -0,0 +1,363 @@
+//! Cancellable waits on the std platform.
+//!
+//!   Tests: channel recv/send, selector, socket recv and WaitGroup wait
+//!          return error.Cancelled when their scope is cancelled or its
+//!          deadline passes, with the right reason
+//!   BM1:   cancel-to-exit latency for 128 tasks blocked in a mix of
+//!          channel, selector, socket and WaitGroup waits: scoped waits
+//!          woken by `Scope.cancel` vs waits that poll a
+//!          CancellationToken between 10ms timeouts
+
+const std = @import("std");
+const std_impl = @import("std_impl");
+const cancellation = @import("cancellation");
+const waitgroup = @import("waitgroup");
+const print = std.debug.print;
+const testing = std.testing;
+
+const Scope = cancellation.Scope;
+const Reason = cancellation.Reason;
+const Ch = std_impl.channel.Channel(u32, 4);
+const Sel = std_impl.selector.Selector(4, 4);
+const Wake = std_impl.cancel.Wake(Scope);
+const WG = waitgroup.WaitGroup(std_impl.runtime);
+const Socket = std_impl.socket.Socket;
+const nowNs = std_impl.cancel.nowNs;
+const ns_per_ms = std.time.ns_per_ms;
+
+fn rootScope(timeout_ms: ?u64) Scope {
+    return Scope.init(.{
+        .clock = nowNs,
+        .timeout_ns = if (timeout_ms) |ms| ms * ns_per_ms else null,
+    });
+}
+
+/// Cancel `scope` from another thread after `ms`
+fn cancelAfter(scope: *Scope, ms: u64, why: Reason) !std.Thread {
+    return std.Thread.spawn(.{}, struct {
+        fn run(s: *Scope, delay: u64, r: Reason) void {
+            std.Thread.sleep(delay * ns_per_ms);
+            s.cancel(r);
+        }
+    }.run, .{ scope, ms, why });
+}
+
+/// Connected loopback TCP pair
+const TcpPair = struct {
+    client: Socket,
+    conn: Socket,
+
+    fn init(server: *Socket) !TcpPair {
+        var client = try Socket.tcp();
+        errdefer client.close();
+        try client.connect(.{ 127, 0, 0, 1 }, try server.getBoundPort());
+        return .{ .client = client, .conn = try server.accept() };
+    }
+
+    fn deinit(self: *TcpPair) void {
+        self.client.close();
+        self.conn.close();
+    }
+};
+
+fn listen() !Socket {
+    var server = try Socket.tcp();
+    errdefer server.close();
+    try server.bind(.{ 127, 0, 0, 1 }, 0);
+    try server.listen();
+    return server;
+}
+
+// ============================================================================
+// Tests
+// ============================================================================
+
+test "channel recv and send wake on cancel" {
+    var ch = try Ch.init();
+    defer ch.deinit();
+
+    // Queued items are delivered before the wait would block
+    var root = rootScope(null);
+    try ch.send(7);
+    try testing.expectEqual(@as(?u32, 7), try ch.recvCancellable(&root));
+
+    const t = try cancelAfter(&root, 5, .shutdown);
+    try testing.expectError(error.Cancelled, ch.recvCancellable(&root));
+    t.join();
+    try testing.expectEqual(Reason.shutdown, root.reason());
+    try testing.expectError(error.Cancelled, ch.recvCancellable(&root));
+
+    var other = rootScope(null);
+    for (0..4) |i| try ch.send(@intCast(i));
+    const t2 = try cancelAfter(&other, 5, .cancelled);
+    try testing.expectError(error.Cancelled, ch.sendCancellable(9, &other));
+    t2.join();
+    try testing.expectEqual(@as(usize, 4), ch.count());
+}
+
+test "channel deadline cancels the child only" {
+    var ch = try Ch.init();
+    defer ch.deinit();
+    var root = rootScope(null);
+    var child: Scope = undefined;
+    child.initChild(&root, .{ .timeout_ns = 20 * ns_per_ms });
+    defer child.deinit();
+
+    const start = nowNs();
+    try testing.expectError(error.Cancelled, ch.recvCancellable(&child));
+    try testing.expect(nowNs() - start >= 20 * ns_per_ms);
+    try testing.expectEqual(Reason.deadline, child.reason());
+    try testing.expect(!root.isCancelled());
+}
+
+test "selector reports the cancel index" {
+    var ch = try Ch.init();
+    defer ch.deinit();
+    var root = rootScope(null);
+    var timed = rootScope(10);
+    var sel = try Sel.init();
+    defer sel.deinit();
+    var wake = try Wake.init();
+    defer wake.deinit();
+
+    wake.arm(&root);
+    _ = try sel.addRecv(&ch);
+    const cancel_index = try sel.addCancel(&wake);
+
+    // No deadline: the caller's timeout applies as usual
+    try testing.expectEqual(@as(usize, 4), try sel.waitScoped(&root, cancel_index, 5));
+
+    const t = try cancelAfter(&root, 5, .shutdown);
+    try testing.expectEqual(cancel_index, try sel.waitScoped(&root, cancel_index, null));
+    t.join();
+
+    // Re-arming on another scope clears the readiness
+    wake.arm(&timed);
+    try testing.expectEqual(cancel_index, try sel.waitScoped(&timed, cancel_index, 1000));
+    try testing.expectEqual(Reason.deadline, timed.reason());
+}
+
+test "socket recv: deadline keeps the socket, cancel aborts it" {
+    var server = try listen();
+    defer server.close();
+    var pair = try TcpPair.init(&server);
+    defer pair.deinit();
+    var buf: [8]u8 = undefined;
+
+    var timed = rootScope(10);
+    try testing.expectError(error.Cancelled, pair.conn.recvCancellable(&buf, &timed));
+    try testing.expectEqual(Reason.deadline, timed.reason());
+
+    var root = rootScope(null);
+    _ = try pair.client.send("ok");
+    try testing.expectEqual(@as(usize, 2), try pair.conn.recvCancellable(&buf, &root));
+
+    const t = try cancelAfter(&root, 5, .shutdown);
+    try testing.expectError(error.Cancelled, pair.conn.recvCancellable(&buf, &root));
+    t.join();
+}
+
+test "socket recv: cancel wakes a blocked UDP recv and keeps the socket" {
+    var sock = try Socket.udp();
+    defer sock.close();
+    try sock.bind(.{ 127, 0, 0, 1 }, 0);
+    const port = try sock.getBoundPort();
+    var buf: [8]u8 = undefined;
+
+    var timed = rootScope(10);
+    try testing.expectError(error.Cancelled, sock.recvCancellable(&buf, &timed));
+    try testing.expectEqual(Reason.deadline, timed.reason());
+
+    var root = rootScope(null);
+    const t = try cancelAfter(&root, 5, .shutdown);
+    try testing.expectError(error.Cancelled, sock.recvCancellable(&buf, &root));
+    t.join();
+
+    // Still receives afterwards
+    _ = try sock.sendTo(.{ 127, 0, 0, 1 }, port, "ok");
+    var fresh = rootScope(1000);
+    try testing.expectEqual(@as(usize, 2), try sock.recvCancellable(&buf, &fresh));
+}
+
+test "WaitGroup wait gives up on deadline" {
+    var wg = WG.init();
+    defer wg.deinit();
+    var release = std.Thread.ResetEvent{};
+    try wg.go(std.Thread.ResetEvent.wait, .{&release});
+
+    var timed = rootScope(10);
+    try testing.expectError(error.Cancelled, wg.waitCancellable(&timed));
+    try testing.expectEqual(Reason.deadline, timed.reason());
+
+    release.set();
+    var root = rootScope(null);
+    try wg.waitCancellable(&root);
+}
+
+// ============================================================================
+// BM1: cancel-to-exit latency
+// ============================================================================
+
+const PER_KIND = 32;
+const POLL_MS = 10;
+
+const Kind = enum { channel, selector, socket, waitgroup };
+const Mode = enum { scoped, polled };
+
+const Shared = struct {
+    mode: Mode,
+    root: Scope,
+    token: cancellation.CancellationToken,
+    ready: std.atomic.Value(u32) = .init(0),
+    /// Held open by one task that runs until the benchmark ends
+    wg: WG,
+
+    fn parked(self: *Shared) void {
+        _ = self.ready.fetchAdd(1, .release);
+    }
+
+    fn polling(self: *Shared) bool {
+        return !self.token.isCancelled();
+    }
+};
+
+fn task(shared: *Shared, kind: Kind, conn: *Socket, exit_ns: *u64) void {
+    block(shared, kind, conn) catch |err| print("[bench] {s} task failed: {s}\n", .{ @tagName(kind), @errorName(err) });
+    exit_ns.* = nowNs();
+}
+
+fn block(shared: *Shared, kind: Kind, conn: *Socket) !void {
+    const root = &shared.root;
+    switch (kind) {
+        .channel => {
+            var ch = try Ch.init();
+            defer ch.deinit();
+            if (shared.mode == .scoped) {
+                shared.parked();
+                _ = ch.recvCancellable(root) catch null;
+            } else {
+                // No timed recv on a channel: poll it through a selector
+                var sel = try Sel.init();
+                defer sel.deinit();
+                _ = try sel.addRecv(&ch);
+                shared.parked();
+                while (shared.polling()) _ = try sel.wait(POLL_MS);
+            }
+        },
+        .selector => {
+            var ch = try Ch.init();
+            defer ch.deinit();
+            var sel = try Sel.init();
+            defer sel.deinit();
+            _ = try sel.addRecv(&ch);
+            if (shared.mode == .scoped) {
+                var wake = try Wake.init();
+                defer wake.deinit();
+                wake.arm(root);
+                const cancel_index = try sel.addCancel(&wake);
+                shared.parked();
+                _ = try sel.waitScoped(root, cancel_index, null);
+            } else {
+                shared.parked();
+                while (shared.polling()) _ = try sel.wait(POLL_MS);
+            }
+        },
+        .socket => {
+            var buf: [64]u8 = undefined;
+            if (shared.mode == .scoped) {
+                shared.parked();
+                _ = conn.recvCancellable(&buf, root) catch 0;
+            } else {
+                conn.setRecvTimeout(POLL_MS);
+                shared.parked();
+                while (shared.polling()) {
+                    _ = conn.recv(&buf) catch |err| switch (err) {
+                        error.Timeout => continue,
+                        else => break,
+                    };
+                }
+            }
+        },
+        .waitgroup => {
+            shared.parked();
+            if (shared.mode == .scoped) {
+                shared.wg.waitCancellable(root) catch {};
+            } else {
+                // WaitGroup.wait has no timeout: polling means sleeping
+                while (shared.polling()) std.Thread.sleep(POLL_MS * ns_per_ms);
+            }
+        },
+    }
+}
+
+const N = PER_KIND * std.enums.values(Kind).len;
+
+/// Cancel-to-exit latency in µs per task, grouped by kind
+fn measure(mode: Mode) ![N]u64 {
+    var server = try listen();
+    defer server.close();
+    var pairs: [PER_KIND]TcpPair = undefined;
+    for (&pairs) |*p| p.* = try TcpPair.init(&server);
+    defer for (&pairs) |*p| p.deinit();
+
+    var shared = Shared{
+        .mode = mode,
+        .root = rootScope(null),
+        .token = cancellation.CancellationToken.init(),
+        .wg = WG.init(),
+    };
+    defer shared.wg.deinit();
+    var release = std.Thread.ResetEvent{};
+    try shared.wg.go(std.Thread.ResetEvent.wait, .{&release});
+    defer shared.wg.wait();
+    defer release.set();
+
+    var threads: [N]std.Thread = undefined;
+    var exit_ns: [N]u64 = undefined;
+    for (&threads, 0..) |*t, i| {
+        const kind: Kind = @enumFromInt(i / PER_KIND);
+        t.* = try std.Thread.spawn(.{}, task, .{ &shared, kind, &pairs[i % PER_KIND].conn, &exit_ns[i] });
+    }
+    while (shared.ready.load(.acquire) < N) std.Thread.sleep(ns_per_ms);
+    // Let every task get from "parked" into its blocking call
+    std.Thread.sleep(50 * ns_per_ms);
+
+    const start = nowNs();
+    switch (mode) {
+        .scoped => shared.root.cancel(.shutdown),
+        .polled => shared.token.cancel(),
+    }
+    for (threads) |t| t.join();
+
+    var latency_us: [N]u64 = undefined;
+    for (&latency_us, exit_ns) |*l, e| l.* = (e -| start) / std.time.ns_per_us;
+    return latency_us;
+}
+
+fn percentile(sorted: []const u64, p: usize) u64 {
+    return sorted[@min(sorted.len - 1, sorted.len * p / 100)];
+}
+
+test "BM1: cancel-to-exit latency across blocked tasks" {
+    print("\n[bench] {d} blocked tasks ({d} per kind), cancel-to-exit latency (us)\n", .{ N, PER_KIND });
+    print("[bench]   {s:<8} {s:<10} {s:>8} {s:>8} {s:>8}\n", .{ "mode", "kind", "p50", "p99", "max" });
+
+    var p50: [2]u64 = undefined;
+    for ([_]Mode{ .scoped, .polled }, 0..) |mode, m| {
+        var all = try measure(mode);
+        for (std.enums.values(Kind), 0..) |kind, k| {
+            const group = all[k * PER_KIND ..][0..PER_KIND];
+            std.mem.sort(u64, group, {}, std.sort.asc(u64));
+            print("[bench]   {s:<8} {s:<10} {d:>8} {d:>8} {d:>8}\n", .{
+                @tagName(mode), @tagName(kind), percentile(group, 50), percentile(group, 99), group[PER_KIND - 1],
+            });
+        }
+        std.mem.sort(u64, &all, {}, std.sort.asc(u64));
+        print("[bench]   {s:<8} {s:<10} {d:>8} {d:>8} {d:>8}\n", .{
+            @tagName(mode), "all", percentile(&all, 50), percentile(&all, 99), all[N - 1],
+        });
+        p50[m] = percentile(&all, 50);
+    }
+
+    try testing.expect(p50[0] < p50[1]);
+}
@@ -0,0 +1,137 @@
+//! trait.fs random-access benchmark over a large asset bundle.
+//!
+//! Builds a 64 MiB bundle of 4 KiB assets and looks up random entries:
+//!
+//!   - legacy: re-open and stream from the start up to the entry (what a
+//!     sequential-only File forces)
+//!   - pread: fd-backed positional read, one syscall per lookup
+//!   - mmap: zero-copy slice of `File.data`, with and without a `.random`
+//!     read-ahead hint
+//!
+//! Each mode checksums the bytes it touches so all modes can be compared.
+
+const std = @import("std");
+const std_impl = @import("std_impl");
+const trait = @import("trait");
+const print = std.debug.print;
+const testing = std.testing;
+
+const ENTRY_SIZE = 4096;
+const ENTRY_COUNT = 16 * 1024; // 64 MiB
+const LOOKUPS = 50_000;
+const LEGACY_LOOKUPS = 200;
+
+fn entryOffset(i: usize) u64 {
+    return @as(u64, i) * ENTRY_SIZE;
+}
+
+fn checksum(bytes: []const u8) u64 {
+    var sum: u64 = 0;
+    for (bytes) |b| sum +%= b;
+    return sum;
+}
+
+fn buildBundle(dir: std.fs.Dir) !void {
+    const file = try dir.createFile("bundle.bin", .{});
+    defer file.close();
+    var entry: [ENTRY_SIZE]u8 = undefined;
+    for (0..ENTRY_COUNT) |i| {
+        for (&entry, 0..) |*b, j| b.* = @truncate(i *% 31 +% j);
+        try file.writeAll(&entry);
+    }
+}
+
+fn lookupOrder(buf: []usize) void {
+    var prng = std.Random.DefaultPrng.init(0x5EED);
+    for (buf) |*i| i.* = prng.random().uintLessThan(usize, ENTRY_COUNT);
+}
+
+const Result = struct {
+    lookups: usize,
+    ns: u64,
+    sum: u64,
+};
+
+fn report(name: []const u8, r: Result) void {
+    const per_s = @as(f64, @floatFromInt(r.lookups)) * 1e9 / @as(f64, @floatFromInt(@max(r.ns, 1)));
+    const mb_s = per_s * ENTRY_SIZE / (1024 * 1024);
+    print("[bench]   {s:<22} {d:>10.0} lookups/s  {d:>8.1} MB/s  ({d} lookups)\n", .{ name, per_s, mb_s, r.lookups });
+}
+
+fn legacy(dir: std.fs.Dir, order: []const usize) !Result {
+    var sum: u64 = 0;
+    var buf: [64 * 1024]u8 = undefined;
+    var timer = try std.time.Timer.start();
+    for (order) |idx| {
+        const file = try dir.openFile("bundle.bin", .{});
+        defer file.close();
+        var remaining = entryOffset(idx);
+        while (remaining > 0) {
+            const n = try file.read(buf[0..@intCast(@min(remaining, buf.len))]);
+            if (n == 0) return error.ShortRead;
+            remaining -= n;
+        }
+        const n = try file.readAll(buf[0..ENTRY_SIZE]);
+        sum +%= checksum(buf[0..n]);
+    }
+    return .{ .lookups = order.len, .ns = timer.read(), .sum = sum };
+}
+
+fn pread(fs: *std_impl.fs.Fs, order: []const usize) !Result {
+    var file = fs.open("/bundle.bin", .read_write) orelse return error.OpenFailed;
+    defer file.close();
+    try testing.expect(file.data == null);
+
+    var sum: u64 = 0;
+    var buf: [ENTRY_SIZE]u8 = undefined;
+    var timer = try std.time.Timer.start();
+    for (order) |idx| {
+        const n = file.pread(&buf, entryOffset(idx));
+        sum +%= checksum(buf[0..n]);
+    }
+    return .{ .lookups = order.len, .ns = timer.read(), .sum = sum };
+}
+
+fn mmap(fs: *std_impl.fs.Fs, order: []const usize, advice: ?trait.fs.Advice) !Result {
+    var file = fs.open("/bundle.bin", .read) orelse return error.OpenFailed;
+    defer file.close();
+    const data = file.data orelse return error.NotMapped;
+    if (advice) |a| file.advise(0, 0, a);
+
+    var sum: u64 = 0;
+    var timer = try std.time.Timer.start();
+    for (order) |idx| {
+        const off: usize = @intCast(entryOffset(idx));
+        sum +%= checksum(data[off..][0..ENTRY_SIZE]);
+    }
+    return .{ .lookups = order.len, .ns = timer.read(), .sum = sum };
+}
+
+test "BM1: random asset lookups in a 64 MiB bundle" {
+    var tmp = testing.tmpDir(.{});
+    defer tmp.cleanup();
+    try buildBundle(tmp.dir);
+
+    var fs = std_impl.fs.Fs.initDir(tmp.dir);
+    defer fs.deinit();
+
+    const order = try testing.allocator.alloc(usize, LOOKUPS);
+    defer testing.allocator.free(order);
+    lookupOrder(order);
+
+    print("\n[bench] {d} x {d} KiB assets, random lookups\n", .{ ENTRY_COUNT, ENTRY_SIZE / 1024 });
+    const old = try legacy(tmp.dir, order[0..LEGACY_LOOKUPS]);
+    const pos = try pread(&fs, order);
+    const zc = try mmap(&fs, order, null);
+    const zc_random = try mmap(&fs, order, .random);
+    report("legacy re-open+read", old);
+    report("pread (fd)", pos);
+    report("mmap zero-copy", zc);
+    report("mmap + advise(random)", zc_random);
+
+    // Same bytes in every mode
+    const head = try pread(&fs, order[0..LEGACY_LOOKUPS]);
+    try testing.expectEqual(old.sum, head.sum);
+    try testing.expectEqual(pos.sum, zc.sum);
+    try testing.expectEqual(zc.sum, zc_random.sum);
+}
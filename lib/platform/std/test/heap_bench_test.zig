@@ -0,0 +1,119 @@
+//! Accounting allocator overhead and footprint report.
+//!
+//!   BM1: alloc/free churn with connection-like sizes through the raw
+//!        parent vs the accounting wrapper, single thread and 4 threads
+//!        sharing one tag (worst case: every counter contended)
+//!   BM2: per-subsystem footprint of an mqtt0 Mux with 256 subscriptions
+//!        and large-packet PacketBuffers, printed as the accounting report
+
+const std = @import("std");
+const std_impl = @import("std_impl");
+const mqtt0 = @import("mqtt0");
+const print = std.debug.print;
+const testing = std.testing;
+
+const heap = std_impl.heap;
+const Accounting = heap.Accounting(heap.Subsystem);
+
+const OPS = 400_000;
+const THREADS = 4;
+
+/// Sizes a connection handler typically asks for: headers, small
+/// records, a TLS record buffer, occasional large bodies.
+const sizes = [_]usize{ 24, 64, 200, 512, 1500, 4096, 16 * 1024 + 256, 48, 96, 32 * 1024 };
+
+fn churn(a: std.mem.Allocator, ops: usize) void {
+    var live: [16][]u8 = undefined;
+    var n: usize = 0;
+    var i: usize = 0;
+    while (i < ops) : (i += 1) {
+        if (n == live.len or (n > 0 and i % 3 == 0)) {
+            n -= 1;
+            a.free(live[(i * 7) % (n + 1)]);
+            live[(i * 7) % (n + 1)] = live[n];
+        } else {
+            live[n] = a.alloc(u8, sizes[i % sizes.len]) catch return;
+            live[n][0] = @truncate(i);
+            n += 1;
+        }
+    }
+    for (live[0..n]) |buf| a.free(buf);
+}
+
+fn timeChurn(a: std.mem.Allocator, threads: usize) !u64 {
+    var timer = try std.time.Timer.start();
+    if (threads == 1) {
+        churn(a, OPS);
+    } else {
+        var handles: [THREADS]std.Thread = undefined;
+        for (handles[0..threads]) |*t| t.* = try std.Thread.spawn(.{}, churn, .{ a, OPS / threads });
+        for (handles[0..threads]) |t| t.join();
+    }
+    return timer.read();
+}
+
+fn reportOverhead(name: []const u8, raw_ns: u64, acct_ns: u64) void {
+    const raw = @as(f64, @floatFromInt(raw_ns)) / OPS;
+    const acct = @as(f64, @floatFromInt(acct_ns)) / OPS;
+    print("[bench]   {s:<22} raw {d:>7.1} ns/op  accounted {d:>7.1} ns/op  (+{d:.1} ns, {d:.0}%)\n", .{
+        name, raw, acct, acct - raw, (acct - raw) * 100 / raw,
+    });
+}
+
+test "BM1: accounting overhead" {
+    const parent = std.heap.smp_allocator;
+    var acct = Accounting.init(parent, .{});
+
+    print("\n[bench] alloc/free churn, {d} ops, sizes 24 B..32 KiB\n", .{OPS});
+    // Warm the parent so both runs start from the same heap state
+    _ = try timeChurn(parent, 1);
+
+    reportOverhead("1 thread", try timeChurn(parent, 1), try timeChurn(acct.allocator(.net), 1));
+    reportOverhead("4 threads, one tag", try timeChurn(parent, THREADS), try timeChurn(acct.allocator(.net), THREADS));
+
+    const c = acct.snapshot(.net);
+    try testing.expectEqual(@as(u64, 0), c.live_bytes);
+    try testing.expectEqual(c.allocs, c.frees);
+}
+
+const Mux = mqtt0.Mux(std_impl.runtime);
+
+fn onMessage(_: []const u8, _: *const mqtt0.Message) anyerror!void {}
+
+test "BM2: per-subsystem footprint report" {
+    var acct = Accounting.init(testing.allocator, .{});
+    acct.setBudget(.mqtt0, 256 * 1024);
+
+    var mux = try Mux.init(acct.allocator(.mqtt0));
+    defer mux.deinit();
+    var topic: [64]u8 = undefined;
+    for (0..256) |i| {
+        const pattern = try std.fmt.bufPrint(&topic, "devices/{d}/sensors/+/state", .{i});
+        try mux.handleFn(pattern, &onMessage);
+    }
+    const after_subs = acct.snapshot(.mqtt0);
+
+    var bufs: [8]mqtt0.PacketBuffer = undefined;
+    for (&bufs) |*b| {
+        b.* = mqtt0.PacketBuffer.init(acct.allocator(.app));
+        _ = try b.acquire(12 * 1024);
+    }
+    defer for (&bufs) |*b| b.deinit();
+
+    // A budget that is too small fails at the allocation, not later
+    acct.setBudget(.ws, 1024);
+    try testing.expectError(error.OutOfMemory, acct.allocator(.ws).alloc(u8, 4096));
+
+    print("\n[bench] mqtt0 Mux with 256 subscriptions: {d} bytes live in {d} blocks ({d} B/subscription)\n", .{
+        after_subs.live_bytes,
+        after_subs.live_allocs,
+        after_subs.live_bytes / 256,
+    });
+    var out: [8192]u8 = undefined;
+    var stream = std.io.fixedBufferStream(&out);
+    try acct.report(stream.writer());
+    print("{s}", .{stream.getWritten()});
+
+    try testing.expect(after_subs.live_bytes > 0);
+    try testing.expectEqual(@as(u64, 8 * 12 * 1024), acct.snapshot(.app).live_bytes);
+}
@@ -0,0 +1,313 @@
+//! Vectored and batched socket I/O over loopback.
+//!
+//!   BM1: TCP messages of a 14-byte header (a masked WebSocket frame
+//!        header) and a body: two sends, staging copy + send, sendv
+//!   BM2: UDP packets per second with 64-byte datagrams: sendTo and
+//!        recvFromWithAddr one at a time vs sendBatch/recvBatch
+//!        (sendmmsg/recvmmsg) vs sendSegments/recvSegments (UDP GSO/GRO)
+//!
+//! Reports messages per second, MB/s and socket calls per message on each
+//! side. Batched and segmented sends count the syscalls the socket made
+//! (`Socket.send_syscalls`); every other call counted here is one.
+
+const std = @import("std");
+const builtin = @import("builtin");
+const std_impl = @import("std_impl");
+const trait = @import("trait");
+const print = std.debug.print;
+const testing = std.testing;
+
+const Socket = std_impl.socket.Socket;
+const socket = trait.socket;
+const loopback = [4]u8{ 127, 0, 0, 1 };
+
+const HEADER_LEN = 14;
+const BODY_LENS = [_]usize{ 64, 1024, 16 * 1024 };
+const TCP_BYTES = 64 * 1024 * 1024;
+const TCP_MAX_MESSAGES = 200_000;
+
+const UDP_DATAGRAMS = 200_000;
+const UDP_LEN = 64;
+const UDP_BATCH = 32;
+const GSO_SEGMENTS = 64;
+
+/// Socket wrapper counting calls
+const Counted = struct {
+    sock: *Socket,
+    calls: usize = 0,
+
+    pub fn send(self: *Counted, data: []const u8) socket.Error!usize {
+        self.calls += 1;
+        return self.sock.send(data);
+    }
+    pub fn sendv(self: *Counted, bufs: []const []const u8) socket.Error!usize {
+        self.calls += 1;
+        return self.sock.sendv(bufs);
+    }
+    pub fn recv(self: *Counted, buf: []u8) socket.Error!usize {
+        self.calls += 1;
+        return self.sock.recv(buf);
+    }
+    pub fn recvv(self: *Counted, bufs: []const []u8) socket.Error!usize {
+        self.calls += 1;
+        return self.sock.recvv(bufs);
+    }
+    pub fn sendTo(self: *Counted, ip: socket.Ipv4Address, port: u16, data: []const u8) socket.Error!usize {
+        self.calls += 1;
+        return self.sock.sendTo(ip, port, data);
+    }
+    pub fn recvFromWithAddr(self: *Counted, buf: []u8) socket.Error!socket.RecvFromResult {
+        self.calls += 1;
+        return self.sock.recvFromWithAddr(buf);
+    }
+    pub fn sendBatch(self: *Counted, msgs: []const socket.Datagram) socket.Error!usize {
+        const before = self.sock.send_syscalls;
+        defer self.calls += self.sock.send_syscalls - before;
+        return self.sock.sendBatch(msgs);
+    }
+    pub fn recvBatch(self: *Counted, slots: []socket.RecvSlot) socket.Error!usize {
+        self.calls += 1;
+        return self.sock.recvBatch(slots);
+    }
+    pub fn sendSegments(self: *Counted, ip: socket.Ipv4Address, port: u16, data: []const u8, segment_len: usize) socket.Error!usize {
+        const before = self.sock.send_syscalls;
+        defer self.calls += self.sock.send_syscalls - before;
+        return self.sock.sendSegments(ip, port, data, segment_len);
+    }
+    pub fn recvSegments(self: *Counted, buf: []u8) socket.Error!std_impl.socket.SegmentedRecv {
+        self.calls += 1;
+        return self.sock.recvSegments(buf);
+    }
+};
+
+const Result = struct {
+    messages: usize,
+    bytes: usize,
+    ns: u64,
+    send_calls: usize,
+    recv_calls: usize,
+
+    fn report(self: Result, name: []const u8) void {
+        const secs = @as(f64, @floatFromInt(@max(self.ns, 1))) / 1e9;
+        const msgs: f64 = @floatFromInt(self.messages);
+        print("[bench]   {s:<14} {d:>10.0} msg/s {d:>9.1} MB/s   send {d:>5.2} calls/msg   recv {d:>5.2} calls/msg\n", .{
+            name,
+            msgs / secs,
+            @as(f64, @floatFromInt(self.bytes)) / secs / (1024 * 1024),
+            @as(f64, @floatFromInt(self.send_calls)) / msgs,
+            @as(f64, @floatFromInt(self.recv_calls)) / msgs,
+        });
+    }
+};
+
+// ============================================================================
+// BM1: TCP header + body
+// ============================================================================
+
+const TcpMode = enum { two_sends, staging_copy, sendv };
+
+const StreamSink = struct {
+    conn: Socket,
+    expected: usize,
+    bytes: usize = 0,
+    calls: usize = 0,
+
+    fn run(self: *StreamSink) void {
+        var buf: [64 * 1024]u8 = undefined;
+        var c = Counted{ .sock = &self.conn };
+        while (self.bytes < self.expected) {
+            self.bytes += c.recv(&buf) catch break;
+        }
+        self.calls = c.calls;
+    }
+};
+
+fn sendAll(c: *Counted, data: []const u8) !void {
+    var off: usize = 0;
+    while (off < data.len) off += try c.send(data[off..]);
+}
+
+fn tcpRun(mode: TcpMode, body_len: usize) !Result {
+    var server = try Socket.tcp();
+    defer server.close();
+    try server.bind(loopback, 0);
+    try server.listen();
+    const port = try server.getBoundPort();
+
+    var client = try Socket.tcp();
+    defer client.close();
+    try client.connect(loopback, port);
+    client.setTcpNoDelay(true);
+
+    const msg_len = HEADER_LEN + body_len;
+    const messages = @min(TCP_MAX_MESSAGES, TCP_BYTES / msg_len);
+    var sink = StreamSink{ .conn = try server.accept(), .expected = messages * msg_len };
+    defer sink.conn.close();
+
+    var header: [HEADER_LEN]u8 = undefined;
+    @memset(&header, 0x82);
+    var body: [16 * 1024]u8 = undefined;
+    @memset(&body, 0xA5);
+    var staging: [HEADER_LEN + 16 * 1024]u8 = undefined;
+
+    var c = Counted{ .sock = &client };
+    var timer = try std.time.Timer.start();
+    const thread = try std.Thread.spawn(.{}, StreamSink.run, .{&sink});
+    for (0..messages) |_| switch (mode) {
+        .two_sends => {
+            try sendAll(&c, &header);
+            try sendAll(&c, body[0..body_len]);
+        },
+        .staging_copy => {
+            @memcpy(staging[0..HEADER_LEN], &header);
+            @memcpy(staging[HEADER_LEN..][0..body_len], body[0..body_len]);
+            try sendAll(&c, staging[0..msg_len]);
+        },
+        .sendv => try socket.sendvAll(&c, &.{ &header, body[0..body_len] }),
+    };
+    thread.join();
+    const ns = timer.read();
+
+    try testing.expectEqual(sink.expected, sink.bytes);
+    return .{
+        .messages = messages,
+        .bytes = sink.bytes,
+        .ns = ns,
+        .send_calls = c.calls,
+        .recv_calls = sink.calls,
+    };
+}
+
+test "BM1: TCP header + body, two sends vs staging copy vs sendv" {
+    print("\n[bench] BM1: TCP loopback, {d}-byte header + body, TCP_NODELAY\n", .{HEADER_LEN});
+    for (BODY_LENS) |body_len| {
+        print("[bench]   body {d} B\n", .{body_len});
+        inline for (.{ TcpMode.two_sends, TcpMode.staging_copy, TcpMode.sendv }) |mode| {
+            const r = try tcpRun(mode, body_len);
+            r.report(@tagName(mode));
+            switch (mode) {
+                .two_sends => try testing.expect(r.send_calls >= 2 * r.messages),
+                // Only partial writes under backpressure add calls
+                .sendv, .staging_copy => try testing.expect(r.send_calls < r.messages + r.messages / 10),
+            }
+        }
+    }
+}
+
+// ============================================================================
+// BM2: UDP datagrams
+// ============================================================================
+
+const UdpMode = enum { single, batched, gso_gro };
+
+const DatagramSink = struct {
+    sock: Socket,
+    mode: UdpMode,
+    received: usize = 0,
+    bytes: usize = 0,
+    calls: usize = 0,
+    /// Time of the last datagram, from the sender's timer start
+    last_ns: u64 = 0,
+    timer: std.time.Timer,
+
+    fn run(self: *DatagramSink) void {
+        var c = Counted{ .sock = &self.sock };
+        var bufs: [UDP_BATCH][2048]u8 = undefined;
+        var slots: [UDP_BATCH]socket.RecvSlot = undefined;
+        for (&slots, &bufs) |*slot, *b| slot.* = .{ .buf = b };
+        var coalesced: [64 * 1024]u8 = undefined;
+
+        while (self.received < UDP_DATAGRAMS) {
+            switch (self.mode) {
+                .single => {
+                    const r = c.recvFromWithAddr(&bufs[0]) catch break;
+                    self.received += 1;
+                    self.bytes += r.len;
+                },
+                .batched => {
+                    const n = socket.recvBatch(&c, &slots) catch break;
+                    self.received += n;
+                    for (slots[0..n]) |slot| self.bytes += slot.len;
+                },
+                .gso_gro => {
+                    const r = c.recvSegments(&coalesced) catch break;
+                    self.received += r.count();
+                    self.bytes += r.len;
+                },
+            }
+            self.last_ns = self.timer.read();
+        }
+        self.calls = c.calls;
+    }
+};
+
+fn udpRun(mode: UdpMode) !Result {
+    var rx = try Socket.udp();
+    defer rx.close();
+    try rx.bind(loopback, 0);
+    const port = try rx.getBoundPort();
+    rx.setRecvTimeout(200);
+    // Room for a burst, so the comparison is about syscalls, not drops
+    const rcvbuf: u32 = 8 * 1024 * 1024;
+    std.posix.setsockopt(rx.fd, std.posix.SOL.SOCKET, std.posix.SO.RCVBUF, std.mem.asBytes(&rcvbuf)) catch {};
+    if (mode == .gso_gro and !rx.enableGro()) print("[bench]   (UDP GRO unavailable)\n", .{});
+
+    var tx = try Socket.udp();
+    defer tx.close();
+    var c = Counted{ .sock = &tx };
+
+    var payload: [GSO_SEGMENTS * UDP_LEN]u8 = undefined;
+    @memset(&payload, 0x5A);
+    var batch: [UDP_BATCH]socket.Datagram = undefined;
+    for (&batch) |*m| m.* = .{ .addr = loopback, .port = port, .data = payload[0..UDP_LEN] };
+
+    var sink = DatagramSink{ .sock = rx, .mode = mode, .timer = try std.time.Timer.start() };
+    const thread = try std.Thread.spawn(.{}, DatagramSink.run, .{&sink});
+    var sent: usize = 0;
+    while (sent < UDP_DATAGRAMS) {
+        switch (mode) {
+            .single => {
+                _ = try c.sendTo(loopback, port, payload[0..UDP_LEN]);
+                sent += 1;
+            },
+            .batched => {
+                const n = @min(UDP_BATCH, UDP_DATAGRAMS - sent);
+                sent += try socket.sendBatch(&c, batch[0..n]);
+            },
+            .gso_gro => {
+                const n = @min(GSO_SEGMENTS, UDP_DATAGRAMS - sent);
+                sent += try c.sendSegments(loopback, port, payload[0 .. n * UDP_LEN], UDP_LEN) / UDP_LEN;
+            },
+        }
+    }
+    thread.join();
+    if (mode == .gso_gro and tx.gso_off) print("[bench]   (UDP GSO refused: sendSegments fell back to sendBatch)\n", .{});
+
+    return .{
+        .messages = sink.received,
+        .bytes = sink.bytes,
+        .ns = sink.last_ns,
+        // Scaled so that calls/msg is per datagram sent, not delivered
+        .send_calls = c.calls * sink.received / UDP_DATAGRAMS,
+        .recv_calls = sink.calls,
+    };
+}
+
+test "BM2: UDP packets per second, single vs batched vs GSO/GRO" {
+    print("\n[bench] BM2: UDP loopback, {d} x {d}-byte datagrams, batch {d}, GSO {d}\n", .{ UDP_DATAGRAMS, UDP_LEN, UDP_BATCH, GSO_SEGMENTS });
+    var results: [3]Result = undefined;
+    for (&results, 0..) |*r, i| {
+        const mode: UdpMode = @enumFromInt(i);
+        r.* = try udpRun(mode);
+        r.report(@tagName(mode));
+    }
+    print("[bench]   delivered: single {d}, batched {d}, gso_gro {d} of {d}\n", .{
+        results[0].messages, results[1].messages, results[2].messages, UDP_DATAGRAMS,
+    });
+
+    for (results) |r| try testing.expect(r.messages > 0);
+    if (builtin.os.tag == .linux) {
+        try testing.expect(results[1].send_calls * 8 < results[1].messages);
+        try testing.expect(results[2].send_calls * 8 < results[2].messages);
+    }
+}
@@ -0,0 +1,372 @@
+//! WebSim Headless Runner — deterministic virtual-clock simulation.
+//!
+//! Runs the same `App` (init + step) as `native.run`, but without a webview
+//! and without the wall clock. Time advances only by `step_ms` per step (and
+//! by `sal.time.sleepMs`), inputs come from a scripted event trace, and
+//! outputs are captured into a text transcript:
+//!
+//! ```
+//! 1000 log [INFO] BTN1 PRESSED
+//! 1008 frame 12 240x240 crc=9a3c11f0
+//! 1008 led 0 #ff0000
+//! 1024 audio 256 crc=0be1a77c
+//! ```
+//!
+//! The transcript is compared against a golden file on CI; a run is a pure
+//! function of (App, trace, options), so it reproduces bit-for-bit and runs
+//! as fast as the CPU allows.
+//!
+//! ## Usage
+//!
+//! ```zig
+//! pub fn main() !void {
+//!     try websim.headless.runFromArgs(@This(), .{
+//!         .trace = @embedFile("buttons.trace"),
+//!     });
+//! }
+//! // $ app --golden test/buttons.golden            (CI: compare)
+//! // $ app --golden test/buttons.golden --update   (re-record)
+//! // $ app --out /tmp/run --frames                 (dump frames + audio)
+//! ```
+
+const std = @import("std");
+const state_mod = @import("../impl/state.zig");
+pub const trace = @import("trace.zig");
+
+const shared = &state_mod.state;
+
+pub const Options = struct {
+    /// Event trace text (see trace.zig for the format)
+    trace: []const u8 = "",
+    /// Virtual time per App.step() call
+    step_ms: u32 = 16,
+    /// Hard stop in virtual ms (null: `end` event, or last event + tail_ms)
+    duration_ms: ?u64 = null,
+    /// Extra virtual time to run after the last trace event
+    tail_ms: u64 = 1000,
+    /// Speaker/mic sample rate; the speaker ring is drained at this rate
+    audio_rate_hz: u32 = 16000,
+    /// Directory for transcript.txt, audio_out.pcm and (optionally) frames
+    out_dir: ?[]const u8 = null,
+    /// Write every flushed frame as frame_NNNNN.rgb565 into out_dir
+    dump_frames: bool = false,
+    /// Compare the transcript against this file
+    golden_path: ?[]const u8 = null,
+    /// Overwrite golden_path with this run's transcript instead of comparing
+    update_golden: bool = false,
+    allocator: std.mem.Allocator = std.heap.page_allocator,
+};
+
+pub const Report = struct {
+    steps: u64 = 0,
+    virtual_ms: u64 = 0,
+    wall_ms: u64 = 0,
+    frames: u32 = 0,
+    log_lines: u32 = 0,
+    audio_out_samples: u64 = 0,
+    /// 1-based transcript line of the first golden mismatch
+    golden_mismatch_line: ?usize = null,
+
+    /// Virtual time elapsed per wall-clock time (>1 = faster than real time)
+    pub fn speedup(self: Report) f64 {
+        if (self.wall_ms == 0) return 0;
+        return @as(f64, @floatFromInt(self.virtual_ms)) / @as(f64, @floatFromInt(self.wall_ms));
+    }
+};
+
+/// Run `App` under the virtual clock until the trace ends.
+pub fn run(comptime App: type, opts: Options) !Report {
+    var transcript: std.Io.Writer.Allocating = .init(opts.allocator);
+    defer transcript.deinit();
+
+    var out_dir: ?std.fs.Dir = null;
+    defer if (out_dir) |*d| d.close();
+    if (opts.out_dir) |path| {
+        try std.fs.cwd().makePath(path);
+        out_dir = try std.fs.cwd().openDir(path, .{});
+    }
+
+    var audio_file: ?std.fs.File = null;
+    defer if (audio_file) |f| f.close();
+    if (out_dir) |d| audio_file = try d.createFile("audio_out.pcm", .{});
+
+    var rec = Recorder{
+        .out = &transcript.writer,
+        .frames_dir = if (opts.dump_frames) out_dir else null,
+        .audio_file = audio_file,
+    };
+
+    // Validate the whole trace up front so a typo fails before a long run
+    const stop_ms = try resolveStopTime(opts);
+
+    shared.* = .{};
+    shared.virtual_time = true;
+    defer shared.virtual_time = false;
+    shared.time_ms = 0;
+    shared.start_time_ms = 0;
+
+    var report = Report{};
+    const wall_start = std.time.milliTimestamp();
+
+    if (@hasDecl(App, "init")) App.init();
+
+    var parser = trace.Parser.init(opts.trace);
+    var pending: ?trace.Event = parser.next() catch unreachable;
+    var mic = MicGen{};
+    var audio_credit: u64 = 0;
+
+    // The virtual clock is the only time base: each step starts at
+    // `shared.time_ms` and lasts `step_ms`, or longer if it slept
+    while (shared.running and shared.time_ms <= stop_ms) {
+        const tick = shared.time_ms;
+
+        // Inputs scheduled up to this tick
+        while (pending) |ev| {
+            if (ev.at_ms > tick) break;
+            if (ev.action == .end) break;
+            applyEvent(ev.action, &mic, opts.audio_rate_hz);
+            pending = parser.next() catch unreachable;
+        }
+
+        mic.feed(opts.audio_rate_hz, opts.step_ms);
+
+        if (@hasDecl(App, "step")) App.step();
+        report.steps += 1;
+        if (shared.time_ms < tick + opts.step_ms) shared.time_ms = tick + opts.step_ms;
+
+        // Speaker plays at a fixed rate for the step's virtual duration;
+        // fractional samples carry over
+        audio_credit += @as(u64, opts.audio_rate_hz) * (shared.time_ms - tick);
+        const play: u32 = @intCast(audio_credit / 1000);
+        audio_credit %= 1000;
+
+        try rec.capture(tick, play, &report);
+    }
+
+    report.virtual_ms = shared.time_ms;
+    report.wall_ms = @intCast(@max(0, std.time.milliTimestamp() - wall_start));
+    shared.running = false;
+
+    const text = transcript.written();
+    if (out_dir) |d| try d.writeFile(.{ .sub_path = "transcript.txt", .data = text });
+
+    if (opts.golden_path) |golden_path| {
+        if (opts.update_golden) {
+            try std.fs.cwd().writeFile(.{ .sub_path = golden_path, .data = text });
+        } else {
+            const golden = try std.fs.cwd().readFileAlloc(opts.allocator, golden_path, 64 * 1024 * 1024);
+            defer opts.allocator.free(golden);
+            report.golden_mismatch_line = firstMismatch(golden, text);
+        }
+    }
+
+    return report;
+}
+
+/// `main()` helper: parses `--golden <path> [--update] [--out <dir>]
+/// [--frames] [--trace <path>]`, prints a summary and returns an error if
+/// the golden comparison fails (non-zero exit for CI).
+pub fn runFromArgs(comptime App: type, defaults: Options) !void {
+    var opts = defaults;
+    var trace_buf: ?[]u8 = null;
+    defer if (trace_buf) |b| opts.allocator.free(b);
+
+    var args = try std.process.argsWithAllocator(opts.allocator);
+    defer args.deinit();
+    _ = args.skip();
+    while (args.next()) |arg| {
+        if (std.mem.eql(u8, arg, "--golden")) {
+            opts.golden_path = args.next() orelse return error.InvalidArgs;
+        } else if (std.mem.eql(u8, arg, "--update")) {
+            opts.update_golden = true;
+        } else if (std.mem.eql(u8, arg, "--out")) {
+            opts.out_dir = args.next() orelse return error.InvalidArgs;
+        } else if (std.mem.eql(u8, arg, "--frames")) {
+            opts.dump_frames = true;
+        } else if (std.mem.eql(u8, arg, "--trace")) {
+            const path = args.next() orelse return error.InvalidArgs;
+            trace_buf = try std.fs.cwd().readFileAlloc(opts.allocator, path, 16 * 1024 * 1024);
+            opts.trace = trace_buf.?;
+        } else {
+            std.debug.print("[WebSim] unknown argument: {s}\n", .{arg});
+            return error.InvalidArgs;
+        }
+    }
+
+    const report = try run(App, opts);
+    std.debug.print("[WebSim] headless: {d} steps, {d}ms virtual in {d}ms wall ({d:.1}x), {d} frames, {d} log lines\n", .{
+        report.steps,
+        report.virtual_ms,
+        report.wall_ms,
+        report.speedup(),
+        report.frames,
+        report.log_lines,
+    });
+
+    if (report.golden_mismatch_line) |line| {
+        std.debug.print("[WebSim] golden mismatch at line {d} of {s}\n", .{ line, opts.golden_path.? });
+        return error.GoldenMismatch;
+    }
+}
+
+// ============================================================================
+// Trace application
+// ============================================================================
+
+fn resolveStopTime(opts: Options) error{InvalidTrace}!u64 {
+    var parser = trace.Parser.init(opts.trace);
+    var last: u64 = 0;
+    var end_at: ?u64 = null;
+    while (parser.next() catch |err| {
+        std.debug.print("[WebSim] trace line {d}: {s}\n", .{ parser.line_no, @errorName(err) });
+        return error.InvalidTrace;
+    }) |ev| {
+        last = ev.at_ms;
+        if (ev.action == .end and end_at == null) end_at = ev.at_ms;
+    }
+    return opts.duration_ms orelse end_at orelse last + opts.tail_ms;
+}
+
+fn applyEvent(action: trace.Action, mic: *MicGen, rate_hz: u32) void {
+    switch (action) {
+        .button => |down| shared.setButtonPressed(down),
+        .power => |down| shared.setPowerPressed(down),
+        .adc => |raw| shared.adc_raw = raw,
+        .accel => |v| shared.imu_accel = v,
+        .gyro => |v| shared.imu_gyro = v,
+        .wifi_rssi => |rssi| shared.wifi_rssi = rssi,
+        .wifi_drop => shared.wifi_force_disconnect = true,
+        .ble_connect => shared.ble_sim_connect = true,
+        .ble_disconnect => shared.ble_sim_disconnect = true,
+        .mic_tone => |t| mic.* = .{
+            .freq_hz = t.freq_hz,
+            .remaining = @as(u64, rate_hz) * t.duration_ms / 1000,
+        },
+        .mic_silence => |ms| mic.* = .{
+            .freq_hz = 0,
+            .remaining = @as(u64, rate_hz) * ms / 1000,
+        },
+        .end => {},
+    }
+}
+
+/// Deterministic mic source: pushes one step's worth of samples per tick
+const MicGen = struct {
+    freq_hz: u32 = 0,
+    remaining: u64 = 0,
+    /// Sample index since the tone started (phase is exact, no drift)
+    n: u64 = 0,
+
+    fn feed(self: *MicGen, rate_hz: u32, step_ms: u32) void {
+        var count = @min(self.remaining, @as(u64, rate_hz) * step_ms / 1000);
+        self.remaining -= count;
+        while (count > 0) : (count -= 1) {
+            if (shared.audioInAvailable() >= state_mod.AUDIO_BUF_SAMPLES) return;
+            const sample: i16 = if (self.freq_hz == 0) 0 else blk: {
+                const phase = @as(f64, @floatFromInt((self.n * self.freq_hz) % rate_hz)) / @as(f64, @floatFromInt(rate_hz));
+                break :blk @intFromFloat(@sin(phase * 2.0 * std.math.pi) * 16000.0);
+            };
+            shared.audio_in_buf[shared.audio_in_write & state_mod.AUDIO_BUF_MASK] = sample;
+            shared.audio_in_write +%= 1;
+            self.n += 1;
+        }
+    }
+};
+
+// ============================================================================
+// Output capture
+// ============================================================================
+
+const Recorder = struct {
+    out: *std.Io.Writer,
+    frames_dir: ?std.fs.Dir,
+    audio_file: ?std.fs.File,
+
+    log_seen: u32 = 0,
+    frames_seen: u32 = 0,
+    leds: [state_mod.MAX_LEDS]state_mod.Color = [_]state_mod.Color{state_mod.Color.black} ** state_mod.MAX_LEDS,
+
+    fn capture(self: *Recorder, tick: u64, play_samples: u32, report: *Report) !void {
+        // Logs (ring may have wrapped if a step logged more than it holds)
+        const new_lines = shared.log_seq -% self.log_seen;
+        if (new_lines > state_mod.LOG_LINES_MAX) {
+            try self.out.print("{d} log-dropped {d}\n", .{ tick, new_lines - state_mod.LOG_LINES_MAX });
+        }
+        const keep = @min(new_lines, shared.log_count);
+        var i: u32 = shared.log_count - keep;
+        while (i < shared.log_count) : (i += 1) {
+            try self.out.print("{d} log {s}\n", .{ tick, shared.getLogLine(i).? });
+        }
+        self.log_seen = shared.log_seq;
+        report.log_lines += new_lines;
+        shared.log_dirty = false;
+
+        // Display: one entry per step that flushed, hashed over the visible area
+        if (shared.display_flush_count != self.frames_seen) {
+            self.frames_seen = shared.display_flush_count;
+            shared.display_dirty = false;
+            report.frames += 1;
+
+            const w = shared.display_width;
+            const h = shared.display_height;
+            const fb = shared.display_fb[0 .. @as(usize, w) * h * state_mod.DISPLAY_BPP];
+            try self.out.print("{d} frame {d} {d}x{d} crc={x:0>8}\n", .{ tick, report.frames, w, h, std.hash.Crc32.hash(fb) });
+
+            if (self.frames_dir) |d| {
+                var name_buf: [32]u8 = undefined;
+                const name = std.fmt.bufPrint(&name_buf, "frame_{d:0>5}.rgb565", .{report.frames}) catch unreachable;
+                try d.writeFile(.{ .sub_path = name, .data = fb });
+            }
+        }
+
+        // LEDs: only changes
+        for (shared.led_colors[0..@min(shared.led_count, state_mod.MAX_LEDS)], 0..) |col, idx| {
+            if (!col.eql(self.leds[idx])) {
+                self.leds[idx] = col;
+                try self.out.print("{d} led {d} #{x:0>2}{x:0>2}{x:0>2}\n", .{ tick, idx, col.r, col.g, col.b });
+            }
+        }
+
+        // Speaker: drain what a real DAC would have played during this step
+        const avail = shared.audioOutAvailable();
+        const n = @min(avail, play_samples);
+        if (n > 0) {
+            var crc = std.hash.Crc32.init();
+            var chunk: [256]i16 = undefined;
+            var done: u32 = 0;
+            while (done < n) {
+                const m = @min(n - done, chunk.len);
+                for (chunk[0..m], 0..) |*s, k| {
+                    s.* = shared.audio_out_buf[(shared.audio_out_read +% done +% @as(u32, @intCast(k))) & state_mod.AUDIO_BUF_MASK];
+                }
+                const bytes = std.mem.sliceAsBytes(chunk[0..m]);
+                crc.update(bytes);
+                if (self.audio_file) |f| try f.writeAll(bytes);
+                done += m;
+            }
+            shared.audio_out_read +%= n;
+            report.audio_out_samples += n;
+            try self.out.print("{d} audio {d} crc={x:0>8}\n", .{ tick, n, crc.final() });
+        }
+    }
+};
+
+/// 1-based line number of the first difference, or null if identical
+fn firstMismatch(expected: []const u8, actual: []const u8) ?usize {
+    var a = std.mem.splitScalar(u8, expected, '\n');
+    var b = std.mem.splitScalar(u8, actual, '\n');
+    var line: usize = 1;
+    while (true) : (line += 1) {
+        const la = a.next();
+        const lb = b.next();
+        if (la == null and lb == null) return null;
+        if (la == null or lb == null or !std.mem.eql(u8, la.?, lb.?)) {
+            std.debug.print("[WebSim] golden line {d}:\n  expected: {s}\n  actual:   {s}\n", .{
+                line,
+                la orelse "<eof>",
+                lb orelse "<eof>",
+            });
+            return line;
+        }
+    }
+}
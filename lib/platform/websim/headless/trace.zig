@@ -0,0 +1,144 @@
+//! Headless Event Trace
+//!
+//! Text script of timed input events for the headless virtual-clock runner.
+//! One event per line, `#` starts a comment, times are virtual ms since boot
+//! and must not decrease:
+//!
+//! ```
+//! # time  event    args
+//! 0       adc      4095
+//! 500     adc      1200          # press ADC button (raw value)
+//! 650     adc      4095
+//! 1000    button   down          # BOOT button
+//! 1080    button   up
+//! 1200    power    down|up
+//! 1500    imu      accel 0 0.5 0.8
+//! 1500    imu      gyro 0 0 90
+//! 2000    wifi     rssi -80
+//! 2100    wifi     drop
+//! 2200    ble      connect|disconnect
+//! 2300    mic      tone 440 500  # freq Hz, duration ms
+//! 2900    mic      silence 200
+//! 5000    end
+//! ```
+
+const std = @import("std");
+
+pub const Event = struct {
+    at_ms: u64,
+    action: Action,
+    /// 1-based line in the trace source (for error messages)
+    line: u32,
+};
+
+pub const Action = union(enum) {
+    button: bool,
+    power: bool,
+    adc: u16,
+    accel: [3]f32,
+    gyro: [3]f32,
+    wifi_rssi: i8,
+    wifi_drop,
+    ble_connect,
+    ble_disconnect,
+    mic_tone: struct { freq_hz: u32, duration_ms: u32 },
+    mic_silence: u32,
+    end,
+};
+
+pub const ParseError = error{
+    InvalidTime,
+    TimeWentBackwards,
+    UnknownEvent,
+    InvalidArgument,
+};
+
+/// Iterates events from trace text without allocating.
+pub const Parser = struct {
+    text: []const u8,
+    pos: usize = 0,
+    line_no: u32 = 0,
+    last_ms: u64 = 0,
+
+    const Self = @This();
+
+    pub fn init(text: []const u8) Self {
+        return .{ .text = text };
+    }
+
+    /// Next event, or null at end of text. On error, `line_no` is the
+    /// offending line.
+    pub fn next(self: *Self) ParseError!?Event {
+        while (self.pos < self.text.len) {
+            const end = std.mem.indexOfScalarPos(u8, self.text, self.pos, '\n') orelse self.text.len;
+            var line = self.text[self.pos..end];
+            self.pos = end + 1;
+            self.line_no += 1;
+
+            if (std.mem.indexOfScalar(u8, line, '#')) |hash| line = line[0..hash];
+            var tok = std.mem.tokenizeAny(u8, line, " \t\r");
+            const time_str = tok.next() orelse continue;
+
+            const at_ms = std.fmt.parseUnsigned(u64, time_str, 10) catch return error.InvalidTime;
+            if (at_ms < self.last_ms) return error.TimeWentBackwards;
+            self.last_ms = at_ms;
+
+            const name = tok.next() orelse return error.UnknownEvent;
+            return .{ .at_ms = at_ms, .action = try parseAction(name, &tok), .line = self.line_no };
+        }
+        return null;
+    }
+};
+
+fn parseAction(name: []const u8, tok: anytype) ParseError!Action {
+    const eql = std.mem.eql;
+    if (eql(u8, name, "button")) return .{ .button = try parseUpDown(tok.next()) };
+    if (eql(u8, name, "power")) return .{ .power = try parseUpDown(tok.next()) };
+    if (eql(u8, name, "adc")) {
+        const raw = try parseInt(u16, tok.next());
+        if (raw > 4095) return error.InvalidArgument;
+        return .{ .adc = raw };
+    }
+    if (eql(u8, name, "imu")) {
+        const which = tok.next() orelse return error.InvalidArgument;
+        var v: [3]f32 = undefined;
+        for (&v) |*f| f.* = std.fmt.parseFloat(f32, tok.next() orelse return error.InvalidArgument) catch return error.InvalidArgument;
+        if (eql(u8, which, "accel")) return .{ .accel = v };
+        if (eql(u8, which, "gyro")) return .{ .gyro = v };
+        return error.InvalidArgument;
+    }
+    if (eql(u8, name, "wifi")) {
+        const what = tok.next() orelse return error.InvalidArgument;
+        if (eql(u8, what, "drop")) return .wifi_drop;
+        if (eql(u8, what, "rssi")) return .{ .wifi_rssi = try parseInt(i8, tok.next()) };
+        return error.InvalidArgument;
+    }
+    if (eql(u8, name, "ble")) {
+        const what = tok.next() orelse return error.InvalidArgument;
+        if (eql(u8, what, "connect")) return .ble_connect;
+        if (eql(u8, what, "disconnect")) return .ble_disconnect;
+        return error.InvalidArgument;
+    }
+    if (eql(u8, name, "mic")) {
+        const what = tok.next() orelse return error.InvalidArgument;
+        if (eql(u8, what, "tone")) return .{ .mic_tone = .{
+            .freq_hz = try parseInt(u32, tok.next()),
+            .duration_ms = try parseInt(u32, tok.next()),
+        } };
+        if (eql(u8, what, "silence")) return .{ .mic_silence = try parseInt(u32, tok.next()) };
+        return error.InvalidArgument;
+    }
+    if (eql(u8, name, "end")) return .end;
+    return error.UnknownEvent;
+}
+
+fn parseUpDown(arg: ?[]const u8) ParseError!bool {
+    const a = arg orelse return error.InvalidArgument;
+    if (std.mem.eql(u8, a, "down")) return true;
+    if (std.mem.eql(u8, a, "up")) return false;
+    return error.InvalidArgument;
+}
+
+fn parseInt(comptime T: type, arg: ?[]const u8) ParseError!T {
+    return std.fmt.parseInt(T, arg orelse return error.InvalidArgument, 10) catch error.InvalidArgument;
+}
@@ -194,7 +194,12 @@ pub const sal = struct {
     pub const time = struct {
         /// Sleep for the given number of milliseconds.
         /// WASM: no-op (cooperative stepping). Native: real sleep.
+        /// Headless virtual clock: advances simulated time instantly.
         pub fn sleepMs(ms: u32) void {
+            if (shared.virtual_time) {
+                shared.advanceTime(ms);
+                return;
+            }
             if (!is_wasm) {
                 std.Thread.sleep(@as(u64, ms) * std.time.ns_per_ms);
             }
@@ -2,7 +2,8 @@
 //!
 //! Simulates accelerometer + gyroscope.
 //! Default: stationary (accel = 0,0,1g, gyro = 0,0,0).
-//! Could be made interactive via JS (mouse drag to tilt) in the future.
+//! Readings come from SharedState.imu_accel / imu_gyro, so the headless
+//! runner's event trace (and later JS) can drive motion.
 
 const hal = @import("hal");
 const state_mod = @import("state.zig");
@@ -11,16 +12,6 @@ const shared = &state_mod.state;
 pub const ImuDriver = struct {
     const Self = @This();
 
-    /// Simulated accelerometer data (default: stationary, Z = 1g)
-    accel_x: f32 = 0.0,
-    accel_y: f32 = 0.0,
-    accel_z: f32 = 1.0, // 1g downward
-
-    /// Simulated gyroscope data (default: no rotation)
-    gyro_x: f32 = 0.0,
-    gyro_y: f32 = 0.0,
-    gyro_z: f32 = 0.0,
-
     pub fn init() !Self {
         shared.addLog("WebSim: IMU initialized (accel+gyro)");
         return .{};
@@ -29,20 +20,20 @@ pub const ImuDriver = struct {
     pub fn deinit(_: *Self) void {}
 
     /// Read accelerometer (returns scaled values in g, where 1g = 9.81 m/s²)
-    pub fn readAccel(self: *Self) !hal.imu.AccelData {
+    pub fn readAccel(_: *Self) !hal.imu.AccelData {
         return .{
-            .x = self.accel_x,
-            .y = self.accel_y,
-            .z = self.accel_z,
+            .x = shared.imu_accel[0],
+            .y = shared.imu_accel[1],
+            .z = shared.imu_accel[2],
         };
     }
 
     /// Read gyroscope (returns angular velocity in degrees/second)
-    pub fn readGyro(self: *Self) !hal.imu.GyroData {
+    pub fn readGyro(_: *Self) !hal.imu.GyroData {
         return .{
-            .x = self.gyro_x,
-            .y = self.gyro_y,
-            .z = self.gyro_z,
+            .x = shared.imu_gyro[0],
+            .y = shared.imu_gyro[1],
+            .z = shared.imu_gyro[2],
         };
     }
 };
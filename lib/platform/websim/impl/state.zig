@@ -93,6 +93,15 @@ pub const SharedState = struct {
     time_ms: u64 = 0,
     /// Start time for uptime calculation
     start_time_ms: u64 = 0,
+    /// Virtual clock: time_ms only moves via advanceTime() (headless runner,
+    /// sal.time.sleepMs), never from the wall clock. Makes runs reproducible.
+    virtual_time: bool = false,
+
+    // ======== IMU ========
+    /// Simulated accelerometer in g (default: stationary, Z = 1g)
+    imu_accel: [3]f32 = .{ 0.0, 0.0, 1.0 },
+    /// Simulated gyroscope in degrees/second
+    imu_gyro: [3]f32 = .{ 0.0, 0.0, 0.0 },
 
     // ======== Display Framebuffer ========
     /// Active display width (set per board, default 240)
@@ -104,6 +113,14 @@ pub const SharedState = struct {
     display_fb: [MAX_DISPLAY_FB_SIZE]u8 = [_]u8{0} ** MAX_DISPLAY_FB_SIZE,
     /// Dirty flag: set by flush, cleared by JS after rendering
     display_dirty: bool = false,
+    /// Total flushes since boot (monotonic, for frame capture)
+    display_flush_count: u32 = 0,
+    /// Seqlock over the framebuffer: odd while displayFlush is copying.
+    /// Readers on another thread (native binary transport) take a snapshot
+    /// only when they see the same even value before and after the copy.
+    display_write_seq: u32 = 0,
+    /// display_flush_count at which each row was last written
+    display_row_seq: [MAX_DISPLAY_HEIGHT]u32 = [_]u32{0} ** MAX_DISPLAY_HEIGHT,
 
     // ======== Log Buffer ========
     /// Log line storage
@@ -114,6 +131,8 @@ pub const SharedState = struct {
     log_count: u32 = 0,
     /// Next write index (ring buffer)
     log_next: u32 = 0,
+    /// Total lines ever logged (monotonic, never capped)
+    log_seq: u32 = 0,
     /// Flag: new log lines available (JS resets after reading)
     log_dirty: bool = false,
 
@@ -220,6 +239,8 @@ pub const SharedState = struct {
 
     /// Write pixels to the framebuffer (called by display flush)
     pub fn displayFlush(self: *SharedState, x1: u16, y1: u16, x2: u16, y2: u16, data: [*]const u8) void {
+        @atomicStore(u32, &self.display_write_seq, self.display_write_seq +% 1, .release);
+        const flush_no = self.display_flush_count +% 1;
         const w = @as(u32, x2 - x1 + 1);
         const line_bytes = w * DISPLAY_BPP;
         const stride: u32 = @as(u32, self.display_width);
@@ -232,8 +253,65 @@ pub const SharedState = struct {
                 const src = data[src_offset..][0..line_bytes];
                 @memcpy(dst, src);
             }
+            if (y < MAX_DISPLAY_HEIGHT) self.display_row_seq[y] = flush_no;
         }
         self.display_dirty = true;
+        self.display_flush_count = flush_no;
+        @atomicStore(u32, &self.display_write_seq, self.display_write_seq +% 1, .release);
+    }
+
+    /// Rows copied by `displaySnapshot`
+    pub const DisplaySnapshot = struct {
+        /// display_flush_count the snapshot is consistent with
+        flush_count: u32,
+        width: u16,
+        height: u16,
+        /// First and last row copied (full width, RGB565)
+        y1: u16,
+        y2: u16,
+    };
+
+    /// Copy every row flushed after `since_flush` into `out` (row-major,
+    /// full width). Safe against a concurrent displayFlush on another
+    /// thread: returns null when nothing changed or when the writer kept
+    /// the framebuffer busy for all retries (caller polls again).
+    pub fn displaySnapshot(self: *const SharedState, since_flush: u32, out: []u8) ?DisplaySnapshot {
+        var attempt: u32 = 0;
+        while (attempt < 4) : (attempt += 1) {
+            const seq = @atomicLoad(u32, &self.display_write_seq, .acquire);
+            if (seq & 1 != 0) continue;
+
+            const flush_count = self.display_flush_count;
+            if (flush_count == since_flush) return null;
+            const width = self.display_width;
+            const height = @min(self.display_height, MAX_DISPLAY_HEIGHT);
+
+            // Rows newer than since_flush (wrapping compare)
+            var y1: u16 = height;
+            var y2: u16 = 0;
+            for (0..height) |y| {
+                const age = self.display_row_seq[y] -% since_flush;
+                if (age != 0 and age < 0x8000_0000) {
+                    if (y1 == height) y1 = @intCast(y);
+                    y2 = @intCast(y);
+                }
+            }
+            if (y1 == height) {
+                y1 = 0;
+                y2 = height -| 1;
+            }
+
+            const row_bytes = @as(usize, width) * DISPLAY_BPP;
+            const start = @as(usize, y1) * row_bytes;
+            const len = (@as(usize, y2) - y1 + 1) * row_bytes;
+            if (len > out.len or start + len > MAX_DISPLAY_FB_SIZE) return null;
+            @memcpy(out[0..len], self.display_fb[start..][0..len]);
+
+            if (@atomicLoad(u32, &self.display_write_seq, .acquire) == seq) {
+                return .{ .flush_count = flush_count, .width = width, .height = height, .y1 = y1, .y2 = y2 };
+            }
+        }
+        return null;
     }
 
     // ================================================================
@@ -246,6 +324,7 @@ pub const SharedState = struct {
         self.log_lens[self.log_next] = len;
         self.log_next = (self.log_next + 1) % LOG_LINES_MAX;
         if (self.log_count < LOG_LINES_MAX) self.log_count += 1;
+        self.log_seq +%= 1;
         self.log_dirty = true;
     }
 
@@ -280,7 +359,8 @@ pub const SharedState = struct {
         while (i < to_write) : (i += 1) {
             self.audio_out_buf[(self.audio_out_write +% i) & AUDIO_BUF_MASK] = samples[i];
         }
-        self.audio_out_write +%= to_write;
+        // Publish after the samples: the native transport drains on another thread
+        @atomicStore(u32, &self.audio_out_write, self.audio_out_write +% to_write, .release);
         return to_write;
     }
 
@@ -312,6 +392,11 @@ pub const SharedState = struct {
     pub fn uptime(self: *const SharedState) u64 {
         return self.time_ms - self.start_time_ms;
     }
+
+    /// Advance the virtual clock (no-op when running on wall-clock time)
+    pub fn advanceTime(self: *SharedState, ms: u64) void {
+        if (self.virtual_time) self.time_ms += ms;
+    }
 };
 
 /// Global shared state instance
@@ -16,7 +16,7 @@ const shared = &state_mod.state;
 pub const Mac = [6]u8;
 
 /// Simulated connection delay in milliseconds
-const CONNECT_DELAY_MS: u64 = 500;
+pub const CONNECT_DELAY_MS: u64 = 500;
 
 /// Disconnect reason (must match HAL wifi.DisconnectReason enum order)
 pub const DisconnectReason = enum {
@@ -83,6 +83,7 @@ pub const WifiDriver = struct {
 
     /// Timestamp when connect() was called (for simulated delay)
     connect_start_ms: u64 = 0,
+    connect_delay_ms: u64 = CONNECT_DELAY_MS,
 
     /// Pending event queue (single slot — one event per poll cycle)
     pending_event: ?WifiEvent = null,
@@ -154,7 +155,7 @@ pub const WifiDriver = struct {
         // State machine: connecting → connected after delay
         if (self.state == .connecting) {
             const elapsed = shared.time_ms -| self.connect_start_ms;
-            if (elapsed >= CONNECT_DELAY_MS) {
+            if (elapsed >= self.connect_delay_ms) {
                 self.state = .connected;
                 shared.wifi_connected = true;
                 shared.addLog("WebSim: WiFi connected");
@@ -197,4 +198,12 @@ pub const WifiDriver = struct {
             shared.addLog("WebSim: WiFi reconnecting...");
         }
     }
+
+    /// Undo the `connected` event just polled, without another event:
+    /// the simulated AP refused the join (see wifi_sim.zig)
+    pub fn refuse(self: *Self) void {
+        self.state = .disconnected;
+        shared.wifi_connected = false;
+        shared.addLog("WebSim: WiFi connection refused");
+    }
 };
@@ -0,0 +1,379 @@
+//! Simulated WiFi Radio for Host Tests
+//!
+//! The WebSim WiFi driver (wifi.zig) run from a test instead of the
+//! browser. The driver keeps the connect delay, the SSID and the link
+//! state; this layer plays the part of JS and the air around it: it moves
+//! SharedState's clock with `advance`, places APs (fixed RSSI or an RSSI
+//! trace over time), and drops the link through `wifi_force_disconnect`
+//! when an AP goes away or falls below the receiver sensitivity.
+//!
+//! On top of the driver it answers scans, joins the strongest AP of the
+//! requested SSID (refusing unknown SSIDs and wrong passwords), and raises
+//! `rssi_low` at the configured threshold. Satisfies the hal.wifi Driver
+//! interface, including the optional scan, BSSID, power-save and
+//! RSSI-threshold methods; events use the hal types directly.
+//!
+//! The clock and link state live in the global SharedState, so run one
+//! simulated radio at a time.
+
+const std = @import("std");
+const hal = @import("hal");
+const websim_wifi = @import("wifi.zig");
+const shared = &@import("state.zig").state;
+
+const wifi = hal.wifi;
+pub const Mac = wifi.Mac;
+pub const WifiEvent = wifi.WifiEvent;
+pub const DisconnectReason = wifi.DisconnectReason;
+pub const FailReason = wifi.FailReason;
+pub const AuthMode = wifi.AuthMode;
+pub const PowerSaveMode = wifi.PowerSaveMode;
+
+/// RSSI at a point in time; values in between are interpolated
+pub const RssiPoint = struct {
+    at_ms: u64,
+    rssi: i8,
+};
+
+/// A simulated access point
+pub const Ap = struct {
+    ssid: []const u8,
+    password: []const u8 = "",
+    bssid: Mac,
+    channel: u8 = 6,
+    rssi: i8 = -50,
+    auth_mode: AuthMode = .wpa2_psk,
+    /// Overrides `rssi` when set; held flat before the first and after
+    /// the last point
+    trace: []const RssiPoint = &.{},
+    /// Cleared to take the AP off the air
+    present: bool = true,
+
+    pub fn rssiAt(self: *const Ap, now_ms: u64) i8 {
+        const t = self.trace;
+        if (t.len == 0) return self.rssi;
+        if (now_ms <= t[0].at_ms) return t[0].rssi;
+        for (t[0 .. t.len - 1], t[1..]) |a, b| {
+            if (now_ms >= b.at_ms) continue;
+            const span: i64 = @intCast(b.at_ms - a.at_ms);
+            const into: i64 = @intCast(now_ms - a.at_ms);
+            const delta: i64 = @as(i64, b.rssi) - a.rssi;
+            return @intCast(a.rssi + @divTrunc(delta * into, span));
+        }
+        return t[t.len - 1].rssi;
+    }
+};
+
+pub const Options = struct {
+    connect_delay_ms: u64 = websim_wifi.CONNECT_DELAY_MS,
+    /// All-channel active scan
+    scan_ms: u64 = 1_200,
+    /// The link drops below this RSSI
+    sensitivity_rssi: i8 = -92,
+    mac: Mac = .{ 0xDE, 0xAD, 0xBE, 0xEF, 0x00, 0x02 },
+};
+
+pub const ConnectConfig = struct {
+    ssid: []const u8,
+    password: []const u8,
+    channel_hint: u8 = 0,
+    bssid: ?Mac = null,
+    auth_mode: ?AuthMode = null,
+    timeout_ms: u32 = 30_000,
+};
+
+pub const ScanConfig = struct {
+    ssid: ?[]const u8 = null,
+    bssid: ?Mac = null,
+    channel: u8 = 0,
+    show_hidden: bool = false,
+    passive: bool = false,
+};
+
+/// What the radio was asked to do, for assertions
+pub const Stats = struct {
+    connects: u32 = 0,
+    scans: u32 = 0,
+    power_changes: u32 = 0,
+};
+
+pub const SimWifiDriver = struct {
+    const Self = @This();
+
+    pub const max_aps = 8;
+    const queue_len = 32;
+
+    options: Options,
+    driver: websim_wifi.WifiDriver,
+    now_ms: u64 = 0,
+    aps: [max_aps]Ap = undefined,
+    ap_count: usize = 0,
+
+    /// Joined AP, index into `aps`
+    ap: ?usize = null,
+    connect_bssid: ?Mac = null,
+    password_buf: [64]u8 = undefined,
+    password_len: u8 = 0,
+
+    scan_done_ms: ?u64 = null,
+    scan_ssid: ?[]const u8 = null,
+    power_save: PowerSaveMode = .none,
+    rssi_threshold: ?i8 = null,
+    rssi_low_armed: bool = true,
+
+    events: [queue_len]WifiEvent = undefined,
+    head: usize = 0,
+    len: usize = 0,
+    stats: Stats = .{},
+
+    /// Resets SharedState's clock and WiFi fields
+    pub fn init(options: Options) Self {
+        shared.time_ms = 0;
+        shared.wifi_connected = false;
+        shared.wifi_force_disconnect = false;
+        return .{
+            .options = options,
+            .driver = .{ .connect_delay_ms = options.connect_delay_ms, .mac = options.mac },
+        };
+    }
+
+    pub fn deinit(self: *Self) void {
+        self.driver.deinit();
+    }
+
+    // ================================================================
+    // Simulation control
+    // ================================================================
+
+    pub fn addAp(self: *Self, ap: Ap) *Ap {
+        std.debug.assert(self.ap_count < max_aps);
+        self.aps[self.ap_count] = ap;
+        self.ap_count += 1;
+        return &self.aps[self.ap_count - 1];
+    }
+
+    pub fn findAp(self: *Self, bssid: Mac) ?*Ap {
+        for (self.aps[0..self.ap_count]) |*ap| {
+            if (std.mem.eql(u8, &ap.bssid, &bssid)) return ap;
+        }
+        return null;
+    }
+
+    /// Drop the link as a lost AP does (`connection_lost`), the way the
+    /// browser's disconnect button does
+    pub fn injectDisconnect(self: *Self) void {
+        if (!self.driver.isConnected()) return;
+        shared.wifi_force_disconnect = true;
+        self.pollDriver();
+    }
+
+    /// Move the clock to `now_ms` and run everything that came due
+    pub fn advance(self: *Self, now_ms: u64) void {
+        self.now_ms = now_ms;
+        shared.time_ms = now_ms;
+        self.pollDriver();
+
+        if (self.scan_done_ms) |done| if (now_ms >= done) {
+            self.scan_done_ms = null;
+            self.finishScan();
+        }
+
+        const i = self.joined() orelse return;
+        const ap = &self.aps[i];
+        const rssi = ap.rssiAt(now_ms);
+        if (!ap.present or rssi < self.options.sensitivity_rssi) return self.injectDisconnect();
+        shared.wifi_rssi = rssi;
+        if (self.rssi_threshold) |threshold| {
+            if (rssi < threshold and self.rssi_low_armed) {
+                self.rssi_low_armed = false;
+                self.push(.{ .rssi_low = rssi });
+            } else if (rssi >= threshold) {
+                self.rssi_low_armed = true;
+            }
+        }
+    }
+
+    // ================================================================
+    // Required: connect / disconnect / isConnected / pollEvent
+    // ================================================================
+
+    pub fn connect(self: *Self, ssid: []const u8, password: []const u8) void {
+        self.connectWithConfig(.{ .ssid = ssid, .password = password });
+    }
+
+    pub fn disconnect(self: *Self) void {
+        self.driver.disconnect();
+        self.ap = null;
+    }
+
+    pub fn isConnected(self: *const Self) bool {
+        return self.driver.isConnected();
+    }
+
+    pub fn pollEvent(self: *Self) ?WifiEvent {
+        self.pollDriver();
+        if (self.len == 0) return null;
+        const event = self.events[self.head];
+        self.head = (self.head + 1) % queue_len;
+        self.len -= 1;
+        return event;
+    }
+
+    // ================================================================
+    // Optional: extended connection
+    // ================================================================
+
+    pub fn connectWithConfig(self: *Self, config: ConnectConfig) void {
+        const pw_len: u8 = @intCast(@min(config.password.len, self.password_buf.len));
+        @memcpy(self.password_buf[0..pw_len], config.password[0..pw_len]);
+        self.password_len = pw_len;
+        self.connect_bssid = config.bssid;
+        self.startConnect();
+        self.driver.connect(config.ssid, config.password);
+    }
+
+    pub fn reconnect(self: *Self) void {
+        if (self.driver.getSsid() == null) return;
+        self.connect_bssid = null;
+        self.startConnect();
+        self.driver.reconnect();
+    }
+
+    // ================================================================
+    // Optional: status queries
+    // ================================================================
+
+    pub fn getRssi(self: *const Self) ?i8 {
+        if (self.joined() == null) return null;
+        return self.driver.getRssi();
+    }
+
+    pub fn getMac(self: *const Self) ?Mac {
+        return self.driver.getMac();
+    }
+
+    pub fn getChannel(self: *const Self) ?u8 {
+        const i = self.joined() orelse return null;
+        return self.aps[i].channel;
+    }
+
+    pub fn getSsid(self: *const Self) ?[]const u8 {
+        return self.driver.getSsid();
+    }
+
+    pub fn getBssid(self: *const Self) ?Mac {
+        const i = self.joined() orelse return null;
+        return self.aps[i].bssid;
+    }
+
+    // ================================================================
+    // Optional: scan, power save, RSSI threshold
+    // ================================================================
+
+    pub fn scanStart(self: *Self, config: ScanConfig) !void {
+        if (self.scan_done_ms != null) return error.Busy;
+        self.stats.scans += 1;
+        self.scan_ssid = config.ssid;
+        self.scan_done_ms = self.now_ms + self.options.scan_ms;
+    }
+
+    pub fn setPowerSave(self: *Self, mode: PowerSaveMode) void {
+        if (mode != self.power_save) self.stats.power_changes += 1;
+        self.power_save = mode;
+    }
+
+    pub fn getPowerSave(self: *const Self) PowerSaveMode {
+        return self.power_save;
+    }
+
+    pub fn setRssiThreshold(self: *Self, rssi: i8) void {
+        self.rssi_threshold = rssi;
+        self.rssi_low_armed = true;
+    }
+
+    // ================================================================
+    // Internals
+    // ================================================================
+
+    fn joined(self: *const Self) ?usize {
+        return if (self.driver.isConnected()) self.ap else null;
+    }
+
+    /// Leaving the current AP for another one, as a roam does, reports
+    /// the disconnect the driver itself skips
+    fn startConnect(self: *Self) void {
+        if (self.driver.isConnected()) self.push(.{ .disconnected = .user_request });
+        self.stats.connects += 1;
+        self.ap = null;
+    }
+
+    /// Move the driver's events into the queue, deciding each join
+    fn pollDriver(self: *Self) void {
+        while (self.driver.pollEvent()) |event| {
+            switch (event) {
+                .connected => self.join(),
+                .disconnected => |reason| {
+                    self.ap = null;
+                    self.push(.{ .disconnected = @enumFromInt(@intFromEnum(reason)) });
+                },
+                else => {},
+            }
+        }
+    }
+
+    /// The driver's connect delay is over: pick the AP, or refuse
+    fn join(self: *Self) void {
+        const ssid = self.driver.getSsid() orelse "";
+        var pick: ?usize = null;
+        for (self.aps[0..self.ap_count], 0..) |*ap, i| {
+            if (!ap.present or !std.mem.eql(u8, ap.ssid, ssid)) continue;
+            if (ap.rssiAt(self.now_ms) < self.options.sensitivity_rssi) continue;
+            if (self.connect_bssid) |b| if (!std.mem.eql(u8, &b, &ap.bssid)) continue;
+            if (pick) |p| if (ap.rssiAt(self.now_ms) <= self.aps[p].rssiAt(self.now_ms)) continue;
+            pick = i;
+        }
+
+        const i = pick orelse return self.refuse(.ap_not_found);
+        const ap = &self.aps[i];
+        if (ap.auth_mode != .open and !std.mem.eql(u8, ap.password, self.password_buf[0..self.password_len])) {
+            return self.refuse(.auth_failed);
+        }
+        self.ap = i;
+        self.rssi_low_armed = true;
+        shared.wifi_rssi = ap.rssiAt(self.now_ms);
+        self.push(.{ .connected = {} });
+    }
+
+    fn refuse(self: *Self, reason: FailReason) void {
+        self.driver.refuse();
+        self.push(.{ .connection_failed = reason });
+    }
+
+    fn finishScan(self: *Self) void {
+        for (self.aps[0..self.ap_count]) |*ap| {
+            // Keep the last slot for scan_done
+            if (self.len >= queue_len - 1) break;
+            const rssi = ap.rssiAt(self.now_ms);
+            if (!ap.present or rssi < self.options.sensitivity_rssi) continue;
+            if (self.scan_ssid) |s| if (!std.mem.eql(u8, s, ap.ssid)) continue;
+
+            var info = wifi.ApInfo{
+                .ssid = undefined,
+                .ssid_len = @intCast(@min(ap.ssid.len, 32)),
+                .bssid = ap.bssid,
+                .channel = ap.channel,
+                .rssi = rssi,
+                .auth_mode = ap.auth_mode,
+            };
+            @memcpy(info.ssid[0..info.ssid_len], ap.ssid[0..info.ssid_len]);
+            self.push(.{ .scan_result = info });
+        }
+        self.push(.{ .scan_done = .{ .success = true } });
+    }
+
+    fn push(self: *Self, event: WifiEvent) void {
+        if (self.len == queue_len) return;
+        self.events[(self.head + self.len) % queue_len] = event;
+        self.len += 1;
+    }
+};
@@ -7,6 +7,8 @@
 //! Communication:
 //!   JS → Zig: webview_bind callbacks (button presses, ADC values, mic data)
 //!   Zig → JS: webview_eval / webview_dispatch (LED state, logs, display, status)
+//!   Display + audio: binary WebSocket at /ws on the localhost server
+//!     (see transport.zig); the base64 bindings remain as a fallback
 //!
 //! ## Usage (in app's main.zig)
 //!
@@ -22,6 +24,7 @@
 const std = @import("std");
 const state_mod = @import("../impl/state.zig");
 pub const recorder_mod = @import("recorder.zig");
+pub const transport = @import("transport.zig");
 
 const shared = &state_mod.state;
 const Recorder = recorder_mod.Recorder;
@@ -205,11 +208,24 @@ fn httpServeLoop() void {
             std.Thread.sleep(10 * std.time.ns_per_ms);
             continue;
         };
-        defer conn.stream.close();
 
         // Read request
         var req_buf: [4096]u8 = undefined;
-        _ = conn.stream.read(&req_buf) catch continue;
+        const req_len = conn.stream.read(&req_buf) catch {
+            conn.stream.close();
+            continue;
+        };
+
+        // Binary display/audio transport: hand the socket to its own thread
+        if (transport.upgradeKey(req_buf[0..req_len])) |key| {
+            if (std.Thread.spawn(.{}, transport.serve, .{ conn.stream, key, transport.Config{} })) |t| {
+                t.detach();
+            } else |_| {
+                conn.stream.close();
+            }
+            continue;
+        }
+        defer conn.stream.close();
 
         // Respond with HTML
         var hdr_buf: [256]u8 = undefined;
@@ -0,0 +1,370 @@
+//! WebSim Binary Transport — framebuffer and PCM over a binary WebSocket.
+//!
+//! Replaces the base64-JSON polling path (zigGetDisplayFrame,
+//! zigPullAudioOut, zigPushAudioBatch) for the native launcher. The page
+//! opens `ws://127.0.0.1:<port>/ws` on the same localhost server that
+//! serves the HTML; the transport thread pushes dirty display rows and
+//! speaker PCM as soon as they appear and accepts mic PCM back.
+//!
+//! Wire format (little-endian), one WebSocket binary message each:
+//!
+//! ```
+//! header (16 B)   kind:u8 flags:u8 reserved:u16 seq:u32 time_us:u64
+//! frame  kind=1   width:u16 height:u16 y1:u16 rows:u16, rows*width RGB565
+//! audio  kind=2   sample_rate:u32 first_sample:u32 count:u32, count i16
+//! mic    kind=3   (page → sim) count i16
+//! ```
+//!
+//! `seq` increases per kind; the page drops anything older than what it has
+//! already applied. `first_sample` is the speaker ring position of the first
+//! sample, so gaps are visible to the page.
+//!
+//! Double buffering: the app thread flushes into `SharedState.display_fb`
+//! under a seqlock while the transport copies only the rows flushed since
+//! the last message into its own staging buffer (`displaySnapshot`) and
+//! sends from there, so the app never waits on the socket.
+//!
+//! While a page is connected the transport owns the speaker read cursor;
+//! pages must not also call zigPullAudioOut.
+
+const std = @import("std");
+const state_mod = @import("../impl/state.zig");
+
+const shared = &state_mod.state;
+
+pub const Kind = enum(u8) {
+    frame = 1,
+    audio = 2,
+    mic = 3,
+};
+
+pub const HEADER_SIZE = 16;
+pub const FRAME_INFO_SIZE = 8;
+pub const AUDIO_INFO_SIZE = 12;
+/// Largest WebSocket frame header (server frames are unmasked)
+pub const WS_HEADER_MAX = 10;
+pub const MAX_MESSAGE_SIZE = HEADER_SIZE + FRAME_INFO_SIZE + state_mod.MAX_DISPLAY_FB_SIZE;
+
+/// Path the page connects to
+pub const PATH = "/ws";
+
+pub const Config = struct {
+    /// Speaker sample rate reported to the page
+    sample_rate: u32 = 16000,
+    /// Minimum samples per audio message (160 = 10ms @ 16kHz)
+    audio_chunk: u32 = 160,
+    /// Sleep between polls when there is nothing to send
+    poll_us: u32 = 1000,
+};
+
+pub const Header = struct {
+    kind: Kind,
+    seq: u32,
+    time_us: u64,
+};
+
+pub const FrameInfo = struct {
+    width: u16,
+    height: u16,
+    y1: u16,
+    rows: u16,
+};
+
+pub const AudioInfo = struct {
+    sample_rate: u32,
+    first_sample: u32,
+    count: u32,
+};
+
+// ============================================================================
+// Encoder
+// ============================================================================
+
+/// Builds ready-to-send WebSocket frames in one buffer. The message body is
+/// written at `WS_HEADER_MAX` and the WebSocket header is placed directly in
+/// front of it, so each message is a single contiguous write.
+pub const Encoder = struct {
+    buf: []u8,
+    frame_seq: u32 = 0,
+    audio_seq: u32 = 0,
+    /// display_flush_count of the last frame sent
+    last_flush: u32 = 0,
+
+    const Self = @This();
+
+    /// `buf` must hold WS_HEADER_MAX + MAX_MESSAGE_SIZE bytes
+    pub fn init(buf: []u8) Self {
+        std.debug.assert(buf.len >= WS_HEADER_MAX + MAX_MESSAGE_SIZE);
+        return .{ .buf = buf };
+    }
+
+    /// Encode display rows flushed since the last call, or null if none.
+    pub fn encodeFrame(self: *Self, state: *const state_mod.SharedState, now_us: u64) ?[]const u8 {
+        const body = self.buf[WS_HEADER_MAX..];
+        const pixels = body[HEADER_SIZE + FRAME_INFO_SIZE ..];
+        const snap = state.displaySnapshot(self.last_flush, pixels) orelse return null;
+        self.last_flush = snap.flush_count;
+
+        const rows = snap.y2 - snap.y1 + 1;
+        const len = HEADER_SIZE + FRAME_INFO_SIZE + @as(usize, rows) * snap.width * state_mod.DISPLAY_BPP;
+        self.frame_seq +%= 1;
+        writeHeader(body, .frame, self.frame_seq, now_us);
+        const info = body[HEADER_SIZE..];
+        std.mem.writeInt(u16, info[0..2], snap.width, .little);
+        std.mem.writeInt(u16, info[2..4], snap.height, .little);
+        std.mem.writeInt(u16, info[4..6], snap.y1, .little);
+        std.mem.writeInt(u16, info[6..8], rows, .little);
+        return self.wrap(len);
+    }
+
+    /// Encode pending speaker samples (at least `cfg.audio_chunk`, at most
+    /// what fits), advancing the ring read cursor. Null if not enough yet.
+    pub fn encodeAudio(self: *Self, state: *state_mod.SharedState, cfg: Config, now_us: u64) ?[]const u8 {
+        const write_pos = @atomicLoad(u32, &state.audio_out_write, .acquire);
+        const read_pos = state.audio_out_read;
+        const avail = write_pos -% read_pos;
+        if (avail == 0 or avail < cfg.audio_chunk) return null;
+        const count = @min(avail, state_mod.AUDIO_BUF_SAMPLES);
+
+        const body = self.buf[WS_HEADER_MAX..];
+        const samples = body[HEADER_SIZE + AUDIO_INFO_SIZE ..];
+        for (0..count) |i| {
+            const s = state.audio_out_buf[(read_pos +% @as(u32, @intCast(i))) & state_mod.AUDIO_BUF_MASK];
+            std.mem.writeInt(i16, samples[i * 2 ..][0..2], s, .little);
+        }
+        @atomicStore(u32, &state.audio_out_read, read_pos +% count, .release);
+
+        self.audio_seq +%= 1;
+        writeHeader(body, .audio, self.audio_seq, now_us);
+        const info = body[HEADER_SIZE..];
+        std.mem.writeInt(u32, info[0..4], cfg.sample_rate, .little);
+        std.mem.writeInt(u32, info[4..8], read_pos, .little);
+        std.mem.writeInt(u32, info[8..12], count, .little);
+        return self.wrap(HEADER_SIZE + AUDIO_INFO_SIZE + @as(usize, count) * 2);
+    }
+
+    fn wrap(self: *Self, body_len: usize) []const u8 {
+        var hdr: [WS_HEADER_MAX]u8 = undefined;
+        const hdr_len = wsHeader(&hdr, 0x2, body_len);
+        const start = WS_HEADER_MAX - hdr_len;
+        @memcpy(self.buf[start..WS_HEADER_MAX], hdr[0..hdr_len]);
+        return self.buf[start .. WS_HEADER_MAX + body_len];
+    }
+};
+
+fn writeHeader(body: []u8, kind: Kind, seq: u32, time_us: u64) void {
+    body[0] = @intFromEnum(kind);
+    body[1] = 0;
+    std.mem.writeInt(u16, body[2..4], 0, .little);
+    std.mem.writeInt(u32, body[4..8], seq, .little);
+    std.mem.writeInt(u64, body[8..16], time_us, .little);
+}
+
+pub fn parseHeader(msg: []const u8) ?Header {
+    if (msg.len < HEADER_SIZE) return null;
+    const kind = std.meta.intToEnum(Kind, msg[0]) catch return null;
+    return .{
+        .kind = kind,
+        .seq = std.mem.readInt(u32, msg[4..8], .little),
+        .time_us = std.mem.readInt(u64, msg[8..16], .little),
+    };
+}
+
+pub fn parseFrameInfo(msg: []const u8) ?FrameInfo {
+    if (msg.len < HEADER_SIZE + FRAME_INFO_SIZE) return null;
+    const info = msg[HEADER_SIZE..];
+    return .{
+        .width = std.mem.readInt(u16, info[0..2], .little),
+        .height = std.mem.readInt(u16, info[2..4], .little),
+        .y1 = std.mem.readInt(u16, info[4..6], .little),
+        .rows = std.mem.readInt(u16, info[6..8], .little),
+    };
+}
+
+pub fn parseAudioInfo(msg: []const u8) ?AudioInfo {
+    if (msg.len < HEADER_SIZE + AUDIO_INFO_SIZE) return null;
+    const info = msg[HEADER_SIZE..];
+    return .{
+        .sample_rate = std.mem.readInt(u32, info[0..4], .little),
+        .first_sample = std.mem.readInt(u32, info[4..8], .little),
+        .count = std.mem.readInt(u32, info[8..12], .little),
+    };
+}
+
+// ============================================================================
+// WebSocket framing (RFC 6455, binary messages only)
+// ============================================================================
+
+const WS_GUID = "258EAFA5-E914-47DA-95CA-C5AB0DC85B11";
+
+/// Length of a Sec-WebSocket-Key (base64 of a 16-byte nonce)
+pub const KEY_LEN = 24;
+
+/// Returns the Sec-WebSocket-Key if `request` is a WebSocket upgrade for PATH.
+pub fn upgradeKey(request: []const u8) ?[KEY_LEN]u8 {
+    if (!std.mem.startsWith(u8, request, "GET " ++ PATH ++ " ")) return null;
+    var lines = std.mem.splitSequence(u8, request, "\r\n");
+    _ = lines.next();
+    while (lines.next()) |line| {
+        if (line.len == 0) break;
+        const colon = std.mem.indexOfScalar(u8, line, ':') orelse continue;
+        if (!std.ascii.eqlIgnoreCase(line[0..colon], "Sec-WebSocket-Key")) continue;
+        const value = std.mem.trim(u8, line[colon + 1 ..], " \t");
+        if (value.len != KEY_LEN) return null;
+        return value[0..KEY_LEN].*;
+    }
+    return null;
+}
+
+/// Sec-WebSocket-Accept value for `key`
+pub fn acceptKey(key: []const u8) [28]u8 {
+    var sha = std.crypto.hash.Sha1.init(.{});
+    sha.update(key);
+    sha.update(WS_GUID);
+    var digest: [20]u8 = undefined;
+    sha.final(&digest);
+    var out: [28]u8 = undefined;
+    _ = std.base64.standard.Encoder.encode(&out, &digest);
+    return out;
+}
+
+pub fn writeHandshake(stream: std.net.Stream, key: []const u8) !void {
+    var buf: [160]u8 = undefined;
+    const resp = try std.fmt.bufPrint(&buf, "HTTP/1.1 101 Switching Protocols\r\n" ++
+        "Upgrade: websocket\r\nConnection: Upgrade\r\nSec-WebSocket-Accept: {s}\r\n\r\n", .{&acceptKey(key)});
+    try stream.writeAll(resp);
+}
+
+/// Write an unmasked frame header (FIN set) into `out`, returning its length.
+fn wsHeader(out: *[WS_HEADER_MAX]u8, opcode: u8, len: usize) usize {
+    out[0] = 0x80 | opcode;
+    if (len < 126) {
+        out[1] = @intCast(len);
+        return 2;
+    }
+    if (len <= 0xFFFF) {
+        out[1] = 126;
+        std.mem.writeInt(u16, out[2..4], @intCast(len), .big);
+        return 4;
+    }
+    out[1] = 127;
+    std.mem.writeInt(u64, out[2..10], len, .big);
+    return 10;
+}
+
+pub const Message = struct {
+    opcode: u8,
+    payload: []u8,
+};
+
+/// Read one WebSocket frame into `buf`, unmasking client frames.
+/// Fragmented messages are not used by either side and are rejected.
+pub fn readMessage(stream: std.net.Stream, buf: []u8) !Message {
+    var hdr: [2]u8 = undefined;
+    try readExact(stream, &hdr);
+    if (hdr[0] & 0x80 == 0) return error.Fragmented;
+    const opcode = hdr[0] & 0x0F;
+    const masked = hdr[1] & 0x80 != 0;
+
+    var len: u64 = hdr[1] & 0x7F;
+    if (len == 126) {
+        var ext: [2]u8 = undefined;
+        try readExact(stream, &ext);
+        len = std.mem.readInt(u16, &ext, .big);
+    } else if (len == 127) {
+        var ext: [8]u8 = undefined;
+        try readExact(stream, &ext);
+        len = std.mem.readInt(u64, &ext, .big);
+    }
+    if (len > buf.len) return error.MessageTooLarge;
+
+    var mask: [4]u8 = .{ 0, 0, 0, 0 };
+    if (masked) try readExact(stream, &mask);
+    const payload = buf[0..@intCast(len)];
+    try readExact(stream, payload);
+    if (masked) {
+        for (payload, 0..) |*b, i| b.* ^= mask[i & 3];
+    }
+    return .{ .opcode = opcode, .payload = payload };
+}
+
+fn readExact(stream: std.net.Stream, buf: []u8) !void {
+    var off: usize = 0;
+    while (off < buf.len) {
+        const n = try stream.read(buf[off..]);
+        if (n == 0) return error.Closed;
+        off += n;
+    }
+}
+
+// ============================================================================
+// Session
+// ============================================================================
+
+/// Serve one upgraded connection until the page disconnects or the
+/// simulator stops. Takes ownership of `stream`.
+pub fn serve(stream: std.net.Stream, key: [KEY_LEN]u8, cfg: Config) void {
+    defer stream.close();
+    writeHandshake(stream, &key) catch return;
+
+    const alloc = std.heap.page_allocator;
+    const buf = alloc.alloc(u8, WS_HEADER_MAX + MAX_MESSAGE_SIZE) catch return;
+    defer alloc.free(buf);
+
+    var closed = std.atomic.Value(bool).init(false);
+    const reader = std.Thread.spawn(.{}, readLoop, .{ stream, &closed }) catch return;
+    defer {
+        closed.store(true, .release);
+        std.posix.shutdown(stream.handle, .both) catch {};
+        reader.join();
+    }
+
+    // Start the new page from a full frame (no row is newer than a future
+    // flush count, so displaySnapshot falls back to the whole screen) and
+    // only fresh audio
+    var enc = Encoder.init(buf);
+    enc.last_flush = shared.display_flush_count +% 1;
+    shared.audio_out_read = @atomicLoad(u32, &shared.audio_out_write, .acquire);
+
+    var timer = std.time.Timer.start() catch return;
+    while (shared.running and !closed.load(.acquire)) {
+        var sent = false;
+        const now_us = timer.read() / std.time.ns_per_us;
+        if (enc.encodeAudio(shared, cfg, now_us)) |msg| {
+            stream.writeAll(msg) catch return;
+            sent = true;
+        }
+        if (enc.encodeFrame(shared, now_us)) |msg| {
+            stream.writeAll(msg) catch return;
+            sent = true;
+        }
+        if (!sent) std.Thread.sleep(@as(u64, cfg.poll_us) * std.time.ns_per_us);
+    }
+}
+
+fn readLoop(stream: std.net.Stream, closed: *std.atomic.Value(bool)) void {
+    var buf: [8192]u8 = undefined;
+    while (!closed.load(.acquire)) {
+        const msg = readMessage(stream, &buf) catch break;
+        switch (msg.opcode) {
+            0x2 => pushMic(msg.payload),
+            0x8 => break,
+            else => {},
+        }
+    }
+    closed.store(true, .release);
+}
+
+/// Append a mic message (kind=3) to the input ring, dropping on overflow.
+fn pushMic(payload: []const u8) void {
+    const hdr = parseHeader(payload) orelse return;
+    if (hdr.kind != .mic) return;
+    const data = payload[HEADER_SIZE..];
+    var i: usize = 0;
+    while (i + 1 < data.len) : (i += 2) {
+        const read_pos = @atomicLoad(u32, &shared.audio_in_read, .acquire);
+        if (shared.audio_in_write -% read_pos >= state_mod.AUDIO_BUF_SAMPLES) break;
+        shared.audio_in_buf[shared.audio_in_write & state_mod.AUDIO_BUF_MASK] = std.mem.readInt(i16, data[i..][0..2], .little);
+        @atomicStore(u32, &shared.audio_in_write, shared.audio_in_write +% 1, .release);
+    }
+}
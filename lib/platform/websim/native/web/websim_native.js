@@ -6,12 +6,14 @@
  *
  * Standard element IDs (all optional — features auto-detect):
  *   #status           — status badge
- *   #displayCanvas    — LVGL display (RGB565)
+ *   #displayCanvas    — LVGL display (RGB565, streamed over the /ws
+ *                       binary transport when served from localhost)
  *   #ledGlowCanvas    — LED glow rendering canvas
  *   #ledContainer     — LED DOM container (fallback if no glow canvas)
  *   .adc-btn          — ADC buttons (data-adc="200" etc.)
  *   #btnPower         — power button
  *   #btnBoot          — boot button
+ *   #micToggleBtn     — microphone on/off (streamed over /ws)
  *   #logContent       — log output area
  *   #logClear         — clear log button
  *   #logCopy          — copy log button
@@ -27,6 +29,8 @@ const WebSim = (() => {
     // ========================================================================
     let canvasCtx = null, imageData = null;
 
+    let frameSeq = 0, paintedSeq = 0;
+
     function initDisplay() {
         const c = document.getElementById('displayCanvas');
         if (!c) return;
@@ -34,6 +38,144 @@ const WebSim = (() => {
         imageData = canvasCtx.createImageData(c.width, c.height);
     }
 
+    // Apply dirty rows (RGB565) into the back image; painted on next rAF.
+    function applyFrame(view, bytes) {
+        if (!canvasCtx) return;
+        const width = view.getUint16(16, true), height = view.getUint16(18, true);
+        const y1 = view.getUint16(20, true), rows = view.getUint16(22, true);
+        const c = canvasCtx.canvas;
+        if (c.width !== width || c.height !== height) {
+            c.width = width; c.height = height;
+            imageData = canvasCtx.createImageData(width, height);
+        }
+        const px = new Uint16Array(bytes.buffer, bytes.byteOffset + 24, rows * width);
+        const out = imageData.data;
+        let o = y1 * width * 4;
+        for (let i = 0; i < px.length; i++, o += 4) {
+            const v = px[i];
+            out[o] = ((v >> 11) & 0x1F) * 255 / 31;
+            out[o + 1] = ((v >> 5) & 0x3F) * 255 / 63;
+            out[o + 2] = (v & 0x1F) * 255 / 31;
+            out[o + 3] = 255;
+        }
+    }
+
+    function paintDisplay() {
+        if (canvasCtx && frameSeq !== paintedSeq) {
+            canvasCtx.putImageData(imageData, 0, 0);
+            paintedSeq = frameSeq;
+        }
+    }
+
+    // ========================================================================
+    // Binary transport (display + audio over WebSocket, see transport.zig)
+    // ========================================================================
+    const MSG_FRAME = 1, MSG_AUDIO = 2, MSG_MIC = 3;
+    const MIC_RATE = 16000;
+    let ws = null, audioCtx = null, audioTime = 0, audioSeq = 0, micSeq = 0;
+
+    function initTransport() {
+        if (location.protocol !== 'http:' || typeof WebSocket === 'undefined') return;
+        ws = new WebSocket(`ws://${location.host}/ws`);
+        ws.binaryType = 'arraybuffer';
+        ws.onmessage = ev => {
+            const bytes = new Uint8Array(ev.data);
+            const view = new DataView(ev.data);
+            const seq = view.getUint32(4, true);
+            if (bytes[0] === MSG_FRAME) {
+                if (seq <= frameSeq && frameSeq - seq < 0x80000000) return; // stale
+                frameSeq = seq;
+                applyFrame(view, bytes);
+            } else if (bytes[0] === MSG_AUDIO) {
+                if (seq <= audioSeq && audioSeq - seq < 0x80000000) return;
+                audioSeq = seq;
+                playAudio(view, ev.data);
+            }
+        };
+        ws.onclose = () => { ws = null; };
+    }
+
+    // Schedule speaker PCM back-to-back, resyncing if playback fell behind.
+    function playAudio(view, buf) {
+        const rate = view.getUint32(16, true), count = view.getUint32(24, true);
+        if (!audioCtx) {
+            const Ctx = window.AudioContext || window.webkitAudioContext;
+            if (!Ctx) return;
+            audioCtx = new Ctx({ sampleRate: rate });
+        }
+        const pcm = new Int16Array(buf, 28, count);
+        const ab = audioCtx.createBuffer(1, count, rate);
+        const ch = ab.getChannelData(0);
+        for (let i = 0; i < count; i++) ch[i] = pcm[i] / 32768;
+        const src = audioCtx.createBufferSource();
+        src.buffer = ab;
+        src.connect(audioCtx.destination);
+        const now = audioCtx.currentTime;
+        if (audioTime < now + 0.005) audioTime = now + 0.02;
+        src.start(audioTime);
+        audioTime += count / rate;
+    }
+
+    /// Send mic PCM (Int16Array) to the simulator; false if not connected.
+    function sendMic(samples) {
+        if (!ws || ws.readyState !== WebSocket.OPEN) return false;
+        const msg = new Uint8Array(16 + samples.length * 2);
+        msg[0] = MSG_MIC;
+        new DataView(msg.buffer).setUint32(4, ++micSeq >>> 0, true);
+        new Int16Array(msg.buffer, 16).set(samples);
+        ws.send(msg.buffer);
+        return true;
+    }
+
+    // Microphone: #micToggleBtn captures at MIC_RATE and streams each
+    // ScriptProcessor block to the simulator with sendMic.
+    let micCtx = null, micStream = null, micNode = null;
+
+    function initMic() {
+        const btn = document.getElementById('micToggleBtn');
+        if (!btn || !ws || !navigator.mediaDevices) return;
+        btn.addEventListener('click', async () => {
+            if (micStream) {
+                stopMic();
+                btn.textContent = '\uD83C\uDF99 Mic Off';
+                btn.classList.remove('active');
+            } else if (await startMic()) {
+                btn.textContent = '\uD83C\uDF99 Mic On';
+                btn.classList.add('active');
+            }
+        });
+    }
+
+    async function startMic() {
+        try {
+            micStream = await navigator.mediaDevices.getUserMedia({ audio: { sampleRate: MIC_RATE, channelCount: 1, echoCancellation: true } });
+            const Ctx = window.AudioContext || window.webkitAudioContext;
+            if (!micCtx) micCtx = new Ctx({ sampleRate: MIC_RATE });
+            const source = micCtx.createMediaStreamSource(micStream);
+            micNode = micCtx.createScriptProcessor(1024, 1, 1);
+            micNode.onaudioprocess = e => {
+                const input = e.inputBuffer.getChannelData(0);
+                const pcm = new Int16Array(input.length);
+                for (let i = 0; i < input.length; i++) {
+                    pcm[i] = Math.max(-32768, Math.min(32767, Math.round(input[i] * 32768)));
+                }
+                sendMic(pcm);
+            };
+            source.connect(micNode);
+            micNode.connect(micCtx.destination); // Required for processing (output is silent)
+            return true;
+        } catch (e) {
+            console.warn('WebSim: Mic access failed:', e);
+            stopMic();
+            return false;
+        }
+    }
+
+    function stopMic() {
+        if (micNode) { micNode.disconnect(); micNode = null; }
+        if (micStream) { micStream.getTracks().forEach(t => t.stop()); micStream = null; }
+    }
+
     // ========================================================================
     // LED Glow (canvas-based diffuse light)
     // ========================================================================
@@ -296,6 +438,7 @@ const WebSim = (() => {
 
     async function frame() {
         if (!running) return;
+        paintDisplay();
         try {
             const state = await zigGetState();
             if (state) {
@@ -320,6 +463,8 @@ const WebSim = (() => {
             const status = document.getElementById('status');
 
             initDisplay();
+            initTransport();
+            initMic();
             initGlow();
             initLog();
             initInput();
@@ -329,7 +474,9 @@ const WebSim = (() => {
             running = true;
             if (status) { status.textContent = 'Running'; status.classList.add('running'); }
             requestAnimationFrame(frame);
-        }
+        },
+
+        sendMic,
     };
 })();
 
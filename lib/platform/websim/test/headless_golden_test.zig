@@ -0,0 +1,67 @@
+//! Headless runner against a checked-in golden transcript.
+//!
+//! A small app logs and lights the LED on button edges and sleeps inside
+//! the press handler. The transcript must match golden/button.golden line
+//! for line, including timestamps taken from the virtual clock after the
+//! sleep.
+
+const std = @import("std");
+const websim = @import("websim");
+const testing = std.testing;
+
+const shared = &websim.state_mod.state;
+const Color = websim.state_mod.Color;
+
+const App = struct {
+    var was_down = false;
+
+    pub fn init() void {
+        was_down = false;
+    }
+
+    pub fn step() void {
+        const down = shared.button_pressed;
+        if (down == was_down) return;
+        was_down = down;
+        shared.addLog(if (down) "BTN down" else "BTN up");
+        shared.led_colors[0] = if (down) Color.red else Color.black;
+        // Like sal.time.sleepMs(40) in a press handler
+        if (down) shared.advanceTime(40);
+    }
+};
+
+test "transcript matches the golden file" {
+    const golden = @embedFile("golden/button.golden");
+
+    var tmp = testing.tmpDir(.{});
+    defer tmp.cleanup();
+    try tmp.dir.writeFile(.{ .sub_path = "button.golden", .data = golden });
+    const dir = try tmp.dir.realpathAlloc(testing.allocator, ".");
+    defer testing.allocator.free(dir);
+    const golden_path = try std.fs.path.join(testing.allocator, &.{ dir, "button.golden" });
+    defer testing.allocator.free(golden_path);
+
+    const report = try websim.headless.run(App, .{
+        .trace = @embedFile("golden/button.trace"),
+        .out_dir = dir,
+        .golden_path = golden_path,
+        .allocator = testing.allocator,
+    });
+
+    const transcript = try tmp.dir.readFileAlloc(testing.allocator, "transcript.txt", 1 << 20);
+    defer testing.allocator.free(transcript);
+    try testing.expectEqualStrings(golden, transcript);
+    try testing.expectEqual(@as(?usize, null), report.golden_mismatch_line);
+
+    // 0..112 in 16 ms steps, one 40 ms step, then 152..296
+    try testing.expectEqual(@as(u64, 18), report.steps);
+    try testing.expectEqual(@as(u64, 312), report.virtual_ms);
+    try testing.expectEqual(@as(u32, 2), report.log_lines);
+}
+
+test "trace parser rejects time going backwards" {
+    var parser = websim.headless.trace.Parser.init("100 button down\n50 button up\n");
+    _ = try parser.next();
+    try testing.expectError(error.TimeWentBackwards, parser.next());
+    try testing.expectEqual(@as(u32, 2), parser.line_no);
+}
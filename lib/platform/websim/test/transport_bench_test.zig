@@ -0,0 +1,239 @@
+//! WebSim binary transport benchmark — delivered FPS, speaker and mic latency.
+//!
+//! Runs the native /ws transport over loopback against a minimal WebSocket
+//! client. A producer thread flushes full frames as fast as it can,
+//! writes 10ms speaker chunks on a fixed cadence and drains the mic ring;
+//! the client counts frames, measures write→receive latency per speaker
+//! chunk, and sends 10ms mic chunks (as the page's sendMic does) whose
+//! send→ring latency the producer records. The base64 encode cost of one
+//! frame (the old zigGetDisplayFrame path) is printed for comparison.
+
+const std = @import("std");
+const websim = @import("websim");
+const print = std.debug.print;
+const testing = std.testing;
+
+const transport = websim.native.transport;
+const state_mod = websim.state_mod;
+const shared = &state_mod.state;
+
+const RUN_MS = 2000;
+const AUDIO_CHUNK = 160; // 10ms @ 16kHz
+const MAX_CHUNKS = RUN_MS / 10 + 16;
+
+/// Producer timestamp per audio chunk, indexed by ring position / AUDIO_CHUNK
+var chunk_write_ns: [MAX_CHUNKS]i128 = undefined;
+/// Client send and simulator receive timestamps per mic chunk
+var mic_send_ns: [MAX_CHUNKS]i128 = undefined;
+var mic_recv_ns: [MAX_CHUNKS]i128 = undefined;
+var mic_chunks_sent: u32 = 0;
+var mic_chunks_received: u32 = 0;
+
+fn serveOne(server: *std.net.Server) void {
+    const conn = server.accept() catch return;
+    var req: [1024]u8 = undefined;
+    const n = conn.stream.read(&req) catch {
+        conn.stream.close();
+        return;
+    };
+    const key = transport.upgradeKey(req[0..n]) orelse {
+        conn.stream.close();
+        return;
+    };
+    transport.serve(conn.stream, key, .{ .audio_chunk = AUDIO_CHUNK });
+}
+
+fn produce(width: u16, height: u16, frames_flushed: *u32) void {
+    const alloc = std.heap.page_allocator;
+    const px = alloc.alloc(u8, @as(usize, width) * height * 2) catch return;
+    defer alloc.free(px);
+
+    const start = std.time.nanoTimestamp();
+    var next_audio = start;
+    var chunk: u32 = 0;
+    var tone: [AUDIO_CHUNK]i16 = undefined;
+    for (&tone, 0..) |*s, i| s.* = @intCast(@as(i32, @intCast(i % 32)) * 512 - 8192);
+    var mic: [AUDIO_CHUNK]i16 = undefined;
+    var mic_samples: u64 = 0;
+
+    while (std.time.nanoTimestamp() - start < RUN_MS * std.time.ns_per_ms) {
+        const now = std.time.nanoTimestamp();
+        if (now >= next_audio and chunk < MAX_CHUNKS) {
+            chunk_write_ns[chunk] = now;
+            _ = shared.audioOutWrite(&tone);
+            chunk += 1;
+            next_audio += 10 * std.time.ns_per_ms;
+        }
+        // Mic: timestamp each chunk once all of its samples are in the ring
+        mic_samples += shared.audioInRead(&mic);
+        while (mic_chunks_received < MAX_CHUNKS and (mic_chunks_received + 1) * AUDIO_CHUNK <= mic_samples) {
+            mic_recv_ns[mic_chunks_received] = std.time.nanoTimestamp();
+            mic_chunks_received += 1;
+        }
+
+        @memset(px, @truncate(frames_flushed.*));
+        shared.displayFlush(0, 0, width - 1, height - 1, px.ptr);
+        frames_flushed.* += 1;
+        std.Thread.sleep(std.time.ns_per_ms);
+    }
+    shared.running = false;
+}
+
+fn connect(port: u16) !std.net.Stream {
+    const stream = try std.net.tcpConnectToAddress(std.net.Address.initIp4(.{ 127, 0, 0, 1 }, port));
+    errdefer stream.close();
+    try stream.writeAll("GET /ws HTTP/1.1\r\nHost: 127.0.0.1\r\nUpgrade: websocket\r\nConnection: Upgrade\r\n" ++
+        "Sec-WebSocket-Key: dGhlIHNhbXBsZSBub25jZQ==\r\nSec-WebSocket-Version: 13\r\n\r\n");
+
+    // Response headers end with an empty line
+    var tail: [4]u8 = .{ 0, 0, 0, 0 };
+    var status: [12]u8 = undefined;
+    var i: usize = 0;
+    while (!std.mem.eql(u8, &tail, "\r\n\r\n")) : (i += 1) {
+        var b: [1]u8 = undefined;
+        if (try stream.read(&b) == 0) return error.Closed;
+        if (i < status.len) status[i] = b[0];
+        std.mem.copyForwards(u8, tail[0..3], tail[1..4]);
+        tail[3] = b[0];
+    }
+    if (!std.mem.eql(u8, &status, "HTTP/1.1 101")) return error.HandshakeFailed;
+    return stream;
+}
+
+/// Send 10ms mic chunks for the run, framed like the page's sendMic.
+/// Client frames must be masked; an all-zero key leaves the payload as is.
+fn sendMic(stream: std.net.Stream) void {
+    const body_len = transport.HEADER_SIZE + AUDIO_CHUNK * 2;
+    var msg: [4 + 4 + body_len]u8 = undefined;
+    msg[0] = 0x82;
+    msg[1] = 0x80 | 126;
+    std.mem.writeInt(u16, msg[2..4], body_len, .big);
+    @memset(msg[4..8], 0);
+    const body = msg[8..];
+    body[0] = @intFromEnum(transport.Kind.mic);
+    @memset(body[1..transport.HEADER_SIZE], 0);
+    for (0..AUDIO_CHUNK) |i| std.mem.writeInt(i16, body[transport.HEADER_SIZE + i * 2 ..][0..2], @intCast(i), .little);
+
+    const start = std.time.nanoTimestamp();
+    while (mic_chunks_sent < MAX_CHUNKS and std.time.nanoTimestamp() - start < RUN_MS * std.time.ns_per_ms) {
+        std.mem.writeInt(u32, body[4..8], mic_chunks_sent + 1, .little);
+        mic_send_ns[mic_chunks_sent] = std.time.nanoTimestamp();
+        stream.writeAll(&msg) catch return;
+        mic_chunks_sent += 1;
+        std.Thread.sleep(10 * std.time.ns_per_ms);
+    }
+}
+
+fn lessThan(_: void, a: u64, b: u64) bool {
+    return a < b;
+}
+
+fn benchResolution(width: u16, height: u16) !void {
+    shared.* = .{};
+    shared.display_width = width;
+    shared.display_height = height;
+
+    var server = try std.net.Address.initIp4(.{ 127, 0, 0, 1 }, 0).listen(.{ .reuse_address = true });
+    defer server.deinit();
+    const srv = try std.Thread.spawn(.{}, serveOne, .{&server});
+    defer srv.join();
+
+    const stream = try connect(server.listen_address.getPort());
+    defer stream.close();
+
+    mic_chunks_sent = 0;
+    mic_chunks_received = 0;
+    const mic_sender = try std.Thread.spawn(.{}, sendMic, .{stream});
+    var mic_joined = false;
+    defer if (!mic_joined) mic_sender.join();
+
+    var flushed: u32 = 0;
+    const producer = try std.Thread.spawn(.{}, produce, .{ width, height, &flushed });
+    var producer_joined = false;
+    defer if (!producer_joined) producer.join();
+
+    const alloc = testing.allocator;
+    const buf = try alloc.alloc(u8, transport.MAX_MESSAGE_SIZE);
+    defer alloc.free(buf);
+    var latencies: std.ArrayList(u64) = .empty;
+    defer latencies.deinit(alloc);
+
+    var frames: u32 = 0;
+    var frame_bytes: u64 = 0;
+    var last_seq: u32 = 0;
+    const start = std.time.nanoTimestamp();
+    while (true) {
+        const msg = transport.readMessage(stream, buf) catch break;
+        const now = std.time.nanoTimestamp();
+        const hdr = transport.parseHeader(msg.payload) orelse continue;
+        switch (hdr.kind) {
+            .frame => {
+                try testing.expect(hdr.seq == last_seq + 1);
+                last_seq = hdr.seq;
+                frames += 1;
+                frame_bytes += msg.payload.len;
+            },
+            .audio => {
+                const info = transport.parseAudioInfo(msg.payload).?;
+                const idx = info.first_sample / AUDIO_CHUNK;
+                if (idx < MAX_CHUNKS) try latencies.append(alloc, @intCast(now - chunk_write_ns[idx]));
+            },
+            .mic => {},
+        }
+    }
+    const elapsed_ms: u64 = @intCast(@divTrunc(std.time.nanoTimestamp() - start, std.time.ns_per_ms));
+
+    // Old path: base64 of the full framebuffer per frame
+    const fb_bytes = @as(usize, width) * height * 2;
+    const b64 = try alloc.alloc(u8, std.base64.standard.Encoder.calcSize(fb_bytes));
+    defer alloc.free(b64);
+    var timer = try std.time.Timer.start();
+    for (0..20) |_| _ = std.base64.standard.Encoder.encode(b64, shared.display_fb[0..fb_bytes]);
+    const b64_us = timer.read() / 20 / std.time.ns_per_us;
+
+    try testing.expect(frames > 0);
+    try testing.expect(latencies.items.len > 0);
+    std.mem.sort(u64, latencies.items, {}, lessThan);
+    const lat = latencies.items;
+    var sum: u64 = 0;
+    for (lat) |l| sum += l;
+
+    const fps = if (elapsed_ms > 0) @as(u64, frames) * 1000 / elapsed_ms else 0;
+    const mb_per_s = if (elapsed_ms > 0) frame_bytes * 1000 / elapsed_ms / (1024 * 1024) else 0;
+    print("\n[bench] websim transport {d}x{d}: {d} frames delivered of {d} flushed in {d}ms, {d} fps, {d} MB/s\n", .{
+        width, height, frames, flushed, elapsed_ms, fps, mb_per_s,
+    });
+    print("[bench]   audio latency over {d} chunks: avg={d}us p50={d}us p99={d}us max={d}us\n", .{
+        lat.len,
+        sum / lat.len / std.time.ns_per_us,
+        lat[lat.len / 2] / std.time.ns_per_us,
+        lat[lat.len * 99 / 100] / std.time.ns_per_us,
+        lat[lat.len - 1] / std.time.ns_per_us,
+    });
+    // Mic: chunks the producer saw before the run ended
+    producer.join();
+    producer_joined = true;
+    mic_sender.join();
+    mic_joined = true;
+    const mic_n = @min(mic_chunks_received, mic_chunks_sent);
+    try testing.expect(mic_n > 0);
+    var mic_lat: [MAX_CHUNKS]u64 = undefined;
+    for (mic_lat[0..mic_n], 0..) |*l, i| l.* = @intCast(@max(0, mic_recv_ns[i] - mic_send_ns[i]));
+    std.mem.sort(u64, mic_lat[0..mic_n], {}, lessThan);
+    print("[bench]   mic latency over {d} of {d} chunks: p50={d}us p99={d}us max={d}us\n", .{
+        mic_n,
+        mic_chunks_sent,
+        mic_lat[mic_n / 2] / std.time.ns_per_us,
+        mic_lat[mic_n * 99 / 100] / std.time.ns_per_us,
+        mic_lat[mic_n - 1] / std.time.ns_per_us,
+    });
+    print("[bench]   base64 path reference: {d}us encode per full frame\n", .{b64_us});
+}
+
+test "BM1: binary transport 320x240" {
+    try benchResolution(320, 240);
+}
+
+test "BM2: binary transport 800x480" {
+    try benchResolution(800, 480);
+}
@@ -0,0 +1,238 @@
+//! WiFi connection manager on the simulated radio — reconnect time.
+//!
+//! Runs hal.wifi_manager against websim's SimWifiDriver on a virtual
+//! clock, pumped in 10ms steps the way a board loop would, through
+//! scenarios a device meets in the field: a transient drop, an AP outage,
+//! failover to a lower-priority network, roaming along an RSSI trace and
+//! a long stretch with no network at all. Each scenario prints the time
+//! from link loss (or roam decision) to connected again.
+
+const std = @import("std");
+const hal = @import("hal");
+const websim = @import("websim");
+const print = std.debug.print;
+const testing = std.testing;
+
+const Sim = websim.SimWifiDriver;
+const Wifi = hal.wifi.from(struct {
+    pub const Driver = Sim;
+    pub const meta = .{ .id = "wifi.sim" };
+});
+const Manager = hal.wifi_manager.Manager(Wifi);
+
+const STEP_MS = 10;
+const CONNECT_MS = 500;
+const SCAN_MS = 1_200;
+
+fn mac(last: u8) hal.wifi.Mac {
+    return .{ 0x02, 0x00, 0x00, 0x00, 0x00, last };
+}
+
+const Harness = struct {
+    radio: Sim,
+    wifi: Wifi,
+    mgr: Manager,
+    now: u64 = 0,
+
+    /// In place: the wrapper and manager keep pointers into the harness
+    fn init(self: *Harness, config: hal.wifi_manager.Config) void {
+        self.* = .{ .radio = Sim.init(.{}), .wifi = undefined, .mgr = undefined };
+        self.wifi = Wifi.init(&self.radio);
+        self.mgr = Manager.init(&self.wifi, config);
+    }
+
+    fn step(self: *Harness) void {
+        self.now += STEP_MS;
+        self.radio.advance(self.now);
+        while (self.wifi.pollEvent()) |event| self.mgr.handleEvent(event, self.now);
+        self.mgr.tick(self.now);
+    }
+
+    fn run(self: *Harness, ms: u64) void {
+        const end = self.now + ms;
+        while (self.now < end) self.step();
+    }
+
+    /// Steps until connected; returns the elapsed time
+    fn untilConnected(self: *Harness, max_ms: u64) !u64 {
+        const start = self.now;
+        while (self.now - start < max_ms) {
+            self.step();
+            if (self.mgr.phase() == .connected) return self.now - start;
+        }
+        return error.Timeout;
+    }
+
+    fn ssid(self: *Harness) []const u8 {
+        return self.radio.getSsid() orelse "";
+    }
+};
+
+const home = hal.wifi_manager.Network{ .ssid = "home", .password = "home-pass", .priority = 2 };
+const cafe = hal.wifi_manager.Network{ .ssid = "cafe", .password = "cafe-pass", .priority = 1 };
+
+test "initial connect takes the highest-priority network in range" {
+    var h: Harness = undefined;
+    h.init(.{ .networks = &.{ cafe, home } });
+    _ = h.radio.addAp(.{ .ssid = "cafe", .password = "cafe-pass", .bssid = mac(1), .rssi = -40 });
+    _ = h.radio.addAp(.{ .ssid = "home", .password = "home-pass", .bssid = mac(2), .rssi = -65 });
+
+    h.mgr.start(h.now);
+    const t = try h.untilConnected(10_000);
+    print("\n[wifi] initial connect: {d} ms\n", .{t});
+
+    try testing.expectEqualStrings("home", h.ssid());
+    try testing.expect(t <= SCAN_MS + CONNECT_MS + 2 * STEP_MS);
+}
+
+test "transient drop reconnects on the fast path without scanning" {
+    var h: Harness = undefined;
+    h.init(.{ .networks = &.{home} });
+    _ = h.radio.addAp(.{ .ssid = "home", .password = "home-pass", .bssid = mac(1) });
+    h.mgr.start(h.now);
+    _ = try h.untilConnected(10_000);
+    h.run(5_000);
+
+    const scans = h.radio.stats.scans;
+    h.radio.injectDisconnect();
+    _ = try h.untilConnected(10_000);
+    const s = h.mgr.stats();
+    print("[wifi] transient drop: reconnect {d} ms\n", .{s.last_reconnect_ms});
+
+    try testing.expectEqual(scans, h.radio.stats.scans);
+    try testing.expectEqual(@as(u32, 1), s.link_losses);
+    try testing.expect(s.last_reconnect_ms <= CONNECT_MS + 2 * STEP_MS);
+}
+
+test "AP outage backs off and reconnects soon after the AP returns" {
+    const backoff_max = 4_000;
+    const outages = [_]u64{ 2_000, 8_000, 30_000 };
+    print("[wifi] AP outage (backoff cap {d} ms):\n", .{backoff_max});
+
+    for (outages) |outage| {
+        var h: Harness = undefined;
+        h.init(.{ .networks = &.{home}, .backoff_max_ms = backoff_max, .seed = outage });
+        const ap = h.radio.addAp(.{ .ssid = "home", .password = "home-pass", .bssid = mac(1) });
+        h.mgr.start(h.now);
+        _ = try h.untilConnected(10_000);
+        h.run(1_000);
+
+        ap.present = false;
+        h.run(outage);
+        try testing.expect(h.mgr.phase() != .connected);
+        ap.present = true;
+        const after = try h.untilConnected(30_000);
+        const s = h.mgr.stats();
+        print("[wifi]   outage {d:>6} ms: reconnect {d:>6} ms ({d} ms after return), {d} scans\n", .{
+            outage, s.last_reconnect_ms, after, h.radio.stats.scans,
+        });
+
+        // Worst case: a full jittered backoff, then a scan and a connect
+        try testing.expect(after <= backoff_max * 5 / 4 + SCAN_MS + CONNECT_MS + 4 * STEP_MS);
+    }
+}
+
+test "lost network fails over to the next one" {
+    var h: Harness = undefined;
+    h.init(.{ .networks = &.{ home, cafe } });
+    const ap = h.radio.addAp(.{ .ssid = "home", .password = "home-pass", .bssid = mac(1) });
+    _ = h.radio.addAp(.{ .ssid = "cafe", .password = "cafe-pass", .bssid = mac(2), .rssi = -70 });
+    h.mgr.start(h.now);
+    _ = try h.untilConnected(10_000);
+    try testing.expectEqualStrings("home", h.ssid());
+
+    ap.present = false;
+    h.run(STEP_MS);
+    _ = try h.untilConnected(10_000);
+    const s = h.mgr.stats();
+    print("[wifi] failover home -> cafe: reconnect {d} ms\n", .{s.last_reconnect_ms});
+
+    try testing.expectEqualStrings("cafe", h.ssid());
+    // Fast retry on home fails, then a scan finds cafe
+    try testing.expect(s.last_reconnect_ms <= 2 * CONNECT_MS + SCAN_MS + 4 * STEP_MS);
+}
+
+test "wrong password moves on instead of retrying forever" {
+    var h: Harness = undefined;
+    h.init(.{ .networks = &.{ home, cafe } });
+    _ = h.radio.addAp(.{ .ssid = "home", .password = "changed", .bssid = mac(1) });
+    _ = h.radio.addAp(.{ .ssid = "cafe", .password = "cafe-pass", .bssid = mac(2), .rssi = -75 });
+    h.mgr.start(h.now);
+
+    const t = try h.untilConnected(20_000);
+    print("[wifi] auth failure on home, connected to cafe after {d} ms\n", .{t});
+    try testing.expectEqualStrings("cafe", h.ssid());
+    try testing.expectEqual(@as(u32, 2), h.mgr.stats().failures);
+}
+
+test "roams to a stronger AP as the current one fades" {
+    // Walking away from AP 1 towards AP 2 over 30s
+    const fade = [_]websim.wifi_sim.RssiPoint{
+        .{ .at_ms = 5_000, .rssi = -50 },
+        .{ .at_ms = 35_000, .rssi = -88 },
+    };
+    const rise = [_]websim.wifi_sim.RssiPoint{
+        .{ .at_ms = 5_000, .rssi = -80 },
+        .{ .at_ms = 35_000, .rssi = -50 },
+    };
+
+    var h: Harness = undefined;
+    h.init(.{ .networks = &.{home} });
+    _ = h.radio.addAp(.{ .ssid = "home", .password = "home-pass", .bssid = mac(1), .trace = &fade });
+    _ = h.radio.addAp(.{ .ssid = "home", .password = "home-pass", .bssid = mac(2), .trace = &rise });
+    h.mgr.start(h.now);
+    _ = try h.untilConnected(10_000);
+    try testing.expectEqual(mac(1), h.radio.getBssid().?);
+
+    h.run(40_000);
+    const s = h.mgr.stats();
+    print("[wifi] roam along RSSI trace: {d} roam(s), handover {d} ms, {d} link losses\n", .{
+        s.roams, s.last_roam_ms, s.link_losses,
+    });
+
+    try testing.expectEqual(hal.wifi_manager.Phase.connected, h.mgr.phase());
+    try testing.expectEqual(mac(2), h.radio.getBssid().?);
+    try testing.expectEqual(@as(u32, 1), s.roams);
+    try testing.expectEqual(@as(u32, 0), s.link_losses);
+    try testing.expect(s.last_roam_ms <= CONNECT_MS + 2 * STEP_MS);
+}
+
+test "no network in range: retries stay bounded by the backoff" {
+    var h: Harness = undefined;
+    h.init(.{ .networks = &.{home}, .backoff_initial_ms = 1_000, .backoff_max_ms = 16_000, .seed = 3 });
+    h.mgr.start(h.now);
+    h.run(120_000);
+
+    // Rounds 1+2+4+8+16 s, then one per 16 s, each plus a scan
+    const scans = h.radio.stats.scans;
+    print("[wifi] 120 s without a network: {d} scans, {d} connect attempts\n", .{ scans, h.radio.stats.connects });
+    try testing.expect(scans >= 8 and scans <= 14);
+    try testing.expectEqual(@as(u32, 0), h.radio.stats.connects);
+}
+
+test "power save deepens when idle and stays shallow on a weak link" {
+    const weak = [_]websim.wifi_sim.RssiPoint{
+        .{ .at_ms = 20_000, .rssi = -60 },
+        .{ .at_ms = 21_000, .rssi = -84 },
+    };
+
+    var h: Harness = undefined;
+    h.init(.{ .networks = &.{home}, .roam_rssi = -90 });
+    _ = h.radio.addAp(.{ .ssid = "home", .password = "home-pass", .bssid = mac(1), .trace = &weak });
+    h.mgr.start(h.now);
+    try testing.expectEqual(hal.wifi.PowerSaveMode.none, h.radio.getPowerSave());
+
+    _ = try h.untilConnected(10_000);
+    h.run(STEP_MS);
+    try testing.expectEqual(hal.wifi.PowerSaveMode.min_modem, h.radio.getPowerSave());
+
+    h.run(10_000);
+    try testing.expectEqual(hal.wifi.PowerSaveMode.max_modem, h.radio.getPowerSave());
+
+    h.mgr.activity(h.now);
+    h.run(STEP_MS);
+    try testing.expectEqual(hal.wifi.PowerSaveMode.min_modem, h.radio.getPowerSave());
+
+    h.run(12_000);
+    try testing.expectEqual(hal.wifi.PowerSaveMode.min_modem, h.radio.getPowerSave());
+}
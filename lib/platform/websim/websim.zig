@@ -29,12 +29,19 @@
 //! pub const time = websim.sal.time;
 //! pub const isRunning = websim.sal.isRunning;
 //! ```
+//!
+//! ## Headless (CI)
+//!
+//! `websim.headless.run(App, .{ .trace = ... })` runs the same app on a
+//! virtual clock driven by a scripted event trace and records frames, logs,
+//! LEDs and audio into a transcript for golden comparison.
 
 pub const drivers = @import("impl/drivers.zig");
 pub const state_mod = @import("impl/state.zig");
 pub const spi_sim = @import("impl/spi.zig");
 pub const kvs_mod = @import("impl/kvs.zig");
 pub const wifi_mod = @import("impl/wifi.zig");
+pub const wifi_sim = @import("impl/wifi_sim.zig");
 pub const net_mod = @import("impl/net.zig");
 pub const speaker_mod = @import("impl/speaker.zig");
 pub const mic_mod = @import("impl/mic.zig");
@@ -51,6 +58,10 @@ pub const native = if (builtin.target.cpu.arch == .wasm32)
     @compileError("native module not available on WASM target — use wasm module instead")
 else
     @import("native/native.zig");
+pub const headless = if (builtin.target.cpu.arch == .wasm32)
+    @compileError("headless runner not available on WASM target")
+else
+    @import("headless/headless.zig");
 pub const boards = @import("boards/boards.zig");
 pub const mirror_mod = @import("mirror.zig");
 
@@ -68,6 +79,7 @@ pub const AdcButtonDriver = drivers.AdcButtonDriver;
 pub const LedDriver = drivers.LedDriver;
 pub const KvsDriver = kvs_mod.KvsDriver;
 pub const WifiDriver = wifi_mod.WifiDriver;
+pub const SimWifiDriver = wifi_sim.SimWifiDriver;
 pub const NetDriver = net_mod.NetDriver;
 pub const SpeakerDriver = speaker_mod.SpeakerDriver;
 pub const MicDriver = mic_mod.MicDriver;
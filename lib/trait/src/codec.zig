@@ -21,6 +21,40 @@
 //! };
 //! ```
 //!
+//! ## Batch Extension (optional)
+//!
+//! Codecs may process N frames per call. Frames are back to back in
+//! `pcm`; packets are back to back in `out`, with `lens[i]` the size of
+//! packet `i`:
+//!
+//! ```zig
+//! pub fn encodeBatch(*MyEncoder, pcm: []const i16, frame_size: u32, out: []u8, lens: []u16) ![]const u8;
+//! pub fn decodeBatch(*MyDecoder, data: []const u8, lens: []const u16, pcm: []i16) ![]const i16;
+//! ```
+//!
+//! `codec.encodeBatch` / `codec.decodeBatch` call them when present and
+//! loop over `encode` / `decode` otherwise. Both sides follow one rule: a
+//! batch is all or nothing. Buffers are checked before any frame is
+//! coded, and a batch that does not fit fails with `error.BufferTooSmall`
+//! leaving `out` / `lens` / `pcm` untouched:
+//!
+//! - `encodeBatch` encodes every whole frame of `pcm`. `lens` must hold
+//!   one entry per frame, and `out` the worst case for them:
+//!   `frames * maxPacketBytes(Impl)` always suffices, a backend with
+//!   fixed-size packets may accept less.
+//! - `decodeBatch` decodes every packet in `lens`. The sizes must fit in
+//!   `data` (`error.BadArg` otherwise), and `pcm` must hold the samples
+//!   of every packet.
+//!
+//! ## Packet Bound (optional)
+//!
+//! An encoder may declare the largest packet it produces for one frame,
+//! so callers can size output buffers at comptime (see `maxPacketBytes`):
+//!
+//! ```zig
+//! pub const max_packet_bytes: usize = 1275;
+//! ```
+//!
 //! ## Usage
 //!
 //! ```zig
@@ -63,3 +97,240 @@ pub fn Decoder(comptime Impl: type) type {
     }
     return Impl;
 }
+
+// ============================================================================
+// Batch extension
+// ============================================================================
+
+fn returnsErrorUnion(comptime F: type) bool {
+    const ret = @typeInfo(F).@"fn".return_type orelse return false;
+    return @typeInfo(ret) == .error_union;
+}
+
+/// Whether Impl provides `encodeBatch(*Impl, pcm, frame_size, out, lens) ![]const u8`
+pub fn hasEncodeBatch(comptime Impl: type) bool {
+    if (!@hasDecl(Impl, "encodeBatch")) return false;
+    const F = @TypeOf(Impl.encodeBatch);
+    const params = @typeInfo(F).@"fn".params;
+    if (params.len != 5 or params[1].type != []const i16 or params[3].type != []u8 or
+        params[4].type != []u16 or !returnsErrorUnion(F))
+    {
+        @compileError("encodeBatch must be fn(*Self, []const i16, u32, []u8, []u16) ![]const u8");
+    }
+    return true;
+}
+
+/// Whether Impl provides `decodeBatch(*Impl, data, lens, pcm) ![]const i16`
+pub fn hasDecodeBatch(comptime Impl: type) bool {
+    if (!@hasDecl(Impl, "decodeBatch")) return false;
+    const F = @TypeOf(Impl.decodeBatch);
+    const params = @typeInfo(F).@"fn".params;
+    if (params.len != 4 or params[1].type != []const u8 or params[2].type != []const u16 or
+        params[3].type != []i16 or !returnsErrorUnion(F))
+    {
+        @compileError("decodeBatch must be fn(*Self, []const u8, []const u16, []i16) ![]const i16");
+    }
+    return true;
+}
+
+/// Output bytes to reserve per frame for an encoder that does not declare
+/// `max_packet_bytes` (the Opus limit, RFC 6716)
+pub const default_max_packet_bytes: usize = 1275;
+
+/// Largest packet `Impl` produces for one frame
+pub fn maxPacketBytes(comptime Impl: type) usize {
+    return if (@hasDecl(Impl, "max_packet_bytes")) Impl.max_packet_bytes else default_max_packet_bytes;
+}
+
+/// Encode the `pcm.len / frame_size` frames of `pcm` into `out`.
+/// Returns the packets, back to back; `lens[i]` holds each size. Fails
+/// with `error.BufferTooSmall`, before encoding anything, when `lens` or
+/// `out` cannot hold the whole batch (see the module comment).
+pub fn encodeBatch(enc: anytype, pcm: []const i16, frame_size: u32, out: []u8, lens: []u16) anyerror![]const u8 {
+    const Impl = @typeInfo(@TypeOf(enc)).pointer.child;
+    if (comptime hasEncodeBatch(Impl)) return enc.encodeBatch(pcm, frame_size, out, lens);
+
+    const frames = pcm.len / frame_size;
+    if (lens.len < frames or out.len < frames * maxPacketBytes(Impl)) return error.BufferTooSmall;
+    var off: usize = 0;
+    for (0..frames) |i| {
+        const packet = try enc.encode(pcm[i * frame_size ..][0..frame_size], frame_size, out[off..]);
+        lens[i] = @intCast(packet.len);
+        off += packet.len;
+    }
+    return out[0..off];
+}
+
+/// Decode packets (sizes in `lens`, back to back in `data`) into
+/// consecutive frames of `pcm`. Returns the decoded samples. Fails before
+/// decoding anything when `lens` runs past `data` (`error.BadArg`) or
+/// `pcm` cannot hold a frame per packet (`error.BufferTooSmall`).
+pub fn decodeBatch(dec: anytype, data: []const u8, lens: []const u16, pcm: []i16) anyerror![]const i16 {
+    const Impl = @typeInfo(@TypeOf(dec)).pointer.child;
+    if (comptime hasDecodeBatch(Impl)) return dec.decodeBatch(data, lens, pcm);
+
+    var total: usize = 0;
+    for (lens) |len| total += len;
+    if (total > data.len) return error.BadArg;
+    if (pcm.len < lens.len * dec.frameSize()) return error.BufferTooSmall;
+
+    var in_off: usize = 0;
+    var out_off: usize = 0;
+    for (lens) |len| {
+        const decoded = try dec.decode(data[in_off..][0..len], pcm[out_off..]);
+        in_off += len;
+        out_off += decoded.len;
+    }
+    return pcm[0..out_off];
+}
+
+/// Walks the packets of a batch
+pub const PacketIterator = struct {
+    data: []const u8,
+    lens: []const u16,
+    index: usize = 0,
+    offset: usize = 0,
+
+    pub fn init(data: []const u8, lens: []const u16) PacketIterator {
+        return .{ .data = data, .lens = lens };
+    }
+
+    pub fn next(self: *PacketIterator) ?[]const u8 {
+        if (self.index >= self.lens.len) return null;
+        const packet = self.data[self.offset..][0..self.lens[self.index]];
+        self.index += 1;
+        self.offset += packet.len;
+        return packet;
+    }
+};
+
+// ============================================================================
+// Tests
+// ============================================================================
+
+const std = @import("std");
+
+/// Toy codec: a "packet" is the first sample of the frame as 2 bytes,
+/// padded to `frame % 3 + 1` copies so packet sizes vary.
+const ToyEncoder = struct {
+    frame: u32,
+    calls: usize = 0,
+
+    pub const max_packet_bytes: usize = 6;
+
+    pub fn encode(self: *ToyEncoder, pcm: []const i16, frame_size: u32, out: []u8) ![]const u8 {
+        if (frame_size != self.frame) return error.BadArg;
+        self.calls += 1;
+        const copies = @as(usize, @intCast(@mod(pcm[0], 3))) + 1;
+        if (out.len < copies * 2) return error.BufferTooSmall;
+        for (0..copies) |i| std.mem.writeInt(i16, out[i * 2 ..][0..2], pcm[0], .little);
+        return out[0 .. copies * 2];
+    }
+
+    pub fn frameSize(self: *const ToyEncoder) u32 {
+        return self.frame;
+    }
+};
+
+const ToyDecoder = struct {
+    frame: u32,
+    calls: usize = 0,
+
+    pub fn decode(self: *ToyDecoder, data: []const u8, pcm: []i16) ![]const i16 {
+        self.calls += 1;
+        const v = std.mem.readInt(i16, data[0..2], .little);
+        @memset(pcm[0..self.frame], v);
+        return pcm[0..self.frame];
+    }
+
+    pub fn frameSize(self: *const ToyDecoder) u32 {
+        return self.frame;
+    }
+};
+
+test "batch helpers fall back to per-frame calls" {
+    _ = Encoder(ToyEncoder);
+    _ = Decoder(ToyDecoder);
+    try std.testing.expect(!hasEncodeBatch(ToyEncoder));
+
+    var pcm: [4 * 8]i16 = undefined;
+    for (0..4) |f| @memset(pcm[f * 8 ..][0..8], @intCast(f + 10));
+
+    var enc = ToyEncoder{ .frame = 8 };
+    var out: [4 * ToyEncoder.max_packet_bytes]u8 = undefined;
+    var lens: [4]u16 = undefined;
+    const packets = try encodeBatch(&enc, &pcm, 8, &out, &lens);
+    try std.testing.expectEqual(@as(usize, 4), enc.calls);
+    try std.testing.expectEqualSlices(u16, &.{ 4, 6, 2, 4 }, &lens);
+    try std.testing.expectEqual(@as(usize, 16), packets.len);
+
+    var it = PacketIterator.init(packets, &lens);
+    var n: usize = 0;
+    while (it.next()) |p| : (n += 1) {
+        try std.testing.expectEqual(@as(i16, @intCast(n + 10)), std.mem.readInt(i16, p[0..2], .little));
+    }
+    try std.testing.expectEqual(@as(usize, 4), n);
+
+    var dec = ToyDecoder{ .frame = 8 };
+    var decoded: [4 * 8]i16 = undefined;
+    const samples = try decodeBatch(&dec, packets, &lens, &decoded);
+    try std.testing.expectEqualSlices(i16, &pcm, samples);
+}
+
+test "native batch is preferred" {
+    const Native = struct {
+        batches: usize = 0,
+
+        pub fn encode(_: *@This(), _: []const i16, _: u32, out: []u8) ![]const u8 {
+            return out[0..0];
+        }
+        pub fn frameSize(_: *const @This()) u32 {
+            return 4;
+        }
+        pub fn encodeBatch(self: *@This(), pcm: []const i16, frame_size: u32, out: []u8, lens: []u16) ![]const u8 {
+            self.batches += 1;
+            const frames = pcm.len / frame_size;
+            @memset(lens[0..frames], 1);
+            @memset(out[0..frames], 0xAB);
+            return out[0..frames];
+        }
+    };
+    try std.testing.expect(hasEncodeBatch(Native));
+
+    var enc = Native{};
+    var pcm = [_]i16{0} ** 12;
+    var out: [8]u8 = undefined;
+    var lens: [3]u16 = undefined;
+    const packets = try encodeBatch(&enc, &pcm, 4, &out, &lens);
+    try std.testing.expectEqual(@as(usize, 1), enc.batches);
+    try std.testing.expectEqual(@as(usize, 3), packets.len);
+}
+
+test "maxPacketBytes uses the declared bound" {
+    const Bounded = struct {
+        pub const max_packet_bytes: usize = 40;
+    };
+    try std.testing.expectEqual(@as(usize, 40), maxPacketBytes(Bounded));
+    try std.testing.expectEqual(default_max_packet_bytes, maxPacketBytes(ToyDecoder));
+}
+
+test "fallback batches fail whole before coding a frame" {
+    var pcm: [4 * 8]i16 = undefined;
+    for (0..4) |f| @memset(pcm[f * 8 ..][0..8], @intCast(f + 10));
+
+    var enc = ToyEncoder{ .frame = 8 };
+    var out: [4 * ToyEncoder.max_packet_bytes]u8 = @splat(0xEE);
+    var lens: [4]u16 = @splat(0xEEEE);
+    try std.testing.expectError(error.BufferTooSmall, encodeBatch(&enc, &pcm, 8, &out, lens[0..3]));
+    try std.testing.expectError(error.BufferTooSmall, encodeBatch(&enc, &pcm, 8, out[0 .. out.len - 1], &lens));
+    try std.testing.expectEqual(@as(usize, 0), enc.calls);
+    for (out) |b| try std.testing.expectEqual(@as(u8, 0xEE), b);
+    for (lens) |l| try std.testing.expectEqual(@as(u16, 0xEEEE), l);
+
+    const packets = try encodeBatch(&enc, &pcm, 8, &out, &lens);
+    var dec = ToyDecoder{ .frame = 8 };
+    var decoded: [4 * 8]i16 = undefined;
+    try std.testing.expectError(error.BufferTooSmall, decodeBatch(&dec, packets, &lens, decoded[0 .. decoded.len - 1]));
+    try std.testing.expectError(error.BadArg, decodeBatch(&dec, packets[0 .. packets.len - 1], &lens, &decoded));
+    try std.testing.expectEqual(@as(usize, 0), dec.calls);
+}
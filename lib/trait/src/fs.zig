@@ -19,6 +19,17 @@
 //! var fw = board.fs.open("/ota/firmware.bin", .write) orelse return;
 //! defer fw.close();
 //! _ = fw.write(data);
+//!
+//! // Random access without re-reading from the start
+//! var bundle = board.fs.open("/assets/bundle.bin", .read) orelse return;
+//! defer bundle.close();
+//! _ = bundle.pread(&header, 0);
+//! _ = bundle.seek(entry.offset, .start);
+//!
+//! // Directories (optional driver support)
+//! var dir = board.fs.openDir("/assets") orelse return;
+//! defer dir.close();
+//! while (dir.next()) |entry| log.info("{s}", .{entry.name});
 //! ```
 
 /// File open mode
@@ -37,6 +48,64 @@ pub const FsError = error{
     InvalidPath,
 };
 
+/// Origin for `File.seek`
+pub const Whence = enum {
+    start,
+    current,
+    end,
+};
+
+/// Access-pattern hint for `File.advise` (read-ahead control)
+pub const Advice = enum {
+    normal,
+    sequential,
+    random,
+    /// Range will be needed soon: start reading it ahead
+    will_need,
+    /// Range will not be needed again: pages may be dropped
+    dont_need,
+};
+
+/// Entry kind for `stat` and directory listing
+pub const Kind = enum {
+    file,
+    directory,
+    other,
+};
+
+/// File metadata from `stat`
+pub const Stat = struct {
+    size: u64,
+    kind: Kind,
+    /// Modification time in seconds since the Unix epoch (0 if unknown)
+    mtime_s: i64 = 0,
+};
+
+/// One directory entry. `name` is valid until the next `Dir.next()`.
+pub const DirEntry = struct {
+    name: []const u8,
+    kind: Kind,
+};
+
+/// Directory handle — returned by openDir(), iterated with next().
+pub const Dir = struct {
+    ctx: *anyopaque,
+
+    /// Next entry, or null at the end of the directory.
+    nextFn: *const fn (ctx: *anyopaque) ?DirEntry,
+
+    /// Close the directory and release resources.
+    closeFn: *const fn (ctx: *anyopaque) void,
+
+    pub fn next(self: *Dir) ?DirEntry {
+        return self.nextFn(self.ctx);
+    }
+
+    pub fn close(self: *Dir) void {
+        self.closeFn(self.ctx);
+    }
+};
+
 /// File handle — returned by open(), used for read/write/close.
 ///
 /// Supports two access modes:
@@ -44,6 +113,10 @@ pub const FsError = error{
 ///   (flash mmap, @embedFile). No RAM copy needed. Use this when available.
 /// - **Streaming**: `data` is null, use read()/write() with caller buffer.
 ///   For network downloads, OTA, etc.
+///
+/// Seek, positional I/O and advice are optional per backend. For
+/// zero-copy files they are served from `data` when the backend leaves
+/// them unset.
 pub const File = struct {
     /// Zero-copy data pointer — non-null for mmap-capable backends
     /// (@embedFile, flash mmap). Points directly to backing store.
@@ -62,17 +135,115 @@ pub const File = struct {
     /// Close the file and release resources.
     closeFn: *const fn (ctx: *anyopaque) void,
 
-    /// File size in bytes (known at open time, or 0 if unknown).
-    size: u32,
+    /// Move the file position. Returns the new absolute position, or null
+    /// if the target is out of range or unsupported.
+    seekFn: ?*const fn (ctx: *anyopaque, offset: i64, whence: Whence) ?u64 = null,
+
+    /// Read at `offset` without moving the file position.
+    preadFn: ?*const fn (ctx: *anyopaque, buf: []u8, offset: u64) usize = null,
+
+    /// Write at `offset` without moving the file position.
+    pwriteFn: ?*const fn (ctx: *anyopaque, data: []const u8, offset: u64) usize = null,
+
+    /// Access-pattern hint for a byte range (len 0 = to end of file).
+    adviseFn: ?*const fn (ctx: *anyopaque, offset: u64, len: u64, advice: Advice) void = null,
+
+    /// Flush written data to the backing store. Returns false on failure.
+    syncFn: ?*const fn (ctx: *anyopaque) bool = null,
+
+    /// File size in bytes (known at open time, or 0 if unknown). Grows
+    /// as `write`/`pwrite` extend the file.
+    size: u64,
+
+    /// Position for zero-copy files without `readFn`/`seekFn`
+    pos: u64 = 0,
 
     pub fn read(self: *File, buf: []u8) usize {
-        const f = self.readFn orelse return 0;
+        const f = self.readFn orelse {
+            const n = self.copyData(buf, self.pos);
+            self.pos += n;
+            return n;
+        };
         return f(self.ctx, buf);
     }
 
     pub fn write(self: *File, buf: []const u8) usize {
         const f = self.writeFn orelse return 0;
-        return f(self.ctx, buf);
+        const n = f(self.ctx, buf);
+        if (n > 0) {
+            if (self.tell()) |end| self.size = @max(self.size, end);
+        }
+        return n;
+    }
+
+    /// Move the file position. Returns the new position, or null if out
+    /// of range or unsupported.
+    pub fn seek(self: *File, offset: i64, whence: Whence) ?u64 {
+        if (self.seekFn) |f| return f(self.ctx, offset, whence);
+        if (self.data == null or self.readFn != null) return null;
+        const base: u64 = switch (whence) {
+            .start => 0,
+            .current => self.pos,
+            .end => self.size,
+        };
+        const target = @as(i128, base) + offset;
+        if (target < 0 or target > self.size) return null;
+        self.pos = @intCast(target);
+        return self.pos;
+    }
+
+    /// Current file position (null if the backend cannot report it)
+    pub fn tell(self: *File) ?u64 {
+        return self.seek(0, .current);
+    }
+
+    /// Read up to buf.len bytes at `offset`. The file position is left
+    /// unchanged. Returns bytes read, 0 = EOF or unsupported.
+    pub fn pread(self: *File, buf: []u8, offset: u64) usize {
+        if (self.preadFn) |f| return f(self.ctx, buf, offset);
+        if (self.data != null) return self.copyData(buf, offset);
+        // Emulate through seek + read; seek takes an i64, so offsets from
+        // 2^63 up read nothing
+        const at = std.math.cast(i64, offset) orelse return 0;
+        const saved = self.tell() orelse return 0;
+        defer _ = self.seek(@intCast(saved), .start);
+        if (self.seek(at, .start) == null) return 0;
+        return self.read(buf);
+    }
+
+    /// Write `buf` at `offset`. The file position is left unchanged.
+    /// Returns bytes written, 0 if unsupported.
+    pub fn pwrite(self: *File, buf: []const u8, offset: u64) usize {
+        if (self.pwriteFn) |f| {
+            const n = f(self.ctx, buf, offset);
+            if (n > 0) self.size = @max(self.size, offset + n);
+            return n;
+        }
+        const at = std.math.cast(i64, offset) orelse return 0;
+        const saved = self.tell() orelse return 0;
+        defer _ = self.seek(@intCast(saved), .start);
+        if (self.seek(at, .start) == null) return 0;
+        return self.write(buf);
+    }
+
+    /// Hint how a byte range will be accessed. No-op if unsupported.
+    pub fn advise(self: *File, offset: u64, len: u64, advice: Advice) void {
+        if (self.adviseFn) |f| f(self.ctx, offset, len, advice);
+    }
+
+    /// Make everything written so far durable (survives power loss).
+    /// Backends without a write cache leave `syncFn` unset: always true.
+    pub fn sync(self: *File) bool {
+        const f = self.syncFn orelse return true;
+        return f(self.ctx);
+    }
+
+    fn copyData(self: *const File, buf: []u8, offset: u64) usize {
+        const d = self.data orelse return 0;
+        if (offset >= d.len) return 0;
+        const n = @min(buf.len, d.len - @as(usize, @intCast(offset)));
+        @memcpy(buf[0..n], d[@intCast(offset)..][0..n]);
+        return n;
     }
 
     pub fn close(self: *File) void {
@@ -97,6 +268,10 @@ pub const File = struct {
 /// Driver must provide:
 ///   pub fn open(self: *Driver, path: []const u8, mode: OpenMode) ?File
 ///
+/// Driver may provide (validated when present):
+///   pub fn stat(self: *Driver, path: []const u8) ?Stat
+///   pub fn openDir(self: *Driver, path: []const u8) ?Dir
+///
 /// Example:
 /// ```zig
 /// const fs_spec = struct {
@@ -106,13 +281,19 @@ pub const File = struct {
 /// const MyFs = fs.from(fs_spec);
 /// ```
 pub fn from(comptime spec: type) type {
+    const BaseDriver = switch (@typeInfo(spec.Driver)) {
+        .pointer => |p| p.child,
+        else => spec.Driver,
+    };
     comptime {
-        const BaseDriver = switch (@typeInfo(spec.Driver)) {
-            .pointer => |p| p.child,
-            else => spec.Driver,
-        };
         // Verify required method: open(self, path, mode) -> ?File
         _ = @as(*const fn (*BaseDriver, []const u8, OpenMode) ?File, &BaseDriver.open);
+        if (@hasDecl(BaseDriver, "stat")) {
+            _ = @as(*const fn (*BaseDriver, []const u8) ?Stat, &BaseDriver.stat);
+        }
+        if (@hasDecl(BaseDriver, "openDir")) {
+            _ = @as(*const fn (*BaseDriver, []const u8) ?Dir, &BaseDriver.openDir);
+        }
         _ = @as([]const u8, spec.meta.id);
     }
 
@@ -133,6 +314,18 @@ pub fn from(comptime spec: type) type {
         pub fn open(self: *Self, path: []const u8, mode: OpenMode) ?File {
             return self.driver.open(path, mode);
         }
+
+        /// File metadata, or null if missing or unsupported by the driver
+        pub fn stat(self: *Self, path: []const u8) ?Stat {
+            if (!@hasDecl(BaseDriver, "stat")) return null;
+            return self.driver.stat(path);
+        }
+
+        /// Open a directory for listing, or null if missing or unsupported
+        pub fn openDir(self: *Self, path: []const u8) ?Dir {
+            if (!@hasDecl(BaseDriver, "openDir")) return null;
+            return self.driver.openDir(path);
+        }
     };
 }
 
@@ -210,7 +403,7 @@ test "Fs with mock driver" {
     var file = vfs.open("/test.txt", .read) orelse return error.TestUnexpectedResult;
     defer file.close();
 
-    try std.testing.expectEqual(@as(u32, 11), file.size);
+    try std.testing.expectEqual(@as(u64, 11), file.size);
 
     // Test read
     var buf: [64]u8 = undefined;
@@ -258,5 +451,125 @@ test "Fs zero-copy (mmap) path" {
     // Zero-copy: data available directly, no read() needed
     try std.testing.expect(file.data != null);
     try std.testing.expectEqualStrings("mmap content here", file.data.?);
-    try std.testing.expectEqual(@as(u32, 17), file.size);
+    try std.testing.expectEqual(@as(u64, 17), file.size);
+}
+
+test "zero-copy files support seek and pread without backend hooks" {
+    var dummy: u8 = 0;
+    const noop = struct {
+        fn close(_: *anyopaque) void {}
+    };
+    var file = File{
+        .data = "0123456789",
+        .ctx = @ptrCast(&dummy),
+        .closeFn = &noop.close,
+        .size = 10,
+    };
+
+    var buf: [4]u8 = undefined;
+    try std.testing.expectEqual(@as(usize, 3), file.pread(&buf, 7));
+    try std.testing.expectEqualStrings("789", buf[0..3]);
+    try std.testing.expectEqual(@as(?u64, 0), file.tell());
+
+    try std.testing.expectEqual(@as(?u64, 6), file.seek(-4, .end));
+    try std.testing.expectEqual(@as(usize, 4), file.read(&buf));
+    try std.testing.expectEqualStrings("6789", &buf);
+    try std.testing.expectEqual(@as(?u64, null), file.seek(11, .start));
+    try std.testing.expectEqual(@as(usize, 0), file.pread(&buf, 10));
+}
+
+test "pread emulated through seek and read" {
+    const Backing = struct {
+        const content = "abcdefgh";
+        var pos: u64 = 0;
+
+        fn read(_: *anyopaque, buf: []u8) usize {
+            const n = @min(buf.len, content.len - pos);
+            @memcpy(buf[0..n], content[pos..][0..n]);
+            pos += n;
+            return n;
+        }
+        fn seek(_: *anyopaque, offset: i64, whence: Whence) ?u64 {
+            const base: i64 = switch (whence) {
+                .start => 0,
+                .current => @intCast(pos),
+                .end => content.len,
+            };
+            pos = @intCast(base + offset);
+            return pos;
+        }
+        fn close(_: *anyopaque) void {}
+    };
+
+    var dummy: u8 = 0;
+    var file = File{
+        .ctx = @ptrCast(&dummy),
+        .readFn = &Backing.read,
+        .seekFn = &Backing.seek,
+        .closeFn = &Backing.close,
+        .size = 8,
+    };
+    var buf: [2]u8 = undefined;
+    _ = file.read(&buf);
+    try std.testing.expectEqual(@as(usize, 2), file.pread(&buf, 5));
+    try std.testing.expectEqualStrings("fg", &buf);
+    try std.testing.expectEqual(@as(?u64, 2), file.tell());
+
+    // Offsets past i64 are short I/O, not a panic
+    try std.testing.expectEqual(@as(usize, 0), file.pread(&buf, 1 << 63));
+    try std.testing.expectEqual(@as(usize, 0), file.pwrite("xy", std.math.maxInt(u64)));
+    try std.testing.expectEqual(@as(?u64, 2), file.tell());
+}
+
+test "write and pwrite keep size current" {
+    const Backing = struct {
+        var pos: u64 = 0;
+
+        fn write(_: *anyopaque, data: []const u8) usize {
+            pos += data.len;
+            return data.len;
+        }
+        fn pwrite(_: *anyopaque, data: []const u8, _: u64) usize {
+            return data.len;
+        }
+        fn seek(_: *anyopaque, offset: i64, whence: Whence) ?u64 {
+            if (whence != .current) return null;
+            pos = @intCast(@as(i64, @intCast(pos)) + offset);
+            return pos;
+        }
+        fn close(_: *anyopaque) void {}
+    };
+
+    var dummy: u8 = 0;
+    var file = File{
+        .ctx = @ptrCast(&dummy),
+        .writeFn = &Backing.write,
+        .pwriteFn = &Backing.pwrite,
+        .seekFn = &Backing.seek,
+        .closeFn = &Backing.close,
+        .size = 0,
+    };
+    try std.testing.expectEqual(@as(usize, 4), file.write("abcd"));
+    try std.testing.expectEqual(@as(u64, 4), file.size);
+    _ = file.pwrite("xyz", 10);
+    try std.testing.expectEqual(@as(u64, 13), file.size);
+    // Overwriting inside the file does not shrink it
+    _ = file.pwrite("q", 0);
+    try std.testing.expectEqual(@as(u64, 13), file.size);
+}
+
+test "optional stat and openDir on the Fs wrapper" {
+    const PlainDriver = struct {
+        pub fn open(_: *@This(), _: []const u8, _: OpenMode) ?File {
+            return null;
+        }
+    };
+    const spec = struct {
+        pub const Driver = PlainDriver;
+        pub const meta = .{ .id = "fs.plain" };
+    };
+    var driver = PlainDriver{};
+    var vfs = from(spec).init(&driver);
+    try std.testing.expectEqual(@as(?Stat, null), vfs.stat("/x"));
+    try std.testing.expect(vfs.openDir("/") == null);
 }
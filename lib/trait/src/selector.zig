@@ -85,6 +85,18 @@
 //!   `error.QueueSetCapacityExceeded` for capacity validation failures
 //! - `addTimeout`: Returns `error.TooMany` if `max_sources` exceeded
 //!
+//! ## Optional extensions
+//!
+//! Backends may offer more source kinds; portable code checks with
+//! `@hasDecl` before use. The std backend provides all of them:
+//!
+//! - `addSend(*Self, channel) !usize` — ready while the channel has room
+//! - `addSocket(*Self, socket, .read | .write) !usize` — socket readiness
+//! - `addTimer(*Self, after_ms) !usize`, `armTimer`, `disarmTimer` —
+//!   independent one-shot timers, any number per selector
+//! - `remove(*Self, index)` — drop one source, keeping the others
+//! - `waitMany(*Self, ?u32, []usize) !usize` — every ready source at once
+//!
 //! ## Usage
 //!
 //! ```zig
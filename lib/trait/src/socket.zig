@@ -28,6 +28,29 @@ const std = @import("std");
 /// IPv4 address
 pub const Ipv4Address = [4]u8;
 
+/// IPv6 address (network byte order)
+pub const Ipv6Address = [16]u8;
+
+/// Address family
+pub const Family = enum { ipv4, ipv6 };
+
+/// Address-family-agnostic IP address
+pub const IpAddress = union(Family) {
+    ipv4: Ipv4Address,
+    ipv6: Ipv6Address,
+
+    pub fn family(self: IpAddress) Family {
+        return std.meta.activeTag(self);
+    }
+
+    pub fn eql(a: IpAddress, b: IpAddress) bool {
+        return switch (a) {
+            .ipv4 => |v4| b == .ipv4 and std.mem.eql(u8, &v4, &b.ipv4),
+            .ipv6 => |v6| b == .ipv6 and std.mem.eql(u8, &v6, &b.ipv6),
+        };
+    }
+};
+
 /// Socket error types
 pub const Error = error{
     CreateFailed,
@@ -98,6 +121,228 @@ pub fn from(comptime Impl: type) type {
     return Impl;
 }
 
+/// Optional dual-stack extension. An implementation that supports IPv6
+/// provides, next to the IPv4 methods above:
+///
+/// - `tcp6() Error!Self`, `udp6() Error!Self`
+/// - `connect6(*Self, Ipv6Address, u16) Error!void`
+/// - `sendTo6(*Self, Ipv6Address, u16, []const u8) Error!usize`
+/// - `bind6(*Self, Ipv6Address, u16) Error!void`
+///
+/// Returns false when absent; fails to compile if present but mistyped.
+pub fn hasIpv6(comptime Impl: type) bool {
+    const BaseType = switch (@typeInfo(Impl)) {
+        .pointer => |p| p.child,
+        else => Impl,
+    };
+    if (!@hasDecl(BaseType, "connect6")) return false;
+    comptime {
+        _ = @as(*const fn () Error!BaseType, &BaseType.tcp6);
+        _ = @as(*const fn () Error!BaseType, &BaseType.udp6);
+        _ = @as(*const fn (*BaseType, Ipv6Address, u16) Error!void, &BaseType.connect6);
+        _ = @as(*const fn (*BaseType, Ipv6Address, u16, []const u8) Error!usize, &BaseType.sendTo6);
+        _ = @as(*const fn (*BaseType, Ipv6Address, u16) Error!void, &BaseType.bind6);
+    }
+    return true;
+}
+
+/// Optional non-blocking connect, used to race several attempts:
+///
+/// - `connectStart(*Self, IpAddress, u16) Error!bool` begins a connect
+///   without blocking; true if it already completed
+/// - `connectPoll(*Self, timeout_ms: u32) Error!bool` waits up to
+///   `timeout_ms`; true once connected (socket back in blocking mode),
+///   false while still in progress, ConnectFailed if refused
+pub fn hasConnectPoll(comptime Impl: type) bool {
+    const BaseType = switch (@typeInfo(Impl)) {
+        .pointer => |p| p.child,
+        else => Impl,
+    };
+    if (!@hasDecl(BaseType, "connectPoll")) return false;
+    comptime {
+        _ = @as(*const fn (*BaseType, IpAddress, u16) Error!bool, &BaseType.connectStart);
+        _ = @as(*const fn (*BaseType, u32) Error!bool, &BaseType.connectPoll);
+    }
+    return true;
+}
+
+/// Optional wait on several non-blocking connects at once, so a race
+/// notices whichever attempt finishes first:
+///
+/// - `connectPollAny(socks: []const *Self, timeout_ms: u32) Error!?usize`
+///   waits up to `timeout_ms` for any connect in `socks` to finish or
+///   fail; returns its index, or null on timeout. `connectPoll(0)` on
+///   that socket then reports the outcome.
+///
+/// Requires `hasConnectPoll`.
+pub fn hasConnectPollAny(comptime Impl: type) bool {
+    const BaseType = switch (@typeInfo(Impl)) {
+        .pointer => |p| p.child,
+        else => Impl,
+    };
+    if (!@hasDecl(BaseType, "connectPollAny")) return false;
+    comptime {
+        if (!hasConnectPoll(BaseType)) @compileError("connectPollAny requires connectStart/connectPoll");
+        _ = @as(*const fn ([]const *BaseType, u32) Error!?usize, &BaseType.connectPollAny);
+    }
+    return true;
+}
+
+/// Optional vectored I/O, so a header and a body go out (or come in) in
+/// one call without a staging copy:
+///
+/// - `sendv(*Self, []const []const u8) Error!usize` sends the buffers in
+///   order as one stream write; may be partial like `send`
+/// - `recvv(*Self, []const []u8) Error!usize` fills the buffers in order;
+///   may be short like `recv`
+///
+/// Implementations may cap the buffers taken per call (the rest is a
+/// partial write). Use the `sendv`/`recvv` helpers below to fall back
+/// to `send`/`recv` where this is absent.
+pub fn hasVectored(comptime Impl: type) bool {
+    const BaseType = switch (@typeInfo(Impl)) {
+        .pointer => |p| p.child,
+        else => Impl,
+    };
+    if (!@hasDecl(BaseType, "sendv")) return false;
+    comptime {
+        _ = @as(*const fn (*BaseType, []const []const u8) Error!usize, &BaseType.sendv);
+        _ = @as(*const fn (*BaseType, []const []u8) Error!usize, &BaseType.recvv);
+    }
+    return true;
+}
+
+/// One datagram of a batch send
+pub const Datagram = struct {
+    addr: Ipv4Address,
+    port: u16,
+    data: []const u8,
+};
+
+/// One slot of a batch receive; `len`, `src_addr` and `src_port` are
+/// filled in
+pub const RecvSlot = struct {
+    buf: []u8,
+    len: usize = 0,
+    src_addr: Ipv4Address = .{ 0, 0, 0, 0 },
+    src_port: u16 = 0,
+};
+
+/// Optional UDP batching (sendmmsg/recvmmsg):
+///
+/// - `sendBatch(*Self, []const Datagram) Error!usize` sends datagrams in
+///   order; returns how many went out
+/// - `recvBatch(*Self, []RecvSlot) Error!usize` waits for one datagram,
+///   then takes whatever else is already queued, one per slot; returns
+///   the number of slots filled
+pub fn hasBatch(comptime Impl: type) bool {
+    const BaseType = switch (@typeInfo(Impl)) {
+        .pointer => |p| p.child,
+        else => Impl,
+    };
+    if (!@hasDecl(BaseType, "sendBatch")) return false;
+    comptime {
+        _ = @as(*const fn (*BaseType, []const Datagram) Error!usize, &BaseType.sendBatch);
+        _ = @as(*const fn (*BaseType, []RecvSlot) Error!usize, &BaseType.recvBatch);
+    }
+    return true;
+}
+
+/// Vectored send, or one `send` per buffer until one comes up short
+pub fn sendv(sock: anytype, bufs: []const []const u8) Error!usize {
+    const Impl = @typeInfo(@TypeOf(sock)).pointer.child;
+    if (comptime hasVectored(Impl)) return sock.sendv(bufs);
+    var total: usize = 0;
+    for (bufs) |buf| {
+        if (buf.len == 0) continue;
+        const n = sock.send(buf) catch |err| return if (total > 0) total else err;
+        total += n;
+        if (n < buf.len) break;
+    }
+    return total;
+}
+
+/// Send all bytes of `bufs`, resuming after partial writes
+pub fn sendvAll(sock: anytype, bufs: []const []const u8) Error!void {
+    const max_parts = 16;
+    var first: usize = 0;
+    var offset: usize = 0;
+    while (first < bufs.len) {
+        var parts: [max_parts][]const u8 = undefined;
+        var count: usize = 0;
+        for (bufs[first..]) |buf| {
+            if (count == max_parts) break;
+            parts[count] = buf;
+            count += 1;
+        }
+        parts[0] = parts[0][offset..];
+
+        var n = try sendv(sock, parts[0..count]);
+        if (n == 0 and totalLen(parts[0..count]) > 0) return error.SendFailed;
+        while (first < bufs.len and n >= bufs[first].len - offset) {
+            n -= bufs[first].len - offset;
+            first += 1;
+            offset = 0;
+        }
+        offset += n;
+    }
+}
+
+fn totalLen(bufs: []const []const u8) usize {
+    var sum: usize = 0;
+    for (bufs) |b| sum += b.len;
+    return sum;
+}
+
+/// Vectored receive, or a single `recv` into the first non-empty buffer
+pub fn recvv(sock: anytype, bufs: []const []u8) Error!usize {
+    const Impl = @typeInfo(@TypeOf(sock)).pointer.child;
+    if (comptime hasVectored(Impl)) return sock.recvv(bufs);
+    for (bufs) |buf| {
+        if (buf.len > 0) return sock.recv(buf);
+    }
+    return 0;
+}
+
+/// Batch send, or one `sendTo` per datagram
+pub fn sendBatch(sock: anytype, msgs: []const Datagram) Error!usize {
+    const Impl = @typeInfo(@TypeOf(sock)).pointer.child;
+    if (comptime hasBatch(Impl)) return sock.sendBatch(msgs);
+    for (msgs, 0..) |m, i| {
+        _ = sock.sendTo(m.addr, m.port, m.data) catch |err| return if (i > 0) i else err;
+    }
+    return msgs.len;
+}
+
+/// Batch receive, or one `recvFromWithAddr` into the first slot
+pub fn recvBatch(sock: anytype, slots: []RecvSlot) Error!usize {
+    const Impl = @typeInfo(@TypeOf(sock)).pointer.child;
+    if (comptime hasBatch(Impl)) return sock.recvBatch(slots);
+    if (slots.len == 0) return 0;
+    const r = try sock.recvFromWithAddr(slots[0].buf);
+    slots[0].len = r.len;
+    slots[0].src_addr = r.src_addr;
+    slots[0].src_port = r.src_port;
+    return 1;
+}
+
+/// Create a TCP socket of the address family of `addr`
+pub fn tcpFor(comptime Impl: type, fam: Family) Error!Impl {
+    return switch (fam) {
+        .ipv4 => Impl.tcp(),
+        .ipv6 => if (comptime hasIpv6(Impl)) Impl.tcp6() else error.InvalidAddress,
+    };
+}
+
+/// Blocking connect to an address of either family
+pub fn connectAddr(sock: anytype, addr: IpAddress, port: u16) Error!void {
+    const Impl = @typeInfo(@TypeOf(sock)).pointer.child;
+    return switch (addr) {
+        .ipv4 => |v4| sock.connect(v4, port),
+        .ipv6 => |v6| if (comptime hasIpv6(Impl)) sock.connect6(v6, port) else error.InvalidAddress,
+    };
+}
+
 pub fn hasRecvFromWithAddr(comptime Impl: type) bool {
     const BaseType = switch (@typeInfo(Impl)) {
         .pointer => |p| p.child,
@@ -133,6 +378,66 @@ pub fn parseIpv4(str: []const u8) ?Ipv4Address {
     return addr;
 }
 
+/// Parse IPv6 address string (e.g., "::1", "2001:db8::8a2e:370:7334").
+/// Embedded IPv4 tails and zone ids are not supported.
+pub fn parseIpv6(str: []const u8) ?Ipv6Address {
+    if (str.len < 2) return null;
+    var head: [8]u16 = undefined;
+    var tail: [8]u16 = undefined;
+    var head_len: usize = 0;
+    var tail_len: usize = 0;
+    var seen_gap = false;
+
+    var rest = str;
+    if (std.mem.startsWith(u8, rest, "::")) {
+        seen_gap = true;
+        rest = rest[2..];
+    }
+    while (rest.len > 0) {
+        const end = std.mem.indexOfScalar(u8, rest, ':') orelse rest.len;
+        const group = rest[0..end];
+        if (group.len == 0 or group.len > 4) return null;
+        const val = std.fmt.parseUnsigned(u16, group, 16) catch return null;
+        if (seen_gap) {
+            if (tail_len == 8) return null;
+            tail[tail_len] = val;
+            tail_len += 1;
+        } else {
+            if (head_len == 8) return null;
+            head[head_len] = val;
+            head_len += 1;
+        }
+        if (end == rest.len) break;
+        rest = rest[end + 1 ..];
+        if (rest.len > 0 and rest[0] == ':') {
+            if (seen_gap) return null;
+            seen_gap = true;
+            rest = rest[1..];
+        } else if (rest.len == 0) {
+            return null; // trailing single ':'
+        }
+    }
+
+    const total = head_len + tail_len;
+    if (seen_gap and total > 7) return null;
+    if (!seen_gap and total != 8) return null;
+
+    var groups = [_]u16{0} ** 8;
+    @memcpy(groups[0..head_len], head[0..head_len]);
+    @memcpy(groups[8 - tail_len ..], tail[0..tail_len]);
+    var addr: Ipv6Address = undefined;
+    for (groups, 0..) |g, i| std.mem.writeInt(u16, addr[i * 2 ..][0..2], g, .big);
+    return addr;
+}
+
+/// Parse an IPv4 or IPv6 literal (brackets around IPv6 allowed)
+pub fn parseIp(str: []const u8) ?IpAddress {
+    if (parseIpv4(str)) |v4| return .{ .ipv4 = v4 };
+    const bare = if (str.len >= 2 and str[0] == '[' and str[str.len - 1] == ']') str[1 .. str.len - 1] else str;
+    if (parseIpv6(bare)) |v6| return .{ .ipv6 = v6 };
+    return null;
+}
+
 // =========== Tests ===========
 
 test "parseIpv4" {
@@ -145,3 +450,69 @@ test "parseIpv4" {
     try std.testing.expectEqual(@as(?Ipv4Address, null), parseIpv4("invalid"));
     try std.testing.expectEqual(@as(?Ipv4Address, null), parseIpv4("256.1.1.1"));
 }
+
+test "parseIpv6" {
+    const loopback = parseIpv6("::1").?;
+    try std.testing.expectEqual(@as(u8, 1), loopback[15]);
+    for (loopback[0..15]) |b| try std.testing.expectEqual(@as(u8, 0), b);
+
+    const doc = parseIpv6("2001:db8::8a2e:370:7334").?;
+    try std.testing.expectEqualSlices(u8, &.{ 0x20, 0x01, 0x0d, 0xb8, 0, 0, 0, 0, 0, 0, 0x8a, 0x2e, 0x03, 0x70, 0x73, 0x34 }, &doc);
+
+    const full = parseIpv6("fe80:0:0:0:1:2:3:4").?;
+    try std.testing.expectEqual(@as(u8, 0xfe), full[0]);
+    try std.testing.expectEqual(@as(u8, 4), full[15]);
+
+    try std.testing.expect(parseIpv6("::") != null);
+    try std.testing.expect(parseIpv6("1::2::3") == null);
+    try std.testing.expect(parseIpv6("1:2:3") == null);
+    try std.testing.expect(parseIpv6("12345::") == null);
+    try std.testing.expect(parseIpv6("1:") == null);
+}
+
+test "parseIp picks the family" {
+    try std.testing.expectEqual(Family.ipv4, parseIp("127.0.0.1").?.family());
+    try std.testing.expectEqual(Family.ipv6, parseIp("[::1]").?.family());
+    try std.testing.expect(parseIp("example.com") == null);
+    try std.testing.expect(parseIp("::1").?.eql(.{ .ipv6 = parseIpv6("::1").? }));
+}
+
+/// Stream that takes at most `chunk` bytes per send, without vectored I/O
+const ShortWriter = struct {
+    out: [64]u8 = undefined,
+    len: usize = 0,
+    chunk: usize,
+    calls: usize = 0,
+
+    fn send(self: *ShortWriter, data: []const u8) Error!usize {
+        self.calls += 1;
+        const n = @min(data.len, self.chunk, self.out.len - self.len);
+        @memcpy(self.out[self.len..][0..n], data[0..n]);
+        self.len += n;
+        return n;
+    }
+
+    fn sendTo(self: *ShortWriter, _: Ipv4Address, _: u16, data: []const u8) Error!usize {
+        if (self.calls == 2) return error.SendFailed;
+        return self.send(data);
+    }
+};
+
+test "sendvAll falls back to send and resumes partial writes" {
+    var w = ShortWriter{ .chunk = 3 };
+    try std.testing.expect(!hasVectored(ShortWriter));
+    try sendvAll(&w, &.{ "head", "", "er|body", "!" });
+    try std.testing.expectEqualStrings("header|body!", w.out[0..w.len]);
+    try std.testing.expectEqual(@as(usize, 6), w.calls);
+}
+
+test "sendBatch fallback reports how many datagrams went out" {
+    var w = ShortWriter{ .chunk = 64 };
+    const msgs = [_]Datagram{
+        .{ .addr = .{ 127, 0, 0, 1 }, .port = 1, .data = "a" },
+        .{ .addr = .{ 127, 0, 0, 1 }, .port = 1, .data = "b" },
+        .{ .addr = .{ 127, 0, 0, 1 }, .port = 1, .data = "c" },
+    };
+    try std.testing.expectEqual(@as(usize, 2), try sendBatch(&w, &msgs));
+    try std.testing.expectEqualStrings("ab", w.out[0..w.len]);
+}
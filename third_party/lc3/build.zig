@@ -0,0 +1,12 @@
+const std = @import("std");
+
+pub fn build(b: *std.Build) void {
+    const target = b.standardTargetOptions(.{});
+    const optimize = b.standardOptimizeOption(.{});
+
+    _ = b.addModule("lc3", .{
+        .root_source_file = b.path("lc3.zig"),
+        .target = target,
+        .optimize = optimize,
+    });
+}
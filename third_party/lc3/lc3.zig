@@ -0,0 +1,190 @@
+//! Zig bindings for liblc3
+//!
+//! LC3 is the Bluetooth LE Audio codec: 7.5ms or 10ms frames, 8-48kHz,
+//! constant frame size chosen per frame (20-400 bytes).
+//!
+//! Allocator-based: encoder/decoder memory is owned by a Zig allocator,
+//! giving full control over placement (e.g., PSRAM on ESP32).
+//! Uses lc3_encoder_size + lc3_setup_encoder (liblc3 never allocates).
+
+const std = @import("std");
+const c = @cImport({
+    @cInclude("lc3.h");
+});
+
+// =============================================================================
+// Error
+// =============================================================================
+
+pub const Error = error{
+    /// Unsupported sample rate / frame duration, or frame size out of range
+    BadArg,
+    /// Output buffer smaller than the requested frame
+    BufferTooSmall,
+    /// Encoder or decoder rejected the frame
+    InvalidFrame,
+};
+
+// =============================================================================
+// Configuration
+// =============================================================================
+
+pub const min_frame_bytes: u32 = c.LC3_MIN_FRAME_BYTES;
+pub const max_frame_bytes: u32 = c.LC3_MAX_FRAME_BYTES;
+
+/// LC3 frame duration
+pub const FrameDuration = enum(u32) {
+    ms7_5 = 7500,
+    ms10 = 10000,
+
+    pub fn us(self: FrameDuration) c_int {
+        return @intCast(@intFromEnum(self));
+    }
+};
+
+/// Samples per channel in one frame, or BadArg for an unsupported rate.
+/// 10ms @ 16kHz = 160, 7.5ms @ 48kHz = 360.
+pub fn frameSamples(duration: FrameDuration, sample_rate: u32) Error!u32 {
+    const n = c.lc3_frame_samples(duration.us(), @intCast(sample_rate));
+    if (n < 0) return error.BadArg;
+    return @intCast(n);
+}
+
+/// Frame size in bytes for a target bitrate (clamped to the LC3 range).
+pub fn frameBytes(duration: FrameDuration, bitrate: u32) Error!u32 {
+    const n = c.lc3_frame_bytes(duration.us(), @intCast(bitrate));
+    if (n < 0) return error.BadArg;
+    return @intCast(n);
+}
+
+/// Bitrate produced by frames of `nbytes`.
+pub fn resolveBitrate(duration: FrameDuration, nbytes: u32) Error!u32 {
+    const n = c.lc3_resolve_bitrate(duration.us(), @intCast(nbytes));
+    if (n < 0) return error.BadArg;
+    return @intCast(n);
+}
+
+/// Algorithmic delay added by encode + decode, in samples.
+pub fn delaySamples(duration: FrameDuration, sample_rate: u32) Error!u32 {
+    const n = c.lc3_delay_samples(duration.us(), @intCast(sample_rate));
+    if (n < 0) return error.BadArg;
+    return @intCast(n);
+}
+
+// =============================================================================
+// Encoder
+// =============================================================================
+
+pub const Encoder = struct {
+    handle: c.lc3_encoder_t,
+    mem: []align(16) u8,
+    sample_rate: u32,
+    duration: FrameDuration,
+
+    const Self = @This();
+
+    /// Required memory size for an encoder (0 if unsupported).
+    pub fn getSize(duration: FrameDuration, sample_rate: u32) usize {
+        return c.lc3_encoder_size(duration.us(), @intCast(sample_rate));
+    }
+
+    /// Create a mono encoder. Memory is allocated from `allocator`.
+    pub fn init(allocator: std.mem.Allocator, sample_rate: u32, duration: FrameDuration) (Error || error{OutOfMemory})!Self {
+        const size = getSize(duration, sample_rate);
+        if (size == 0) return error.BadArg;
+        const mem = try allocator.alignedAlloc(u8, .@"16", size);
+        errdefer allocator.free(mem);
+
+        const handle = c.lc3_setup_encoder(duration.us(), @intCast(sample_rate), 0, mem.ptr) orelse return error.BadArg;
+        return .{ .handle = handle, .mem = mem, .sample_rate = sample_rate, .duration = duration };
+    }
+
+    /// Samples per frame for this encoder.
+    pub fn frameSamples(self: *const Self) u32 {
+        return @intCast(c.lc3_frame_samples(self.duration.us(), @intCast(self.sample_rate)));
+    }
+
+    /// Free encoder memory.
+    pub fn deinit(self: *Self, allocator: std.mem.Allocator) void {
+        allocator.free(self.mem);
+        self.* = undefined;
+    }
+
+    // ----- encode -----
+
+    /// Encode one frame of i16 PCM into exactly `nbytes` bytes.
+    /// `pcm.len` must be `frameSamples()`. Returns the frame within `out`.
+    pub fn encode(self: *Self, pcm: []const i16, nbytes: u32, out: []u8) Error![]const u8 {
+        if (pcm.len != self.frameSamples()) return error.BadArg;
+        if (nbytes < min_frame_bytes or nbytes > max_frame_bytes) return error.BadArg;
+        if (out.len < nbytes) return error.BufferTooSmall;
+        if (c.lc3_encode(self.handle, c.LC3_PCM_FORMAT_S16, pcm.ptr, 1, @intCast(nbytes), out.ptr) != 0) {
+            return error.InvalidFrame;
+        }
+        return out[0..nbytes];
+    }
+};
+
+// =============================================================================
+// Decoder
+// =============================================================================
+
+pub const Decoder = struct {
+    handle: c.lc3_decoder_t,
+    mem: []align(16) u8,
+    sample_rate: u32,
+    duration: FrameDuration,
+
+    const Self = @This();
+
+    /// Required memory size for a decoder (0 if unsupported).
+    pub fn getSize(duration: FrameDuration, sample_rate: u32) usize {
+        return c.lc3_decoder_size(duration.us(), @intCast(sample_rate));
+    }
+
+    /// Create a mono decoder. Memory is allocated from `allocator`.
+    pub fn init(allocator: std.mem.Allocator, sample_rate: u32, duration: FrameDuration) (Error || error{OutOfMemory})!Self {
+        const size = getSize(duration, sample_rate);
+        if (size == 0) return error.BadArg;
+        const mem = try allocator.alignedAlloc(u8, .@"16", size);
+        errdefer allocator.free(mem);
+
+        const handle = c.lc3_setup_decoder(duration.us(), @intCast(sample_rate), 0, mem.ptr) orelse return error.BadArg;
+        return .{ .handle = handle, .mem = mem, .sample_rate = sample_rate, .duration = duration };
+    }
+
+    /// Samples per frame for this decoder.
+    pub fn frameSamples(self: *const Self) u32 {
+        return @intCast(c.lc3_frame_samples(self.duration.us(), @intCast(self.sample_rate)));
+    }
+
+    /// Free decoder memory.
+    pub fn deinit(self: *Self, allocator: std.mem.Allocator) void {
+        allocator.free(self.mem);
+        self.* = undefined;
+    }
+
+    // ----- decode -----
+
+    /// Decode one LC3 frame to i16 PCM. Returns the decoded slice within
+    /// `pcm`. A corrupt frame is concealed (PLC) rather than rejected.
+    pub fn decode(self: *Self, data: []const u8, pcm: []i16) Error![]const i16 {
+        if (data.len < min_frame_bytes or data.len > max_frame_bytes) return error.BadArg;
+        return self.run(data.ptr, @intCast(data.len), pcm);
+    }
+
+    /// Packet loss concealment — generate replacement audio for a lost frame.
+    pub fn plc(self: *Self, pcm: []i16) Error![]const i16 {
+        return self.run(null, 0, pcm);
+    }
+
+    fn run(self: *Self, data: ?[*]const u8, nbytes: c_int, pcm: []i16) Error![]const i16 {
+        const n = self.frameSamples();
+        if (pcm.len < n) return error.BufferTooSmall;
+        // 0 = decoded, 1 = concealed, < 0 = bad parameters
+        if (c.lc3_decode(self.handle, data, nbytes, c.LC3_PCM_FORMAT_S16, pcm.ptr, 1) < 0) {
+            return error.InvalidFrame;
+        }
+        return pcm[0..n];
+    }
+};
@@ -0,0 +1,53 @@
+"""Repository rule for downloading and setting up liblc3.
+
+External projects using //third_party/lc3:lc3 must call lc3_repository()
+in their MODULE.bazel:
+
+    load("@embed_zig//third_party/lc3:repository.bzl", "lc3_repository")
+    lc3_repository(name = "lc3")
+"""
+
+_LC3_VERSION = "1.1.3"
+
+# SHA-256 of the GitHub tag archive for _LC3_VERSION. The fetch is refused
+# until it is pinned here (or passed as `sha256`); an unchecked download is
+# never used.
+_LC3_SHA256 = ""
+
+def _lc3_repository_impl(ctx):
+    """Download and setup liblc3 source."""
+    sha256 = ctx.attr.sha256 or _LC3_SHA256
+    if not sha256:
+        fail("liblc3 {}: no sha256 pinned in //third_party/lc3:repository.bzl".format(_LC3_VERSION))
+    ctx.download_and_extract(
+        url = "https://github.com/google/liblc3/archive/refs/tags/v{}.tar.gz".format(_LC3_VERSION),
+        strip_prefix = "liblc3-{}".format(_LC3_VERSION),
+        sha256 = sha256,
+    )
+    ctx.file("BUILD.bazel", """
+package(default_visibility = ["//visibility:public"])
+
+# Public headers (include/lc3.h, include/lc3_private.h)
+filegroup(
+    name = "headers",
+    srcs = glob(["include/*.h"]),
+)
+
+filegroup(
+    name = "internal_headers",
+    srcs = glob(["src/*.h"]),
+)
+
+filegroup(
+    name = "core_srcs",
+    srcs = glob(["src/*.c"]),
+)
+""")
+
+lc3_repository = repository_rule(
+    implementation = _lc3_repository_impl,
+    attrs = {
+        "sha256": attr.string(doc = "Overrides the pinned archive digest"),
+    },
+    doc = "Downloads liblc3 {} and creates filegroups for C sources and headers.".format(_LC3_VERSION),
+)
@@ -81,6 +81,9 @@ pub const Encoder = struct {
 
     const Self = @This();
 
+    /// Largest packet opus_encode produces for one frame (RFC 6716)
+    pub const max_packet_bytes: usize = 1275;
+
     /// Required memory size for an encoder with given channel count.
     pub fn getSize(channels: u8) usize {
         return @intCast(c.opus_encoder_get_size(@intCast(channels)));
@@ -119,6 +122,31 @@ pub const Encoder = struct {
         return out[0..n];
     }
 
+    /// Encode consecutive frames of i16 PCM in one call. Packets are
+    /// written back to back into `out`, `lens[i]` receives each size.
+    /// Encodes all `pcm.len / (frame_size * channels)` frames; fails with
+    /// BufferTooSmall before encoding any when `lens` has fewer entries or
+    /// `out` is shorter than `max_packet_bytes` per frame.
+    pub fn encodeBatch(self: *Self, pcm: []const i16, frame_size: u32, out: []u8, lens: []u16) Error![]const u8 {
+        const stride = @as(usize, frame_size) * self.channels;
+        if (stride == 0) return Error.BadArg;
+        const frames = pcm.len / stride;
+        if (lens.len < frames or out.len < frames * max_packet_bytes) return Error.BufferTooSmall;
+        var off: usize = 0;
+        for (0..frames) |i| {
+            const n = try checkedPositive(c.opus_encode(
+                self.handle,
+                pcm.ptr + i * stride,
+                @intCast(frame_size),
+                out.ptr + off,
+                @intCast(@min(out.len - off, max_packet_bytes)),
+            ));
+            lens[i] = @intCast(n);
+            off += n;
+        }
+        return out[0..off];
+    }
+
     /// Encode f32 PCM. Returns the encoded slice within `out`.
     pub fn encodeFloat(self: *Self, pcm: []const f32, frame_size: u32, out: []u8) Error![]const u8 {
         const n = try checkedPositive(c.opus_encode_float(self.handle, pcm.ptr, @intCast(frame_size), out.ptr, @intCast(out.len)));
@@ -204,6 +232,32 @@ pub const Decoder = struct {
         return pcm[0..n];
     }
 
+    /// Decode consecutive packets (sizes in `lens`, back to back in
+    /// `data`) into consecutive frames of `pcm`. Returns the decoded samples.
+    /// Packet headers are checked first: sizes running past `data` give
+    /// BadArg and a `pcm` too short for every packet gives BufferTooSmall,
+    /// before any packet is decoded.
+    pub fn decodeBatch(self: *Self, data: []const u8, lens: []const u16, pcm: []i16) Error![]const i16 {
+        var need: usize = 0;
+        var at: usize = 0;
+        for (lens) |len| {
+            if (len > data.len - at) return Error.BadArg;
+            need += @as(usize, try packetGetSamples(data[at..][0..len], self.sample_rate)) * self.channels;
+            at += len;
+        }
+        if (pcm.len < need) return Error.BufferTooSmall;
+
+        var in_off: usize = 0;
+        var out_off: usize = 0;
+        for (lens) |len| {
+            const room: c_int = @intCast((pcm.len - out_off) / self.channels);
+            const n = try checkedPositive(c.opus_decode(self.handle, data.ptr + in_off, len, pcm.ptr + out_off, room, 0));
+            in_off += len;
+            out_off += n * self.channels;
+        }
+        return pcm[0..out_off];
+    }
+
     /// Decode opus packet to f32 PCM. Returns the decoded slice within `pcm`.
     pub fn decodeFloat(self: *Self, data: []const u8, pcm: []f32, fec: bool) Error![]const f32 {
         const frame_size: c_int = @intCast(pcm.len);